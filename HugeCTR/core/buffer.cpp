@@ -22,6 +22,30 @@
 namespace core {
 using HugeCTR::CudaDeviceContext;
 
+namespace {
+
+// Wraps one stream-ordered suballocation so it can back a TensorImpl. The arena owns the
+// lifetime; extend/allocate make no sense here.
+class StreamOrderedStorage final : public IStorageImpl {
+  void *ptr_;
+  size_t nbytes_;
+
+ public:
+  StreamOrderedStorage(void *ptr, size_t nbytes) : ptr_(ptr), nbytes_(nbytes) {}
+
+  void *get_ptr() override { return ptr_; }
+
+  size_t nbytes() const override { return nbytes_; }
+
+  void extend(size_t nbytes) override {
+    HCTR_CHECK_HINT(false, "stream-ordered storage can not be extended");
+  }
+
+  void allocate() override {}
+};
+
+}  // namespace
+
 BufferBlockImpl::BufferBlockImpl(CoreResourceManager *backend, Device device)
     : storage_(backend->CreateStorage(device)), device_(device) {}
 
@@ -91,4 +115,51 @@ void BufferImpl::allocate() {
   }
   storages_.clear();
 }
+
+ArenaImpl::ArenaImpl(CoreResourceManager *backend, Device device) : device_(device) {
+  HCTR_CHECK_HINT(device_.is_gpu(), "stream-ordered arena only supports GPU devices");
+#if CUDART_VERSION >= 11020
+  // Keep freed suballocations in the device pool instead of trimming back to the driver, so
+  // a steady-state iteration is served from the pool without touching the driver.
+  CudaDeviceContext context(device_.index());
+  cudaMemPool_t pool;
+  HCTR_LIB_THROW(cudaDeviceGetDefaultMemPool(&pool, device_.index()));
+  uint64_t threshold = UINT64_MAX;
+  HCTR_LIB_THROW(cudaMemPoolSetAttribute(pool, cudaMemPoolAttrReleaseThreshold, &threshold));
+#endif
+}
+
+ArenaImpl::~ArenaImpl() { free_all(0); }
+
+Tensor ArenaImpl::allocate(const Shape &shape, DataType type, cudaStream_t stream) {
+  size_t nbytes = shape.num_elements() * type.itemsize();
+  CudaDeviceContext context(device_.index());
+  void *ptr = nullptr;
+#if CUDART_VERSION >= 11020
+  HCTR_LIB_THROW(cudaMallocAsync(&ptr, nbytes, stream));
+#else
+  // No stream-ordered allocator on this toolkit: fall back to a synchronous allocation.
+  HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+  HCTR_LIB_THROW(cudaMalloc(&ptr, nbytes));
+#endif
+  auto storage = std::make_shared<StreamOrderedStorage>(ptr, nbytes);
+  live_storages_.push_back(storage);
+  return Tensor{std::make_shared<TensorImpl>(storage, 0, shape, device_, type)};
+}
+
+void ArenaImpl::free_all(cudaStream_t stream) {
+  if (live_storages_.empty()) {
+    return;
+  }
+  CudaDeviceContext context(device_.index());
+  for (auto &storage : live_storages_) {
+#if CUDART_VERSION >= 11020
+    HCTR_LIB_THROW(cudaFreeAsync(storage->get_ptr(), stream));
+#else
+    HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+    HCTR_LIB_THROW(cudaFree(storage->get_ptr()));
+#endif
+  }
+  live_storages_.clear();
+}
 }  // namespace core
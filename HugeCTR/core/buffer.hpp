@@ -46,6 +46,26 @@ class BufferImpl final {
   void allocate();
 };
 
+/**
+ * Stream-ordered arena for per-iteration scratch tensors. Unlike BufferBlock/Buffer, which
+ * reserve eagerly at init time sized for the max batch, allocate() suballocates in stream
+ * order for the current shapes and free_all() returns everything to the per-device pool at
+ * the end of the step, so varying batch sizes use proportional memory instead of the
+ * worst case. The returned tensors must not be used past the free_all() of their step.
+ */
+class ArenaImpl final {
+  Device device_;
+  std::vector<Storage> live_storages_;
+
+ public:
+  ArenaImpl(CoreResourceManager *backend, Device device);
+  ~ArenaImpl();
+
+  Tensor allocate(const Shape &shape, DataType type, cudaStream_t stream);
+
+  void free_all(cudaStream_t stream);
+};
+
 inline BufferBlockPtr GetBufferBlock(std::shared_ptr<CoreResourceManager> backend, Device device) {
   return std::make_shared<core::BufferBlockImpl>(backend.get(), device);
 }
@@ -54,4 +74,8 @@ inline BufferPtr GetBuffer(std::shared_ptr<CoreResourceManager> backend) {
   return std::make_shared<core::BufferImpl>(backend.get());
 }
 
+inline ArenaPtr GetArena(std::shared_ptr<CoreResourceManager> backend, Device device) {
+  return std::make_shared<core::ArenaImpl>(backend.get(), device);
+}
+
 }  // namespace core
\ No newline at end of file
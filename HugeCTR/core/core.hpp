@@ -26,9 +26,11 @@ namespace core {
 class Device;
 class BufferBlockImpl;
 class BufferImpl;
+class ArenaImpl;
 
 using BufferBlockPtr = std::shared_ptr<BufferBlockImpl>;
 using BufferPtr = std::shared_ptr<BufferImpl>;
+using ArenaPtr = std::shared_ptr<ArenaImpl>;
 
 class IStorageImpl {
  public:
@@ -74,6 +76,10 @@ class CoreResourceManager {
 
   virtual const ncclComm_t &get_nccl() const = 0;
 
+  // Side communicator for an embedding table group, so independent groups' collectives can
+  // overlap. Backends without communicator groups fall back to the shared communicator.
+  virtual const ncclComm_t &get_group_nccl(size_t group_id) const { return get_nccl(); }
+
   virtual Storage CreateStorage(Device device) = 0;
 
   virtual int get_local_gpu_id() const = 0;
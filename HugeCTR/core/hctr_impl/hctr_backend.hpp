@@ -144,6 +144,10 @@ class HCTRCoreResourceManager : public core::CoreResourceManager {
 
   const ncclComm_t &get_nccl() const override { return ext_->get_local_gpu(local_id_)->get_nccl(); }
 
+  const ncclComm_t &get_group_nccl(size_t group_id) const override {
+    return ext_->get_local_gpu(local_id_)->get_group_nccl(group_id);
+  }
+
   core::Storage CreateStorage(Device device) {
     return std::make_shared<HCTRStorageImpl>(GetAllocator(device.type()));
   }
@@ -254,16 +254,12 @@ void All2AllEmbeddingCollectionModelForward::sparse_forward_per_gpu(
                             local_embedding_data_.h_local_hotness_list_,
                             global_embedding_data_.h_hotness_list_, batch_size, key_type);
 
-  Tensor model_key, model_offsets;
+  Tensor model_key, model_offsets, id_space_offset;
   size_t num_model_key_;
   model_index_calculation_.compute(
       keys, bucket_range, num_keys, local_embedding_data_.d_local_embedding_list_,
       local_embedding_data_.shard_id_, local_embedding_data_.shards_count_, batch_size, &model_key,
-      &model_offsets, &num_model_key_);
-
-  compress_offset_ = CompressOffset(core_, local_embedding_data_.num_local_embedding_ + 1);
-  Tensor id_space_offset;
-  compress_offset_.compute(model_offsets, batch_size, &id_space_offset);
+      &model_offsets, &num_model_key_, &id_space_offset);
 
   HCTR_LIB_THROW(cudaStreamSynchronize(stream));
   TensorList embedding_vec = TensorList(core_.get(), key_all_gather_recv_buffer.get_num_elements(),
@@ -109,7 +109,6 @@ class All2AllEmbeddingCollectionModelForward : public IAll2AllEmbeddingCollectio
   LocalEmbeddingData local_embedding_data_;
 
   ModelIndexCalculation model_index_calculation_;
-  CompressOffset compress_offset_;
   ModelForward model_forward_;
 
   Tensor model_key_, model_offsets_;
@@ -47,8 +47,6 @@ UniformDPEmbeddingForward::UniformDPEmbeddingForward(
       core_, global_embedding_data_.num_embedding_, local_embedding_data_.num_local_embedding_,
       local_embedding_data_.h_local_hotness_list_, universal_batch_size, key_type);
 
-  compress_offset_ = CompressOffset(core_, local_embedding_data_.num_local_embedding_ + 1);
-
   dp_model_forward_ = DPModelForward(core_, num_gpus, global_embedding_data_.num_embedding_,
                                      local_embedding_data_.num_local_embedding_);
   if (std::find(local_embedding_data_.h_local_combiner_list_.begin(),
@@ -73,12 +71,10 @@ void UniformDPEmbeddingForward::forward_per_gpu(const Tensor &keys, const Tensor
   Tensor dp_offset;
   size_t num_dp_key;
   Tensor dp_dst;
+  Tensor id_space_offset;
   index_calculation_.compute(keys, bucket_range, num_keys,
                              local_embedding_data_.d_local_embedding_list_, batch_size, &dp_key,
-                             &dp_offset, &num_dp_key, &dp_dst);
-
-  Tensor id_space_offset;
-  compress_offset_.compute(dp_offset, batch_size_per_gpu, &id_space_offset);
+                             &dp_offset, &num_dp_key, &dp_dst, &id_space_offset);
 
   Tensor unique_key, unique_dst_idx, sorted_bucket_id_list, sorted_bucket_id_offset,
       unique_id_space_offset;
@@ -19,7 +19,6 @@
 #include "embedding.hpp"
 #include "embedding_data.hpp"
 #include "operators/communication.hpp"
-#include "operators/compress_offset.hpp"
 #include "operators/dp_index_calculation.hpp"
 #include "operators/model_backward.hpp"
 #include "operators/model_forward.hpp"
@@ -33,7 +32,6 @@ class UniformDPEmbeddingForward : public IGroupedEmbeddingForward {
 
   DPIndexCalculation index_calculation_;
   DPLocalReduceIndexCalculation dp_local_reduce_index_calculation_;
-  CompressOffset compress_offset_;
   DPModelForward dp_model_forward_;
   AverageCominber average_combiner_;
 
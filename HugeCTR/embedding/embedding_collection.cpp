@@ -33,6 +33,9 @@ EmbeddingCollectionForward::EmbeddingCollectionForward(
   global_embedding_data_ = GlobalEmbeddingData(core, flatten_ebc_param);
 
   for (auto &embedding_sharding_param : flatten_ebs_param[0]) {
+    // the group index selects the communicator group; forward and backward of the same group
+    // must pick the same one
+    size_t group_id = embeddings_.size();
     switch (embedding_sharding_param.table_placement_strategy) {
       case TablePlacementStrategy::DataParallel:
         embeddings_.push_back(std::make_unique<UniformDPEmbeddingForward>(
@@ -40,7 +43,7 @@ EmbeddingCollectionForward::EmbeddingCollectionForward(
         break;
       case TablePlacementStrategy::ModelParallel:
         embeddings_.push_back(std::make_unique<UniformLocalizedEmbeddingForward>(
-            core, flatten_ebc_param, global_embedding_data_, embedding_sharding_param));
+            core, flatten_ebc_param, global_embedding_data_, embedding_sharding_param, group_id));
         break;
       default:
         HCTR_OWN_THROW(HugeCTR::Error_t::UnspecificError, "embedding forward create fail.");
@@ -84,6 +87,7 @@ EmbeddingCollectionBackward::EmbeddingCollectionBackward(
   global_embedding_data_ = GlobalEmbeddingData(core, flatten_ebc_param);
 
   for (auto &embedding_sharding_param : flatten_ebs_param[0]) {
+    size_t group_id = embeddings_.size();
     switch (embedding_sharding_param.table_placement_strategy) {
       case TablePlacementStrategy::DataParallel:
         embeddings_.push_back(std::make_unique<UniformDPEmbeddingBackward>(
@@ -91,7 +95,7 @@ EmbeddingCollectionBackward::EmbeddingCollectionBackward(
         break;
       case TablePlacementStrategy::ModelParallel:
         embeddings_.push_back(std::make_unique<UniformLocalizedEmbeddingBackward>(
-            core, flatten_ebc_param, global_embedding_data_, embedding_sharding_param));
+            core, flatten_ebc_param, global_embedding_data_, embedding_sharding_param, group_id));
         break;
       default:
         HCTR_OWN_THROW(HugeCTR::Error_t::UnspecificError, "embedding backward create fail.");
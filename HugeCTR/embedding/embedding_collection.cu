@@ -242,8 +242,10 @@ void PreprocessInput::compute(const Tensor &key, const Tensor &bucket_range, siz
     DISPATCH_INTEGRAL_FUNCTION(key.dtype().type(), key_t, [&] {
       DISPATCH_INTEGRAL_FUNCTION(bucket_range.dtype().type(), offset_t, [&] {
         auto stream = core_->get_local_gpu()->get_stream();
-        HCTR_LIB_THROW(cudaMemsetAsync(t_key_.get<key_t>(), 0, t_key_.nbytes(), stream));
 
+        // t_bucket_range is an inclusive scan of the actual per-bucket hotness, so
+        // transpose_key_kernel compacts all num_key keys into the front of t_key_; the padded
+        // tail up to max hotness is never read and needs no clearing.
         constexpr int block_size = 256;
         int grid_size = (bucket_range.get_num_elements() - 2) / block_size + 1;
         transpose_key_kernel<<<grid_size, block_size, 0, stream>>>(
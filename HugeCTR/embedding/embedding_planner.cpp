@@ -16,6 +16,7 @@
 #include "embedding_planner.hpp"
 
 #include <fstream>
+#include <limits>
 #include <nlohmann/json.hpp>
 #include <set>
 #include <unordered_set>
@@ -233,6 +234,105 @@ void EmbeddingPlanner::generate_embedding_plan_from_json_file(const std::string
 
 void EmbeddingPlanner::generate_embedding_plan(const std::string &strategy) {}
 
+void EmbeddingPlanner::generate_embedding_plan_auto(
+    const std::vector<EmbeddingTableParam> &table_param_list,
+    const AutoPlannerCostModel &cost_model) {
+  int num_global_gpus = cost_model.num_global_gpus;
+  HCTR_CHECK_HINT(num_global_gpus > 0,
+                  "EmbeddingPlanner: illegal input. num_global_gpus %d should be positive",
+                  num_global_gpus);
+
+  double itemsize = static_cast<double>(param_.emb_type.itemsize());
+  double batch_size = static_cast<double>(param_.universal_batch_size);
+  // both the mp all2all and the dp wgrad allreduce cross the node boundary as soon as the
+  // job does, so they share the same bottleneck bandwidth
+  double communication_bandwidth = (num_global_gpus > cost_model.num_gpus_per_node)
+                                       ? cost_model.inter_node_bandwidth
+                                       : cost_model.intra_node_bandwidth;
+  double shuffle_fraction = static_cast<double>(num_global_gpus - 1) / num_global_gpus;
+
+  std::vector<int> dp_embedding_list;
+  std::vector<int> mp_embedding_list;
+  size_t dp_bytes_used = 0;
+  for (int embedding_id = 0; embedding_id < param_.num_embedding; ++embedding_id) {
+    const auto &embedding_param = param_.embedding_params[embedding_id];
+    HCTR_CHECK_HINT(static_cast<size_t>(embedding_param.id_space) < table_param_list.size(),
+                    "EmbeddingPlanner: illegal input. id_space %d has no table param",
+                    embedding_param.id_space);
+    const auto &table_param = table_param_list[embedding_param.id_space];
+
+    double hotness = static_cast<double>(embedding_param.hotness);
+    double ev_bytes = embedding_param.ev_size * itemsize;
+
+    // dp: every replica has to receive the gradients of all the rows the step touched
+    // through the wgrad allreduce. A table smaller than the batch caps the touched rows,
+    // which is what makes the hot small tables the dp candidates.
+    double touched_rows = batch_size * hotness;
+    if (table_param.max_vocabulary_size >= 0) {
+      touched_rows = std::min(touched_rows, static_cast<double>(table_param.max_vocabulary_size));
+    }
+    double dp_time =
+        2.0 * shuffle_fraction * touched_rows * ev_bytes / communication_bandwidth;
+
+    // mp: the pooled vectors (all of them for concat) cross the wire in the forward
+    // all2all and once more backward
+    double pooled_hotness =
+        (embedding_param.combiner == Combiner::Concat) ? hotness : 1.0;
+    double mp_time = 2.0 * shuffle_fraction * batch_size * pooled_hotness * ev_bytes /
+                     communication_bandwidth;
+
+    // the lookup reads move the same volume per gpu under both placements and only shift
+    // the absolute prediction
+    double lookup_time = batch_size / num_global_gpus * hotness * ev_bytes /
+                         cost_model.device_memory_bandwidth;
+    dp_time += lookup_time;
+    mp_time += lookup_time;
+
+    // dp replicates the whole table on every gpu; dynamic tables cannot be replicated
+    size_t table_bytes =
+        (table_param.max_vocabulary_size >= 0)
+            ? static_cast<size_t>(table_param.max_vocabulary_size) * embedding_param.ev_size *
+                  param_.emb_type.itemsize()
+            : std::numeric_limits<size_t>::max();
+    bool replicable = (table_param.max_vocabulary_size >= 0) &&
+                      (dp_bytes_used + table_bytes <= cost_model.dp_memory_budget);
+
+    bool place_dp = replicable && dp_time < mp_time;
+    if (place_dp) {
+      dp_embedding_list.push_back(embedding_id);
+      dp_bytes_used += table_bytes;
+    } else {
+      mp_embedding_list.push_back(embedding_id);
+    }
+    HCTR_LOG_S(INFO, ROOT) << "EmbeddingPlanner: embedding " << embedding_id << " placed "
+                           << (place_dp ? "dp" : "mp") << " (predicted dp " << dp_time * 1.e6
+                           << " us, mp " << mp_time * 1.e6 << " us)" << std::endl;
+  }
+
+  global_embedding_sharding_param_list_.clear();
+  global_embedding_sharding_param_list_.resize(num_global_gpus);
+  for (int gpu_id = 0; gpu_id < num_global_gpus; ++gpu_id) {
+    if (!dp_embedding_list.empty()) {
+      EmbeddingShardingParam sharding_param;
+      sharding_param.local_embedding_list = dp_embedding_list;
+      sharding_param.global_embedding_list.assign(num_global_gpus, dp_embedding_list);
+      sharding_param.shard_id = 0;
+      sharding_param.shards_count = 1;
+      sharding_param.table_placement_strategy = TablePlacementStrategy::DataParallel;
+      global_embedding_sharding_param_list_[gpu_id].push_back(std::move(sharding_param));
+    }
+    if (!mp_embedding_list.empty()) {
+      EmbeddingShardingParam sharding_param;
+      sharding_param.local_embedding_list = mp_embedding_list;
+      sharding_param.global_embedding_list.assign(num_global_gpus, mp_embedding_list);
+      sharding_param.shard_id = gpu_id;
+      sharding_param.shards_count = num_global_gpus;
+      sharding_param.table_placement_strategy = TablePlacementStrategy::ModelParallel;
+      global_embedding_sharding_param_list_[gpu_id].push_back(std::move(sharding_param));
+    }
+  }
+}
+
 std::unique_ptr<IEmbeddingCollectionForward> EmbeddingPlanner::create_embedding_collection_forward(
     std::shared_ptr<CoreResourceManager> core) {
   int global_id = core->get_global_gpu_id();
@@ -14,11 +14,24 @@
  * limitations under the License.
  */
 #pragma once
+#include "HugeCTR/embedding_storage/common.hpp"
 #include "embedding.hpp"
 
 namespace embedding {
 using core::CoreResourceManager;
 
+// The bandwidths and capacities the automatic planner predicts step times with. The
+// defaults are typical NVLink / InfiniBand / HBM numbers; fill in measured values when
+// they are available.
+struct AutoPlannerCostModel {
+  int num_global_gpus;
+  int num_gpus_per_node;
+  double intra_node_bandwidth = 150.e9;     // bytes/s per GPU over NVLink
+  double inter_node_bandwidth = 20.e9;      // bytes/s per GPU over the network
+  double device_memory_bandwidth = 900.e9;  // bytes/s of HBM
+  size_t dp_memory_budget = 2ul << 30;      // bytes per GPU for replicated tables
+};
+
 class EmbeddingPlanner {
   EmbeddingCollectionParam param_;
   std::vector<std::vector<EmbeddingShardingParam>> global_embedding_sharding_param_list_;
@@ -49,6 +62,12 @@ class EmbeddingPlanner {
 
   void generate_embedding_plan(const std::string &strategy);
 
+  // Automatic placement: choose dp or mp per embedding from the table cardinalities, the
+  // hotness and the cost model, minimizing the predicted per-step time. mp embeddings are
+  // sharded over all gpus.
+  void generate_embedding_plan_auto(const std::vector<EmbeddingTableParam> &table_param_list,
+                                    const AutoPlannerCostModel &cost_model);
+
   std::unique_ptr<IEmbeddingCollectionForward> create_embedding_collection_forward(
       std::shared_ptr<CoreResourceManager> core);
 
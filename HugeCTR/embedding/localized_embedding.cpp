@@ -20,7 +20,8 @@ namespace embedding {
 
 UniformLocalizedEmbeddingForward::UniformLocalizedEmbeddingForward(
     std::shared_ptr<CoreResourceManager> core, const EmbeddingCollectionParam &params,
-    const GlobalEmbeddingData &global_embedding_data, const EmbeddingShardingParam &sharding_param)
+    const GlobalEmbeddingData &global_embedding_data, const EmbeddingShardingParam &sharding_param,
+    size_t comm_group)
     : core_(core),
       global_embedding_data_(global_embedding_data),
       local_embedding_data_(core, params, sharding_param) {
@@ -35,9 +36,8 @@ UniformLocalizedEmbeddingForward::UniformLocalizedEmbeddingForward(
       core, num_gpus, local_embedding_data_.num_local_embedding_,
       local_embedding_data_.h_local_hotness_list_, local_embedding_data_.h_local_id_space_list_,
       local_embedding_data_.h_local_ev_size_list_, params.universal_batch_size, key_type);
-  compress_offset_ = CompressOffset(core, local_embedding_data_.num_local_embedding_ + 1);
   model_forward_ = ModelForward(core, num_gpus, local_embedding_data_.h_local_embedding_list_);
-  all2all_comm_ = NcclAll2AllComm(core);
+  all2all_comm_ = NcclAll2AllComm(core, comm_group);
   network_forward_ = NetworkForward(core, num_gpus);
   ragged_network_index_ =
       RaggedNetworkIndex(core, params.universal_batch_size, sharding_param.global_embedding_list,
@@ -50,14 +50,6 @@ UniformLocalizedEmbeddingForward::UniformLocalizedEmbeddingForward(
       DeviceType::GPU, TensorScalarType::Float32);
 
   init_model_comm_buffer(params.universal_batch_size, emb_type);
-  if (std::find(local_embedding_data_.h_network_combiner_list_.begin(),
-                local_embedding_data_.h_network_combiner_list_.end(),
-                static_cast<char>(Combiner::Average)) !=
-      local_embedding_data_.h_network_combiner_list_.end()) {
-    average_combiner_ =
-        AverageCominber(core, num_gpus, local_embedding_data_.h_network_embedding_list_.size(),
-                        global_embedding_data_.h_ev_size_list_, params.universal_batch_size);
-  }
 }
 
 std::vector<size_t> UniformLocalizedEmbeddingForward::get_model_comm_buffer_size(
@@ -94,14 +86,12 @@ void UniformLocalizedEmbeddingForward::forward_per_gpu(
   HugeCTR::CudaDeviceContext context(core_->get_device_id());
   int batch_size = (bucket_range.get_num_elements() - 1) / global_embedding_data_.num_embedding_;
 
-  Tensor model_key, model_offsets;
+  Tensor model_key, model_offsets, id_space_offset;
   size_t num_model_key;
   model_index_calculation_.compute(
       keys, bucket_range, num_keys, local_embedding_data_.d_local_embedding_list_,
       local_embedding_data_.shard_id_, local_embedding_data_.shards_count_, batch_size, &model_key,
-      &model_offsets, &num_model_key);
-  Tensor id_space_offset;
-  compress_offset_.compute(model_offsets, batch_size, &id_space_offset);
+      &model_offsets, &num_model_key, &id_space_offset);
 
   Tensor unique_key, unique_dst_idx, sorted_bucket_id_list, sorted_bucket_id_offset,
       unique_id_space_list, unique_id_space_offset, coordinate_key, coordinate_wgrad_dst_idx;
@@ -136,16 +126,15 @@ void UniformLocalizedEmbeddingForward::forward_per_gpu(
         ragged_network_index_.network_ev_offsets_, output_buffer,
         global_embedding_data_.d_ev_size_offset_, batch_size, global_embedding_data_.max_ev_size_);
   } else {
+    // The average division is folded into the gather itself, so no intermediate float buffer
+    // is materialized and the combined result lands directly in the dense-network input.
     network_forward_.compute(
         ragged_network_buffer_.network_comm_buffer_, ragged_network_index_.network_ids_,
         ragged_network_index_.network_gpu_ids_, ragged_network_index_.network_offsets_,
         ragged_network_index_.network_dst_lookup_ids_, ragged_network_index_.network_ev_sizes_,
-        ragged_network_index_.network_ev_offsets_, average_combiner_.float_emb_vec_,
+        ragged_network_index_.network_ev_offsets_, bucket_range,
+        global_embedding_data_.d_combiner_list_, output_buffer,
         global_embedding_data_.d_ev_size_offset_, batch_size, global_embedding_data_.max_ev_size_);
-    average_combiner_.forward(
-        bucket_range, output_buffer, local_embedding_data_.d_network_embedding_list_,
-        global_embedding_data_.d_combiner_list_, global_embedding_data_.d_ev_size_offset_,
-        batch_size, global_embedding_data_.max_ev_size_);
   }
 
   // for utest
@@ -174,7 +163,8 @@ void UniformLocalizedEmbeddingForward::forward_per_gpu(
 
 UniformLocalizedEmbeddingBackward::UniformLocalizedEmbeddingBackward(
     std::shared_ptr<CoreResourceManager> core, const EmbeddingCollectionParam &params,
-    const GlobalEmbeddingData &global_embedding_data, const EmbeddingShardingParam &sharding_param)
+    const GlobalEmbeddingData &global_embedding_data, const EmbeddingShardingParam &sharding_param,
+    size_t comm_group)
     : core_(core),
       global_embedding_data_(global_embedding_data),
       local_embedding_data_(core, params, sharding_param) {
@@ -183,7 +173,7 @@ UniformLocalizedEmbeddingBackward::UniformLocalizedEmbeddingBackward(
   int num_gpus = core->get_global_gpu_count();
 
   network_backward_ = NetworkBackward(core, num_gpus);
-  all2all_comm_ = NcclAll2AllComm(core);
+  all2all_comm_ = NcclAll2AllComm(core, comm_group);
   model_backward_ =
       ModelBackward(core, num_gpus, local_embedding_data_.num_local_embedding_,
                     local_embedding_data_.h_local_hotness_list_,
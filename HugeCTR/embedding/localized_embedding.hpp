@@ -18,7 +18,6 @@
 #include "embedding.hpp"
 #include "embedding_data.hpp"
 #include "operators/communication.hpp"
-#include "operators/compress_offset.hpp"
 #include "operators/model_backward.hpp"
 #include "operators/model_forward.hpp"
 #include "operators/mp_index_calculation.hpp"
@@ -34,11 +33,9 @@ class UniformLocalizedEmbeddingForward : public IGroupedEmbeddingForward {
 
   ModelIndexCalculation model_index_calculation_;
   ModelBackwardIndexCalculation model_backward_index_calculation_;
-  CompressOffset compress_offset_;
   ModelForward model_forward_;
   NcclAll2AllComm all2all_comm_;
   NetworkForward network_forward_;
-  AverageCominber average_combiner_;
 
   RaggedNetworkIndex ragged_network_index_;
   RaggedNetworkBuffer ragged_network_buffer_;
@@ -58,7 +55,8 @@ class UniformLocalizedEmbeddingForward : public IGroupedEmbeddingForward {
   UniformLocalizedEmbeddingForward(std::shared_ptr<CoreResourceManager> core,
                                    const EmbeddingCollectionParam &params,
                                    const GlobalEmbeddingData &global_embedding_data,
-                                   const EmbeddingShardingParam &embedding_sharding_param);
+                                   const EmbeddingShardingParam &embedding_sharding_param,
+                                   size_t comm_group = 0);
 
   void forward_per_gpu(const Tensor &keys, const Tensor &bucket_range, size_t num_keys,
                        const Tensor &sparse_weight, ILookup *embedding_table, Tensor &output_buffer,
@@ -79,7 +77,8 @@ class UniformLocalizedEmbeddingBackward : public IGroupedEmbeddingBackward {
   UniformLocalizedEmbeddingBackward(std::shared_ptr<CoreResourceManager> core,
                                     const EmbeddingCollectionParam &params,
                                     const GlobalEmbeddingData &global_embedding_data,
-                                    const EmbeddingShardingParam &embedding_sharding_param);
+                                    const EmbeddingShardingParam &embedding_sharding_param,
+                                    size_t comm_group = 0);
 
   void backward_per_gpu(ContextContainer *context_container, const Tensor &top_grad,
                         bool do_allreduce, Tensor *unique_key, size_t *num_unique_key,
@@ -13,6 +13,8 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <cstdlib>
+
 #include "communication.hpp"
 
 #include "HugeCTR/include/utils.hpp"
@@ -21,14 +23,35 @@ namespace embedding {
 using core::CoreResourceManager;
 using core::get_nccl_dtype_from_tensor_scalar_type;
 
-NcclAll2AllComm::NcclAll2AllComm(std::shared_ptr<CoreResourceManager> core) : core_(core) {}
+NcclAll2AllComm::NcclAll2AllComm(std::shared_ptr<CoreResourceManager> core, size_t comm_group)
+    : core_(core), comm_group_(comm_group) {
+  size_t num_local_gpus = core_->get_local_gpu_count();
+  size_t num_global_gpus = core_->get_global_gpu_count();
+  if (std::getenv("HCTR_HIER_ALL2ALL") && num_local_gpus > 1 &&
+      num_global_gpus > num_local_gpus) {
+    hierarchical_ = true;
+    HCTR_LOG_S(INFO, ROOT) << "HCTR_HIER_ALL2ALL is set. NcclAll2AllComm aggregates "
+                              "inter-node traffic per node pair." << std::endl;
+  }
+}
 
 void NcclAll2AllComm::communicate(const std::vector<Tensor> &send_tensors,
                                   const std::vector<size_t> &send_offsets,
                                   std::vector<Tensor> &recv_tensors,
                                   const std::vector<size_t> &recv_offsets) {
   int device_id = core_->get_device_id();
-  auto &comm = core_->get_nccl();
+  auto &comm = core_->get_group_nccl(comm_group_);
+
+  if (hierarchical_) {
+    bool uniform_send = true;
+    for (size_t p = 1; p < send_offsets.size(); ++p) {
+      if (send_offsets[p] != send_offsets[0]) uniform_send = false;
+    }
+    if (uniform_send) {
+      communicate_hierarchical(send_tensors, send_offsets, recv_tensors, recv_offsets);
+      return;
+    }
+  }
 
   HugeCTR::CudaDeviceContext ctx(device_id);
   HCTR_LIB_THROW(ncclGroupStart());
@@ -44,6 +67,119 @@ void NcclAll2AllComm::communicate(const std::vector<Tensor> &send_tensors,
   HCTR_LIB_THROW(ncclGroupEnd());
 }
 
+void NcclAll2AllComm::reserve_inter_node_buffers(size_t send_bytes, size_t recv_bytes) {
+  if (send_bytes <= inter_node_send_bytes_ && recv_bytes <= inter_node_recv_bytes_) {
+    return;
+  }
+  auto buffer_ptr = GetBuffer(core_);
+  inter_node_send_buffer_ =
+      buffer_ptr->reserve({send_bytes}, core::DeviceType::GPU, core::TensorScalarType::Char);
+  inter_node_recv_buffer_ =
+      buffer_ptr->reserve({recv_bytes}, core::DeviceType::GPU, core::TensorScalarType::Char);
+  buffer_ptr->allocate();
+  inter_node_send_bytes_ = send_bytes;
+  inter_node_recv_bytes_ = recv_bytes;
+}
+
+void NcclAll2AllComm::communicate_hierarchical(const std::vector<Tensor> &send_tensors,
+                                               const std::vector<size_t> &send_offsets,
+                                               std::vector<Tensor> &recv_tensors,
+                                               const std::vector<size_t> &recv_offsets) {
+  HugeCTR::CudaDeviceContext ctx(core_->get_device_id());
+  auto &comm = core_->get_group_nccl(comm_group_);
+  cudaStream_t stream = core_->get_local_gpu()->get_stream();
+
+  int num_local_gpus = static_cast<int>(core_->get_local_gpu_count());
+  int num_global_gpus = static_cast<int>(core_->get_global_gpu_count());
+  int num_nodes = num_global_gpus / num_local_gpus;
+  int global_id = core_->get_global_gpu_id();
+  int node_id = global_id / num_local_gpus;
+  int local_id = global_id % num_local_gpus;
+
+  ncclDataType_t nccl_dtype =
+      get_nccl_dtype_from_tensor_scalar_type(send_tensors[0].dtype().type());
+  size_t itemsize = send_tensors[0].dtype().itemsize();
+  auto rank_of = [&](int node, int local) { return node * num_local_gpus + local; };
+
+  // What a node neighbor sends to any rank equals what it sends to us.
+  std::vector<size_t> local_send_count(num_local_gpus);
+  std::vector<size_t> local_chunk_offset(num_local_gpus + 1, 0);
+  for (int i = 0; i < num_local_gpus; ++i) {
+    local_send_count[i] =
+        (i == local_id) ? send_offsets[global_id] : recv_offsets[rank_of(node_id, i)];
+    local_chunk_offset[i + 1] = local_chunk_offset[i] + local_send_count[i];
+  }
+  size_t node_blob_count = local_chunk_offset[num_local_gpus];
+
+  std::vector<size_t> recv_node_blob_count(num_nodes, 0);
+  size_t recv_staging_count = 0;
+  for (int n = 0; n < num_nodes; ++n) {
+    if (n == node_id) continue;
+    for (int j = 0; j < num_local_gpus; ++j) {
+      recv_node_blob_count[n] += recv_offsets[rank_of(n, j)];
+    }
+    recv_staging_count += recv_node_blob_count[n];
+  }
+  reserve_inter_node_buffers((num_nodes - 1) * node_blob_count * itemsize,
+                             recv_staging_count * itemsize);
+  char *send_staging = inter_node_send_buffer_.get<char>();
+  char *recv_staging = inter_node_recv_buffer_.get<char>();
+
+  // Stage 1 (intra-node): deliver the node-local traffic directly and gather the chunk
+  // destined to the remote gpu (n, j) on the local rail gpu (node_id, j).
+  HCTR_LIB_THROW(ncclGroupStart());
+  for (int j = 0; j < num_local_gpus; ++j) {
+    int peer = rank_of(node_id, j);
+    HCTR_LIB_THROW(ncclSend(send_tensors[peer].get(), send_offsets[peer], nccl_dtype, peer, comm,
+                            stream));
+    HCTR_LIB_THROW(ncclRecv(recv_tensors[peer].get(), recv_offsets[peer], nccl_dtype, peer, comm,
+                            stream));
+    int blob = 0;
+    for (int n = 0; n < num_nodes; ++n) {
+      if (n == node_id) continue;
+      int remote = rank_of(n, j);
+      HCTR_LIB_THROW(ncclSend(send_tensors[remote].get(), send_offsets[remote], nccl_dtype, peer,
+                              comm, stream));
+      char *dst =
+          send_staging + (blob * node_blob_count + local_chunk_offset[j]) * itemsize;
+      HCTR_LIB_THROW(ncclRecv(dst, local_send_count[j], nccl_dtype, peer, comm, stream));
+      ++blob;
+    }
+  }
+  HCTR_LIB_THROW(ncclGroupEnd());
+
+  // Stage 2 (inter-node): one aggregated message per node pair on this rail.
+  HCTR_LIB_THROW(ncclGroupStart());
+  {
+    int blob = 0;
+    size_t recv_off = 0;
+    for (int n = 0; n < num_nodes; ++n) {
+      if (n == node_id) continue;
+      int peer = rank_of(n, local_id);
+      const char *src = send_staging + blob * node_blob_count * itemsize;
+      HCTR_LIB_THROW(ncclSend(src, node_blob_count, nccl_dtype, peer, comm, stream));
+      HCTR_LIB_THROW(ncclRecv(recv_staging + recv_off * itemsize, recv_node_blob_count[n],
+                              nccl_dtype, peer, comm, stream));
+      recv_off += recv_node_blob_count[n];
+      ++blob;
+    }
+  }
+  HCTR_LIB_THROW(ncclGroupEnd());
+
+  // Stage 3 (local): scatter each received blob into the per-source receive buffers.
+  size_t recv_off = 0;
+  for (int n = 0; n < num_nodes; ++n) {
+    if (n == node_id) continue;
+    for (int j = 0; j < num_local_gpus; ++j) {
+      size_t count = recv_offsets[rank_of(n, j)];
+      HCTR_LIB_THROW(cudaMemcpyAsync(recv_tensors[rank_of(n, j)].get(),
+                                     recv_staging + recv_off * itemsize, count * itemsize,
+                                     cudaMemcpyDeviceToDevice, stream));
+      recv_off += count;
+    }
+  }
+}
+
 NcclAllReduceInplaceComm::NcclAllReduceInplaceComm(std::shared_ptr<CoreResourceManager> core)
     : core_(core) {}
 
@@ -24,11 +24,31 @@ using core::Tensor;
 
 class NcclAll2AllComm {
   std::shared_ptr<CoreResourceManager> core_;
+  size_t comm_group_{0};
+  bool hierarchical_{false};
+  Tensor inter_node_send_buffer_;
+  Tensor inter_node_recv_buffer_;
+  size_t inter_node_send_bytes_{0};
+  size_t inter_node_recv_bytes_{0};
+
+  void reserve_inter_node_buffers(size_t send_bytes, size_t recv_bytes);
+
+  // Two-stage exchange for multi-node jobs: the chunks destined to a remote gpu are first
+  // gathered on the local gpu sharing its local id (the rail) over NVLink, then every rail
+  // sends one aggregated message per remote node, and the received blob is scattered into
+  // the per-source receive buffers with device copies. Requires every rank to send the
+  // same element count to each of its peers, which lets a rank infer the counts of its
+  // node neighbors from its own receive counts.
+  void communicate_hierarchical(const std::vector<Tensor> &send_tensors,
+                                const std::vector<size_t> &send_offsets,
+                                std::vector<Tensor> &recv_tensors,
+                                const std::vector<size_t> &recv_offsets);
 
  public:
   NcclAll2AllComm() = default;
 
-  NcclAll2AllComm(std::shared_ptr<CoreResourceManager> core);
+  // comm_group selects the communicator group so independent embedding groups' exchanges overlap
+  NcclAll2AllComm(std::shared_ptr<CoreResourceManager> core, size_t comm_group = 0);
 
   void communicate(const std::vector<Tensor> &send_tensors, const std::vector<size_t> &send_offsets,
                    std::vector<Tensor> &recv_tensors, const std::vector<size_t> &recv_offsets);
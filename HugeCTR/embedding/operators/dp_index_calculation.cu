@@ -23,27 +23,54 @@ namespace embedding {
 
 namespace {
 
+// One thread per bucket of every embedding and every gpu slice: writing the unselected
+// flags alongside the selected ones makes the pass cover the whole flag array, so the
+// flag/offset/dst memset launches before this kernel are gone.
 template <typename offset_t>
-__global__ void mask_flag_kernel(int num_local_embedding, int batch_size_per_gpu,
+__global__ void mask_flag_kernel(int num_bucket, int num_local_embedding, int batch_size_per_gpu,
                                  int const* d_local_embedding_list, int batch_size, int gpu_id,
                                  offset_t const* bucket_range, char* flag, uint32_t* dp_offset,
                                  uint32_t* dp_dst) {
   int tid = blockIdx.x * blockDim.x + threadIdx.x;
 
-  if (tid < num_local_embedding * batch_size_per_gpu) {
-    int batch_id = tid % batch_size_per_gpu;
-    int embedding_id = d_local_embedding_list[tid / batch_size_per_gpu];
-    int bucket_id = batch_size * embedding_id + batch_size_per_gpu * gpu_id + batch_id;
+  if (tid < num_bucket) {
+    int embedding_id = tid / batch_size;
+    int batch_id = tid % batch_size;
 
-    int start = bucket_range[bucket_id];
-    int end = bucket_range[bucket_id + 1];
-    dp_offset[1 + tid] = end - start;
+    // d_local_embedding_list is sorted, so membership is a binary search
+    int local_pos =
+        binary_search_index_lower_bound(d_local_embedding_list, num_local_embedding, embedding_id);
+    bool is_local = (local_pos >= 0 && d_local_embedding_list[local_pos] == embedding_id);
+    bool in_local_batch = (batch_id >= gpu_id * batch_size_per_gpu) &&
+                          (batch_id < (gpu_id + 1) * batch_size_per_gpu);
+    char selected = (is_local && in_local_batch) ? 1 : 0;
+
+    int start = bucket_range[tid];
+    int end = bucket_range[tid + 1];
     for (int j = start; j < end; ++j) {
-      flag[j] = 1;
+      flag[j] = selected;
     }
 
-    int dst_bucket_id = batch_size_per_gpu * embedding_id + batch_id;
-    dp_dst[tid] = dst_bucket_id;
+    if (selected) {
+      int local_batch_id = batch_id - gpu_id * batch_size_per_gpu;
+      int local_tid = local_pos * batch_size_per_gpu + local_batch_id;
+      dp_offset[1 + local_tid] = end - start;
+      dp_dst[local_tid] = batch_size_per_gpu * embedding_id + local_batch_id;
+    }
+    if (tid == 0) {
+      dp_offset[0] = 0;
+    }
+  }
+}
+
+// strided gather of the scanned offsets; running it here instead of the separate
+// CompressOffset pass keeps the whole index calculation in one operator
+__global__ void fused_compress_offset_kernel(const uint32_t* offset, int num, int stride,
+                                             uint32_t* compressed_offset) {
+  int thread_cnt = blockDim.x * blockDim.y;
+
+  for (int tid = threadIdx.x + threadIdx.y * blockDim.x; tid < num; tid += thread_cnt) {
+    compressed_offset[tid] = offset[tid * stride];
   }
 }
 
@@ -212,13 +239,15 @@ DPIndexCalculation::DPIndexCalculation(std::shared_ptr<CoreResourceManager> core
                                    device, TensorScalarType::UInt32);
   dp_dst_ = buffer_ptr->reserve({universal_batch_size_per_gpu_ * num_local_embedding_}, device,
                                 TensorScalarType::UInt32);
+  id_space_offset_ =
+      buffer_ptr->reserve({num_local_embedding_ + 1}, device, TensorScalarType::UInt32);
   buffer_ptr->allocate();
 }
 
 void DPIndexCalculation::compute(const Tensor& key, const Tensor& bucket_range, size_t num_keys,
                                  const Tensor& d_local_embedding_list, int batch_size,
                                  Tensor* dp_key, Tensor* dp_offset, size_t* num_dp_key,
-                                 Tensor* dp_dst) {
+                                 Tensor* dp_dst, Tensor* id_space_offset) {
   HugeCTR::CudaDeviceContext ctx(core_->get_device_id());
 
   int batch_size_per_gpu = batch_size / num_gpus_;
@@ -228,19 +257,19 @@ void DPIndexCalculation::compute(const Tensor& key, const Tensor& bucket_range,
 
   DISPATCH_INTEGRAL_FUNCTION(key.dtype().type(), key_t, [&] {
     DISPATCH_INTEGRAL_FUNCTION(bucket_range.dtype().type(), offset_t, [&] {
-      HCTR_LIB_THROW(cudaMemsetAsync(dp_key_.get<key_t>(), 0, dp_key_.nbytes(), stream));
-      HCTR_LIB_THROW(cudaMemsetAsync(dp_offset_.get<uint32_t>(), 0, dp_offset_.nbytes(), stream));
-      HCTR_LIB_THROW(cudaMemsetAsync(dp_dst_.get<uint32_t>(), 0, dp_dst_.nbytes(), stream));
-      HCTR_LIB_THROW(cudaMemsetAsync(flag_.get<char>(), 0, flag_.nbytes(), stream));
+      // DeviceSelect::Flagged compacts exactly num_dp_key keys into the front of dp_key_ and
+      // every consumer is bounded by that count, so the padded tail needs no clearing.
       HCTR_LIB_THROW(cudaMemsetAsync(num_dp_key_.get<size_t>(), 0, num_dp_key_.nbytes(), stream));
 
-      // mask_flag
+      // mask_flag; the fused kernel fully covers the flag, offset and dst buffers, so their
+      // memset passes are gone
+      int num_bucket = static_cast<int>(bucket_range.get_num_elements()) - 1;
       constexpr int blockDim = 1024;
-      int gridDim = (num_local_embedding_ * batch_size_per_gpu - 1) / blockDim + 1;
+      int gridDim = (num_bucket - 1) / blockDim + 1;
       mask_flag_kernel<<<gridDim, blockDim, 0, stream>>>(
-          num_local_embedding_, batch_size_per_gpu, d_local_embedding_list.get<int>(), batch_size,
-          gpu_id, bucket_range.get<offset_t>(), flag_.get<char>(), dp_offset_.get<uint32_t>(),
-          dp_dst_.get<uint32_t>());
+          num_bucket, num_local_embedding_, batch_size_per_gpu, d_local_embedding_list.get<int>(),
+          batch_size, gpu_id, bucket_range.get<offset_t>(), flag_.get<char>(),
+          dp_offset_.get<uint32_t>(), dp_dst_.get<uint32_t>());
 
       // select key
       size_t temp_storage_category_bytes = d_temp_storage_category_.nbytes();
@@ -254,6 +283,10 @@ void DPIndexCalculation::compute(const Tensor& key, const Tensor& bucket_range,
                                     dp_offset_.get<uint32_t>(), dp_offset_.get<uint32_t>(),
                                     dp_offset_.get_num_elements(), stream);
       HCTR_LIB_THROW(cudaPeekAtLastError());
+      fused_compress_offset_kernel<<<1, dim3(32, 8), 0, stream>>>(
+          dp_offset_.get<uint32_t>(), num_local_embedding_ + 1, batch_size_per_gpu,
+          id_space_offset_.get<uint32_t>());
+      HCTR_LIB_THROW(cudaPeekAtLastError());
       // sync with cpu to get sum flag
       HCTR_LIB_THROW(cudaStreamSynchronize(stream));
     });
@@ -263,6 +296,7 @@ void DPIndexCalculation::compute(const Tensor& key, const Tensor& bucket_range,
   *dp_offset = dp_offset_;
   *num_dp_key = num_dp_key_.get<size_t>()[0];
   *dp_dst = dp_dst_;
+  *id_space_offset = id_space_offset_;
 }
 
 DPLocalReduceIndexCalculation::DPLocalReduceIndexCalculation(
@@ -368,25 +402,13 @@ void DPLocalReduceIndexCalculation::compute(
       int gpu_id = core_->get_global_gpu_id();
       int num_gpus = core_->get_global_gpu_count();
 
-      HCTR_LIB_THROW(cudaMemsetAsync(segment_end_offsets_.get<int>(), 0,
-                                     segment_end_offsets_.nbytes(), stream));
-      HCTR_LIB_THROW(cudaMemsetAsync(dp_keys_.get<key_t>(), 0, dp_keys_.nbytes(), stream));
-      HCTR_LIB_THROW(
-          cudaMemsetAsync(dp_bucket_id_.get<uint32_t>(), 0, dp_bucket_id_.nbytes(), stream));
-      HCTR_LIB_THROW(
-          cudaMemsetAsync(sorted_dp_keys_.get<key_t>(), 0, sorted_dp_keys_.nbytes(), stream));
-      HCTR_LIB_THROW(
-          cudaMemsetAsync(unique_dp_keys_.get<key_t>(), 0, unique_dp_keys_.nbytes(), stream));
-      HCTR_LIB_THROW(cudaMemsetAsync(unique_dp_keys_indices_.get<uint32_t>(), 0,
-                                     unique_dp_keys_indices_.nbytes(), stream));
-
-      HCTR_LIB_THROW(cudaMemsetAsync(sorted_bucket_id_list_.get<uint32_t>(), 0,
-                                     sorted_bucket_id_list_.nbytes(), stream));
-      HCTR_LIB_THROW(
-          cudaMemsetAsync(unique_dst_idx_.get<uint32_t>(), 0, unique_dst_idx_.nbytes(), stream));
-      HCTR_LIB_THROW(cudaMemsetAsync(sorted_bucket_id_offset_.get<uint32_t>(), 0,
-                                     sorted_bucket_id_offset_.nbytes(), stream));
-
+      // The intermediate buffers are sized by the max hotness, but the kernels below write
+      // every entry they later read: the segmented sort and the unique-key select are bounded
+      // by the per-segment end offsets, the compaction kernel by the device-side unique count,
+      // and the scans only accumulate padding past those counts, which no consumer reads. So
+      // none of the buffers needs a full-capacity clearing pass per iteration. The one
+      // exception is sorted_dp_bucket_id_, whose inter-segment gaps must read as empty for
+      // the bucket-id select below.
       {
         fused_select_dp_key_and_bucket_id_kernel<<<num_local_embedding_, 256, 0, stream>>>(
             key.get<key_t>(), bucket_range.get<offset_t>(), num_key, batch_size,
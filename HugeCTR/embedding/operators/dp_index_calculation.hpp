@@ -40,7 +40,8 @@ class DPIndexCalculation {
 
   void compute(const Tensor& key, const Tensor& bucket_range, size_t num_keys,
                const Tensor& d_local_embedding_list, int batch_size, Tensor* ret_dp_key,
-               Tensor* ret_dp_offset, size_t* num_dp_key, Tensor* dp_dst);
+               Tensor* ret_dp_offset, size_t* num_dp_key, Tensor* dp_dst,
+               Tensor* id_space_offset);
 
  private:
   int num_gpus_;
@@ -62,6 +63,7 @@ class DPIndexCalculation {
   Tensor dp_key_;
   Tensor dp_offset_;
   Tensor dp_dst_;
+  Tensor id_space_offset_;
 };
 
 class DPLocalReduceIndexCalculation {
@@ -490,7 +490,12 @@ void generic_copy(IndexArray src_idx, ScalerArray scaler_arr, DstArray dst_idx,
       src_idx, scaler_arr, dst_idx, src_tensor, dst_tensor);
 }
 
-template <typename CopyDesc, int kMaxElemPerThread>
+// The multi_to_one/one_to_multi kernels below are specialized at launch time on three compile-time
+// axes: the src/dst dtypes (baked into CopyDesc by DISPATCH_FLOAT_AND_HALF_FUNCTION at the call
+// site), the vector width per thread (kMaxElemPerThread, chosen from max_ev_size), and the
+// combiner scaling (kHasScale). With kHasScale == false the average-pooling division is compiled
+// out entirely, so sum/concat combiners pay no per-element scaling cost.
+template <typename CopyDesc, int kMaxElemPerThread, bool kHasScale>
 __global__ void multi_to_one_cta_per_ev_kernel(CopyDesc copy_desc) {
   using src_type = typename CopyDesc::SrcT;
   using dst_type = typename CopyDesc::DstT;
@@ -499,7 +504,6 @@ __global__ void multi_to_one_cta_per_ev_kernel(CopyDesc copy_desc) {
 
   if (i_ev < copy_desc.num_vec_) {
     vec_length_type vec_length = copy_desc.get_vec_length_(i_ev);
-    int average_pooling_factor = copy_desc.get_average_pooling_factor(i_ev);
     dst_type *dst_ev = copy_desc.get_dst_ptr(i_ev);
 
     int start = copy_desc.get_offset(i_ev);
@@ -514,9 +518,12 @@ __global__ void multi_to_one_cta_per_ev_kernel(CopyDesc copy_desc) {
             src_ev[blockDim.x * i + threadIdx.x]);
       }
     }
+    if (kHasScale) {
+      int average_pooling_factor = copy_desc.get_average_pooling_factor(i_ev);
 #pragma unroll kMaxElemPerThread
-    for (int i = 0; i < kMaxElemPerThread; ++i) {
-      accum[i] /= average_pooling_factor;
+      for (int i = 0; i < kMaxElemPerThread; ++i) {
+        accum[i] /= average_pooling_factor;
+      }
     }
 
 #pragma unroll kMaxElemPerThread
@@ -527,7 +534,7 @@ __global__ void multi_to_one_cta_per_ev_kernel(CopyDesc copy_desc) {
   }
 }
 
-template <typename CopyDesc, int kMaxElemPerThread>
+template <typename CopyDesc, int kMaxElemPerThread, bool kHasScale>
 __global__ void multi_to_one_warp_per_ev_vec4_kernel(CopyDesc copy_desc) {
   using src_type = typename CopyDesc::SrcT;
   using dst_type = typename CopyDesc::DstT;
@@ -541,7 +548,6 @@ __global__ void multi_to_one_warp_per_ev_vec4_kernel(CopyDesc copy_desc) {
   int i_ev = blockIdx.x * blockDim.y + warp_id;
   if (i_ev < copy_desc.num_vec_) {
     vec_length_type vec_length = copy_desc.get_vec_length_(i_ev);
-    int average_pooling_factor = copy_desc.get_average_pooling_factor(i_ev);
 
     int start = copy_desc.get_offset(i_ev);
     int end = copy_desc.get_offset(i_ev + 1);
@@ -569,12 +575,15 @@ __global__ void multi_to_one_warp_per_ev_vec4_kernel(CopyDesc copy_desc) {
       }
     }
 
+    if (kHasScale) {
+      int average_pooling_factor = copy_desc.get_average_pooling_factor(i_ev);
 #pragma unroll kMaxElemPerThread
-    for (int i = 0; i < kMaxElemPerThread; ++i) {
-      accum[i].val.x /= average_pooling_factor;
-      accum[i].val.y /= average_pooling_factor;
-      accum[i].val.z /= average_pooling_factor;
-      accum[i].val.w /= average_pooling_factor;
+      for (int i = 0; i < kMaxElemPerThread; ++i) {
+        accum[i].val.x /= average_pooling_factor;
+        accum[i].val.y /= average_pooling_factor;
+        accum[i].val.z /= average_pooling_factor;
+        accum[i].val.w /= average_pooling_factor;
+      }
     }
 
 #pragma unroll kMaxElemPerThread
@@ -586,7 +595,7 @@ __global__ void multi_to_one_warp_per_ev_vec4_kernel(CopyDesc copy_desc) {
   }
 }
 
-template <typename CopyDesc, int kMaxElemPerThread>
+template <typename CopyDesc, int kMaxElemPerThread, bool kHasScale>
 __global__ void one_to_multi_cta_per_ev_kernel(CopyDesc copy_desc) {
   using src_type = typename CopyDesc::SrcT;
   using dst_type = typename CopyDesc::DstT;
@@ -595,7 +604,6 @@ __global__ void one_to_multi_cta_per_ev_kernel(CopyDesc copy_desc) {
 
   if (i_ev < copy_desc.num_vec_) {
     vec_length_type vec_length = copy_desc.get_vec_length_(i_ev);
-    int average_pooling_factor = copy_desc.get_average_pooling_factor(i_ev);
     const src_type *src_ev = copy_desc.get_src_ptr(i_ev);
     float accum[kMaxElemPerThread] = {0.f};
 #pragma unroll kMaxElemPerThread
@@ -603,9 +611,12 @@ __global__ void one_to_multi_cta_per_ev_kernel(CopyDesc copy_desc) {
       accum[i] = src_ev[blockDim.x * i + threadIdx.x];
     }
 
+    if (kHasScale) {
+      int average_pooling_factor = copy_desc.get_average_pooling_factor(i_ev);
 #pragma unroll kMaxElemPerThread
-    for (int i = 0; i < kMaxElemPerThread; ++i) {
-      accum[i] /= average_pooling_factor;
+      for (int i = 0; i < kMaxElemPerThread; ++i) {
+        accum[i] /= average_pooling_factor;
+      }
     }
 
     int start = copy_desc.get_offset(i_ev);
@@ -621,7 +632,7 @@ __global__ void one_to_multi_cta_per_ev_kernel(CopyDesc copy_desc) {
   }
 }
 
-template <typename CopyDesc, int kMaxElemPerThread>
+template <typename CopyDesc, int kMaxElemPerThread, bool kHasScale>
 __global__ void one_to_multi_warp_per_ev_vec4_kernel(CopyDesc copy_desc) {
   using src_type = typename CopyDesc::SrcT;
   using dst_type = typename CopyDesc::DstT;
@@ -635,7 +646,6 @@ __global__ void one_to_multi_warp_per_ev_vec4_kernel(CopyDesc copy_desc) {
   int i_ev = blockIdx.x * blockDim.y + warp_id;
   if (i_ev < copy_desc.num_vec_) {
     vec_length_type vec_length = copy_desc.get_vec_length_(i_ev);
-    int average_pooling_factor = copy_desc.get_average_pooling_factor(i_ev);
     const src_type *src_ev = copy_desc.get_src_ptr(i_ev);
     Vec4T<float> accum[kMaxElemPerThread];
 
@@ -646,12 +656,15 @@ __global__ void one_to_multi_warp_per_ev_vec4_kernel(CopyDesc copy_desc) {
       accum[i].load(src_ev + idx4, n);
     }
 
+    if (kHasScale) {
+      int average_pooling_factor = copy_desc.get_average_pooling_factor(i_ev);
 #pragma unroll kMaxElemPerThread
-    for (int i = 0; i < kMaxElemPerThread; ++i) {
-      accum[i].val.x /= average_pooling_factor;
-      accum[i].val.y /= average_pooling_factor;
-      accum[i].val.z /= average_pooling_factor;
-      accum[i].val.w /= average_pooling_factor;
+      for (int i = 0; i < kMaxElemPerThread; ++i) {
+        accum[i].val.x /= average_pooling_factor;
+        accum[i].val.y /= average_pooling_factor;
+        accum[i].val.z /= average_pooling_factor;
+        accum[i].val.w /= average_pooling_factor;
+      }
     }
 
     int start = copy_desc.get_offset(i_ev);
@@ -745,35 +758,35 @@ make_MultiToOne_reduce(int num_vec, LambdaKey get_key, LambdaSrcVecLength get_sr
           get_dst_unique_id, get_src_tensor, get_dst_tensor};
 };
 
-template <typename CopyDesc>
-void copy_multi_to_one(CopyDesc copy_desc, int max_ev_size, cudaStream_t stream,
-                       bool backward = false) {
+template <bool kHasScale, typename CopyDesc>
+void copy_multi_to_one_impl(CopyDesc copy_desc, int max_ev_size, cudaStream_t stream,
+                            bool backward) {
   if (max_ev_size <= 128) {
     int grid_size = (copy_desc.num_vec_ - 1) / 2 + 1;
     dim3 block_size{32, 2};
     if (!backward) {
-      multi_to_one_warp_per_ev_vec4_kernel<CopyDesc, 1>
+      multi_to_one_warp_per_ev_vec4_kernel<CopyDesc, 1, kHasScale>
           <<<grid_size, block_size, 0, stream>>>(copy_desc);
     } else {
-      one_to_multi_warp_per_ev_vec4_kernel<CopyDesc, 1>
+      one_to_multi_warp_per_ev_vec4_kernel<CopyDesc, 1, kHasScale>
           <<<grid_size, block_size, 0, stream>>>(copy_desc);
     }
   } else if (max_ev_size <= 256) {
     int grid_size = (copy_desc.num_vec_ - 1) / 2 + 1;
     dim3 block_size{32, 2};
     if (!backward) {
-      multi_to_one_warp_per_ev_vec4_kernel<CopyDesc, 2>
+      multi_to_one_warp_per_ev_vec4_kernel<CopyDesc, 2, kHasScale>
           <<<grid_size, block_size, 0, stream>>>(copy_desc);
     } else {
-      one_to_multi_warp_per_ev_vec4_kernel<CopyDesc, 2>
+      one_to_multi_warp_per_ev_vec4_kernel<CopyDesc, 2, kHasScale>
           <<<grid_size, block_size, 0, stream>>>(copy_desc);
     }
   } else if (max_ev_size <= 1024) {
     if (!backward) {
-      multi_to_one_cta_per_ev_kernel<CopyDesc, 1>
+      multi_to_one_cta_per_ev_kernel<CopyDesc, 1, kHasScale>
           <<<copy_desc.num_vec_, max_ev_size, 0, stream>>>(copy_desc);
     } else {
-      one_to_multi_cta_per_ev_kernel<CopyDesc, 1>
+      one_to_multi_cta_per_ev_kernel<CopyDesc, 1, kHasScale>
           <<<copy_desc.num_vec_, max_ev_size, 0, stream>>>(copy_desc);
     }
   } else {
@@ -781,4 +794,18 @@ void copy_multi_to_one(CopyDesc copy_desc, int max_ev_size, cudaStream_t stream,
                    "HugeCTR does not support emb vector size >= 4096");
   }
 }
+
+// With average_pooling == false (the default, used by every sum/concat path), the
+// get_average_pooling_factor_ lambda in copy_desc is never evaluated and the scaling loop is
+// compiled out of the instantiated kernel. Mean combiners pass true to get the dividing
+// specialization.
+template <typename CopyDesc>
+void copy_multi_to_one(CopyDesc copy_desc, int max_ev_size, cudaStream_t stream,
+                       bool backward = false, bool average_pooling = false) {
+  if (average_pooling) {
+    copy_multi_to_one_impl<true>(copy_desc, max_ev_size, stream, backward);
+  } else {
+    copy_multi_to_one_impl<false>(copy_desc, max_ev_size, stream, backward);
+  }
+}
 }  // namespace embedding
@@ -13,6 +13,8 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <cstdlib>
+
 #include "HugeCTR/include/utils.hpp"
 #include "generic_lookup.cuh"
 #include "model_backward.hpp"
@@ -62,6 +64,12 @@ void ModelBackward::compute(const TensorList& model_comm_buffer, const Tensor& u
   auto stream = core_->get_local_gpu()->get_stream();
   int batch_size_per_gpu = batch_size / num_gpus_;
 
+  // Deterministic mode (HCTR_DETERMINISTIC_EMB_BACKWARD): reduce every unique key's segment of
+  // the sorted bucket id list with one warp walking it in fixed order, instead of the two-stage
+  // atomic reduction below. Bitwise reproducible run-to-run at the cost of losing the
+  // multi-warp parallelism on heavy keys, so keep it for investigation runs only.
+  static const bool deterministic{std::getenv("HCTR_DETERMINISTIC_EMB_BACKWARD") != nullptr};
+
   cudaMemsetAsync(grad_ev_.get(), 0, grad_ev_.nbytes(), core_->get_local_gpu()->get_stream());
   DISPATCH_FLOAT_AND_HALF_FUNCTION(model_comm_buffer.dtype().type(), emb_t, [&] {
     const uint32_t* unique_dst_idx_ptr = unique_dst_idx.get<uint32_t>();
@@ -70,6 +78,29 @@ void ModelBackward::compute(const TensorList& model_comm_buffer, const Tensor& u
     auto stream = core_->get_local_gpu()->get_stream();
     uint32_t* corrdinate_key_ptr = (uint32_t*)corrdinate_key.get();
     uint32_t* sorted_bucket_id_list_ptr = (uint32_t*)sorted_bucket_id_list.get();
+    if (deterministic) {
+      const uint32_t* sorted_bucket_id_offset_ptr = (uint32_t*)sorted_bucket_id_offset.get();
+      float* grad_ev_ptr = grad_ev_.get<float>();
+      auto multi_to_one_desc = make_MultiToOne<emb_t, float>(
+          num_unique_key, [=] __device__(int i) { return sorted_bucket_id_offset_ptr[i]; },
+          [=] __device__(int i) { return 1; },
+          [=] __device__(int i) { return unique_dst_idx_ptr[i + 1] - unique_dst_idx_ptr[i]; },
+          [=] __device__(int i) {
+            uint32_t src_index = sorted_bucket_id_list_ptr[i];
+            int embedding_id = src_index / batch_size;
+            int batch_id = src_index % batch_size;
+            int gpu_id = batch_id / batch_size_per_gpu;
+            int local_batch_id = batch_id % batch_size_per_gpu;
+            int ev_size =
+                local_ev_offset_list_ptr[embedding_id + 1] - local_ev_offset_list_ptr[embedding_id];
+            return model_comm_buffer_ptr[gpu_id] +
+                   batch_size_per_gpu * local_ev_offset_list_ptr[embedding_id] +
+                   local_batch_id * ev_size;
+          },
+          [=] __device__(int i) { return grad_ev_ptr + unique_dst_idx_ptr[i]; });
+      copy_multi_to_one(multi_to_one_desc, max_ev_size, stream);
+      return;
+    }
     uint32_t* coordinate_wgrad_dst_idx_ptr = (uint32_t*)coordinate_wgrad_dst_idx.get();
     auto partial_grad_ev_ptr = (float*)partial_grad_ev_.get();
     auto partial_key_ptr = (uint32_t*)partial_key_.get();
@@ -24,36 +24,58 @@ namespace embedding {
 
 namespace {
 
+// One thread per bucket of every embedding, not just the local ones: the unselected flags
+// are written alongside the selected ones, so the pass covers the whole flag array and the
+// flag/offsets memset launches before this kernel are gone.
 template <typename key_t, typename offset_t>
 __global__ void index_calculation_kernel(const key_t* key, const offset_t* bucket_range,
-                                         const int* local_embedding_list, int shard_id,
-                                         int shards_count, int batch_size, int num_local_embedding,
-                                         uint32_t* model_idx_offsets, char* flag) {
+                                         int num_bucket, const int* local_embedding_list,
+                                         int shard_id, int shards_count, int batch_size,
+                                         int num_local_embedding, uint32_t* model_idx_offsets,
+                                         char* flag) {
   int tid = blockIdx.x * blockDim.x + threadIdx.x;
 
-  if (tid < batch_size * num_local_embedding) {
+  if (tid < num_bucket) {
+    int embedding_id = tid / batch_size;
     int batch_id = tid % batch_size;
-    int embedding_id = local_embedding_list[tid / batch_size];
 
-    uint32_t bucket_start =
-        static_cast<uint32_t>(bucket_range[batch_size * embedding_id + batch_id]);
-    uint32_t bucket_end =
-        static_cast<uint32_t>(bucket_range[batch_size * embedding_id + batch_id + 1]);
+    // local_embedding_list is sorted, so membership is a binary search
+    int local_pos =
+        binary_search_index_lower_bound(local_embedding_list, num_local_embedding, embedding_id);
+    bool is_local = (local_pos >= 0 && local_embedding_list[local_pos] == embedding_id);
+
+    uint32_t bucket_start = static_cast<uint32_t>(bucket_range[tid]);
+    uint32_t bucket_end = static_cast<uint32_t>(bucket_range[tid + 1]);
     uint32_t flag_cnt = 0;
-    for (uint32_t idx = 0; idx < (bucket_end - bucket_start); ++idx) {
-      key_t k = key[idx + bucket_start];
-      if (k % shards_count == shard_id) {
-        flag[idx + bucket_start] = 1;
-        flag_cnt += 1;
+    for (uint32_t idx = bucket_start; idx < bucket_end; ++idx) {
+      char f = 0;
+      if (is_local) {
+        key_t k = key[idx];
+        f = (k % shards_count == shard_id) ? 1 : 0;
       }
+      flag[idx] = f;
+      flag_cnt += f;
+    }
+    if (is_local) {
+      model_idx_offsets[1 + local_pos * batch_size + batch_id] = flag_cnt;
     }
-    model_idx_offsets[1 + tid] = flag_cnt;
     if (tid == 0) {
       model_idx_offsets[0] = 0;
     }
   }
 }
 
+// strided gather of the scanned offsets; running it here instead of the separate
+// CompressOffset pass keeps the whole index calculation in one operator
+__global__ void fused_compress_offset_kernel(const uint32_t* offset, int num, int stride,
+                                             uint32_t* compressed_offset) {
+  int thread_cnt = blockDim.x * blockDim.y;
+
+  for (int tid = threadIdx.x + threadIdx.y * blockDim.x; tid < num; tid += thread_cnt) {
+    compressed_offset[tid] = offset[tid * stride];
+  }
+}
+
 __global__ void expand_bucket_id_kernel(const uint32_t* model_offset, uint32_t* bucket_idx,
                                         int batch_size, int num_local_embedding,
                                         int batch_size_per_gpu) {
@@ -272,6 +294,8 @@ ModelIndexCalculation::ModelIndexCalculation(std::shared_ptr<CoreResourceManager
   num_model_key_ = buffer_ptr_->reserve({1}, DeviceType::CPU, TensorScalarType::Size_t);
   flag_ = buffer_ptr_->reserve({universal_batch_size_ * hotness_list_sum_}, device,
                                TensorScalarType::Char);
+  id_space_offset_ =
+      buffer_ptr_->reserve({num_local_embedding_ + 1}, device, TensorScalarType::UInt32);
   {
     size_t temp_bytes = 0;
     cub::DeviceScan::InclusiveSum(nullptr, temp_bytes, (uint32_t*)nullptr, (uint32_t*)nullptr,
@@ -293,7 +317,8 @@ ModelIndexCalculation::ModelIndexCalculation(std::shared_ptr<CoreResourceManager
 void ModelIndexCalculation::compute(const Tensor& key, const Tensor& bucket_range, size_t num_key,
                                     const Tensor& d_local_embedding_list, int shard_id,
                                     int shards_count, int batch_size, Tensor* model_key,
-                                    Tensor* model_idx_offsets, size_t* num_model_key) {
+                                    Tensor* model_idx_offsets, size_t* num_model_key,
+                                    Tensor* id_space_offset) {
   HugeCTR::CudaDeviceContext ctx(core_->get_device_id());
 
   *(num_model_key_.get<size_t>()) = 0;
@@ -302,11 +327,9 @@ void ModelIndexCalculation::compute(const Tensor& key, const Tensor& bucket_rang
       DISPATCH_INTEGRAL_FUNCTION(bucket_range.dtype().type(), offset_t, [&] {
         auto stream = core_->get_local_gpu()->get_stream();
 
-        HCTR_LIB_THROW(cudaMemsetAsync(model_key_.get(), 0, model_key_.nbytes(), stream));
-        HCTR_LIB_THROW(
-            cudaMemsetAsync(model_idx_offsets_.get(), 0, model_idx_offsets_.nbytes(), stream));
-        HCTR_LIB_THROW(cudaMemsetAsync(flag_.get(), 0, flag_.nbytes(), stream));
-
+        // DeviceSelect::Flagged compacts exactly num_model_key keys into the front of
+        // model_key_, and every consumer is bounded by that count, so the padded tail needs
+        // no clearing.
         key_t* model_key_ptr = model_key_.get<key_t>();
         uint32_t* model_idx_offsets_ptr = model_idx_offsets_.get<uint32_t>();
         size_t* num_model_key_ptr = num_model_key_.get<size_t>();
@@ -315,19 +338,25 @@ void ModelIndexCalculation::compute(const Tensor& key, const Tensor& bucket_rang
         const offset_t* bucket_range_ptr = bucket_range.get<offset_t>();
         const int* local_embedding_list_ptr = d_local_embedding_list.get<int>();
 
-        // in cub implementation, the flag must be 0 or 1. See
-        // https://github.com/NVIDIA/cub/issues/235 we can fuse thie memset with next kernel
+        // the fused kernel fully covers the flag array (cub needs flags that are 0 or 1,
+        // see https://github.com/NVIDIA/cub/issues/235) and the offsets, so neither buffer
+        // needs its memset pass anymore
+        int num_bucket = static_cast<int>(bucket_range.get_num_elements()) - 1;
         int thread_cnt = 128;
-        int block_cnt = (batch_size * num_local_embedding_ - 1) / thread_cnt + 1;
+        int block_cnt = (num_bucket - 1) / thread_cnt + 1;
         index_calculation_kernel<<<block_cnt, thread_cnt, 0, stream>>>(
-            key_ptr, bucket_range_ptr, local_embedding_list_ptr, shard_id, shards_count, batch_size,
-            num_local_embedding_, model_idx_offsets_ptr, flag_ptr);
+            key_ptr, bucket_range_ptr, num_bucket, local_embedding_list_ptr, shard_id,
+            shards_count, batch_size, num_local_embedding_, model_idx_offsets_ptr, flag_ptr);
 
         size_t d_temp_scan_storage_nbytes = d_temp_scan_storage_.nbytes();
         cub::DeviceScan::InclusiveSum(d_temp_scan_storage_.get(), d_temp_scan_storage_nbytes,
                                       model_idx_offsets_ptr, model_idx_offsets_ptr,
                                       batch_size * num_local_embedding_ + 1, stream);
 
+        fused_compress_offset_kernel<<<1, dim3(32, 8), 0, stream>>>(
+            model_idx_offsets_ptr, num_local_embedding_ + 1, batch_size,
+            id_space_offset_.get<uint32_t>());
+
         size_t d_temp_select_storage_nbytes = d_temp_select_storage_.nbytes();
         cub::DeviceSelect::Flagged(d_temp_select_storage_.get(), d_temp_select_storage_nbytes,
                                    key_ptr, flag_ptr, model_key_ptr, num_model_key_ptr, num_key,
@@ -339,6 +368,7 @@ void ModelIndexCalculation::compute(const Tensor& key, const Tensor& bucket_rang
   *model_key = model_key_;
   *model_idx_offsets = model_idx_offsets_;
   *num_model_key = *(num_model_key_.get<size_t>());
+  *id_space_offset = id_space_offset_;
 }
 
 ModelBackwardIndexCalculation::ModelBackwardIndexCalculation(
@@ -449,21 +479,12 @@ void ModelBackwardIndexCalculation::compute(
   DISPATCH_INTEGRAL_FUNCTION(model_key.dtype().type(), key_t, [&] {
     auto stream = core_->get_local_gpu()->get_stream();
 
+    // All the intermediate buffers are sized by the max hotness, but the kernels and scans
+    // below only touch the first num_model_key (resp. num_unique_key) entries and every
+    // consumer is bounded by those counts, so no full-capacity clearing pass is needed. The
+    // only element no kernel covers is the leading 0 of the run-length offsets.
     HCTR_LIB_THROW(
-        cudaMemsetAsync(bucket_id_list_.get<uint32_t>(), 0, bucket_id_list_.nbytes(), stream));
-    HCTR_LIB_THROW(cudaMemsetAsync(sorted_local_index_.get<uint32_t>(), 0,
-                                   sorted_local_index_.nbytes(), stream));
-    HCTR_LIB_THROW(cudaMemsetAsync(unique_local_index_.get<uint32_t>(), 0,
-                                   unique_local_index_.nbytes(), stream));
-    HCTR_LIB_THROW(cudaMemsetAsync(unique_key_.get<key_t>(), 0, unique_key_.nbytes(), stream));
-    HCTR_LIB_THROW(
-        cudaMemsetAsync(unique_dst_idx_.get<uint32_t>(), 0, unique_dst_idx_.nbytes(), stream));
-    HCTR_LIB_THROW(cudaMemsetAsync(coordinate_wgrad_dst_idx_.get<uint32_t>(), 0,
-                                   coordinate_wgrad_dst_idx_.nbytes(), stream));
-    HCTR_LIB_THROW(cudaMemsetAsync(sorted_bucket_id_list_.get<uint32_t>(), 0,
-                                   sorted_bucket_id_list_.nbytes(), stream));
-    HCTR_LIB_THROW(cudaMemsetAsync(sorted_bucket_id_offset_.get<uint32_t>(), 0,
-                                   sorted_bucket_id_offset_.nbytes(), stream));
+        cudaMemsetAsync(sorted_bucket_id_offset_.get<uint32_t>(), 0, sizeof(uint32_t), stream));
     if (num_local_embedding_ > 0 && num_model_key > 0ul) {
       {
         // this can be fused with sort pair in 4th code
@@ -535,22 +556,27 @@ void ModelBackwardIndexCalculation::compute(
       }
       HCTR_LIB_THROW(cudaStreamSynchronize(stream));
       {
+        // Scan only the entries that carry data for this batch: the buffers are sized by the
+        // max hotness, but everything past num_unique_key (resp. num_model_key) is padding
+        // that no consumer reads, so scanning it would be pure overhead for ragged inputs.
+        int num_unique_key_host = static_cast<int>(*num_unique_key_.get<size_t>());
         size_t nbytes = d_temp_scan_encode_storage_.nbytes();
         cub::DeviceScan::InclusiveSum(d_temp_scan_encode_storage_.get(), nbytes,
                                       unique_id_space_offset_.get<uint32_t>(),
                                       unique_id_space_offset_.get<uint32_t>(),
                                       unique_id_space_offset_.get_num_elements(), stream);
-        cub::DeviceScan::InclusiveSum(
-            d_temp_scan_encode_storage_.get(), nbytes, unique_dst_idx_.get<uint32_t>(),
-            unique_dst_idx_.get<uint32_t>(), unique_dst_idx_.get_num_elements(), stream);
+        cub::DeviceScan::InclusiveSum(d_temp_scan_encode_storage_.get(), nbytes,
+                                      unique_dst_idx_.get<uint32_t>(),
+                                      unique_dst_idx_.get<uint32_t>(), 1 + num_unique_key_host,
+                                      stream);
         cub::DeviceScan::InclusiveSum(d_temp_scan_encode_storage_.get(), nbytes,
                                       coordinate_wgrad_dst_idx_.get<uint32_t>(),
-                                      coordinate_wgrad_dst_idx_.get<uint32_t>(),
-                                      coordinate_wgrad_dst_idx_.get_num_elements(), stream);
+                                      coordinate_wgrad_dst_idx_.get<uint32_t>(), num_model_key,
+                                      stream);
         cub::DeviceScan::InclusiveSum(d_temp_scan_encode_storage_.get(), nbytes,
                                       sorted_bucket_id_offset_.get<uint32_t>(),
                                       sorted_bucket_id_offset_.get<uint32_t>(),
-                                      sorted_bucket_id_offset_.get_num_elements(), stream);
+                                      1 + num_unique_key_host, stream);
       }
       HCTR_LIB_THROW(cudaStreamSynchronize(stream));
     }
@@ -39,6 +39,7 @@ class ModelIndexCalculation {
   Tensor num_key_in_bucket_for_combiner_;
   Tensor num_model_key_;
   Tensor flag_;
+  Tensor id_space_offset_;
 
   Tensor d_temp_scan_storage_;
   Tensor d_temp_select_storage_;
@@ -53,7 +54,8 @@ class ModelIndexCalculation {
 
   void compute(const Tensor& key, const Tensor& bucket_range, size_t num_key,
                const Tensor& d_local_embedding_list, int shard_id, int shards_count, int batch_size,
-               Tensor* model_key, Tensor* model_idx_offsets, size_t* num_model_key);
+               Tensor* model_key, Tensor* model_idx_offsets, size_t* num_model_key,
+               Tensor* id_space_offset);
 };
 
 class ModelBackwardIndexCalculation {
@@ -41,6 +41,16 @@ class NetworkForward {
                const Tensor& network_dst_lookup_ids, const TensorList& network_ev_sizes,
                const TensorList& network_ev_offsets, Tensor& output_buffer,
                const Tensor& d_ev_size_offset, int batch_size, int max_ev_size);
+
+  // Fused-combiner variant: folds the average division into the single gather pass, so the
+  // combined result lands directly in the dense-network input buffer and no intermediate
+  // float buffer or second pass is needed for average-combiner lookups.
+  void compute(const TensorList& network_comm_buffer, const Tensor& network_ids,
+               const Tensor& network_gpu_ids, const Tensor& network_offsets,
+               const Tensor& network_dst_lookup_ids, const TensorList& network_ev_sizes,
+               const TensorList& network_ev_offsets, const Tensor& bucket_range,
+               const Tensor& d_combiner_list, Tensor& output_buffer,
+               const Tensor& d_ev_size_offset, int batch_size, int max_ev_size);
 };
 
 }  // namespace embedding
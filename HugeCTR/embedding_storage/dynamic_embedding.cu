@@ -1,6 +1,7 @@
 #include <cuda_runtime_api.h>
 #include <curand_kernel.h>
 
+#include <cstdlib>
 #include <cub/cub.cuh>
 
 #include "HugeCTR/core/registry.hpp"
@@ -28,6 +29,14 @@ DynamicEmbeddingTable::DynamicEmbeddingTable(
       opt_param_(global_emb_table_param_list[0].opt_param) {
   CudaDeviceContext ctx(core_->get_device_id());
 
+  // Pre-grow the table on a low-priority stream so submap allocation does not stall the
+  // training stream once the table fills up during online training.
+  if (std::getenv("HCTR_DET_ASYNC_GROWTH")) {
+    async_growth_ = true;
+    HCTR_LOG_S(INFO, ROOT) << "HCTR_DET_ASYNC_GROWTH is set. DynamicEmbeddingTable grows "
+                              "its capacity in the background." << std::endl;
+  }
+
   DISPATCH_INTEGRAL_FUNCTION(key_type_.type(), key_t, [&] {
     std::vector<size_t> dim_per_class;
     for (int emb_id : sharding_param.local_embedding_list) {
@@ -95,6 +104,12 @@ void DynamicEmbeddingTable::lookup(const Tensor &keys, size_t num_keys,
                            mapped_id_space_list.data(), id_space_offset_cpu.data(),
                            num_id_space_offset - 1, stream);
       HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+
+      // Keep enough headroom for the next batch of unseen keys in every class so the
+      // blocking reserve inside lookup stays a no-op.
+      if (async_growth_) {
+        table->reserve_async(2 * num_keys);
+      }
     });
   }
 }
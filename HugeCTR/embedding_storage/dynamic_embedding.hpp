@@ -16,6 +16,7 @@ class DynamicEmbeddingTable final : public IDynamicEmbeddingTable {
   std::map<size_t, size_t> global_to_local_id_space_map_;
 
   HugeCTR::OptParams opt_param_;
+  bool async_growth_{false};
 
  public:
   DynamicEmbeddingTable(std::shared_ptr<CoreResourceManager> core,
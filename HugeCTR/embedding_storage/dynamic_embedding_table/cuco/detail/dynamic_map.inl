@@ -42,6 +42,10 @@ void dynamic_map<Key, Element, Initializer>::initialize(cudaStream_t stream) {
   CUCO_CUDA_TRY(
     cudaMemcpyAsync(ptr, h_ptr, sizeof(atomic_ctr_type) * 2, cudaMemcpyHostToDevice, stream));
 
+  int least_priority, greatest_priority;
+  CUCO_CUDA_TRY(cudaDeviceGetStreamPriorityRange(&least_priority, &greatest_priority));
+  CUCO_CUDA_TRY(cudaStreamCreateWithPriority(&growth_stream_, cudaStreamNonBlocking, least_priority));
+  CUCO_CUDA_TRY(cudaEventCreateWithFlags(&growth_event_, cudaEventDisableTiming));
 }
 
 template <typename Key, typename Element, typename Initializer>
@@ -51,6 +55,8 @@ void dynamic_map<Key, Element, Initializer>::uninitialize(cudaStream_t stream) {
   }
   CUCO_ASSERT_CUDA_SUCCESS(cudaFree(reinterpret_cast<void *>(occupied_size_per_submap_)));
   CUCO_ASSERT_CUDA_SUCCESS(cudaFreeHost(reinterpret_cast<void *>(h_occupied_size_per_submap_)));
+  CUCO_ASSERT_CUDA_SUCCESS(cudaEventDestroy(growth_event_));
+  CUCO_ASSERT_CUDA_SUCCESS(cudaStreamDestroy(growth_stream_));
 }
 
 template <typename Key, typename Element, typename Initializer>
@@ -81,11 +87,25 @@ void dynamic_map<Key, Element, Initializer>::reserve(size_t n, cudaStream_t stre
   }
 }
 
+template <typename Key, typename Element, typename Initializer>
+void dynamic_map<Key, Element, Initializer>::reserve_async(size_t n) {
+  size_t num_submaps = submaps_.size();
+  reserve(n, growth_stream_);
+  if (submaps_.size() != num_submaps) {
+    CUCO_CUDA_TRY(cudaEventRecord(growth_event_, growth_stream_));
+    growth_pending_ = true;
+  }
+}
+
 template <typename Key, typename Element, typename Initializer>
 template <typename Hash>
 void dynamic_map<Key, Element, Initializer>::lookup(key_type const *keys, element_type *values, size_t num_keys, cudaStream_t stream, Hash hash) {
   size_t num_to_insert = num_keys;
   reserve(get_size() + num_to_insert, stream);
+  if (growth_pending_) {
+    CUCO_CUDA_TRY(cudaStreamWaitEvent(stream, growth_event_));
+    growth_pending_ = false;
+  }
 
   uint32_t submap_idx = 0;
   while (num_to_insert > 0) {
@@ -121,6 +141,10 @@ template <typename Hash>
 void dynamic_map<Key, Element, Initializer>::lookup_unsafe(key_type const *keys, element_type **values, size_t num_keys, cudaStream_t stream, Hash hash) {
   size_t num_to_insert = num_keys;
   reserve(get_size() + num_to_insert, stream);
+  if (growth_pending_) {
+    CUCO_CUDA_TRY(cudaStreamWaitEvent(stream, growth_event_));
+    growth_pending_ = false;
+  }
 
   uint32_t submap_idx = 0;
   while (num_to_insert > 0) {
@@ -106,6 +106,19 @@ class dynamic_map {
    */
   void reserve(size_t n, cudaStream_t stream = 0);
 
+  /**
+   * @brief Grows the capacity of the map on the internal low-priority growth
+   * stream so the next submap is allocated and initialized in the background
+   * instead of stalling the stream the lookups run on.
+   *
+   * Operations that may insert into the map order themselves after the
+   * in-flight growth with a stream wait, so callers only pay for the growth
+   * when they reach the new submap before it is ready.
+   *
+   * @param n The number of key value pairs for which there must be space
+   */
+  void reserve_async(size_t n);
+
   template <typename Hash = cuco::detail::MurmurHash3_32<key_type>>
   void lookup(key_type const *keys, element_type *values, size_t num_keys, cudaStream_t stream = 0,
               Hash hash = Hash{});
@@ -174,6 +187,10 @@ class dynamic_map {
   atomic_ctr_type *h_reclaimed_size_per_submap_;
   atomic_ctr_type *h_num_successes_;
 
+  cudaStream_t growth_stream_{nullptr};  ///< low-priority stream for background growth
+  cudaEvent_t growth_event_;             ///< completion of the last background growth
+  bool growth_pending_{false};           ///< a background growth has not been waited on yet
+
   Initializer initializer_{};
 };
 }  // namespace cuco
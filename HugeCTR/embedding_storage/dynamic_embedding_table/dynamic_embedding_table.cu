@@ -196,6 +196,14 @@ void DynamicEmbeddingTable<KeyType, ElementType>::remove(KeyType const *keys, si
   CUCO_CUDA_TRY(cudaGetLastError());
 }
 
+template <typename KeyType, typename ElementType>
+void DynamicEmbeddingTable<KeyType, ElementType>::reserve_async(size_t num_keys_per_class) {
+  for (size_t i = 0; i < num_classes_; i++) {
+    maps_[i]->reserve_async(maps_[i]->get_size() + num_keys_per_class);
+  }
+  CUCO_CUDA_TRY(cudaGetLastError());
+}
+
 template <typename KeyType, typename ElementType>
 void DynamicEmbeddingTable<KeyType, ElementType>::eXport(size_t class_index, KeyType *d_keys,
                                                          ElementType *d_values, size_t num_keys,
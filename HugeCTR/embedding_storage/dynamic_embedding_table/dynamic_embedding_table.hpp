@@ -51,6 +51,7 @@ class DynamicEmbeddingTable {
                    cudaStream_t stream = 0);
   void remove(KeyType const *keys, size_t num_keys, size_t const *id_spaces,
               size_t const *id_space_offsets, size_t num_id_spaces, cudaStream_t stream = 0);
+  void reserve_async(size_t num_keys_per_class);
   void eXport(size_t class_index, KeyType *keys, ElementType *values, size_t num_keys,
               cudaStream_t stream = 0);
   void clear(cudaStream_t stream = 0);
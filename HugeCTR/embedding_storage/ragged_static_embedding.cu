@@ -28,12 +28,26 @@ namespace embedding {
 
 namespace {
 
+// Each table segment stores an arithmetic key sequence by construction (a shard keeps the
+// keys with k % shards_count == shard_id, in increasing order), so the location of a key
+// is computable without searching. key_stride == 0 falls back to the binary search for
+// tables populated with an arbitrary key set.
+template <typename key_t>
+__device__ __forceinline__ int locate_key(const key_t *key_location, int num_keys, key_t k,
+                                          int key_stride) {
+  if (key_stride > 0) {
+    return static_cast<int>((k - key_location[0]) / key_stride);
+  }
+  return binary_search_index_lower_bound(key_location, num_keys, k);
+}
+
 template <typename key_t, typename index_t>
 __global__ void ragged_static_embedding_table_lookup_kernel(
     const key_t *key, size_t num_keys, const uint32_t *id_space_offset, size_t num_id_space_offset,
     const int *id_space_list, const int *local_id_space_list, size_t num_local_id_space_list,
     const key_t *key_location, const index_t *emb_table_id_space_offset, float *emb_table,
-    const uint64_t *emb_table_ev_offset, const int *local_ev_size_list, float **emb_vec) {
+    const uint64_t *emb_table_ev_offset, const int *local_ev_size_list,
+    const int *key_stride_list, float **emb_vec) {
   uint32_t tid = threadIdx.x + blockIdx.x * blockDim.x;
   if (tid >= num_keys) return;
   int id_space_idx = binary_search_index_lower_bound(id_space_offset, num_id_space_offset, tid);
@@ -47,7 +61,8 @@ __global__ void ragged_static_embedding_table_lookup_kernel(
   index_t end = emb_table_id_space_offset[local_id_space_idx + 1];
   key_t k = key[tid];
 
-  int idx = binary_search_index_lower_bound(key_location + start, end - start, k);
+  int idx = locate_key(key_location + start, static_cast<int>(end - start), k,
+                       key_stride_list[local_id_space_idx]);
   assert(idx >= 0);
 
   uint64_t ev_offset = emb_table_ev_offset[local_id_space_idx];
@@ -76,7 +91,7 @@ __global__ void update_kernel(const key_t *keys, size_t num_keys, const uint32_t
                               const int *local_id_space_list, size_t num_local_id_space_list,
                               const key_t *key_location, const index_t *emb_table_id_space_offset,
                               float *emb_table, const uint64_t *emb_table_ev_offset,
-                              const int *local_ev_size_list) {
+                              const int *local_ev_size_list, const int *key_stride_list) {
   uint32_t tid = threadIdx.x + blockIdx.x * blockDim.x;
   if (tid >= num_keys) return;
 
@@ -91,7 +106,8 @@ __global__ void update_kernel(const key_t *keys, size_t num_keys, const uint32_t
   index_t end = emb_table_id_space_offset[local_id_space_idx + 1];
   key_t k = keys[tid];
 
-  int idx = binary_search_index_lower_bound(key_location + start, end - start, k);
+  int idx = locate_key(key_location + start, static_cast<int>(end - start), k,
+                       key_stride_list[local_id_space_idx]);
   assert(idx >= 0);
 
   uint64_t ev_offset = emb_table_ev_offset[local_id_space_idx];
@@ -123,6 +139,7 @@ RaggedStaticEmbeddingTable::RaggedStaticEmbeddingTable(
 
       std::vector<uint64_t> cpu_emb_table_ev_offset{0};
       std::vector<int> cpu_local_ev_size_list;
+      std::vector<int> cpu_key_stride_list;
 
       std::set<int> id_space_set;
       for (int emb_id : sharding_param.local_embedding_list) {
@@ -143,6 +160,7 @@ RaggedStaticEmbeddingTable::RaggedStaticEmbeddingTable(
           uint64_t segment_emb_table_size = id_space_count * emb_table_param.ev_size;
           cpu_emb_table_ev_offset.push_back(segment_emb_table_size);
           cpu_local_ev_size_list.push_back(emb_table_param.ev_size);
+          cpu_key_stride_list.push_back(sharding_param.shards_count);
           emb_table_size_ += segment_emb_table_size;
         }
         id_space_set.insert(id_space);
@@ -164,6 +182,8 @@ RaggedStaticEmbeddingTable::RaggedStaticEmbeddingTable(
                                                  TensorScalarType::UInt64);
       local_ev_size_list_ = buffer_ptr->reserve(cpu_local_ev_size_list.size(), DeviceType::GPU,
                                                 TensorScalarType::Int32);
+      key_stride_list_ =
+          buffer_ptr->reserve(cpu_key_stride_list.size(), DeviceType::GPU, TensorScalarType::Int32);
       buffer_ptr->allocate();
 
       table_ids_.copy_from(cpu_local_id_space_list);
@@ -171,6 +191,7 @@ RaggedStaticEmbeddingTable::RaggedStaticEmbeddingTable(
       num_key_per_table_offset_.copy_from(cpu_id_space_offset);
       emb_table_ev_offset_.copy_from(cpu_emb_table_ev_offset);
       local_ev_size_list_.copy_from(cpu_local_ev_size_list);
+      key_stride_list_.copy_from(cpu_key_stride_list);
 
       for (size_t embedding = 0; embedding < cpu_local_id_space_list.size(); embedding++) {
         int id_space = cpu_local_id_space_list[embedding];
@@ -261,6 +282,7 @@ RaggedStaticEmbeddingTable::RaggedStaticEmbeddingTable(
 
       std::vector<uint64_t> cpu_emb_table_ev_offset{0};
       std::vector<int> cpu_local_ev_size_list;
+      std::vector<int> cpu_key_stride_list;
 
       std::unordered_map<int, int> id_space_shard_id_mapping;
       for (int emb_id = 0; emb_id < ebc_param.num_embedding; ++emb_id) {
@@ -285,6 +307,7 @@ RaggedStaticEmbeddingTable::RaggedStaticEmbeddingTable(
           uint64_t segment_emb_table_size = id_space_count * emb_table_param.ev_size;
           cpu_emb_table_ev_offset.push_back(segment_emb_table_size);
           cpu_local_ev_size_list.push_back(emb_table_param.ev_size);
+          cpu_key_stride_list.push_back(shard_count);
           emb_table_size_ += segment_emb_table_size;
           id_space_shard_id_mapping[id_space] = shard_id;
         }
@@ -308,6 +331,8 @@ RaggedStaticEmbeddingTable::RaggedStaticEmbeddingTable(
                                                  TensorScalarType::UInt64);
       local_ev_size_list_ = buffer_ptr->reserve(cpu_local_ev_size_list.size(), DeviceType::GPU,
                                                 TensorScalarType::Int32);
+      key_stride_list_ =
+          buffer_ptr->reserve(cpu_key_stride_list.size(), DeviceType::GPU, TensorScalarType::Int32);
       buffer_ptr->allocate();
 
       table_ids_.copy_from(cpu_local_id_space_list);
@@ -315,6 +340,7 @@ RaggedStaticEmbeddingTable::RaggedStaticEmbeddingTable(
       num_key_per_table_offset_.copy_from(cpu_id_space_offset);
       emb_table_ev_offset_.copy_from(cpu_emb_table_ev_offset);
       local_ev_size_list_.copy_from(cpu_local_ev_size_list);
+      key_stride_list_.copy_from(cpu_key_stride_list);
 
       auto uniform_init_table = [&](const curandGenerator_t &generator) {
         const size_t num_tables = cpu_local_id_space_list.size();
@@ -361,6 +387,7 @@ RaggedStaticEmbeddingTable::RaggedStaticEmbeddingTable(
 
       std::vector<uint64_t> h_emb_table_ev_offset{0};
       std::vector<int> h_local_ev_sizes;
+      std::vector<int> h_key_strides;
 
       const auto &emb_param = ebc_param.emb_params[emb_id];
       if (emb_param.table_placement_strategy == TablePlacementStrategy::DataParallel) {
@@ -377,6 +404,7 @@ RaggedStaticEmbeddingTable::RaggedStaticEmbeddingTable(
           uint64_t segment_emb_table_size = num_key * table_params[table_id].ev_size;
           h_emb_table_ev_offset.push_back(segment_emb_table_size);
           h_local_ev_sizes.push_back(table_params[table_id].ev_size);
+          h_key_strides.push_back(1);
           emb_table_size_ += segment_emb_table_size;
         }
       } else if (emb_param.table_placement_strategy == TablePlacementStrategy::ModelParallel) {
@@ -411,6 +439,7 @@ RaggedStaticEmbeddingTable::RaggedStaticEmbeddingTable(
           uint64_t segment_emb_table_size = num_key * table_params[table_id].ev_size;
           h_emb_table_ev_offset.push_back(segment_emb_table_size);
           h_local_ev_sizes.push_back(table_params[table_id].ev_size);
+          h_key_strides.push_back(num_shards);
           emb_table_size_ += segment_emb_table_size;
         }
       }
@@ -431,6 +460,8 @@ RaggedStaticEmbeddingTable::RaggedStaticEmbeddingTable(
                                                  TensorScalarType::UInt64);
       local_ev_size_list_ =
           buffer_ptr->reserve(h_local_ev_sizes.size(), DeviceType::GPU, TensorScalarType::Int32);
+      key_stride_list_ =
+          buffer_ptr->reserve(h_key_strides.size(), DeviceType::GPU, TensorScalarType::Int32);
       buffer_ptr->allocate();
 
       table_ids_.copy_from(h_table_ids_);
@@ -438,6 +469,7 @@ RaggedStaticEmbeddingTable::RaggedStaticEmbeddingTable(
       num_key_per_table_offset_.copy_from(h_num_key_per_table_offset);
       emb_table_ev_offset_.copy_from(h_emb_table_ev_offset);
       local_ev_size_list_.copy_from(h_local_ev_sizes);
+      key_stride_list_.copy_from(h_key_strides);
 
       auto uniform_init_table = [&](const curandGenerator_t &generator) {
         const size_t num_tables = h_table_ids_.size();
@@ -486,7 +518,7 @@ void RaggedStaticEmbeddingTable::lookup(const Tensor &keys, size_t num_keys,
             id_space_list.get<int>(), table_ids_.get<int>(), table_ids_.get_num_elements(),
             keys_.get<key_t>(), num_key_per_table_offset_.get<index_t>(), emb_table_.get<float>(),
             emb_table_ev_offset_.get<uint64_t>(), local_ev_size_list_.get<int>(),
-            emb_vec.get<float>());
+            key_stride_list_.get<int>(), emb_vec.get<float>());
       }
 
       HCTR_LIB_THROW(cudaPeekAtLastError());
@@ -525,7 +557,8 @@ void RaggedStaticEmbeddingTable::update(const Tensor &keys, size_t num_keys,
             grad_ev.get<float>(), grad_ev_offset.get<uint32_t>(), id_space_list.get<int>(),
             table_ids_.get<int>(), table_ids_.get_num_elements(), keys_.get<key_t>(),
             num_key_per_table_offset_.get<index_t>(), emb_table_.get<float>(),
-            emb_table_ev_offset_.get<uint64_t>(), local_ev_size_list_.get<int>());
+            emb_table_ev_offset_.get<uint64_t>(), local_ev_size_list_.get<int>(),
+            key_stride_list_.get<int>());
       }
     });
   });
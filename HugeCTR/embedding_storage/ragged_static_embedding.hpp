@@ -30,6 +30,7 @@ class RaggedStaticEmbeddingTable final : public IGroupedEmbeddingTable {
   Tensor emb_table_;
   Tensor emb_table_ev_offset_;  // num_local_id_space + 1
   Tensor local_ev_size_list_;   // num_local_id_space
+  Tensor key_stride_list_;      // num_local_id_space, stride of the arithmetic key sequence
 
   HugeCTR::OptParams opt_param_;
 
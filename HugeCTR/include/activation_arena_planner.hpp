@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <map>
+#include <set>
+#include <tensor2.hpp>
+#include <vector>
+
+namespace HugeCTR {
+
+/**
+ * @brief Liveness-based offset planner for activation tensors.
+ *
+ * In a forward-only network an activation is dead as soon as its last consumer has run, so
+ * activations with disjoint lifetimes can share the same memory. The planner is fed the
+ * input and output tensors of every layer in execution order, derives a live interval per
+ * underlying buffer, and packs the buffers into a shared arena with a first-fit-decreasing
+ * placement. GeneralBuffer2 consumes the resulting offsets through
+ * set_overlapped_offsets().
+ *
+ * A buffer first seen as a layer input is written before the first layer runs (by the data
+ * reader or an embedding), so it is treated as live from the start. Buffers that are read
+ * after the network finishes, such as the prediction tensor, must be excluded with pin().
+ */
+class ActivationArenaPlanner {
+ public:
+  /** Record one layer in execution order with its input and output tensors. */
+  void add_layer(const std::vector<TensorBag2>& inputs, const std::vector<TensorBag2>& outputs);
+
+  /** Exclude a tensor from the arena so it keeps its own dedicated allocation. */
+  void pin(const TensorBag2& bag);
+
+  /**
+   * Compute the arena placement.
+   * @param offsets filled with the arena offset of every placed buffer
+   * @return the required arena size in bytes
+   */
+  size_t plan(std::map<TensorBuffer2*, size_t>* offsets) const;
+
+  /** Sum of the placed buffer sizes, i.e. what the activations occupy without reuse. */
+  size_t get_total_size_in_bytes() const;
+
+ private:
+  struct Interval {
+    size_t size_in_bytes;
+    int first;
+    int last;
+  };
+
+  std::vector<TensorBuffer2*> order_;  // buffers in first-touch order, for stable planning
+  std::map<TensorBuffer2*, Interval> intervals_;
+  std::set<TensorBuffer2*> pinned_;
+  int num_layers_{0};
+};
+
+}  // namespace HugeCTR
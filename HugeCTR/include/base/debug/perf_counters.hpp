@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+
+namespace HugeCTR {
+
+/**
+ * Process-wide registry of machine-scrapable performance counters.
+ *
+ * Unlike the logging timers and the profiler hooks, which produce human-readable output, this
+ * registry keeps named monotonic counters and gauges that monitoring systems can poll. Series
+ * names carry their Prometheus labels pre-formatted, e.g.
+ *
+ *   hugectr_embedding_cache_queries_total{model="dcn",device="0"}
+ *
+ * so the registry itself stays a flat name -> value map. Series that share the name before the
+ * opening brace form one metric family in the exported text.
+ *
+ * Hot call sites should resolve the series once via counter() and cache the returned reference;
+ * the atomic it refers to is never moved or freed for the lifetime of the process.
+ *
+ * When the env variable 'HCTR_PROMETHEUS_TEXTFILE' is set to a file path, a background thread
+ * periodically rewrites that file in the Prometheus text exposition format (atomically, via a
+ * temporary file and rename), so a node-exporter textfile collector can scrape it. The rewrite
+ * interval in seconds is controlled by 'HCTR_PROMETHEUS_INTERVAL_SEC' (default: 15).
+ */
+class PerfCounters {
+ public:
+  static PerfCounters& get();
+
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+  ~PerfCounters();
+
+  /**
+   * Get (registering on first use) the monotonic counter for `series`. The reference stays
+   * valid for the process lifetime, so callers on hot paths should look it up once.
+   */
+  std::atomic<uint64_t>& counter(const std::string& series);
+
+  /**
+   * Convenience increment for call sites that are not latency sensitive.
+   */
+  void inc(const std::string& series, uint64_t delta = 1);
+
+  /**
+   * Set the gauge for `series` (registering on first use) to `value`.
+   */
+  void set_gauge(const std::string& series, double value);
+
+  /**
+   * Render all registered series in the Prometheus text exposition format.
+   */
+  std::string to_prometheus() const;
+
+  /**
+   * Flat snapshot of all series for the pybind accessor; counters are widened to double.
+   */
+  std::map<std::string, double> snapshot() const;
+
+ private:
+  PerfCounters();
+  void textfile_writer_loop(const std::string path, const size_t interval_sec);
+
+  mutable std::shared_mutex mutex_;
+  std::map<std::string, std::unique_ptr<std::atomic<uint64_t>>> counters_;
+  std::map<std::string, std::unique_ptr<std::atomic<double>>> gauges_;
+
+  std::thread textfile_writer_;
+  std::atomic<bool> terminate_{false};
+};
+
+}  // namespace HugeCTR
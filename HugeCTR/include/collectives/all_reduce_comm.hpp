@@ -15,6 +15,7 @@
  */
 
 #pragma once
+#include <atomic>
 #include <boost/serialization/strong_typedef.hpp>
 #include <collectives/ib_comm.hpp>
 #include <collectives/ib_proxy.hpp>
@@ -89,6 +90,7 @@ class OneshotMultiARInplaceComm : public AllReduceInPlaceComm {
   std::vector<std::unique_ptr<ARContext>> ar_ctx_;
   size_t num_procs_ = 1;
   size_t num_gpus_ = 1;
+  std::atomic<uint64_t>* perf_ar_bytes_ = nullptr; /**< cached PerfCounters series */
 };
 #endif
 template <typename T>
@@ -123,6 +125,7 @@ class OneshotSingleARInplaceComm : public AllReduceInPlaceComm {
   size_t num_gpus_ = 1;
   std::vector<int> device_list_;
   int cfg_nchannels_ = 16;
+  std::atomic<uint64_t>* perf_ar_bytes_ = nullptr; /**< cached PerfCounters series */
 };
 
 template <typename T>
@@ -152,5 +155,6 @@ class NCCLARInplaceComm : public AllReduceInPlaceComm {
   std::vector<std::unique_ptr<ARContext>> ar_ctx_;
   size_t num_procs_ = 1;
   size_t num_gpus_ = 1;
+  std::atomic<uint64_t>* perf_ar_bytes_ = nullptr; /**< cached PerfCounters series */
 };
 }  // namespace HugeCTR
@@ -35,7 +35,12 @@ namespace HugeCTR {
 class IbComm {
   // API
  public:
-  int init(size_t num_procs, size_t num_gpus, size_t my_proc, const std::vector<int>& device_list);
+  /**
+   * num_qps_per_peer > 1 stripes large hier-A2A messages over that many queue pairs per peer so
+   * ECMP can route the stripes over different fabric paths; HCTR_IBV_QPS_PER_PEER overrides it.
+   */
+  int init(size_t num_procs, size_t num_gpus, size_t my_proc, const std::vector<int>& device_list,
+           size_t num_qps_per_peer = 1);
   void finalize();
 
   /* Hier A2A coll api */
@@ -70,6 +75,13 @@ class IbComm {
   void blocking_wait(HierA2AvCollHandle coll, cudaStream_t dep_stream, size_t device_id);
   void wait_global_recv_async(HierA2AvCollHandle coll, size_t device_id);
 
+  /* Cluster-wide device barrier api. Built from the hier A2A atomic exchange: every proxy
+   * posts GPUDirect-written atomics to its peer on each remote node and the calling stream
+   * spins on the local flags until all of them arrived, so no host synchronization sits on
+   * the critical path. */
+  HierA2ACollHandle register_device_barrier();
+  void device_barrier(HierA2ACollHandle coll, cudaStream_t stream, size_t device_id);
+
   // AR coll api
   ARCollHandle register_ar_coll();
   template <typename T>
@@ -102,6 +114,7 @@ class IbComm {
   size_t num_gpus_;
   size_t num_procs_;
   size_t my_proc_;
+  size_t num_qps_per_peer_ = 1;
   std::vector<int> device_list_;
 
   hwloc_topology_t topo_;
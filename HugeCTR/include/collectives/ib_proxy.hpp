@@ -43,6 +43,8 @@
 #define AR_MAX_BLOCKS 16
 #define AR_ALIGN_BLOCK 256 * 1024
 #define AR_MIN_BLOCK 256 * 1024
+#define A2A_MAX_CHUNKS 16
+#define A2A_MIN_CHUNK_SIZE 4096
 
 // TODO: Limit max colls per comm to 4.
 
@@ -206,6 +208,9 @@ struct IbvProxy {
     std::string ib_dev_;
     unsigned int ib_port_;
     ProxyCommand* proxy_cmd_;
+    // QPs per peer for the hier A2A contexts. With > 1, large messages are striped
+    // chunk-by-chunk across the QPs so ECMP can route the stripes over different fabric paths.
+    size_t num_qps_per_peer_ = 1;
   };
 
   struct HierA2AIbvContext {
@@ -219,6 +224,12 @@ struct IbvProxy {
     struct ibv_qp** qp_ = NULL;
     struct IbQpInfo* qp_infos_ = NULL;
     struct IbQpInfo* rem_qp_infos_ = NULL;
+    // Stripes per peer (InitConfig::num_qps_per_peer_). All stripes of a peer share cq_[peer];
+    // qp_ holds num_procs * num_qps_per_peer_ entries, stripe-major per peer.
+    size_t num_qps_per_peer_ = 1;
+    struct ibv_qp* qp(size_t peer, size_t stripe) const {
+      return qp_[peer * num_qps_per_peer_ + stripe];
+    }
     void init_ibv(const IbvProxy::InitConfig& cfg);
     void finalize_ibv();
 
@@ -292,6 +303,12 @@ struct IbvProxy {
 
     size_t h_max_send_size_per_dest_ = 0;
     size_t h_max_recv_size_per_dest_ = 0;
+
+    // Chunk size in bytes for pipelined RDMA writes (HCTR_IBV_A2A_CHUNK_SIZE). When non-zero,
+    // messages larger than this are split and the chunks are posted round-robin over the
+    // destination QPs so all rails start transferring with the first wave. 0 keeps the single
+    // write per destination GPU.
+    size_t chunk_bytes_ = 0;
     size_t* send_sizes_ = NULL;
     size_t* recv_sizes_ = NULL;
     size_t* d_ibv_atomic_ = NULL;
@@ -325,6 +342,15 @@ struct IbvProxy {
     int num_expected_atomic_completions_ = 0;
     int num_atomic_completions_ = 0;
 
+    // Multi-QP striping state (num_qps_per_peer_ > 1). RDMA ordering only holds within one QP,
+    // so the fence atomic of a peer may be posted only after the data writes on all of its
+    // stripes have completed; process_send_chunked() signals every chunk and
+    // wait_send_completion() posts the fence once a peer's write count is reached.
+    std::vector<int> stripe_expected_writes_;
+    std::vector<int> stripe_done_writes_;
+    std::vector<char> fence_posted_;
+    void post_fence(size_t peer);
+
     bool skip_barrier_ = false;
 
     HierA2AvCollContext(IbvProxy* proxy_ctx, HierA2AIbvContext* ibv_ctx,
@@ -336,6 +362,7 @@ struct IbvProxy {
     bool check_send() const;
     void process_recv();
     void process_send();
+    void process_send_chunked();
     bool wait_send_completion();
     void stm();
   };
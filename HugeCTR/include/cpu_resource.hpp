@@ -17,6 +17,8 @@
 #pragma once
 #include <curand.h>
 
+#include <set>
+#include <string>
 #include <vector>
 
 namespace HugeCTR {
@@ -27,6 +29,24 @@ class CPUResource {
   unsigned long long replica_uniform_seed_;
 
  public:
+  /**
+   * Declarative core-set reservation (HCTR_CORE_RESERVATION). Partitions the host cores into
+   * named pools so data-reader workers ("reader"), communication proxy threads ("comm") and
+   * serving-side thread-pool workers ("service") stop migrating onto each other's cores and
+   * onto the cores driving the GPUs.
+   *
+   * The spec is a ';'-separated list of pool:cores entries. cores is either an explicit cpu
+   * list ("0-7,64-71") or a plain count ("8"), in which case whole physical cores (both SMT
+   * siblings, detected via sysfs) are assigned from the highest NUMA node downward, so counted
+   * pools never share a physical core with each other or with the unreserved compute cores.
+   * Example: HCTR_CORE_RESERVATION="reader:8;comm:4;service:0-3".
+   *
+   * reserved_cores returns an empty set for unreserved pools, in which case callers leave the
+   * thread affinity alone. Both methods are static so that components without a
+   * ResourceManager handle (e.g. the communication proxies) can share the same partition.
+   */
+  static bool core_reservation_enabled();
+  static const std::set<int>& reserved_cores(const std::string& pool);
   CPUResource(unsigned long long replica_uniform_seed,
               const std::vector<unsigned long long> replica_variant_seeds);
   CPUResource(const CPUResource&) = delete;
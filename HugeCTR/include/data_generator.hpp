@@ -19,6 +19,7 @@
 #include <omp.h>
 #include <sys/stat.h>
 
+#include <algorithm>
 #include <base/debug/logger.hpp>
 #include <common.hpp>
 #include <fstream>
@@ -310,11 +311,11 @@ void data_generation_for_test2(std::string file_list_name, std::string data_pref
     file_list_stream << (tmp_file_name + "\n");
   }
 
-// Then create files in parallel
+// Then create files in parallel; the file list is complete at this point, so the workers only
+// touch their own data file.
 #pragma omp parallel for num_threads(num_threads)
   for (int k = 0; k < num_files; k++) {
     std::string tmp_file_name(data_prefix + std::to_string(k) + ".data");
-    file_list_stream << (tmp_file_name + "\n");
     HCTR_LOG_S(INFO, WORLD) << tmp_file_name << std::endl;
     // data generation;
     std::ofstream out_stream(tmp_file_name, std::ofstream::binary);
@@ -694,7 +695,8 @@ inline void data_generation_for_raw(std::string file_name, long long num_samples
                                     bool long_tail = false, float alpha = 0.0,
                                     std::vector<T>* generated_sparse_data = nullptr,
                                     std::vector<float>* generated_dense_data = nullptr,
-                                    std::vector<float>* generated_label_data = nullptr) {
+                                    std::vector<float>* generated_label_data = nullptr,
+                                    int num_threads = 1) {
   if (file_exist(file_name)) {
     HCTR_LOG_S(INFO, WORLD) << "File (" + file_name + ") exists and it will be overwritten."
                             << std::endl;
@@ -702,81 +704,104 @@ inline void data_generation_for_raw(std::string file_name, long long num_samples
   static_assert(std::is_same<T, long long>::value || std::is_same<T, unsigned int>::value,
                 "type not support");
 
-  std::ofstream out_stream(file_name, std::ofstream::binary);
   size_t size_label_dense = float_label_dense ? sizeof(float) : sizeof(T);
   // check input
 
-  std::vector<std::shared_ptr<IDataSimulator<long long>>> ldata_sim_vec;
-
   if (slot_size.size() != nnz_array.size() && !nnz_array.empty()) {
     HCTR_LOG(ERROR, WORLD, "Error: slot_size.size() != nnz_array.size() && !nnz_array.empty()\n");
     exit(-1);
   }
 
-  for (auto& voc : slot_size) {
-    if (long_tail) {
-      ldata_sim_vec.emplace_back(new IntPowerLawDataSimulator<long long>(0, voc - 1, alpha));
-    } else {
-      ldata_sim_vec.emplace_back(new IntUniformDataSimulator<long long>(0, voc - 1));
+  // Generates samples [begin, end) into `os`. Every worker owns its simulators, so workers
+  // never share random-generator state.
+  auto generate_range = [&](long long begin, long long end, std::ostream& os) {
+    std::vector<std::shared_ptr<IDataSimulator<long long>>> ldata_sim_vec;
+    for (auto& voc : slot_size) {
+      if (long_tail) {
+        ldata_sim_vec.emplace_back(new IntPowerLawDataSimulator<long long>(0, voc - 1, alpha));
+      } else {
+        ldata_sim_vec.emplace_back(new IntUniformDataSimulator<long long>(0, voc - 1));
+      }
     }
-  }
 
-  for (long long i = 0; i < num_samples; i++) {
-    for (int j = 0; j < label_dim; j++) {
-      T label_int = i % 2;
-      float label_float = static_cast<float>(label_int);
-      char* label_ptr = float_label_dense ? reinterpret_cast<char*>(&label_float)
-                                          : reinterpret_cast<char*>(&label_int);
-      if (generated_label_data != nullptr) {
-        generated_label_data->push_back(label_float);
+    for (long long i = begin; i < end; i++) {
+      for (int j = 0; j < label_dim; j++) {
+        T label_int = i % 2;
+        float label_float = static_cast<float>(label_int);
+        char* label_ptr = float_label_dense ? reinterpret_cast<char*>(&label_float)
+                                            : reinterpret_cast<char*>(&label_int);
+        if (generated_label_data != nullptr) {
+          generated_label_data->push_back(label_float);
+        }
+        os.write(label_ptr, size_label_dense);
       }
-      out_stream.write(label_ptr, size_label_dense);
-    }
-    for (int j = 0; j < dense_dim; j++) {
-      T dense_int = j;
-      float dense_float = static_cast<float>(dense_int);
-      char* dense_ptr = float_label_dense ? reinterpret_cast<char*>(&dense_float)
-                                          : reinterpret_cast<char*>(&dense_int);
-      if (generated_dense_data != nullptr) {
-        generated_dense_data->push_back(dense_float);
+      for (int j = 0; j < dense_dim; j++) {
+        T dense_int = j;
+        float dense_float = static_cast<float>(dense_int);
+        char* dense_ptr = float_label_dense ? reinterpret_cast<char*>(&dense_float)
+                                            : reinterpret_cast<char*>(&dense_int);
+        if (generated_dense_data != nullptr) {
+          generated_dense_data->push_back(dense_float);
+        }
+        os.write(dense_ptr, size_label_dense);
       }
-      out_stream.write(dense_ptr, size_label_dense);
-    }
 
-    for (size_t j = 0; j < ldata_sim_vec.size(); j++) {
-      int nnz = 1;
-      if (!nnz_array.empty()) {
-        nnz = nnz_array[j];
-      }
-      for (int k = 0; k < nnz; k++) {
-        long long num_tmp = ldata_sim_vec[j]->get_num();
-        T sparse =
-            num_tmp > std::numeric_limits<T>::max() ? std::numeric_limits<T>::max() : num_tmp;
-        if (generated_sparse_data != nullptr) {
-          generated_sparse_data->push_back(sparse);
+      for (size_t j = 0; j < ldata_sim_vec.size(); j++) {
+        int nnz = 1;
+        if (!nnz_array.empty()) {
+          nnz = nnz_array[j];
+        }
+        for (int k = 0; k < nnz; k++) {
+          long long num_tmp = ldata_sim_vec[j]->get_num();
+          T sparse =
+              num_tmp > std::numeric_limits<T>::max() ? std::numeric_limits<T>::max() : num_tmp;
+          if (generated_sparse_data != nullptr) {
+            generated_sparse_data->push_back(sparse);
+          }
+          os.write(reinterpret_cast<char*>(&sparse), sizeof(T));
         }
-        out_stream.write(reinterpret_cast<char*>(&sparse), sizeof(T));
       }
     }
-
-    // for (int j = 0; j < sparse_dim; j++) {
-    //   int sparse = 0;
-    //   if (slot_size.size() != 0) {
-    //     std::shared_ptr<IDataSimulator<long long>> temp_sim;
-    //     if (long_tail)
-    //       temp_sim.reset(new IntPowerLawDataSimulator<long long>(0, (slot_size[j] - 1) < 0 ? 0 :
-    //       (slot_size[j] - 1), alpha));
-    //     else
-    //       temp_sim.reset(new IntUniformDataSimulator<long long>(
-    //         0, (slot_size[j] - 1) < 0 ? 0 : (slot_size[j] - 1)));  // range = [0, slot_size[j])
-    //     long long num_ = temp_sim->get_num();
-    //     sparse = num_ > std::numeric_limits<int>::max() ? std::numeric_limits<int>::max() : num_;
-    //   } else {
-    //     sparse = j;
-    //   }
-    //   out_stream.write(reinterpret_cast<char*>(&sparse), sizeof(int));
-    // }
+  };
+
+  // Every sample occupies the same number of bytes in the raw format, so the file can be split
+  // into per-thread ranges that are written at precomputed offsets. The capture vectors require
+  // the samples in order, so those callers stay on the single-threaded path.
+  size_t total_nnz = 0;
+  for (size_t j = 0; j < slot_size.size(); j++) {
+    total_nnz += nnz_array.empty() ? 1 : nnz_array[j];
+  }
+  const size_t bytes_per_sample =
+      (label_dim + dense_dim) * size_label_dense + total_nnz * sizeof(T);
+  const bool capture_requested = generated_sparse_data != nullptr ||
+                                 generated_dense_data != nullptr ||
+                                 generated_label_data != nullptr;
+
+  if (num_threads > 1 && !capture_requested && num_samples > 0) {
+    // Create the file at its final size upfront so the workers can seek into their own segment.
+    {
+      std::ofstream out_stream(file_name, std::ofstream::binary);
+      out_stream.seekp(num_samples * bytes_per_sample - 1);
+      char zero = 0;
+      out_stream.write(&zero, 1);
+    }
+    const long long samples_per_thread = (num_samples + num_threads - 1) / num_threads;
+#pragma omp parallel num_threads(num_threads)
+    {
+      const long long begin = samples_per_thread * omp_get_thread_num();
+      const long long end = std::min<long long>(begin + samples_per_thread, num_samples);
+      if (begin < end) {
+        std::fstream chunk_stream(file_name,
+                                  std::fstream::in | std::fstream::out | std::fstream::binary);
+        chunk_stream.seekp(begin * bytes_per_sample);
+        generate_range(begin, end, chunk_stream);
+      }
+    }
+    return;
   }
+
+  std::ofstream out_stream(file_name, std::ofstream::binary);
+  generate_range(0, num_samples, out_stream);
   out_stream.close();
   return;
 }
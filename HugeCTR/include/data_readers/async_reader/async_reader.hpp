@@ -1,6 +1,9 @@
 #pragma once
 
+#include <atomic>
 #include <data_readers/async_reader/async_reader_common.hpp>
+#include <data_readers/async_reader/compressed_raw.hpp>
+#include <data_readers/async_reader/raw_v2.hpp>
 #include <data_readers/async_reader/thread_async_reader.hpp>
 #include <string>
 #include <thread>
@@ -12,10 +15,15 @@ class ResourceManager;
 
 class AsyncReaderImpl {
  public:
+  /**
+   * sample_size_bytes/label_dense_bytes describe the raw sample layout and enable the opt-in
+   * scatter mode (HCTR_ASYNC_READER_SCATTER); zero keeps the full-batch broadcast.
+   */
   AsyncReaderImpl(std::string fname, size_t batch_size_bytes,
                   const ResourceManager* resource_manager, int num_threads,
                   int num_batches_per_thread, size_t io_block_size, int io_depth, int io_alignment,
-                  bool shuffle = false, bool wait_for_gpu_idle = false);
+                  bool shuffle = false, bool wait_for_gpu_idle = false,
+                  size_t sample_size_bytes = 0, size_t label_dense_bytes = 0);
 
   bool is_currently_loading();
   size_t get_num_buffers() const;
@@ -40,9 +48,18 @@ class AsyncReaderImpl {
   int io_depth_, io_alignment_;
   InternalBatchBuffer* last_buffer_ = nullptr;
   size_t total_file_size_;
+  bool compressed_ = false; /**< the file is in the block-compressed raw format */
+  CompressedRawIndex comp_index_;
+  bool raw_v2_ = false; /**< the file is in the aligned raw v2 format */
+  RawV2Index v2_index_;
   bool wait_for_gpu_idle_;
   int queue_id_;
   bool loop_ = true;
+  bool striped_ = false; /**< workers pull batches from a shared queue instead of fixed lists */
+  bool scatter_ = false; /**< remote GPUs only get all-sparse plus their own label/dense slice */
+  bool gds_ = false;     /**< the file lives on a GDS mount, read it straight into device memory */
+  size_t sample_size_bytes_ = 0;
+  size_t label_dense_bytes_ = 0;
   cudaEvent_t event_success_;
 
   std::vector<size_t> batch_ids_;
@@ -52,6 +69,13 @@ class AsyncReaderImpl {
   std::vector<std::vector<size_t>> thread_batch_ids_;
   std::vector<std::vector<size_t>> thread_buffer_ids_, gpu_thread_ids_;
   std::vector<std::unique_ptr<ThreadAsyncReader>> local_readers_;
+  std::vector<InternalBatchBuffer*> striped_buffer_ptrs_; /**< shared with the striped workers */
+  std::atomic<size_t> next_work_item_{0};                 /**< head of the striped work queue */
+
+  // PerfCounters series for this reader, labelled with the file name; the counter reference is
+  // cached, the gauge series is re-resolved on update (see perf_counters.hpp).
+  std::atomic<uint64_t>* perf_batches_ = nullptr;
+  std::string perf_ready_buffers_series_;
 
   void create_workers();
 };
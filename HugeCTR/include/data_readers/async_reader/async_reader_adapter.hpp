@@ -130,6 +130,11 @@ class AsyncReader : public SchedulableDataReader {
   std::vector<cudaStream_t> s3w_streams_;  // split_3_way streams
   std::vector<cudaStream_t> d2d_streams_;  // d2d copy streams
 
+  // Integer handles into each GPU's event pool, resolved once at construction so the per-batch
+  // path does not hash the event names
+  std::vector<size_t> sparse_ready_event_handles_;
+  std::vector<size_t> dense_ready_event_handles_;
+
   bool cache_buffers_ = false;
 };
 
@@ -25,9 +25,11 @@ enum class BufferStatus : int {
 struct InternalBatchBuffer {
   int64_t id = -1;
   size_t size;
+  size_t comp_size = 0; /**< compressed bytes of this batch (compressed raw files only) */
   int raw_device_id;
 
   std::vector<char*> dev_data;
+  char* dev_comp_data = nullptr; /**< staging for the compressed frame before decompression */
   char* raw_host_ptr = nullptr;
   char* host_data;
 
@@ -39,6 +41,9 @@ struct InternalBatchBuffer {
   int num_submitted_broadcasts;
   bool preload_done;
   cudaEvent_t event;
+  // Which work item round this buffer currently accepts; only used by the cooperative striping
+  // mode to sequence claims of the same buffer by different threads (ThreadAsyncReader).
+  std::atomic<size_t> striped_round{0};
 
   // Following the rule of 5 just in case
   // Only need the destructor here
@@ -53,6 +58,9 @@ struct InternalBatchBuffer {
     for (auto ptr : dev_data) {
       HCTR_LIB_THROW(cudaFree(ptr));
     }
+    if (dev_comp_data != nullptr) {
+      HCTR_LIB_THROW(cudaFree(dev_comp_data));
+    }
     HCTR_LIB_THROW(cudaFreeHost(raw_host_ptr));
   }
 };
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2021, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace HugeCTR {
+
+/**
+ * Block-compressed variant of the raw format, produced by tools/raw_compressor.
+ *
+ * File layout:
+ *   CompressedRawHeader
+ *   uint64_t frame_offsets[num_frames + 1]   -- absolute file offsets of the frames
+ *   frames
+ *
+ * One frame holds the bytes of one batch (batch_size_bytes, the tail frame may be shorter) and
+ * consists of a chunk table followed by independently LZ4-block-compressed chunks:
+ *   uint32_t num_chunks
+ *   uint32_t chunk_offsets[num_chunks + 1]   -- relative to the end of the chunk table
+ *   chunk payloads
+ * Every chunk decompresses to chunk_size_bytes except the last one of a frame. Chunks are
+ * independent so the GPU can decompress a frame with one warp per chunk.
+ */
+struct CompressedRawHeader {
+  static constexpr uint64_t MAGIC = 0x5741524352544348ull;  // "HCTRCRAW"
+  static constexpr uint64_t VERSION = 1;
+
+  uint64_t magic;
+  uint64_t version;
+  uint64_t batch_size_bytes;  /**< uncompressed bytes per frame (except the tail frame) */
+  uint64_t chunk_size_bytes;  /**< uncompressed bytes per chunk (except the last of a frame) */
+  uint64_t uncompressed_size; /**< total uncompressed size of the dataset */
+  uint64_t num_frames;
+};
+
+struct CompressedRawIndex {
+  CompressedRawHeader header;
+  std::vector<size_t> frame_offsets; /**< absolute file offsets, num_frames + 1 entries */
+};
+
+/**
+ * Load the frame index of a block-compressed raw file.
+ * @return false if the file is not in the compressed raw format.
+ */
+inline bool try_load_compressed_raw_index(const std::string& fname, CompressedRawIndex& index) {
+  std::ifstream file(fname, std::ios::binary);
+  if (!file.read(reinterpret_cast<char*>(&index.header), sizeof(index.header))) {
+    return false;
+  }
+  if (index.header.magic != CompressedRawHeader::MAGIC ||
+      index.header.version != CompressedRawHeader::VERSION) {
+    return false;
+  }
+
+  std::vector<uint64_t> offsets(index.header.num_frames + 1);
+  if (!file.read(reinterpret_cast<char*>(offsets.data()), offsets.size() * sizeof(uint64_t))) {
+    return false;
+  }
+  index.frame_offsets.assign(offsets.begin(), offsets.end());
+  return true;
+}
+
+}  // namespace HugeCTR
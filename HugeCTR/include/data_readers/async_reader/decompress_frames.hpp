@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2021, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cuda_runtime.h>
+
+#include <cstddef>
+
+namespace HugeCTR {
+
+/**
+ * Decompress one frame of a block-compressed raw file (see compressed_raw.hpp) on-device.
+ *
+ * dev_comp_frame points at the uploaded frame (chunk table + LZ4 chunks), dev_out receives
+ * out_size uncompressed bytes. Runs with one warp per chunk on the given stream.
+ */
+void decompress_lz4_frame_async(const char* dev_comp_frame, char* dev_out, size_t out_size,
+                                size_t chunk_size, cudaStream_t stream);
+
+}  // namespace HugeCTR
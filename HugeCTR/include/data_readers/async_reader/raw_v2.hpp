@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2021, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace HugeCTR {
+
+/**
+ * Aligned variant (v2) of the raw format, produced by tools/raw_v2_converter.
+ *
+ * File layout:
+ *   RawV2Header
+ *   uint32_t group_checksums[num_groups]      -- CRC32 of each group's payload
+ *   padding up to data_offset_bytes
+ *   record groups
+ *
+ * One group holds the samples of one batch (samples_per_group at the fixed sample stride, the
+ * tail group may hold fewer) and is zero-padded to group_stride_bytes, a multiple of
+ * RAW_V2_ALIGNMENT. Group i therefore starts at data_offset_bytes + i * group_stride_bytes: the
+ * index is fixed-stride, batches can be shuffled with O(1) addressing, and every group boundary
+ * is aligned so O_DIRECT reads land the payload at the start of the staging buffer without any
+ * over-read offset. The per-group checksums replace a whole-file verification pass: a group is
+ * validated the first time a worker reads it.
+ */
+constexpr size_t RAW_V2_ALIGNMENT = 4096;
+
+struct RawV2Header {
+  static constexpr uint64_t MAGIC = 0x3257415252544348ull;  // "HCTRRAW2"
+  static constexpr uint64_t VERSION = 2;
+
+  uint64_t magic;
+  uint64_t version;
+  uint64_t sample_size_bytes;  /**< fixed on-disk stride of one sample */
+  uint64_t samples_per_group;  /**< samples in every group except possibly the tail */
+  uint64_t group_stride_bytes; /**< padded group size, multiple of RAW_V2_ALIGNMENT */
+  uint64_t data_offset_bytes;  /**< file offset of group 0, multiple of RAW_V2_ALIGNMENT */
+  uint64_t num_samples;
+  uint64_t num_groups;
+};
+
+struct RawV2Index {
+  RawV2Header header;
+  std::vector<uint32_t> group_checksums; /**< one CRC32 per group */
+};
+
+/** CRC32 (polynomial 0xEDB88320, as used by zlib) over a byte range. */
+inline uint32_t raw_v2_crc32(const void* data, size_t num_bytes) {
+  static const auto table = [] {
+    std::vector<uint32_t> t(256);
+    for (uint32_t i = 0; i < 256; i++) {
+      uint32_t c = i;
+      for (int k = 0; k < 8; k++) {
+        c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : (c >> 1);
+      }
+      t[i] = c;
+    }
+    return t;
+  }();
+
+  uint32_t crc = 0xFFFFFFFFu;
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < num_bytes; i++) {
+    crc = table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+  }
+  return crc ^ 0xFFFFFFFFu;
+}
+
+/**
+ * Load the header and checksum segment of a raw v2 file.
+ * @return false if the file is not in the raw v2 format.
+ */
+inline bool try_load_raw_v2_index(const std::string& fname, RawV2Index& index) {
+  std::ifstream file(fname, std::ios::binary);
+  if (!file.read(reinterpret_cast<char*>(&index.header), sizeof(index.header))) {
+    return false;
+  }
+  if (index.header.magic != RawV2Header::MAGIC ||
+      index.header.version != RawV2Header::VERSION) {
+    return false;
+  }
+
+  index.group_checksums.resize(index.header.num_groups);
+  if (!file.read(reinterpret_cast<char*>(index.group_checksums.data()),
+                 index.group_checksums.size() * sizeof(uint32_t))) {
+    return false;
+  }
+  return true;
+}
+
+}  // namespace HugeCTR
@@ -1,9 +1,17 @@
 #pragma once
 
 #include <cuda_runtime.h>
+#ifdef ENABLE_IO_URING
+#include <liburing.h>
+#else
 #include <libaio.h>
+#endif
+#ifdef ENABLE_GDS
+#include <cufile.h>
+#endif
 
 #include <atomic>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -19,6 +27,25 @@ struct ThreadAsyncReaderParameters {
   int num_h2d_chunks;
   bool wait_for_gpu_idle;
   bool loop;
+  size_t comp_chunk_size = 0; /**< uncompressed chunk size of a compressed raw file */
+
+  /* Scatter mode (scatter_sample_size_bytes == 0 means classic full-batch broadcast): remote
+   * GPUs receive the sparse columns of every sample plus the label/dense rows of their own
+   * slice only, see ThreadAsyncReader::try_submit_p2p. */
+  size_t scatter_sample_size_bytes = 0;
+  size_t scatter_label_dense_bytes = 0;
+  size_t scatter_samples_per_dev = 0;
+  std::vector<size_t> scatter_global_dev_ids; /**< global device id of each local gpu */
+
+  /* Raw v2 (see raw_v2.hpp): a non-zero group stride selects the aligned fixed-stride group
+   * addressing; the checksum of a group is verified the first time this worker reads it. */
+  size_t v2_group_stride_bytes = 0;
+  size_t v2_data_offset_bytes = 0;
+  const std::vector<uint32_t>* v2_group_checksums = nullptr;
+
+  /* GPUDirect Storage (HCTR_GDS_MOUNTS): cuFileRead the batch extents straight into the device
+   * staging buffers, skipping the host bounce and the H2D upload. Requires ENABLE_GDS. */
+  bool gds = false;
 };
 
 class ThreadAsyncReader {
@@ -26,11 +53,18 @@ class ThreadAsyncReader {
   ThreadAsyncReader(std::string fname, const ResourceManager* resource_manager,
                     size_t batch_size_bytes, int device_id, cudaStream_t stream,
                     std::vector<size_t> batch_ids, std::vector<InternalBatchBuffer*> dest_buffers,
-                    ThreadAsyncReaderParameters params, size_t total_file_size);
+                    ThreadAsyncReaderParameters params, size_t total_file_size,
+                    const std::vector<size_t>* comp_frame_offsets = nullptr);
 
   void load();
   void reset();
 
+  /** Switch this worker to cooperative striping: batches are pulled from a work queue shared by
+   * all workers instead of this worker's fixed batch list (see AsyncReaderImpl). */
+  void set_striped_source(const std::vector<InternalBatchBuffer*>* all_buffers,
+                          const std::vector<size_t>* all_batch_ids,
+                          std::atomic<size_t>* next_work_item);
+
   ~ThreadAsyncReader();
 
  private:
@@ -41,16 +75,36 @@ class ThreadAsyncReader {
   int num_dest_buffers_;
   int max_num_blocks_per_batch_;
   size_t total_file_size_;
+#ifdef ENABLE_IO_URING
+  io_uring ring_;
+#else
   io_context_t ioctx_;
+#endif
+#ifdef ENABLE_GDS
+  /* GPUDirect Storage (HCTR_GDS_MOUNTS): file extents are read straight into the device staging
+   * buffers, skipping the host bounce and the H2D upload, see try_submit_io_to. */
+  bool gds_enabled_ = false;
+  CUfileHandle_t gds_handle_{};
+#endif
   std::atomic<WorkerStatus> status_;
 
   std::vector<size_t> batch_ids_;
   std::vector<InternalBatchBuffer*> dest_buffers_;
   ThreadAsyncReaderParameters params_;
+  const std::vector<size_t>* comp_frame_offsets_; /**< frame index of a compressed raw file */
+  std::vector<char> v2_group_verified_;           /**< raw v2 groups already checksum-verified */
   int num_buffers_waiting_io_;
 
+  // Cooperative striping state, owned by AsyncReaderImpl and shared across all workers
+  const std::vector<InternalBatchBuffer*>* striped_buffers_ = nullptr;
+  const std::vector<size_t>* striped_batch_ids_ = nullptr;
+  std::atomic<size_t>* striped_next_work_item_ = nullptr;
+
+  void load_striped();
   void try_submit_io(size_t batch_id, int io_id);
+  void try_submit_io_to(InternalBatchBuffer* buffer, size_t batch_id, int reg_index);
   void wait_io();
+  void finish_io_request(InternalBatchBuffer* buffer);
   bool wait_for_gpu_idle(InternalBatchBuffer* buffer);
   void try_submit_upload(InternalBatchBuffer* buffer);
   void try_submit_p2p(InternalBatchBuffer* buffer);
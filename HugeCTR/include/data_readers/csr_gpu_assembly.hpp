@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2021, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cuda_runtime_api.h>
+
+#include <cstddef>
+
+namespace HugeCTR {
+
+/**
+ * Query the device scratch size assemble_csr_row_offsets needs for num_row_offsets entries.
+ */
+template <typename T>
+size_t get_csr_assembly_temp_storage_bytes(size_t num_row_offsets);
+
+/**
+ * Assemble CSR row offsets on-device from a per-slot nnz array.
+ *
+ * d_slot_nnz holds one nnz per slot row plus a trailing zero; the exclusive scan of it yields the
+ * row offsets including the total value count in the last entry. Used by the data reader workers
+ * to avoid building and uploading host-side row offsets.
+ */
+template <typename T>
+void assemble_csr_row_offsets(const T* d_slot_nnz, size_t num_row_offsets, T* d_row_offset,
+                              void* d_temp_storage, size_t temp_storage_bytes, cudaStream_t stream);
+
+}  // namespace HugeCTR
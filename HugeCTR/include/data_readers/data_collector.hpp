@@ -21,6 +21,7 @@
 
 #include <atomic>
 #include <common.hpp>
+#include <graph_wrapper.hpp>
 #include <memory>
 #include <mutex>
 #include <queue>
@@ -142,6 +143,7 @@ class DataCollector {
 
   std::atomic<bool> loop_flag_;
   std::vector<size_t> last_batch_nnz_;
+  std::vector<GraphWrapper> split_graphs_; /**< per-GPU graph of the label/dense split kernel */
 
   std::shared_ptr<ResourceManager> resource_manager_;
 
@@ -157,6 +159,7 @@ class DataCollector {
         loop_flag_{true},
         last_batch_nnz_(
             broadcast_buffer->is_fixed_length.size() * resource_manager->get_local_gpu_count(), 0),
+        split_graphs_(resource_manager->get_local_gpu_count()),
         resource_manager_(resource_manager) {
     background_collector_thread_ = std::thread([this]() { background_collector_.start(); });
   }
@@ -214,15 +217,25 @@ class DataCollector {
         }
         const int label_dense_dim = output_buffer_->label_dense_dim;
 
+        // The split launch is identical every iteration (the output tensors are preallocated and
+        // the kernel always covers the full batch), so capture it into a per-GPU graph on the
+        // first batch and replay it afterwards to take the launch overhead off the critical path.
         if (output_buffer_->use_mixed_precision) {
           auto dense_tensor = Tensor2<__half>::stretch_from(output_buffer_->dense_tensors[i]);
-          split(label_tensor, dense_tensor, label_dense_tensor, label_dense_dim,
-                local_gpu->get_stream());
+          split_graphs_[i].capture(
+              [&](cudaStream_t stream) {
+                split(label_tensor, dense_tensor, label_dense_tensor, label_dense_dim, stream);
+              },
+              local_gpu->get_stream());
         } else {
           auto dense_tensor = Tensor2<float>::stretch_from(output_buffer_->dense_tensors[i]);
-          split(label_tensor, dense_tensor, label_dense_tensor, label_dense_dim,
-                local_gpu->get_stream());
+          split_graphs_[i].capture(
+              [&](cudaStream_t stream) {
+                split(label_tensor, dense_tensor, label_dense_tensor, label_dense_dim, stream);
+              },
+              local_gpu->get_stream());
         }
+        split_graphs_[i].exec(local_gpu->get_stream());
       }
     } else {
       broadcast_buffer_->state.store(BufferState::ReadyForWrite);
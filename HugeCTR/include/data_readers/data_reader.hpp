@@ -288,7 +288,7 @@ class DataReader : public IDataReader {
     source_type_ = SourceType_t::FileList;
     worker_group_.reset(new DataReaderWorkerGroupNorm<TypeKey>(
         thread_buffers_, resource_manager_, file_name, repeat_, check_type, params_,
-        start_reading_from_beginning));
+        data_source_params_, start_reading_from_beginning));
     file_name_ = file_name;
   }
 
@@ -19,9 +19,14 @@
 #include <data_readers/check_none.hpp>
 #include <data_readers/check_sum.hpp>
 #include <data_readers/csr.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <data_readers/csr_gpu_assembly.hpp>
 #include <data_readers/data_reader_worker_interface.hpp>
+#include <data_readers/epoch_data_cache.hpp>
 #include <data_readers/file_list.hpp>
 #include <data_readers/file_source.hpp>
+#include <data_readers/remote_file_source.hpp>
 #include <fstream>
 #include <vector>
 
@@ -44,6 +49,17 @@ class DataReaderWorker : public IDataReaderWorker {
   Tensor2<float> host_dense_buffer_;
   std::vector<CSR<T>> host_sparse_buffer_;
 
+  std::shared_ptr<EpochDataCache<T>> epoch_cache_; /**< host cache of the decoded first epoch */
+  size_t replay_batch_id_{0};
+
+  bool gpu_csr_assembly_{false}; /**< assemble CSR row offsets on-device from per-slot nnz */
+  std::vector<Tensor2<T>> host_slot_nnz_; /**< pinned, one nnz per slot row plus a scan tail */
+  std::vector<Tensor2<T>> dev_slot_nnz_;
+  std::vector<size_t> nnz_fill_pos_;
+  std::vector<size_t> nnz_check_point_;
+  Tensor2<char> dev_scan_temp_storage_;
+  size_t scan_temp_storage_bytes_{0};
+
   void read_new_file() {
     constexpr int MAX_TRY = 10;
     for (int i = 0; i < MAX_TRY; i++) {
@@ -70,6 +86,87 @@ class DataReaderWorker : public IDataReaderWorker {
     HCTR_OWN_THROW(Error_t::BrokenFile, "failed to read a file");
   }
 
+  /**
+   * Copy the staged host buffers of one batch to this worker's device buffers. With GPU CSR
+   * assembly, only the packed values and the per-slot nnz go over PCIe and the row offsets are
+   * produced on-device by an exclusive scan.
+   */
+  void copy_host_buffers_to_device(bool use_gpu_assembly) {
+    CudaCPUDeviceContext context(gpu_resource_->get_device_id());
+    auto dst_dense_tensor = Tensor2<float>::stretch_from(buffer_->device_dense_buffers);
+    HCTR_LIB_THROW(cudaMemcpyAsync(dst_dense_tensor.get_ptr(), host_dense_buffer_.get_ptr(),
+                                   host_dense_buffer_.get_size_in_bytes(), cudaMemcpyHostToDevice,
+                                   gpu_resource_->get_memcpy_stream()));
+
+    for (size_t param_id = 0; param_id < params_.size(); ++param_id) {
+      auto dst_sparse_tensor =
+          SparseTensor<T>::stretch_from(buffer_->device_sparse_buffers[param_id]);
+      if (use_gpu_assembly) {
+        auto& csr = host_sparse_buffer_[param_id];
+        const size_t num_row_offsets = csr.get_num_rows() + 1;
+        // the scan tail turns the exclusive sum into full row offsets ending in the total nnz
+        host_slot_nnz_[param_id].get_ptr()[num_row_offsets - 1] = 0;
+        HCTR_LIB_THROW(cudaMemcpyAsync(dst_sparse_tensor.get_value_ptr(),
+                                       csr.get_value_tensor().get_ptr(),
+                                       csr.get_num_values() * sizeof(T), cudaMemcpyHostToDevice,
+                                       gpu_resource_->get_memcpy_stream()));
+        HCTR_LIB_THROW(cudaMemcpyAsync(dev_slot_nnz_[param_id].get_ptr(),
+                                       host_slot_nnz_[param_id].get_ptr(),
+                                       num_row_offsets * sizeof(T), cudaMemcpyHostToDevice,
+                                       gpu_resource_->get_memcpy_stream()));
+        assemble_csr_row_offsets(dev_slot_nnz_[param_id].get_ptr(), num_row_offsets,
+                                 dst_sparse_tensor.get_rowoffset_ptr(),
+                                 dev_scan_temp_storage_.get_ptr(), scan_temp_storage_bytes_,
+                                 gpu_resource_->get_memcpy_stream());
+        *dst_sparse_tensor.get_nnz_ptr() = csr.get_num_values();
+        last_batch_nnz_[param_id] = csr.get_num_values();
+      } else if (buffer_->is_fixed_length[param_id] &&
+          last_batch_nnz_[param_id] == host_sparse_buffer_[param_id].get_num_values()) {
+        HCTR_LIB_THROW(cudaMemcpyAsync(dst_sparse_tensor.get_value_ptr(),
+                                       host_sparse_buffer_[param_id].get_value_tensor().get_ptr(),
+                                       host_sparse_buffer_[param_id].get_num_values() * sizeof(T),
+                                       cudaMemcpyHostToDevice,
+                                       gpu_resource_->get_memcpy_stream()));
+      } else {
+        sparse_tensor_helper::cuda::copy_async(dst_sparse_tensor, host_sparse_buffer_[param_id],
+                                               gpu_resource_->get_memcpy_stream());
+        last_batch_nnz_[param_id] = host_sparse_buffer_[param_id].get_num_values();
+      }
+    }
+    HCTR_LIB_THROW(cudaStreamSynchronize(gpu_resource_->get_memcpy_stream()));
+  }
+
+  /**
+   * Serve one batch from the sealed epoch cache. The end of a cached epoch reproduces the EOF
+   * protocol of the file-backed path, so epoch transitions look identical to the collector.
+   */
+  void read_a_batch_from_cache() {
+    if (replay_batch_id_ >= epoch_cache_->num_batches()) {
+      if (!wait_until_h2d_ready()) return;
+      buffer_->current_batch_size = 0;
+      assert(buffer_->state.load() == BufferState::Writing);
+      is_eof_ = true;
+      buffer_->state.store(BufferState::ReadyForRead);
+
+      while (buffer_->state.load() != BufferState::ReadyForWrite) {
+        usleep(2);
+        if (*loop_flag_ == 0) return;  // in case main thread exit
+      }
+      replay_batch_id_ = 0;
+      return;
+    }
+    long long current_batch_size =
+        epoch_cache_->replay(replay_batch_id_, host_dense_buffer_.get_ptr(), host_sparse_buffer_);
+    replay_batch_id_++;
+
+    if (!wait_until_h2d_ready()) return;
+    buffer_->current_batch_size = current_batch_size;
+    // replayed batches come with host-built row offsets, so skip the device-side assembly
+    copy_host_buffers_to_device(false);
+    assert(buffer_->state.load() == BufferState::Writing);
+    buffer_->state.store(BufferState::ReadyForRead);
+  }
+
   void create_checker() {
     switch (check_type_) {
       case Check_t::Sum:
@@ -98,7 +195,8 @@ class DataReaderWorker : public IDataReaderWorker {
                    const std::shared_ptr<GPUResource>& gpu_resource, int* loop_flag,
                    const std::shared_ptr<ThreadBuffer>& buffer, const std::string& file_list,
                    size_t buffer_length, bool repeat, Check_t check_type,
-                   const std::vector<DataReaderSparseParam>& params)
+                   const std::vector<DataReaderSparseParam>& params,
+                   const DataSourceParams& data_source_params = DataSourceParams())
       : IDataReaderWorker(worker_id, worker_num, gpu_resource, !repeat, loop_flag, buffer),
         buffer_length_(buffer_length),
         check_type_(check_type),
@@ -112,7 +210,12 @@ class DataReaderWorker : public IDataReaderWorker {
     for (auto& p : params) {
       total_slot_num_ += p.slot_num;
     }
-    source_ = std::make_shared<FileSource>(worker_id, worker_num, file_list, repeat);
+    if (data_source_params.type != DataSourceType_t::Local) {
+      source_ = std::make_shared<RemoteFileSource>(worker_id, worker_num, file_list, repeat,
+                                                   data_source_params);
+    } else {
+      source_ = std::make_shared<FileSource>(worker_id, worker_num, file_list, repeat);
+    }
     create_checker();
 
     int batch_size = buffer->batch_size;
@@ -136,12 +239,58 @@ class DataReaderWorker : public IDataReaderWorker {
     }
 
     buff->allocate();
+
+    // Opt-in host cache for epoch mode: the first epoch decodes from the file list as usual
+    // while being recorded, every later epoch replays from host memory with zero decode.
+    const char* cache_env = std::getenv("HCTR_EPOCH_DATA_CACHE");
+    if (!repeat && cache_env && std::atoi(cache_env) != 0) {
+      epoch_cache_ = std::make_shared<EpochDataCache<T>>(host_dense_buffer_.get_num_elements());
+    }
+
+    // Opt-in GPU CSR assembly: the worker only stages per-slot nnz while parsing and the row
+    // offsets are produced on-device by an exclusive scan, like the async raw reader does.
+    const char* gpu_csr_env = std::getenv("HCTR_GPU_CSR_ASSEMBLY");
+    if (gpu_csr_env && std::atoi(gpu_csr_env) != 0) {
+      gpu_csr_assembly_ = true;
+      auto host_buff = GeneralBuffer2<CudaHostAllocator>::create();
+      auto dev_buff = GeneralBuffer2<CudaAllocator>::create();
+      host_slot_nnz_.resize(params.size());
+      dev_slot_nnz_.resize(params.size());
+      nnz_fill_pos_.assign(params.size(), 0);
+      nnz_check_point_.assign(params.size(), 0);
+      size_t max_row_offsets = 0;
+      for (size_t param_id = 0; param_id < params.size(); ++param_id) {
+        const size_t num_row_offsets =
+            static_cast<size_t>(batch_size) * params[param_id].slot_num + 1;
+        host_buff->reserve({num_row_offsets}, &host_slot_nnz_[param_id]);
+        dev_buff->reserve({num_row_offsets}, &dev_slot_nnz_[param_id]);
+        max_row_offsets = std::max(max_row_offsets, num_row_offsets);
+      }
+      scan_temp_storage_bytes_ = get_csr_assembly_temp_storage_bytes<T>(max_row_offsets);
+      dev_buff->reserve({scan_temp_storage_bytes_}, &dev_scan_temp_storage_);
+      host_buff->allocate();
+      dev_buff->allocate();
+    }
+  }
+
+  /**
+   * Drop the cached epoch, e.g. when the worker is pointed at a different file list.
+   */
+  void reset_epoch_cache() override {
+    if (epoch_cache_) {
+      epoch_cache_ = std::make_shared<EpochDataCache<T>>(host_dense_buffer_.get_num_elements());
+      replay_batch_id_ = 0;
+    }
   }
 
   /**
    * read a batch of data from data set to heap.
    */
   void read_a_batch() {
+    if (epoch_cache_ && epoch_cache_->sealed()) {
+      read_a_batch_from_cache();
+      return;
+    }
     long long current_batch_size = buffer_->batch_size;
     int label_dim = buffer_->label_dim;
     int dense_dim = buffer_->dense_dim;
@@ -160,6 +309,10 @@ class DataReaderWorker : public IDataReaderWorker {
       // of the datset, while Raw will output current_batchsize < batchsize. Comment by Alex Liu
       // (2021.7.4)
       if (err == Error_t::EndOfFile) {
+        if (epoch_cache_) {
+          // The first epoch has been fully recorded; later epochs replay it from host memory.
+          epoch_cache_->seal();
+        }
         if (!wait_until_h2d_ready()) return;
         buffer_->current_batch_size = 0;
         assert(buffer_->state.load() == BufferState::Writing);
@@ -185,6 +338,10 @@ class DataReaderWorker : public IDataReaderWorker {
     for (auto& each_csr : host_sparse_buffer_) {
       each_csr.reset();
     }
+    if (gpu_csr_assembly_) {
+      std::fill(nnz_fill_pos_.begin(), nnz_fill_pos_.end(), 0);
+      std::fill(nnz_check_point_.begin(), nnz_check_point_.end(), 0);
+    }
     // batch loop
     for (int batch_idx = 0; batch_idx < buffer_->batch_size; ++batch_idx) {
       if (batch_idx >= current_batch_size) {
@@ -193,6 +350,9 @@ class DataReaderWorker : public IDataReaderWorker {
           auto& current_csr = host_sparse_buffer_[param_id];
           for (int k = 0; k < param.slot_num; k++) {
             current_csr.new_row();
+            if (gpu_csr_assembly_) {
+              host_slot_nnz_[param_id].get_ptr()[nnz_fill_pos_[param_id]++] = 0;
+            }
           }
         }
         if (batch_idx >= batch_size_start_idx &&
@@ -225,6 +385,9 @@ class DataReaderWorker : public IDataReaderWorker {
           for (size_t param_id = 0; param_id < params_.size(); ++param_id) {
             auto& current_csr = host_sparse_buffer_[param_id];
             current_csr.set_check_point();
+            if (gpu_csr_assembly_) {
+              nnz_check_point_[param_id] = nnz_fill_pos_[param_id];
+            }
           }
           for (size_t param_id = 0; param_id < params_.size(); ++param_id) {
             auto& param = params_[param_id];
@@ -240,6 +403,10 @@ class DataReaderWorker : public IDataReaderWorker {
                     << HCTR_LOCATION() << std::endl;
               }
               current_csr.new_row();
+              if (gpu_csr_assembly_) {
+                host_slot_nnz_[param_id].get_ptr()[nnz_fill_pos_[param_id]++] =
+                    static_cast<T>(nnz);
+              }
               size_t num_value = current_csr.get_num_values();
 
               HCTR_OWN_THROW(
@@ -255,6 +422,9 @@ class DataReaderWorker : public IDataReaderWorker {
           for (auto& each_csr : host_sparse_buffer_) {
             each_csr.roll_back();
           }
+          if (gpu_csr_assembly_) {
+            nnz_fill_pos_ = nnz_check_point_;
+          }
           Error_t err = rt_err.get_error();
           if (err == Error_t::DataCheckError) {
             HCTR_LOG_S(ERROR, WORLD) << "Error_t::DataCheckError " << HCTR_LOCATION() << std::endl;
@@ -282,36 +452,16 @@ class DataReaderWorker : public IDataReaderWorker {
     for (auto& each_csr : host_sparse_buffer_) {
       each_csr.new_row();
     }
+
+    if (epoch_cache_) {
+      epoch_cache_->put(host_dense_buffer_.get_ptr(), current_batch_size, host_sparse_buffer_);
+    }
     // do h2d
     // wait buffer and schedule
 
     if (!wait_until_h2d_ready()) return;
     buffer_->current_batch_size = current_batch_size;
-    {
-      CudaCPUDeviceContext context(gpu_resource_->get_device_id());
-      auto dst_dense_tensor = Tensor2<float>::stretch_from(buffer_->device_dense_buffers);
-      HCTR_LIB_THROW(cudaMemcpyAsync(dst_dense_tensor.get_ptr(), host_dense_buffer_.get_ptr(),
-                                     host_dense_buffer_.get_size_in_bytes(), cudaMemcpyHostToDevice,
-                                     gpu_resource_->get_memcpy_stream()));
-
-      for (size_t param_id = 0; param_id < params_.size(); ++param_id) {
-        auto dst_sparse_tensor =
-            SparseTensor<T>::stretch_from(buffer_->device_sparse_buffers[param_id]);
-        if (buffer_->is_fixed_length[param_id] &&
-            last_batch_nnz_[param_id] == host_sparse_buffer_[param_id].get_num_values()) {
-          HCTR_LIB_THROW(cudaMemcpyAsync(dst_sparse_tensor.get_value_ptr(),
-                                         host_sparse_buffer_[param_id].get_value_tensor().get_ptr(),
-                                         host_sparse_buffer_[param_id].get_num_values() * sizeof(T),
-                                         cudaMemcpyHostToDevice,
-                                         gpu_resource_->get_memcpy_stream()));
-        } else {
-          sparse_tensor_helper::cuda::copy_async(dst_sparse_tensor, host_sparse_buffer_[param_id],
-                                                 gpu_resource_->get_memcpy_stream());
-          last_batch_nnz_[param_id] = host_sparse_buffer_[param_id].get_num_values();
-        }
-      }
-      HCTR_LIB_THROW(cudaStreamSynchronize(gpu_resource_->get_memcpy_stream()));
-    }
+    copy_host_buffers_to_device(gpu_csr_assembly_);
     assert(buffer_->state.load() == BufferState::Writing);
     buffer_->state.store(BufferState::ReadyForRead);
   }
@@ -20,11 +20,13 @@
 
 #include <atomic>
 #include <common.hpp>
+#include <cpu_resource.hpp>
 #include <data_readers/csr.hpp>
 #include <data_readers/data_reader_worker_interface.hpp>
 #include <fstream>
 #include <thread>
 #include <tuple>
+#include <utils.hpp>
 #include <vector>
 
 namespace HugeCTR {
@@ -76,10 +78,16 @@ class DataReaderWorkerGroup {
 
     size_t local_gpu_count = resource_manager_->get_local_gpu_count();
 
+    // Keep the workers on the "reader" pool when one is reserved (HCTR_CORE_RESERVATION), so
+    // they stop migrating onto the cores driving the GPUs and the communication proxies.
+    const std::set<int>& reader_cores = CPUResource::reserved_cores("reader");
     for (size_t i = 0; i < data_readers_.size(); ++i) {
       auto local_gpu = resource_manager_->get_local_gpu(i % local_gpu_count);
       data_reader_threads_.emplace_back(data_reader_thread_func_, data_readers_[i],
                                         &data_reader_loop_flag_, local_gpu->get_device_id());
+      if (!reader_cores.empty()) {
+        set_affinity(data_reader_threads_.back(), reader_cores, false);
+      }
     }
   }
 
@@ -125,6 +133,13 @@ class DataReaderWorkerGroup {
           Error_t::WrongInput,
           "set_source only supports FileList for Norm & Mmap for Raw & Parquet for Parquet");
     }
+    // A cached epoch only stays valid as long as the workers keep reading the same dataset.
+    if (!current_source_name_.empty() && current_source_name_ != file_name) {
+      for (auto& data_reader : data_readers_) {
+        data_reader->reset_epoch_cache();
+      }
+    }
+    current_source_name_ = file_name;
     size_t num_workers = data_readers_.size();
     for (size_t worker_id = 0; worker_id < num_workers; worker_id++) {
       data_readers_[worker_id]->set_source(create_source(
@@ -136,6 +151,8 @@ class DataReaderWorkerGroup {
   }
 
  private:
+  std::string current_source_name_; /**< file name of the last set_source call */
+
   virtual std::shared_ptr<Source> create_source(size_t worker_id, size_t num_worker,
                                                 const std::string& file_name,
                                                 bool strict_order_of_batches, bool repeat,
@@ -18,6 +18,7 @@
 
 #include <data_readers/data_reader_worker.hpp>
 #include <data_readers/data_reader_worker_group.hpp>
+#include <data_readers/remote_file_source.hpp>
 
 namespace HugeCTR {
 
@@ -31,6 +32,10 @@ class DataReaderWorkerGroupNorm : public DataReaderWorkerGroup {
                                         const DataSourceParams &data_source_params) override {
     HCTR_CHECK_HINT(!strict_order_of_batches,
                     "Norm datareader: cant impose norm data loading order\n");
+    if (data_source_params.type != DataSourceType_t::Local) {
+      return std::make_shared<RemoteFileSource>(worker_id, num_worker, file_name, repeat,
+                                                data_source_params);
+    }
     return std::make_shared<FileSource>(worker_id, num_worker, file_name, repeat);
   }
 
@@ -40,6 +45,7 @@ class DataReaderWorkerGroupNorm : public DataReaderWorkerGroup {
                             const std::shared_ptr<ResourceManager> &resource_manager_,
                             std::string file_list, bool repeat, Check_t check_type,
                             const std::vector<DataReaderSparseParam> &params,
+                            const DataSourceParams &data_source_params = DataSourceParams(),
                             bool start_reading_from_beginning = true)
       : DataReaderWorkerGroup(start_reading_from_beginning, DataReaderType_t::Norm) {
     if (file_list.empty()) {
@@ -63,7 +69,7 @@ class DataReaderWorkerGroupNorm : public DataReaderWorkerGroup {
       std::shared_ptr<IDataReaderWorker> data_reader(new DataReaderWorker<TypeKey>(
           i, num_threads, resource_manager_->get_local_gpu(i % local_gpu_count),
           &data_reader_loop_flag_, output_buffers[i], file_list, max_feature_num_per_sample, repeat,
-          check_type, params));
+          check_type, params, data_source_params));
       data_readers_.push_back(data_reader);
     }
     create_data_reader_threads();
@@ -27,6 +27,7 @@ class IDataReaderWorker {
  public:
   virtual void read_a_batch(){};
   virtual void skip_read(){};
+  virtual void reset_epoch_cache(){};
   void set_source(std::shared_ptr<Source> source) {
     if (!is_eof_) {
       HCTR_OWN_THROW(
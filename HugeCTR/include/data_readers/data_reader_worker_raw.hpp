@@ -35,6 +35,8 @@ class DataReaderWorkerRaw : public IDataReaderWorker {
   bool float_label_dense_;
   size_t total_slot_num_;
   std::vector<size_t> last_batch_nnz_;
+  std::shared_ptr<MmapSource> mmap_source_;
+  bool sample_shuffle_; /**< batches come as slices of coalesced sample runs */
 
   Tensor2<float> host_dense_buffer_;
   std::vector<CSR<T>> host_sparse_buffer_;
@@ -71,7 +73,9 @@ class DataReaderWorkerRaw : public IDataReaderWorker {
       HCTR_OWN_THROW(Error_t::BrokenFile, "DataReaderWorkerRaw: worker_id >= worker_num");
     }
 
-    source_ = std::make_shared<MmapSource>(file_offset_list, worker_id);
+    mmap_source_ = std::make_shared<MmapSource>(file_offset_list, worker_id);
+    source_ = mmap_source_;
+    sample_shuffle_ = file_offset_list->sample_shuffle_enabled();
 
     int batch_size = buffer->batch_size;
     int batch_size_start_idx = buffer->batch_size_start_idx;
@@ -140,6 +144,11 @@ class DataReaderWorkerRaw : public IDataReaderWorker {
     for (auto& each_csr : host_sparse_buffer_) {
       each_csr.reset();
     }
+    // In sample-shuffle mode the batch is a list of coalesced sample runs instead of one
+    // contiguous region; walk the runs as batch_idx advances
+    const std::vector<MmapOffset>* slices = sample_shuffle_ ? &mmap_source_->get_slices() : nullptr;
+    size_t slice_id = 0;
+    long long slice_start = 0;
     for (int batch_idx = 0; batch_idx < buffer_->batch_size; ++batch_idx) {
       if (batch_idx >= current_batchsize) {
         for (size_t param_id = 0; param_id < params_.size(); ++param_id) {
@@ -160,7 +169,16 @@ class DataReaderWorkerRaw : public IDataReaderWorker {
         }
         continue;
       }
-      char* sample_cur = data_buffer + sample_length * batch_idx;
+      char* sample_cur;
+      if (slices) {
+        while (batch_idx - slice_start >= (*slices)[slice_id].samples) {
+          slice_start += (*slices)[slice_id].samples;
+          slice_id++;
+        }
+        sample_cur = (*slices)[slice_id].offset + sample_length * (batch_idx - slice_start);
+      } else {
+        sample_cur = data_buffer + sample_length * batch_idx;
+      }
 
       if (batch_idx >= batch_size_start_idx &&
           batch_idx < batch_size_end_idx) {  // only read local device dense data
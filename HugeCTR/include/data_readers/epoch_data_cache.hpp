@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2021, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstring>
+#include <data_readers/csr.hpp>
+#include <vector>
+
+namespace HugeCTR {
+
+/**
+ * @brief Per-worker host cache of decoded batches for multi-epoch training.
+ *
+ * During the first epoch every decoded batch (the dense shard owned by this worker plus the CSR
+ * buffer of every sparse param) is appended to a host arena. Once the epoch is sealed, the worker
+ * replays the arena into its staging buffers for all later epochs instead of re-reading and
+ * re-decoding the dataset, so the file source is only touched once.
+ */
+template <typename T>
+class EpochDataCache {
+ private:
+  struct BatchRecord {
+    long long current_batch_size;
+    size_t dense_begin;                   /**< offset into dense_arena_ */
+    std::vector<size_t> row_offset_begin; /**< per param, offset into row_offset_arena_ */
+    std::vector<size_t> value_begin;      /**< per param, offset into value_arena_ */
+    std::vector<size_t> value_num;        /**< per param, number of cached values */
+  };
+
+  const size_t dense_elements_per_batch_; /**< local dense shard size of one batch, in floats */
+  std::vector<float> dense_arena_;
+  std::vector<T> row_offset_arena_;
+  std::vector<T> value_arena_;
+  std::vector<BatchRecord> batches_;
+  bool sealed_{false};
+
+ public:
+  EpochDataCache(size_t dense_elements_per_batch)
+      : dense_elements_per_batch_(dense_elements_per_batch) {}
+
+  bool sealed() const { return sealed_; }
+  size_t num_batches() const { return batches_.size(); }
+
+  void seal() { sealed_ = true; }
+
+  /**
+   * Append one decoded batch to the arena. Must only be called before seal().
+   */
+  void put(const float* dense, long long current_batch_size,
+           const std::vector<CSR<T>>& sparse_buffers) {
+    BatchRecord record;
+    record.current_batch_size = current_batch_size;
+    record.dense_begin = dense_arena_.size();
+    dense_arena_.insert(dense_arena_.end(), dense, dense + dense_elements_per_batch_);
+
+    for (auto& csr : sparse_buffers) {
+      const T* row_offset_ptr = csr.get_row_offset_tensor().get_ptr();
+      const T* value_ptr = csr.get_value_tensor().get_ptr();
+      const size_t num_row_offsets = csr.get_num_rows() + 1;
+      const size_t num_values = csr.get_num_values();
+
+      record.row_offset_begin.push_back(row_offset_arena_.size());
+      row_offset_arena_.insert(row_offset_arena_.end(), row_offset_ptr,
+                               row_offset_ptr + num_row_offsets);
+      record.value_begin.push_back(value_arena_.size());
+      record.value_num.push_back(num_values);
+      value_arena_.insert(value_arena_.end(), value_ptr, value_ptr + num_values);
+    }
+    batches_.push_back(std::move(record));
+  }
+
+  /**
+   * Copy a cached batch back into the worker's staging buffers.
+   * @return the current batch size recorded for this batch.
+   */
+  long long replay(size_t batch_id, float* dense, std::vector<CSR<T>>& sparse_buffers) const {
+    const BatchRecord& record = batches_[batch_id];
+    std::memcpy(dense, dense_arena_.data() + record.dense_begin,
+                dense_elements_per_batch_ * sizeof(float));
+
+    for (size_t param_id = 0; param_id < sparse_buffers.size(); ++param_id) {
+      auto& csr = sparse_buffers[param_id];
+      const size_t num_row_offsets = csr.get_num_rows() + 1;
+      const size_t num_values = record.value_num[param_id];
+
+      csr.reset();
+      std::memcpy(csr.get_row_offset_tensor().get_ptr(),
+                  row_offset_arena_.data() + record.row_offset_begin[param_id],
+                  num_row_offsets * sizeof(T));
+      csr.update_row_offset(num_row_offsets);
+      std::memcpy(csr.get_value_tensor().get_ptr(),
+                  value_arena_.data() + record.value_begin[param_id], num_values * sizeof(T));
+      csr.update_value_size(num_values);
+    }
+    return record.current_batch_size;
+  }
+};
+
+}  // namespace HugeCTR
@@ -22,10 +22,14 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <cstdlib>
 #include <cudf/copying.hpp>
 #include <cudf/io/parquet.hpp>
 #include <fstream>
+#include <future>
+#include <map>
 #include <rmm/mr/device/device_memory_resource.hpp>
+#include <utility>
 #include <vector>
 
 #include "common.hpp"
@@ -58,6 +62,25 @@ class ParquetFileSource : public Source {
   int row_group_size_;                      // size of current row_group
   cudaStream_t slice_stream_;               /**< worker stream for slicing row_group */
   std::unique_ptr<FileLoader> file_loader_; /**< loader to load data from file system to memory */
+  std::vector<std::string> column_projection_; /**< columns to decode; empty decodes all */
+  std::future<cudf_io::table_with_metadata>
+      prefetched_row_group_;               /**< in-flight background decode of the next group */
+  int prefetched_row_group_id_{-1};        // row group targeted by the in-flight decode
+  unsigned int prefetched_counter_{0};     // file counter the in-flight decode belongs to
+
+  /* Decoded row groups kept on device, keyed by (file name, row group id). The parquet
+     dictionary pages are decoded inside libcudf, so the closest point where repeated decode
+     work (dictionary and data pages alike) can be skipped is the decoded row group itself.
+     HCTR_PARQUET_GROUP_CACHE sets how many row groups each worker may retain; once a group is
+     cached, every later pass over the same file (repeat mode over a fixed set of partitions)
+     serves a device-to-device copy instead of a cudf decode. Entries hold the column
+     projection active at their first decode, which the worker fixes before the first read. */
+  struct CachedRowGroup {
+    std::unique_ptr<cudf::table> tbl;
+    cudf_io::table_metadata metadata;
+  };
+  std::map<std::pair<std::string, int>, CachedRowGroup> row_group_cache_;
+  size_t row_group_cache_capacity_{0};
 
   const bool repeat_;
   const bool sequential_file_consumption_;
@@ -81,6 +104,38 @@ class ParquetFileSource : public Source {
     return file_name;
   }
 
+  /**
+   * Private helper to wait for and discard the in-flight row-group decode. Must be called before
+   * the mapped file it reads from is unmapped or the read position is re-targeted.
+   */
+  void drain_prefetch() noexcept {
+    if (prefetched_row_group_.valid()) {
+      try {
+        prefetched_row_group_.get();
+      } catch (...) {
+      }
+    }
+    prefetched_row_group_id_ = -1;
+  }
+
+  /**
+   * Private helper to apply the row-group selection and the column projection (if any) to the
+   * reader options before a decode.
+   */
+  void prepare_parquet_args(int row_group) {
+    std::vector<std::vector<cudf::size_type>> rgrps;
+    if (row_group >= 0) {
+      rgrps.push_back({(cudf::size_type)row_group});
+    }
+    parquet_args_.set_row_groups(rgrps);
+    parquet_args_.set_skip_rows(0);
+    parquet_args_.set_num_rows(-1);
+    parquet_args_.set_timestamp_type(cudf::data_type(cudf::type_id::EMPTY));
+    if (!column_projection_.empty()) {
+      parquet_args_.set_columns(column_projection_);
+    }
+  }
+
  public:
   /**
    * Ctor
@@ -101,6 +156,9 @@ class ParquetFileSource : public Source {
         offset_(worker_id * !(sequtial_file_consumption)) {
     slice_stream_ = NULL;
     file_loader_ = std::make_unique<FileLoader>(data_source_params);
+    if (const char* cache_groups = std::getenv("HCTR_PARQUET_GROUP_CACHE")) {
+      row_group_cache_capacity_ = std::max(0l, atol(cache_groups));
+    }
     // load _metadata.json
     std::string metadata_file_name = get_metada_filename(file_list_.get_a_file_with_id(0, true));
     if (!(file_metadata_.get_metadata_status())) {
@@ -121,6 +179,7 @@ class ParquetFileSource : public Source {
   }
 
   ~ParquetFileSource() {
+    drain_prefetch();
     cudaStreamDestroy(slice_stream_);
     slice_stream_ = NULL;
     file_loader_->clean();
@@ -141,6 +200,7 @@ class ParquetFileSource : public Source {
   // counter_ always points to next file name
   Error_t next_source() noexcept {
     try {
+      drain_prefetch();
       file_loader_->clean();
       can_read_file_ = false;
       if (sequential_file_consumption_) {
@@ -191,6 +251,13 @@ class ParquetFileSource : public Source {
   }
   bool is_open() noexcept { return can_read_file_; }
   void set_row_idx(long long idx) { curr_row_idx_ = idx; }
+  /**
+   * Restrict decoding to the given parquet columns (pushed down to the cudf reader). Applies
+   * from the next read onward; an empty list decodes every column.
+   */
+  void set_column_projection(const std::vector<std::string>& columns) {
+    column_projection_ = columns;
+  }
   /**
    * Read "num_rows" from the memory-mapped parquet file
    * @param num_rows number of rows to read from Parquet file, -1 is single row_group
@@ -212,25 +279,67 @@ class ParquetFileSource : public Source {
     if (!use_cache) {
       if (num_rows == -1) {
         // read and inc row_group and send back
-        std::vector<cudf::size_type> row_list = {curr_row_group_};
-        std::vector<std::vector<cudf::size_type>> rgrps = {row_list};
-        parquet_args_.set_row_groups(rgrps);
-        parquet_args_.set_skip_rows(0);
-        parquet_args_.set_num_rows(-1);
-        parquet_args_.set_timestamp_type(cudf::data_type(cudf::type_id::EMPTY));
-        auto tbl_w_metadata = cudf_io::read_parquet(parquet_args_, mr);
+        cudf_io::table_with_metadata tbl_w_metadata;
+        bool from_cache = false;
+        auto cached = row_group_cache_capacity_ > 0
+                          ? row_group_cache_.find(std::make_pair(file_name_, curr_row_group_))
+                          : row_group_cache_.end();
+        if (prefetched_row_group_.valid() && prefetched_row_group_id_ == curr_row_group_ &&
+            prefetched_counter_ == counter_) {
+          // this row group was already decoded in the background during the previous batch
+          tbl_w_metadata = prefetched_row_group_.get();
+          prefetched_row_group_id_ = -1;
+        } else if (cached != row_group_cache_.end()) {
+          // decoded in an earlier pass over this file, only a device copy is needed
+          drain_prefetch();
+          tbl_w_metadata.tbl =
+              std::make_unique<cudf::table>(cached->second.tbl->view(), slice_stream_, mr);
+          tbl_w_metadata.metadata = cached->second.metadata;
+          // blocking bcoz parquet_read is blocking - mimic same behavior
+          cudaStreamSynchronize(slice_stream_);
+          from_cache = true;
+        } else {
+          drain_prefetch();
+          prepare_parquet_args(curr_row_group_);
+          tbl_w_metadata = cudf_io::read_parquet(parquet_args_, mr);
+        }
+        if (!from_cache && row_group_cache_capacity_ > 0 &&
+            row_group_cache_.size() < row_group_cache_capacity_) {
+          CachedRowGroup entry;
+          entry.tbl = std::make_unique<cudf::table>(tbl_w_metadata.tbl->view(), slice_stream_, mr);
+          entry.metadata = tbl_w_metadata.metadata;
+          cudaStreamSynchronize(slice_stream_);
+          row_group_cache_.emplace(std::make_pair(file_name_, curr_row_group_), std::move(entry));
+        }
         curr_row_group_++;
         curr_row_idx_ += tbl_w_metadata.tbl->num_rows();
         row_group_offset_ += tbl_w_metadata.tbl->num_rows();
+
+        // Pipeline the decode of the next row group of this file, so that it overlaps with the
+        // conversion work on the batches served from the current one. When the next group is
+        // already cached there is nothing to overlap, so skip the background decode.
+        if (curr_row_idx_ < file_total_rows_ &&
+            (row_group_cache_capacity_ == 0 ||
+             row_group_cache_.find(std::make_pair(file_name_, curr_row_group_)) ==
+                 row_group_cache_.end())) {
+          prepare_parquet_args(curr_row_group_);
+          prefetched_row_group_id_ = curr_row_group_;
+          prefetched_counter_ = counter_;
+          int dev = 0;
+          cudaGetDevice(&dev);
+          cudf_io::parquet_reader_options args = parquet_args_;
+          prefetched_row_group_ = std::async(std::launch::async, [args, dev, mr]() {
+            cudaSetDevice(dev);
+            return cudf_io::read_parquet(args, mr);
+          });
+        }
         nvtxRangePop();
         return tbl_w_metadata;
       } else {
         // parquet_args_.row_group = -1; // set zero to use num_rows and skip_rows param
-        std::vector<std::vector<cudf::size_type>> rgrps;
-        parquet_args_.set_row_groups(rgrps);
+        prepare_parquet_args(-1);
         parquet_args_.set_skip_rows(curr_row_idx_);
         parquet_args_.set_num_rows(num_rows);
-        parquet_args_.set_timestamp_type(cudf::data_type(cudf::type_id::EMPTY));
         auto tbl_w_metadata = cudf_io::read_parquet(parquet_args_, mr);
 
         curr_row_idx_ += num_rows;
@@ -23,8 +23,13 @@
 
 #include <algorithm>
 #include <atomic>
+#include <cstdlib>
+#include <deque>
 #include <fstream>
+#include <mutex>
+#include <numeric>
 #include <random>
+#include <utility>
 #include <vector>
 
 namespace HugeCTR {
@@ -50,19 +55,108 @@ struct MmapOffset {
  */
 class MmapOffsetList {
  private:
+  // Number of batch offsets per shuffle block. Block order and per-block permutations are both
+  // derived from seed_, so epoch start stays O(#blocks) and blocks are materialized on demand.
+  static constexpr long long SHUFFLE_BLOCK_SIZE_ = 1 << 16;
+  // Number of lazily materialized block permutations kept around. Workers walk the epoch almost
+  // in lockstep, so a handful of blocks covers their skew; a dropped block can always be rebuilt
+  // deterministically from seed_.
+  static constexpr size_t MAX_CACHED_BLOCKS_ = 8;
+
   const long long length_;
-  std::vector<MmapOffset> offsets_;
+  const long long num_samples_;
+  const long long stride_;
+  const long long batchsize_;
+  const long long num_batches_;
+  const bool use_shuffle_;
+  unsigned int seed_{0};
+  std::vector<long long> block_order_; /**< shuffled order of the offset blocks */
+  std::deque<std::pair<long long, std::vector<long long>>>
+      block_cache_; /**< lazily materialized per-block batch permutations */
+  std::mutex block_mutex_;
   std::atomic<long long> counter_{0};
   const int num_workers_;
   bool repeat_;
   char* mmapped_data_;
   int fd_;
 
+  // Sample-level shuffle (HCTR_RAW_SAMPLE_SHUFFLE): batches are assembled from
+  // slices_per_batch_ coalesced runs of run_len_ consecutive samples whose positions follow a
+  // stateless per-epoch permutation, approximating global random sampling without the cost of
+  // a materialized sample index.
+  long long slices_per_batch_{0};
+  long long run_len_{0};
+  long long num_runs_{0};
+  int feistel_bits_{0}; /**< half-width in bits of the permutation domain */
+
+  static uint32_t hash32_(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x7feb352d;
+    x ^= x >> 15;
+    x *= 0x846ca68b;
+    x ^= x >> 16;
+    return x;
+  }
+
+  /* Four-round Feistel cipher over 2 * feistel_bits_ bits with cycle walking: a counter-based
+     bijection on [0, num_runs_), so any epoch position can be evaluated independently and no
+     index array is ever built. The epoch seed reshuffles the whole permutation every epoch. */
+  long long permuted_run(long long run, uint32_t epoch_seed) const {
+    const uint32_t mask = (1u << feistel_bits_) - 1;
+    long long x = run;
+    do {
+      uint32_t left = (uint32_t)(x >> feistel_bits_);
+      uint32_t right = (uint32_t)x & mask;
+      for (int round = 0; round < 4; round++) {
+        uint32_t tmp = left ^ (hash32_(right ^ hash32_(epoch_seed + round)) & mask);
+        left = right;
+        right = tmp;
+      }
+      x = ((long long)left << feistel_bits_) | right;
+    } while (x >= num_runs_);
+    return x;
+  }
+
+  /* Blocked Fisher-Yates: map an epoch position to its shuffled batch index. Full blocks trade
+     places through block_order_; within a block the batches follow a permutation that is generated
+     from seed_ and the block id the first time the block is touched. */
+  long long shuffled_batch_index(long long counter) {
+    const long long block = counter / SHUFFLE_BLOCK_SIZE_;
+    const long long pos_in_block = counter % SHUFFLE_BLOCK_SIZE_;
+    const long long src_block = block_order_[block];
+    const long long block_begin = src_block * SHUFFLE_BLOCK_SIZE_;
+    const long long block_len = std::min(SHUFFLE_BLOCK_SIZE_, num_batches_ - block_begin);
+
+    std::lock_guard<std::mutex> lock(block_mutex_);
+    for (auto& entry : block_cache_) {
+      if (entry.first == src_block) {
+        return block_begin + entry.second[pos_in_block];
+      }
+    }
+    std::vector<long long> permutation(block_len);
+    std::iota(permutation.begin(), permutation.end(), (long long)0);
+    auto rng = std::default_random_engine{seed_ + (unsigned int)src_block + 1};
+    std::shuffle(permutation.begin(), permutation.end(), rng);
+    const long long batch_idx = block_begin + permutation[pos_in_block];
+    block_cache_.emplace_back(src_block, std::move(permutation));
+    if (block_cache_.size() > MAX_CACHED_BLOCKS_) {
+      block_cache_.pop_front();
+    }
+    return batch_idx;
+  }
+
  public:
   // stride: samle size in byte
   MmapOffsetList(std::string file_name, long long num_samples, long long stride,
                  long long batchsize, bool use_shuffle, int num_workers, bool repeat)
-      : length_(num_samples * stride), num_workers_(num_workers), repeat_(repeat) {
+      : length_(num_samples * stride),
+        num_samples_(num_samples),
+        stride_(stride),
+        batchsize_(batchsize),
+        num_batches_((num_samples + batchsize - 1) / batchsize),
+        use_shuffle_(use_shuffle),
+        num_workers_(num_workers),
+        repeat_(repeat) {
     try {
       fd_ = open(file_name.c_str(), O_RDONLY, 0);
       if (fd_ == -1) {
@@ -78,30 +172,42 @@ class MmapOffsetList {
         return;
       }
 
-      auto offset_gen = [stride](char* mmapped_data, long long idx,
-                                 long long samples) -> MmapOffset {
-        char* offset = mmapped_data + idx * stride;
-        return {offset, samples};
-      };
-
-      offsets_.reserve(num_samples);
-      for (long long sample_idx = 0; sample_idx < num_samples; sample_idx += batchsize) {
-        if (sample_idx + batchsize <= num_samples) {
-          offsets_.emplace_back(offset_gen(mmapped_data_, sample_idx, batchsize));
-        } else {
-          offsets_.emplace_back(offset_gen(mmapped_data_, sample_idx, num_samples - sample_idx));
-        }
-      }
       // shuffle
       if (use_shuffle) {
         std::random_device rd;
-        unsigned int seed = rd();
+        seed_ = rd();
 
 #ifdef ENABLE_MPI
-        HCTR_MPI_THROW(MPI_Bcast(&seed, 1, MPI_UNSIGNED, 0, MPI_COMM_WORLD));
+        HCTR_MPI_THROW(MPI_Bcast(&seed_, 1, MPI_UNSIGNED, 0, MPI_COMM_WORLD));
 #endif
-        auto rng = std::default_random_engine{seed};
-        std::shuffle(std::begin(offsets_), std::end(offsets_), rng);
+        const long long num_blocks =
+            (num_batches_ + SHUFFLE_BLOCK_SIZE_ - 1) / SHUFFLE_BLOCK_SIZE_;
+        const long long num_full_blocks = num_batches_ / SHUFFLE_BLOCK_SIZE_;
+        block_order_.resize(num_blocks);
+        std::iota(block_order_.begin(), block_order_.begin() + num_blocks, (long long)0);
+        // Only full blocks trade places; a short tail block keeps its position so that the block
+        // lengths stay consistent under the index arithmetic above.
+        auto rng = std::default_random_engine{seed_};
+        std::shuffle(block_order_.begin(), block_order_.begin() + num_full_blocks, rng);
+
+        // Opt-in sample-level mode, HCTR_RAW_SAMPLE_SHUFFLE=<slices per batch> (default 8).
+        // The slice count is rounded down to a divisor of the batch size so that every full
+        // batch still reads exactly batchsize samples.
+        if (const char* env = std::getenv("HCTR_RAW_SAMPLE_SHUFFLE")) {
+          long long slices = std::atoll(env);
+          slices_per_batch_ = std::min((slices > 1) ? slices : 8, batchsize_);
+          while (batchsize_ % slices_per_batch_ != 0) {
+            slices_per_batch_--;
+          }
+          run_len_ = batchsize_ / slices_per_batch_;
+          num_runs_ = (num_samples_ + run_len_ - 1) / run_len_;
+          while ((1ll << (2 * feistel_bits_)) < num_runs_) {
+            feistel_bits_++;
+          }
+          HCTR_LOG_S(INFO, ROOT) << "Raw reader will shuffle at sample level: batches are "
+                                 << slices_per_batch_ << " runs of " << run_len_
+                                 << " consecutive samples, re-permuted every epoch" << std::endl;
+        }
       }
 
     } catch (const std::runtime_error& rt_err) {
@@ -117,18 +223,55 @@ class MmapOffsetList {
 
   MmapOffset get_offset(long long round, int worker_id) {
     size_t worker_pos = round * num_workers_ + worker_id;
-    if (!repeat_ && worker_pos >= offsets_.size()) {
+    if (!repeat_ && worker_pos >= (size_t)num_batches_) {
       throw internal_runtime_error(Error_t::EndOfFile, "EndOfFile");
     }
-    size_t counter = (round * num_workers_ + worker_id) % offsets_.size();
+    size_t counter = (round * num_workers_ + worker_id) % num_batches_;
     if (worker_id >= num_workers_) {
       HCTR_OWN_THROW(Error_t::WrongInput, "worker_id >= num_workers_");
     }
-    if (counter == offsets_.size() - 1) {
+    if (counter == (size_t)(num_batches_ - 1)) {
       // HCTR_OWN_THROW(Error_t::OutOfBound, "End of File");
       HCTR_LOG_S(INFO, WORLD) << "End of File, worker:  " << worker_id << std::endl;
     }
-    return offsets_[counter];
+    const long long batch_idx = use_shuffle_ ? shuffled_batch_index(counter) : (long long)counter;
+    const long long sample_idx = batch_idx * batchsize_;
+    const long long samples = std::min(batchsize_, num_samples_ - sample_idx);
+    return {mmapped_data_ + sample_idx * stride_, samples};
+  }
+
+  bool sample_shuffle_enabled() const { return slices_per_batch_ > 0; }
+
+  /**
+   * Sample-level counterpart of get_offset: one logical batch made of slices_per_batch_
+   * coalesced runs drawn from the per-epoch permutation. At most one run (the dataset tail)
+   * is shorter than run_len_, so at most one batch per epoch is incomplete.
+   */
+  std::vector<MmapOffset> get_offset_slices(long long round, int worker_id) {
+    size_t worker_pos = round * num_workers_ + worker_id;
+    if (!repeat_ && worker_pos >= (size_t)num_batches_) {
+      throw internal_runtime_error(Error_t::EndOfFile, "EndOfFile");
+    }
+    if (worker_id >= num_workers_) {
+      HCTR_OWN_THROW(Error_t::WrongInput, "worker_id >= num_workers_");
+    }
+    const long long counter = worker_pos % num_batches_;
+    const long long epoch = worker_pos / num_batches_;
+    const uint32_t epoch_seed = seed_ + (uint32_t)epoch * 0x9e3779b9u;
+
+    std::vector<MmapOffset> slices;
+    slices.reserve(slices_per_batch_);
+    for (long long s = 0; s < slices_per_batch_; s++) {
+      const long long run = counter * slices_per_batch_ + s;
+      if (run >= num_runs_) {
+        break;
+      }
+      const long long src_run = permuted_run(run, epoch_seed);
+      const long long sample_idx = src_run * run_len_;
+      const long long samples = std::min(run_len_, num_samples_ - sample_idx);
+      slices.push_back({mmapped_data_ + sample_idx * stride_, samples});
+    }
+    return slices;
   }
 };
 }  // namespace HugeCTR
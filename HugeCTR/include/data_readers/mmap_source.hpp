@@ -24,6 +24,7 @@ class MmapSource : public Source {
  private:
   std::shared_ptr<MmapOffsetList> mmap_offset_list_;
   MmapOffset offset_;
+  std::vector<MmapOffset> slices_; /**< batch slices when sample-level shuffle is enabled */
   int worker_id_;
   long long round_{0};
 
@@ -36,9 +37,20 @@ class MmapSource : public Source {
   // no use here
   bool is_open() noexcept { return true; }
 
+  const std::vector<MmapOffset>& get_slices() const { return slices_; }
+
   Error_t next_source() noexcept {
     try {
-      offset_ = mmap_offset_list_->get_offset(round_, worker_id_);
+      if (mmap_offset_list_->sample_shuffle_enabled()) {
+        slices_ = mmap_offset_list_->get_offset_slices(round_, worker_id_);
+        long long total_samples = 0;
+        for (const auto& slice : slices_) {
+          total_samples += slice.samples;
+        }
+        offset_ = {slices_.empty() ? nullptr : slices_[0].offset, total_samples};
+      } else {
+        offset_ = mmap_offset_list_->get_offset(round_, worker_id_);
+      }
       round_++;
       return Error_t::Success;
     } catch (const internal_runtime_error& rt_err) {
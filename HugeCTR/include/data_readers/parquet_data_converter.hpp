@@ -27,6 +27,10 @@ void convert_parquet_dense_columns(std::vector<T *> &dense_column_data_ptr, cons
                                    T *dense_data_buffers, int64_t *dev_ptr_staging,
                                    std::deque<rmm::device_buffer> &rmm_resources,
                                    rmm::mr::device_memory_resource *mr, cudaStream_t task_stream);
+// per-sample lengths of a ragged list column, consumed as a width-1 dense feature
+template <typename T>
+void extract_parquet_list_lengths(T *length_out, const int32_t *row_offsets, int num_rows,
+                                  cudaStream_t task_stream);
 template <typename T>
 size_t convert_parquet_cat_columns(
     std::vector<T *> &cat_column_data_ptr, std::vector<int32_t *> &cat_column_row_offset_ptr,
@@ -15,6 +15,8 @@
  */
 
 #pragma once
+#include <cstdlib>
+
 #include "HugeCTR/include/common.hpp"
 #include "HugeCTR/include/data_readers/data_reader_worker_interface.hpp"
 #pragma GCC diagnostic push
@@ -99,6 +101,71 @@ class ParquetDataReaderWorker : public IDataReaderWorker {
     is_eof_ = false;
     buffer_->state.store(BufferState::ReadyForWrite);
   }
+  /* Rebuild the parquet column maps from the current file's metadata and push the resulting
+     column projection down to the file source. Only the columns the model consumes survive: every
+     label/dense column plus the first slots_ categorical columns, so any extra columns of the
+     file are never decoded by cudf at all. Since the projection is specified in schema order, the
+     position of a column in the decoded table is its rank among the selected indices, and the
+     maps are expressed in those projected positions. */
+  void update_column_maps() {
+    auto source = parquet_file_source();
+    auto metadata = source->get_file_metadata();
+    auto label_col_names = metadata.get_label_names();
+    auto dense_col_names = metadata.get_cont_names();
+    auto cat_col_names = metadata.get_cat_names();
+
+    const size_t num_label_dense = label_col_names.size() + dense_col_names.size();
+    const size_t num_cat = std::min(cat_col_names.size(), static_cast<size_t>(slots_));
+    if (dense_idx_to_parquet_col_.size() == num_label_dense &&
+        categorical_idx_parquet_col_.size() == num_cat) {
+      return;
+    }
+
+    std::map<int, std::string> index_to_name;
+    std::set<int> dense_col_index;
+    std::set<int> cat_col_index;
+    for (auto& c : label_col_names) {
+      dense_col_index.insert(c.index);
+      index_to_name[c.index] = c.col_name;
+    }
+    for (auto& c : dense_col_names) {
+      dense_col_index.insert(c.index);
+      index_to_name[c.index] = c.col_name;
+    }
+    for (auto& c : cat_col_names) {
+      cat_col_index.insert(c.index);
+      index_to_name[c.index] = c.col_name;
+    }
+    // the model consumes slots_ embedding inputs; surplus categorical columns are pruned
+    while (cat_col_index.size() > num_cat) {
+      cat_col_index.erase(std::prev(cat_col_index.end()));
+    }
+
+    std::set<int> selected_index(dense_col_index);
+    selected_index.insert(cat_col_index.begin(), cat_col_index.end());
+    std::vector<std::string> projection;
+    std::map<int, int> projected_position;
+    for (int index : selected_index) {
+      projected_position[index] = static_cast<int>(projection.size());
+      projection.emplace_back(index_to_name[index]);
+    }
+
+    int i = 0;
+    dense_idx_to_parquet_col_.clear();
+    for (int index : dense_col_index) {
+      dense_idx_to_parquet_col_.insert(std::make_pair(i, projected_position[index]));
+      i++;
+    }
+    i = 0;
+    categorical_idx_parquet_col_.clear();
+    for (int index : cat_col_index) {
+      categorical_idx_parquet_col_.insert(std::make_pair(i, projected_position[index]));
+      i++;
+    }
+
+    source->set_column_projection(projection);
+  }
+
   /* seek current record starts to reading from;
    will modify
     row_group_id_pre_
@@ -109,7 +176,6 @@ class ParquetDataReaderWorker : public IDataReaderWorker {
     true if dst row_group is exactly current row_group, false otherwise
   */
   bool seek_file_by_global_id(long long global_batch, long long batchsize) {
-    std::set<int> tmp_col_index;
     auto source = parquet_file_source();
     const long long tmp_group = row_group_id_pre_;
     int file_id_pre = source->get_cur_file_id();
@@ -121,51 +187,7 @@ class ParquetDataReaderWorker : public IDataReaderWorker {
         auto metadata = source->get_file_metadata();
 
         if (metadata.get_metadata_status()) {
-          auto label_col_names = metadata.get_label_names();
-          auto dense_col_names = metadata.get_cont_names();
-          if (dense_idx_to_parquet_col_.size() !=
-              (label_col_names.size() + dense_col_names.size())) {
-            int i = 0;
-            dense_idx_to_parquet_col_.clear();
-            tmp_col_index.clear();
-            for (auto& c : label_col_names) {
-              // HCTR_LOG_S(INFO, WORLD)
-              //     << "label " << c.col_name << " index " << c.index <<
-              //     std::endl;
-              tmp_col_index.insert(c.index);
-            }
-            for (auto it = tmp_col_index.begin(); it != tmp_col_index.end(); it++) {
-              dense_idx_to_parquet_col_.insert(std::make_pair(i, *it));
-              i++;
-            }
-            tmp_col_index.clear();
-            for (auto& c : dense_col_names) {
-              // HCTR_LOG_S(INFO, WORLD)
-              //     << "dense " << c.col_name << " index " << c.index <<
-              //     std::endl;
-              tmp_col_index.insert(c.index);
-            }
-            for (auto it = tmp_col_index.begin(); it != tmp_col_index.end(); it++) {
-              dense_idx_to_parquet_col_.insert(std::make_pair(i, *it));
-              i++;
-            }
-          }
-          tmp_col_index.clear();
-
-          auto cat_col_names = metadata.get_cat_names();
-          if (categorical_idx_parquet_col_.size() != cat_col_names.size()) {
-            categorical_idx_parquet_col_.clear();
-            int i = 0;
-            for (auto& c : cat_col_names) {
-              // HCTR_LOG_S(INFO, WORLD) << "cat " << c.col_name << " index " <<
-              // c.index << std::endl;
-              tmp_col_index.insert(c.index);
-            }
-            for (auto it = tmp_col_index.begin(); it != tmp_col_index.end(); it++) {
-              categorical_idx_parquet_col_.insert(std::make_pair(i, *it));
-              i++;
-            }
-          }
+          update_column_maps();
           // hasnt been read yet
           row_group_index_pre_ = source->get_offset_to_read_within_group();
           row_group_id_pre_ = source->get_row_group_to_read();
@@ -196,7 +218,6 @@ class ParquetDataReaderWorker : public IDataReaderWorker {
     return false;
   }
   void read_new_file() {
-    std::set<int> tmp_col_index;
     auto source = parquet_file_source();
     for (int t = 0; t < MAX_TRY; t++) {
       // file source counter_ ++
@@ -205,51 +226,7 @@ class ParquetDataReaderWorker : public IDataReaderWorker {
         auto metadata = source->get_file_metadata();
 
         if (metadata.get_metadata_status()) {
-          auto label_col_names = metadata.get_label_names();
-          auto dense_col_names = metadata.get_cont_names();
-          if (dense_idx_to_parquet_col_.size() !=
-              (label_col_names.size() + dense_col_names.size())) {
-            int i = 0;
-            dense_idx_to_parquet_col_.clear();
-            tmp_col_index.clear();
-            for (auto& c : label_col_names) {
-              // HCTR_LOG_S(INFO, WORLD)
-              //     << "label " << c.col_name << " index " << c.index <<
-              //     std::endl;
-              tmp_col_index.insert(c.index);
-            }
-            for (auto it = tmp_col_index.begin(); it != tmp_col_index.end(); it++) {
-              dense_idx_to_parquet_col_.insert(std::make_pair(i, *it));
-              i++;
-            }
-            tmp_col_index.clear();
-            for (auto& c : dense_col_names) {
-              // HCTR_LOG_S(INFO, WORLD)
-              //     << "dense " << c.col_name << " index " << c.index <<
-              //     std::endl;
-              tmp_col_index.insert(c.index);
-            }
-            for (auto it = tmp_col_index.begin(); it != tmp_col_index.end(); it++) {
-              dense_idx_to_parquet_col_.insert(std::make_pair(i, *it));
-              i++;
-            }
-          }
-          tmp_col_index.clear();
-
-          auto cat_col_names = metadata.get_cat_names();
-          if (categorical_idx_parquet_col_.size() != cat_col_names.size()) {
-            categorical_idx_parquet_col_.clear();
-            int i = 0;
-            for (auto& c : cat_col_names) {
-              // HCTR_LOG_S(INFO, WORLD) << "cat " << c.col_name << " index " <<
-              // c.index << std::endl;
-              tmp_col_index.insert(c.index);
-            }
-            for (auto it = tmp_col_index.begin(); it != tmp_col_index.end(); it++) {
-              categorical_idx_parquet_col_.insert(std::make_pair(i, *it));
-              i++;
-            }
-          }
+          update_column_maps();
           records_num_file_ = source->get_num_rows();
           record_offset_file_ = 0;
           // the first row group hasnt been read yet
@@ -755,10 +732,34 @@ void ParquetDataReaderWorker<T>::read_a_batch() {
            *  Thus dense_width = dense_scalar_num / size_df
            */
           if ((dense_scalar_num % size_df)) {
-            HCTR_LOG(ERROR, WORLD, "%d dense;value_size %zu, sizedf %zu\n", k, dense_scalar_num,
-                     size_df);
-            HCTR_OWN_THROW(Error_t::WrongInput,
-                           "Parquet reader: Length of Vector dense column isn't fixed");
+            // With HCTR_PARQUET_RAGGED_DENSE set, a variable-length list column is accepted and
+            // surfaced as a width-1 sequence-length feature derived from its row offsets. The
+            // ragged values themselves stay on the CSR sparse path, so layers like SequenceMask
+            // get the true per-sample lengths without the reader materializing any padding.
+            static const bool ragged_dense_as_length{std::getenv("HCTR_PARQUET_RAGGED_DENSE") !=
+                                                     nullptr};
+            if (!ragged_dense_as_length) {
+              HCTR_LOG(ERROR, WORLD, "%d dense;value_size %zu, sizedf %zu\n", k, dense_scalar_num,
+                       size_df);
+              HCTR_OWN_THROW(Error_t::WrongInput,
+                             "Parquet reader: Length of Vector dense column isn't fixed");
+            }
+            if (row_offset_view.type().id() != cudf::type_to_id<int32_t>()) {
+              HCTR_OWN_THROW(Error_t::WrongInput,
+                             "Parquet reader: row_offset type should be int32_t");
+            }
+            rmm_resources.emplace_back(size_df * sizeof(dtype_dense), dense_stream_,
+                                       memory_resource_.get());
+            rmm::device_buffer& length_buf = rmm_resources.back();
+            extract_parquet_list_lengths(reinterpret_cast<dtype_dense*>(length_buf.data()),
+                                         row_offset_view.data<int32_t>(),
+                                         static_cast<int>(size_df), dense_stream_);
+            dense_columns_view_ref.emplace_back(
+                cudf::column_view(cudf::data_type{cudf::type_to_id<dtype_dense>()},
+                                  static_cast<cudf::size_type>(size_df), length_buf.data()));
+            dense_width_dim.push_back(1l);
+            dense_dim_check += 1;
+            continue;
           }
           const int64_t dense_width = dense_scalar_num / size_df;
           // if the vector dense is not of float type
@@ -837,9 +838,16 @@ void ParquetDataReaderWorker<T>::read_a_batch() {
           device_csr_value_buffers[k] = reinterpret_cast<void*>(dst_sparse_tensor.get_value_ptr());
           device_csr_row_offset_buffers[k] =
               reinterpret_cast<void*>(dst_sparse_tensor.get_rowoffset_ptr());
-          size_t size_of_csr_roff_buffer = sizeof(T) * (params_[k].slot_num * batch_size + 1);
-          HCTR_LIB_THROW(cudaMemsetAsync(device_csr_row_offset_buffers[k], 0,
-                                         size_of_csr_roff_buffer, task_stream_));
+          // The offset kernel writes every row length of the first current_batch_size samples
+          // (plus the leading zero), so only the tail of an incomplete batch has to be
+          // zero-filled before the prefix sum instead of a full pass over the buffer
+          if (current_batch_size < batch_size) {
+            size_t elements_written = params_[k].slot_num * current_batch_size + 1;
+            size_t elements_tail = params_[k].slot_num * (batch_size - current_batch_size);
+            HCTR_LIB_THROW(cudaMemsetAsync(
+                reinterpret_cast<T*>(device_csr_row_offset_buffers[k]) + elements_written, 0,
+                sizeof(T) * elements_tail, task_stream_));
+          }
         }
 
         int param_id = 0;
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2021, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <common.hpp>
+#include <cstring>
+#include <data_readers/file_list.hpp>
+#include <data_readers/source.hpp>
+#include <general_buffer2.hpp>
+#include <io/filesystem.hpp>
+#include <thread>
+#include <vector>
+
+namespace HugeCTR {
+
+/**
+ * A Source that streams files straight from a remote file system (HDFS, S3, ...) instead of
+ * requiring them to be staged to local disk first. The current file is fetched by a small pool
+ * of I/O threads that issue ranged reads in parallel into a ring of pinned chunk buffers, while
+ * read() consumes the chunks in order. Any FileSystem that DataSourceParams can create works
+ * here, since only get_file_size() and ranged read() are used.
+ */
+class RemoteFileSource : public Source {
+ private:
+  static constexpr size_t CHUNK_SIZE_ = 8ul << 20; /**< ranged read granularity */
+  static constexpr int NUM_SLOTS_ = 4;             /**< chunk buffers in flight */
+  static constexpr int NUM_IO_THREADS_ = 4;        /**< parallel ranged reads */
+
+  FileList file_list_;              /**< file list of data set */
+  std::unique_ptr<FileSystem> fs_;  /**< remote file system created from DataSourceParams */
+  const long long offset_;
+  const long long stride_;
+  bool repeat_;
+  unsigned int counter_{0};
+
+  CudaHostAllocator host_allocator_;
+  std::vector<char*> slot_data_;                  /**< ring of pinned chunk buffers */
+  size_t slot_bytes_[NUM_SLOTS_];                 /**< valid bytes, set before publishing */
+  std::atomic<long long> slot_chunk_[NUM_SLOTS_]; /**< resident chunk id, -1 when free */
+
+  std::string file_name_; /**< file name of current file */
+  size_t file_size_{0};
+  size_t num_chunks_{0};
+  std::atomic<size_t> next_fetch_chunk_{0}; /**< next chunk an I/O thread should fetch */
+  std::atomic<size_t> consumed_chunks_{0};  /**< chunks fully drained by read() */
+  size_t read_chunk_{0};                    /**< chunk read() is currently draining */
+  size_t read_pos_{0};                      /**< position of read() within the chunk */
+  std::atomic<bool> fetch_failed_{false};
+  std::atomic<bool> terminate_{false};
+  std::vector<std::thread> io_threads_;
+  bool open_{false};
+
+  void fetch_loop() {
+    while (!terminate_.load()) {
+      size_t chunk = next_fetch_chunk_.fetch_add(1);
+      if (chunk >= num_chunks_) {
+        return;
+      }
+      // The slot becomes ours once the chunk it held NUM_SLOTS_ iterations ago is drained.
+      while (chunk >= consumed_chunks_.load() + NUM_SLOTS_) {
+        if (terminate_.load()) {
+          return;
+        }
+        usleep(10);
+      }
+      int slot = chunk % NUM_SLOTS_;
+      size_t chunk_beg = chunk * CHUNK_SIZE_;
+      size_t chunk_len = std::min(CHUNK_SIZE_, file_size_ - chunk_beg);
+      int bytes_read = fs_->read(file_name_, slot_data_[slot], chunk_len, chunk_beg);
+      if (bytes_read != static_cast<int>(chunk_len)) {
+        fetch_failed_.store(true);
+        return;
+      }
+      slot_bytes_[slot] = chunk_len;
+      slot_chunk_[slot].store(static_cast<long long>(chunk));
+    }
+  }
+
+  void stop_io_threads() {
+    terminate_.store(true);
+    for (auto& thread : io_threads_) {
+      thread.join();
+    }
+    io_threads_.clear();
+    terminate_.store(false);
+  }
+
+ public:
+  RemoteFileSource(long long offset, long long stride, const std::string& file_list, bool repeat,
+                   const DataSourceParams& data_source_params)
+      : file_list_(file_list),
+        fs_(data_source_params.create_unique()),
+        offset_(offset),
+        stride_(stride),
+        repeat_(repeat) {
+    HCTR_CHECK_HINT(
+        file_list_.get_num_of_files() >= stride_,
+        "The number of data reader workers should be no greater than the number of files in the "
+        "file list. Please re-configure num_workers within DataReaderParams.");
+    slot_data_.resize(NUM_SLOTS_);
+    for (int slot = 0; slot < NUM_SLOTS_; slot++) {
+      slot_data_[slot] = static_cast<char*>(host_allocator_.allocate(CHUNK_SIZE_));
+      slot_chunk_[slot].store(-1);
+      slot_bytes_[slot] = 0;
+    }
+  }
+
+  ~RemoteFileSource() {
+    stop_io_threads();
+    for (auto ptr : slot_data_) {
+      host_allocator_.deallocate(ptr);
+    }
+  }
+
+  /**
+   * Read "bytes_to_read" byte to the memory associated to ptr.
+   * The bytes are served from the chunk ring as the I/O threads publish them.
+   * @param ptr pointer to user located buffer
+   * @param bytes_to_read bytes to read
+   * @return `FileCannotOpen` `OutOfBound` `Success` `UnspecificError`
+   */
+  Error_t read(char* ptr, size_t bytes_to_read) noexcept {
+    try {
+      if (!open_) {
+        return Error_t::FileCannotOpen;
+      }
+      size_t copied = 0;
+      while (copied < bytes_to_read) {
+        if (fetch_failed_.load()) {
+          return Error_t::UnspecificError;
+        }
+        if (read_chunk_ >= num_chunks_) {
+          return Error_t::OutOfBound;
+        }
+        int slot = read_chunk_ % NUM_SLOTS_;
+        while (slot_chunk_[slot].load() != static_cast<long long>(read_chunk_)) {
+          if (fetch_failed_.load()) {
+            return Error_t::UnspecificError;
+          }
+          usleep(10);
+        }
+        size_t chunk_remain = slot_bytes_[slot] - read_pos_;
+        size_t copy_len = std::min(chunk_remain, bytes_to_read - copied);
+        std::memcpy(ptr + copied, slot_data_[slot] + read_pos_, copy_len);
+        copied += copy_len;
+        read_pos_ += copy_len;
+        if (read_pos_ == slot_bytes_[slot]) {
+          slot_chunk_[slot].store(-1);
+          consumed_chunks_.fetch_add(1);
+          read_chunk_++;
+          read_pos_ = 0;
+        }
+      }
+      return Error_t::Success;
+    } catch (const std::runtime_error& rt_err) {
+      HCTR_LOG_S(ERROR, WORLD) << rt_err.what() << std::endl;
+      return Error_t::UnspecificError;
+    }
+  }
+
+  /**
+   * Start a new file to read: restart the I/O threads against the next file in the list.
+   * @return `Success`, `EndOfFile`, `FileCannotOpen` or `UnspecificError`
+   */
+  Error_t next_source() noexcept {
+    try {
+      stop_io_threads();
+      open_ = false;
+      std::string file_name = file_list_.get_a_file_with_id(offset_ + counter_ * stride_, repeat_);
+      counter_++;  // counter_ should be accum for every source.
+      if (file_name.empty()) {
+        return Error_t::EndOfFile;
+      }
+      file_name_ = file_name;
+      file_size_ = fs_->get_file_size(file_name_);
+      if (file_size_ == 0) {
+        HCTR_LOG_S(ERROR, WORLD) << "get_file_size() failed: " << file_name_ << ' '
+                                 << HCTR_LOCATION() << std::endl;
+        return Error_t::FileCannotOpen;
+      }
+      num_chunks_ = (file_size_ + CHUNK_SIZE_ - 1) / CHUNK_SIZE_;
+      next_fetch_chunk_.store(0);
+      consumed_chunks_.store(0);
+      read_chunk_ = 0;
+      read_pos_ = 0;
+      fetch_failed_.store(false);
+      for (int slot = 0; slot < NUM_SLOTS_; slot++) {
+        slot_chunk_[slot].store(-1);
+      }
+      size_t num_io_threads = std::min(static_cast<size_t>(NUM_IO_THREADS_), num_chunks_);
+      for (size_t i = 0; i < num_io_threads; i++) {
+        io_threads_.emplace_back([this]() { fetch_loop(); });
+      }
+      open_ = true;
+      return Error_t::Success;
+    } catch (const std::runtime_error& rt_err) {
+      HCTR_LOG_S(ERROR, WORLD) << rt_err.what() << std::endl;
+      return Error_t::UnspecificError;
+    }
+  }
+
+  bool is_open() noexcept { return open_; }
+};
+
+}  // namespace HugeCTR
@@ -15,6 +15,7 @@
  */
 
 #pragma once
+#include <cstdint>
 #include <gpu_resource.hpp>
 #include <tensor2.hpp>
 
@@ -30,6 +31,19 @@ class UniformGenerator {
                    const curandGenerator_t& generator, const cudaStream_t& stream);
 };
 
+/**
+ * Counter-based uniform fill: every element is a pure function of (seed, table_id, row, col)
+ * evaluated through a Philox counter, so the result is bitwise identical for any GPU count or
+ * table sharding while all threads write independently at full memory bandwidth. Used for
+ * deterministic embedding table initialization (HCTR_DETERMINISTIC_INIT).
+ */
+class PhiloxUniformGenerator {
+ public:
+  template <typename T>
+  static void fill(T* ptr, size_t num_rows, size_t embedding_vec_size, T a, T b, size_t table_id,
+                   size_t row_offset, uint64_t seed, size_t sm_count, const cudaStream_t& stream);
+};
+
 class SinusoidalGenerator {
  public:
   template <typename T>
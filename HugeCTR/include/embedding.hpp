@@ -52,6 +52,23 @@ class IEmbedding {
   virtual void reset() = 0;
   virtual void reset_optimizer() = 0;
 
+  /**
+   * Collect the <key, embedding> pairs the optimizer has touched since the previous call, and
+   * reset the touched set. Embedding types that do not track updates return false.
+   */
+  virtual bool dump_incremental(std::vector<long long>& keys, std::vector<float>& vectors) {
+    return false;
+  }
+
+  /**
+   * Redistribute the <key, embedding> pairs held in buf_bag to their owning ranks under the
+   * current GPU topology, so that parameters dumped with dump_parameters(BufferBag&, ...) under a
+   * different GPU count can be handed to load_parameters(BufferBag&, ...) after an elastic rescale
+   * without a round trip through a checkpoint file. Embedding types whose sharding is not a pure
+   * function of the key return false.
+   */
+  virtual bool reshard_parameters(BufferBag& buf_bag, size_t* num) { return false; }
+
   virtual void dump_opt_states(std::ofstream& stream, std::string write_path,
                                const DataSourceParams& data_source_params) = 0;
   virtual void load_opt_states(std::ifstream& stream, std::string read_path,
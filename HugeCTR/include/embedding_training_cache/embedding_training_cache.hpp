@@ -62,6 +62,12 @@ class EmbeddingTrainingCache {
 
   void update(std::string& keyset_file) { impl_base_->update(keyset_file); }
 
+  void prefetch(std::vector<std::string>& keyset_file_list) {
+    impl_base_->prefetch(keyset_file_list);
+  }
+
+  void prefetch(std::string& keyset_file) { impl_base_->prefetch(keyset_file); }
+
   std::vector<std::pair<std::vector<long long>, std::vector<float>>> get_incremental_model(
       const std::vector<long long>& keys_to_load) {
     return impl_base_->get_incremental_model(keys_to_load);
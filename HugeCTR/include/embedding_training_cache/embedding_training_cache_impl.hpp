@@ -31,6 +31,8 @@ class EmbeddingTrainingCacheImplBase {
   virtual void dump() = 0;
   virtual void update(std::vector<std::string>&) = 0;
   virtual void update(std::string&) = 0;
+  virtual void prefetch(std::vector<std::string>&) = 0;
+  virtual void prefetch(std::string&) = 0;
   virtual void update_sparse_model_file() = 0;
   virtual std::vector<std::pair<std::vector<long long>, std::vector<float>>> get_incremental_model(
       const std::vector<long long>&) = 0;
@@ -91,6 +93,21 @@ class EmbeddingTrainingCacheImpl : public EmbeddingTrainingCacheImplBase {
    */
   void update(std::string& keyset_file) override;
 
+  /**
+   * @brief Stage the next pass's embeddings in the background so the following
+   *        update() doesn't have to pull them from the parameter servers. To be
+   *        called right after update() returns, while the current pass trains.
+   * @param keyset_file_list The file list storing keysets of the next pass.
+   */
+  void prefetch(std::vector<std::string>& keyset_file_list) override;
+
+  /**
+   * @brief Stage the next pass's embeddings in the background so the following
+   *        update() doesn't have to pull them from the parameter servers.
+   * @param keyset_file A single file storing keysets for all embeddings.
+   */
+  void prefetch(std::string& keyset_file) override;
+
   std::vector<std::pair<std::vector<long long>, std::vector<float>>> get_incremental_model(
       const std::vector<long long>& keys_to_load) override;
 
@@ -16,7 +16,10 @@
 
 #pragma once
 
+#include <condition_variable>
 #include <embedding_training_cache/hmem_cache/sparse_model_file_ts.hpp>
+#include <mutex>
+#include <thread>
 
 namespace {
 
@@ -67,16 +70,47 @@ class HMemCache {
   bool is_full_{false};
   int head_id_{-1};
 
+  // Per-block dirty flags (index num_block_ is the temp block). A block turns dirty when the
+  // cache refills or updates it, and clean again once its content is dumped to SSD, so the
+  // eviction and sync_to_ssd paths only dump blocks that still differ from the SSD copy.
+  std::vector<char> block_dirty_;
+
+  // Peer host-memory tier (HCTR_ETC_PEER_CACHE): before falling back to SSD, keys are looked
+  // up in the DRAM cache blocks of the other nodes through a collective exchange, since a key
+  // that is cold here may still be hot in another node's cache. Only active with >1 process.
+  const bool peer_cache_;
+
+  // Background write-back (HCTR_HMEM_CACHE_ASYNC_WB): a writer thread trickles dirty blocks
+  // to SSD while training computes, so the pass-boundary flush only covers the residue.
+  // wb_mutex_ serializes read/write/sync_to_ssd against one in-flight block dump.
+  const bool async_wb_;
+  std::mutex wb_mutex_;
+  std::condition_variable wb_cv_;
+  bool wb_terminate_{false};
+  std::thread wb_thread_;
+
   std::shared_ptr<SparseModelFileTS<TypeKey>> sparse_model_file_ptr_;
 
   size_t find_(TypeKey key);
   std::pair<int, size_t> cascade_find_(TypeKey key);
+  void write_back_loop_();
+#ifdef ENABLE_MPI
+  /**
+   * Fills entries of keys (position-aligned with slot_id_ptr / data_ptrs) from the DRAM cache
+   * blocks of peer nodes. Collective over MPI_COMM_WORLD; every rank must call it once per
+   * read, with an empty key list if it has nothing to fetch.
+   * @return flags marking which positions were satisfied remotely.
+   */
+  std::vector<char> peer_fetch_(const std::vector<TypeKey> &keys, size_t *slot_id_ptr,
+                                std::vector<float *> &data_ptrs);
+#endif
 
  public:
   HMemCache(size_t num_cached_pass, double target_hit_rate, size_t max_num_evict,
             size_t max_vocabulary_size, std::string sparse_model_file, std::string local_path,
             bool use_slot_id, Optimizer_t opt_type, size_t emb_vec_size,
             std::shared_ptr<ResourceManager> resource_manager);
+  ~HMemCache();
 
   std::pair<std::vector<long long>, std::vector<float>> read(long long const *key_ptr, size_t len);
   void read(TypeKey *key_ptr, size_t &len, size_t *slot_id_ptr, std::vector<float *> &data_ptrs);
@@ -60,6 +60,8 @@ class SparseModelFileTS {
   void flush_mmap_to_disk_();
   void unmap_from_memory_();
   void expand_(size_t expand_size);
+  bool load_direct_(std::vector<size_t> const &ssd_idx_vec, size_t *slot_id_ptr,
+                    std::vector<float *> &data_ptrs);
 
   static size_t num_instance;
 
@@ -57,6 +57,14 @@ class ParameterServer {
    */
   void load_keyset_from_file(std::string keyset_file);
 
+  /**
+   * @brief Replace keyset_ with a keyset read by the caller. Unlike
+   *        load_keyset_from_file, it performs no MPI synchronization, so it is
+   *        safe to call from the keyset prefetching thread.
+   * @param keyset The keyset of the next pass.
+   */
+  void set_keyset(std::vector<TypeKey> keyset) { keyset_ = std::move(keyset); }
+
   /**
    * @brief Pull embedding vectors from the sparse embedding model according to
    *        keyset_. It only loads embedding vectors that their corresponding
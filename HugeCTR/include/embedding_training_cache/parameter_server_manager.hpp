@@ -16,6 +16,10 @@
 
 #pragma once
 
+#include <future>
+#include <unordered_map>
+#include <unordered_set>
+
 #include "embedding_training_cache/hmem_cache/hmem_cache.hpp"
 #include "embedding_training_cache/parameter_server.hpp"
 #include "parser.hpp"
@@ -28,6 +32,20 @@ class ParameterServerManager {
   std::vector<std::shared_ptr<ParameterServer<TypeKey>>> ps_;
   BufferBag buf_bag_;
 
+  // Async keyset prefetch (HCTR_ETC_PREFETCH): while pass N trains, a background thread pulls
+  // pass N+1's vectors into per-table staging bags; the boundary dump patches staged lines it
+  // refreshes, and load then copies the staged pass into buf_bag_ instead of re-reading SSD.
+  bool prefetch_enabled_{false};
+  std::vector<BufferBag> staging_bags_;
+  std::vector<std::string> staged_files_;
+  std::vector<size_t> staged_hit_sizes_;
+  std::vector<std::unordered_map<TypeKey, size_t>> staged_key_pos_;
+  std::vector<std::unordered_set<TypeKey>> staged_miss_keys_;
+  std::vector<size_t> emb_vec_sizes_;
+  std::vector<size_t> vecs_per_line_;
+  std::vector<bool> use_slot_ids_;
+  std::future<void> prefetch_future_;
+
  public:
   ParameterServerManager(std::vector<TrainPSType_t>& ps_types,
                          std::vector<std::string>& sparse_embedding_files,
@@ -47,8 +65,39 @@ class ParameterServerManager {
   BufferBag& get_buffer_bag() { return buf_bag_; }
 
   void update_sparse_model_file() {
+    wait_prefetch();
     for (auto& ps : ps_) ps->flush_emb_tbl_to_ssd();
   }
+
+  /**
+   * @brief Launch a background thread that pulls the given keysets into the
+   *        staging bags so the next update() can skip its synchronous pull.
+   *        A no-op (with a warning) unless HCTR_ETC_PREFETCH is set.
+   * @param keyset_file_list One keyset file per embedding table.
+   */
+  void prefetch(const std::vector<std::string>& keyset_file_list);
+
+  /**
+   * @brief Block until the in-flight prefetch (if any) completes. Must be
+   *        called before the parameter servers are accessed from the calling
+   *        thread; rethrows any exception raised by the prefetching thread.
+   */
+  void wait_prefetch();
+
+  /**
+   * @brief Overwrite staged lines of table i with the content just dumped to
+   *        buf_bag_, so vectors trained in the current pass are not served
+   *        stale from the staging bag. Called with the dump still in buf_bag_.
+   */
+  void patch_prefetched(size_t i, size_t dump_size);
+
+  /**
+   * @brief Copy the staged pass of table i into buf_bag_ if it matches
+   *        keyset_file. Returns false (and leaves hit_size untouched) if
+   *        nothing suitable is staged, in which case the caller must pull
+   *        synchronously.
+   */
+  bool use_prefetched(size_t i, const std::string& keyset_file, size_t& hit_size);
 };
 
 }  // namespace HugeCTR
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <unordered_set>
+
 #include "embedding.hpp"
 #include "embedding_training_cache/sparse_model_file.hpp"
 
@@ -28,6 +30,12 @@ class SparseModelEntity {
   std::vector<float> host_emb_tabel_;
   HashTableType exist_key_idx_mapping_;
   HashTableType new_key_idx_mapping_;
+  /// Keys whose host-memory vectors may differ from the on-disk copy. Only
+  /// dump_vec_by_key modifies host_emb_tabel_, so any key it never touched is
+  /// still byte-identical to the sparse model file and can be skipped when
+  /// flushing (enabled by HCTR_DELTA_CHECKPOINT).
+  std::unordered_set<TypeKey> dirty_keys_;
+  const bool delta_flush_;
   bool is_distributed_;
   size_t emb_vec_size_;
   std::shared_ptr<ResourceManager> resource_manager_;
@@ -68,6 +76,9 @@ class SparseModelEntity {
   /**
    * @brief Write the sparse model stored in the host memory to the disk. This
    *        function will do nothing when the SSD-based PS is used.
+   *        When HCTR_DELTA_CHECKPOINT is set, only the vectors updated since
+   *        the previous flush are written back; untouched rows are left as-is
+   *        because they already match the file contents.
    */
   void flush_emb_tbl_to_ssd();
 };
@@ -79,6 +79,10 @@ class DistributedSlotSparseEmbeddingHash : public IEmbedding {
 
   Tensors2<TypeEmbeddingComp> utest_forward_temp_tensors_;
 
+  Tensors2<uint32_t> touched_rows_tensors_; /**< Bitmap of value rows touched by the optimizer,
+                                                 only allocated when incremental dumping is on. */
+  bool track_touched_rows_{false};
+
   size_t max_vocabulary_size_;         /**< Max vocabulary size for each GPU. */
   size_t max_vocabulary_size_per_gpu_; /**< Max vocabulary size for each GPU. */
 
@@ -246,6 +250,11 @@ class DistributedSlotSparseEmbeddingHash : public IEmbedding {
           wgrad_tensors_[id], hash_table_value_tensors_[id],
           embedding_data_.get_local_gpu(id).get_sm_count(),
           embedding_data_.get_local_gpu(id).get_stream());
+      if (track_touched_rows_) {
+        functors_.mark_touched_rows(*embedding_data_.get_nnz_array(true)[id],
+                                    hash_value_index_tensors_[id], touched_rows_tensors_[id],
+                                    embedding_data_.get_local_gpu(id).get_stream());
+      }
     }
 
     return;
@@ -277,6 +286,14 @@ class DistributedSlotSparseEmbeddingHash : public IEmbedding {
                        const DataSourceParams &data_source_params) const override;
   void dump_parameters(BufferBag &buf_bag, size_t *num) const override;
 
+  /**
+   * Exchange the <key, embedding> pairs in buf_bag among ranks so that every pair ends up on the
+   * rank that owns key % global_gpu_count under the current topology. Pairs dumped under a
+   * different GPU count can then be re-inserted with load_parameters(BufferBag&, size_t), which
+   * rejects keys that mod-shard to a remote rank.
+   */
+  bool reshard_parameters(BufferBag &buf_bag, size_t *num) override;
+
   void dump_opt_states(std::ofstream &stream, std::string sparse_model,
                        const DataSourceParams &data_source_params) override;
   void load_opt_states(std::ifstream &stream, std::string read_path,
@@ -288,6 +305,13 @@ class DistributedSlotSparseEmbeddingHash : public IEmbedding {
    */
   void reset() override;
 
+  /**
+   * Collect the <key, embedding> pairs touched by update_params() since the previous call and
+   * clear the touched-row bitmaps. Only active when incremental dumping was enabled at
+   * construction time; returns false otherwise.
+   */
+  bool dump_incremental(std::vector<long long> &keys, std::vector<float> &vectors) override;
+
   /**
    * Get the total size of hash tables on all GPUs.
    */
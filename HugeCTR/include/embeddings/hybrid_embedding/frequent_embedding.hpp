@@ -113,6 +113,8 @@ class FrequentEmbeddingSingleNode : public FrequentEmbeddingBase<dtype> {
   Tensor2<emtype> frequent_embedding_vectors_cache_;
   Tensor2<emtype *> embedding_vectors_cache_pointers_;
   Tensor2<const emtype *> partial_gradients_pointers_;
+  // all instances' frequent_embedding_vectors_, for the fused direct-reduce backward
+  Tensor2<float *> embedding_vectors_pointers_;
   template <typename T>
   using BuffPtr = std::shared_ptr<BufferBlock2<T>>;
 
@@ -125,6 +127,8 @@ class FrequentEmbeddingSingleNode : public FrequentEmbeddingBase<dtype> {
   void forward_model_eval(cudaStream_t stream);
   void forward_network(emtype *interaction_layer_input, cudaStream_t stream);
   void local_reduce(const emtype *gradients, cudaStream_t stream);
+  void local_reduce_direct(const emtype *gradients, float *dev_lr, float scale,
+                           cudaStream_t stream);
   void update_model_direct(float *dev_lr, float scale, cudaStream_t stream);
 
   template <typename T = emtype>
@@ -38,6 +38,8 @@ class BatchIndices {
     return infrequent_selection_[raw_device_id];
   }
 
+  Data<dtype>& get_data(int raw_device_id) { return data_[raw_device_id]; }
+
  private:
   size_t num_slots_ = 0;
   std::shared_ptr<ResourceManager> resource_manager_;
@@ -125,6 +125,12 @@ class InfrequentEmbedding_IB_NVLINK : public InfrequentEmbeddingBase<dtype> {
       infrequent_backward_comm_buffers_;
   std::unique_ptr<Communication> infrequent_forward_comms_, infrequent_backward_comms_;
 
+  // When emtype is float, HCTR_INFREQUENT_COMM_FP16 packs the all-to-all messages as __half
+  // (two per float slot) to halve the inter-node bytes. The pack/unpack kernels fuse the
+  // conversion and the optimizer still accumulates in FP32, so only the wire format changes.
+  // Ignored when emtype is already __half or the embedding vector size is odd.
+  bool comm_compress_fp16_ = false;
+
   // requires model_ and data_ to be set
   InfrequentEmbedding_IB_NVLINK(Model<dtype> &model, GPUResource &gpu_resource,
                                 size_t embedding_vec_size);
@@ -88,6 +88,7 @@ struct Statistics {
     buf->reserve({num_tables + 1, 1}, &table_offsets);
     buf->reserve({num_tables + 1, 1}, &infrequent_model_table_offsets);
     buf->reserve({num_instances * (num_tables + 1), 1}, &frequent_model_table_offsets);
+    buf->reserve({1, 1}, &frequent_overlap_count);
     reserve_temp_storage(buf);
   }
 
@@ -100,9 +101,22 @@ struct Statistics {
   // top categories sorted by count
   Tensor2<dtype> categories_sorted;
   Tensor2<uint32_t> counts_sorted;
+
+  /* Count-min sketch estimator used instead of the full radix sort when
+   * HCTR_HYBRID_SKETCH_STATISTICS is set. The sketch counts every sample occurrence, then only
+   * the categories whose estimated count reaches sketch_min_count_ (HCTR_HYBRID_SKETCH_MIN_COUNT,
+   * default 2) are compacted and sorted. Singletons can never pass the frequent-category count
+   * threshold, so dropping them up front shrinks the descending sort from the full unique set to
+   * the repeated categories only. */
+  bool use_sketch_{false};
+  uint32_t sketch_min_count_{2};
+  size_t sketch_width_{0};  // counters per sketch row, power of two
+  Tensor2<uint32_t> sketch_counters_;
+  Tensor2<unsigned long long> sketch_claim_bitmap_;  // 1 bit per category: candidate published
   Tensor2<dtype> table_offsets;  // cumulative sum of table_sizes
   Tensor2<dtype> infrequent_model_table_offsets;
   Tensor2<dtype> frequent_model_table_offsets;
+  Tensor2<uint32_t> frequent_overlap_count;
   std::vector<Tensor2<unsigned char>> sort_categories_by_count_temp_storages_;
   std::vector<Tensor2<unsigned char>> calculate_frequent_categories_temp_storages_;
   std::vector<Tensor2<unsigned char>> calculate_infrequent_categories_temp_storages_;
@@ -111,6 +125,11 @@ struct Statistics {
                                 uint32_t *counts_sorted, uint32_t &num_unique_categories,
                                 cudaStream_t stream);
   void sort_categories_by_count(const Tensor2<dtype> &samples, cudaStream_t stream);
+  void estimate_categories_by_count(const dtype *samples, size_t num_samples,
+                                    dtype *categories_sorted, uint32_t *counts_sorted,
+                                    uint32_t &num_unique_categories, cudaStream_t stream);
+  uint32_t calculate_frequent_overlap(const Tensor2<dtype> &category_location, dtype num_frequent,
+                                      uint32_t num_instances, cudaStream_t stream);
   void calculate_frequent_and_infrequent_categories(
       dtype *frequent_categories, dtype *infrequent_categories, dtype *category_location,
       const size_t num_frequent, const size_t num_infrequent, cudaStream_t stream);
@@ -131,9 +131,20 @@ class HybridSparseEmbedding : public SchedulableEmbeding {
       0; /**< Current batch size (since we need to handle incomplete batch). */
   bool current_train_batch_cached_ = false; /**< Used to check if BatchIndices already computed. */
   bool current_eval_batch_cached_ = false;  /**< Used to check if BatchIndices already computed. */
+  bool precompute_indices_enabled_ = false;  /**< Compute indices on a side stream ahead of the
+                                                pipeline (HCTR_PRECOMPUTE_INDICES). */
+  bool train_indices_precomputed_ = false;   /**< Current train batch's indices are ready. */
+  bool eval_indices_precomputed_ = false;    /**< Current eval batch's indices are ready. */
   std::vector<BatchIndices<dtype>> train_batch_indices_; /**< Stores indices for Batch. */
   std::vector<BatchIndices<dtype>> eval_batch_indices_;  /**< Stores indices for Batch. */
 
+  size_t drift_check_iters_ = 0; /**< Check frequent-category drift every N iterations, 0 = off. */
+  bool frequent_direct_reduce_ = false; /**< Apply frequent gradients straight into the owner
+                                          instances' vectors over NVLink, skipping the staging
+                                          pass (HCTR_FREQUENT_DIRECT_REDUCE). */
+  size_t drift_window_pos_ = 0;  /**< Next slice of the statistics window to overwrite. */
+  size_t train_steps_ = 0;       /**< Number of train iterations seen by the drift monitor. */
+
   // TODO: this parameter is not used by HE at all.
   // We should be in pursuit of merging SparseEmbeddingHashParams and HybridSparseEmbeddingParams
   SparseEmbeddingHashParams dummy_params_;
@@ -193,6 +204,8 @@ class HybridSparseEmbedding : public SchedulableEmbeding {
 
   GPUResource& get_local_gpu(int i) const { return *resource_manager_->get_local_gpu(i); }
 
+  void update_frequent_category_drift(int i, cudaStream_t stream);
+
   size_t get_categories_num() {
     size_t num_categories = 0;
     for (size_t i = 0; i < embedding_params_.slot_size_array.size(); ++i) {
@@ -265,6 +278,7 @@ class HybridSparseEmbedding : public SchedulableEmbeding {
 
   void assign_input_tensors(bool is_train, size_t batch_size, size_t inflight_id,
                             bool cached) override;
+  void precompute_indices(bool is_train) override;
   void index_calculation(bool is_train, int i) override;
   void freq_forward(bool is_train, int i, bool is_first_eval_batch) override;
   void freq_backward(int i) override;
@@ -20,6 +20,7 @@
 #include "HugeCTR/include/common.hpp"
 #include "HugeCTR/include/embeddings/embedding_data.hpp"
 #include "HugeCTR/include/embeddings/sparse_embedding_functors.hpp"
+#include "HugeCTR/include/graph_wrapper.hpp"
 #include "HugeCTR/include/utils.hpp"
 
 namespace HugeCTR {
@@ -79,6 +80,15 @@ class LocalizedSlotSparseEmbeddingHash : public IEmbedding {
   size_t max_vocabulary_size_per_gpu_;   /**< Max vocabulary size for each GPU. */
   std::vector<size_t> slot_num_per_gpu_; /* slot_num per GPU */
   std::vector<size_t> slot_size_array_;
+  size_t all2all_chunk_num_{1}; /**< slices of the chunked all2all pipeline, 1 = one exchange */
+  bool use_train_graph_{false};            /**< replay the train forward()/backward() as graphs */
+  std::vector<GraphWrapper> fprop_graphs_; /**< per-GPU graph of the captured train forward */
+  std::vector<GraphWrapper> bprop_graphs_; /**< per-GPU graph of the captured backward */
+  std::vector<size_t> fprop_captured_nnz_; /**< per-GPU nnz the forward graphs were built with */
+  bool use_quantized_read_{false};    /**< serve forward lookups from an int8 copy of the table */
+  bool quantized_table_ready_{false}; /**< whether the int8 copy reflects the fp32 table */
+  Tensors2<char> quantized_table_tensors_;  /**< int8 shadow of hash_table_value_tensors_ */
+  Tensors2<float> quantized_scale_tensors_; /**< per-row dequantization scales */
 
   SparseEmbeddingFunctors functors_;
 
@@ -203,74 +213,148 @@ class LocalizedSlotSparseEmbeddingHash : public IEmbedding {
       const Tensors2<size_t> &hash_table_slot_id_tensors,
       const std::vector<std::shared_ptr<HashTable<TypeHashKey, size_t>>> &hash_tables) const;
 
- public:
-  LocalizedSlotSparseEmbeddingHash(const SparseTensors<TypeHashKey> &train_keys,
-                                   const SparseTensors<TypeHashKey> &evaluate_keys,
-                                   const SparseEmbeddingHashParams &embedding_params,
-                                   const std::shared_ptr<ResourceManager> &resource_manager);
+  /**
+   * Device-native snapshot of the hash-table state. Instead of converting each GPU's table
+   * into portable key/slot_id/vector arrays, the raw slot array plus the used rows of the
+   * slot-id and value tensors are streamed to one file per (rank, gpu) through a pinned
+   * staging buffer, and load_parameters_raw() restores them with plain copies, skipping the
+   * per-key re-insertion entirely. A snapshot is only valid for the same GPU mapping, table
+   * capacity and container type that produced it; use dump_parameters() for portable models.
+   * @param snapshot_dir directory that receives (holds) the per-GPU snapshot files.
+   */
+  void dump_parameters_raw(const std::string &snapshot_dir) const;
+  void load_parameters_raw(const std::string &snapshot_dir);
 
-  void filter_keys_per_gpu(bool is_train, size_t id, size_t global_id, size_t global_num);
+  /**
+   * Chunked all2all + reorder pipeline for forward: the batch is split into
+   * all2all_chunk_num_ sample slices, the exchange of each slice runs on dedicated per-GPU
+   * all2all streams, and the reorder of slice k on the compute streams overlaps with the
+   * exchange of slice k+1.
+   */
+  void forward_all2all_overlapped(bool is_train) {
+    size_t local_gpu_count = embedding_data_.get_resource_manager().get_local_gpu_count();
+    size_t batch_size_per_gpu = embedding_data_.get_batch_size_per_gpu(is_train);
+
+    std::vector<cudaStream_t> comm_streams(local_gpu_count);
+    for (size_t id = 0; id < local_gpu_count; id++) {
+      auto &local_gpu = embedding_data_.get_resource_manager().get_local_gpu(id);
+      CudaDeviceContext context(local_gpu->get_device_id());
+      comm_streams[id] = local_gpu->get_stream("embedding_all2all");
+      // the exchange must see the embedding features produced on the compute stream
+      const cudaEvent_t &ready = local_gpu->get_event("all2all_src_ready");
+      HCTR_LIB_THROW(cudaEventRecord(ready, local_gpu->get_stream()));
+      HCTR_LIB_THROW(cudaStreamWaitEvent(comm_streams[id], ready, 0));
+    }
+
+    for (size_t chunk = 0; chunk < all2all_chunk_num_; chunk++) {
+      size_t sample_begin = chunk * batch_size_per_gpu / all2all_chunk_num_;
+      size_t sample_end = (chunk + 1) * batch_size_per_gpu / all2all_chunk_num_;
+#ifndef ENABLE_MPI
+      functors_.all2all_forward_chunk(sample_begin, sample_end - sample_begin, batch_size_per_gpu,
+                                      slot_num_per_gpu_,
+                                      embedding_data_.embedding_params_.embedding_vec_size,
+                                      embedding_feature_tensors_, all2all_tensors_,
+                                      embedding_data_.get_resource_manager(), comm_streams);
+#else
+      functors_.all2all_forward_chunk(sample_begin, sample_end - sample_begin, batch_size_per_gpu,
+                                      embedding_data_.embedding_params_.slot_num,
+                                      embedding_data_.embedding_params_.embedding_vec_size,
+                                      embedding_feature_tensors_, all2all_tensors_,
+                                      embedding_data_.get_resource_manager(), comm_streams);
+#endif
+      for (size_t id = 0; id < local_gpu_count; id++) {
+        auto &local_gpu = embedding_data_.get_resource_manager().get_local_gpu(id);
+        CudaDeviceContext context(local_gpu->get_device_id());
+        const cudaEvent_t &done = local_gpu->get_event("all2all_chunk_done");
+        HCTR_LIB_THROW(cudaEventRecord(done, comm_streams[id]));
+        HCTR_LIB_THROW(cudaStreamWaitEvent(local_gpu->get_stream(), done, 0));
+      }
+      functors_.forward_reorder_chunk(
+          sample_begin, sample_end - sample_begin, batch_size_per_gpu,
+          embedding_data_.embedding_params_.slot_num,
+          embedding_data_.embedding_params_.embedding_vec_size, all2all_tensors_,
+          embedding_data_.get_output_tensors(is_train), embedding_data_.get_resource_manager());
+    }
+  }
 
   /**
-   * The forward propagation of embedding layer.
+   * The compute stage of forward(): per-GPU lookup, the inter-GPU exchange, the reorder and
+   * the slot id store. Everything here is stream-ordered work, so the whole stage can be
+   * recorded into the per-GPU CUDA graphs by forward_graph().
    */
-  void forward(bool is_train) override {
+  void forward_core(bool is_train) {
 #pragma omp parallel num_threads(embedding_data_.get_resource_manager().get_local_gpu_count())
     {
       size_t i = omp_get_thread_num();
       CudaDeviceContext context(embedding_data_.get_local_gpu(i).get_device_id());
 
-      if (embedding_data_.embedding_params_.is_data_parallel) {
-        filter_keys_per_gpu(is_train, i, embedding_data_.get_local_gpu(i).get_global_id(),
-                            embedding_data_.get_resource_manager().get_global_gpu_count());
+      if (use_quantized_read_) {
+        functors_.forward_per_gpu_quantized(
+            embedding_data_.embedding_params_.get_batch_size(is_train), slot_num_per_gpu_[i],
+            embedding_data_.embedding_params_.embedding_vec_size,
+            embedding_data_.embedding_params_.combiner, is_train,
+            embedding_data_.get_row_offsets_tensors(is_train)[i],
+            embedding_data_.get_value_tensors(is_train)[i],
+            *embedding_data_.get_nnz_array(is_train)[i], *hash_tables_[i],
+            quantized_table_tensors_[i], quantized_scale_tensors_[i], hash_value_index_tensors_[i],
+            embedding_feature_tensors_[i], embedding_data_.get_local_gpu(i).get_stream());
+      } else {
+        functors_.forward_per_gpu(
+            embedding_data_.embedding_params_.get_batch_size(is_train), slot_num_per_gpu_[i],
+            embedding_data_.embedding_params_.embedding_vec_size,
+            embedding_data_.embedding_params_.combiner, is_train,
+            embedding_data_.get_row_offsets_tensors(is_train)[i],
+            embedding_data_.get_value_tensors(is_train)[i],
+            *embedding_data_.get_nnz_array(is_train)[i], *hash_tables_[i],
+            hash_table_value_tensors_[i], hash_value_index_tensors_[i],
+            embedding_feature_tensors_[i], embedding_data_.get_local_gpu(i).get_stream());
       }
-      functors_.forward_per_gpu(
-          embedding_data_.embedding_params_.get_batch_size(is_train), slot_num_per_gpu_[i],
-          embedding_data_.embedding_params_.embedding_vec_size,
-          embedding_data_.embedding_params_.combiner, is_train,
-          embedding_data_.get_row_offsets_tensors(is_train)[i],
-          embedding_data_.get_value_tensors(is_train)[i],
-          *embedding_data_.get_nnz_array(is_train)[i], *hash_tables_[i],
-          hash_table_value_tensors_[i], hash_value_index_tensors_[i], embedding_feature_tensors_[i],
-          embedding_data_.get_local_gpu(i).get_stream());
     }
 
-// do all-to-all
-#ifndef ENABLE_MPI
-    if (embedding_data_.get_resource_manager().get_global_gpu_count() > 1) {
-      functors_.all2all_forward(embedding_data_.get_batch_size_per_gpu(is_train), slot_num_per_gpu_,
-                                embedding_data_.embedding_params_.embedding_vec_size,
-                                embedding_feature_tensors_, all2all_tensors_,
-                                embedding_data_.get_resource_manager());
+    // do all-to-all + reorder; the chunked pipeline overlaps the two, the single-shot path
+    // below runs them back to back
+    if (all2all_chunk_num_ > 1 &&
+        embedding_data_.get_resource_manager().get_global_gpu_count() > 1 &&
+        embedding_data_.get_batch_size_per_gpu(is_train) >= all2all_chunk_num_) {
+      forward_all2all_overlapped(is_train);
     } else {
-      HCTR_LIB_THROW(cudaMemcpyAsync(
-          all2all_tensors_[0].get_ptr(), embedding_feature_tensors_[0].get_ptr(),
-          embedding_data_.get_batch_size_per_gpu(is_train) * slot_num_per_gpu_[0] *
-              embedding_data_.embedding_params_.embedding_vec_size * sizeof(TypeEmbeddingComp),
-          cudaMemcpyDeviceToDevice, embedding_data_.get_local_gpu(0).get_stream()));
-    }
+#ifndef ENABLE_MPI
+      if (embedding_data_.get_resource_manager().get_global_gpu_count() > 1) {
+        functors_.all2all_forward(embedding_data_.get_batch_size_per_gpu(is_train),
+                                  slot_num_per_gpu_,
+                                  embedding_data_.embedding_params_.embedding_vec_size,
+                                  embedding_feature_tensors_, all2all_tensors_,
+                                  embedding_data_.get_resource_manager());
+      } else {
+        HCTR_LIB_THROW(cudaMemcpyAsync(
+            all2all_tensors_[0].get_ptr(), embedding_feature_tensors_[0].get_ptr(),
+            embedding_data_.get_batch_size_per_gpu(is_train) * slot_num_per_gpu_[0] *
+                embedding_data_.embedding_params_.embedding_vec_size * sizeof(TypeEmbeddingComp),
+            cudaMemcpyDeviceToDevice, embedding_data_.get_local_gpu(0).get_stream()));
+      }
 #else
-    if (embedding_data_.get_resource_manager().get_global_gpu_count() > 1) {
-      functors_.all2all_forward(embedding_data_.get_batch_size_per_gpu(is_train),
+      if (embedding_data_.get_resource_manager().get_global_gpu_count() > 1) {
+        functors_.all2all_forward(embedding_data_.get_batch_size_per_gpu(is_train),
+                                  embedding_data_.embedding_params_.slot_num,
+                                  embedding_data_.embedding_params_.embedding_vec_size,
+                                  embedding_feature_tensors_, all2all_tensors_,
+                                  embedding_data_.get_resource_manager());
+      } else {
+        HCTR_LIB_THROW(cudaMemcpyAsync(
+            all2all_tensors_[0].get_ptr(), embedding_feature_tensors_[0].get_ptr(),
+            (size_t)embedding_data_.get_batch_size_per_gpu(is_train) * slot_num_per_gpu_[0] *
+                embedding_data_.embedding_params_.embedding_vec_size * sizeof(TypeEmbeddingComp),
+            cudaMemcpyDeviceToDevice, embedding_data_.get_local_gpu(0).get_stream()));
+      }
+#endif
+
+      // reorder
+      functors_.forward_reorder(embedding_data_.get_batch_size_per_gpu(is_train),
                                 embedding_data_.embedding_params_.slot_num,
                                 embedding_data_.embedding_params_.embedding_vec_size,
-                                embedding_feature_tensors_, all2all_tensors_,
+                                all2all_tensors_, embedding_data_.get_output_tensors(is_train),
                                 embedding_data_.get_resource_manager());
-    } else {
-      HCTR_LIB_THROW(cudaMemcpyAsync(
-          all2all_tensors_[0].get_ptr(), embedding_feature_tensors_[0].get_ptr(),
-          (size_t)embedding_data_.get_batch_size_per_gpu(is_train) * slot_num_per_gpu_[0] *
-              embedding_data_.embedding_params_.embedding_vec_size * sizeof(TypeEmbeddingComp),
-          cudaMemcpyDeviceToDevice, embedding_data_.get_local_gpu(0).get_stream()));
     }
-#endif
-
-    // reorder
-    functors_.forward_reorder(embedding_data_.get_batch_size_per_gpu(is_train),
-                              embedding_data_.embedding_params_.slot_num,
-                              embedding_data_.embedding_params_.embedding_vec_size,
-                              all2all_tensors_, embedding_data_.get_output_tensors(is_train),
-                              embedding_data_.get_resource_manager());
 
     // store slot ids
     functors_.store_slot_id(embedding_data_.embedding_params_.get_batch_size(is_train),
@@ -278,17 +362,57 @@ class LocalizedSlotSparseEmbeddingHash : public IEmbedding {
                             embedding_data_.get_row_offsets_tensors(is_train),
                             hash_value_index_tensors_, hash_table_slot_id_tensors_,
                             embedding_data_.get_resource_manager());
-
-    return;
   }
 
   /**
-   * The first stage of backward propagation of embedding layer,
-   * which computes the wgrad by the dgrad from the top layer.
+   * Replay the captured train forward, recording the per-GPU graphs on first use. The launch
+   * configuration of forward_per_gpu() is baked into the graphs together with the nnz it was
+   * captured with, so when any GPU's nnz differs from the capture the caller has to take the
+   * eager path instead.
+   * @return whether the captured graphs were played.
    */
-  void backward() override {
-    // Read dgrad from output_tensors -> compute wgrad
+  bool forward_graph(bool is_train) {
+    size_t local_gpu_count = embedding_data_.get_resource_manager().get_local_gpu_count();
+    if (fprop_graphs_[0].initialized) {
+      for (size_t i = 0; i < local_gpu_count; i++) {
+        if (fprop_captured_nnz_[i] != *embedding_data_.get_nnz_array(is_train)[i]) {
+          return false;
+        }
+      }
+    }
+
+    CudaDeviceContext context(embedding_data_.get_local_gpu(0).get_device_id());
+    if (!fprop_graphs_[0].initialized) {
+      for (size_t i = 0; i < local_gpu_count; i++) {
+        context.set_device(embedding_data_.get_local_gpu(i).get_device_id());
+        HCTR_LIB_THROW(cudaStreamBeginCapture(embedding_data_.get_local_gpu(i).get_stream(),
+                                              cudaStreamCaptureModeThreadLocal));
+      }
+      forward_core(is_train);
+      for (size_t i = 0; i < local_gpu_count; i++) {
+        context.set_device(embedding_data_.get_local_gpu(i).get_device_id());
+        GraphWrapper &graph = fprop_graphs_[i];
+        HCTR_LIB_THROW(
+            cudaStreamEndCapture(embedding_data_.get_local_gpu(i).get_stream(), &graph.graph));
+        HCTR_LIB_THROW(cudaGraphInstantiate(&graph.graph_exec, graph.graph, NULL, NULL, 0));
+        graph.initialized = true;
+        fprop_captured_nnz_[i] = *embedding_data_.get_nnz_array(is_train)[i];
+      }
+    }
 
+    // capture only records the work, so the first iteration replays the graphs as well
+    for (size_t i = 0; i < local_gpu_count; i++) {
+      context.set_device(embedding_data_.get_local_gpu(i).get_device_id());
+      fprop_graphs_[i].exec(embedding_data_.get_local_gpu(i).get_stream());
+    }
+    return true;
+  }
+
+  /**
+   * The compute stage of backward(): reorder, the inter-GPU exchange and the wgrad kernels.
+   * Stream-ordered work only, so it can be recorded by backward_graph().
+   */
+  void backward_core() {
     // reorder
     functors_.backward_reorder(embedding_data_.get_batch_size_per_gpu(true),
                                embedding_data_.embedding_params_.slot_num,
@@ -335,6 +459,97 @@ class LocalizedSlotSparseEmbeddingHash : public IEmbedding {
                        embedding_data_.embedding_params_.combiner,
                        embedding_data_.get_row_offsets_tensors(true), embedding_feature_tensors_,
                        wgrad_tensors_, embedding_data_.get_resource_manager());
+  }
+
+  /**
+   * Replay the captured backward, recording the per-GPU graphs on first use. Unlike the
+   * forward, every launch here is shaped by the batch and slot counts alone, so the graphs
+   * never have to be re-captured.
+   */
+  void backward_graph() {
+    size_t local_gpu_count = embedding_data_.get_resource_manager().get_local_gpu_count();
+    CudaDeviceContext context(embedding_data_.get_local_gpu(0).get_device_id());
+    if (!bprop_graphs_[0].initialized) {
+      for (size_t i = 0; i < local_gpu_count; i++) {
+        context.set_device(embedding_data_.get_local_gpu(i).get_device_id());
+        HCTR_LIB_THROW(cudaStreamBeginCapture(embedding_data_.get_local_gpu(i).get_stream(),
+                                              cudaStreamCaptureModeThreadLocal));
+      }
+      backward_core();
+      for (size_t i = 0; i < local_gpu_count; i++) {
+        context.set_device(embedding_data_.get_local_gpu(i).get_device_id());
+        GraphWrapper &graph = bprop_graphs_[i];
+        HCTR_LIB_THROW(
+            cudaStreamEndCapture(embedding_data_.get_local_gpu(i).get_stream(), &graph.graph));
+        HCTR_LIB_THROW(cudaGraphInstantiate(&graph.graph_exec, graph.graph, NULL, NULL, 0));
+        graph.initialized = true;
+      }
+    }
+
+    for (size_t i = 0; i < local_gpu_count; i++) {
+      context.set_device(embedding_data_.get_local_gpu(i).get_device_id());
+      bprop_graphs_[i].exec(embedding_data_.get_local_gpu(i).get_stream());
+    }
+  }
+
+ public:
+  LocalizedSlotSparseEmbeddingHash(const SparseTensors<TypeHashKey> &train_keys,
+                                   const SparseTensors<TypeHashKey> &evaluate_keys,
+                                   const SparseEmbeddingHashParams &embedding_params,
+                                   const std::shared_ptr<ResourceManager> &resource_manager);
+
+  void filter_keys_per_gpu(bool is_train, size_t id, size_t global_id, size_t global_num);
+
+  /**
+   * The forward propagation of embedding layer.
+   */
+  void forward(bool is_train) override {
+    // key filtering copies the per-GPU nnz back to the host, so it always runs eagerly,
+    // outside any captured graph
+    if (embedding_data_.embedding_params_.is_data_parallel) {
+#pragma omp parallel num_threads(embedding_data_.get_resource_manager().get_local_gpu_count())
+      {
+        size_t i = omp_get_thread_num();
+        CudaDeviceContext context(embedding_data_.get_local_gpu(i).get_device_id());
+        filter_keys_per_gpu(is_train, i, embedding_data_.get_local_gpu(i).get_global_id(),
+                            embedding_data_.get_resource_manager().get_global_gpu_count());
+      }
+    }
+
+    // (re)build the int8 copy of the table outside any captured graph; the rows touched by
+    // each iteration are refreshed in update_params()
+    if (use_quantized_read_ && !quantized_table_ready_) {
+#pragma omp parallel num_threads(embedding_data_.get_resource_manager().get_local_gpu_count())
+      {
+        size_t i = omp_get_thread_num();
+        CudaDeviceContext context(embedding_data_.get_local_gpu(i).get_device_id());
+        functors_.quantize_embedding_rows(
+            max_vocabulary_size_per_gpu_, embedding_data_.embedding_params_.embedding_vec_size,
+            hash_table_value_tensors_[i], quantized_table_tensors_[i], quantized_scale_tensors_[i],
+            embedding_data_.get_local_gpu(i).get_stream());
+      }
+      quantized_table_ready_ = true;
+    }
+
+    if (use_train_graph_ && is_train && forward_graph(is_train)) {
+      return;
+    }
+    forward_core(is_train);
+
+    return;
+  }
+
+  /**
+   * The first stage of backward propagation of embedding layer,
+   * which computes the wgrad by the dgrad from the top layer.
+   */
+  void backward() override {
+    // Read dgrad from output_tensors -> compute wgrad
+    if (use_train_graph_) {
+      backward_graph();
+      return;
+    }
+    backward_core();
 
     return;
   }
@@ -359,6 +574,15 @@ class LocalizedSlotSparseEmbeddingHash : public IEmbedding {
           wgrad_tensors_[id], hash_table_value_tensors_[id],
           embedding_data_.get_local_gpu(id).get_sm_count(),
           embedding_data_.get_local_gpu(id).get_stream());
+
+      // refresh the int8 copy of the rows this iteration updated
+      if (use_quantized_read_) {
+        functors_.quantize_embedding_rows(
+            hash_value_index_tensors_[id], *embedding_data_.get_nnz_array(true)[id],
+            embedding_data_.embedding_params_.embedding_vec_size, hash_table_value_tensors_[id],
+            quantized_table_tensors_[id], quantized_scale_tensors_[id],
+            embedding_data_.get_local_gpu(id).get_stream());
+      }
     }
   }
 
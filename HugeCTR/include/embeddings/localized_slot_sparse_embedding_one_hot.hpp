@@ -17,9 +17,12 @@
 #pragma once
 #include <omp.h>
 
+#include <memory>
+
 #include "HugeCTR/include/common.hpp"
 #include "HugeCTR/include/embeddings/embedding_data.hpp"
 #include "HugeCTR/include/embeddings/sparse_embedding_functors.hpp"
+#include "HugeCTR/include/gpu_barrier.hpp"
 #include "HugeCTR/include/utils.hpp"
 
 namespace HugeCTR {
@@ -63,6 +66,8 @@ class LocalizedSlotSparseEmbeddingOneHot : public IEmbedding {
 
   SparseEmbeddingFunctors functors_;
 
+  std::unique_ptr<GPUBarrier> gpu_barrier_; /**< device-side barrier for the fused P2P kernels */
+
   Tensors2<TypeEmbeddingComp> all2all_tensors_; /**< the temple buffer to store all2all results */
   Tensors2<TypeEmbeddingComp> utest_all2all_tensors_;
   Tensors2<TypeEmbeddingComp> utest_reorder_tensors_;
@@ -228,9 +233,17 @@ class LocalizedSlotSparseEmbeddingOneHot : public IEmbedding {
           hash_table_value_tensors_[i], get_embedding_features(is_train),
           embedding_data_.get_local_gpu(i).get_sm_count(),
           embedding_data_.get_local_gpu(i).get_stream());
+
+      // order the fused P2P stores with their consumers on the other GPUs without
+      // synchronizing the host
+      if (gpu_barrier_) {
+        gpu_barrier_->sync_all_gpus(embedding_data_.get_local_gpu(i).get_stream(), i);
+      }
     }
 
-    functors_.sync_all_gpus(embedding_data_.get_resource_manager());
+    if (!gpu_barrier_) {
+      functors_.sync_all_gpus(embedding_data_.get_resource_manager());
+    }
 
     return;
   }
@@ -240,12 +253,19 @@ class LocalizedSlotSparseEmbeddingOneHot : public IEmbedding {
    * which computes the wgrad by the dgrad from the top layer.
    */
   void backward() override {
-    functors_.sync_all_gpus(embedding_data_.get_resource_manager());
+    if (!gpu_barrier_) {
+      functors_.sync_all_gpus(embedding_data_.get_resource_manager());
+    }
 
     CudaDeviceContext context;
     for (size_t i = 0; i < embedding_data_.get_resource_manager().get_local_gpu_count(); i++) {
       context.set_device(embedding_data_.get_local_gpu(i).get_device_id());
 
+      // wait on the device until the top gradients of all GPUs have been produced
+      if (gpu_barrier_) {
+        gpu_barrier_->sync_all_gpus(embedding_data_.get_local_gpu(i).get_stream(), i);
+      }
+
       functors_.backward_fuse_per_gpu(
           i, embedding_data_.get_resource_manager().get_local_gpu_count(),
           embedding_data_.embedding_params_.get_batch_size(true),
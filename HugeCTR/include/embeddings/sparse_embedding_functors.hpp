@@ -91,6 +91,40 @@ class SparseEmbeddingFunctors {
                            const Tensor2<float> &hash_table_value,
                            Tensor2<size_t> &hash_value_index,
                            Tensor2<TypeEmbeddingComp> &embedding_feature, cudaStream_t stream);
+
+  /**
+   * forward propagation on each GPU serving the lookup from the int8 copy of the embedding
+   * table instead of the fp32 one; everything else matches forward_per_gpu().
+   * @param quantized_table int8 embedding rows
+   * @param row_scale per-row dequantization scales
+   */
+  template <typename TypeHashKey, typename TypeEmbeddingComp>
+  void forward_per_gpu_quantized(size_t batch_size, size_t slot_num, size_t embedding_vec_size,
+                                 int combiner, bool train, const Tensor2<TypeHashKey> &row_offset,
+                                 const Tensor2<TypeHashKey> &hash_key, size_t nnz,
+                                 HashTable<TypeHashKey, size_t> &hash_table,
+                                 const Tensor2<char> &quantized_table,
+                                 const Tensor2<float> &row_scale, Tensor2<size_t> &hash_value_index,
+                                 Tensor2<TypeEmbeddingComp> &embedding_feature,
+                                 cudaStream_t stream);
+
+  /**
+   * Rebuild the int8 copy and the per-row scales for the first num_rows rows of the
+   * embedding table.
+   */
+  void quantize_embedding_rows(size_t num_rows, size_t embedding_vec_size,
+                               const Tensor2<float> &hash_table_value,
+                               Tensor2<char> &quantized_table, Tensor2<float> &row_scale,
+                               cudaStream_t stream);
+
+  /**
+   * Rebuild the int8 copy and the per-row scales for the rows listed in hash_value_index;
+   * used after update_params() to refresh only the touched rows.
+   */
+  void quantize_embedding_rows(const Tensor2<size_t> &hash_value_index, size_t num_entries,
+                               size_t embedding_vec_size, const Tensor2<float> &hash_table_value,
+                               Tensor2<char> &quantized_table, Tensor2<float> &row_scale,
+                               cudaStream_t stream);
   /**
    * An additional function for the forward propagation when (combiner=mean).
    *  (only for DistributedSlotSparseEmbeddingHash)
@@ -130,6 +164,18 @@ class SparseEmbeddingFunctors {
                        Tensors2<TypeEmbeddingComp> &dst_tensors,
                        const ResourceManager &resource_manager);
 
+  /**
+   * reorder only the samples in [sample_offset, sample_offset + sample_count); used by the
+   * chunked all2all pipeline so the reorder of chunk k can overlap with the exchange of
+   * chunk k+1.
+   */
+  template <typename TypeEmbeddingComp>
+  void forward_reorder_chunk(size_t sample_offset, size_t sample_count, size_t batch_size_per_gpu,
+                             size_t slot_num, size_t embedding_vec_size,
+                             const Tensors2<TypeEmbeddingComp> &src_tensors,
+                             Tensors2<TypeEmbeddingComp> &dst_tensors,
+                             const ResourceManager &resource_manager);
+
   /**
    * forward propagation on each GPU for LocalizedSlotSparseEmbeddingOneHot.
    * Because there is no hashtable in this class, so there must be a mapping table
@@ -385,6 +431,18 @@ class SparseEmbeddingFunctors {
                        const Tensors2<Type> &send_tensors, Tensors2<Type> &recv_tensors,
                        const ResourceManager &resource_manager);
 
+  /**
+   * nccl all2all communication for forward, exchanging only the samples in
+   * [sample_offset, sample_offset + sample_count) on the given per-GPU streams. The buffer
+   * layout matches all2all_forward, so successive chunks fill disjoint slices in place.
+   */
+  template <typename Type>
+  void all2all_forward_chunk(size_t sample_offset, size_t sample_count, size_t batch_size_per_gpu,
+                             size_t slot_num, size_t embedding_vec_size,
+                             const Tensors2<Type> &send_tensors, Tensors2<Type> &recv_tensors,
+                             const ResourceManager &resource_manager,
+                             const std::vector<cudaStream_t> &comm_streams);
+
   /**
    * nccl all2all communication for backward
    * @param batch_size_per_gpu batch size per GPU
@@ -414,6 +472,19 @@ class SparseEmbeddingFunctors {
                        size_t embedding_vec_size, const Tensors2<Type> &send_tensors,
                        Tensors2<Type> &recv_tensors, const ResourceManager &resource_manager);
 
+  /**
+   * nccl all2all communication for forward, exchanging only the samples in
+   * [sample_offset, sample_offset + sample_count) on the given per-GPU streams. The buffer
+   * layout matches all2all_forward, so successive chunks fill disjoint slices in place.
+   * CAUSION: Only support intra-node all2all currently
+   */
+  template <typename Type>
+  void all2all_forward_chunk(size_t sample_offset, size_t sample_count, size_t batch_size_per_gpu,
+                             const std::vector<size_t> &slot_num_per_gpu,
+                             size_t embedding_vec_size, const Tensors2<Type> &send_tensors,
+                             Tensors2<Type> &recv_tensors, const ResourceManager &resource_manager,
+                             const std::vector<cudaStream_t> &comm_streams);
+
   /**
    * nccl all2all communication for backward
    * CAUSION: Only support intra-node all2all currently
@@ -488,6 +559,36 @@ class SparseEmbeddingFunctors {
       Tensor2<TypeHashKey> &hash_table_key, Tensor2<float> &hash_table_value,
       const ResourceManager &resource_manager);
 
+  /**
+   * Mark the rows addressed by hash_value_index in the touched-rows bitmap. Called after
+   * update_params() so that the rows the optimizer modified can later be collected with
+   * get_touched_update_params_results().
+   * @param nnz non-zero feature number in one batch
+   * @param hash_value_index the row indices the optimizer has just updated
+   * @param touched_rows bitmap with one bit per hash table row
+   * @param stream cuda stream corresponding to the current GPU.
+   */
+  void mark_touched_rows(size_t nnz, const Tensor2<size_t> &hash_value_index,
+                         Tensor2<uint32_t> &touched_rows, cudaStream_t stream);
+
+  /**
+   * Collect the <key, value> pairs whose rows are marked in the touched-rows bitmaps, append
+   * them to the host vectors, and clear the bitmaps. Used for incremental model publication.
+   * @param embedding_vec_size embedding vector size.
+   * @param hash_table_value_tensors the tensors of hash table value on multi GPUs
+   * @param hash_tables the hash tables on multi GPUs
+   * @param touched_rows_tensors the touched-rows bitmaps on multi GPUs
+   * @param h_keys host vector receiving the keys of the touched rows
+   * @param h_vectors host vector receiving the embedding vectors of the touched rows
+   * @param resource_manager all gpus device resources.
+   */
+  template <typename TypeHashKey>
+  void get_touched_update_params_results(
+      size_t embedding_vec_size, const Tensors2<float> &hash_table_value_tensors,
+      const std::vector<std::shared_ptr<HashTable<TypeHashKey, size_t>>> &hash_tables,
+      Tensors2<uint32_t> &touched_rows_tensors, std::vector<TypeHashKey> &h_keys,
+      std::vector<float> &h_vectors, const ResourceManager &resource_manager);
+
   /**
    * set liner data for a buffer
    * @param stream cuda stream.
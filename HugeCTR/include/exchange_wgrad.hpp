@@ -56,6 +56,12 @@ class NetworkExchangeWgrad : public ExchangeWgrad {
   size_t num_gpus_ = 0;
 };
 
+/**
+ * Grouped wgrad exchange: the network and the embedding draw their wgrad tensors from two
+ * BufferBlock2 sub-blocks of one contiguous GeneralBuffer2 per GPU, so the gradients are
+ * produced directly in the exchange layout and a single all-reduce covers both without any
+ * per-iteration gather copy.
+ */
 template <typename TypeFP>
 class GroupedExchangeWgrad : public ExchangeWgrad {
  public:
@@ -75,6 +81,15 @@ class GroupedExchangeWgrad : public ExchangeWgrad {
 
   AllReduceInPlaceComm::Handle ar_handle_;
 
+  // Optional FP16 transport compression with error feedback (HCTR_WGRAD_COMPRESS_FP16). The
+  // wgrads stay FP32 in memory; only the all-reduce payload is compressed, and the rounding
+  // error is carried over into the next iteration through the residual buffers.
+  bool compress_fp16_ = false;
+  std::vector<std::shared_ptr<GeneralBuffer2<CudaAllocator>>> compress_bufs_;
+  std::vector<Tensor2<__half>> compress_tensors_;
+  std::vector<Tensor2<float>> residual_tensors_;
+  size_t ar_size_bytes_ = 0;
+
   size_t network_wgrad_size_ = 0;
   size_t embed_wgrad_size_ = 0;
   size_t num_gpus_ = 0;
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cublasLt.h>
+
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace HugeCTR {
+
+/**
+ * @brief Process-wide cache of tuned cublasLt GEMM algorithms.
+ *
+ * Algorithm search measures every heuristic candidate and can take seconds per layer, and
+ * the heuristic default selected without a search varies from run to run. The cache stores
+ * the winning cublasLtMatmulAlgo_t keyed by GEMM shape, datatype, GPU architecture and
+ * epilogue so the measurement only has to happen once. When a cache file is attached via
+ * set_file(), entries are loaded from disk at attach time and written back by flush(); an
+ * entry tuned on one node is valid on any node with the same GPU architecture and cublasLt
+ * version, so the file can be shared across a homogeneous cluster.
+ */
+class GemmAlgoCache {
+ public:
+  enum class GemmOp : int { Fprop = 0, DGrad = 1, WGrad = 2 };
+
+  struct Key {
+    int64_t m;
+    int64_t n;
+    int64_t k;
+    int data_type;  // cudaDataType_t of the operands
+    int arch;       // compute capability, e.g. 80 for sm_80
+    int op;         // GemmOp, distinguishes GEMMs that share a shape and epilogue
+    int epilogue;   // cublasLtEpilogue_t baked into the matmul descriptor
+
+    bool operator<(const Key& rhs) const;
+  };
+
+  static GemmAlgoCache& get();
+
+  GemmAlgoCache(const GemmAlgoCache&) = delete;
+  GemmAlgoCache& operator=(const GemmAlgoCache&) = delete;
+
+  /**
+   * Attach a cache file and load whatever entries it already holds. Entries recorded with a
+   * different cublasLt version are discarded because algorithm descriptors are not portable
+   * across library versions.
+   */
+  void set_file(const std::string& path);
+
+  /** @return true and fill `algo` if the key was tuned before, either this run or on disk. */
+  bool find(const Key& key, cublasLtMatmulAlgo_t* algo);
+
+  /** Record the winning algorithm for a key. Entries are held in memory until flush(). */
+  void update(const Key& key, const cublasLtMatmulAlgo_t& algo);
+
+  /** Write all entries back to the attached file. A no-op when no file is attached. */
+  void flush();
+
+ private:
+  GemmAlgoCache() = default;
+
+  std::mutex mutex_;
+  std::string path_;
+  std::map<Key, cublasLtMatmulAlgo_t> entries_;
+  bool dirty_{false};
+};
+
+}  // namespace HugeCTR
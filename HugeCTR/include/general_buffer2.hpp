@@ -17,8 +17,13 @@
 #pragma once
 #include <cuda_runtime_api.h>
 
+#include <cstdlib>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <numeric>
+#include <set>
+#include <vector>
 
 #include "HugeCTR/include/tensor2.hpp"
 
@@ -54,10 +59,54 @@ class CudaAllocator {
  public:
   void *allocate(size_t size) const {
     void *ptr;
+#if CUDART_VERSION >= 11020
+    // Opt-in stream-ordered allocation (HCTR_MALLOC_ASYNC_POOL): freed blocks stay in the
+    // per-device pool instead of going back to the driver, so tearing down and rebuilding a
+    // model in the same process reuses the memory instead of paying for cudaMalloc again.
+    if (use_malloc_async()) {
+      int device;
+      HCTR_LIB_THROW(cudaGetDevice(&device));
+      retain_pool_memory(device);
+      HCTR_LIB_THROW(cudaMallocAsync(&ptr, size, 0));
+      HCTR_LIB_THROW(cudaStreamSynchronize(0));
+      return ptr;
+    }
+#endif
     HCTR_LIB_THROW(cudaMalloc(&ptr, size));
     return ptr;
   }
-  void deallocate(void *ptr) const { HCTR_LIB_THROW(cudaFree(ptr)); }
+  void deallocate(void *ptr) const {
+#if CUDART_VERSION >= 11020
+    if (use_malloc_async()) {
+      HCTR_LIB_THROW(cudaFreeAsync(ptr, 0));
+      HCTR_LIB_THROW(cudaStreamSynchronize(0));
+      return;
+    }
+#endif
+    HCTR_LIB_THROW(cudaFree(ptr));
+  }
+
+#if CUDART_VERSION >= 11020
+ private:
+  static bool use_malloc_async() {
+    static const bool value = std::getenv("HCTR_MALLOC_ASYNC_POOL") != nullptr;
+    return value;
+  }
+
+  // Raises the release threshold of the device's default pool once, so the pool keeps its
+  // memory across buffer teardown instead of trimming back to the driver.
+  static void retain_pool_memory(int device) {
+    static std::mutex mutex;
+    static std::set<int> configured_devices;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (configured_devices.insert(device).second) {
+      cudaMemPool_t pool;
+      HCTR_LIB_THROW(cudaDeviceGetDefaultMemPool(&pool, device));
+      uint64_t threshold = UINT64_MAX;
+      HCTR_LIB_THROW(cudaMemPoolSetAttribute(pool, cudaMemPoolAttrReleaseThreshold, &threshold));
+    }
+  }
+#endif
 };
 
 template <typename T>
@@ -66,6 +115,11 @@ class BufferBlock2 {
   virtual ~BufferBlock2() {}
   virtual void reserve(const std::vector<size_t> &dimensions, Tensor2<T> *tensor) = 0;
   virtual Tensor2<T> &as_tensor() = 0;
+  /**
+   * Number of elements reserved so far. Unlike as_tensor(), this does not finalize the block,
+   * so it can be used to take watermarks while tensors are still being reserved.
+   */
+  virtual size_t get_num_elements() const = 0;
 };
 
 template <typename Allocator>
@@ -131,6 +185,8 @@ class GeneralBuffer2 : public std::enable_shared_from_this<GeneralBuffer2<Alloca
       return tensor_;
     };
 
+    size_t get_num_elements() const override { return total_num_elements_; }
+
     size_t get_size_in_bytes() const {
       return total_num_elements_ * TensorScalarSizeFunc<T>::get_element_size();
     }
@@ -157,9 +213,11 @@ class GeneralBuffer2 : public std::enable_shared_from_this<GeneralBuffer2<Alloca
   void *ptr_;
   size_t total_size_in_bytes_;
   std::vector<std::shared_ptr<BufferInternal>> reserved_buffers_;
+  std::map<TensorBuffer2 *, size_t> overlapped_offsets_;
+  size_t overlapped_arena_size_;
 
   GeneralBuffer2(Allocator allocator)
-      : allocator_(allocator), ptr_(nullptr), total_size_in_bytes_(0) {}
+      : allocator_(allocator), ptr_(nullptr), total_size_in_bytes_(0), overlapped_arena_size_(0) {}
 
  public:
   static std::shared_ptr<GeneralBuffer2> create(Allocator allocator = Allocator()) {
@@ -177,22 +235,56 @@ class GeneralBuffer2 : public std::enable_shared_from_this<GeneralBuffer2<Alloca
 
   void allocate() { allocate_aligned(32); }
 
+  /**
+   * Place the given tensor buffers at explicit offsets inside a shared arena appended after
+   * the sequentially packed region, so tensors with disjoint lifetimes can share memory.
+   * Offsets are relative to the arena base; buffers not reserved on this GeneralBuffer2 are
+   * ignored. Must be called before allocate().
+   */
+  void set_overlapped_offsets(const std::map<TensorBuffer2 *, size_t> &offsets,
+                              size_t arena_size) {
+    if (allocated()) {
+      HCTR_OWN_THROW(Error_t::IllegalCall, "General buffer is finalized.");
+    }
+    overlapped_offsets_ = offsets;
+    overlapped_arena_size_ = arena_size;
+  }
+
   void allocate_aligned(size_t align_size) {
     if (ptr_ != nullptr) {
       HCTR_OWN_THROW(Error_t::WrongInput, "Memory has already been allocated.");
     }
 
     size_t offset = 0;
-    for (const std::shared_ptr<BufferInternal> &buffer : reserved_buffers_) {
-      buffer->initialize(this->shared_from_this(), offset);
+    std::vector<size_t> buffer_offsets(reserved_buffers_.size());
+    std::vector<bool> in_arena(reserved_buffers_.size(), false);
+    for (size_t i = 0; i < reserved_buffers_.size(); i++) {
+      const std::shared_ptr<BufferInternal> &buffer = reserved_buffers_[i];
+      if (!overlapped_offsets_.empty()) {
+        TensorBuffer2 *tensor_buffer = dynamic_cast<TensorBuffer2 *>(buffer.get());
+        auto it = tensor_buffer != nullptr ? overlapped_offsets_.find(tensor_buffer)
+                                           : overlapped_offsets_.end();
+        if (it != overlapped_offsets_.end()) {
+          buffer_offsets[i] = it->second;
+          in_arena[i] = true;
+          continue;
+        }
+      }
+      buffer_offsets[i] = offset;
       size_t size_in_bytes = buffer->get_size_in_bytes();
       if (size_in_bytes % align_size != 0) {
         size_in_bytes += (align_size - size_in_bytes % align_size);
       }
       offset += size_in_bytes;
     }
+    const size_t arena_base = offset;
+    for (size_t i = 0; i < reserved_buffers_.size(); i++) {
+      reserved_buffers_[i]->initialize(
+          this->shared_from_this(),
+          in_arena[i] ? arena_base + buffer_offsets[i] : buffer_offsets[i]);
+    }
     reserved_buffers_.clear();
-    total_size_in_bytes_ = offset;
+    total_size_in_bytes_ = arena_base + overlapped_arena_size_;
 
     if (total_size_in_bytes_ != 0) {
       ptr_ = allocator_.allocate(total_size_in_bytes_);
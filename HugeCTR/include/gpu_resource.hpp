@@ -21,6 +21,8 @@
 #include <curand.h>
 #include <nccl.h>
 
+#include <vector>
+
 #include "stream_event_manager.hpp"
 #include "utils.hpp"
 
@@ -45,7 +47,16 @@ class GPUResource {
   cudnnHandle_t cudnn_handle_;
   cublasLtHandle_t cublaslt_handle_;
   ncclComm_t comm_;
+  ncclComm_t island_comm_; /**< communicator over the NVLink-connected local peers, may be null */
+  bool own_comms_;         /**< false when the communicators live in a process-wide cache */
+  /**< side communicators for independent embedding table groups, so their collectives are not
+   * serialized inside one NCCL communicator; always owned, see create_embedding_comm_groups */
+  std::vector<ncclComm_t> group_comms_;
   size_t sm_count_;
+  /**< advisory SM budget for background work (metrics, cache refresh, index precompute);
+   * launchers clamp their grids to it so the critical path keeps the remaining SMs */
+  size_t background_sm_count_;
+  cudaStream_t background_stream_; /**< lowest-priority stream for background kernels */
   int cc_major_;
   int cc_minor_;
   cudaStream_t computation_stream_2_;
@@ -57,13 +68,15 @@ class GPUResource {
  public:
   GPUResource(int device_id, size_t local_id, size_t global_id,
               unsigned long long replica_uniform_seed, unsigned int long long replica_variant_seed,
-              const ncclComm_t& comm);
+              const ncclComm_t& comm, ncclComm_t island_comm = nullptr, bool own_comms = true);
   GPUResource(const GPUResource&) = delete;
   GPUResource& operator=(const GPUResource&) = delete;
   ~GPUResource();
 
   const cudaStream_t& get_stream(const std::string& name, int priority = 0);
   const cudaEvent_t& get_event(const std::string& name);
+  size_t get_event_handle(const std::string& name);
+  const cudaEvent_t& get_event(size_t handle) const;
 
   int get_device_id() const { return device_id_; }
   int get_local_id() const { return local_id_; }
@@ -92,7 +105,30 @@ class GPUResource {
   const cublasLtHandle_t& get_cublaslt_handle() const { return cublaslt_handle_; }
   const cudnnHandle_t& get_cudnn_handle() const { return cudnn_handle_; }
   const ncclComm_t& get_nccl() const { return comm_; }
+  const ncclComm_t& get_island_nccl() const { return island_comm_; }
+  bool has_island_nccl() const { return island_comm_ != nullptr; }
+  void set_group_comms(const std::vector<ncclComm_t>& group_comms) { group_comms_ = group_comms; }
+  /**
+   * Communicator for an embedding table group. Groups beyond the created count wrap around, and
+   * without any group communicators every group falls back to the shared one.
+   */
+  const ncclComm_t& get_group_nccl(size_t group_id) const {
+    return group_comms_.empty() ? comm_ : group_comms_[group_id % group_comms_.size()];
+  }
+  size_t get_group_comm_count() const { return group_comms_.size(); }
   size_t get_sm_count() const { return sm_count_; }
+  /**
+   * Stream for background tasks. It is created with the device's lowest priority so resident
+   * critical-path blocks are scheduled first whenever both compete for an SM.
+   */
+  const cudaStream_t& get_background_stream() const { return background_stream_; }
+  /**
+   * Advisory SM budget for kernels launched on the background stream. Launchers should clamp
+   * their grid to background_sm_count * blocks_per_sm so background work occupies a bounded SM
+   * subset instead of spreading across the whole device. Tune with HCTR_BACKGROUND_SM_PERCENT
+   * (default 25).
+   */
+  size_t get_background_sm_count() const { return background_sm_count_; }
   int get_cc_major() const { return cc_major_; }
   int get_cc_minor() const { return cc_minor_; }
   bool support_nccl() const { return comm_ != nullptr; }
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2021, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/pair.h>
+
+#include <limits>
+
+#include "HugeCTR/include/common.hpp"
+// also provides the atomicCAS overloads for 64-bit keys, the hashers and the allocator
+#include "HugeCTR/include/hashtable/cudf/concurrent_unordered_map.cuh"
+
+template <typename value_type, typename size_type, typename key_type, typename elem_type>
+__global__ void init_bucketed_hashtbl(value_type* slots, size_type num_slots, key_type unused_key,
+                                      elem_type unused_element) {
+  const size_type i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i < num_slots) {
+    slots[i].first = unused_key;
+    slots[i].second = unused_element;
+  }
+}
+
+// re-mix of the primary hash, used to derive the second candidate bucket
+__forceinline__ __host__ __device__ size_t bucketed_hash_remix(size_t h) {
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdull;
+  h ^= h >> 33;
+  return h;
+}
+
+/**
+ * A bucketed open-addressing hash map for the embedding hash tables. Keys probe whole
+ * buckets of BUCKET_SIZE slots instead of single slots: the primary bucket first, then a
+ * second, independently derived candidate bucket, then consecutive buckets as a last
+ * resort. A key always claims the first free slot of the earliest non-full bucket on this
+ * path and slots are never freed, so the probe path of a key is deterministic and the
+ * concurrent insert protocol of concurrent_unordered_map (atomicCAS on the key, spin on
+ * the pending value) carries over unchanged. Bucket-granular probing keeps the number of
+ * probed cache lines small even near full occupancy, which lets the table be sized at a
+ * load factor above 0.9 instead of the 0.75 used for the linear-probing map. The
+ * device-side interface mirrors the subset of concurrent_unordered_map used by HashTable,
+ * so the same host-side kernels drive both containers.
+ */
+template <typename Key, typename Element, Key unused_key, typename Hasher = default_hash<Key>,
+          typename Equality = equal_to<Key>,
+          typename Allocator = managed_allocator<thrust::pair<Key, Element>>>
+class bucketed_hash_map : public managed {
+ public:
+  using size_type = size_t;
+  using hasher = Hasher;
+  using key_equal = Equality;
+  using allocator_type = Allocator;
+  using key_type = Key;
+  using value_type = thrust::pair<Key, Element>;
+  using mapped_type = Element;
+  using iterator = value_type*;
+  using const_iterator = const value_type*;
+
+  static constexpr size_type BUCKET_SIZE = 16;
+
+  bucketed_hash_map(const bucketed_hash_map&) = delete;
+  bucketed_hash_map& operator=(const bucketed_hash_map&) = delete;
+
+  explicit bucketed_hash_map(size_type n, const mapped_type unused_element,
+                             const Hasher& hf = hasher(), const Equality& eql = key_equal(),
+                             const allocator_type& a = allocator_type())
+      : m_hf(hf), m_equal(eql), m_allocator(a), m_unused_element(unused_element) {
+    m_num_buckets = (n + BUCKET_SIZE - 1) / BUCKET_SIZE;
+    if (m_num_buckets < 2) {
+      m_num_buckets = 2;
+    }
+    m_num_slots = m_num_buckets * BUCKET_SIZE;
+    m_slots = m_allocator.allocate(m_num_slots);
+    constexpr int block_size = 128;
+    init_bucketed_hashtbl<<<((m_num_slots - 1) / block_size) + 1, block_size>>>(
+        m_slots, m_num_slots, unused_key, m_unused_element);
+    HCTR_LIB_THROW(cudaStreamSynchronize(0));
+    HCTR_LIB_THROW(cudaGetLastError());
+  }
+
+  ~bucketed_hash_map() { m_allocator.deallocate(m_slots, m_num_slots); }
+
+  __host__ __device__ value_type* data() const { return m_slots; }
+
+  __host__ __device__ size_type size() const { return m_num_slots; }
+
+  __host__ __device__ iterator end() const { return m_slots + m_num_slots; }
+
+  /**
+   * Find the slot of key k, or claim a free slot on its probe path and assign the next
+   * index from value_counter to it. Same semantics and insert protocol as
+   * concurrent_unordered_map::get_insert().
+   */
+  template <typename aggregation_type, typename counter_type>
+  __forceinline__ __device__ iterator get_insert(const key_type& k, aggregation_type op,
+                                                 counter_type* value_counter) {
+    bool claimed = false;
+    value_type* slot = probe_insert(k, &claimed);
+    if (slot == end()) {
+      return slot;
+    }
+    volatile mapped_type& existing_value = slot->second;
+    if (claimed) {
+      // this thread claimed the slot: publish the value index
+      existing_value = static_cast<mapped_type>(atomicAdd(value_counter, 1));
+    } else {
+      while (existing_value == m_unused_element) {
+        // another thread is inserting this key and its value is not yet ready, just wait
+      }
+    }
+    return slot;
+  }
+
+  /**
+   * Insert pair x, overwriting the value when the key already exists (the only
+   * aggregation used by HashTable is ReplaceOp).
+   */
+  template <typename aggregation_type>
+  __forceinline__ __device__ iterator insert(const value_type& x, aggregation_type op) {
+    bool claimed = false;
+    value_type* slot = probe_insert(x.first, &claimed);
+    if (slot == end()) {
+      return slot;
+    }
+    slot->second = x.second;
+    return slot;
+  }
+
+  __forceinline__ __host__ __device__ const_iterator find(const key_type& k) const {
+    const size_type num_buckets = m_num_buckets;
+    size_type primary = m_hf(k) % num_buckets;
+    size_type secondary = bucketed_hash_remix(primary) % num_buckets;
+
+    for (size_type probe = 0; probe < num_buckets; probe++) {
+      size_type bucket =
+          (probe == 0) ? primary
+                       : ((probe == 1) ? secondary : (primary + probe - 1) % num_buckets);
+      value_type* slots = m_slots + bucket * BUCKET_SIZE;
+      for (size_type j = 0; j < BUCKET_SIZE; j++) {
+        const key_type existing_key = slots[j].first;
+        if (m_equal(k, existing_key)) {
+          return slots + j;
+        }
+        if (m_equal(unused_key, existing_key)) {
+          // slots are never freed, so a free slot on the probe path means k was never
+          // inserted
+          return end();
+        }
+      }
+    }
+    return end();
+  }
+
+  void clear_async(cudaStream_t stream = 0) {
+    constexpr int block_size = 128;
+    init_bucketed_hashtbl<<<((m_num_slots - 1) / block_size) + 1, block_size, 0, stream>>>(
+        m_slots, m_num_slots, unused_key, m_unused_element);
+  }
+
+ private:
+  /**
+   * Walk the probe path of key k and return its slot: either the slot already holding k
+   * or a formerly free slot claimed for it with atomicCAS. *claimed tells the caller
+   * whether this thread won the claim and has to publish the value.
+   */
+  __forceinline__ __device__ value_type* probe_insert(const key_type& k, bool* claimed) {
+    const size_type num_buckets = m_num_buckets;
+    size_type primary = m_hf(k) % num_buckets;
+    size_type secondary = bucketed_hash_remix(primary) % num_buckets;
+
+    for (size_type probe = 0; probe < num_buckets; probe++) {
+      size_type bucket =
+          (probe == 0) ? primary
+                       : ((probe == 1) ? secondary : (primary + probe - 1) % num_buckets);
+      value_type* slots = m_slots + bucket * BUCKET_SIZE;
+      for (size_type j = 0; j < BUCKET_SIZE; j++) {
+        key_type& existing_key = slots[j].first;
+        const key_type old_key = atomicCAS(&existing_key, unused_key, k);
+        if (m_equal(unused_key, old_key)) {
+          // the slot was free and this thread claimed it
+          *claimed = true;
+          return slots + j;
+        }
+        if (m_equal(k, old_key)) {
+          // the key is already present (possibly still being inserted by another thread)
+          return slots + j;
+        }
+        // the slot belongs to another key, try the next one in the bucket
+      }
+    }
+    return end();
+  }
+
+  Hasher m_hf;
+  Equality m_equal;
+  Allocator m_allocator;
+  const mapped_type m_unused_element;
+  size_type m_num_buckets;
+  size_type m_num_slots;
+  value_type* m_slots;
+};
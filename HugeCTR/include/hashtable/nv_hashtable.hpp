@@ -24,6 +24,9 @@ namespace HugeCTR {
 template <typename KeyType, typename ValType>
 class HashTableContainer;
 
+template <typename KeyType, typename ValType>
+class BucketedHashTableContainer;
+
 /**
  * The HashTable class is wrapped by cudf library for hash table operations on single GPU.
  * In this class, we implement the GPU version of the common used operations of hash table,
@@ -173,17 +176,64 @@ class HashTable {
    */
   void clear(cudaStream_t stream);
 
+  /**
+   * Bytes of the raw slot array of the active container. The raw snapshot API
+   * (download_raw_table/upload_raw_table) moves the slot array as-is, so a table restored this
+   * way must have been created with the same capacity and container type (see
+   * HCTR_BUCKETED_HASHTABLE) as the table that was dumped.
+   */
+  size_t get_raw_table_bytes() const;
+
+  /**
+   * Copy [offset, offset + num_bytes) of the raw slot array to host memory (device-native
+   * snapshot). The byte range lets callers stream a large table through a bounded pinned
+   * buffer. Asynchronous on the given stream; h_dst should be pinned memory.
+   */
+  void download_raw_table(void* h_dst, size_t offset, size_t num_bytes, cudaStream_t stream) const;
+
+  /**
+   * Restore [offset, offset + num_bytes) of the raw slot array from a device-native snapshot,
+   * skipping per-key re-insertion. The caller must also restore the value counter via
+   * set_value_head().
+   */
+  void upload_raw_table(const void* h_src, size_t offset, size_t num_bytes, cudaStream_t stream);
+
  private:
   static const int BLOCK_SIZE_ =
       256; /**< The block size of the CUDA kernels. The default value is 256. */
 
   const float LOAD_FACTOR = 0.75f;
 
+  const float BUCKETED_LOAD_FACTOR = 0.93f; /**< The load factor of the bucketed container,
+                                                 whose bucket probes stay bounded near full
+                                                 occupancy. */
+
   const size_t capacity_;
 
   HashTableContainer<KeyType, ValType>* container_; /**< The object of the Table class which is
        defined in the concurrent_unordered_map class. */
 
+  BucketedHashTableContainer<KeyType, ValType>* bucketed_container_; /**< The bucketed probing
+       container used instead of container_ when HCTR_BUCKETED_HASHTABLE is set. */
+
+  bool warp_dedup_{false}; /**< get_insert deduplicates same-key lanes within a warp before
+                                touching the table (HCTR_HASHTABLE_WARP_DEDUP), so a hot key
+                                repeated across a warp issues one CAS instead of 32. */
+
+  size_t lookup_cache_slots_{0}; /**< get_insert probes a small direct-mapped <key, value> cache
+                                      first when HCTR_LOOKUP_CACHE_SLOTS is set, so the repeat
+                                      keys of consecutive online-training batches skip the table
+                                      walk. Coherent by construction because get_insert never
+                                      remaps a key; the bulk mutation APIs flush it. */
+  KeyType* d_cache_keys_{nullptr};
+  ValType* d_cache_vals_{nullptr};
+
+  /**
+   * Drop every pair of the get_insert lookup cache; called by the operations that mutate the
+   * table content directly (insert/set/clear/upload_raw_table).
+   */
+  void flush_lookup_cache(cudaStream_t stream);
+
   // Counter for value index
   size_t* d_counter_; /**< The device counter for value index. */
   size_t* d_container_size_;
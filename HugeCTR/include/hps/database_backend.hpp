@@ -294,11 +294,32 @@ class VolatileBackend : public DatabaseBackend<TKey> {
    */
   void synchronize();
 
+  /**
+   * Format of pluggable eviction-victim selectors. Given the name of the overflowing
+   * table/partition, the candidate keys together with their last access times and the number of
+   * entries that should be evicted, implementations append the selected keys to \p victims (most
+   * expendable first).
+   */
+  using OverflowVictimSelector =
+      std::function<void(const std::string& table_name,
+                         const std::vector<std::pair<TKey, time_t>>& candidates, size_t num_victims,
+                         std::vector<TKey>& victims)>;
+
+  /**
+   * Install a custom eviction-victim selector. When set, overflow handling consults it instead of
+   * the built-in \p DatabaseOverflowPolicy_t policies. Pass an empty function to revert to the
+   * configured built-in policy.
+   */
+  void set_overflow_victim_selector(OverflowVictimSelector selector) {
+    overflow_victim_selector_ = std::move(selector);
+  }
+
  protected:
   // Overflow-handling / pruning related parameters.
   const size_t overflow_margin_;
   const DatabaseOverflowPolicy_t overflow_policy_;
   const size_t overflow_resolution_target_;
+  OverflowVictimSelector overflow_victim_selector_;
 
   // Worker used for asynchronours insertion, and other tasks that subclasses might want to apply
   // asynchronously.
@@ -59,6 +59,8 @@ class DirectMapBackend final : public VolatileBackend<TKey> {
                    DatabaseOverflowPolicy_t overflow_policy = DatabaseOverflowPolicy_t::EvictOldest,
                    double overflow_resolution_target = 0.8);
 
+  ~DirectMapBackend() override;
+
   bool is_shared() const override final { return false; }
 
   const char* get_name() const override { return "DirectMapBackend"; }
@@ -93,8 +95,16 @@ class DirectMapBackend final : public VolatileBackend<TKey> {
   void dump_sst(const std::string& table_name, rocksdb::SstFileWriter& file) override;
 
  protected:
+  /**
+   * Copy the borrowed value array into a hugepage-backed anonymous mapping owned by this
+   * backend and install the requested NUMA placement policy. Returns the new base pointer.
+   */
+  const char* rehost_values(const char* values, size_t nbytes);
+
   size_t val_len_nbytes;
   const char* val_ptr;
+  char* owned_vals_ = nullptr; /**< set when the values were rehosted onto hugepages */
+  size_t owned_vals_nbytes_ = 0;
   size_t num_keys_;
   std::string single_table_name;
   std::atomic_bool inited_{false};
@@ -17,12 +17,17 @@
 #pragma once
 #include <cuda_runtime_api.h>
 
+#include <atomic>
 #include <hps/embedding_cache_base.hpp>
 #include <hps/inference_utils.hpp>
 #include <hps/unique_op/unique_op.hpp>
 #include <memory>
 #include <nv_gpu_cache.hpp>
+#include <shared_mutex>
+#include <thread>
 #include <thread_pool.hpp>
+#include <unordered_map>
+#include <utility>
 
 namespace HugeCTR {
 
@@ -49,6 +54,12 @@ class EmbeddingCache : public EmbeddingCacheBase,
                        cudaStream_t stream);
   virtual void finalize();
 
+  virtual std::pair<size_t, size_t> get_and_reset_lookup_stats();
+  virtual double get_recent_lookup_latency_us() {
+    return static_cast<double>(lookup_latency_ewma_us_.load(std::memory_order_relaxed));
+  }
+  virtual void resize(float cache_size_percentage);
+
   virtual EmbeddingCacheWorkspace create_workspace();
   virtual void destroy_workspace(EmbeddingCacheWorkspace&);
   virtual EmbeddingCacheRefreshspace create_refreshspace();
@@ -63,8 +74,12 @@ class EmbeddingCache : public EmbeddingCacheBase,
  private:
   static const size_t BLOCK_SIZE_ = 64;
 
-  using Cache = gpu_cache::gpu_cache<TypeHashKey, uint64_t, std::numeric_limits<TypeHashKey>::max(),
-                                     SET_ASSOCIATIVITY, SLAB_SIZE>;
+  // Keys must be seen at least this often within a sliding window to qualify for prefetch.
+  static const uint32_t PREFETCH_HOT_THRESHOLD_ = 2;
+
+  // Set associativity is chosen per table at runtime, so the caches are held through the
+  // type-erased API and constructed with gpu_cache::create_gpu_cache.
+  using Cache = gpu_cache::gpu_cache_api<TypeHashKey>;
   using UniqueOp =
       unique_op::unique_op<TypeHashKey, uint64_t, std::numeric_limits<TypeHashKey>::max(),
                            std::numeric_limits<uint64_t>::max()>;
@@ -78,6 +93,10 @@ class EmbeddingCache : public EmbeddingCacheBase,
   // The shared thread-safe embedding cache
   std::vector<std::unique_ptr<Cache>> gpu_emb_caches_;
 
+  // Optional second GPU-memory cache tier that absorbs misses of gpu_emb_caches_, 1 per embedding
+  // table. Kept inclusive: whatever is inserted into the first tier is inserted here as well.
+  std::vector<std::unique_ptr<Cache>> gpu_l2_emb_caches_;
+
   // streams for asynchronous parameter server insert threads
   std::vector<cudaStream_t> insert_streams_;
 
@@ -92,6 +111,46 @@ class EmbeddingCache : public EmbeddingCacheBase,
 
   // mutex for insert_streams_
   std::mutex stream_mutex_;
+
+  // Cumulative lookup statistics consumed by the capacity arbitration in HierParameterServer
+  std::atomic<size_t> num_unique_queries_{0};
+  std::atomic<size_t> num_lookup_misses_{0};
+
+  // EWMA of lookup wall-clock latency in microseconds, steering the QoS-aware refresh pacing
+  std::atomic<uint64_t> lookup_latency_ewma_us_{0};
+
+  // Cached series from the process-wide PerfCounters registry (resolved once in the constructor,
+  // labelled with this cache's model, device and table, one entry per embedding table) so
+  // lookup() only pays an atomic add.
+  std::vector<std::atomic<uint64_t>*> perf_queries_;
+  std::vector<std::atomic<uint64_t>*> perf_misses_;
+  std::vector<std::atomic<uint64_t>*> perf_l2_queries_;
+  std::vector<std::atomic<uint64_t>*> perf_l2_misses_;
+
+  // Per-table eviction counters of the GPU cache tiers. The device-side counters are read back
+  // asynchronously into h_evict_counts_ (pinned, L1 slots first, then L2) behind each Replace,
+  // and published as deltas against the last value seen.
+  std::vector<std::atomic<uint64_t>*> perf_evictions_;
+  std::vector<std::atomic<uint64_t>*> perf_l2_evictions_;
+  size_t* h_evict_counts_{nullptr};
+  std::vector<size_t> last_evict_counts_;
+
+  // Guards gpu_emb_caches_ against a concurrent resize(); all cache users take the shared side
+  std::shared_mutex cache_resize_mutex_;
+
+  // Background query-history-driven prefetch.
+  void record_query_history_(size_t table_id, const void* h_keys, size_t num_keys);
+  void prefetcher_loop_();
+
+  // Sliding-window key frequency sketches, 1 per embedding table
+  std::vector<std::unordered_map<TypeHashKey, uint32_t>> query_history_;
+
+  // mutex for query_history_
+  std::mutex history_mutex_;
+
+  // background prefetch worker
+  std::thread prefetch_worker_;
+  std::atomic<bool> prefetch_terminate_{false};
 };
 
 }  // namespace HugeCTR
\ No newline at end of file
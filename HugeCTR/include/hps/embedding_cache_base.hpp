@@ -18,6 +18,7 @@
 #include <cuda_runtime_api.h>
 
 #include <hps/inference_utils.hpp>
+#include <utility>
 
 namespace HugeCTR {
 
@@ -50,6 +51,23 @@ class EmbeddingCacheBase {
   virtual EmbeddingCacheRefreshspace create_refreshspace() = 0;
   virtual void destroy_refreshspace(EmbeddingCacheRefreshspace&) = 0;
 
+  /**
+   * Measured lookup traffic since the last call: <number of unique queried keys, number of
+   * cache misses among them>. Caches that do not track statistics return zeros.
+   */
+  virtual std::pair<size_t, size_t> get_and_reset_lookup_stats() { return {0, 0}; }
+  /**
+   * Exponentially weighted moving average of recent lookup latencies in microseconds; the
+   * refresh scheduler uses it to yield to serving traffic. Caches that do not track
+   * statistics return 0.
+   */
+  virtual double get_recent_lookup_latency_us() { return 0.0; }
+  /**
+   * Rebuild the per-table GPU caches for a new share of the embedding tables and carry the
+   * current contents over. A no-op for caches that do not support online resizing.
+   */
+  virtual void resize(float cache_size_percentage) {}
+
   virtual const embedding_cache_config& get_cache_config() = 0;
   virtual const std::vector<cudaStream_t>& get_refresh_streams() = 0;
   virtual const std::vector<cudaStream_t>& get_insert_streams() = 0;
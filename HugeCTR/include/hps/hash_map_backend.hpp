@@ -17,10 +17,12 @@
 
 #include <parallel_hashmap/phmap.h>
 
+#include <atomic>
 #include <condition_variable>
 #include <deque>
 #include <functional>
 #include <hps/database_backend.hpp>
+#include <memory>
 #include <shared_mutex>
 #include <thread>
 #include <thread_pool.hpp>
@@ -54,9 +56,15 @@ class HashMapBackend final : public VolatileBackend<TKey> {
     std::vector<char*> value_ptrs;
     phmap::flat_hash_map<TKey, TEntry> entries;
 
+    // Partition-level access control. Readers (fetch/contains) acquire this shared, so they
+    // never serialize behind writers that mutate other partitions.
+    std::unique_ptr<std::shared_mutex> read_write_guard;
+
     TPartition() = delete;
     TPartition(const size_t index, const uint32_t value_size)
-        : index{index}, value_size{value_size} {}
+        : index{index},
+          value_size{value_size},
+          read_write_guard{std::make_unique<std::shared_mutex>()} {}
   };
 
   /**
@@ -66,12 +74,18 @@ class HashMapBackend final : public VolatileBackend<TKey> {
    * @param overflow_margin Margin at which further inserts will trigger overflow handling.
    * @param overflow_policy Policy to use in case an overflow has been detected.
    * @param overflow_resolution_target Target margin after applying overflow handling policy.
+   * @param expiry_seconds Seconds after which an untouched entry expires (0 = never). Expired
+   *                       entries are reclaimed by a background compaction thread, so tables
+   *                       fed by online training stop growing with the key churn instead of
+   *                       thrashing in overflow eviction.
    */
   HashMapBackend(size_t num_partitions = 16, size_t allocation_rate = 256 * 1024 * 1024,
                  size_t max_get_batch_size = 10'000, size_t max_set_batch_size = 10'000,
                  size_t overflow_margin = std::numeric_limits<size_t>::max(),
                  DatabaseOverflowPolicy_t overflow_policy = DatabaseOverflowPolicy_t::EvictOldest,
-                 double overflow_resolution_target = 0.8);
+                 double overflow_resolution_target = 0.8, size_t expiry_seconds = 0);
+
+  virtual ~HashMapBackend();
 
   bool is_shared() const override final { return false; }
 
@@ -115,11 +129,33 @@ class HashMapBackend final : public VolatileBackend<TKey> {
   const size_t allocation_rate_;
   std::unordered_map<std::string, std::vector<TPartition>> tables_;
 
-  // Access control.
+  // Access control. Only guards the table => partition mapping itself. Queries and updates
+  // acquire it shared and rely on the per-partition guards, so concurrent lookups never block
+  // on inserts that target other partitions.
   mutable std::shared_mutex read_write_guard_;
 
   // Overflow resolution.
   size_t resolve_overflow_(const std::string& table_name, TPartition& part);
+
+  // TTL expiry (see expiry_seconds ctor parameter). The compaction thread sweeps one
+  // partition at a time and evicts in max_set_batch_size batches, so the serving path only
+  // ever waits for one bounded critical section.
+  const size_t expiry_seconds_;
+  std::thread expiry_compaction_worker_;
+  std::atomic<bool> expiry_compaction_terminate_{false};
+  void expiry_compaction_loop_();
+
+  /**
+   * Radix-partitions a batch of `num_keys` key positions into per-partition runs. After the
+   * call, `order` holds the positions `0 .. num_keys - 1` grouped by partition, and
+   * `run_offsets` holds `num_partitions_ + 1` offsets such that partition p owns the
+   * contiguous run `order[run_offsets[p]] .. order[run_offsets[p + 1] - 1]`. Both the
+   * histogram and the scatter pass are chunked across the thread pool; `part_index_of(i)`
+   * maps a position to its partition. Positions within a run keep their original order.
+   */
+  template <typename TPartIndexOf>
+  void radix_partition_(TPartIndexOf&& part_index_of, size_t num_keys,
+                        std::vector<size_t>& run_offsets, std::vector<size_t>& order) const;
 };
 
 // TODO: Remove me!
@@ -15,6 +15,7 @@
  */
 
 #pragma once
+#include <atomic>
 #include <common.hpp>
 #include <hps/database_backend.hpp>
 #include <hps/embedding_cache_base.hpp>
@@ -24,8 +25,10 @@
 #include <hps/message.hpp>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
+#include <tuple>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -42,6 +45,9 @@ class HierParameterServer : public HierParameterServerBase {
   HierParameterServer& operator=(HierParameterServer const&) = delete;
 
   virtual void update_database_per_model(const InferenceParams& inference_params);
+  virtual void ingest_model_table(const std::string& model_name, const std::string& table_name,
+                                  size_t num_pairs, const void* keys, size_t key_size_bytes,
+                                  const float* vectors, size_t embedding_vec_size);
   virtual void create_embedding_cache_per_model(InferenceParams& inference_params);
   virtual void init_ec(InferenceParams& inference_params,
                        std::map<int64_t, std::shared_ptr<EmbeddingCacheBase>> embedding_cache_map);
@@ -56,6 +62,10 @@ class HierParameterServer : public HierParameterServerBase {
   virtual void free_buffer(void* p);
   virtual void lookup(const void* h_keys, size_t length, float* h_vectors,
                       const std::string& model_name, size_t table_id);
+  virtual void lookup(const std::vector<const void*>& h_keys_per_table,
+                      const std::vector<size_t>& lengths_per_table,
+                      const std::vector<float*>& h_vectors_per_table,
+                      const std::string& model_name);
   virtual void refresh_embedding_cache(const std::string& model_name, int device_id);
   virtual void insert_embedding_cache(size_t table_id,
                                       std::shared_ptr<EmbeddingCacheBase> embedding_cache,
@@ -65,6 +75,16 @@ class HierParameterServer : public HierParameterServerBase {
   virtual std::map<std::string, InferenceParams> get_hps_model_configuration_map();
 
  private:
+  // Staged real-time updates awaiting group commit, tag -> (value_size, keys, values).
+  using UpdateStagingBuffer =
+      std::unordered_map<std::string,
+                         std::tuple<size_t, std::vector<TypeHashKey>, std::vector<char>>>;
+
+  bool stage_update_(UpdateStagingBuffer& staging, const std::string& tag, size_t num_pairs,
+                     const TypeHashKey* keys, const char* values, size_t value_size);
+  void apply_staged_updates_();
+  void arbitrate_cache_memory_();
+
   // Parameter server configuration
   parameter_server_config ps_config_;
   // Database layers for multi-tier cache/lookup.
@@ -75,6 +95,15 @@ class HierParameterServer : public HierParameterServerBase {
   // Realtime data ingestion.
   std::unique_ptr<MessageSource<TypeHashKey>> volatile_db_source_;
   std::unique_ptr<MessageSource<TypeHashKey>> persistent_db_source_;
+  // Group-commit staging of real-time updates (one staging area per database level).
+  UpdateStagingBuffer volatile_db_staged_updates_;
+  UpdateStagingBuffer persistent_db_staged_updates_;
+  std::mutex staged_updates_guard_;
+  std::thread group_commit_worker_;
+  std::atomic<bool> group_commit_terminate_{false};
+  // Online GPU cache capacity arbitration between co-located models.
+  std::thread cache_arbitration_worker_;
+  std::atomic<bool> cache_arbitration_terminate_{false};
   // Buffer pool that manages workspace and refreshspace of embedding caches
   std::shared_ptr<ManagerPool> buffer_pool_;
   // Configurations for memory pool
@@ -43,6 +43,16 @@ class HierParameterServerBase {
   static std::shared_ptr<HierParameterServerBase> create(const std::string& hps_json_config_file);
 
   virtual void update_database_per_model(const InferenceParams& inference_params) = 0;
+  /**
+   * Ingests one embedding table of a registered model straight into the database hierarchy,
+   * bypassing the sparse-model-file round trip of update_database_per_model(). The table name,
+   * key width and embedding vector size are validated against the model configuration before
+   * any insert. Shards may arrive across multiple calls and in any order; each call is applied
+   * like an online update, so a standing server can be fed while it keeps serving lookups.
+   */
+  virtual void ingest_model_table(const std::string& model_name, const std::string& table_name,
+                                  size_t num_pairs, const void* keys, size_t key_size_bytes,
+                                  const float* vectors, size_t embedding_vec_size) = 0;
   virtual void create_embedding_cache_per_model(InferenceParams& inference_params) = 0;
   virtual void init_ec(
       InferenceParams& inference_params,
@@ -58,6 +68,10 @@ class HierParameterServerBase {
   virtual void free_buffer(void* p) = 0;
   virtual void lookup(const void* h_keys, size_t length, float* h_vectors,
                       const std::string& model_name, size_t table_id) = 0;
+  virtual void lookup(const std::vector<const void*>& h_keys_per_table,
+                      const std::vector<size_t>& lengths_per_table,
+                      const std::vector<float*>& h_vectors_per_table,
+                      const std::string& model_name) = 0;
   virtual void refresh_embedding_cache(const std::string& model_name, int device_id) = 0;
   virtual void insert_embedding_cache(size_t table_id,
                                       std::shared_ptr<EmbeddingCacheBase> embedding_cache,
@@ -36,6 +36,7 @@ enum class DatabaseType_t {
   Disabled,
   HashMap,
   ParallelHashMap,
+  MultiProcessHashMap,
   RedisCluster,
   RocksDB,
   DirectMap,
@@ -58,6 +59,8 @@ constexpr const char* hctr_enum_to_c_str(const DatabaseType_t value) {
       return "hash_map";
     case DatabaseType_t::ParallelHashMap:
       return "parallel_hash_map";
+    case DatabaseType_t::MultiProcessHashMap:
+      return "multi_process_hash_map";
     case DatabaseType_t::DirectMap:
       return "direct_map";
     case DatabaseType_t::RedisCluster:
@@ -110,11 +113,18 @@ struct VolatileDatabaseParams {
   size_t max_get_batch_size;
   size_t max_set_batch_size;
 
+  // Only used with the MultiProcessHashMap backend.
+  std::string shared_memory_name = "hps_shared_memory";
+  size_t shared_memory_size = 16UL * 1024 * 1024 * 1024;
+
   // Overflow handling related.
   bool refresh_time_after_fetch;
   size_t overflow_margin;
   DatabaseOverflowPolicy_t overflow_policy;
   double overflow_resolution_target;
+  // Seconds after which an untouched embedding expires and becomes eligible for background
+  // compaction (0 = never). Only used with HashMap type backends.
+  size_t expiry_seconds;
 
   // Chaching behavior related.
   double initial_cache_rate;
@@ -135,7 +145,7 @@ struct VolatileDatabaseParams {
       bool refresh_time_after_fetch = false,
       size_t overflow_margin = std::numeric_limits<size_t>::max(),
       DatabaseOverflowPolicy_t overflow_policy = DatabaseOverflowPolicy_t::EvictOldest,
-      double overflow_resolution_target = 0.8,
+      double overflow_resolution_target = 0.8, size_t expiry_seconds = 0,
       // Caching behavior related.
       double initial_cache_rate = 1.0, bool cache_missed_embeddings = false,
       // Real-time update mechanism related.
@@ -182,6 +192,10 @@ struct UpdateSourceParams {
   size_t max_batch_size;
   size_t failure_backoff_ms;
   size_t max_commit_interval;
+  // Group-commit mode: stage delivered updates and batch-apply them to the database backends on a
+  // timer, instead of applying each delivery immediately.
+  bool group_commit = false;
+  size_t group_commit_staleness_ms = 1'000;  // Upper bound for the staleness of staged updates.
 
   UpdateSourceParams(UpdateSourceType_t type = UpdateSourceType_t::Null,
                      // Backend specific.
@@ -216,6 +230,14 @@ struct InferenceParams {
   int number_of_refresh_buffers_in_pool;
   int thread_pool_size;
   float cache_refresh_percentage_per_iteration;
+  bool enable_cache_prefetch = false;
+  float cache_prefetch_interval = 1.0f;  // Seconds between background prefetch rounds.
+  // Optional second GPU-memory cache tier that absorbs first-tier misses before PCIe.
+  bool use_l2_gpu_cache = false;
+  float l2_cache_size_percentage = 0.0f;
+  // GPU embedding cache set associativity per table (2/4/8/16-way). Tables without an entry use
+  // the 2-way default.
+  std::vector<size_t> gpu_cache_set_associativity;
   std::vector<int> deployed_devices;
   std::vector<int> cross_worker_deployed_devices;
   std::vector<float> default_value_for_each_table;
@@ -321,6 +343,10 @@ struct embedding_cache_config {
   size_t num_emb_table_;  // # of embedding table in this model
   float cache_size_percentage_;
   float cache_refresh_percentage_per_iteration = 0.1;
+  bool enable_cache_prefetch_ = false;    // Whether the query-history prefetch worker runs
+  float cache_prefetch_interval_ = 1.0f;  // Seconds between background prefetch rounds
+  bool use_l2_gpu_embedding_cache_ = false;  // Whether the second GPU cache tier is enabled
+  float l2_cache_size_percentage_ = 0.0f;
   size_t num_set_in_refresh_workspace_;
   std::vector<float> default_value_for_each_table;
   std::string model_name_;        // Which model this cache belongs to
@@ -329,6 +355,8 @@ struct embedding_cache_config {
   // Each vector will have the size of E(# of embedding tables in the model)
   std::vector<size_t> embedding_vec_size_;  // # of float in emb_vec
   std::vector<size_t> num_set_in_cache_;    // # of cache set in the cache
+  std::vector<size_t> set_associativity_per_table_;  // # of slabs per cache set
+  std::vector<size_t> num_set_in_l2_cache_;  // # of cache set in the second-level cache
   std::vector<std::string>
       embedding_table_name_;  // ## of embedding tables be cached by current embedding cache
   std::vector<size_t>
@@ -358,18 +386,31 @@ struct EmbeddingCacheWorkspace {
                                             // on device, same size as h_embeddingcolumns
   std::vector<float*> d_missing_emb_vec_;   // The buffer to hold retrieved missing emb_vec on
                                             // device, same size as d_shuffled_embeddingoutputvector
+  std::vector<float*> d_l2_hit_emb_vec_;  // The buffer to hold emb_vec hit in the 2nd cache tier on
+                                          // device, same size as d_shuffled_embeddingoutputvector
+  std::vector<void*>
+      d_l2_missing_embeddingcolumns_;  // The buffer to hold emb_id missed by both cache tiers on
+                                       // device, same size as h_embeddingcolumns
+  std::vector<uint64_t*>
+      d_l2_missing_index_;  // The buffer to hold missing index of the 2nd cache tier on device,
+                            // same size as h_embeddingcolumns
   std::vector<void*> unique_op_obj_;  // The unique op object for to de-duplicate queried emb_id to
                                       // each emb_table, size = # of emb_table
   size_t* d_missing_length_;  // The buffer to hold missing length for each emb_table on device,
                               // size = # of emb_table
   size_t* h_missing_length_;  // The buffer to hold missing length for each emb_table on host, size
                               // = # of emb_table
+  size_t* d_l2_missing_length_;  // The buffer to hold missing length of the 2nd cache tier for
+                                 // each emb_table on device, size = # of emb_table
+  size_t* h_l2_missing_length_;  // The buffer to hold missing length of the 2nd cache tier for
+                                 // each emb_table on host, size = # of emb_table
   size_t* d_unique_length_;   // The # of emb_id after the unique operation for each emb_table on
                               // device, size = # of emb_table
   size_t* h_unique_length_;   // The # of emb_id after the unique operation for each emb_table on
                               // host, size = # of emb_table
   double* h_hit_rate_;        // The hit rate for each emb_table on host, size = # of emb_table
-  bool use_gpu_embedding_cache_;  // whether to use gpu embedding cache
+  bool use_gpu_embedding_cache_;     // whether to use gpu embedding cache
+  bool use_l2_gpu_embedding_cache_;  // whether to use the second gpu cache tier
 };
 
 struct EmbeddingCacheRefreshspace {
@@ -395,4 +436,8 @@ void decompress_emb_vec_async(const float* d_unique_src_ptr, const uint64_t* d_u
                               const size_t emb_vec_size, const size_t BLOCK_SIZE,
                               cudaStream_t stream);
 
+void compose_missing_index_async(const uint64_t* d_outer_missing_index_ptr,
+                                 uint64_t* d_inner_missing_index_ptr, const size_t missing_len,
+                                 const size_t BLOCK_SIZE, cudaStream_t stream);
+
 }  // namespace HugeCTR
\ No newline at end of file
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2021, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+
+namespace HugeCTR {
+
+/**
+ * Deterministic compaction of 64-bit keys into the 32-bit key space, for tables that hold fewer
+ * than 4 billion unique keys but carry sparse 64-bit ids. Keys that already fit keep their value,
+ * so datasets generated for 32-bit key mode are unaffected; only the long tail above 2^32 is
+ * hashed down. Because the mapping is a pure function of the key, lookup clients can apply it to
+ * their query keys without any shared dictionary -- the dictionary in KeyCompactor32 exists only
+ * to prove, at load time, that the mapping is collision-free on the actual key set.
+ */
+inline uint32_t compact_key_32(uint64_t key) {
+  if (key < (1ULL << 32)) {
+    return static_cast<uint32_t>(key);
+  }
+  // MurmurHash3 64-bit finalizer, folded to 32 bits
+  key ^= key >> 33;
+  key *= 0xff51afd7ed558ccdULL;
+  key ^= key >> 33;
+  key *= 0xc4ceb9fe1a85ec53ULL;
+  key ^= key >> 33;
+  return static_cast<uint32_t>(key ^ (key >> 32));
+}
+
+/**
+ * Collision checker for compact_key_32. Feed every key of a table through add(); the first pair
+ * of distinct keys that land on the same 32-bit id is remembered so the caller can report it.
+ */
+class KeyCompactor32 {
+ public:
+  // Returns the compacted id; records the first collision instead of resolving it, since a
+  // dictionary-resolved id could not be recomputed by lookup clients.
+  uint32_t add(uint64_t key) {
+    const uint32_t id = compact_key_32(key);
+    const auto it = dict_.emplace(id, key);
+    if (!it.second && it.first->second != key && !has_collision_) {
+      has_collision_ = true;
+      collision_keys_ = {it.first->second, key};
+    }
+    return id;
+  }
+
+  bool has_collision() const { return has_collision_; }
+  std::pair<uint64_t, uint64_t> collision_keys() const { return collision_keys_; }
+
+ private:
+  std::unordered_map<uint32_t, uint64_t> dict_;
+  bool has_collision_ = false;
+  std::pair<uint64_t, uint64_t> collision_keys_{0, 0};
+};
+
+}  // namespace HugeCTR
@@ -14,7 +14,11 @@
  * limitations under the License.
  */
 #pragma once
+#include <condition_variable>
 #include <hps/lookup_session_base.hpp>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace HugeCTR {
 
@@ -27,15 +31,54 @@ class LookupSession : public LookupSessionBase {
   LookupSession& operator=(LookupSession const&) = delete;
 
   virtual void lookup(const void* h_keys, float* d_vectors, size_t num_keys, size_t table_id);
+  virtual void lookup(const void* h_keys, float* d_vectors, size_t num_keys, size_t table_id,
+                      Priority priority) override;
   virtual void lookup(const std::vector<const void*>& h_keys_per_table,
                       const std::vector<float*>& d_vectors_per_table,
                       const std::vector<size_t>& num_keys_per_table);
   virtual const InferenceParams get_inference_params() const override { return inference_params_; }
 
  private:
+  /// One lookup request blocked in a coalescing window, waiting for the merged cache query.
+  struct PendingLookup {
+    const void* h_keys;
+    float* d_vectors;
+    size_t num_keys;
+    bool done{false};
+  };
+  /// Per-table window state. The first caller of a window becomes the leader: it waits for
+  /// followers until the deadline, executes one merged query and wakes the batch. exec_mutex
+  /// serializes the merged queries so the next window can already assemble meanwhile.
+  struct CoalesceQueue {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::mutex exec_mutex;
+    std::vector<PendingLookup*> requests;
+    bool leader_active{false};
+  };
+
+  void lookup_coalesced_(const void* h_keys, float* d_vectors, size_t num_keys, size_t table_id);
+  void execute_coalesced_(size_t table_id, const std::vector<PendingLookup*>& batch);
+
+  void lookup_low_priority_(const void* h_keys, float* d_vectors, size_t num_keys,
+                            size_t table_id);
+
   std::vector<cudaStream_t> lookup_streams_;
+  // Low-priority lane for batch scoring: the streams preempt behind the online lane, and the
+  // admission count keeps batch lookups from draining the worker-buffer pool that online
+  // requests block on.
+  std::vector<cudaStream_t> batch_lookup_streams_;
+  std::mutex batch_admission_mutex_;
+  std::condition_variable batch_admission_cv_;
+  long batch_admission_limit_{1};
+  long batch_inflight_{0};
   std::shared_ptr<EmbeddingCacheBase> embedding_cache_;
   InferenceParams inference_params_;
+  long coalesce_window_us_{0};
+  std::vector<std::unique_ptr<CoalesceQueue>> coalesce_queues_;
+  std::vector<std::vector<char>> h_coalesced_keys_;
+  std::vector<float*> d_coalesced_vectors_;
+  std::vector<size_t> coalesce_capacities_;
 };
 
-}  // namespace HugeCTR
\ No newline at end of file
+}  // namespace HugeCTR
@@ -27,7 +27,17 @@ class LookupSessionBase {
   LookupSessionBase(LookupSessionBase const&) = delete;
   LookupSessionBase& operator=(LookupSessionBase const&) = delete;
 
+  /**
+   * Lane selection for lookups that share a device: \p High for latency-sensitive online
+   * traffic, \p Low for throughput-oriented batch scoring.
+   */
+  enum class Priority { High, Low };
+
   virtual void lookup(const void* h_keys, float* d_vectors, size_t num_keys, size_t table_id) = 0;
+  virtual void lookup(const void* h_keys, float* d_vectors, size_t num_keys, size_t table_id,
+                      Priority priority) {
+    lookup(h_keys, d_vectors, num_keys, table_id);
+  }
   virtual void lookup(const std::vector<const void*>& h_keys_per_table,
                       const std::vector<float*>& d_vectors_per_table,
                       const std::vector<size_t>& num_keys_per_table) = 0;
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2021, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <pthread.h>
+
+#include <hps/database_backend.hpp>
+#include <string>
+#include <vector>
+
+namespace HugeCTR {
+
+// TODO: Remove me!
+#pragma GCC diagnostic push
+#pragma GCC diagnostic error "-Wconversion"
+
+/**
+ * \p DatabaseBackend implementation that stores key/value pairs in a POSIX shared memory arena, so
+ * that all HPS instances running on the same host (e.g., multiple Triton model instances) map one
+ * single copy of the embedding tables instead of duplicating them per process.
+ *
+ * Tables are stored as offset-based open-addressing hash tables directly inside the arena (no
+ * process-local pointers), with a fixed probe window per key that doubles as the eviction set when
+ * a table runs full.
+ *
+ * @tparam TKey The data-type that is used for keys in this database.
+ */
+template <typename TKey>
+class MultiProcessHashMapBackend final : public VolatileBackend<TKey> {
+ public:
+  using TBase = VolatileBackend<TKey>;
+
+  /**
+   * Construct a new MultiProcessHashMapBackend object, creating the shared memory arena if this
+   * process is the first one on the host, or attaching to the existing arena otherwise.
+   *
+   * @param shared_memory_name Name of the POSIX shared memory segment (i.e., \p shm_open name).
+   * @param shared_memory_size Total size of the arena in bytes (only relevant for the creator).
+   * @param max_get_batch_size Maximum number of key/value pairs per partition to fetch.
+   * @param max_set_batch_size Maximum number of key/value pairs per partition to insert.
+   * @param overflow_margin Margin at which further inserts will trigger overflow handling.
+   * @param overflow_policy Policy to use in case an overflow has been detected.
+   * @param overflow_resolution_target Target margin after applying overflow handling policy.
+   */
+  MultiProcessHashMapBackend(
+      const std::string& shared_memory_name = "hps_shared_memory",
+      size_t shared_memory_size = 16UL * 1024 * 1024 * 1024, size_t max_get_batch_size = 10'000,
+      size_t max_set_batch_size = 10'000,
+      size_t overflow_margin = std::numeric_limits<size_t>::max(),
+      DatabaseOverflowPolicy_t overflow_policy = DatabaseOverflowPolicy_t::EvictOldest,
+      double overflow_resolution_target = 0.8);
+
+  virtual ~MultiProcessHashMapBackend();
+
+  // The arena is shared by all processes of this host.
+  bool is_shared() const override final { return true; }
+
+  const char* get_name() const override { return "MultiProcessHashMapBackend"; }
+
+  size_t capacity(const std::string& table_name) const override;
+
+  size_t size(const std::string& table_name) const override;
+
+  size_t contains(const std::string& table_name, size_t num_keys, const TKey* keys,
+                  const std::chrono::nanoseconds& time_budget) const override;
+
+  bool insert(const std::string& table_name, size_t num_pairs, const TKey* keys, const char* values,
+              size_t value_size) override;
+
+  size_t fetch(const std::string& table_name, size_t num_keys, const TKey* keys,
+               const DatabaseHitCallback& on_hit, const DatabaseMissCallback& on_miss,
+               const std::chrono::nanoseconds& time_budget) override;
+
+  size_t fetch(const std::string& table_name, size_t num_indices, const size_t* indices,
+               const TKey* keys, const DatabaseHitCallback& on_hit,
+               const DatabaseMissCallback& on_miss,
+               const std::chrono::nanoseconds& time_budget) override;
+
+  size_t evict(const std::string& table_name) override;
+
+  size_t evict(const std::string& table_name, size_t num_keys, const TKey* keys) override;
+
+  std::vector<std::string> find_tables(const std::string& model_name) override;
+
+  void dump_bin(const std::string& table_name, std::ofstream& file) override;
+
+  void dump_sst(const std::string& table_name, rocksdb::SstFileWriter& file) override;
+
+ protected:
+  // Number of slots a key can hash to. Also the eviction set if all of them are occupied.
+  static constexpr size_t PROBE_WINDOW = 8;
+
+  // Key value that marks a slot as vacant. Keys with this value cannot be stored.
+  static constexpr TKey EMPTY_SLOT_SENTINEL = std::numeric_limits<TKey>::max();
+
+  static constexpr uint64_t SHM_MAGIC = 0x6870735f73686d31;  // "hps_shm1"
+  static constexpr size_t MAX_TABLES = 64;
+  static constexpr size_t MAX_TABLE_NAME_LENGTH = 119;
+
+  /**
+   * Hash table slot; lives in shared memory. The value bytes directly follow the header, so the
+   * effective slot stride depends on the value size of the table.
+   */
+  struct ShmSlot {
+    TKey key;            // = EMPTY_SLOT_SENTINEL, if the slot is vacant.
+    time_t last_access;  // Last time this slot was inserted or fetched.
+    // char value[];  // value_size bytes, 8-byte aligned.
+  };
+
+  /**
+   * Per-table metadata; lives in the arena directory. Offsets are relative to the arena base, so
+   * they are valid in every process regardless of where the arena is mapped.
+   */
+  struct ShmTable {
+    char name[MAX_TABLE_NAME_LENGTH + 1];
+    size_t slots_offset;    // Byte offset of the slot array within the arena.
+    size_t num_slots;       // Capacity in slots.
+    size_t slot_stride;     // Bytes per slot (header + padded value).
+    size_t value_size;      // Bytes per value.
+    size_t num_entries;     // Number of occupied slots; maintained under the write lock.
+    pthread_rwlock_t lock;  // Process-shared reader/writer lock.
+  };
+
+  /**
+   * Arena header; lives at the beginning of the shared memory segment.
+   */
+  struct ShmHeader {
+    uint64_t magic;  // = SHM_MAGIC, once the creator finished initializing the header.
+    size_t arena_size;
+    size_t alloc_offset;          // Bump allocator position.
+    pthread_mutex_t alloc_guard;  // Process-shared; protects alloc_offset and the directory.
+    size_t num_tables;
+    ShmTable tables[MAX_TABLES];
+  };
+
+  /**
+   * Find a table in the arena directory.
+   *
+   * @return Pointer to the table metadata, or nullptr if no such table exists.
+   */
+  ShmTable* find_table_(const std::string& table_name) const;
+
+  /**
+   * Find or create a table. Creation reserves the slot array from the bump allocator.
+   */
+  ShmTable* get_or_create_table_(const std::string& table_name, size_t num_pairs,
+                                 size_t value_size);
+
+  ShmSlot* slot_at_(const ShmTable& table, size_t slot_index) const {
+    return reinterpret_cast<ShmSlot*>(reinterpret_cast<char*>(arena_) + table.slots_offset +
+                                      slot_index * table.slot_stride);
+  }
+
+  static char* slot_value_(ShmSlot* const slot) {
+    return reinterpret_cast<char*>(slot) + sizeof(ShmSlot);
+  }
+
+  const std::string shared_memory_name_;
+  size_t shared_memory_size_;
+  void* arena_ = nullptr;
+  ShmHeader* header_ = nullptr;
+  bool is_creator_ = false;
+};
+
+// TODO: Remove me!
+#pragma GCC diagnostic pop
+
+}  // namespace HugeCTR
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2021, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <hps/database_backend.hpp>
+#include <hps/hash_map_backend.hpp>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace HugeCTR {
+
+// TODO: Remove me!
+#pragma GCC diagnostic push
+#pragma GCC diagnostic error "-Wconversion"
+
+/**
+ * \p VolatileBackend decorator that keeps a bounded in-process copy of recently fetched
+ * key/value pairs in front of a distant (i.e., network-attached) backend. Keys that hit the
+ * near tier never reach the distant backend; misses are fetched from the distant backend and
+ * admitted into the near tier on the way out. Updates delivered through \p insert (e.g., from
+ * the online update stream) evict the affected near copies, so the next fetch observes the
+ * fresh value.
+ *
+ * @tparam TKey The data-type that is used for keys in this database.
+ */
+template <typename TKey>
+class NearCacheBackend final : public VolatileBackend<TKey> {
+ public:
+  using TBase = VolatileBackend<TKey>;
+
+  /**
+   * Construct a new NearCacheBackend object.
+   * @param distant The backend to put the near cache in front of.
+   * @param near_capacity Maximum total number of entries the near tier may hold per table.
+   * @param num_partitions The number of parallel partitions of the near tier.
+   * @param max_get_batch_size Maximum number of key/value pairs per near-tier query.
+   * @param max_set_batch_size Maximum number of key/value pairs per near-tier insertion.
+   */
+  NearCacheBackend(std::unique_ptr<VolatileBackend<TKey>> distant, size_t near_capacity,
+                   size_t num_partitions, size_t max_get_batch_size, size_t max_set_batch_size);
+
+  /**
+   * Deliberately not delegated: every process has to consume the full update stream to
+   * invalidate its private near tier, even when the distant backend is shared.
+   */
+  bool is_shared() const override final { return false; }
+
+  const char* get_name() const override { return "NearCacheBackend"; }
+
+  size_t capacity(const std::string& table_name) const override {
+    return distant_->capacity(table_name);
+  }
+
+  size_t size(const std::string& table_name) const override { return distant_->size(table_name); }
+
+  size_t contains(const std::string& table_name, size_t num_keys, const TKey* keys,
+                  const std::chrono::nanoseconds& time_budget) const override {
+    return distant_->contains(table_name, num_keys, keys, time_budget);
+  }
+
+  bool insert(const std::string& table_name, size_t num_pairs, const TKey* keys, const char* values,
+              size_t value_size) override;
+
+  size_t fetch(const std::string& table_name, size_t num_keys, const TKey* keys,
+               const DatabaseHitCallback& on_hit, const DatabaseMissCallback& on_miss,
+               const std::chrono::nanoseconds& time_budget) override;
+
+  size_t fetch(const std::string& table_name, size_t num_indices, const size_t* indices,
+               const TKey* keys, const DatabaseHitCallback& on_hit,
+               const DatabaseMissCallback& on_miss,
+               const std::chrono::nanoseconds& time_budget) override;
+
+  size_t evict(const std::string& table_name) override;
+
+  size_t evict(const std::string& table_name, size_t num_keys, const TKey* keys) override;
+
+  std::vector<std::string> find_tables(const std::string& model_name) override {
+    return distant_->find_tables(model_name);
+  }
+
+  void dump_bin(const std::string& table_name, std::ofstream& file) override {
+    distant_->dump_bin(table_name, file);
+  }
+
+  void dump_sst(const std::string& table_name, rocksdb::SstFileWriter& file) override {
+    distant_->dump_sst(table_name, file);
+  }
+
+ protected:
+  /**
+   * Fetch the keys selected by \p indices from the distant backend, forward the results to
+   * \p on_hit and admit them into the near tier.
+   */
+  size_t fetch_distant_(const std::string& table_name, const std::vector<size_t>& indices,
+                        const TKey* keys, const DatabaseHitCallback& on_hit,
+                        const DatabaseMissCallback& on_miss,
+                        const std::chrono::nanoseconds& time_budget);
+
+  std::unique_ptr<VolatileBackend<TKey>> distant_;
+  HashMapBackend<TKey> near_;
+};
+
+// TODO: Remove me!
+#pragma GCC diagnostic pop
+
+}  // namespace HugeCTR
@@ -24,6 +24,22 @@ namespace HugeCTR {
 
 enum class EmbeddingFeatureCombiner_t { Sum, Mean };
 
+/**
+ * Per-table arguments of the fused multi-table combine kernel. One entry is
+ * gathered from each EmbeddingFeatureCombiner and uploaded to device memory
+ * once, so a single launch can serve tables with different slot numbers,
+ * vector sizes and combiner types.
+ */
+template <typename T>
+struct EmbeddingFeatureCombineParams {
+  const float* input;
+  T* output;
+  const int* row_ptrs;
+  int slot_num;
+  int embedding_vec_size;
+  EmbeddingFeatureCombiner_t combiner_type;
+};
+
 /**
  * Combine the embedding feature vectors by Sum or Mean
  * according to slot_num and row_ptrs
@@ -70,6 +86,12 @@ class EmbeddingFeatureCombiner : public Layer {
    */
   void fprop(bool is_train = false) override;
 
+  /**
+   * Gather this layer's arguments for the fused multi-table combine kernel.
+   * Must be called after the input tensors have been bound to their buffers.
+   */
+  EmbeddingFeatureCombineParams<T> get_combine_params();
+
   void bprop() override {
     HCTR_OWN_THROW(Error_t::IllegalCall,
                    "The bprop() of EmbeddingFeatureCombiner is not implemented!");
@@ -82,4 +104,37 @@ class EmbeddingFeatureCombiner : public Layer {
   EmbeddingFeatureCombiner_t combiner_type_;
 };
 
+/**
+ * Combines the features of all embedding tables with one kernel launch instead
+ * of one launch per table. The per-table arguments are gathered from the
+ * EmbeddingFeatureCombiner layers at construction and kept in device memory,
+ * so the tensors must already be bound to their final buffers.
+ */
+template <typename T>
+class FusedEmbeddingFeatureCombine {
+  std::vector<EmbeddingFeatureCombineParams<T>> h_params_;
+  EmbeddingFeatureCombineParams<T>* d_params_{nullptr};
+  int batch_size_;
+  int max_embedding_vec_size_{0};
+  std::shared_ptr<GPUResource> gpu_resource_;
+
+ public:
+  /**
+   * Ctor of FusedEmbeddingFeatureCombine.
+   * @param combiners the EmbeddingFeatureCombiner layers to fuse, one per table
+   * @param batch_size batch size
+   * @param gpu_resource available gpu resource
+   */
+  FusedEmbeddingFeatureCombine(const std::vector<std::shared_ptr<Layer>>& combiners,
+                               int batch_size, const std::shared_ptr<GPUResource>& gpu_resource);
+  ~FusedEmbeddingFeatureCombine();
+  FusedEmbeddingFeatureCombine(FusedEmbeddingFeatureCombine const&) = delete;
+  FusedEmbeddingFeatureCombine& operator=(FusedEmbeddingFeatureCombine const&) = delete;
+
+  /**
+   * Combine operation for all tables on the gpu resource's current stream
+   */
+  void fprop();
+};
+
 }  // namespace HugeCTR
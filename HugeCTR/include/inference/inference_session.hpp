@@ -44,15 +44,34 @@ class InferenceSession : public InferenceSessionBase {
   TensorBag2 dense_input_tensorbag_;  // dense input vector
 
   std::vector<std::shared_ptr<Layer>> embedding_feature_combiners_;
+  // Embedding-only sessions never build the dense network (network_ stays empty); they serve
+  // the combined embedding features to an external dense engine instead.
+  const bool embedding_only_;
   std::unique_ptr<Network> network_;
   std::shared_ptr<EmbeddingCacheBase> embedding_cache_;
 
   int* h_row_ptrs_;
   void* h_keys_;
+  // Pinned staging for caller-provided key buffers: pageable inputs are copied through a
+  // pooled pinned block once instead of paying a pageable H2D per embedding cache lookup;
+  // pinned or device-registered inputs are used zero-copy.
+  PinnedStagingPool pinned_staging_pool_;
   float* d_embedding_vectors_;
+  // Session-owned copy of the row pointers laid out at max_batchsize strides. The combiner
+  // input tensors are bound to it once at construction so their fprop can live inside the
+  // captured CUDA graph instead of being re-bound to the caller's buffer every request.
+  int* d_row_ptrs_;
 
   Pipeline predict_network_pipeline_;
 
+  /**
+   * Shared front half of predict and predict_embedding_only: copy the row pointers to the
+   * host, redistribute the keys to table-major order if needed, query the embedding cache and
+   * stage the row pointers into the session-owned buffer the combiners are bound to.
+   */
+  void lookup_and_stage_(void* h_embeddingcolumns, int* d_row_ptrs, int num_samples,
+                         bool table_major_key_layout);
+
  protected:
   InferenceParser inference_parser_;
   InferenceParams inference_params_;
@@ -63,12 +82,16 @@ class InferenceSession : public InferenceSessionBase {
   virtual ~InferenceSession();
   InferenceSession(const std::string& model_config_path, const InferenceParams& inference_params,
                    const std::shared_ptr<EmbeddingCacheBase>& embedding_cache,
-                   std::shared_ptr<ResourceManager> resource_manager = nullptr);
+                   std::shared_ptr<ResourceManager> resource_manager = nullptr,
+                   bool embedding_only = false);
   InferenceSession(InferenceSession const&) = delete;
   InferenceSession& operator=(InferenceSession const&) = delete;
 
   virtual void predict(float* d_dense, void* h_embeddingcolumns, int* d_row_ptrs, float* d_output,
                        int num_samples, bool table_major_key_layout = false);
+  virtual void predict_embedding_only(void* h_embeddingcolumns, int* d_row_ptrs,
+                                      float* d_embedding_features, int num_samples,
+                                      bool table_major_key_layout = false) override;
   const InferenceParser& get_inference_parser() const { return inference_parser_; }
 };
 
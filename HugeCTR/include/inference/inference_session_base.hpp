@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #pragma once
+#include <common.hpp>
 #include <hps/embedding_cache_base.hpp>
 #include <hps/inference_utils.hpp>
 #include <memory>
@@ -30,9 +31,21 @@ class InferenceSessionBase {
   virtual void predict(float* d_dense, void* h_embeddingcolumns, int* d_row_ptrs, float* d_output,
                        int num_samples, bool table_major_key_layout = false) = 0;
 
+  /**
+   * Embedding-only serving: look up and combine the embedding features without executing the
+   * dense network (e.g., when the dense layers are served by an external engine). Only
+   * available when the session was created with \p embedding_only set.
+   */
+  virtual void predict_embedding_only(void* h_embeddingcolumns, int* d_row_ptrs,
+                                      float* d_embedding_features, int num_samples,
+                                      bool table_major_key_layout = false) {
+    HCTR_OWN_THROW(Error_t::IllegalCall,
+                   "This inference session does not support embedding-only serving.");
+  }
+
   static std::shared_ptr<InferenceSessionBase> create(
       const std::string& model_config_path, const InferenceParams& inference_params,
-      const std::shared_ptr<EmbeddingCacheBase>& embedding_cache);
+      const std::shared_ptr<EmbeddingCacheBase>& embedding_cache, bool embedding_only = false);
 };
 
 }  // namespace HugeCTR
\ No newline at end of file
@@ -15,10 +15,71 @@
  */
 
 #pragma once
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
 #include "HugeCTR/include/tensor2.hpp"
 
 namespace HugeCTR {
 
+/**
+ * A small pool of reusable pinned host blocks for staging inference inputs. Inference
+ * frameworks can hand the session pageable buffers, and every H2D copy out of pageable
+ * memory pays an extra driver-side staging pass; copying the input once into a pinned
+ * block from this pool is cheaper. Blocks are size-classed to the next power of two and
+ * returned to a per-class free list on release, so steady-state serving allocates nothing.
+ */
+class PinnedStagingPool {
+ public:
+  PinnedStagingPool() = default;
+  PinnedStagingPool(const PinnedStagingPool&) = delete;
+  PinnedStagingPool& operator=(const PinnedStagingPool&) = delete;
+
+  ~PinnedStagingPool() {
+    for (auto& pair : block_class_) {
+      cudaFreeHost(pair.first);
+    }
+  }
+
+  void* acquire(size_t size_in_bytes) {
+    const size_t size_class = round_up_pow2(size_in_bytes);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& free_list = free_blocks_[size_class];
+    if (!free_list.empty()) {
+      void* ptr = free_list.back();
+      free_list.pop_back();
+      return ptr;
+    }
+    void* ptr;
+    HCTR_LIB_THROW(cudaMallocHost(&ptr, size_class));
+    block_class_[ptr] = size_class;
+    return ptr;
+  }
+
+  void release(void* ptr) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = block_class_.find(ptr);
+    if (it == block_class_.end()) {
+      HCTR_OWN_THROW(Error_t::WrongInput, "The released block does not belong to this pool");
+    }
+    free_blocks_[it->second].push_back(ptr);
+  }
+
+ private:
+  static size_t round_up_pow2(size_t size_in_bytes) {
+    size_t size_class = 512;
+    while (size_class < size_in_bytes) {
+      size_class <<= 1;
+    }
+    return size_class;
+  }
+
+  std::unordered_map<size_t, std::vector<void*>> free_blocks_;
+  std::unordered_map<void*, size_t> block_class_;
+  std::mutex mutex_;
+};  // class PinnedStagingPool
+
 template <typename T>
 class PreallocatedBuffer2 : public TensorBuffer2 {
   void *ptr_;
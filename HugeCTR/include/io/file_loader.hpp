@@ -18,6 +18,7 @@
 #include <sys/mman.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <fstream>
 
 #include "common.hpp"
@@ -122,8 +123,21 @@ class FileLoader {
       return Error_t::Success;
     } else {
       data_ = new char[cur_file_size_ / sizeof(char)];
-      int bytes_read = file_system_->read(cur_file_name_, data_, cur_file_size_, 0);
-      if (bytes_read <= 0) {
+      // Split the file into block reads so that backends with native asynchronous I/O keep
+      // several requests in flight; backends without it run the callbacks inline.
+      constexpr size_t block_size = 16ul << 20;
+      bool read_ok = true;
+      for (size_t offset = 0; offset < cur_file_size_; offset += block_size) {
+        const size_t len = std::min(block_size, cur_file_size_ - offset);
+        file_system_->read_async(cur_file_name_, data_ + offset, len, offset,
+                                 [&read_ok, len](int bytes_read) {
+                                   if (bytes_read != static_cast<int>(len)) {
+                                     read_ok = false;
+                                   }
+                                 });
+      }
+      file_system_->wait_all();
+      if (!read_ok) {
         delete[] data_;
         data_ = nullptr;
         HCTR_LOG_S(ERROR, WORLD) << "Error reading the file from dfs " << HCTR_LOCATION()
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -93,6 +94,35 @@ class FileSystem {
    */
   virtual int read(const std::string& path, void* buffer, size_t buffer_size, size_t offset) = 0;
 
+  /**
+   * @brief Completion callback of read_async; receives the number of successfully read bytes.
+   * Callbacks run on the thread that calls read_async or wait_all, never on a hidden one.
+   */
+  using ReadCallback = std::function<void(int)>;
+
+  /**
+   * @brief Submit an asynchronous read; the callback fires once the buffer is filled. Backends
+   * with native asynchronous I/O keep several submitted reads in flight, so callers get storage
+   * parallelism without one blocked thread per request. Backends without it run the read
+   * synchronously and invoke the callback before returning.
+   *
+   * @param path Remote path of the file from which to read.
+   * @param buffer Buffer to hold the read data; must stay alive until the callback has run.
+   * @param buffer_size The number of bytes to read.
+   * @param offset Offset within the file from which to start reading.
+   * @param on_complete Invoked with the number of successfully read bytes.
+   */
+  virtual void read_async(const std::string& path, void* buffer, size_t buffer_size, size_t offset,
+                          ReadCallback on_complete) {
+    on_complete(read(path, buffer, buffer_size, offset));
+  }
+
+  /**
+   * @brief Block until every read submitted with read_async has completed and its callback has
+   * run.
+   */
+  virtual void wait_all() {}
+
   /**
    * @brief Copy a specific file within a file system.
    *
@@ -16,7 +16,11 @@
 
 #pragma once
 
+#include <deque>
+#include <future>
 #include <io/filesystem.hpp>
+#include <mutex>
+#include <vector>
 
 #ifdef ENABLE_HDFS
 #include "hdfs.h"
@@ -90,6 +94,42 @@ class HadoopFileSystem final : public FileSystem {
   hdfsFS fs_;
   hdfsFS local_fs_;
 
+  static constexpr size_t READAHEAD_BLOCK_SIZE = 4ul << 20; /**< block read granularity */
+  static constexpr int READAHEAD_DEPTH = 4;                 /**< outstanding block reads */
+
+  /**
+   * One block of the readahead window: a buffer plus the pread that fills it.
+   */
+  struct ReadaheadSlot {
+    std::vector<char> data;
+    size_t offset = 0;
+    std::future<int> pending; /**< resolves to the number of bytes read */
+    int size = 0;             /**< valid bytes, set once pending resolved */
+    bool resolved = false;
+  };
+
+  std::mutex readahead_mutex_;
+  std::deque<ReadaheadSlot> readahead_window_;
+  std::vector<std::vector<char>> readahead_buffer_pool_; /**< recycled slot buffers */
+  std::string readahead_path_;                           /**< path the window belongs to */
+  size_t readahead_next_offset_ = 0;                     /**< next block to submit */
+  size_t readahead_consumer_offset_ = 0;                 /**< next byte read() will ask for */
+
+  /**
+   * @brief Submit block preads until READAHEAD_DEPTH are outstanding.
+   */
+  void fill_readahead_window();
+
+  /**
+   * @brief Wait for in-flight block reads and drop the window.
+   */
+  void reset_readahead_window();
+
+  /**
+   * @brief Synchronous single-shot pread, used for non-sequential access.
+   */
+  int read_direct(const std::string& path, void* buffer, size_t buffer_size, size_t offset);
+
   /**
    * @brief Connect to HDFS server
    */
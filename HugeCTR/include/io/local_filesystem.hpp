@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2021, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <io/filesystem.hpp>
+
+#ifdef ENABLE_IO_URING
+#include <liburing.h>
+#endif
+
+namespace HugeCTR {
+
+/**
+ * FileSystem backend for the local file system. The synchronous interface maps straight onto
+ * POSIX; read_async keeps up to RING_DEPTH reads in flight through io_uring when the binary is
+ * built with ENABLE_IO_URING, and degrades to the blocking base implementation otherwise.
+ */
+class LocalFileSystem final : public FileSystem {
+ public:
+  LocalFileSystem() = default;
+
+  virtual ~LocalFileSystem();
+
+  size_t get_file_size(const std::string& path) const override;
+
+  void create_dir(const std::string& path) override;
+
+  void delete_file(const std::string& path, bool recursive) override;
+
+  void fetch(const std::string& source_path, const std::string& target_path) override;
+
+  void upload(const std::string& source_path, const std::string& target_path) override;
+
+  int write(const std::string& path, const void* data, size_t data_size, bool overwrite) override;
+
+  int read(const std::string& path, void* buffer, size_t buffer_size, size_t offset) override;
+
+  void copy(const std::string& source_file, const std::string& target_file) override;
+
+  int batch_fetch(const std::string& source_dir, const std::string& target_dir) override;
+
+  int batch_upload(const std::string& source_dir, const std::string& target_dir) override;
+
+#ifdef ENABLE_IO_URING
+  void read_async(const std::string& path, void* buffer, size_t buffer_size, size_t offset,
+                  ReadCallback on_complete) override;
+
+  void wait_all() override;
+#endif
+
+ private:
+#ifdef ENABLE_IO_URING
+  static constexpr unsigned RING_DEPTH = 32; /**< max reads in flight */
+
+  /**
+   * One in-flight read; the heap address doubles as the io_uring user_data.
+   */
+  struct PendingRead {
+    int fd;
+    ReadCallback on_complete;
+  };
+
+  /**
+   * @brief Reap one completion, run its callback and release the slot.
+   */
+  void reap_one_();
+
+  io_uring ring_;
+  bool ring_ready_ = false;
+  size_t num_inflight_ = 0;
+#endif
+};
+
+}  // namespace HugeCTR
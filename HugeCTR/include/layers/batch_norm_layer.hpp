@@ -125,6 +125,14 @@ class BatchNormLayer : public Layer {
   // host array to do device-to-host copy for mean and var
   Tensor2<float> h_result_running_mean_;
   Tensor2<float> h_result_running_var_;
+
+  // SyncBN (opt-in via HCTR_SYNC_BN): normalize with global batch statistics instead of the
+  // per-GPU ones cuDNN computes. Both moments (and in bprop both gradient reduction terms) are
+  // packed into sync_stats_ so each pass costs a single all-reduce.
+  const bool sync_bn_requested_;
+  bool sync_bn_{false};
+  int num_global_gpus_{1};
+  Tensor2<float> sync_stats_;
 };
 
 }  // namespace HugeCTR
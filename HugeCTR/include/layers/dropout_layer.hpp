@@ -79,6 +79,20 @@ class DropoutLayer : public Layer {
   Tensor2<float> mask_;
   cudnnTensorDescriptor_t in_out_desc_;
   size_t reserveSpaceSizeInBytes_;
+  /*
+   * true when the mask is regenerated from a Philox counter in bprop instead of being
+   * materialized; no cudnn state or reserve space is allocated in this mode.
+   */
+  bool use_philox_{false};
+  uint64_t philox_seed_{0};
+  /*
+   * position in the Philox sequence for the next fprop; advanced every training iteration.
+   */
+  uint64_t philox_offset_{0};
+  /*
+   * offset the last fprop used, so bprop replays the identical mask.
+   */
+  uint64_t philox_fprop_offset_{0};
 };
 
 }  // namespace HugeCTR
@@ -46,6 +46,13 @@ class GatherLayer : public Layer {
   std::vector<int> h_indices_;
   Tensor2<int> indices_;
 
+  /*
+   * First row of a consecutive index range [first, first + num_indices), or -1. Consecutive
+   * rows select a contiguous block of the input, so fprop/bprop turn into single device
+   * copies instead of gather/scatter kernels.
+   */
+  int contiguous_start_{-1};
+
   Tensors2<T>& get_in_tensors(bool is_train) { return in_tensors_; }
 
  public:
@@ -23,7 +23,10 @@
 namespace HugeCTR {
 
 /**
- * GRU function (Interest Extractor Layer) as a derived class of Layer
+ * GRU function (Interest Extractor Layer) as a derived class of Layer.
+ * An optional sequence length tensor (the same per-sample lengths fed to SequenceMaskLayer)
+ * switches the layer to the cuDNN variable-sequence-length path, which skips the compute of
+ * the padded time steps instead of running every sample to the maximum sequence length.
  */
 template <typename T>
 class GRULayer : public Layer {
@@ -71,9 +74,34 @@ class GRULayer : public Layer {
            size_t embedding_vec_size, const std::shared_ptr<GPUResource> &gpu_resource,
            std::vector<Initializer_t> initializer_types = std::vector<Initializer_t>());
 
+  /**
+   * Ctor of GRULayer with per-sample sequence lengths.
+   * @param seq_len_tensor the [batch_size, 1] sequence length tensor also fed to
+   * SequenceMaskLayer; the padded time steps of each sample are skipped
+   */
+  GRULayer(const std::shared_ptr<BufferBlock2<T>> &weight_buff,
+           const std::shared_ptr<BufferBlock2<T>> &wgrad_buff, const Tensor2<T> &in_tensor,
+           const Tensor2<T> &seq_len_tensor, const Tensor2<T> &out_tensor, size_t hiddenSize,
+           size_t batch_size, size_t SeqLength, size_t embedding_vec_size,
+           const std::shared_ptr<GPUResource> &gpu_resource,
+           std::vector<Initializer_t> initializer_types = std::vector<Initializer_t>());
+
  private:
   int *seqLengthArray = NULL;
   int *devSeqLengthArray = NULL;
+  /*
+   * variable sequence length mode: the lengths live on the device and the RNN data
+   * descriptors are refreshed from them before every forward pass.
+   */
+  bool variable_seq_len_ = false;
+  Tensor2<T> seq_len_tensor_;
+  T padding_fill_ = T(0);
+
+  /**
+   * Reloads the per-sample lengths from the sequence length tensor and rebuilds the RNN data
+   * descriptors so that cuDNN skips the padded time steps of the current batch.
+   */
+  void refresh_seq_length_descriptors();
   void *weightSpace = NULL;
   void *dweightSpace = NULL;
   void *workSpace = NULL;
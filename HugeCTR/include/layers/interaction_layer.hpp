@@ -48,6 +48,12 @@ class InteractionLayer : public Layer {
 
   bool separate_Y_and_dY_;
 
+  /*
+   * computes the pairwise dots directly into the flattened triangular output,
+   * skipping the concat / batched GEMM / extract pipeline and its intermediates.
+   */
+  bool fused_fp32_{false};
+
   Tensors2<T> internal_tensors_;
 
   Tensors2<T>& get_in_tensors(bool is_train) { return in_tensors_; }
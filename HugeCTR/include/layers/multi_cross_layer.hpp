@@ -58,6 +58,12 @@ class MultiCrossLayer : public Layer {
   Tensor2<T> tmp_mat_tensors_[3];  //[h,w]
   Tensor2<T> tmp_vec_tensor_;      //[h,1]
 
+  /*
+   * runs the whole cross stack in one persistent kernel per direction, keeping the
+   * activations of a sample resident in shared memory across the layers.
+   */
+  bool fused_stack_{false};
+
   /*
    * stores the weight tensors of this layer.
    */
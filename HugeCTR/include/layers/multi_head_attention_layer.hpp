@@ -24,6 +24,10 @@ namespace HugeCTR {
 /**
  * Layer which does mult-head attention by input tensors.
  * All the input tensors should have the same shape.
+ * With two inputs (query, key) the layer emits the [head, batch, seq, seq] score matrix for
+ * a separate softmax layer. With three inputs (query, key, value) it computes the complete
+ * attention output through a streaming-softmax kernel that never materializes the score
+ * matrix; this fused form requires a head dimension of at most 128.
  */
 template <typename T>
 class MultiHeadAttentionLayer : public Layer {
@@ -74,6 +78,16 @@ class MultiHeadAttentionLayer : public Layer {
   Tensor2<T*> h_inputs_;
   Tensor2<T*> d_inputs_;
   Tensor2<T> fprop_inputA_;
+  /*
+   * whether the fused query/key/value attention path is active.
+   */
+  bool fused_attention_{false};
+  /*
+   * forward output and per-row softmax logsumexp kept for the fused backward pass.
+   */
+  Tensor2<T> fprop_out_;
+  Tensor2<float> softmax_lse_;
+  Tensor2<float> bprop_row_dot_;
 };
 
 }  // namespace HugeCTR
@@ -33,6 +33,14 @@ class ReluLayer : public Layer {
    * stores the references to the output tensors of this layer.
    */
   Tensors2<T> out_tensors_;
+  /*
+   * stores the packed sign mask used when the layer runs in place.
+   */
+  Tensor2<unsigned int> mask_tensor_;
+  /*
+   * true when out_tensor aliases in_tensor and bprop restores the mask from mask_tensor_.
+   */
+  bool in_place_{false};
 
  public:
   /**
@@ -44,6 +52,19 @@ class ReluLayer : public Layer {
   ReluLayer(const Tensor2<T>& in_tensor, const Tensor2<T>& out_tensor,
             const std::shared_ptr<GPUResource>& gpu_resource);
 
+  /**
+   * Ctor of ReluLayer running in place. The output aliases the input and the sign of the
+   * activation is kept as one bit per element, so the forward input does not have to stay
+   * alive until the backward pass.
+   * @param in_tensor the input tensor
+   * @param out_tensor the output tensor which aliases in_tensor
+   * @param mask_tensor the sign mask with (num_elements + 31) / 32 uint32 words
+   * @param device_id the id of GPU where this layer belongs
+   */
+  ReluLayer(const Tensor2<T>& in_tensor, const Tensor2<T>& out_tensor,
+            const Tensor2<unsigned int>& mask_tensor,
+            const std::shared_ptr<GPUResource>& gpu_resource);
+
   /**
    * A method of implementing the forward pass of Relu
    * @param stream CUDA stream where the foward propagation is executed
@@ -69,6 +90,14 @@ class ReluLayer<__half> : public Layer {
    * stores the references to the output tensors of this layer.
    */
   Tensor2<__half> top_tensor_;
+  /*
+   * stores the packed sign mask used when the layer runs in place.
+   */
+  Tensor2<unsigned int> mask_tensor_;
+  /*
+   * true when top_tensor aliases bottom_tensor and bprop restores the mask from mask_tensor_.
+   */
+  bool in_place_{false};
 
  public:
   /**
@@ -80,6 +109,19 @@ class ReluLayer<__half> : public Layer {
   ReluLayer(const Tensor2<__half>& bottom_tensor, const Tensor2<__half>& top_tensor,
             const std::shared_ptr<GPUResource>& gpu_resource);
 
+  /**
+   * Ctor of ReluLayer running in place. The output aliases the input and the sign of the
+   * activation is kept as one bit per element, so the forward input does not have to stay
+   * alive until the backward pass.
+   * @param bottom_tensor the input tensor
+   * @param top_tensor the output tensor which aliases bottom_tensor
+   * @param mask_tensor the sign mask with (num_elements + 31) / 32 uint32 words
+   * @param device_id the id of GPU where this layer belongs
+   */
+  ReluLayer(const Tensor2<__half>& bottom_tensor, const Tensor2<__half>& top_tensor,
+            const Tensor2<unsigned int>& mask_tensor,
+            const std::shared_ptr<GPUResource>& gpu_resource);
+
   /**
    * A method of implementing the forward pass of Relu
    * @param stream CUDA stream where the foward propagation is executed
@@ -47,6 +47,11 @@ class ReshapeLayer : public Layer {
   Tensors2<T> out_tensors_;
 
   bool in_place_;
+  /*
+   * true when the output tensor is a zero-copy view sharing the input buffer, in which case
+   * fprop and bprop become metadata-only and no copy is issued.
+   */
+  bool zero_copy_view_{false};
   int batch_size_;
   int n_slot_;
   int vector_length_;
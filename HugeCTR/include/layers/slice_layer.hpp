@@ -66,6 +66,13 @@ class SliceLayer : public Layer {
   Tensors2<T> out_tensors_;
 
   std::vector<int> slices_start_;
+
+  /*
+   * The first output is a zero-copy alias of the input (HCTR_SLICE_ALIAS): its range covers
+   * the whole input width, so fprop skips its copy and bprop treats the input gradient as
+   * already holding that branch's contribution.
+   */
+  bool alias_first_{false};
 };
 
 }  // namespace HugeCTR
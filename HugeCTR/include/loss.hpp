@@ -34,6 +34,8 @@ class ILoss {
 
   virtual float get_label_weight() const = 0;
   virtual void set_label_weight(float new_weight) = 0;
+
+  virtual void set_sample_weight_tensor(const Tensor2<float>& sample_weight) = 0;
 };
 
 /**
@@ -75,18 +77,24 @@ class Loss : public ILoss {
    */
   Tensors2<float> loss_tensors_;
 
+  /**
+   * Optional [batch_size, 1] per-sample weights (e.g. freshness); empty when unweighted. In
+   * training the gradient rows are scaled by their sample's weight right behind do_compute on
+   * the same stream, replacing sample duplication in the data.
+   */
+  Tensor2<float> sample_weight_tensor_;
+
   virtual void do_compute(T* input, const float* label, float* loss, int batch_size,
                           int feature_dim, float scaler, float rterm, float label_weight,
                           bool is_train, cudaStream_t stream) = 0;
 
+ protected:
   const Tensors2<float>& get_label_tensors(bool is_train) const { return label_tensors_; }
 
   Tensors2<T>& get_input_tensors(bool is_train) { return input_tensors_; }
 
- protected:
   bool gen_loss_summary_;
   const Tensors2<float>& get_loss_tensors() const { return loss_tensors_; }
-  int get_total_gpu_count() const { return total_gpu_count_; }
   const GPUResource& get_gpu() const { return *gpu_resource_; }
 
  public:
@@ -121,8 +129,24 @@ class Loss : public ILoss {
 
   float get_label_weight() const override { return label_weight; }
   void set_label_weight(float new_weight) override { label_weight = new_weight; }
+
+  /**
+   * Attach per-sample weights; the scalar loss summary stays the unweighted mean, only the
+   * gradients are weighted.
+   */
+  void set_sample_weight_tensor(const Tensor2<float>& sample_weight) override {
+    sample_weight_tensor_ = sample_weight;
+  }
+
+  float get_scaler() const { return scaler_; }
+  int get_total_gpu_count() const { return total_gpu_count_; }
 };
 
+/**
+ * Softmax cross-entropy over the feature dimension. The two-class case keeps its dedicated
+ * kernel; wider heads run a fused streaming log-sum-exp kernel that never materializes the
+ * probability tensor and expects the label to hold the target class index of each sample.
+ */
 template <typename T>
 class CrossEntropyLoss : public Loss<T> {
  public:
@@ -136,6 +160,33 @@ class CrossEntropyLoss : public Loss<T> {
                    float scaler = 1.f, bool gen_loss_summary = true);
 };
 
+/**
+ * One head of a fused multi-head BCE launch. Multi-task models instantiate one
+ * BinaryCrossEntropyLoss per head; the fused kernel walks all heads in a single pass instead of
+ * one launch each. The loss pointer targets the head's own loss tensor, so metrics (AverageLoss)
+ * keep consuming per-head scalars on the device without extra D2H syncs.
+ */
+template <typename T>
+struct FusedBCEHead {
+  T* input;
+  const float* label;
+  float* loss;
+  float label_weight;
+  int batch_size; /**< allocated batch rows; feature_dim of a BCE head is always 1 */
+};
+
+constexpr int MAX_FUSED_BCE_HEADS = 8;
+
+/**
+ * Computes losses and input gradients for all heads in one kernel. Each head's scalar loss is
+ * written to head.loss. Falls back to per-head Loss::compute() via the caller when a network has
+ * more heads than MAX_FUSED_BCE_HEADS or non-BCE losses.
+ */
+template <typename T>
+void fused_bce_compute(const std::vector<FusedBCEHead<T>>& heads, long long current_batchsize,
+                       float scaler, int total_gpu_count, float rterm, bool is_train,
+                       cudaStream_t stream);
+
 template <typename T>
 class BinaryCrossEntropyLoss : public Loss<T> {
  public:
@@ -147,6 +198,11 @@ class BinaryCrossEntropyLoss : public Loss<T> {
                          const std::shared_ptr<Regularizer<T>>& regularizer,
                          const std::shared_ptr<GPUResource>& gpu_resource, int total_gpu_count,
                          float scaler = 1.f, bool gen_loss_summary = true);
+
+  /**
+   * Descriptor of this head for fused_bce_compute().
+   */
+  FusedBCEHead<T> get_fused_head(bool is_train);
 };
 
 template <typename T>
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2021, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cuda_runtime.h>
+
+#include <common.hpp>
+#include <utils.hpp>
+#include <vector>
+
+namespace HugeCTR {
+
+/**
+ * Asynchronous D2H channel for the scalar losses Model::fit() displays
+ * (HCTR_ASYNC_LOSS_READBACK).
+ *
+ * The synchronous path (Network::get_loss) issues a cudaStreamSynchronize per display interval,
+ * stalling the training pipeline. This ring instead copies every loss scalar into a pinned slot
+ * with cudaMemcpyAsync and records an event behind the copies; the reader polls the events with
+ * cudaEventQuery and consumes the newest completed slot, so the displayed value lags by up to one
+ * display interval but the GPU is never drained.
+ */
+class LossReadbackRing {
+ public:
+  /** One device-side scalar to read back, together with the stream that produces it. */
+  struct Source {
+    const float* device_ptr;
+    cudaStream_t stream;
+    int device_id;
+  };
+
+  static constexpr int kNumSlots = 4;
+
+  explicit LossReadbackRing(const std::vector<Source>& sources) : sources_(sources) {
+    HCTR_LIB_THROW(
+        cudaMallocHost(&pinned_, kNumSlots * sources_.size() * sizeof(float)));
+    events_.resize(kNumSlots * sources_.size());
+    for (int slot = 0; slot < kNumSlots; ++slot) {
+      for (size_t s = 0; s < sources_.size(); ++s) {
+        CudaDeviceContext context(sources_[s].device_id);
+        HCTR_LIB_THROW(
+            cudaEventCreateWithFlags(&event_at(slot, s), cudaEventDisableTiming));
+      }
+    }
+  }
+
+  LossReadbackRing(const LossReadbackRing&) = delete;
+  LossReadbackRing& operator=(const LossReadbackRing&) = delete;
+
+  ~LossReadbackRing() {
+    for (auto& event : events_) {
+      cudaEventDestroy(event);
+    }
+    cudaFreeHost(pinned_);
+  }
+
+  /**
+   * Enqueues a readback of every source into the next slot. Only async calls; never blocks.
+   */
+  void push() {
+    const int slot = head_ % kNumSlots;
+    for (size_t s = 0; s < sources_.size(); ++s) {
+      CudaDeviceContext context(sources_[s].device_id);
+      HCTR_LIB_THROW(cudaMemcpyAsync(&slot_value(slot, s), sources_[s].device_ptr, sizeof(float),
+                                     cudaMemcpyDeviceToHost, sources_[s].stream));
+      HCTR_LIB_THROW(cudaEventRecord(event_at(slot, s), sources_[s].stream));
+    }
+    head_++;
+  }
+
+  /**
+   * Sum of the newest slot whose copies have all completed. Returns false and leaves *sum
+   * untouched when no pushed slot has completed yet.
+   */
+  bool latest(float* sum) {
+    const int newest = head_ - 1;
+    const int oldest = head_ > kNumSlots ? head_ - kNumSlots : 0;
+    for (int i = newest; i >= oldest; --i) {
+      const int slot = i % kNumSlots;
+      bool complete = true;
+      for (size_t s = 0; s < sources_.size() && complete; ++s) {
+        complete = (cudaEventQuery(event_at(slot, s)) == cudaSuccess);
+      }
+      if (complete) {
+        float val = 0.f;
+        for (size_t s = 0; s < sources_.size(); ++s) {
+          val += slot_value(slot, s);
+        }
+        *sum = val;
+        return true;
+      }
+    }
+    return false;
+  }
+
+ private:
+  cudaEvent_t& event_at(int slot, size_t source) {
+    return events_[slot * sources_.size() + source];
+  }
+  float& slot_value(int slot, size_t source) {
+    return pinned_[slot * sources_.size() + source];
+  }
+
+  std::vector<Source> sources_;
+  float* pinned_ = nullptr;
+  std::vector<cudaEvent_t> events_;
+  int head_ = 0;
+};
+
+}  // namespace HugeCTR
@@ -132,11 +132,9 @@ class SMAPE : public Metric {
   int n_batches_;
   int num_local_gpus_;
 
-  std::vector<float*> error_;       // Device variable
-  std::vector<int> checked_local_;  // Host variable
-  std::vector<float> error_local_;  // Host variable
-  int checked_global_;
-  float error_global_;
+  std::vector<float*> error_;          // Per-GPU running error sums, accumulated on device
+  std::vector<size_t> checked_local_;  // Per-GPU running sample counts, host variable
+  std::vector<float> error_local_;     // Host staging for the device sums at finalization
 };
 
 enum class ReallocType_t { NO_COPY, MMAP, DEFAULT };
@@ -162,6 +160,12 @@ class ReallocBuffer {
   std::vector<std::pair<CUdeviceptr, size_t>> vm_ranges_;    // Virtual allocation info
   std::vector<std::pair<CUdeviceptr, size_t>> mmap_ranges_;  // Memmap VA->PA info
 
+  // Upfront virtual address reservation. While new_size fits into it, growing the buffer only
+  // creates and maps one new physical chunk: no data copies and no remapping of existing chunks.
+  CUdeviceptr va_base_;
+  size_t va_reserved_;
+  static constexpr size_t va_reserve_default_ = 64ul * 1024 * 1024 * 1024;
+
   size_t chunk_size_;
   void get_aligned_size(size_t& size) const {
     size = ((size + chunk_size_ - 1) / chunk_size_) * chunk_size_;
@@ -314,6 +318,27 @@ class AUC : public Metric {
   const size_t num_finalize_steps_ = 3;
   const size_t num_classes_;
 
+  /*
+   * With HCTR_ASYNC_AUC set, the per-batch reduction runs on a dedicated low-priority stream
+   * and the eval stream only waits until the raw predictions and labels have been consumed,
+   * so the next eval forward pass overlaps with the metric computation.
+   */
+  bool async_local_reduce_ = false;
+  std::vector<cudaStream_t> side_streams_;
+  std::vector<cudaEvent_t> fork_events_;
+  std::vector<cudaEvent_t> join_events_;
+
+  /*
+   * With HCTR_AUC_SKETCH_BINS set, the AUC is approximated from per-GPU positive/negative
+   * prediction histograms merged with a single small all-reduce instead of redistributing
+   * every sample across the nodes; the error is bounded by the bin width.
+   */
+  bool use_sketch_ = false;
+  int sketch_num_bins_ = 0;
+  std::vector<CountType*> sketch_hist_;  // 2 * sketch_num_bins_ counters: positives, negatives
+
+  float finalize_sketch_metric(int local_id);
+
   std::shared_ptr<ResourceManager> resource_manager_;
 
   int n_batches_;
@@ -90,6 +90,43 @@ class Network {
 
   void prop_layers(const std::vector<Layer*>& layers, bool fprop, bool train);
 
+  /**
+   * Bucketed wgrad exchange (HCTR_AR_NUM_BUCKETS). The wgrad tensors live in one flat buffer
+   * in layer creation order and backward visits the layers in reverse, so after layer i's
+   * bprop every wgrad above its watermark holds its final value. train() exploits this to
+   * hand bucket-sized slices of the buffer to NCCL on a side stream while the remaining
+   * layers are still running backward, instead of one all-reduce after backward completes.
+   */
+  std::vector<size_t> train_layer_wgrad_watermarks_; /**< wgrad elements after each layer */
+  int ar_bucket_count_ = 0;
+  cudaStream_t ar_bucket_stream_ = nullptr;
+  cudaEvent_t ar_bucket_ready_event_ = nullptr;
+  cudaEvent_t ar_bucket_done_event_ = nullptr;
+
+  void bprop_bucketed_exchange(const std::vector<Layer*>& layers);
+
+  /**
+   * Gradient accumulation (HCTR_GRAD_ACCUM_STEPS). The flat wgrad buffer is overwritten by
+   * every backward pass, so the micro-batch gradients are summed into a shadow buffer of the
+   * same shape; on the last micro-batch of a step the averaged sum is written back into the
+   * wgrad buffer, and the caller runs the single all-reduce and optimizer apply on it.
+   */
+  int grad_accum_steps_ = 1;
+  bool grad_accum_pending_ = false; /**< the shadow buffer holds earlier micro-batches */
+  std::shared_ptr<GeneralBuffer2<CudaAllocator>> grad_accum_buff_;
+  Tensor2<float> wgrad_accum_tensor_;
+  Tensor2<__half> wgrad_accum_tensor_half_;
+
+  /**
+   * Fused multi-head loss (HCTR_FUSE_LOSS_HEADS). When every loss of the network is a
+   * BinaryCrossEntropyLoss, all heads' losses and input gradients are computed by one kernel
+   * instead of one launch per head; per-head scalars still land in the heads' own loss tensors
+   * for the metrics. Returns false when the losses do not qualify and the caller must take the
+   * per-head path.
+   */
+  bool fuse_loss_heads_ = false;
+  bool fused_loss_compute(bool is_train, long long current_batchsize, float rterm);
+
  public:
   /**
    * Ctor.
@@ -129,6 +166,18 @@ class Network {
    */
   float get_loss();
 
+  /**
+   * Device pointers of the train loss scalars, for the async readback ring
+   * (HCTR_ASYNC_LOSS_READBACK); get_loss() remains the synchronous path.
+   */
+  std::vector<const float*> get_train_loss_ptrs() {
+    std::vector<const float*> ptrs;
+    for (auto& loss_tensor : train_loss_tensors_) {
+      ptrs.push_back(loss_tensor.second.get_ptr());
+    }
+    return ptrs;
+  }
+
   int get_device_id() const { return gpu_resource_->get_device_id(); }
 
   std::map<std::string, metrics::RawMetricMap> get_raw_metrics_all() const;
@@ -212,6 +261,28 @@ class Network {
    */
   void exchange_wgrad();
 
+  /**
+   * Enable bucketed wgrad exchange: train() overlaps the dense gradient all-reduce with the
+   * backward pass by reducing the flat wgrad buffer in num_buckets slices as they become
+   * final. When enabled, the caller must skip its own wgrad all-reduce.
+   */
+  void enable_bucketed_wgrad_exchange(int num_buckets);
+
+  /**
+   * Allocate the gradient accumulation shadow buffer, see grad_accum_steps_.
+   */
+  void enable_grad_accumulation(int num_steps);
+
+  bool grad_accumulation_enabled() const { return grad_accum_steps_ > 1; }
+
+  /**
+   * Fold this micro-batch's wgrads into the shadow buffer; on the final micro-batch of the
+   * step, write the averaged sum back into the wgrad buffer for the exchange and the update.
+   */
+  void accumulate_wgrad(bool final_micro_batch);
+
+  bool bucketed_wgrad_exchange_enabled() const { return ar_bucket_count_ > 1; }
+
   /**
    * Update parameters.
    */
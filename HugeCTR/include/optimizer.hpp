@@ -95,11 +95,13 @@ struct OptParams {
   OptHyperParams hyperparams;
   Update_t update_type;
   float scaler;
+  bool quantized_opt_states = false; /**< Store the per-row optimizer states (Adam moments /
+                                        AdaGrad accumulators) as int8 with per-row scales. */
 
   bool operator==(const OptParams& other) const {
     return (optimizer == other.optimizer) && (lr == other.lr) &&
            (hyperparams == other.hyperparams) && (update_type == other.update_type) &&
-           (scaler == other.scaler);
+           (scaler == other.scaler) && (quantized_opt_states == other.quantized_opt_states);
   }
 
   bool operator!=(const OptParams& other) const { return !(*this == other); }
@@ -241,6 +243,36 @@ class EmbeddingOptimizer {
   Tensor2<uint32_t> hash_value_index_count_counter_tensors_; /**< The temp memory to store the
                                                                 counter of the count of hash table
                                                                 value indexes in update_params(). */
+
+  bool use_hash_aggregation_{false}; /**< Group duplicate keys through a device hash table of the
+                                        touched keys instead of radix-sorting all the pairs. */
+  size_t hash_agg_capacity_{0};      /**< Capacity (power of two) of the aggregation hash table. */
+  Tensor2<size_t> hash_agg_key_tensors_;         /**< Open-addressing table of touched keys. */
+  Tensor2<uint32_t> hash_agg_count_tensors_;     /**< Per-slot occurrence counts. */
+  Tensor2<uint32_t> hash_agg_offset_tensors_;    /**< Inclusive scan of the per-slot counts. */
+  Tensor2<uint32_t> hash_agg_entry_slot_tensors_;  /**< Hash slot of each (key, sample) pair. */
+  Tensor2<uint32_t> hash_agg_unique_slot_tensors_; /**< Non-empty slots in ascending order. */
+  Tensor2<void> temp_storage_agg_scan_tensors_;    /**< CUB temp memory for the count scan. */
+  Tensor2<void> temp_storage_agg_select_tensors_;  /**< CUB temp memory for the slot selection. */
+
+  bool use_quantized_opt_state_{false}; /**< Keep the Adam moments / AdaGrad accumulators as int8
+                                           with one fp32 scale per embedding row instead of full
+                                           TypeEmbeddingComp tensors. */
+  Tensor2<char> opt_m_quantized_tensors_;    /**< Quantized mi states (Adam). */
+  Tensor2<float> opt_m_scale_tensors_;       /**< Per-row dequantization scales of mi. */
+  Tensor2<char> opt_v_quantized_tensors_;    /**< Quantized vi states (Adam). */
+  Tensor2<float> opt_v_scale_tensors_;       /**< Per-row dequantization scales of vi. */
+  Tensor2<char> opt_accm_quantized_tensors_; /**< Quantized accumulators (AdaGrad). */
+  Tensor2<float> opt_accm_scale_tensors_;    /**< Per-row dequantization scales of the
+                                                accumulators. */
+
+  size_t delayed_update_interval_{0}; /**< Fold the accumulated wgrads into the embedding table
+                                         every this many steps; 0 means updating the table every
+                                         step as usual. */
+  size_t delayed_update_step_{0};     /**< Steps accumulated since the last fold. */
+  Tensor2<float> wgrad_delta_tensors_; /**< The per-row delta buffer the scaled wgrads are
+                                          accumulated into between folds. */
+
   SparseEmbeddingHashParams& param;
 
  public:
@@ -24,6 +24,7 @@ namespace HugeCTR {
 
 class Scheduleable {
  protected:
+  std::string name_;
   std::optional<std::string> stream_name_;
   int priority_;
   bool is_absolute_stream_;
@@ -31,10 +32,16 @@ class Scheduleable {
   bool wait_external_;
   std::optional<cudaEvent_t> completion_event_;
   bool record_external_;
+  std::vector<const void *> reads_;
+  std::vector<const void *> writes_;
 
  public:
   explicit Scheduleable();
 
+  /** Names the stage in the pipeline profiler report; unnamed stages get an index-based name. */
+  void set_name(const std::string &name) { name_ = name; }
+  const std::string &get_name() const { return name_; }
+
   void set_absolute_stream(const std::string &stream_name, int priority = 0);
 
   void set_stream(const std::string &stream_name, int priority = 0);
@@ -43,9 +50,43 @@ class Scheduleable {
 
   cudaEvent_t record_done(bool external = false, unsigned int flags = cudaEventDisableTiming);
 
+  /**
+   * Declares which buffers this scheduleable reads and writes, so auto_schedule() can infer
+   * the event dependencies and the stream assignment instead of having them hand-crafted.
+   * Any stable address identifying the data works as a key, e.g. the tensor buffer pointer.
+   */
+  void declare_access(const std::vector<const void *> &reads,
+                      const std::vector<const void *> &writes);
+
+  const std::vector<const void *> &get_reads() const { return reads_; }
+  const std::vector<const void *> &get_writes() const { return writes_; }
+
   virtual void run(std::shared_ptr<GPUResource> gpu, bool use_graph, bool prepare_resource) = 0;
 };
 
+/**
+ * The dependency graph and the stream assignment inferred from the declared read and write
+ * sets of an ordered list of scheduleables. wait_on holds, per scheduleable, the indices of
+ * the producers it must wait for after transitive reduction.
+ */
+struct InferredSchedule {
+  std::vector<int> stream_id;
+  std::vector<std::vector<size_t>> wait_on;
+};
+
+InferredSchedule infer_schedule(const std::vector<std::vector<const void *>> &reads,
+                                const std::vector<std::vector<const void *>> &writes,
+                                size_t max_streams = 4);
+
+/**
+ * Infers the minimal event graph from the access sets declared with declare_access() and
+ * applies it: dependency chains stay on one stream, independent chains are spread over up to
+ * max_streams streams, and only cross-stream dependencies become event waits. The first
+ * stream is the calling stream, so a fully serial list schedules exactly like before.
+ */
+void auto_schedule(const std::vector<std::shared_ptr<Scheduleable>> &scheduleable_list,
+                   size_t max_streams = 4);
+
 class StreamContextScheduleable : public Scheduleable {
  private:
   std::function<void()> workload_;
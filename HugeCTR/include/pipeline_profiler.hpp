@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2021, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <cuda_runtime.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace HugeCTR {
+
+/**
+ * Lightweight iteration-time profiler (HCTR_PROFILE_PIPELINE). Every scheduleable brackets its
+ * launches with a pair of CUDA events on its own stream; completed pairs are harvested lazily
+ * with cudaEventQuery, so the pipeline is never blocked for a timing readout. The per-stage
+ * GPU-time distributions (count/avg/p50/p99/max) are exposed through
+ * Model::get_pipeline_profile() and can be dumped as JSON for offline regression hunting.
+ * The cuda-graph path replays a pre-captured graph and is not instrumented.
+ */
+class PipelineProfiler {
+ public:
+  static PipelineProfiler& get();
+
+  bool enabled() const { return enabled_; }
+
+  /**
+   * Records the start event of one stage execution on the given stream. Returns an opaque
+   * handle to pass to end_stage, or NULL when profiling is disabled.
+   */
+  void* begin_stage(const std::string& name, int device_id, cudaStream_t stream);
+  void end_stage(void* handle, cudaStream_t stream);
+
+  /** One entry per (stage, device) with count, avg_ms, p50_ms, p99_ms and max_ms. */
+  std::string report_json();
+  void dump_json(const std::string& path);
+  void reset();
+
+  PipelineProfiler(const PipelineProfiler&) = delete;
+  PipelineProfiler& operator=(const PipelineProfiler&) = delete;
+
+ private:
+  PipelineProfiler();
+  ~PipelineProfiler();
+
+  struct StageStats {
+    std::vector<std::pair<cudaEvent_t, cudaEvent_t>> free_pairs_;
+    std::vector<std::pair<cudaEvent_t, cudaEvent_t>> inflight_pairs_;
+    std::vector<float> samples_ms_;
+    size_t next_sample_ = 0;  // ring index once the sample cap is reached
+    int device_id_ = 0;
+  };
+
+  struct Handle {
+    StageStats* stats;
+    std::pair<cudaEvent_t, cudaEvent_t> events;
+  };
+
+  // Reads out the event pairs that already completed without blocking on the pending ones.
+  void harvest(StageStats& stats);
+
+  bool enabled_ = false;
+  std::mutex mutex_;
+  std::map<std::string, StageStats> stages_;
+};
+}  // namespace HugeCTR
@@ -16,6 +16,7 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
+#include <HugeCTR/include/base/debug/perf_counters.hpp>
 #include <HugeCTR/include/collectives/all_reduce_comm.hpp>
 #include <HugeCTR/include/common.hpp>
 #include <HugeCTR/include/device_map.hpp>
@@ -32,6 +33,12 @@ void CommonPybind(pybind11::module& m) {
   m.attr("__version__") = std::to_string(HUGECTR_VERSION_MAJOR) + "." +
                           std::to_string(HUGECTR_VERSION_MINOR) + "." +
                           std::to_string(HUGECTR_VERSION_PATCH);
+  m.def(
+      "get_perf_counters", []() { return PerfCounters::get().snapshot(); },
+      "Snapshot of the process-wide performance counter registry as a dict.");
+  m.def(
+      "get_perf_counters_prometheus", []() { return PerfCounters::get().to_prometheus(); },
+      "All performance counters rendered in the Prometheus text exposition format.");
   pybind11::enum_<HugeCTR::Error_t>(m, "Error_t")
       .value("Success", HugeCTR::Error_t::Success)
       .value("FileCannotOpen", HugeCTR::Error_t::FileCannotOpen)
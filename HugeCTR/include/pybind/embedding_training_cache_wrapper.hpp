@@ -147,6 +147,13 @@ void EmbeddingTrainingCachePybind(pybind11::module& m) {
       .def("update",
            pybind11::overload_cast<std::vector<std::string>&>(
                &HugeCTR::EmbeddingTrainingCache::update),
+           pybind11::arg("keyset_file_list"))
+      .def("prefetch",
+           pybind11::overload_cast<std::string&>(&HugeCTR::EmbeddingTrainingCache::prefetch),
+           pybind11::arg("keyset_file"))
+      .def("prefetch",
+           pybind11::overload_cast<std::vector<std::string>&>(
+               &HugeCTR::EmbeddingTrainingCache::prefetch),
            pybind11::arg("keyset_file_list"));
 }
 
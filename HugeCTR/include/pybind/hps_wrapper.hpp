@@ -21,8 +21,10 @@
 
 #include <hps/embedding_cache.hpp>
 #include <hps/hier_parameter_server.hpp>
+#include <hps/key_compactor.hpp>
 #include <hps/lookup_session.hpp>
 #include <pybind/hpsconversion.hpp>
+#include <pybind/pinned_buffer_pool.hpp>
 
 namespace HugeCTR {
 
@@ -49,6 +51,8 @@ class HPS {
                                   size_t table_id, int64_t device_id);
   void lookup_fromdlpack(pybind11::capsule& h_keys, pybind11::capsule& out_tensor,
                          const std::string& model_name, size_t table_id, int64_t device_id);
+  void insert_fromdlpack(pybind11::capsule& keys, pybind11::capsule& vectors,
+                         const std::string& model_name, size_t table_id);
 
  private:
   void initialize();
@@ -177,10 +181,16 @@ void HPS::lookup_fromdlpack(pybind11::capsule& h_keys, pybind11::capsule& vector
 
   // TODO: batching or scheduling for lookup sessions on multiple GPUs
   const auto& lookup_session = lookup_session_map_.find(model_name)->second.find(device_id)->second;
+  float* vec_ptr = static_cast<float*>(hps_vet.data);
+  if (hps_vet.device == DeviceType::CUDA && hps_vet.device_id == device_id) {
+    // Zero-copy fast path: the output tensor already lives on the lookup device, so gather
+    // directly into it instead of staging in d_vectors_per_table and copying device-to-device.
+    lookup_session->lookup(key_ptr, vec_ptr, num_keys, table_id);
+    return;
+  }
   auto& d_vectors_per_table =
       d_vectors_per_table_map_.find(model_name)->second.find(device_id)->second;
   lookup_session->lookup(key_ptr, d_vectors_per_table[table_id], num_keys, table_id);
-  float* vec_ptr = static_cast<float*>(hps_vet.data);
   if (hps_vet.device == DeviceType::CPU) {
     HCTR_LIB_THROW(cudaMemcpy(vec_ptr, d_vectors_per_table[table_id],
                               num_keys * embedding_size_per_table[table_id] * sizeof(float),
@@ -191,6 +201,74 @@ void HPS::lookup_fromdlpack(pybind11::capsule& h_keys, pybind11::capsule& vector
                               cudaMemcpyDeviceToDevice));
   }
 }
+void HPS::insert_fromdlpack(pybind11::capsule& keys, pybind11::capsule& vectors,
+                            const std::string& model_name, size_t table_id) {
+  HPSTensor hps_key = fromDLPack(keys);
+  size_t num_keys = *(reinterpret_cast<size_t*>(hps_key.shape));
+  HPSTensor hps_vec = fromDLPack(vectors);
+  size_t num_elements = 1;
+  for (int32_t i = 0; i < hps_vec.ndim; ++i) {
+    num_elements *= static_cast<size_t>(hps_vec.shape[i]);
+  }
+
+  if (lookup_session_map_.find(model_name) == lookup_session_map_.end()) {
+    HCTR_OWN_THROW(Error_t::WrongInput, "The model name does not exist in HPS.");
+  }
+  const auto& embedding_size_per_table = ps_config_.embedding_vec_size_.at(model_name);
+  const size_t embedding_vec_size = embedding_size_per_table[table_id];
+  const std::string& table_name = ps_config_.emb_table_name_.at(model_name).at(table_id);
+  const auto& inference_params =
+      parameter_server_->get_hps_model_configuration_map().at(model_name);
+
+  HCTR_THROW_IF(hps_key.type != DataType::Int64, HugeCTR::Error_t::DataCheckError,
+                "insert_fromdlpack expects int64 embedding keys");
+  HCTR_THROW_IF(hps_vec.type != DataType::Float, HugeCTR::Error_t::DataCheckError,
+                "insert_fromdlpack expects float32 embedding vectors");
+  HCTR_THROW_IF(num_elements != num_keys * embedding_vec_size, HugeCTR::Error_t::DataCheckError,
+                "The number of vector elements should be equal to "
+                "embedding vector size * number of embedding keys");
+
+  // Host tensors are handed to the databases' batched insert as-is. Device tensors are staged
+  // through one pooled pinned buffer each: the databases consume host memory, so a single
+  // full-bandwidth D2H copy is the minimum.
+  std::unique_ptr<void, void (*)(void*)> staged_keys(
+      nullptr, [](void* p) { PinnedBufferPool::get().release(p); });
+  std::unique_ptr<void, void (*)(void*)> staged_vectors(
+      nullptr, [](void* p) { PinnedBufferPool::get().release(p); });
+  const void* key_ptr = hps_key.data;
+  if (hps_key.device == DeviceType::CUDA) {
+    CudaDeviceContext context(hps_key.device_id);
+    staged_keys.reset(PinnedBufferPool::get().acquire(num_keys * sizeof(long long)));
+    HCTR_LIB_THROW(cudaMemcpy(staged_keys.get(), hps_key.data, num_keys * sizeof(long long),
+                              cudaMemcpyDeviceToHost));
+    key_ptr = staged_keys.get();
+  }
+  const float* vec_ptr = static_cast<const float*>(hps_vec.data);
+  if (hps_vec.device == DeviceType::CUDA) {
+    CudaDeviceContext context(hps_vec.device_id);
+    staged_vectors.reset(PinnedBufferPool::get().acquire(num_elements * sizeof(float)));
+    HCTR_LIB_THROW(cudaMemcpy(staged_vectors.get(), hps_vec.data, num_elements * sizeof(float),
+                              cudaMemcpyDeviceToHost));
+    vec_ptr = static_cast<const float*>(staged_vectors.get());
+  }
+
+  // Handle both keys of both long long and unsigned int
+  size_t key_size_bytes = sizeof(long long);
+  std::vector<unsigned int> narrowed_keys;
+  if (!inference_params.i64_input_key) {
+    narrowed_keys.resize(num_keys);
+    const long long* key_in = static_cast<const long long*>(key_ptr);
+    for (size_t i{0}; i < num_keys; ++i) {
+      narrowed_keys[i] = static_cast<unsigned int>(key_in[i]);
+    }
+    key_ptr = narrowed_keys.data();
+    key_size_bytes = sizeof(unsigned int);
+  }
+
+  parameter_server_->ingest_model_table(model_name, table_name, num_keys, key_ptr, key_size_bytes,
+                                        vec_ptr, embedding_vec_size);
+}
+
 pybind11::array_t<float> HPS::lookup(pybind11::array_t<size_t>& h_keys,
                                      const std::string& model_name, size_t table_id,
                                      int64_t device_id) {
@@ -212,8 +290,14 @@ pybind11::array_t<float> HPS::lookup(pybind11::array_t<size_t>& h_keys,
 
   // Handle both keys of both long long and unsigned int
   void* key_ptr;
+  std::unique_ptr<void, void (*)(void*)> pinned_keys(
+      nullptr, [](void* p) { PinnedBufferPool::get().release(p); });
   if (inference_params.i64_input_key) {
-    key_ptr = static_cast<void*>(key_buf.ptr);
+    // Stage the keys in a pooled pinned buffer: like the unsigned int path below, this keeps
+    // the H2D copy inside the lookup session at full bandwidth
+    pinned_keys.reset(PinnedBufferPool::get().acquire(num_keys * sizeof(size_t)));
+    std::memcpy(pinned_keys.get(), key_buf.ptr, num_keys * sizeof(size_t));
+    key_ptr = pinned_keys.get();
   } else {
     unsigned int* h_keys = h_keys_per_table_map_.find(model_name)->second[table_id];
     auto transform = [](unsigned int* out, long long* in, size_t count) {
@@ -232,7 +316,9 @@ pybind11::array_t<float> HPS::lookup(pybind11::array_t<size_t>& h_keys,
   lookup_session->lookup(key_ptr, d_vectors_per_table[table_id], num_keys, table_id);
   std::vector<size_t> vector_shape{static_cast<size_t>(key_buf.shape[0]),
                                    embedding_size_per_table[table_id]};
-  pybind11::array_t<float> h_vectors(vector_shape);
+  // Pinned output array so the D2H copy below runs at full bandwidth; the buffer is recycled
+  // through the pool once the array is garbage-collected on the python side
+  pybind11::array_t<float> h_vectors = make_pinned_array<float>(vector_shape);
   pybind11::buffer_info vector_buf = h_vectors.request();
   float* vec_ptr = static_cast<float*>(vector_buf.ptr);
   HCTR_LIB_THROW(cudaMemcpy(vec_ptr, d_vectors_per_table[table_id],
@@ -244,6 +330,10 @@ pybind11::array_t<float> HPS::lookup(pybind11::array_t<size_t>& h_keys,
 void HPSPybind(pybind11::module& m) {
   pybind11::module infer = m.def_submodule("inference", "inference submodule of hugectr");
 
+  infer.def("compact_key_32", &HugeCTR::compact_key_32, pybind11::arg("key"),
+            "Map a 64-bit key to the 32-bit id used by uint32-keyed parameter servers; apply to "
+            "query keys of models whose key files exceed the 32-bit range");
+
   pybind11::class_<HugeCTR::parameter_server_config,
                    std::shared_ptr<HugeCTR::parameter_server_config>>(infer,
                                                                       "ParameterServerConfig")
@@ -267,7 +357,10 @@ void HPSPybind(pybind11::module& m) {
            pybind11::arg("model_name"), pybind11::arg("table_id"), pybind11::arg("device_id") = 0)
       .def("lookup_fromdlpack", &HugeCTR::python_lib::HPS::lookup_fromdlpack,
            pybind11::arg("h_keys"), pybind11::arg("out_tensor"), pybind11::arg("model_name"),
-           pybind11::arg("table_id"), pybind11::arg("device_id") = 0);
+           pybind11::arg("table_id"), pybind11::arg("device_id") = 0)
+      .def("insert_fromdlpack", &HugeCTR::python_lib::HPS::insert_fromdlpack,
+           pybind11::arg("keys"), pybind11::arg("vectors"), pybind11::arg("model_name"),
+           pybind11::arg("table_id"));
 }
 
 }  // namespace python_lib
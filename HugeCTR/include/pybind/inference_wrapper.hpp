@@ -22,6 +22,7 @@
 #include <hps/hier_parameter_server.hpp>
 #include <inference/inference_session.hpp>
 #include <pybind/inference_model.hpp>
+#include <pybind/pinned_buffer_pool.hpp>
 #include <utils.hpp>
 
 namespace HugeCTR {
@@ -340,7 +341,9 @@ pybind11::array_t<float> InferenceSessionPy::predict_(const size_t num_batches,
   } else {
     pred_size = {inference_params_.max_batchsize * num_batches, inference_parser_.label_dim};
   }
-  auto pred = pybind11::array_t<float>(pred_size);
+  // Pinned prediction array: the per-batch D2H copies below can then actually run
+  // asynchronously on the stream instead of degrading to staged pageable copies
+  auto pred = make_pinned_array<float>(pred_size);
   pybind11::buffer_info pred_array_buff = pred.request();
   float* pred_ptr = static_cast<float*>(pred_array_buff.ptr);
   size_t pred_ptr_offset = 0;
@@ -445,7 +448,7 @@ void InferencePybind(pybind11::module& m) {
                           const std::string&, const std::string&, const std::string&, size_t,
                           size_t, size_t, size_t,
                           // Overflow handling related.
-                          bool, size_t, DatabaseOverflowPolicy_t, double,
+                          bool, size_t, DatabaseOverflowPolicy_t, double, size_t,
                           // Caching behavior related.
                           double, bool,
                           // Real-time update mechanism related.
@@ -463,6 +466,7 @@ void InferencePybind(pybind11::module& m) {
            pybind11::arg("overflow_margin") = std::numeric_limits<size_t>::max(),
            pybind11::arg("overflow_policy") = DatabaseOverflowPolicy_t::EvictOldest,
            pybind11::arg("overflow_resolution_target") = 0.8,
+           pybind11::arg("expiry_seconds") = 0,
            // Caching behavior related.
            pybind11::arg("initial_cache_rate") = 1.0,
            pybind11::arg("cache_missed_embeddings") = false,
@@ -24,6 +24,7 @@
 #include <hps/message.hpp>
 #include <io/filesystem.hpp>
 #include <loss.hpp>
+#include <loss_readback_ring.hpp>
 #include <metrics.hpp>
 #include <network.hpp>
 #include <optimizer.hpp>
@@ -160,18 +161,21 @@ struct DataReaderParams {
   std::vector<long long int> slot_size_array;
   DataSourceParams data_source_params;
   AsyncParam async_param;
+  bool numa_pinning;
   DataReaderParams(DataReaderType_t data_reader_type, std::string source, std::string keyset,
                    std::string eval_source, Check_t check_type, int cache_eval_data,
                    long long num_samples, long long eval_num_samples, bool float_label_dense,
                    bool read_file_sequentially, int num_workers,
                    std::vector<long long>& slot_size_array,
-                   const DataSourceParams& data_source_params, const AsyncParam& async_param);
+                   const DataSourceParams& data_source_params, const AsyncParam& async_param,
+                   bool numa_pinning = true);
   DataReaderParams(DataReaderType_t data_reader_type, std::vector<std::string> source,
                    std::vector<std::string> keyset, std::string eval_source, Check_t check_type,
                    int cache_eval_data, long long num_samples, long long eval_num_samples,
                    bool float_label_dense, bool read_file_sequentially, int num_workers,
                    std::vector<long long>& slot_size_array,
-                   const DataSourceParams& data_source_params, const AsyncParam& async_param);
+                   const DataSourceParams& data_source_params, const AsyncParam& async_param,
+                   bool numa_pinning = true);
 };
 
 struct Input {
@@ -376,6 +380,8 @@ class Model {
 
   virtual void compile(std::vector<std::string>& label_names, std::vector<float>& label_weights);
 
+  void set_gemm_algo_cache(const std::string& cache_file);
+
   void update_label_weights(std::vector<std::string>& label_names,
                             std::vector<float>& label_weights);
 
@@ -395,8 +401,25 @@ class Model {
 
   std::vector<std::pair<std::string, float>> get_eval_metrics();
 
+  /**
+   * Per-stage GPU-time report of the train and eval pipelines as a JSON string, collected by
+   * the pipeline profiler (HCTR_PROFILE_PIPELINE). Empty distributions are omitted.
+   */
+  std::string get_pipeline_profile();
+
+  /** Writes the report of get_pipeline_profile() to a file. */
+  void dump_pipeline_profile(const std::string& profile_file);
+
   Error_t get_current_loss(float* loss);
 
+  /**
+   * Loss value for the display log. With HCTR_ASYNC_LOSS_READBACK set, the value comes from a
+   * pinned ring buffer filled by cudaMemcpyAsync and polled via events, so displaying never
+   * synchronizes the training streams; the reported loss lags by up to one display interval.
+   * Otherwise falls through to get_current_loss().
+   */
+  Error_t get_display_loss(float* loss);
+
   Error_t download_params_to_files(std::string prefix, int iter);
 
   Error_t export_predictions(const std::string& output_prediction_file_name,
@@ -512,6 +535,14 @@ class Model {
   void unfreeze_dense() { is_dense_trainable_ = true; };
   std::vector<std::pair<std::vector<long long>, std::vector<float>>>& get_incremental_model();
   void dump_incremental_model_2kafka();
+  /**
+   * Streams the trained embedding tables of this process straight into a standing hierarchical
+   * parameter server, skipping the sparse-model-file dump and reload that a checkpoint-based
+   * serving handoff would require. The model must already be registered with the parameter
+   * server under solver.model_name. With multiple nodes, every rank ingests the shard resident
+   * on its local GPUs.
+   */
+  void export_params_to_hps(const std::shared_ptr<HierParameterServerBase>& hps_ps);
 
  protected:
   Solver solver_;
@@ -521,6 +552,9 @@ class Model {
   std::shared_ptr<EmbeddingTrainingCacheParams> etc_params_;
   std::vector<std::shared_ptr<OptParamsPy>> embedding_opt_params_list_;
   std::shared_ptr<MessageSink<long long>> message_sink_;
+  size_t kafka_sync_interval_{0}; /**< Iterations between incremental publications; 0 = off. */
+  /** Pinned ring for async loss display (HCTR_ASYNC_LOSS_READBACK); null = sync readback. */
+  std::unique_ptr<LossReadbackRing> loss_readback_ring_;
   std::shared_ptr<LearningRateScheduler> lr_sch_;
   GpuLearningRateSchedulers gpu_lr_sches_;
 
@@ -533,9 +567,20 @@ class Model {
   std::map<std::string, float> label_weights_;
 
   bool overflow_check_{true};
+  /**
+   * Gradient accumulation (HCTR_GRAD_ACCUM_STEPS): every train() call runs one micro-batch and
+   * only every N-th call exchanges the dense wgrads and applies the optimizer, emulating an
+   * N-times larger batch. Embedding updates stay per micro-batch with their gradients scaled
+   * down by N (exact for SGD, the embedding default).
+   */
+  int grad_accum_steps_{1};
+  size_t grad_accum_iter_{0}; /**< micro-batches folded into the current step so far */
   bool data_reader_train_status_;
   bool data_reader_eval_status_;
   bool buff_allocated_;
+  // compile() ran only its validation phase (HCTR_LAZY_COMPILE); the GPU buffers
+  // materialize lazily at the first fit() or weight/optimizer-state load.
+  bool compile_deferred_{false};
   bool etc_created_;
   bool is_dense_trainable_;
   std::vector<std::shared_ptr<GeneralBuffer2<CudaAllocator>>> blobs_buff_list_;
@@ -629,8 +674,15 @@ class Model {
       const std::vector<std::string>& sparse_embedding_files,
       const std::vector<std::string>& local_paths,
       const std::vector<HMemCacheConfig>& hmem_cache_configs);
+  // Heavy half of compile(): buffer allocation, layer initialization, parameter init and
+  // pipeline creation. Runs inside compile() normally; with HCTR_LAZY_COMPILE it is deferred
+  // until the first fit() or load call so config iteration only pays the validation cost.
+  void materialize_compile_();
+  template <typename TypeKey>
+  void export_params_to_hps_(const std::shared_ptr<HierParameterServerBase>& hps_ps);
   void init_params_for_dense_();
   void init_params_for_sparse_();
+  void publish_incremental_updates_2kafka_();
   void init_embedding_training_cache_(const std::vector<TrainPSType_t>& ps_types,
                                       const std::vector<std::string>& sparse_embedding_files,
                                       const std::vector<std::string>& local_paths,
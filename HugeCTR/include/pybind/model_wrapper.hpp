@@ -29,7 +29,7 @@ void ModelPybind(pybind11::module &m) {
       m, "DataReaderParams")
       .def(pybind11::init<DataReaderType_t, std::string, std::string, std::string, Check_t, int,
                           long long, long long, bool, bool, int, std::vector<long long> &,
-                          const DataSourceParams &, const AsyncParam &>(),
+                          const DataSourceParams &, const AsyncParam &, bool>(),
            pybind11::arg("data_reader_type"), pybind11::arg("source"), pybind11::arg("keyset") = "",
            pybind11::arg("eval_source"), pybind11::arg("check_type"),
            pybind11::arg("cache_eval_data") = 0, pybind11::arg("num_samples") = 0,
@@ -38,10 +38,12 @@ void ModelPybind(pybind11::module &m) {
            pybind11::arg("slot_size_array") = std::vector<long long>(),
            pybind11::arg("data_source_params") = new DataSourceParams(),
            pybind11::arg("async_param") =
-               AsyncParam{16, 4, 512000, 4, 512, false, Alignment_t::None})
+               AsyncParam{16, 4, 512000, 4, 512, false, Alignment_t::None},
+           pybind11::arg("numa_pinning") = true)
       .def(pybind11::init<DataReaderType_t, std::vector<std::string>, std::vector<std::string>,
                           std::string, Check_t, int, long long, long long, bool, bool, int,
-                          std::vector<long long> &, const DataSourceParams &, const AsyncParam &>(),
+                          std::vector<long long> &, const DataSourceParams &, const AsyncParam &,
+                          bool>(),
            pybind11::arg("data_reader_type"), pybind11::arg("source"),
            pybind11::arg("keyset") = std::vector<std::string>(), pybind11::arg("eval_source"),
            pybind11::arg("check_type"), pybind11::arg("cache_eval_data") = 0,
@@ -51,7 +53,8 @@ void ModelPybind(pybind11::module &m) {
            pybind11::arg("slot_size_array") = std::vector<long long>(),
            pybind11::arg("data_source_params") = new DataSourceParams(),
            pybind11::arg("async_param") =
-               AsyncParam{16, 4, 512000, 4, 512, false, Alignment_t::None});
+               AsyncParam{16, 4, 512000, 4, 512, false, Alignment_t::None},
+           pybind11::arg("numa_pinning") = true);
   pybind11::class_<HugeCTR::Input, std::shared_ptr<HugeCTR::Input>>(m, "Input")
       .def(pybind11::init<int, std::string, int, std::string,
                           std::vector<DataReaderSparseParam> &>(),
@@ -128,6 +131,8 @@ void ModelPybind(pybind11::module &m) {
            pybind11::overload_cast<std::vector<std::string> &, std::vector<float> &>(
                &HugeCTR::Model::compile),
            pybind11::arg("loss_names"), pybind11::arg("loss_weights"))
+      .def("set_gemm_algo_cache", &HugeCTR::Model::set_gemm_algo_cache,
+           pybind11::arg("cache_file"))
       .def("summary", &HugeCTR::Model::summary)
       .def("fit", &HugeCTR::Model::fit, pybind11::arg("num_epochs") = 0,
            pybind11::arg("max_iter") = 2000, pybind11::arg("display") = 200,
@@ -198,6 +203,9 @@ void ModelPybind(pybind11::module &m) {
              return loss;
            })
       .def("get_eval_metrics", &HugeCTR::Model::get_eval_metrics)
+      .def("get_pipeline_profile", &HugeCTR::Model::get_pipeline_profile)
+      .def("dump_pipeline_profile", &HugeCTR::Model::dump_pipeline_profile,
+           pybind11::arg("profile_file"))
       .def("get_incremental_model",
            [](HugeCTR::Model &self) {
              auto inc_sparse_model = self.get_incremental_model();
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2021, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+#include <HugeCTR/include/general_buffer2.hpp>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace HugeCTR {
+
+namespace python_lib {
+
+/**
+ * @brief Recycling pool of pinned host buffers for the python bindings
+ *
+ * Arrays crossing the python boundary are plain pageable numpy allocations, so every transfer
+ * they feed goes through the driver's internal staging buffer at roughly half bandwidth. The
+ * pool hands out pinned blocks instead: acquire() reuses the smallest released block that fits
+ * and only falls back to cudaHostAlloc when none does. Buffers handed to python are wrapped in
+ * a capsule that releases them back to the pool when the numpy array is garbage-collected.
+ */
+class PinnedBufferPool {
+ public:
+  static PinnedBufferPool& get() {
+    static PinnedBufferPool pool;
+    return pool;
+  }
+
+  void* acquire(size_t size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto best = free_blocks_.end();
+    for (auto it = free_blocks_.begin(); it != free_blocks_.end(); ++it) {
+      if (it->second >= size && (best == free_blocks_.end() || it->second < best->second)) {
+        best = it;
+      }
+    }
+    void* ptr;
+    if (best != free_blocks_.end()) {
+      ptr = best->first;
+      used_blocks_.emplace(ptr, best->second);
+      free_blocks_.erase(best);
+    } else {
+      ptr = allocator_.allocate(size);
+      used_blocks_.emplace(ptr, size);
+    }
+    return ptr;
+  }
+
+  void release(void* ptr) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = used_blocks_.find(ptr);
+    HCTR_CHECK_HINT(it != used_blocks_.end(), "Released buffer does not belong to the pool");
+    free_blocks_.emplace_back(it->first, it->second);
+    used_blocks_.erase(it);
+  }
+
+  PinnedBufferPool(PinnedBufferPool const&) = delete;
+  PinnedBufferPool& operator=(PinnedBufferPool const&) = delete;
+
+ private:
+  PinnedBufferPool() {}
+  // The blocks are intentionally not freed at process teardown: capsules of long-lived python
+  // arrays can outlive the CUDA context and calling cudaFreeHost then would fail.
+  ~PinnedBufferPool() {}
+
+  CudaHostAllocator allocator_;
+  std::mutex mutex_;
+  std::vector<std::pair<void*, size_t>> free_blocks_;
+  std::unordered_map<void*, size_t> used_blocks_;
+};
+
+/**
+ * @brief Allocate a numpy array backed by a pooled pinned buffer
+ *
+ * The buffer returns to the pool once the array is garbage-collected on the python side.
+ */
+template <typename T>
+pybind11::array_t<T> make_pinned_array(const std::vector<size_t>& shape) {
+  size_t num_elements = 1;
+  for (auto dim : shape) {
+    num_elements *= dim;
+  }
+  T* ptr = static_cast<T*>(PinnedBufferPool::get().acquire(num_elements * sizeof(T)));
+  auto capsule = pybind11::capsule(ptr, [](void* p) { PinnedBufferPool::get().release(p); });
+  return pybind11::array_t<T>(shape, ptr, capsule);
+}
+
+void PinnedBufferPoolPybind(pybind11::module& m) {
+  // Copy an array into a pooled pinned buffer so that feeding it to the lookup / prediction
+  // apis transfers at full H2D bandwidth. The pinned copy is recycled like any pooled array.
+  m.def(
+      "pin_numpy_array",
+      [](pybind11::array array) {
+        HCTR_CHECK_HINT((array.flags() & pybind11::array::c_style) != 0,
+                        "pin_numpy_array requires a C-contiguous array");
+        void* ptr = PinnedBufferPool::get().acquire(array.nbytes());
+        std::memcpy(ptr, array.data(), array.nbytes());
+        auto capsule = pybind11::capsule(ptr, [](void* p) { PinnedBufferPool::get().release(p); });
+        return pybind11::array(array.dtype(),
+                               std::vector<ssize_t>(array.shape(), array.shape() + array.ndim()),
+                               ptr, capsule);
+      },
+      pybind11::arg("array"));
+}
+
+}  // namespace python_lib
+
+}  // namespace HugeCTR
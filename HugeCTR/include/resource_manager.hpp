@@ -102,5 +102,12 @@ class ResourceManager : public ResourceManagerBase {
 #endif
   virtual void set_ar_comm(AllReduceAlgo algo, bool use_mixed_precision) = 0;
   virtual AllReduceInPlaceComm* get_ar_comm() const = 0;
+  /**
+   * Create side NCCL communicators so that the collectives of independent embedding table groups
+   * are not serialized inside the shared per-GPU communicator. The created count is capped
+   * (HCTR_EMB_COMM_GROUPS, default 2) since every communicator schedules its own SM channels;
+   * groups beyond the cap share communicators round-robin.
+   */
+  virtual void create_embedding_comm_groups(size_t num_groups) = 0;
 };
 }  // namespace HugeCTR
@@ -129,5 +129,8 @@ class ResourceManagerCore : public ResourceManager {
     HCTR_OWN_THROW(Error_t::IllegalCall, "Error: should not be reached");
     return nullptr;
   }
+  void create_embedding_comm_groups(size_t num_groups) override {
+    HCTR_OWN_THROW(Error_t::IllegalCall, "Error: should not be reached");
+  }
 };
 }  // namespace HugeCTR
@@ -108,5 +108,6 @@ class ResourceManagerExt : public ResourceManager {
 #endif
   void set_ar_comm(AllReduceAlgo algo, bool use_mixed_precision) override;
   AllReduceInPlaceComm* get_ar_comm() const override { return ar_comm_.get(); }
+  void create_embedding_comm_groups(size_t num_groups) override;
 };
 }  // namespace HugeCTR
@@ -48,6 +48,11 @@ class SchedulableEmbeding : public IEmbedding {
 
   virtual void assign_input_tensors(bool is_train, size_t batch_size, size_t inflight_id,
                                     bool cached) = 0;
+  /**
+   * @brief Optionally launch the index calculation of the assigned batch on a side stream ahead
+   * of the pipeline, so that index_calculation() only consumes the result. No-op by default.
+   */
+  virtual void precompute_indices(bool is_train) {}
   virtual void index_calculation(bool is_train, int i) = 0;
   virtual void freq_forward(bool is_train, int i, bool is_first_eval_batch = true) = 0;
   virtual void freq_backward(int i) = 0;
@@ -29,6 +29,12 @@ struct DefaultArbitrary {
   constexpr static bool Aligned = false;
   constexpr static dim3 block{32, 8, 1};
 };
+// For elements no larger than one vector: one thread per element instead of one thread group
+struct DefaultSmall {
+  using VecType = int4;
+  constexpr static bool Aligned = false;
+  constexpr static dim3 block{256, 1, 1};
+};
 
 }  // namespace ShuffleConfigs
 }  // namespace HugeCTR
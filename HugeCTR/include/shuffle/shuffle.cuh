@@ -179,6 +179,35 @@ __global__ void arbitrary(CopyDesc copy_desc) {
   }
 }
 
+template <typename Config, typename CopyDesc>
+__global__ void small(CopyDesc copy_desc) {
+  // Grid  ( arbitrary, 1, 1 )
+  // Block ( arbitrary, 1, 1 )
+
+  using DstT = typename CopyDesc::DstT;
+  constexpr int ndests = CopyDesc::ndests;
+
+  const size_t num_elems = copy_desc.src_buf_size();
+  const int num_dimensions = copy_desc.num_dimensions();
+
+  // One thread per element: a row of a few bytes fits in registers, and adjacent threads
+  // reading adjacent rows keep the accesses coalesced, so neither the per-element thread
+  // groups nor the shared-memory staging of the generic kernels pay off here.
+  for (size_t src_id = (size_t)blockIdx.x * blockDim.x + threadIdx.x; src_id < num_elems;
+       src_id += (size_t)gridDim.x * blockDim.x) {
+    auto copy_details = copy_desc.get_details(src_id);
+    for (int i = 0; i < num_dimensions; i++) {
+      DstT val = (DstT)copy_details.src_ptr[i];
+#pragma unroll
+      for (int dst_id = 0; dst_id < ndests; dst_id++) {
+        if (copy_details.do_copy[dst_id]) {
+          copy_details.dst_ptr[dst_id][i] = val;
+        }
+      }
+    }
+  }
+}
+
 }  // namespace ShuffleKernels
 
 namespace HugeCTR {
@@ -203,13 +232,29 @@ void __shuffle_dispatch(CopyDesc copy_desc, size_t expected_elements, cudaStream
   ShuffleKernels::arbitrary<Config><<<grid, block, shmem_size, stream>>>(copy_desc);
 }
 
+template <typename Config, typename CopyDesc>
+void __shuffle_dispatch_small(CopyDesc copy_desc, size_t expected_elements, cudaStream_t stream) {
+  dim3 block = ShuffleConfigs::DefaultSmall::block;
+  size_t grid = std::max((size_t)1, std::min((size_t)100000, expected_elements / block.x + 1));
+
+  ShuffleKernels::small<Config><<<(uint32_t)grid, block, 0, stream>>>(copy_desc);
+}
+
 template <typename Config = ShuffleConfigs::DefaultAligned, typename CopyDesc>
 void shuffle(CopyDesc copy_desc, cudaStream_t stream, size_t expected_elements = 10000) {
   assert((sizeof(typename CopyDesc::SrcT) * copy_desc.num_dimensions()) % sizeof(int) == 0 &&
          (sizeof(typename CopyDesc::DstT) * copy_desc.num_dimensions()) % sizeof(int) == 0);
 
-  if (std::is_same<typename CopyDesc::SrcT, typename CopyDesc::DstT>::value && Config::Aligned &&
-      (copy_desc.num_dimensions() % sizeof(typename Config::VecType) == 0)) {
+  // Elements of at most one vector each (e.g. the 4-16 byte index shuffles of the hybrid
+  // embedding) cannot amortize a whole thread group per element: take the small-message path
+  if (copy_desc.num_dimensions() * sizeof(typename CopyDesc::SrcT) <=
+          sizeof(typename Config::VecType) &&
+      copy_desc.num_dimensions() * sizeof(typename CopyDesc::DstT) <=
+          sizeof(typename Config::VecType)) {
+    __shuffle_dispatch_small<Config, CopyDesc>(copy_desc, expected_elements, stream);
+  } else if (std::is_same<typename CopyDesc::SrcT, typename CopyDesc::DstT>::value &&
+             Config::Aligned &&
+             (copy_desc.num_dimensions() % sizeof(typename Config::VecType) == 0)) {
     __shuffle_dispatch_aligned<Config, CopyDesc>(copy_desc, expected_elements, stream);
   } else {
     __shuffle_dispatch<Config, CopyDesc>(copy_desc, expected_elements, stream);
@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <deque>
+
 #include "utils.hpp"
 
 namespace HugeCTR {
@@ -27,8 +29,8 @@ class StreamEventManager {
     for (auto& s : stream_map_) {
       cudaStreamDestroy(s.second);
     }
-    for (auto& e : event_map_) {
-      cudaEventDestroy(e.second);
+    for (auto& e : event_pool_) {
+      cudaEventDestroy(e);
     }
   }
 
@@ -48,17 +50,36 @@ class StreamEventManager {
   }
 
   cudaEvent_t& get_event(const std::string& key, unsigned int flags = 0) {
-    if (event_map_.find(key) == event_map_.end()) {
-      cudaEvent_t event;
-      HCTR_LIB_THROW(cudaEventCreateWithFlags(&event, flags));
-      event_map_[key] = event;
+    return event_pool_[get_event_handle(key, flags)];
+  }
+
+  /**
+   * Resolve a name to a stable integer handle, creating the event on first use. The string
+   * lookup is paid once at setup; the per-iteration path then indexes the pool directly via
+   * get_event(size_t). Timing is disabled by default, which is what the synchronization-only
+   * events of the training loop want.
+   */
+  size_t get_event_handle(const std::string& key, unsigned int flags = cudaEventDisableTiming) {
+    const auto it = event_handle_map_.find(key);
+    if (it != event_handle_map_.end()) {
+      return it->second;
     }
-    return event_map_[key];
+    cudaEvent_t event;
+    HCTR_LIB_THROW(cudaEventCreateWithFlags(&event, flags));
+    event_pool_.push_back(event);
+    const size_t handle = event_pool_.size() - 1;
+    event_handle_map_[key] = handle;
+    return handle;
   }
 
+  const cudaEvent_t& get_event(size_t handle) const { return event_pool_[handle]; }
+
  private:
   std::unordered_map<std::string, cudaStream_t> stream_map_;
-  std::unordered_map<std::string, cudaEvent_t> event_map_;
+  // The events live in a deque so that references stay valid while the pool grows; the name map
+  // only translates to indices and is off the per-iteration path.
+  std::deque<cudaEvent_t> event_pool_;
+  std::unordered_map<std::string, size_t> event_handle_map_;
 };
 
 }  // namespace HugeCTR
\ No newline at end of file
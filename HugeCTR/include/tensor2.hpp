@@ -133,6 +133,8 @@ class TensorBag2 {
 
   void *get_ptr() { return buffer_->get_ptr(); }
 
+  const std::shared_ptr<TensorBuffer2> &get_buffer() const { return buffer_; }
+
   size_t get_size_in_bytes() const {
     return get_num_elements_from_dimensions(dimensions_) * tensorScalarSizeFunc(scalar_type_);
   }
@@ -189,6 +191,17 @@ class Tensor2 {
 
   T *get_ptr() { return reinterpret_cast<T *>(buffer_->get_ptr()); }
 
+  /**
+   * Creates a zero-copy view of this tensor with new dimensions. The view shares the
+   * underlying buffer, so the new dimensions must hold the same number of elements.
+   */
+  Tensor2 reshape(const std::vector<size_t> &new_dimensions) const {
+    if (get_num_elements_from_dimensions(new_dimensions) != num_elements_) {
+      HCTR_OWN_THROW(Error_t::WrongInput, "A reshaped view must keep the number of elements");
+    }
+    return Tensor2(new_dimensions, buffer_);
+  }
+
   void reset_shape(const std::vector<size_t> &new_dimensions) {
     try {
       size_t new_num_elements = get_num_elements_from_dimensions(new_dimensions);
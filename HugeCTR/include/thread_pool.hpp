@@ -49,24 +49,48 @@ class ThreadPool {
 
   std::future<void> submit(std::function<void()> task);
 
+  /**
+   * Submits a task that may only run on the given subset of worker indices, e.g. the workers
+   * pinned to the NUMA node holding the task's data. An empty affinity set means any worker.
+   */
+  std::future<void> submit(std::function<void()> task, const std::vector<size_t>& affinity);
+
   static ThreadPool& get();
 
   template <typename TInputIterator>
   static void await(TInputIterator first, const TInputIterator& last);
 
  private:
+  struct Task {
+    std::packaged_task<void()> work;
+    std::vector<size_t> affinity;  // Worker indices allowed to run it; empty = any worker.
+  };
+
+  // One deque per worker, each with its own lock: submissions are spread round-robin and idle
+  // workers steal from the other deques, so there is no single queue mutex to contend on.
+  struct WorkerQueue {
+    mutable std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
   const std::string name_;
   std::vector<std::thread> workers_;
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
 
-  mutable std::mutex barrier_;  // Must be obtained to ensure exclusive access.
+  std::atomic<size_t> next_queue_{0};   // Round-robin submission target.
+  std::atomic<size_t> num_pending_{0};  // Tasks queued or running.
+
+  mutable std::mutex barrier_;  // Only taken on idle transitions, not per task.
   mutable std::condition_variable
       submit_sempahore_;  // Triggered on submission. Workers wait for this.
   mutable std::condition_variable idle_semaphore_;  // Trigger
 
   bool terminate_ = false;  // Used to signal to the workers that termination is imminent.
   size_t num_idle_workers_ = 0;
-  std::deque<std::packaged_task<void()>>
-      packages_;  // Work packages that have not been processed yet.
+
+  // Takes a runnable task from the worker's own deque (front), or steals one from another
+  // worker's deque (back), honoring the tasks' affinity sets.
+  bool try_acquire_task_(size_t thread_index, Task& task);
 
   void run_(const size_t thread_index);
 };
@@ -78,4 +102,4 @@ void ThreadPool::await(TInputIterator first, const TInputIterator& last) {
   }
 }
 
-}  // namespace HugeCTR
\ No newline at end of file
+}  // namespace HugeCTR
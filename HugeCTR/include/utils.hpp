@@ -18,11 +18,14 @@
 
 #include <cuda_runtime_api.h>
 #include <cudnn.h>
+#include <fcntl.h>
 #include <getopt.h>
 #include <nccl.h>
 #include <numa.h>
 #include <unistd.h>
 
+#include <atomic>
+
 #include <algorithm>
 #include <cassert>
 #include <chrono>
@@ -236,9 +239,13 @@ class CudaDeviceContext {
 class CudaCPUDeviceContext {
  public:
   CudaCPUDeviceContext(int device_id) {
+    HCTR_LIB_THROW(cudaSetDevice(device_id));
+    if (!numa_pinning_enabled_) {
+      return;
+    }
+
     auto node_it = device_id_to_numa_node_.find(device_id);
     assert(node_it != device_id_to_numa_node_.end());
-    HCTR_LIB_THROW(cudaSetDevice(device_id));
 
     int node = node_it->second;
     if (node >= 0) {
@@ -247,6 +254,10 @@ class CudaCPUDeviceContext {
     }
   }
 
+  // When disabled, the context only switches the device and leaves the thread and its
+  // allocations wherever the OS puts them.
+  static void set_numa_pinning_enabled(bool enabled) { numa_pinning_enabled_ = enabled; }
+
   static void init_cpu_mapping(std::vector<int> device_ids) {
     constexpr int pci_id_len = 16;
     char pci_id[pci_id_len];
@@ -285,6 +296,7 @@ class CudaCPUDeviceContext {
 
  public:
   static std::unordered_map<int, int> device_id_to_numa_node_;
+  static bool numa_pinning_enabled_;
 };
 
 /**
@@ -539,6 +551,51 @@ void inc_var(volatile T* x, cudaStream_t stream);
 
 inline int64_t divup(int64_t x, int64_t y) { return (x + y - 1) / y; }
 
+/**
+ * @brief Write a host buffer to a local file with several threads, each pwrite-ing its own
+ *        chunk at the proper offset. The file content is identical to one sequential write;
+ *        splitting the transfer keeps checkpoint-sized dumps from being limited by a single
+ *        write stream. Small buffers are written with a single chunk.
+ */
+inline void parallel_file_write(const std::string& file_name, const void* data, size_t bytes) {
+  constexpr size_t chunk_bytes{64ul << 20};
+  constexpr size_t max_threads{8};
+  int fd{open(file_name.c_str(), O_CREAT | O_WRONLY | O_TRUNC, 0644)};
+  if (fd == -1) {
+    HCTR_OWN_THROW(Error_t::WrongInput, "Cannot open the file: " + file_name);
+  }
+  size_t const num_chunks{std::max<size_t>(divup(bytes, chunk_bytes), 1)};
+  size_t const num_threads{std::min(num_chunks, max_threads)};
+  std::atomic<bool> write_ok{true};
+  std::vector<std::thread> writers;
+  for (size_t tid{0}; tid < num_threads; tid++) {
+    writers.emplace_back([&, tid] {
+      for (size_t chunk{tid}; chunk < num_chunks && write_ok; chunk += num_threads) {
+        size_t offset{chunk * chunk_bytes};
+        size_t remain{std::min(chunk_bytes, bytes - offset)};
+        const char* src{static_cast<const char*>(data) + offset};
+        while (remain > 0) {
+          auto ret{pwrite(fd, src, remain, offset)};
+          if (ret <= 0) {
+            write_ok = false;
+            break;
+          }
+          src += ret;
+          offset += ret;
+          remain -= ret;
+        }
+      }
+    });
+  }
+  for (auto& writer : writers) {
+    writer.join();
+  }
+  close(fd);
+  if (!write_ok) {
+    HCTR_OWN_THROW(Error_t::WrongInput, "Error: writing " + file_name + " failed");
+  }
+}
+
 template <class T>
 inline void hash_combine(std::size_t& s, const T& v) {
   std::hash<T> h;
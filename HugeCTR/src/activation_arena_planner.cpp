@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "HugeCTR/include/activation_arena_planner.hpp"
+
+#include <algorithm>
+
+namespace HugeCTR {
+
+namespace {
+
+constexpr size_t kArenaAlignment = 32;
+
+size_t align_up(size_t size) {
+  return (size + kArenaAlignment - 1) / kArenaAlignment * kArenaAlignment;
+}
+
+}  // namespace
+
+void ActivationArenaPlanner::add_layer(const std::vector<TensorBag2>& inputs,
+                                       const std::vector<TensorBag2>& outputs) {
+  const int layer_id = num_layers_++;
+
+  auto touch = [&](const TensorBag2& bag, bool is_output) {
+    TensorBuffer2* buffer = bag.get_buffer().get();
+    if (buffer == nullptr) {
+      return;
+    }
+    auto it = intervals_.find(buffer);
+    if (it == intervals_.end()) {
+      // A buffer first seen as an input was written before the first layer ran.
+      intervals_[buffer] = Interval{bag.get_size_in_bytes(), is_output ? layer_id : 0, layer_id};
+      order_.push_back(buffer);
+    } else {
+      it->second.last = layer_id;
+      it->second.size_in_bytes = std::max(it->second.size_in_bytes, bag.get_size_in_bytes());
+    }
+  };
+
+  for (const auto& bag : inputs) {
+    touch(bag, false);
+  }
+  for (const auto& bag : outputs) {
+    touch(bag, true);
+  }
+}
+
+void ActivationArenaPlanner::pin(const TensorBag2& bag) { pinned_.insert(bag.get_buffer().get()); }
+
+size_t ActivationArenaPlanner::get_total_size_in_bytes() const {
+  size_t total = 0;
+  for (TensorBuffer2* buffer : order_) {
+    if (pinned_.find(buffer) == pinned_.end()) {
+      total += align_up(intervals_.at(buffer).size_in_bytes);
+    }
+  }
+  return total;
+}
+
+size_t ActivationArenaPlanner::plan(std::map<TensorBuffer2*, size_t>* offsets) const {
+  struct Candidate {
+    TensorBuffer2* buffer;
+    Interval interval;
+  };
+  std::vector<Candidate> candidates;
+  for (TensorBuffer2* buffer : order_) {
+    if (pinned_.find(buffer) == pinned_.end()) {
+      candidates.push_back({buffer, intervals_.at(buffer)});
+    }
+  }
+  // First-fit-decreasing: place the large buffers first so the small ones fill the gaps.
+  std::stable_sort(candidates.begin(), candidates.end(),
+                   [](const Candidate& a, const Candidate& b) {
+                     return a.interval.size_in_bytes > b.interval.size_in_bytes;
+                   });
+
+  struct Placed {
+    size_t offset;
+    size_t size;
+    int first;
+    int last;
+  };
+  std::vector<Placed> placed;
+
+  size_t arena_size = 0;
+  for (const auto& candidate : candidates) {
+    const size_t size = align_up(candidate.interval.size_in_bytes);
+
+    std::vector<Placed> blocking;
+    for (const auto& block : placed) {
+      if (candidate.interval.first <= block.last && block.first <= candidate.interval.last) {
+        blocking.push_back(block);
+      }
+    }
+    std::sort(blocking.begin(), blocking.end(),
+              [](const Placed& a, const Placed& b) { return a.offset < b.offset; });
+
+    // Lowest offset where the candidate fits in front of or between the live blocks.
+    size_t offset = 0;
+    for (const auto& block : blocking) {
+      if (offset + size <= block.offset) {
+        break;
+      }
+      offset = std::max(offset, block.offset + block.size);
+    }
+
+    placed.push_back({offset, size, candidate.interval.first, candidate.interval.last});
+    (*offsets)[candidate.buffer] = offset;
+    arena_size = std::max(arena_size, offset + size);
+  }
+  return arena_size;
+}
+
+}  // namespace HugeCTR
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <base/debug/logger.hpp>
+#include <base/debug/perf_counters.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+
+namespace HugeCTR {
+
+namespace {
+
+/**
+ * The metric family is the series name up to the (optional) label block; series of one family
+ * share a single '# TYPE' line in the exported text.
+ */
+std::string family_of(const std::string& series) { return series.substr(0, series.find('{')); }
+
+}  // namespace
+
+PerfCounters& PerfCounters::get() {
+  static std::unique_ptr<PerfCounters> instance;
+  static std::once_flag once_flag;
+
+  std::call_once(once_flag, []() { instance.reset(new PerfCounters()); });
+  return *instance;
+}
+
+PerfCounters::PerfCounters() {
+  const char* textfile_path = std::getenv("HCTR_PROMETHEUS_TEXTFILE");
+  if (textfile_path && *textfile_path) {
+    size_t interval_sec = 15;
+    if (const char* interval_env = std::getenv("HCTR_PROMETHEUS_INTERVAL_SEC")) {
+      interval_sec = std::max<size_t>(1, std::strtoull(interval_env, nullptr, 10));
+    }
+    HCTR_LOG_S(INFO, WORLD) << "Exporting performance counters to Prometheus textfile '"
+                            << textfile_path << "' every " << interval_sec << " s." << std::endl;
+    textfile_writer_ = std::thread(&PerfCounters::textfile_writer_loop, this,
+                                   std::string{textfile_path}, interval_sec);
+  }
+}
+
+PerfCounters::~PerfCounters() {
+  terminate_ = true;
+  if (textfile_writer_.joinable()) {
+    textfile_writer_.join();
+  }
+}
+
+std::atomic<uint64_t>& PerfCounters::counter(const std::string& series) {
+  {
+    std::shared_lock lock(mutex_);
+    const auto it = counters_.find(series);
+    if (it != counters_.end()) {
+      return *it->second;
+    }
+  }
+  std::unique_lock lock(mutex_);
+  auto& slot = counters_[series];
+  if (!slot) {
+    slot = std::make_unique<std::atomic<uint64_t>>(0);
+  }
+  return *slot;
+}
+
+void PerfCounters::inc(const std::string& series, uint64_t delta) {
+  counter(series).fetch_add(delta, std::memory_order_relaxed);
+}
+
+void PerfCounters::set_gauge(const std::string& series, double value) {
+  {
+    std::shared_lock lock(mutex_);
+    const auto it = gauges_.find(series);
+    if (it != gauges_.end()) {
+      it->second->store(value, std::memory_order_relaxed);
+      return;
+    }
+  }
+  std::unique_lock lock(mutex_);
+  auto& slot = gauges_[series];
+  if (!slot) {
+    slot = std::make_unique<std::atomic<double>>(value);
+  } else {
+    slot->store(value, std::memory_order_relaxed);
+  }
+}
+
+std::string PerfCounters::to_prometheus() const {
+  std::ostringstream os;
+  std::shared_lock lock(mutex_);
+
+  // The maps are ordered, so series of one family are adjacent and need their TYPE line only
+  // when the family changes.
+  std::string prev_family;
+  for (const auto& [series, value] : counters_) {
+    const std::string family = family_of(series);
+    if (family != prev_family) {
+      os << "# TYPE " << family << " counter\n";
+      prev_family = family;
+    }
+    os << series << ' ' << value->load(std::memory_order_relaxed) << '\n';
+  }
+  prev_family.clear();
+  for (const auto& [series, value] : gauges_) {
+    const std::string family = family_of(series);
+    if (family != prev_family) {
+      os << "# TYPE " << family << " gauge\n";
+      prev_family = family;
+    }
+    os << series << ' ' << value->load(std::memory_order_relaxed) << '\n';
+  }
+  return os.str();
+}
+
+std::map<std::string, double> PerfCounters::snapshot() const {
+  std::map<std::string, double> values;
+  std::shared_lock lock(mutex_);
+  for (const auto& [series, value] : counters_) {
+    values.emplace(series, static_cast<double>(value->load(std::memory_order_relaxed)));
+  }
+  for (const auto& [series, value] : gauges_) {
+    values.emplace(series, value->load(std::memory_order_relaxed));
+  }
+  return values;
+}
+
+void PerfCounters::textfile_writer_loop(const std::string path, const size_t interval_sec) {
+  const std::string tmp_path = path + ".tmp";
+  while (!terminate_) {
+    // Sleep in 1 s slices so shutdown is not delayed by a long interval.
+    for (size_t slept = 0; slept < interval_sec && !terminate_; ++slept) {
+      std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+    if (terminate_) {
+      break;
+    }
+    // Write to a temporary file and rename so the collector never reads a partial scrape.
+    {
+      std::ofstream file(tmp_path, std::ofstream::trunc);
+      if (!file.is_open()) {
+        HCTR_LOG_S(ERROR, WORLD) << "Unable to write Prometheus textfile '" << tmp_path << "'."
+                                 << std::endl;
+        continue;
+      }
+      file << to_prometheus();
+    }
+    if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+      HCTR_LOG_S(ERROR, WORLD) << "Unable to rename '" << tmp_path << "' to '" << path << "'."
+                               << std::endl;
+    }
+  }
+}
+
+}  // namespace HugeCTR
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <base/debug/perf_counters.hpp>
 #include <collectives/all_reduce_comm.hpp>
 #include <collectives/ib_comm.hpp>
 #include <utils.hpp>
@@ -90,7 +91,10 @@ OneshotMultiARInplaceComm<T>::OneshotMultiARInplaceComm(
     : ib_comm_(ib_comm),
       num_procs_(num_procs),
       gpu_resources_(gpu_resources),
-      num_gpus_(gpu_resources.size()) {}
+      num_gpus_(gpu_resources.size()) {
+  perf_ar_bytes_ =
+      &PerfCounters::get().counter("hugectr_all_reduce_bytes_total{algo=\"oneshot_multi\"}");
+}
 
 template <typename T>
 AllReduceInPlaceComm::Handle OneshotMultiARInplaceComm<T>::register_coll() {
@@ -135,6 +139,7 @@ template <typename T>
 void OneshotMultiARInplaceComm<T>::all_reduce(AllReduceInPlaceComm::Handle coll,
                                               cudaStream_t stream, size_t g) {
   auto& ctx = ar_ctx_[coll];
+  perf_ar_bytes_->fetch_add(ctx->ar_size_, std::memory_order_relaxed);
   ib_comm_->all_reduce<T>(ctx->ib_comm_handle_, stream, g);
 }
 
@@ -229,7 +234,7 @@ static __global__ void __launch_bounds__(AR_MAX_THREADS)
   const int myblockDim = nwarps << 5;
   const int mywarp = ((threadIdx.x) >> 5) / (RANKS - 1);
   const int maxthreadIdx = myblockDim * (RANKS - 1);
-  const int mydest = (device_id + 1 + ((threadIdx.x) >> 5) % (RANKS - 1)) & (RANKS - 1);
+  const int mydest = (device_id + 1 + ((threadIdx.x) >> 5) % (RANKS - 1)) % RANKS;
   const int mythreadIdx = (mywarp << 5) + (threadIdx.x & 31);
 
   volatile size_t* flag = (volatile size_t*)&(my_flag[AG_RANK_BCAST_OFFSET + mydest]);
@@ -283,6 +288,8 @@ OneshotSingleARInplaceComm<T>::OneshotSingleARInplaceComm(
   if (getenv("ONESHOT_NCHANNELS")) {
     cfg_nchannels_ = atoi(getenv("ONESHOT_NCHANNELS"));
   }
+  perf_ar_bytes_ =
+      &PerfCounters::get().counter("hugectr_all_reduce_bytes_total{algo=\"oneshot_single\"}");
 }
 
 template <typename T>
@@ -303,6 +310,9 @@ void OneshotSingleARInplaceComm<T>::set_coll_buf(Handle coll, void* ar_ptr, size
   if ((ctx->ar_size_ != 0) && (ctx->ar_size_ != ar_size)) {
     HCTR_OWN_THROW(Error_t::WrongInput, "AR size mismatch");
   }
+  if (ar_size % (num_gpus_ * sizeof(uint4)) != 0) {
+    HCTR_OWN_THROW(Error_t::WrongInput, "AR size needs to be aligned to num_gpus*16");
+  }
   ctx->ar_size_ = ar_size;
   // HCTR_LOG_S(INFO, ROOT) << "Oneshot AR size: " << ar_size << std::endl;
 }
@@ -353,6 +363,7 @@ void OneshotSingleARInplaceComm<T>::all_reduce(AllReduceInPlaceComm::Handle coll
                                                cudaStream_t stream, size_t g) {
   auto& ctx = ar_ctx_[coll];
   auto& gpu_ctx = ctx->ctx_[g];
+  perf_ar_bytes_->fetch_add(ctx->ar_size_, std::memory_order_relaxed);
   int numlines = ctx->ar_size_ / sizeof(uint4);
   int device_id_int = static_cast<int>(g);
 #define LAUNCH_KERNEL(RANKS)                                                         \
@@ -360,8 +371,15 @@ void OneshotSingleARInplaceComm<T>::all_reduce(AllReduceInPlaceComm::Handle coll
     all_reduce_cuda_single<RANKS, T><<<cfg_nchannels_, AR_MAX_THREADS, 0, stream>>>( \
         gpu_ctx.d_peer_ptrs_.get_ptr(), numlines, gpu_ctx.d_coll_cmd_.get_ptr(),     \
         gpu_ctx.d_flags_ptrs_.get_ptr(), device_id_int);
+  if (num_gpus_ < 2 || num_gpus_ > 8) {
+    HCTR_OWN_THROW(Error_t::WrongInput, "Oneshot all-reduce supports 2 to 8 local GPUs");
+  }
   LAUNCH_KERNEL(2);
+  LAUNCH_KERNEL(3);
   LAUNCH_KERNEL(4);
+  LAUNCH_KERNEL(5);
+  LAUNCH_KERNEL(6);
+  LAUNCH_KERNEL(7);
   LAUNCH_KERNEL(8);
 }
 
@@ -371,7 +389,9 @@ template class OneshotSingleARInplaceComm<float>;
 template <typename T>
 NCCLARInplaceComm<T>::NCCLARInplaceComm(
     size_t num_procs, const std::vector<std::shared_ptr<GPUResource>>& gpu_resources)
-    : num_procs_(num_procs), gpu_resources_(gpu_resources), num_gpus_(gpu_resources.size()) {}
+    : num_procs_(num_procs), gpu_resources_(gpu_resources), num_gpus_(gpu_resources.size()) {
+  perf_ar_bytes_ = &PerfCounters::get().counter("hugectr_all_reduce_bytes_total{algo=\"nccl\"}");
+}
 
 template <typename T>
 AllReduceInPlaceComm::Handle NCCLARInplaceComm<T>::register_coll() {
@@ -410,6 +430,7 @@ void NCCLARInplaceComm<T>::all_reduce(AllReduceInPlaceComm::Handle coll, cudaStr
                                       size_t g) {
   auto& ctx = ar_ctx_[coll];
   auto& ctx_g = ctx->ctx_[g];
+  perf_ar_bytes_->fetch_add(ctx->ar_size_, std::memory_order_relaxed);
   HCTR_LIB_THROW(ncclAllReduce((const void*)ctx_g.ar_ptr_, ctx_g.ar_ptr_, ctx->ar_size_ / sizeof(T),
                                NcclDataType<T>::getType(), ncclSum, gpu_resources_[g]->get_nccl(),
                                stream));
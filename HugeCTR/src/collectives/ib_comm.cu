@@ -20,6 +20,8 @@
 #include <numaif.h>
 
 #include <collectives/ib_comm.hpp>
+#include <cpu_resource.hpp>
+#include <cstdlib>
 #include <iostream>
 #include <sstream>
 #include <utils.cuh>
@@ -327,6 +329,7 @@ void IbComm::init_proxy_threads() {
     cfg->num_gpus_ = num_gpus_;
     cfg->num_procs_ = num_procs_;
     cfg->my_proc_ = my_proc_;
+    cfg->num_qps_per_peer_ = num_qps_per_peer_;
 
     sched_param param;
     pthread_attr_t attr;
@@ -338,16 +341,33 @@ void IbComm::init_proxy_threads() {
     pthread_attr_setschedparam(&attr, &param);
     int ret = pthread_create(&proxy_thread_[g], &attr, &proxy_thread_func, cfg.get());
     PROXY_ASSERT(ret == 0);
+
+    // Confine the proxy to the "comm" pool when one is reserved (HCTR_CORE_RESERVATION), so the
+    // SCHED_FIFO proxies do not preempt the data-reader workers or the cores driving the GPUs.
+    const std::set<int>& comm_cores = CPUResource::reserved_cores("comm");
+    if (!comm_cores.empty()) {
+      cpu_set_t cpuset;
+      CPU_ZERO(&cpuset);
+      for (int core : comm_cores) {
+        CPU_SET(core, &cpuset);
+      }
+      ret = pthread_setaffinity_np(proxy_thread_[g], sizeof(cpu_set_t), &cpuset);
+      PROXY_ASSERT(ret == 0);
+    }
   }
 }
 
 // API implementation
 int IbComm::init(size_t num_procs, size_t num_gpus, size_t my_proc,
-                 const std::vector<int>& device_list) {
+                 const std::vector<int>& device_list, size_t num_qps_per_peer) {
   num_procs_ = num_procs;
   num_gpus_ = num_gpus;
   my_proc_ = my_proc;
   device_list_ = device_list;
+  if (const char* env = std::getenv("HCTR_IBV_QPS_PER_PEER")) {
+    num_qps_per_peer = std::max((size_t)atoll(env), (size_t)1);
+  }
+  num_qps_per_peer_ = num_qps_per_peer;
 
   PROXY_ASSERT(num_procs > 1);
   detect_ib_devs();
@@ -773,6 +793,42 @@ void IbComm::wait_global_recv_async(HierA2AvCollHandle coll, size_t device_id) {
                                            ctx.d_ibv_atomic_recv_[device_id], num_procs_, my_proc_);
 }
 
+HierA2ACollHandle IbComm::register_device_barrier() {
+  hier_a2a_coll_ctx_.emplace_back(std::make_unique<HierA2ACollContext>(this));
+  HierA2ACollHandle coll_handle = (HierA2ACollHandle)(hier_a2a_coll_ctx_.size() - 1);
+  auto sync_helper = hier_a2a_coll_ctx_[coll_handle]->sync_helper_.get();
+  for (size_t g = 0; g < num_gpus_; g++) {
+    // The atomic exchange itself is the barrier, skip the proxy-side MPI barrier.
+    M2PHierA2ACollInit coll_init_cmd_(coll_handle, sync_helper, true);
+    HierA2ACollInitCmd cmd = std::make_pair(std::move(coll_init_cmd_), std::move(P2MNull()));
+    proxy_cmd_->cmd_[g] = std::move(cmd);
+  }
+  proxy_cmd_->post_command();
+  proxy_cmd_->wait_for_completion();
+  proxy_cmd_->reset();
+
+  // A barrier moves no payload: register NULL buffers with zero sizes so the proxies skip
+  // the MR registration and post atomic-only sends.
+  std::vector<void*> null_ptrs(num_procs_, nullptr);
+  std::vector<size_t> zero_sizes(num_procs_, 0);
+  for (size_t g = 0; g < num_gpus_; g++) {
+    set_a2a_coll_buf(coll_handle, null_ptrs.data(), zero_sizes.data(), null_ptrs.data(),
+                     zero_sizes.data(), g);
+  }
+  register_a2a_coll_buf(coll_handle);
+  return coll_handle;
+}
+
+void IbComm::device_barrier(HierA2ACollHandle coll, cudaStream_t stream, size_t device_id) {
+  auto& ctx = *hier_a2a_coll_ctx_[coll];
+  // Intra-node barrier; local GPU 0 then rings the proxy doorbell with the new count.
+  ctx.barrier_->sync_all_gpus_report_host_and_inc(ctx.d_send_cmd_[device_id], ctx.h_recv_cmd_ptr_,
+                                                  stream, device_id);
+  // Spin until the GPUDirect-written atomics from all remote nodes arrived.
+  wait_completion<<<1, 32, 0, stream>>>(ctx.d_send_cmd_[device_id], ctx.d_ibv_atomic_[device_id],
+                                        num_procs_, my_proc_, device_id);
+}
+
 template void IbComm::post_send_command_a2a<__half>(HierA2ACollHandle coll, cudaStream_t dep_stream,
                                                     size_t device_id);
 template void IbComm::post_send_command_a2a<float>(HierA2ACollHandle coll, cudaStream_t dep_stream,
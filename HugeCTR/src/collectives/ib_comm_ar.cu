@@ -67,6 +67,10 @@ void IbComm::ARCollContext::update_size(size_t ar_size) {
   if (blocksize_ < cfg_min_block_) {
     blocksize_ = cfg_min_block_;
   }
+  // Keep each block splittable into whole 16B lines per rank for any local GPU count.
+  // Note: This needs to match with the proxy calculation.
+  int rank_quantum = num_gpus_ * sizeof(uint4);
+  blocksize_ = ((blocksize_ + rank_quantum - 1) / rank_quantum) * rank_quantum;
   peer_blocklines_ = blocksize_ / sizeof(uint4) / num_gpus_;
   num_blocks_ = (ar_size + blocksize_ - 1) / blocksize_;
   PROXY_ASSERT(num_blocks_ <= AR_MAX_BLOCKS);
@@ -326,7 +330,7 @@ static __global__ void __launch_bounds__(AR_MAX_THREADS)
       const int mywarp = ((threadIdx.x - basethread) >> 5) / (RANKS - 1);
       const int maxthreadIdx = myblockDim * (RANKS - 1) + basethread;
       const int mydest =
-          (device_id + 1 + ((threadIdx.x - basethread) >> 5) % (RANKS - 1)) & (RANKS - 1);
+          (device_id + 1 + ((threadIdx.x - basethread) >> 5) % (RANKS - 1)) % RANKS;
       const int mythreadIdx = (mywarp << 5) + (threadIdx.x & 31);
 
       volatile size_t* flag = (volatile size_t*)&(my_flag[AG_RANK_BCAST_OFFSET + mydest]);
@@ -399,7 +403,7 @@ void IbComm::all_reduce(ARCollHandle coll, cudaStream_t stream, size_t device_id
       gpu_ctx->d_flags_ptrs_.get_ptr(), ctx->peer_blocklines_, ctx->num_blocks_, device_id_int);
 }
 
-#define SUPPORTED_AR_RANKS (2)(4)(8)(16)
+#define SUPPORTED_AR_RANKS (2)(3)(4)(5)(6)(7)(8)(16)
 
 template <typename T>
 void IbComm::all_reduce(ARCollHandle coll, cudaStream_t stream, size_t device_id) {
@@ -18,7 +18,9 @@
 #include <immintrin.h>
 #include <x86intrin.h>
 
+#include <algorithm>
 #include <collectives/ib_proxy.hpp>
+#include <cstdlib>
 
 namespace HugeCTR {
 // ProxyCommand
@@ -109,63 +111,78 @@ void IbvProxy::HierA2AIbvContext::init_ibv(const IbvProxy::InitConfig& cfg) {
                              << HCTR_LOCATION() << std::endl;
   }
   size_t num_gpus = cfg.num_gpus_;
+  num_qps_per_peer_ = std::max(cfg.num_qps_per_peer_, (size_t)1);
+  const size_t num_qps = num_procs * num_qps_per_peer_;
   cq_ = (struct ibv_cq**)malloc(num_procs * sizeof(struct ibv_cq*));
-  qp_ = (struct ibv_qp**)malloc(num_procs * sizeof(struct ibv_qp*));
+  qp_ = (struct ibv_qp**)malloc(num_qps * sizeof(struct ibv_qp*));
 
-  qp_infos_ = (struct IbQpInfo*)malloc(num_procs * sizeof(struct IbQpInfo));
-  rem_qp_infos_ = (struct IbQpInfo*)malloc(num_procs * sizeof(struct IbQpInfo));
+  qp_infos_ = (struct IbQpInfo*)malloc(num_qps * sizeof(struct IbQpInfo));
+  rem_qp_infos_ = (struct IbQpInfo*)malloc(num_qps * sizeof(struct IbQpInfo));
 
-  // Create completion queue
+  // Create completion queues; all stripes of a peer report into the peer's CQ.
   for (size_t n = 0; n < num_procs; n++) {
-    cq_[n] = ibv_create_cq(context_, 2 * num_gpus /*recv + send*/, NULL, NULL, 0);
+    int cq_depth = 2 * num_gpus /*recv + send*/;
+    if (std::getenv("HCTR_IBV_A2A_CHUNK_SIZE") || num_qps_per_peer_ > 1) {
+      // Chunked sends post up to A2A_MAX_CHUNKS WQEs per destination GPU plus the fence atomic.
+      cq_depth = num_gpus * (A2A_MAX_CHUNKS + 1);
+    }
+    cq_[n] = ibv_create_cq(context_, cq_depth, NULL, NULL, 0);
     if (!cq_[n]) {
       HCTR_LOG_S(ERROR, WORLD) << "Unable to create completion queue. " << HCTR_LOCATION()
                                << std::endl;
     }
 
-    struct ibv_qp_init_attr qp_init_attr;
-    memset(&qp_init_attr, 0, sizeof(struct ibv_qp_init_attr));
-    qp_init_attr.send_cq = cq_[n];
-    qp_init_attr.recv_cq = cq_[n];
-    qp_init_attr.qp_type = IBV_QPT_RC;
-    qp_init_attr.cap.max_send_wr = num_gpus * 4;
-    qp_init_attr.cap.max_recv_wr = 1;
-    qp_init_attr.cap.max_send_sge = 1;
-    qp_init_attr.cap.max_recv_sge = 1;
-    qp_init_attr.cap.max_inline_data = 0;
-
-    // Create QP
-    qp_[n] = ibv_create_qp(pd_, &qp_init_attr);
-    if (qp_[n] == NULL) {
-      HCTR_LOG_S(ERROR, WORLD) << "Unable to create qp. " << HCTR_LOCATION() << std::endl;
-    }
+    for (size_t q = 0; q < num_qps_per_peer_; q++) {
+      struct ibv_qp_init_attr qp_init_attr;
+      memset(&qp_init_attr, 0, sizeof(struct ibv_qp_init_attr));
+      qp_init_attr.send_cq = cq_[n];
+      qp_init_attr.recv_cq = cq_[n];
+      qp_init_attr.qp_type = IBV_QPT_RC;
+      qp_init_attr.cap.max_send_wr = num_gpus * 4;
+      if (std::getenv("HCTR_IBV_A2A_CHUNK_SIZE") || num_qps_per_peer_ > 1) {
+        qp_init_attr.cap.max_send_wr = num_gpus * (A2A_MAX_CHUNKS + 1);
+      }
+      qp_init_attr.cap.max_recv_wr = 1;
+      qp_init_attr.cap.max_send_sge = 1;
+      qp_init_attr.cap.max_recv_sge = 1;
+      qp_init_attr.cap.max_inline_data = 0;
+
+      // Create QP
+      const size_t idx = n * num_qps_per_peer_ + q;
+      qp_[idx] = ibv_create_qp(pd_, &qp_init_attr);
+      if (qp_[idx] == NULL) {
+        HCTR_LOG_S(ERROR, WORLD) << "Unable to create qp. " << HCTR_LOCATION() << std::endl;
+      }
 
-    // QP state machine
-    struct ibv_qp_attr qp_attr;
-    memset(&qp_attr, 0, sizeof(ibv_qp_attr));
-    qp_attr.qp_state = IBV_QPS_INIT;
-    qp_attr.pkey_index = 0;
-    qp_attr.port_num = cfg.ib_port_;
-    qp_attr.qp_access_flags = IBV_ACCESS_REMOTE_WRITE | IBV_ACCESS_REMOTE_ATOMIC;
-    if (ibv_modify_qp(qp_[n], &qp_attr,
-                      IBV_QP_STATE | IBV_QP_PKEY_INDEX | IBV_QP_PORT | IBV_QP_ACCESS_FLAGS) != 0) {
-      HCTR_LOG_S(ERROR, WORLD) << "Unable to modify QP access attributes. " << HCTR_LOCATION()
-                               << std::endl;
-    }
+      // QP state machine
+      struct ibv_qp_attr qp_attr;
+      memset(&qp_attr, 0, sizeof(ibv_qp_attr));
+      qp_attr.qp_state = IBV_QPS_INIT;
+      qp_attr.pkey_index = 0;
+      qp_attr.port_num = cfg.ib_port_;
+      qp_attr.qp_access_flags = IBV_ACCESS_REMOTE_WRITE | IBV_ACCESS_REMOTE_ATOMIC;
+      if (ibv_modify_qp(qp_[idx], &qp_attr,
+                        IBV_QP_STATE | IBV_QP_PKEY_INDEX | IBV_QP_PORT | IBV_QP_ACCESS_FLAGS) !=
+          0) {
+        HCTR_LOG_S(ERROR, WORLD) << "Unable to modify QP access attributes. " << HCTR_LOCATION()
+                                 << std::endl;
+      }
 
-    struct ibv_port_attr port_attr;
-    if (ibv_query_port(context_, cfg.ib_port_, &port_attr) != 0) {
-      HCTR_LOG_S(ERROR, WORLD) << "Unable to query port for port info" << std::endl;
-    }
+      struct ibv_port_attr port_attr;
+      if (ibv_query_port(context_, cfg.ib_port_, &port_attr) != 0) {
+        HCTR_LOG_S(ERROR, WORLD) << "Unable to query port for port info" << std::endl;
+      }
 
-    qp_infos_[n].ib_port = cfg.ib_port_;
-    qp_infos_[n].lid = port_attr.lid;
-    qp_infos_[n].qpn = qp_[n]->qp_num;
-    qp_infos_[n].mtu = port_attr.active_mtu;
+      qp_infos_[idx].ib_port = cfg.ib_port_;
+      qp_infos_[idx].lid = port_attr.lid;
+      qp_infos_[idx].qpn = qp_[idx]->qp_num;
+      qp_infos_[idx].mtu = port_attr.active_mtu;
+    }
   }
 
-  HCTR_MPI_THROW(MPI_Alltoall((void*)qp_infos_, sizeof(IbQpInfo), MPI_BYTE, (void*)rem_qp_infos_,
-                              sizeof(IbQpInfo), MPI_BYTE, MPI_COMM_WORLD));
+  HCTR_MPI_THROW(MPI_Alltoall((void*)qp_infos_, num_qps_per_peer_ * sizeof(IbQpInfo), MPI_BYTE,
+                              (void*)rem_qp_infos_, num_qps_per_peer_ * sizeof(IbQpInfo), MPI_BYTE,
+                              MPI_COMM_WORLD));
 
   // TODO: Align buffer allocation to 4KB
 
@@ -173,47 +190,52 @@ void IbvProxy::HierA2AIbvContext::init_ibv(const IbvProxy::InitConfig& cfg) {
     // connect my QPs with corresponding node QPs.
     if (n == cfg.my_proc_) continue;  // Ignore self
 
-    // Move to RTR state
-    {
-      // Modify MTU to min across both
-      rem_qp_infos_[n].mtu = (enum ibv_mtu)std::min(rem_qp_infos_[n].mtu, qp_infos_[n].mtu);
-      struct ibv_qp_attr qp_attr;
-      memset(&qp_attr, 0, sizeof(struct ibv_qp_attr));
-      qp_attr.qp_state = IBV_QPS_RTR;
-      qp_attr.path_mtu = rem_qp_infos_[n].mtu;
-      qp_attr.dest_qp_num = rem_qp_infos_[n].qpn;
-      qp_attr.rq_psn = 0;
-      qp_attr.max_dest_rd_atomic = 1;
-      qp_attr.min_rnr_timer = 12;
-      qp_attr.ah_attr.is_global = 0;
-      qp_attr.ah_attr.dlid = rem_qp_infos_[n].lid;
-      qp_attr.ah_attr.sl = 0;
-      qp_attr.ah_attr.src_path_bits = 0;
-      qp_attr.ah_attr.port_num = rem_qp_infos_[n].ib_port;
-      if (ibv_modify_qp(qp_[n], &qp_attr,
-                        IBV_QP_STATE | IBV_QP_AV | IBV_QP_PATH_MTU | IBV_QP_DEST_QPN |
-                            IBV_QP_RQ_PSN | IBV_QP_MAX_DEST_RD_ATOMIC | IBV_QP_MIN_RNR_TIMER) !=
-          0) {
-        HCTR_LOG_S(ERROR, WORLD) << "Modify QP failed. " << HCTR_LOCATION() << std::endl;
-        exit(1);
+    for (size_t q = 0; q < num_qps_per_peer_; q++) {
+      const size_t idx = n * num_qps_per_peer_ + q;
+
+      // Move to RTR state
+      {
+        // Modify MTU to min across both
+        rem_qp_infos_[idx].mtu = (enum ibv_mtu)std::min(rem_qp_infos_[idx].mtu, qp_infos_[idx].mtu);
+        struct ibv_qp_attr qp_attr;
+        memset(&qp_attr, 0, sizeof(struct ibv_qp_attr));
+        qp_attr.qp_state = IBV_QPS_RTR;
+        qp_attr.path_mtu = rem_qp_infos_[idx].mtu;
+        qp_attr.dest_qp_num = rem_qp_infos_[idx].qpn;
+        qp_attr.rq_psn = 0;
+        qp_attr.max_dest_rd_atomic = 1;
+        qp_attr.min_rnr_timer = 12;
+        qp_attr.ah_attr.is_global = 0;
+        qp_attr.ah_attr.dlid = rem_qp_infos_[idx].lid;
+        qp_attr.ah_attr.sl = 0;
+        qp_attr.ah_attr.src_path_bits = 0;
+        qp_attr.ah_attr.port_num = rem_qp_infos_[idx].ib_port;
+        if (ibv_modify_qp(qp_[idx], &qp_attr,
+                          IBV_QP_STATE | IBV_QP_AV | IBV_QP_PATH_MTU | IBV_QP_DEST_QPN |
+                              IBV_QP_RQ_PSN | IBV_QP_MAX_DEST_RD_ATOMIC | IBV_QP_MIN_RNR_TIMER) !=
+            0) {
+          HCTR_LOG_S(ERROR, WORLD) << "Modify QP failed. " << HCTR_LOCATION() << std::endl;
+          exit(1);
+        }
       }
-    }
 
-    // Move to RTS state
-    {
-      struct ibv_qp_attr qp_attr;
-      memset(&qp_attr, 0, sizeof(struct ibv_qp_attr));
-      qp_attr.qp_state = IBV_QPS_RTS;
-      qp_attr.timeout = 14;
-      qp_attr.retry_cnt = 7;
-      qp_attr.rnr_retry = 7;
-      qp_attr.sq_psn = 0;
-      qp_attr.max_rd_atomic = 1;
-      if (ibv_modify_qp(qp_[n], &qp_attr,
-                        IBV_QP_STATE | IBV_QP_TIMEOUT | IBV_QP_RETRY_CNT | IBV_QP_RNR_RETRY |
-                            IBV_QP_SQ_PSN | IBV_QP_MAX_QP_RD_ATOMIC) != 0) {
-        HCTR_LOG_S(ERROR, WORLD) << "Modify QP failed RTS state. " << HCTR_LOCATION() << std::endl;
-        exit(1);
+      // Move to RTS state
+      {
+        struct ibv_qp_attr qp_attr;
+        memset(&qp_attr, 0, sizeof(struct ibv_qp_attr));
+        qp_attr.qp_state = IBV_QPS_RTS;
+        qp_attr.timeout = 14;
+        qp_attr.retry_cnt = 7;
+        qp_attr.rnr_retry = 7;
+        qp_attr.sq_psn = 0;
+        qp_attr.max_rd_atomic = 1;
+        if (ibv_modify_qp(qp_[idx], &qp_attr,
+                          IBV_QP_STATE | IBV_QP_TIMEOUT | IBV_QP_RETRY_CNT | IBV_QP_RNR_RETRY |
+                              IBV_QP_SQ_PSN | IBV_QP_MAX_QP_RD_ATOMIC) != 0) {
+          HCTR_LOG_S(ERROR, WORLD) << "Modify QP failed RTS state. " << HCTR_LOCATION()
+                                   << std::endl;
+          exit(1);
+        }
       }
     }
   }
@@ -222,12 +244,14 @@ void IbvProxy::HierA2AIbvContext::init_ibv(const IbvProxy::InitConfig& cfg) {
 void IbvProxy::HierA2AIbvContext::finalize_ibv() {
   // Destroy QPs
   for (size_t n = 0; n < num_procs_; n++) {
+    for (size_t q = 0; q < num_qps_per_peer_; q++) {
+      if (qp_ && qp_[n * num_qps_per_peer_ + q]) {
+        ibv_destroy_qp(qp_[n * num_qps_per_peer_ + q]);
+      }
+    }
     if (cq_ && cq_[n]) {
       ibv_destroy_cq(cq_[n]);
     }
-    if (qp_ && qp_[n]) {
-      ibv_destroy_qp(qp_[n]);
-    }
   }
   if (cq_) {
     free(cq_);
@@ -482,7 +506,7 @@ void IbvProxy::HierA2ACollContext::process_send() {
       struct ibv_send_wr* bad_wr;
       // const std::string nvtx_name = "post_send_start_" + std::to_string(cfg_.device_id);
       // nvtxRangePushA(nvtx_name.c_str());
-      int ret = ibv_post_send(ibv_ctx_->qp_[n], &wr, &bad_wr);
+      int ret = ibv_post_send(ibv_ctx_->qp(n, 0), &wr, &bad_wr);
       PROXY_ASSERT(ret == 0);
     } else {
       // Do the atomic
@@ -505,7 +529,7 @@ void IbvProxy::HierA2ACollContext::process_send() {
       struct ibv_send_wr* bad_wr;
       // const std::string nvtx_name = "post_send_start_" + std::to_string(cfg_.device_id);
       // nvtxRangePushA(nvtx_name.c_str());
-      int ret = ibv_post_send(ibv_ctx_->qp_[n], &atomic_wr, &bad_wr);
+      int ret = ibv_post_send(ibv_ctx_->qp(n, 0), &atomic_wr, &bad_wr);
       PROXY_ASSERT(ret == 0);
     }
 
@@ -611,6 +635,29 @@ void IbvProxy::HierA2AvCollContext::init_buf(const M2PHierA2AvBufInit& in,
   h_max_send_size_per_dest_ = in.h_max_send_size_ / (num_procs_ * num_gpus_);
   h_max_recv_size_per_dest_ = in.h_max_recv_size_ / (num_procs_ * num_gpus_);
 
+  if (const char* env = std::getenv("HCTR_IBV_A2A_CHUNK_SIZE")) {
+    chunk_bytes_ = std::max((size_t)atoll(env), (size_t)A2A_MIN_CHUNK_SIZE);
+    if (proxy_ctx_->cfg_.proxy_id_ == 0 && my_proc_ == 0) {
+      HCTR_LOG_S(INFO, WORLD) << "Hier A2Av: pipelined RDMA write chunks of " << chunk_bytes_
+                              << " bytes" << std::endl;
+    }
+  }
+  if (ibv_ctx_->num_qps_per_peer_ > 1) {
+    if (chunk_bytes_ == 0) {
+      // Striping spreads chunks over the stripes, so chunking must be on.
+      chunk_bytes_ = std::max((size_t)(1 << 20), (size_t)A2A_MIN_CHUNK_SIZE);
+    }
+    if (proxy_ctx_->cfg_.proxy_id_ == 0 && my_proc_ == 0) {
+      HCTR_LOG_S(INFO, WORLD) << "Hier A2Av: striping over " << ibv_ctx_->num_qps_per_peer_
+                              << " QPs per peer, chunks of " << chunk_bytes_ << " bytes"
+                              << std::endl;
+    }
+    stripe_expected_writes_.assign(num_procs_, 0);
+    stripe_done_writes_.assign(num_procs_, 0);
+    // No round in flight yet.
+    fence_posted_.assign(num_procs_, (char)1);
+  }
+
   // Initialize send/recv sizes to max
   for (size_t i = 0; i < num_procs_ * num_gpus_; i++) {
     send_sizes_[i] = h_max_send_size_per_dest_;
@@ -746,6 +793,10 @@ void IbvProxy::HierA2AvCollContext::process_recv() {
 }
 
 void IbvProxy::HierA2AvCollContext::process_send() {
+  if (chunk_bytes_ > 0) {
+    process_send_chunked();
+    return;
+  }
   for (size_t i = 1; i < num_procs_; i++) {
     int n = (my_proc_ + i) % num_procs_;
     for (size_t g = 0; g < num_gpus_; g++) {
@@ -756,7 +807,7 @@ void IbvProxy::HierA2AvCollContext::process_send() {
     }
     __sync_synchronize();
     struct ibv_send_wr* bad_wr;
-    int ret = ibv_post_send(ibv_ctx_->qp_[n], &wr_[n][0], &bad_wr);
+    int ret = ibv_post_send(ibv_ctx_->qp(n, 0), &wr_[n][0], &bad_wr);
     PROXY_ASSERT(ret == 0);
   }
   // auto& cfg = proxy_ctx_->cfg_;
@@ -766,7 +817,105 @@ void IbvProxy::HierA2AvCollContext::process_send() {
   last_recv_cmd_++;
 }
 
+void IbvProxy::HierA2AvCollContext::process_send_chunked() {
+  // Latch the send sizes once, then post the chunks wave by wave, round-robin over the
+  // destination QPs, so every rail starts transferring with the first wave instead of in
+  // destination order. Only the last chunk of each message is signaled, which keeps the
+  // completion counts identical to the unchunked path; zero-length messages still post their
+  // single write for the same reason.
+  //
+  // With multiple QPs per peer the chunks additionally rotate over the peer's stripes so ECMP
+  // can spread them over different fabric paths. Every chunk is then signaled and the fence
+  // atomic is deferred to wait_send_completion(): RDMA only orders within one QP, so the
+  // atomic may go out only after the writes of all stripes have completed.
+  const size_t num_stripes = ibv_ctx_->num_qps_per_peer_;
+  const bool striped = num_stripes > 1;
+  if (striped) {
+    std::fill(stripe_expected_writes_.begin(), stripe_expected_writes_.end(), 0);
+    std::fill(stripe_done_writes_.begin(), stripe_done_writes_.end(), 0);
+    std::fill(fence_posted_.begin(), fence_posted_.end(), (char)0);
+    fence_posted_[my_proc_] = 1;
+  }
+  std::vector<size_t> send_lens(num_procs_ * num_gpus_, 0);
+  std::vector<size_t> eff_chunks(num_procs_ * num_gpus_, 0);
+  size_t max_waves = 1;
+  for (size_t i = 1; i < num_procs_; i++) {
+    int n = (my_proc_ + i) % num_procs_;
+    for (size_t g = 0; g < num_gpus_; g++) {
+      volatile size_t* send_size_ptr = (volatile size_t*)&send_sizes_[n * num_gpus_ + g];
+      size_t send_len = *send_size_ptr;
+      PROXY_ASSERT(send_len <= h_max_send_size_per_dest_);
+      send_lens[n * num_gpus_ + g] = send_len;
+      // Bound the WQE count per message so the send queue depth is never exceeded.
+      size_t eff_chunk = std::max(chunk_bytes_, (send_len + A2A_MAX_CHUNKS - 1) / A2A_MAX_CHUNKS);
+      eff_chunks[n * num_gpus_ + g] = eff_chunk;
+      max_waves = std::max(max_waves, (send_len + eff_chunk - 1) / eff_chunk);
+    }
+  }
+  __sync_synchronize();
+
+  for (size_t wave = 0; wave < max_waves; wave++) {
+    for (size_t i = 1; i < num_procs_; i++) {
+      int n = (my_proc_ + i) % num_procs_;
+      for (size_t g = 0; g < num_gpus_; g++) {
+        size_t send_len = send_lens[n * num_gpus_ + g];
+        size_t eff_chunk = eff_chunks[n * num_gpus_ + g];
+        size_t num_chunks = std::max((send_len + eff_chunk - 1) / eff_chunk, (size_t)1);
+        if (wave >= num_chunks) continue;
+        size_t offset = wave * eff_chunk;
+        const auto& wr_template = wr_[n][g];
+
+        struct ibv_send_wr wr;
+        struct ibv_sge sge;
+        memset(&wr, 0, sizeof(wr));
+        wr.wr_id = striped ? n : wr_template.wr_id;
+        sge.addr = wr_template.sg_list[0].addr + offset;
+        sge.length = (wave == num_chunks - 1) ? send_len - offset : eff_chunk;
+        sge.lkey = wr_template.sg_list[0].lkey;
+        wr.sg_list = &sge;
+        wr.num_sge = 1;
+        wr.opcode = IBV_WR_RDMA_WRITE;
+        wr.send_flags = (striped || wave == num_chunks - 1) ? IBV_SEND_SIGNALED : 0;
+        wr.wr.rdma.remote_addr = wr_template.wr.rdma.remote_addr + offset;
+        wr.wr.rdma.rkey = wr_template.wr.rdma.rkey;
+
+        if (striped) {
+          stripe_expected_writes_[n]++;
+        }
+        struct ibv_send_wr* bad_wr;
+        int ret = ibv_post_send(ibv_ctx_->qp(n, striped ? (g + wave) % num_stripes : 0), &wr,
+                                &bad_wr);
+        PROXY_ASSERT(ret == 0);
+      }
+    }
+  }
+
+  // The fence atomics go last so each QP executes them after all of its data chunks. In striped
+  // mode the fences are posted by wait_send_completion() once the writes have completed.
+  if (!striped) {
+    for (size_t i = 1; i < num_procs_; i++) {
+      int n = (my_proc_ + i) % num_procs_;
+      struct ibv_send_wr* bad_wr;
+      int ret = ibv_post_send(ibv_ctx_->qp(n, 0), &atomic_wr_[n], &bad_wr);
+      PROXY_ASSERT(ret == 0);
+    }
+  }
+
+  PROXY_ASSERT_MSG((*(h_recv_cmd_ptr_)-last_recv_cmd_) <= 2, "Can't have multiple sends inflight");
+  last_recv_cmd_++;
+}
+
+void IbvProxy::HierA2AvCollContext::post_fence(size_t peer) {
+  // Every stripe's data writes of this peer have completed, so the atomic cannot overtake them
+  // even though it travels on stripe 0 only.
+  struct ibv_send_wr* bad_wr;
+  int ret = ibv_post_send(ibv_ctx_->qp(peer, 0), &atomic_wr_[peer], &bad_wr);
+  PROXY_ASSERT(ret == 0);
+  fence_posted_[peer] = 1;
+}
+
 bool IbvProxy::HierA2AvCollContext::wait_send_completion() {
+  const bool striped = ibv_ctx_->num_qps_per_peer_ > 1 && chunk_bytes_ > 0;
   for (size_t n = 0; n < num_procs_; n++) {
     if (n == my_proc_) continue;
     struct ibv_wc wcs[4];
@@ -776,6 +925,14 @@ bool IbvProxy::HierA2AvCollContext::wait_send_completion() {
       struct ibv_wc* wc = wcs + d;
       if (wc->opcode == IBV_WC_RDMA_WRITE) {
         num_send_completions_++;
+        if (striped) {
+          const size_t peer = wc->wr_id;
+          stripe_done_writes_[peer]++;
+          if (stripe_done_writes_[peer] == stripe_expected_writes_[peer] &&
+              !fence_posted_[peer]) {
+            post_fence(peer);
+          }
+        }
       } else if (wc->opcode == IBV_WC_FETCH_ADD) {
         num_atomic_completions_++;
       } else {
@@ -786,7 +943,17 @@ bool IbvProxy::HierA2AvCollContext::wait_send_completion() {
       }
     }
   }
-  if ((num_send_completions_ == num_expected_send_completions_) &&
+  int expected_sends = num_expected_send_completions_;
+  if (striped) {
+    expected_sends = 0;
+    for (size_t n = 0; n < num_procs_; n++) {
+      expected_sends += stripe_expected_writes_[n];
+      if (n != my_proc_ && !fence_posted_[n]) {
+        return true;
+      }
+    }
+  }
+  if ((num_send_completions_ == expected_sends) &&
       (num_atomic_completions_ == num_expected_atomic_completions_)) {
     num_send_completions_ = 0;
     num_atomic_completions_ = 0;
@@ -1178,6 +1345,9 @@ void IbvProxy::ARCollContext::update_size(const size_t ar_size) {
   if (blocksize_ < cfg_min_block_) {
     blocksize_ = cfg_min_block_;
   }
+  // Keep each block splittable into whole 16B lines per rank for any local GPU count.
+  int rank_quantum = num_gpus_ * 16;
+  blocksize_ = ((blocksize_ + rank_quantum - 1) / rank_quantum) * rank_quantum;
   peer_block_ = blocksize_ / num_gpus_;
   num_blocks_ = (ar_size_ + blocksize_ - 1) / blocksize_;
   peer_block_ = (num_blocks_ > 1) ? (peer_block_) : (ar_size_ / num_gpus_);
@@ -29,6 +29,7 @@ namespace {
 
 template <typename T>
 void add_cpu(T** input, T* output, size_t size, size_t num) {
+#pragma omp parallel for
   for (size_t i = 0; i < size; i++) {
     float tmp = 0.f;
     for (size_t j = 0; j < num; j++) {
@@ -40,6 +41,7 @@ void add_cpu(T** input, T* output, size_t size, size_t num) {
 
 template <>
 void add_cpu(__half** input, __half* output, size_t size, size_t num) {
+#pragma omp parallel for
   for (size_t i = 0; i < size; i++) {
     float tmp = 0.f;
     for (size_t j = 0; j < num; j++) {
@@ -51,6 +53,7 @@ void add_cpu(__half** input, __half* output, size_t size, size_t num) {
 
 template <typename T>
 void add_dgrad_cpu(const T* top_grad, T** dgrad, size_t size, size_t num) {
+#pragma omp parallel for
   for (size_t i = 0; i < size; i++) {
     for (size_t j = 0; j < num; j++) {
       dgrad[j][i] = top_grad[i];
@@ -22,12 +22,14 @@ namespace HugeCTR {
 namespace {
 
 void cast_cpu(__half* top, const float* bottom, int len) {
+#pragma omp parallel for
   for (int i = 0; i < len; ++i) {
     top[i] = __float2half(bottom[i]);
   }
 }
 
 void cast_cpu(float* top, const __half* bottom, int len) {
+#pragma omp parallel for
   for (int i = 0; i < len; ++i) {
     top[i] = __half2float(bottom[i]);
   }
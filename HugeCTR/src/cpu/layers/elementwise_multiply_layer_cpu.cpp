@@ -31,6 +31,7 @@ template <typename T>
 void elementwise_multiply_cpu(T** input, T* output, size_t size, size_t num) {
   T one = 1.0;
 
+#pragma omp parallel for
   for (size_t i = 0; i < size; i++) {
     T tmp = one;
     for (size_t j = 0; j < num; j++) {
@@ -45,6 +46,7 @@ void elementwise_multiply_dgrad_cpu(const T* top_grad, T** dgrad, const T* fprop
                                     size_t size, size_t num) {
   T zero = 0.0;
 
+#pragma omp parallel for
   for (size_t i = 0; i < size; i++) {
     for (size_t j = 0; j < num; j++) {
       if (0 == fprop_output[i]) {
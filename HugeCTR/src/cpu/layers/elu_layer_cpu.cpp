@@ -29,6 +29,7 @@ namespace {
 
 template <typename T>
 void elu_cpu(const T* in, T* out, int len, T alpha) {
+#pragma omp parallel for
   for (int i = 0; i < len; ++i) {
     out[i] = (in[i] < 0) ? T(alpha * (exp(in[i]) - 1)) : in[i];
   }
@@ -36,6 +37,7 @@ void elu_cpu(const T* in, T* out, int len, T alpha) {
 
 template <typename T>
 void elu_bprop_cpu(const T* d_out, T* d_in, int len, T alpha) {
+#pragma omp parallel for
   for (int i = 0; i < len; ++i) {
     d_in[i] = (d_in[i] < 0) ? T(alpha * exp(d_in[i]) * d_out[i]) : d_out[i];
   }
@@ -25,6 +25,7 @@ namespace HugeCTR {
 namespace {
 
 void cpu_mm(float* a, float* b, float* c, int m, int k, int n) {
+#pragma omp parallel for
   for (int i = 0; i < m; ++i) {
     for (int j = 0; j < n; ++j) {
       c[i * n + j] = 0.0f;
@@ -34,6 +35,7 @@ void cpu_mm(float* a, float* b, float* c, int m, int k, int n) {
 }
 
 void cpu_add_bias(float* out, float* bias, int m, int n) {
+#pragma omp parallel for
   for (int i = 0; i < m; ++i) {
     for (int j = 0; j < n; ++j) {
       out[i * n + j] += bias[j];
@@ -43,6 +45,7 @@ void cpu_add_bias(float* out, float* bias, int m, int n) {
 
 void transpose(float* a, int m, int n) {
   std::unique_ptr<float[]> tmp(new float[m * n]);
+#pragma omp parallel for
   for (int i = 0; i < m; ++i)
     for (int j = 0; j < n; ++j) tmp[j * m + i] = a[i * n + j];
   for (int i = 0; i < m * n; ++i) a[i] = tmp[i];
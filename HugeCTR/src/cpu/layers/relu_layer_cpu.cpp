@@ -29,6 +29,7 @@ namespace {
 
 template <typename T>
 void relu_cpu(T* top, const T* bottom, int len) {
+#pragma omp parallel for
   for (int i = 0; i < len; ++i) {
     if (bottom[i] > T(0.)) {
       top[i] = bottom[i];
@@ -40,6 +41,7 @@ void relu_cpu(T* top, const T* bottom, int len) {
 
 template <typename T>
 void relu_bprop_cpu(T* d_bottom, const T* d_top, const T* bottom, int len) {
+#pragma omp parallel for
   for (int i = 0; i < len; ++i) {
     if (bottom[i] > T(0.)) {
       d_bottom[i] = d_top[i];
@@ -29,6 +29,7 @@ namespace {
 
 template <typename T>
 void sigmoid_cpu(T* top, const T* bottom, int len) {
+#pragma omp parallel for
   for (int i = 0; i < len; ++i) {
     top[i] = T(1.) / (T(1.) + exp(-bottom[i]));
   }
@@ -36,6 +37,7 @@ void sigmoid_cpu(T* top, const T* bottom, int len) {
 
 template <>
 void sigmoid_cpu(__half* top, const __half* bottom, int len) {
+#pragma omp parallel for
   for (int i = 0; i < len; ++i) {
     top[i] = __float2half(1.0 / (1.0 + exp(-__half2float(bottom[i]))));
   }
@@ -43,6 +45,7 @@ void sigmoid_cpu(__half* top, const __half* bottom, int len) {
 
 template <typename T>
 void sigmoid_bprop_cpu(T* d_bottom, const T* d_top, const T* bottom, int len) {
+#pragma omp parallel for
   for (int i = 0; i < len; ++i) {
     T y = T(1.) / (T(1.) + exp(-bottom[i]));
     d_bottom[i] = d_top[i] * y * (T(1.) - y);
@@ -51,6 +54,7 @@ void sigmoid_bprop_cpu(T* d_bottom, const T* d_top, const T* bottom, int len) {
 
 template <>
 void sigmoid_bprop_cpu(__half* d_bottom, const __half* d_top, const __half* bottom, int len) {
+#pragma omp parallel for
   for (int i = 0; i < len; ++i) {
     float y = 1.0 / (1.0 + exp(-__half2float(bottom[i])));
     d_bottom[i] = __float2half(__half2float(d_top[i]) * y * (1.0 - y));
@@ -14,11 +14,164 @@
  * limitations under the License.
  */
 
+#include <numa.h>
+#include <unistd.h>
+
+#include <algorithm>
 #include <common.hpp>
 #include <cpu_resource.hpp>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
 #include <utils.hpp>
 
 namespace HugeCTR {
+
+namespace {
+
+// One physical core: all SMT siblings plus the NUMA node they live on.
+struct PhysicalCore {
+  int numa_node;
+  std::vector<int> cpus;
+};
+
+// Parses a sysfs/user cpu list like "0-3,8,64-65".
+std::vector<int> parse_cpu_list(const std::string& list) {
+  std::vector<int> cpus;
+  std::stringstream ss(list);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    const size_t dash = item.find('-');
+    if (dash == std::string::npos) {
+      cpus.push_back(std::stoi(item));
+    } else {
+      const int first = std::stoi(item.substr(0, dash));
+      const int last = std::stoi(item.substr(dash + 1));
+      for (int cpu = first; cpu <= last; cpu++) {
+        cpus.push_back(cpu);
+      }
+    }
+  }
+  return cpus;
+}
+
+// Groups the online cpus into physical cores via the sysfs SMT sibling lists, sorted by
+// (NUMA node, first cpu). Falls back to one cpu per core where sysfs is unavailable.
+std::vector<PhysicalCore> detect_physical_cores() {
+  const long num_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+  std::set<int> visited;
+  std::vector<PhysicalCore> cores;
+  for (int cpu = 0; cpu < num_cpus; cpu++) {
+    if (visited.count(cpu)) {
+      continue;
+    }
+    PhysicalCore core;
+    std::ifstream siblings_file("/sys/devices/system/cpu/cpu" + std::to_string(cpu) +
+                                "/topology/thread_siblings_list");
+    std::string siblings;
+    if (siblings_file && std::getline(siblings_file, siblings)) {
+      core.cpus = parse_cpu_list(siblings);
+    }
+    if (core.cpus.empty()) {
+      core.cpus.push_back(cpu);
+    }
+    visited.insert(core.cpus.begin(), core.cpus.end());
+    core.numa_node = (numa_available() >= 0) ? numa_node_of_cpu(core.cpus.front()) : 0;
+    if (core.numa_node < 0) {
+      core.numa_node = 0;
+    }
+    cores.push_back(std::move(core));
+  }
+  std::sort(cores.begin(), cores.end(), [](const PhysicalCore& a, const PhysicalCore& b) {
+    return std::tie(a.numa_node, a.cpus.front()) < std::tie(b.numa_node, b.cpus.front());
+  });
+  return cores;
+}
+
+std::map<std::string, std::set<int>> build_core_reservation() {
+  std::map<std::string, std::set<int>> pools;
+  const char* spec = std::getenv("HCTR_CORE_RESERVATION");
+  if (spec == nullptr) {
+    return pools;
+  }
+
+  std::vector<std::pair<std::string, std::string>> entries;
+  std::stringstream ss(spec);
+  std::string entry;
+  while (std::getline(ss, entry, ';')) {
+    const size_t colon = entry.find(':');
+    HCTR_CHECK_HINT(colon != std::string::npos,
+                    "HCTR_CORE_RESERVATION entries must look like pool:cores, got: %s",
+                    entry.c_str());
+    entries.emplace_back(entry.substr(0, colon), entry.substr(colon + 1));
+  }
+
+  // First pass: explicit cpu lists. Second pass: counted pools, which are placed on whole
+  // physical cores (all SMT siblings at once) from the highest NUMA node downward, skipping
+  // anything already reserved, so counted pools neither share a physical core with each other
+  // nor with the low cores left for compute.
+  std::set<int> used;
+  for (const auto& [pool, value] : entries) {
+    if (value.find('-') != std::string::npos || value.find(',') != std::string::npos) {
+      const auto cpus = parse_cpu_list(value);
+      pools[pool].insert(cpus.begin(), cpus.end());
+      used.insert(cpus.begin(), cpus.end());
+    }
+  }
+  const auto physical_cores = detect_physical_cores();
+  for (const auto& [pool, value] : entries) {
+    if (value.find('-') != std::string::npos || value.find(',') != std::string::npos) {
+      continue;
+    }
+    const size_t count = std::stoull(value);
+    std::set<int>& cpus = pools[pool];
+    for (auto it = physical_cores.rbegin(); it != physical_cores.rend() && cpus.size() < count;
+         ++it) {
+      const bool overlaps = std::any_of(it->cpus.begin(), it->cpus.end(),
+                                        [&](int cpu) { return used.count(cpu) != 0; });
+      if (overlaps) {
+        continue;
+      }
+      cpus.insert(it->cpus.begin(), it->cpus.end());
+      used.insert(it->cpus.begin(), it->cpus.end());
+    }
+    HCTR_CHECK_HINT(cpus.size() >= count,
+                    "HCTR_CORE_RESERVATION: not enough free physical cores for pool %s",
+                    pool.c_str());
+  }
+
+  auto log = HCTR_LOG_S(INFO, ROOT);
+  log << "Core reservation:";
+  for (const auto& [pool, cpus] : pools) {
+    log << " " << pool << "={";
+    bool first = true;
+    for (int cpu : cpus) {
+      log << (first ? "" : ",") << cpu;
+      first = false;
+    }
+    log << "}";
+  }
+  log << std::endl;
+  return pools;
+}
+
+const std::map<std::string, std::set<int>>& core_reservation() {
+  static const std::map<std::string, std::set<int>> pools = build_core_reservation();
+  return pools;
+}
+
+}  // namespace
+
+bool CPUResource::core_reservation_enabled() { return !core_reservation().empty(); }
+
+const std::set<int>& CPUResource::reserved_cores(const std::string& pool) {
+  static const std::set<int> empty;
+  const auto& pools = core_reservation();
+  const auto it = pools.find(pool);
+  return (it != pools.end()) ? it->second : empty;
+}
+
 CPUResource::CPUResource(unsigned long long replica_uniform_seed,
                          const std::vector<unsigned long long> replica_variant_seeds)
     : replica_uniform_seed_(replica_uniform_seed) {
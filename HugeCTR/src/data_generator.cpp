@@ -210,6 +210,7 @@ void DataGenerator::generate() {
                               << ", Number of train samples: " << data_generator_params_.num_samples
                               << ", Number of eval samples: "
                               << data_generator_params_.eval_num_samples
+                              << ", #threads: " << data_generator_params_.num_threads
                               << ", Use power law distribution: " << use_long_tail
                               << ", alpha of power law: " << alpha << std::endl;
       check_make_dir(train_data_folder);
@@ -219,23 +220,27 @@ void DataGenerator::generate() {
             data_generator_params_.source, data_generator_params_.num_samples,
             data_generator_params_.label_dim, data_generator_params_.dense_dim,
             data_generator_params_.float_label_dense, data_generator_params_.slot_size_array,
-            data_generator_params_.nnz_array, use_long_tail, alpha);
+            data_generator_params_.nnz_array, use_long_tail, alpha, nullptr, nullptr, nullptr,
+            data_generator_params_.num_threads);
         data_generation_for_raw<long long>(
             data_generator_params_.eval_source, data_generator_params_.eval_num_samples,
             data_generator_params_.label_dim, data_generator_params_.dense_dim,
             data_generator_params_.float_label_dense, data_generator_params_.slot_size_array,
-            data_generator_params_.nnz_array, use_long_tail, alpha);
+            data_generator_params_.nnz_array, use_long_tail, alpha, nullptr, nullptr, nullptr,
+            data_generator_params_.num_threads);
       } else {
         data_generation_for_raw<unsigned int>(
             data_generator_params_.source, data_generator_params_.num_samples,
             data_generator_params_.label_dim, data_generator_params_.dense_dim,
             data_generator_params_.float_label_dense, data_generator_params_.slot_size_array,
-            data_generator_params_.nnz_array, use_long_tail, alpha);
+            data_generator_params_.nnz_array, use_long_tail, alpha, nullptr, nullptr, nullptr,
+            data_generator_params_.num_threads);
         data_generation_for_raw<unsigned int>(
             data_generator_params_.eval_source, data_generator_params_.eval_num_samples,
             data_generator_params_.label_dim, data_generator_params_.dense_dim,
             data_generator_params_.float_label_dense, data_generator_params_.slot_size_array,
-            data_generator_params_.nnz_array, use_long_tail, alpha);
+            data_generator_params_.nnz_array, use_long_tail, alpha, nullptr, nullptr, nullptr,
+            data_generator_params_.num_threads);
       }
       break;
     }
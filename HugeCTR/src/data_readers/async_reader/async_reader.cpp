@@ -7,12 +7,14 @@
 
 #include <cassert>
 #include <cstdio>
+#include <cstdlib>
 #include <filesystem>
 #include <fstream>
 #include <map>
 #include <numeric>
 #include <random>
 
+#include "base/debug/perf_counters.hpp"
 #include "common.hpp"
 #include "resource_manager.hpp"
 #include "utils.hpp"
@@ -22,7 +24,8 @@ namespace HugeCTR {
 AsyncReaderImpl::AsyncReaderImpl(std::string fname, size_t batch_size_bytes,
                                  const ResourceManager* resource_manager, int num_threads,
                                  int num_batches_per_thread, size_t io_block_size, int io_depth,
-                                 int io_alignment, bool shuffle, bool wait_for_gpu_idle)
+                                 int io_alignment, bool shuffle, bool wait_for_gpu_idle,
+                                 size_t sample_size_bytes, size_t label_dense_bytes)
     :
 
       fname_(fname),
@@ -36,11 +39,38 @@ AsyncReaderImpl::AsyncReaderImpl(std::string fname, size_t batch_size_bytes,
       io_alignment_(io_alignment),
       wait_for_gpu_idle_(wait_for_gpu_idle),
       queue_id_(0),
+      sample_size_bytes_(sample_size_bytes),
+      label_dense_bytes_(label_dense_bytes),
       thread_batch_ids_(num_threads_),
       thread_buffer_ids_(num_threads_),
       gpu_thread_ids_(num_devices_),
       local_readers_(num_threads_) {
   total_file_size_ = std::filesystem::file_size(fname);
+
+  // The file may be in the block-compressed raw format: batches are then addressed through the
+  // frame index and decompressed on the GPU after the upload.
+  compressed_ = try_load_compressed_raw_index(fname, comp_index_);
+  if (compressed_) {
+    if (comp_index_.header.batch_size_bytes != batch_size_bytes_) {
+      throw std::runtime_error("Compressed raw file " + fname +
+                               " was built for a different batch size");
+    }
+    total_file_size_ = comp_index_.header.uncompressed_size;
+  }
+
+  // Or in the aligned raw v2 format: one record group per batch at a fixed stride, addressed
+  // directly and verified against the per-group checksum segment on first read.
+  if (!compressed_) {
+    raw_v2_ = try_load_raw_v2_index(fname, v2_index_);
+  }
+  if (raw_v2_) {
+    if (v2_index_.header.samples_per_group * v2_index_.header.sample_size_bytes !=
+        batch_size_bytes_) {
+      throw std::runtime_error("Raw v2 file " + fname + " was built for a different batch size");
+    }
+    total_file_size_ = v2_index_.header.num_samples * v2_index_.header.sample_size_bytes;
+  }
+
   num_batches_ = (total_file_size_ + batch_size_bytes_ - 1) / batch_size_bytes;
   batch_ids_.resize(num_batches_);
   std::iota(batch_ids_.begin(), batch_ids_.end(), 0);
@@ -50,9 +80,18 @@ AsyncReaderImpl::AsyncReaderImpl(std::string fname, size_t batch_size_bytes,
     std::shuffle(batch_ids_.begin(), batch_ids_.end(), gen);
   }
 
+  size_t max_comp_frame_bytes = 0;
+  if (compressed_) {
+    for (size_t i = 0; i + 1 < comp_index_.frame_offsets.size(); i++) {
+      max_comp_frame_bytes = std::max(
+          max_comp_frame_bytes, comp_index_.frame_offsets[i + 1] - comp_index_.frame_offsets[i]);
+    }
+  }
+
   // Don't allocate more buffers that number of batches in the file
   buffers_.resize(std::min((size_t)num_threads_ * num_batches_per_thread, num_batches_));
-  for (auto& buf : buffers_) {
+  for (size_t buf_id = 0; buf_id < buffers_.size(); buf_id++) {
+    auto& buf = buffers_[buf_id];
     buf = std::make_unique<InternalBatchBuffer>();
     buf->dev_data.resize(num_devices_);
     for (int id = 0; id < num_devices_; id++) {
@@ -60,6 +99,13 @@ AsyncReaderImpl::AsyncReaderImpl(std::string fname, size_t batch_size_bytes,
       CudaDeviceContext ctx(device_id);
       HCTR_LIB_THROW(cudaMalloc(&buf->dev_data[id], batch_size_bytes_));
     }
+    if (compressed_) {
+      // The compressed staging lives on the device of the thread that owns this buffer.
+      int raw_id = (buf_id % num_threads_) % num_devices_;
+      auto device_id = resource_manager_->get_local_gpu(raw_id)->get_device_id();
+      CudaDeviceContext ctx(device_id);
+      HCTR_LIB_THROW(cudaMalloc(&buf->dev_comp_data, max_comp_frame_bytes));
+    }
   }
 
   streams_.resize(num_devices_);
@@ -70,6 +116,74 @@ AsyncReaderImpl::AsyncReaderImpl(std::string fname, size_t batch_size_bytes,
   }
   HCTR_LIB_THROW(cudaEventCreateWithFlags(&event_success_, cudaEventDisableTiming));
 
+  // Opt-in cooperative striping (HCTR_ASYNC_READER_STRIPED): the worker threads pull batches
+  // from a shared queue instead of fixed round-robin lists, so a straggling thread cannot idle
+  // the others at the epoch tail. The compressed path keeps the static distribution because its
+  // staging memory is tied to the owner thread's device, and wait_for_gpu_idle relies on the
+  // static thread-to-buffer mapping.
+  if (std::getenv("HCTR_ASYNC_READER_STRIPED")) {
+    if (compressed_ || wait_for_gpu_idle_) {
+      HCTR_LOG(WARNING, ROOT,
+               "HCTR_ASYNC_READER_STRIPED is ignored for compressed raw files and for "
+               "wait_for_gpu_idle mode\n");
+    } else {
+      striped_ = true;
+      HCTR_LOG(INFO, ROOT, "AsyncReader: cooperative batch striping across the IO threads\n");
+    }
+  }
+
+  // Opt-in scatter (HCTR_ASYNC_READER_SCATTER): instead of broadcasting the full batch, remote
+  // GPUs receive the sparse columns of every sample (the model-parallel embedding consumes all
+  // categoricals on every GPU) plus only their own slice's label/dense rows, cutting the
+  // inter-GPU traffic by the label+dense fraction of the sample. Requires the sample layout,
+  // which only the adapter knows; raw users of AsyncReaderImpl keep the broadcast.
+  if (std::getenv("HCTR_ASYNC_READER_SCATTER")) {
+    if (sample_size_bytes_ == 0) {
+      HCTR_LOG(WARNING, ROOT,
+               "HCTR_ASYNC_READER_SCATTER is ignored because the sample layout is unknown\n");
+    } else {
+      scatter_ = true;
+      HCTR_LOG(INFO, ROOT, "AsyncReader: scattering per-GPU label/dense slices\n");
+    }
+  }
+
+  // Opt-in GPUDirect Storage (HCTR_GDS_MOUNTS): ';'-separated path prefixes of the GDS-capable
+  // mounts, e.g. "/mnt/nvme0;/raid". A file under one of them is read by cuFile straight into
+  // the device staging buffers, skipping the host bounce and the H2D upload along with their
+  // PCIe traffic. Compressed files keep the host path (the frame goes through the on-device
+  // decompression staging), and so does wait_for_gpu_idle mode, whose upload gating lives in
+  // the H2D path that GDS bypasses.
+  if (const char* env = std::getenv("HCTR_GDS_MOUNTS")) {
+#ifdef ENABLE_GDS
+    bool on_gds_mount = false;
+    const std::string mounts(env);
+    for (size_t beg = 0; beg < mounts.size();) {
+      size_t end = mounts.find(';', beg);
+      if (end == std::string::npos) {
+        end = mounts.size();
+      }
+      if (end > beg && fname_.compare(0, end - beg, mounts, beg, end - beg) == 0) {
+        on_gds_mount = true;
+      }
+      beg = end + 1;
+    }
+    if (on_gds_mount && (compressed_ || wait_for_gpu_idle_)) {
+      HCTR_LOG(WARNING, ROOT,
+               "HCTR_GDS_MOUNTS is ignored for compressed raw files and for wait_for_gpu_idle "
+               "mode\n");
+    } else if (on_gds_mount) {
+      gds_ = true;
+      HCTR_LOG(INFO, ROOT, "AsyncReader: reading through GPUDirect Storage\n");
+    }
+#else
+    HCTR_LOG(WARNING, ROOT, "HCTR_GDS_MOUNTS is ignored, build with ENABLE_GDS to use it\n");
+#endif
+  }
+
+  const std::string labels = "{file=\"" + fname_ + "\"}";
+  perf_batches_ = &PerfCounters::get().counter("hugectr_async_reader_batches_total" + labels);
+  perf_ready_buffers_series_ = "hugectr_async_reader_ready_buffers" + labels;
+
   // For correct perf benchmarking create the thread readers upfront
   create_workers();
 }
@@ -104,15 +218,34 @@ void AsyncReaderImpl::create_workers() {
       }
     }
 
-    threads_.emplace_back(std::thread([thid, raw_id, device_id, thread_buffer_ptrs, this]() {
+    ThreadAsyncReaderParameters params{io_block_size_, io_alignment_, io_depth_, num_devices_,
+                                       wait_for_gpu_idle_, loop_,
+                                       compressed_ ? comp_index_.header.chunk_size_bytes : 0};
+    if (raw_v2_) {
+      params.v2_group_stride_bytes = v2_index_.header.group_stride_bytes;
+      params.v2_data_offset_bytes = v2_index_.header.data_offset_bytes;
+      params.v2_group_checksums = &v2_index_.group_checksums;
+    }
+    params.gds = gds_;
+    if (scatter_) {
+      params.scatter_sample_size_bytes = sample_size_bytes_;
+      params.scatter_label_dense_bytes = label_dense_bytes_;
+      params.scatter_samples_per_dev = batch_size_bytes_ / sample_size_bytes_ /
+                                       resource_manager_->get_global_gpu_count();
+      for (int id = 0; id < num_devices_; id++) {
+        params.scatter_global_dev_ids.push_back(
+            resource_manager_->get_gpu_global_id_from_local_id(id));
+      }
+    }
+
+    threads_.emplace_back(std::thread([thid, raw_id, device_id, thread_buffer_ptrs, params,
+                                       this]() {
       CudaCPUDeviceContext ctx(device_id);
 
       local_readers_[thid] = std::make_unique<ThreadAsyncReader>(
           fname_, resource_manager_, batch_size_bytes_, raw_id, streams_[raw_id],
-          thread_batch_ids_[thid], thread_buffer_ptrs,
-          ThreadAsyncReaderParameters{io_block_size_, io_alignment_, io_depth_, num_devices_,
-                                      wait_for_gpu_idle_, loop_},
-          total_file_size_);
+          thread_batch_ids_[thid], thread_buffer_ptrs, params, total_file_size_,
+          compressed_ ? &comp_index_.frame_offsets : nullptr);
     }));
   }
 
@@ -120,6 +253,16 @@ void AsyncReaderImpl::create_workers() {
     thread.join();
   }
   threads_.clear();
+
+  if (striped_) {
+    striped_buffer_ptrs_.clear();
+    for (auto& buf : buffers_) {
+      striped_buffer_ptrs_.push_back(buf.get());
+    }
+    for (auto& reader : local_readers_) {
+      reader->set_striped_source(&striped_buffer_ptrs_, &batch_ids_, &next_work_item_);
+    }
+  }
 }
 
 bool AsyncReaderImpl::is_currently_loading() { return !threads_.empty(); }
@@ -133,6 +276,18 @@ void AsyncReaderImpl::load_async() {
     throw std::runtime_error("load_async() is called before the previous load_async finished!");
   }
 
+  if (striped_) {
+    // The per-buffer state is reset here, before the threads start: in striped mode a buffer may
+    // be touched by a worker other than the one that allocated it.
+    next_work_item_.store(0);
+    for (auto& buf : buffers_) {
+      buf->striped_round.store(0);
+      buf->safe_to_upload_event.store(nullptr);
+      buf->ready_to_upload_event.store(nullptr);
+      buf->preload_done = false;
+    }
+  }
+
   for (int thid = 0; thid < num_threads_; thid++) {
     threads_.emplace_back(std::thread([thid, this]() {
       int raw_id = thid % num_devices_;
@@ -156,6 +311,18 @@ BatchDesc AsyncReaderImpl::get_batch() {
     auto status = last_buffer_->status.load();
     while (status != BufferStatus::Finished) {
       if (status == BufferStatus::ReadReady || status == BufferStatus::PermanentlyResident) {
+        perf_batches_->fetch_add(1, std::memory_order_relaxed);
+        // Queue depth at hand-out time: a depth that keeps touching zero means the consumer is
+        // starved by the IO/upload pipeline.
+        size_t num_ready = 0;
+        for (const auto& buffer : buffers_) {
+          const auto buffer_status = buffer->status.load();
+          if (buffer_status == BufferStatus::ReadReady ||
+              buffer_status == BufferStatus::PermanentlyResident) {
+            num_ready++;
+          }
+        }
+        PerfCounters::get().set_gauge(perf_ready_buffers_series_, static_cast<double>(num_ready));
         return {last_buffer_->size, last_buffer_->dev_data,
                 status == BufferStatus::PermanentlyResident, static_cast<size_t>(last_buffer_->id)};
       }
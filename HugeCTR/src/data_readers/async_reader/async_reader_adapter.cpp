@@ -46,7 +46,8 @@ AsyncReader<SparseType>::AsyncReader(std::string fname, size_t batch_size, size_
 
   reader_impl_ = std::make_unique<AsyncReaderImpl>(
       fname, batch_size_bytes, resource_manager.get(), num_threads, num_batches_per_thread,
-      io_block_size, io_depth, io_alignment, shuffle, wait_for_gpu_idle);
+      io_block_size, io_depth, io_alignment, shuffle, wait_for_gpu_idle,
+      sample_size_items_ * sizeof(InputType), (label_dim + dense_dim) * sizeof(InputType));
 
   for (uint32_t i = 0; i < resource_manager_->get_local_gpu_count(); i++) {
     auto local_gpu = resource_manager_->get_local_gpu(i);
@@ -60,6 +61,9 @@ AsyncReader<SparseType>::AsyncReader(std::string fname, size_t batch_size, size_
     s3w_streams_[i] = local_gpu->get_stream();
     d2d_streams_[i] = local_gpu->get_stream();
 
+    sparse_ready_event_handles_.push_back(local_gpu->get_event_handle("sparse_tensors_ready"));
+    dense_ready_event_handles_.push_back(local_gpu->get_event_handle("bottom_MLP_tensors_ready"));
+
     auto label_dense_buffer = std::make_shared<RawPtrBuffer>(
         batch_size_per_dev_ *
         (label_dim * sizeof(LabelType) +
@@ -215,7 +219,7 @@ long long AsyncReader<SparseType>::read_a_batch_to_device_delay_release() {
       }
     }
 
-    auto sparse_ready_event = local_gpu->get_event("sparse_tensors_ready");
+    auto sparse_ready_event = local_gpu->get_event(sparse_ready_event_handles_[i]);
     HCTR_LIB_THROW(cudaEventRecord(sparse_ready_event, stream));
 
     auto d2d_stream = d2d_streams_[i];
@@ -233,7 +237,7 @@ long long AsyncReader<SparseType>::read_a_batch_to_device_delay_release() {
     assign_dense_and_label_tensors(batch_tensors.label_tensors[i], batch_tensors.dense_tensors[i],
                                    i, d2d_stream);
 
-    auto tensors_ready_event = local_gpu->get_event("bottom_MLP_tensors_ready");
+    auto tensors_ready_event = local_gpu->get_event(dense_ready_event_handles_[i]);
     HCTR_LIB_THROW(cudaEventRecord(tensors_ready_event, d2d_stream));
   }
 
@@ -284,7 +288,9 @@ void AsyncReader<SparseType>::stream_wait_sparse_tensors(cudaStream_t stream, in
                                                          bool from_graph) {
   auto gpu = resource_manager_->get_local_gpu(raw_device_id);
   const auto flags = from_graph ? cudaEventWaitExternal : 0;
-  HCTR_LIB_THROW(cudaStreamWaitEvent(stream, gpu->get_event("sparse_tensors_ready"), flags));
+  HCTR_LIB_THROW(
+      cudaStreamWaitEvent(stream, gpu->get_event(sparse_ready_event_handles_[raw_device_id]),
+                          flags));
 }
 
 template <typename SparseType>
@@ -292,7 +298,9 @@ void AsyncReader<SparseType>::stream_wait_dense_tensors(cudaStream_t stream, int
                                                         bool from_graph) {
   auto gpu = resource_manager_->get_local_gpu(raw_device_id);
   const auto flags = from_graph ? cudaEventWaitExternal : 0;
-  HCTR_LIB_THROW(cudaStreamWaitEvent(stream, gpu->get_event("bottom_MLP_tensors_ready"), flags));
+  HCTR_LIB_THROW(
+      cudaStreamWaitEvent(stream, gpu->get_event(dense_ready_event_handles_[raw_device_id]),
+                          flags));
 }
 
 template <typename SparseType>
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2021, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstdint>
+
+#include "data_readers/async_reader/decompress_frames.hpp"
+
+namespace HugeCTR {
+
+namespace {
+
+constexpr int WARP_SIZE = 32;
+
+// Decode one LZ4 block with a full warp. All lanes parse the sequence headers redundantly (the
+// reads hit L1, so this is cheaper than broadcasting through shuffles) and the literal and match
+// copies are striped across the lanes.
+__device__ void decompress_lz4_chunk(const uint8_t* in, const uint8_t* in_end, uint8_t* out,
+                                     const int lane) {
+  while (in < in_end) {
+    const uint8_t token = *in++;
+
+    size_t lit_len = token >> 4;
+    if (lit_len == 15) {
+      uint8_t extra;
+      do {
+        extra = *in++;
+        lit_len += extra;
+      } while (extra == 255);
+    }
+    for (size_t i = lane; i < lit_len; i += WARP_SIZE) {
+      out[i] = in[i];
+    }
+    __syncwarp();
+    in += lit_len;
+    out += lit_len;
+    if (in >= in_end) {
+      break;  // the last sequence of a block carries literals only
+    }
+
+    const size_t offset = (size_t)in[0] | ((size_t)in[1] << 8);
+    in += 2;
+    size_t match_len = (size_t)(token & 0x0f) + 4;
+    if ((token & 0x0f) == 15) {
+      uint8_t extra;
+      do {
+        extra = *in++;
+        match_len += extra;
+      } while (extra == 255);
+    }
+
+    const uint8_t* match = out - offset;
+    if (offset >= WARP_SIZE) {
+      // Source and destination are at least one warp apart, so copying in warp-wide waves is
+      // safe: every wave only reads bytes the previous waves have already written.
+      for (size_t done = 0; done < match_len; done += WARP_SIZE) {
+        const size_t i = done + lane;
+        if (i < match_len) {
+          out[i] = match[i];
+        }
+        __syncwarp();
+      }
+    } else {
+      // Overlapping match (short period, e.g. run-length data): replicate byte by byte.
+      if (lane == 0) {
+        for (size_t i = 0; i < match_len; i++) {
+          out[i] = match[i];
+        }
+      }
+      __syncwarp();
+    }
+    out += match_len;
+  }
+}
+
+__global__ void decompress_lz4_frame_kernel(const char* frame, char* out, size_t chunk_size) {
+  const uint32_t num_chunks = *reinterpret_cast<const uint32_t*>(frame);
+  const uint32_t* chunk_offsets = reinterpret_cast<const uint32_t*>(frame) + 1;
+  const char* payload = reinterpret_cast<const char*>(chunk_offsets + num_chunks + 1);
+
+  const int lane = threadIdx.x % WARP_SIZE;
+  const uint32_t num_warps = (gridDim.x * blockDim.x) / WARP_SIZE;
+  for (uint32_t chunk = (blockIdx.x * blockDim.x + threadIdx.x) / WARP_SIZE; chunk < num_chunks;
+       chunk += num_warps) {
+    const uint8_t* in = reinterpret_cast<const uint8_t*>(payload + chunk_offsets[chunk]);
+    const uint8_t* in_end = reinterpret_cast<const uint8_t*>(payload + chunk_offsets[chunk + 1]);
+    uint8_t* chunk_out = reinterpret_cast<uint8_t*>(out + (size_t)chunk * chunk_size);
+    decompress_lz4_chunk(in, in_end, chunk_out, lane);
+  }
+}
+
+}  // namespace
+
+void decompress_lz4_frame_async(const char* dev_comp_frame, char* dev_out, size_t out_size,
+                                size_t chunk_size, cudaStream_t stream) {
+  const size_t num_chunks = (out_size + chunk_size - 1) / chunk_size;
+  constexpr int BLOCK_DIM = 128;
+  constexpr int WARPS_PER_BLOCK = BLOCK_DIM / WARP_SIZE;
+  const int grid_dim = static_cast<int>(
+      std::min<size_t>((num_chunks + WARPS_PER_BLOCK - 1) / WARPS_PER_BLOCK, 2048));
+  decompress_lz4_frame_kernel<<<grid_dim, BLOCK_DIM, 0, stream>>>(dev_comp_frame, dev_out,
+                                                                  chunk_size);
+}
+
+}  // namespace HugeCTR
@@ -3,6 +3,10 @@
 
 namespace HugeCTR {
 
+// DenseType is __half in mixed-precision mode: the FP32->FP16 cast is fused into the split
+// (the log-normalized dense value is stored directly as half), so no separate cast pass over
+// the dense tensor is needed downstream and the dense output occupies half the bytes.
+
 // Sparse pointer should be casted to int* when calling this kernel
 template <typename DenseType, typename SparseType>
 __global__ void split_kernel_3_way(int batch_size, float* label_ptr, int label_dim,
@@ -5,13 +5,19 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
 #include <numeric>
 #include <stdexcept>
 
 #include "common.hpp"
 #include "data_readers/async_reader/async_reader_common.hpp"
 #include "data_readers/async_reader/broadcast.hpp"
+#include "data_readers/async_reader/decompress_frames.hpp"
+#include "data_readers/async_reader/raw_v2.hpp"
 #include "resource_manager.hpp"
 
 namespace HugeCTR {
@@ -20,7 +26,8 @@ ThreadAsyncReader::ThreadAsyncReader(std::string fname, const ResourceManager* r
                                      size_t batch_size_bytes, int device_id, cudaStream_t stream,
                                      std::vector<size_t> batch_ids,
                                      std::vector<InternalBatchBuffer*> dest_buffers,
-                                     ThreadAsyncReaderParameters params, size_t total_file_size)
+                                     ThreadAsyncReaderParameters params, size_t total_file_size,
+                                     const std::vector<size_t>* comp_frame_offsets)
     : batch_size_bytes_(batch_size_bytes),
       device_id_(device_id),
       stream_(stream),
@@ -28,6 +35,7 @@ ThreadAsyncReader::ThreadAsyncReader(std::string fname, const ResourceManager* r
       batch_ids_(batch_ids),
       dest_buffers_(dest_buffers),
       params_(params),
+      comp_frame_offsets_(comp_frame_offsets),
       num_buffers_waiting_io_(0) {
 #if (__cplusplus >= 201703L)
   static_assert(std::atomic<BufferStatus>::is_always_lock_free &&
@@ -43,7 +51,22 @@ ThreadAsyncReader::ThreadAsyncReader(std::string fname, const ResourceManager* r
     throw std::runtime_error("No such file: " + fname);
   };
 
-  max_num_blocks_per_batch_ = batch_size_bytes_ / params_.io_block_size + 2;
+  size_t max_batch_io_bytes = batch_size_bytes_;
+  if (comp_frame_offsets_) {
+    // Compressed frames vary in size, the staging has to fit the largest one.
+    max_batch_io_bytes = 0;
+    for (size_t i = 0; i + 1 < comp_frame_offsets_->size(); i++) {
+      max_batch_io_bytes =
+          std::max(max_batch_io_bytes, (*comp_frame_offsets_)[i + 1] - (*comp_frame_offsets_)[i]);
+    }
+  }
+  if (params_.v2_group_stride_bytes > 0) {
+    // v2 groups are padded to the group stride, which the aligned reads cover in full.
+    max_batch_io_bytes = params_.v2_group_stride_bytes;
+    assert(params_.v2_group_stride_bytes % params_.io_alignment == 0);
+    v2_group_verified_.resize(params_.v2_group_checksums->size(), 0);
+  }
+  max_num_blocks_per_batch_ = max_batch_io_bytes / params_.io_block_size + 2;
   for (auto buf : dest_buffers_) {
     HCTR_LIB_THROW(
         cudaMallocHost(&buf->raw_host_ptr, max_num_blocks_per_batch_ * params_.io_block_size));
@@ -51,18 +74,58 @@ ThreadAsyncReader::ThreadAsyncReader(std::string fname, const ResourceManager* r
 
     HCTR_LIB_THROW(cudaEventCreateWithFlags(&buf->event, cudaEventDisableTiming));
 
+#ifndef ENABLE_IO_URING
     buf->io_reqs.resize(max_num_blocks_per_batch_);
     for (auto& req : buf->io_reqs) {
       req = new iocb;
     }
+#endif
+  }
+
+#ifdef ENABLE_GDS
+  if (params_.gds) {
+    // One cuFile driver session per process; any failure falls back to the host staging path.
+    static std::once_flag driver_once;
+    static bool driver_ok = false;
+    std::call_once(driver_once, [] { driver_ok = (cuFileDriverOpen().err == CU_FILE_SUCCESS); });
+
+    CUfileDescr_t descr;
+    memset(&descr, 0, sizeof(descr));
+    descr.handle.fd = fd_;
+    descr.type = CU_FILE_HANDLE_TYPE_OPAQUE_FD;
+    if (driver_ok && cuFileHandleRegister(&gds_handle_, &descr).err == CU_FILE_SUCCESS) {
+      gds_enabled_ = true;
+      // Best effort: an unregistered buffer still works through cuFile's internal staging. Only
+      // this thread's own buffers are registered; in striped mode reads into foreign buffers
+      // take the unregistered path, like the unregistered reads of the striped io_uring setup.
+      for (auto buf : dest_buffers_) {
+        cuFileBufRegister(buf->dev_data[device_id_], batch_size_bytes_, 0);
+      }
+    } else {
+      HCTR_LOG(WARNING, ROOT, "cuFile initialization failed, falling back to host staging\n");
+    }
   }
+#endif
 
   for (auto buf : dest_buffers_) {
     buf->status.store(BufferStatus::IOReady);
   }
 }
 
+void ThreadAsyncReader::set_striped_source(const std::vector<InternalBatchBuffer*>* all_buffers,
+                                           const std::vector<size_t>* all_batch_ids,
+                                           std::atomic<size_t>* next_work_item) {
+  striped_buffers_ = all_buffers;
+  striped_batch_ids_ = all_batch_ids;
+  striped_next_work_item_ = next_work_item;
+}
+
 void ThreadAsyncReader::load() {
+  if (striped_buffers_ != nullptr) {
+    load_striped();
+    return;
+  }
+
   size_t num_batches = batch_ids_.size();
   size_t processed = 0;
   std::vector<size_t> id_per_host_buffer(num_dest_buffers_);
@@ -75,10 +138,40 @@ void ThreadAsyncReader::load() {
     buf->preload_done = false;
   }
 
+#ifdef ENABLE_IO_URING
+  // The ring is sized so that one full batch per destination buffer fits without a flush.
+  const unsigned int ring_depth = num_dest_buffers_ * max_num_blocks_per_batch_;
+  io_uring_params ring_params;
+  memset(&ring_params, 0, sizeof(ring_params));
+  ring_params.flags = IORING_SETUP_SQPOLL;
+  ring_params.sq_thread_idle = 2000;
+  if (io_uring_queue_init_params(ring_depth, &ring_, &ring_params) < 0) {
+    // SQPOLL requires privileges on older kernels, fall back to syscall submission.
+    memset(&ring_params, 0, sizeof(ring_params));
+    if (io_uring_queue_init_params(ring_depth, &ring_, &ring_params) < 0) {
+      throw std::runtime_error("io_uring_queue_init failed");
+    }
+  }
+
+  // Register the staging buffers and the file descriptor once, so the kernel does not have to pin
+  // the pages and resolve the fd on every request. Also mandatory for SQPOLL mode.
+  std::vector<iovec> buffer_iovecs(num_dest_buffers_);
+  for (int i = 0; i < num_dest_buffers_; i++) {
+    buffer_iovecs[i].iov_base = dest_buffers_[i]->raw_host_ptr;
+    buffer_iovecs[i].iov_len = (size_t)max_num_blocks_per_batch_ * params_.io_block_size;
+  }
+  if (io_uring_register_buffers(&ring_, buffer_iovecs.data(), num_dest_buffers_) < 0) {
+    throw std::runtime_error("io_uring_register_buffers failed");
+  }
+  if (io_uring_register_files(&ring_, &fd_, 1) < 0) {
+    throw std::runtime_error("io_uring_register_files failed");
+  }
+#else
   ioctx_ = 0;
   if (io_queue_init(params_.io_depth, &ioctx_) < 0) {
     throw std::runtime_error("io_setup failed");
   }
+#endif
 
   while (status_.load() != WorkerStatus::Terminate) {
     // bool all_resident = true;
@@ -125,9 +218,13 @@ void ThreadAsyncReader::load() {
     }
   }
 
+#ifdef ENABLE_IO_URING
+  io_uring_queue_exit(&ring_);
+#else
   if (io_destroy(ioctx_) < 0) {
     throw std::runtime_error("io_destroy failed");
   }
+#endif
 
   HCTR_LIB_THROW(cudaStreamSynchronize(stream_));
 
@@ -141,8 +238,129 @@ void ThreadAsyncReader::load() {
   }
 }
 
+/* Cooperative striping: instead of walking a fixed per-thread batch list, every worker pulls the
+ * next position of the global consumption order from a queue shared by all workers. A straggling
+ * thread then no longer idles the others at the epoch tail -- whoever is free grabs the next
+ * extent. Position p of an epoch always lands in buffer p % num_buffers, exactly like the static
+ * distribution, so the consumer still sees the batches in order; per-buffer round counters keep
+ * claims of the same buffer by different threads correctly sequenced. */
+void ThreadAsyncReader::load_striped() {
+  const auto& buffers = *striped_buffers_;
+  const size_t num_buffers = buffers.size();
+  const size_t num_batches = striped_batch_ids_->size();
+  // Same in-flight depth per thread as in the static mode
+  const size_t max_claimed = num_dest_buffers_;
+
+  status_.store(WorkerStatus::OK);
+
+#ifdef ENABLE_IO_URING
+  const unsigned int ring_depth = num_dest_buffers_ * max_num_blocks_per_batch_;
+  io_uring_params ring_params;
+  memset(&ring_params, 0, sizeof(ring_params));
+  ring_params.flags = IORING_SETUP_SQPOLL;
+  ring_params.sq_thread_idle = 2000;
+  if (io_uring_queue_init_params(ring_depth, &ring_, &ring_params) < 0) {
+    // SQPOLL requires privileges on older kernels, fall back to syscall submission.
+    memset(&ring_params, 0, sizeof(ring_params));
+    if (io_uring_queue_init_params(ring_depth, &ring_, &ring_params) < 0) {
+      throw std::runtime_error("io_uring_queue_init failed");
+    }
+  }
+  // Only the fd is registered here: any worker may read into any staging buffer in this mode, so
+  // the buffers cannot be pinned to a single ring and plain reads are used instead of fixed ones.
+  if (io_uring_register_files(&ring_, &fd_, 1) < 0) {
+    throw std::runtime_error("io_uring_register_files failed");
+  }
+#else
+  ioctx_ = 0;
+  if (io_queue_init(params_.io_depth, &ioctx_) < 0) {
+    throw std::runtime_error("io_setup failed");
+  }
+#endif
+
+  struct WorkItem {
+    size_t batch_id;
+    size_t round;
+    InternalBatchBuffer* buffer;
+  };
+  std::vector<WorkItem> claimed;
+  claimed.reserve(max_claimed);
+  bool exhausted = false;
+
+  while (status_.load() != WorkerStatus::Terminate) {
+    while (!exhausted && claimed.size() < max_claimed) {
+      const size_t item = striped_next_work_item_->fetch_add(1);
+      if (!params_.loop && item >= num_batches) {
+        exhausted = true;
+        break;
+      }
+      // In loop mode the queue head keeps growing; every epoch restarts at buffer 0, matching the
+      // consumer's wrap in finalize_batch.
+      const size_t epoch = item / num_batches;
+      const size_t pos = item % num_batches;
+      const size_t buf_id = pos % num_buffers;
+      const size_t rounds_per_epoch = (num_batches - buf_id + num_buffers - 1) / num_buffers;
+      claimed.push_back({(*striped_batch_ids_)[pos], epoch * rounds_per_epoch + pos / num_buffers,
+                         buffers[buf_id]});
+    }
+    for (auto& work : claimed) {
+      // A buffer accepts a work item only in its round, so two workers holding successive
+      // positions of the same buffer cannot reorder them.
+      if (work.round == work.buffer->striped_round.load()) {
+        try_submit_io_to(work.buffer, work.batch_id, -1);
+      }
+    }
+    wait_io();
+    for (auto it = claimed.begin(); it != claimed.end();) {
+      if (it->round != it->buffer->striped_round.load()) {
+        ++it;  // an earlier work item of this buffer is still in flight
+        continue;
+      }
+      try_submit_p2p(it->buffer);
+      try_submit_upload(it->buffer);
+      if (check_completion(it->buffer) ||
+          it->buffer->status.load() == BufferStatus::PermanentlyResident) {
+        it->buffer->striped_round.fetch_add(1);
+        it = claimed.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    usleep(10);
+    if (exhausted && claimed.empty()) {
+      break;
+    }
+  }
+
+#ifdef ENABLE_IO_URING
+  io_uring_queue_exit(&ring_);
+#else
+  if (io_destroy(ioctx_) < 0) {
+    throw std::runtime_error("io_destroy failed");
+  }
+#endif
+
+  HCTR_LIB_THROW(cudaStreamSynchronize(stream_));
+
+  if (status_.load() != WorkerStatus::Terminate) {
+    for (auto buf : dest_buffers_) {
+      BufferStatus expected = BufferStatus::IOReady;
+      while (!buf->status.compare_exchange_weak(expected, BufferStatus::Finished)) {
+        if (expected == BufferStatus::PermanentlyResident) {
+          break;  // resident batches stay servable from the cache
+        }
+        expected = BufferStatus::IOReady;
+      }
+    }
+  }
+}
+
 void ThreadAsyncReader::try_submit_io(size_t batch_id, int io_id) {
-  auto& buffer = dest_buffers_[io_id];
+  try_submit_io_to(dest_buffers_[io_id], batch_id, io_id);
+}
+
+void ThreadAsyncReader::try_submit_io_to(InternalBatchBuffer* buffer, size_t batch_id,
+                                         int reg_index) {
   if (buffer->status.load() != BufferStatus::IOReady) {
     return;
   }
@@ -155,27 +373,117 @@ void ThreadAsyncReader::try_submit_io(size_t batch_id, int io_id) {
 
   buffer->status.store(BufferStatus::IOInProcess);
 
-  size_t req_beg_offset = batch_id * batch_size_bytes_;
-  size_t req_end_offset = std::min((batch_id + 1) * batch_size_bytes_, total_file_size_);
-  size_t raw_beg_offset = (req_beg_offset / params_.io_block_size) * params_.io_block_size;
-  size_t raw_end_offset = ((req_end_offset + params_.io_block_size - 1) / params_.io_block_size) *
-                          params_.io_block_size;
-  size_t num_blocks = (raw_end_offset - raw_beg_offset) / params_.io_block_size;
+  size_t req_beg_offset, req_end_offset;
+  if (comp_frame_offsets_) {
+    req_beg_offset = (*comp_frame_offsets_)[batch_id];
+    req_end_offset = (*comp_frame_offsets_)[batch_id + 1];
+  } else if (params_.v2_group_stride_bytes > 0) {
+    req_beg_offset = params_.v2_data_offset_bytes + batch_id * params_.v2_group_stride_bytes;
+    req_end_offset = req_beg_offset + params_.v2_group_stride_bytes;
+  } else {
+    req_beg_offset = batch_id * batch_size_bytes_;
+    req_end_offset = std::min((batch_id + 1) * batch_size_bytes_, total_file_size_);
+  }
+  size_t raw_beg_offset, raw_end_offset;
+  if (params_.v2_group_stride_bytes > 0) {
+    // v2 group boundaries are aligned by construction: no over-read, the payload lands at the
+    // start of the staging buffer.
+    raw_beg_offset = req_beg_offset;
+    raw_end_offset = req_end_offset;
+  } else {
+    raw_beg_offset = (req_beg_offset / params_.io_block_size) * params_.io_block_size;
+    raw_end_offset = ((req_end_offset + params_.io_block_size - 1) / params_.io_block_size) *
+                     params_.io_block_size;
+  }
+  size_t num_blocks =
+      (raw_end_offset - raw_beg_offset + params_.io_block_size - 1) / params_.io_block_size;
   assert(num_blocks <= (size_t)max_num_blocks_per_batch_);
 
   buffer->id = batch_id;
+  buffer->raw_device_id = device_id_;
   buffer->num_outstanding_reqs = num_blocks;
   buffer->num_submitted_h2d_chunks = 0;
   buffer->num_submitted_broadcasts = 0;
-  buffer->size = req_end_offset - req_beg_offset;
+  if (comp_frame_offsets_) {
+    // buffer->size stays the uncompressed batch size the consumers see.
+    buffer->size = std::min((batch_id + 1) * batch_size_bytes_, total_file_size_) -
+                   batch_id * batch_size_bytes_;
+    buffer->comp_size = req_end_offset - req_beg_offset;
+  } else if (params_.v2_group_stride_bytes > 0) {
+    // The group padding is read but never surfaced to the consumers.
+    buffer->size = std::min((batch_id + 1) * batch_size_bytes_, total_file_size_) -
+                   batch_id * batch_size_bytes_;
+  } else {
+    buffer->size = req_end_offset - req_beg_offset;
+  }
   buffer->host_data = buffer->raw_host_ptr + (req_beg_offset - raw_beg_offset);
   assert(buffer->size % sizeof(float) == 0);
 
+#ifdef ENABLE_GDS
+  if (gds_enabled_) {
+    // The read lands in device memory right away, not on the worker stream: wait on the host for
+    // the consumers of the previous batch in this buffer before overwriting it.
+    auto safe_event = buffer->safe_to_upload_event.load();
+    if (safe_event != nullptr) {
+      HCTR_LIB_THROW(cudaEventSynchronize(*safe_event));
+    }
+    // Only the payload is read (a v2 group's padding would overrun the device buffer); cuFile
+    // handles the unaligned tail itself. The v2 first-read checksum is skipped on this path, the
+    // bytes never visit the host.
+    const ssize_t ret =
+        cuFileRead(gds_handle_, buffer->dev_data[device_id_], buffer->size, req_beg_offset, 0);
+    if (ret != (ssize_t)buffer->size) {
+      throw std::runtime_error("cuFileRead failed");
+    }
+    buffer->num_outstanding_reqs = 0;
+    // The bytes are already on the device: skip the H2D upload and go straight to the broadcast.
+    buffer->num_submitted_h2d_chunks = params_.num_h2d_chunks;
+    buffer->status.store(BufferStatus::UploadInProcess);
+    return;
+  }
+#endif
+
+#ifdef ENABLE_IO_URING
+  for (size_t block = 0; block < num_blocks; block++) {
+    // The tail block of a v2 group may be shorter than io_block_size (still io-aligned).
+    const size_t block_beg = params_.io_block_size * block;
+    const size_t block_len =
+        std::min(params_.io_block_size, raw_end_offset - raw_beg_offset - block_beg);
+    io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+    while (sqe == nullptr) {
+      // Submission queue is full, flush it to the kernel and retry.
+      if (io_uring_submit(&ring_) < 0) {
+        throw std::runtime_error("io_uring_submit failed");
+      }
+      sqe = io_uring_get_sqe(&ring_);
+    }
+    if (reg_index >= 0) {
+      // Reads address the pre-registered staging buffer (buf_index == reg_index) and the
+      // pre-registered file descriptor (index 0).
+      io_uring_prep_read_fixed(sqe, 0, buffer->raw_host_ptr + block_beg, block_len,
+                               raw_beg_offset + block_beg, reg_index);
+    } else {
+      // Striped mode: the buffer is not registered with this ring (see load_striped).
+      io_uring_prep_read(sqe, 0, buffer->raw_host_ptr + block_beg, block_len,
+                         raw_beg_offset + block_beg);
+    }
+    sqe->flags |= IOSQE_FIXED_FILE;
+    io_uring_sqe_set_data(sqe, buffer);
+  }
+  num_buffers_waiting_io_ += 1;
+  if (io_uring_submit(&ring_) < 0) {
+    throw std::runtime_error("io_uring_submit failed");
+  }
+#else
   for (size_t block = 0; block < num_blocks; block++) {
     auto req = buffer->io_reqs[block];
 
-    io_prep_pread(req, fd_, buffer->raw_host_ptr + params_.io_block_size * block,
-                  params_.io_block_size, raw_beg_offset + params_.io_block_size * block);
+    // The tail block of a v2 group may be shorter than io_block_size (still io-aligned).
+    const size_t block_beg = params_.io_block_size * block;
+    const size_t block_len =
+        std::min(params_.io_block_size, raw_end_offset - raw_beg_offset - block_beg);
+    io_prep_pread(req, fd_, buffer->raw_host_ptr + block_beg, block_len,
+                  raw_beg_offset + block_beg);
     req->data = (void*)buffer;
   }
 
@@ -184,12 +492,33 @@ void ThreadAsyncReader::try_submit_io(size_t batch_id, int io_id) {
   if (ret < 0) {
     throw std::runtime_error("io_submit failed");
   }
+#endif
 }
 
 void ThreadAsyncReader::wait_io() {
-  // if (num_buffers_waiting_io_ <= 0) {
-  //   return;
-  // }
+#ifdef ENABLE_IO_URING
+  __kernel_timespec timeout = {0, 10'000l};
+  io_uring_cqe* cqe = nullptr;
+  int ret = io_uring_wait_cqe_timeout(&ring_, &cqe, &timeout);
+  if (ret == -ETIME || ret == -EINTR) {
+    return;
+  }
+  if (ret < 0) {
+    throw std::runtime_error("io_uring_wait_cqe_timeout failed");
+  }
+
+  // Drain everything that has completed so far.
+  while (true) {
+    if (cqe->res < 0) {
+      throw std::runtime_error("io_uring read failed");
+    }
+    finish_io_request((InternalBatchBuffer*)io_uring_cqe_get_data(cqe));
+    io_uring_cqe_seen(&ring_, cqe);
+    if (io_uring_peek_cqe(&ring_, &cqe) < 0) {
+      break;
+    }
+  }
+#else
   timespec timeout = {0, 10'000l};
   io_event events[max_num_blocks_per_batch_];
   int num_completed =
@@ -200,15 +529,29 @@ void ThreadAsyncReader::wait_io() {
 
   for (int b = 0; b < num_completed; b++) {
     auto req = events[b].obj;
-    auto buffer = (InternalBatchBuffer*)req->data;
-    buffer->num_outstanding_reqs--;
-    assert(buffer->num_outstanding_reqs >= 0);
-    if (buffer->num_outstanding_reqs == 0) {
-      num_buffers_waiting_io_ -= 1;
-      buffer->status.store(BufferStatus::UploadInProcess);
-      if (params_.wait_for_gpu_idle) {
-        buffer->ready_to_upload_event.store(nullptr);
+    finish_io_request((InternalBatchBuffer*)req->data);
+  }
+#endif
+}
+
+void ThreadAsyncReader::finish_io_request(InternalBatchBuffer* buffer) {
+  buffer->num_outstanding_reqs--;
+  assert(buffer->num_outstanding_reqs >= 0);
+  if (buffer->num_outstanding_reqs == 0) {
+    // A v2 group is verified against its stored checksum the first time it lands here; once a
+    // group passed, re-reads of it in later epochs skip the CRC.
+    if (params_.v2_group_checksums && !v2_group_verified_[buffer->id]) {
+      const uint32_t crc = raw_v2_crc32(buffer->host_data, buffer->size);
+      if (crc != (*params_.v2_group_checksums)[buffer->id]) {
+        throw std::runtime_error("Raw v2 checksum mismatch in record group " +
+                                 std::to_string(buffer->id));
       }
+      v2_group_verified_[buffer->id] = 1;
+    }
+    num_buffers_waiting_io_ -= 1;
+    buffer->status.store(BufferStatus::UploadInProcess);
+    if (params_.wait_for_gpu_idle) {
+      buffer->ready_to_upload_event.store(nullptr);
     }
   }
 }
@@ -241,14 +584,23 @@ void ThreadAsyncReader::try_submit_upload(InternalBatchBuffer* buffer) {
     HCTR_LIB_THROW(cudaStreamWaitEvent(stream_, *buffer->safe_to_upload_event));
   }
 
-  size_t chunk_size = (buffer->size + params_.num_h2d_chunks - 1) / params_.num_h2d_chunks;
+  // For compressed files the frame goes to the compressed staging area first.
+  const size_t upload_size = comp_frame_offsets_ ? buffer->comp_size : buffer->size;
+  char* upload_dst = comp_frame_offsets_ ? buffer->dev_comp_data : buffer->dev_data[device_id_];
+
+  size_t chunk_size = (upload_size + params_.num_h2d_chunks - 1) / params_.num_h2d_chunks;
   size_t beg_offset = chunk_size * buffer->num_submitted_h2d_chunks;
-  size_t end_offset = std::min(buffer->size, chunk_size * (buffer->num_submitted_h2d_chunks + 1));
+  size_t end_offset = std::min(upload_size, chunk_size * (buffer->num_submitted_h2d_chunks + 1));
 
-  HCTR_LIB_THROW(cudaMemcpyAsync(buffer->dev_data[device_id_] + beg_offset,
-                                 buffer->host_data + beg_offset, end_offset - beg_offset,
-                                 cudaMemcpyHostToDevice, stream_));
+  HCTR_LIB_THROW(cudaMemcpyAsync(upload_dst + beg_offset, buffer->host_data + beg_offset,
+                                 end_offset - beg_offset, cudaMemcpyHostToDevice, stream_));
   buffer->num_submitted_h2d_chunks++;
+
+  if (comp_frame_offsets_ && buffer->num_submitted_h2d_chunks == params_.num_h2d_chunks) {
+    // All compressed bytes are on-device, expand them into the batch buffer before the broadcast.
+    decompress_lz4_frame_async(buffer->dev_comp_data, buffer->dev_data[device_id_], buffer->size,
+                               params_.comp_chunk_size, stream_);
+  }
 }
 
 void ThreadAsyncReader::try_submit_p2p(InternalBatchBuffer* buffer) {
@@ -262,10 +614,33 @@ void ThreadAsyncReader::try_submit_p2p(InternalBatchBuffer* buffer) {
 
   // Broadcast to the other GPUs
   if (buffer->num_submitted_broadcasts != (int)buffer->dev_data.size()) {
-    if (device_id_ != buffer->num_submitted_broadcasts) {
-      HCTR_LIB_THROW(cudaMemcpyAsync(buffer->dev_data[buffer->num_submitted_broadcasts],
-                                     buffer->dev_data[device_id_], buffer->size,
-                                     cudaMemcpyDeviceToDevice, stream_));
+    const int dst = buffer->num_submitted_broadcasts;
+    if (device_id_ != dst) {
+      if (params_.scatter_sample_size_bytes > 0) {
+        // Scatter mode: every GPU consumes all categoricals (model-parallel embedding) but only
+        // its own slice's label/dense rows, so the other slices' label/dense bytes are skipped.
+        const size_t sample_bytes = params_.scatter_sample_size_bytes;
+        const size_t ld_bytes = params_.scatter_label_dense_bytes;
+        const size_t num_samples = buffer->size / sample_bytes;
+        HCTR_LIB_THROW(cudaMemcpy2DAsync(buffer->dev_data[dst] + ld_bytes, sample_bytes,
+                                         buffer->dev_data[device_id_] + ld_bytes, sample_bytes,
+                                         sample_bytes - ld_bytes, num_samples,
+                                         cudaMemcpyDeviceToDevice, stream_));
+        const size_t slice_beg = std::min(
+            params_.scatter_global_dev_ids[dst] * params_.scatter_samples_per_dev, num_samples);
+        const size_t slice_end =
+            std::min((params_.scatter_global_dev_ids[dst] + 1) * params_.scatter_samples_per_dev,
+                     num_samples);
+        if (slice_end > slice_beg) {
+          HCTR_LIB_THROW(cudaMemcpy2DAsync(
+              buffer->dev_data[dst] + slice_beg * sample_bytes, sample_bytes,
+              buffer->dev_data[device_id_] + slice_beg * sample_bytes, sample_bytes, ld_bytes,
+              slice_end - slice_beg, cudaMemcpyDeviceToDevice, stream_));
+        }
+      } else {
+        HCTR_LIB_THROW(cudaMemcpyAsync(buffer->dev_data[dst], buffer->dev_data[device_id_],
+                                       buffer->size, cudaMemcpyDeviceToDevice, stream_));
+      }
     }
     buffer->num_submitted_broadcasts++;
     return;
@@ -305,6 +680,15 @@ void ThreadAsyncReader::reset() {
   }
 }
 
-ThreadAsyncReader::~ThreadAsyncReader() = default;
+ThreadAsyncReader::~ThreadAsyncReader() {
+#ifdef ENABLE_GDS
+  if (gds_enabled_) {
+    for (auto buf : dest_buffers_) {
+      cuFileBufDeregister(buf->dev_data[device_id_]);
+    }
+    cuFileHandleDeregister(gds_handle_);
+  }
+#endif
+}
 
 }  // namespace HugeCTR
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2021, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cub/cub.cuh>
+
+#include "HugeCTR/include/common.hpp"
+#include "HugeCTR/include/data_readers/csr_gpu_assembly.hpp"
+
+namespace HugeCTR {
+
+template <typename T>
+size_t get_csr_assembly_temp_storage_bytes(size_t num_row_offsets) {
+  size_t temp_storage_bytes = 0;
+  HCTR_LIB_THROW(cub::DeviceScan::ExclusiveSum(nullptr, temp_storage_bytes, (const T*)nullptr,
+                                               (T*)nullptr, num_row_offsets));
+  return temp_storage_bytes;
+}
+
+template <typename T>
+void assemble_csr_row_offsets(const T* d_slot_nnz, size_t num_row_offsets, T* d_row_offset,
+                              void* d_temp_storage, size_t temp_storage_bytes,
+                              cudaStream_t stream) {
+  HCTR_LIB_THROW(cub::DeviceScan::ExclusiveSum(d_temp_storage, temp_storage_bytes, d_slot_nnz,
+                                               d_row_offset, num_row_offsets, stream));
+}
+
+template size_t get_csr_assembly_temp_storage_bytes<unsigned int>(size_t num_row_offsets);
+template size_t get_csr_assembly_temp_storage_bytes<long long>(size_t num_row_offsets);
+
+template void assemble_csr_row_offsets<unsigned int>(const unsigned int* d_slot_nnz,
+                                                     size_t num_row_offsets,
+                                                     unsigned int* d_row_offset,
+                                                     void* d_temp_storage,
+                                                     size_t temp_storage_bytes,
+                                                     cudaStream_t stream);
+template void assemble_csr_row_offsets<long long>(const long long* d_slot_nnz,
+                                                  size_t num_row_offsets, long long* d_row_offset,
+                                                  void* d_temp_storage, size_t temp_storage_bytes,
+                                                  cudaStream_t stream);
+
+}  // namespace HugeCTR
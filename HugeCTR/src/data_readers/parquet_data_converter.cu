@@ -131,6 +131,16 @@ __global__ void dense_data_converter_kernel__(int64_t *dense_data_column_ptrs, c
   }
 }
 
+// lengths of a ragged list column derived from its row offsets; offset-difference form so the
+// result is independent of where the column view starts within the underlying buffer
+template <typename T>
+__global__ void list_length_kernel__(const int32_t *row_offsets, int num_rows, T *length_out) {
+  int row_idx = threadIdx.x + (blockDim.x * blockIdx.x);
+  if (row_idx < num_rows) {
+    length_out[row_idx] = static_cast<T>(row_offsets[row_idx + 1] - row_offsets[row_idx]);
+  }
+}
+
 // caution that the input row_offset is always int32_t (According to the cudf definition)
 // the output row_offset can be flexible: a template parameter
 template <typename T>
@@ -285,6 +295,14 @@ void convert_parquet_dense_columns(std::vector<T *> &dense_column_data_ptr, cons
                                    rmm::mr::device_memory_resource *mr, cudaStream_t task_stream) {
   int samples_to_interleaved = batch_size;
 
+  // The converter kernels below overwrite every element of the first batch_size samples, so only
+  // the tail of an incomplete batch needs to be zero-filled instead of a full pass over the buffer
+  if (samples_to_interleaved < batch_end - batch_start) {
+    HCTR_LIB_THROW(cudaMemsetAsync(
+        dense_data_buffers + (size_t)samples_to_interleaved * label_dense_dim, 0,
+        sizeof(T) * label_dense_dim * (batch_end - batch_start - samples_to_interleaved),
+        task_stream));
+  }
   if (!samples_to_interleaved) return;
   size_t size_of_col_ptrs = dense_column_data_ptr.size() * sizeof(T *);
   std::memcpy(dev_ptr_staging, dense_column_data_ptr.data(), size_of_col_ptrs);
@@ -299,8 +317,6 @@ void convert_parquet_dense_columns(std::vector<T *> &dense_column_data_ptr, cons
   // 12 warps -> 384 threads/block
   // size_t smem_size = 48 * 1024 * 1024;
 
-  HCTR_LIB_THROW(cudaMemsetAsync(
-      dense_data_buffers, 0, sizeof(T) * label_dense_dim * (batch_end - batch_start), task_stream));
   // all dense columns' type is scalar
   if (num_dense == label_dense_dim) {
     dim3 block(256, 1, 1);
@@ -319,6 +335,24 @@ void convert_parquet_dense_columns(std::vector<T *> &dense_column_data_ptr, cons
   return;
 }
 
+/**
+ * Materialize the per-sample lengths of a ragged (variable-length list) parquet column so that
+ * they can be consumed as a width-1 dense feature, e.g. by SequenceMaskLayer
+ * @param length_out device buffer of num_rows elements to write the lengths to
+ * @param row_offsets row offsets of the list column (num_rows + 1 elements, cudf child(0))
+ * @param num_rows number of samples in the column
+ * @param task_stream Stream to launch the kernel
+ */
+template <typename T>
+void extract_parquet_list_lengths(T *length_out, const int32_t *row_offsets, int num_rows,
+                                  cudaStream_t task_stream) {
+  if (num_rows <= 0) return;
+  dim3 block(256, 1, 1);
+  dim3 grid((num_rows - 1) / block.x + 1, 1, 1);
+  list_length_kernel__<T><<<grid, block, 0, task_stream>>>(row_offsets, num_rows, length_out);
+  HCTR_LIB_THROW(cudaGetLastError());
+}
+
 /**
  * Interleave categoricals (slot) data parquet columns and write to csr buffers
  * @param cat_column_data_ptr vector of device pointers to Parquet columns
@@ -453,6 +487,9 @@ template void convert_parquet_dense_columns<float>(
     std::deque<rmm::device_buffer> &rmm_resources, rmm::mr::device_memory_resource *mr,
     cudaStream_t task_stream);
 
+template void extract_parquet_list_lengths<float>(float *length_out, const int32_t *row_offsets,
+                                                  int num_rows, cudaStream_t task_stream);
+
 template size_t convert_parquet_cat_columns<long long int>(
     std::vector<long long int *> &cat_column_data_ptr,
     std::vector<int32_t *> &cat_column_row_offset_ptr, int view_offset, int num_params,
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <curand_kernel.h>
+
 #include <data_simulator.hpp>
 #include <diagnose.hpp>
 #include <random>
@@ -35,6 +37,38 @@ void UniformGenerator::fill<float>(float* ptr, size_t num_elements, float a, flo
   transform_array<<<sm_count * 2, 1024, 0, stream>>>(ptr, ptr, num_elements, op);
 }
 
+// Each element derives its value from curand_init(seed, table_id:row, col), i.e. a Philox
+// counter keyed on the element's logical position in the table. No generator state is shared
+// between threads, so the kernel is a pure bandwidth-bound write, and the produced table does
+// not depend on how rows are distributed over GPUs.
+__global__ void uniform_philox_kernel(float* output, size_t num_elements,
+                                      size_t embedding_vec_size, size_t table_id,
+                                      size_t row_offset, uint64_t seed, float a, float b) {
+  constexpr uint64_t TABLE_ID_SHIFT = 40;  // leaves 2^40 rows per table in the subsequence
+  for (size_t i = blockIdx.x * blockDim.x + threadIdx.x; i < num_elements;
+       i += blockDim.x * gridDim.x) {
+    const size_t row = i / embedding_vec_size;
+    const size_t col = i - row * embedding_vec_size;
+    curandStatePhilox4_32_10_t state;
+    curand_init(seed, (static_cast<uint64_t>(table_id) << TABLE_ID_SHIFT) + row_offset + row, col,
+                &state);
+    output[i] = curand_uniform(&state) * (b - a) + a;
+  }
+}
+
+template <>
+void PhiloxUniformGenerator::fill<float>(float* ptr, size_t num_rows, size_t embedding_vec_size,
+                                         float a, float b, size_t table_id, size_t row_offset,
+                                         uint64_t seed, size_t sm_count,
+                                         const cudaStream_t& stream) {
+  if (a >= b) {
+    HCTR_OWN_THROW(Error_t::WrongInput, "a must be smaller than b");
+  }
+  const size_t num_elements = num_rows * embedding_vec_size;
+  uniform_philox_kernel<<<sm_count * 2, 1024, 0, stream>>>(ptr, num_elements, embedding_vec_size,
+                                                           table_id, row_offset, seed, a, b);
+}
+
 template <typename T>
 __global__ void sinusoidal_kernel(T* output, int ev_size, int max_sequence_len) {
   int row = blockIdx.x;
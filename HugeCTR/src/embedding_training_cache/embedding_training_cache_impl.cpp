@@ -54,10 +54,12 @@ void EmbeddingTrainingCacheImpl<TypeKey>::load_(std::vector<std::string>& keyset
 
     for (size_t i = 0; i < ps_manager_.get_size(); i++) {
       auto ptr_ps = ps_manager_.get_parameter_server(i);
-      ptr_ps->load_keyset_from_file(keyset_file_list[i]);
 
       size_t hit_size = 0;
-      ptr_ps->pull(ps_manager_.get_buffer_bag(), hit_size);
+      if (!ps_manager_.use_prefetched(i, keyset_file_list[i], hit_size)) {
+        ptr_ps->load_keyset_from_file(keyset_file_list[i]);
+        ptr_ps->pull(ps_manager_.get_buffer_bag(), hit_size);
+      }
       embeddings_[i]->load_parameters(ps_manager_.get_buffer_bag(), hit_size);
     }
   } catch (const internal_runtime_error& rt_err) {
@@ -72,12 +74,15 @@ void EmbeddingTrainingCacheImpl<TypeKey>::load_(std::vector<std::string>& keyset
 template <typename TypeKey>
 void EmbeddingTrainingCacheImpl<TypeKey>::dump() {
   try {
+    ps_manager_.wait_prefetch();
     for (size_t i = 0; i < embeddings_.size(); i++) {
       auto ptr_ps = ps_manager_.get_parameter_server(i);
 
       size_t dump_size = 0;
       embeddings_[i]->dump_parameters(ps_manager_.get_buffer_bag(), &dump_size);
       ptr_ps->push(ps_manager_.get_buffer_bag(), dump_size);
+      // Vectors trained in this pass supersede what the prefetcher staged for the next one.
+      ps_manager_.patch_prefetched(i, dump_size);
     }
 #ifdef ENABLE_MPI
     HCTR_MPI_THROW(MPI_Barrier(MPI_COMM_WORLD));
@@ -121,6 +126,28 @@ void EmbeddingTrainingCacheImpl<TypeKey>::update(std::string& keyset_file) {
   update(keyset_file_list);
 }
 
+template <typename TypeKey>
+void EmbeddingTrainingCacheImpl<TypeKey>::prefetch(std::vector<std::string>& keyset_file_list) {
+  try {
+    if (keyset_file_list.size() != embeddings_.size()) {
+      HCTR_OWN_THROW(Error_t::WrongInput, "num of keyset_file and num of embeddings don't equal");
+    }
+    ps_manager_.prefetch(keyset_file_list);
+  } catch (const internal_runtime_error& rt_err) {
+    HCTR_LOG_S(ERROR, WORLD) << rt_err.what() << std::endl;
+    throw rt_err;
+  } catch (const std::exception& err) {
+    HCTR_LOG_S(ERROR, WORLD) << err.what() << std::endl;
+    throw err;
+  }
+}
+
+template <typename TypeKey>
+void EmbeddingTrainingCacheImpl<TypeKey>::prefetch(std::string& keyset_file) {
+  std::vector<std::string> keyset_file_list(embeddings_.size(), keyset_file);
+  prefetch(keyset_file_list);
+}
+
 template <typename TypeKey>
 std::vector<std::pair<std::vector<long long>, std::vector<float>>>
 EmbeddingTrainingCacheImpl<TypeKey>::get_incremental_model(
@@ -128,6 +155,8 @@ EmbeddingTrainingCacheImpl<TypeKey>::get_incremental_model(
   std::vector<std::pair<std::vector<long long>, std::vector<float>>> inc_model;
   size_t dump_size{0};
 
+  ps_manager_.wait_prefetch();
+
   for (size_t i = 0; i < embeddings_.size(); i++) {
     auto ptr_ps{ps_manager_.get_parameter_server(i)};
     auto key_vec_pair{ptr_ps->pull(keys_to_load)};
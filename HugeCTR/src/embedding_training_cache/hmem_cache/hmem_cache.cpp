@@ -18,6 +18,7 @@
 #include <tqdm.h>
 
 #include <cstddef>
+#include <cstdlib>
 #include <embedding_training_cache/hmem_cache/hmem_cache.hpp>
 #include <execution>
 #include <iomanip>
@@ -47,6 +48,121 @@ std::pair<int, size_t> HMemCache<TypeKey>::cascade_find_(TypeKey key) {
   return std::make_pair(-1, 0);
 }
 
+#ifdef ENABLE_MPI
+template <typename TypeKey>
+std::vector<char> HMemCache<TypeKey>::peer_fetch_(const std::vector<TypeKey> &keys,
+                                                  size_t *slot_id_ptr,
+                                                  std::vector<float *> &data_ptrs) {
+  int const num_proc{resource_manager_->get_num_process()};
+  int const my_rank{resource_manager_->get_process_id()};
+  MPI_Datatype const key_type{(sizeof(TypeKey) == 8) ? MPI_LONG_LONG : MPI_UNSIGNED};
+  size_t const line_size{vec_per_line_ * emb_vec_size_};
+
+  // Exchange every node's want list.
+  int const num_want{static_cast<int>(keys.size())};
+  std::vector<int> want_counts(num_proc);
+  HCTR_MPI_THROW(
+      MPI_Allgather(&num_want, 1, MPI_INT, want_counts.data(), 1, MPI_INT, MPI_COMM_WORLD));
+  std::vector<int> want_displs(num_proc + 1, 0);
+  for (int p{0}; p < num_proc; p++) {
+    want_displs[p + 1] = want_displs[p] + want_counts[p];
+  }
+  std::vector<TypeKey> all_wants(want_displs[num_proc]);
+  HCTR_MPI_THROW(MPI_Allgatherv(keys.data(), num_want, key_type, all_wants.data(),
+                                want_counts.data(), want_displs.data(), key_type,
+                                MPI_COMM_WORLD));
+
+  // Probe this node's DRAM blocks for the other nodes' wants.
+  std::vector<std::vector<int>> found_pos(num_proc);
+  std::vector<std::vector<size_t>> found_slot(num_proc);
+  std::vector<std::vector<float>> found_data(num_proc);
+  for (int p{0}; p < num_proc; p++) {
+    if (p == my_rank) continue;
+    for (int i{0}; i < want_counts[p]; i++) {
+      auto const hc_idx{find_(all_wants[want_displs[p] + i])};
+      if (hc_idx == end_flag) continue;
+      auto const blk_idx{hc_idx / block_capacity_};
+      auto const line_idx{hc_idx % block_capacity_};
+      found_pos[p].push_back(i);
+      if (use_slot_id_) found_slot[p].push_back(slot_ids_[blk_idx][line_idx]);
+      for (size_t j{0}; j < vec_per_line_; j++) {
+        auto const *src{cache_datas_[blk_idx][j].data() + line_idx * emb_vec_size_};
+        found_data[p].insert(found_data[p].end(), src, src + emb_vec_size_);
+      }
+    }
+  }
+
+  // Return the findings (positions, slot ids, vectors) to their requesters.
+  std::vector<int> send_counts(num_proc, 0), recv_counts(num_proc, 0);
+  for (int p{0}; p < num_proc; p++) {
+    send_counts[p] = static_cast<int>(found_pos[p].size());
+  }
+  HCTR_MPI_THROW(MPI_Alltoall(send_counts.data(), 1, MPI_INT, recv_counts.data(), 1, MPI_INT,
+                              MPI_COMM_WORLD));
+  std::vector<int> send_displs(num_proc + 1, 0), recv_displs(num_proc + 1, 0);
+  for (int p{0}; p < num_proc; p++) {
+    send_displs[p + 1] = send_displs[p] + send_counts[p];
+    recv_displs[p + 1] = recv_displs[p] + recv_counts[p];
+  }
+  std::vector<int> send_pos(send_displs[num_proc]);
+  std::vector<size_t> send_slot(use_slot_id_ ? send_displs[num_proc] : 0);
+  std::vector<float> send_data(send_displs[num_proc] * line_size);
+  for (int p{0}; p < num_proc; p++) {
+    std::copy(found_pos[p].begin(), found_pos[p].end(), send_pos.begin() + send_displs[p]);
+    if (use_slot_id_) {
+      std::copy(found_slot[p].begin(), found_slot[p].end(),
+                send_slot.begin() + send_displs[p]);
+    }
+    std::copy(found_data[p].begin(), found_data[p].end(),
+              send_data.begin() + send_displs[p] * line_size);
+  }
+  std::vector<int> recv_pos(recv_displs[num_proc]);
+  HCTR_MPI_THROW(MPI_Alltoallv(send_pos.data(), send_counts.data(), send_displs.data(), MPI_INT,
+                               recv_pos.data(), recv_counts.data(), recv_displs.data(), MPI_INT,
+                               MPI_COMM_WORLD));
+  std::vector<size_t> recv_slot(use_slot_id_ ? recv_displs[num_proc] : 0);
+  if (use_slot_id_) {
+    HCTR_MPI_THROW(MPI_Alltoallv(send_slot.data(), send_counts.data(), send_displs.data(),
+                                 MPI_UNSIGNED_LONG, recv_slot.data(), recv_counts.data(),
+                                 recv_displs.data(), MPI_UNSIGNED_LONG, MPI_COMM_WORLD));
+  }
+  std::vector<int> send_data_counts(num_proc), recv_data_counts(num_proc);
+  std::vector<int> send_data_displs(num_proc), recv_data_displs(num_proc);
+  for (int p{0}; p < num_proc; p++) {
+    send_data_counts[p] = send_counts[p] * static_cast<int>(line_size);
+    recv_data_counts[p] = recv_counts[p] * static_cast<int>(line_size);
+    send_data_displs[p] = send_displs[p] * static_cast<int>(line_size);
+    recv_data_displs[p] = recv_displs[p] * static_cast<int>(line_size);
+  }
+  std::vector<float> recv_data(recv_displs[num_proc] * line_size);
+  HCTR_MPI_THROW(MPI_Alltoallv(send_data.data(), send_data_counts.data(),
+                               send_data_displs.data(), MPI_FLOAT, recv_data.data(),
+                               recv_data_counts.data(), recv_data_displs.data(), MPI_FLOAT,
+                               MPI_COMM_WORLD));
+
+  // Apply the responses; when several peers hold the same key, the first answer wins.
+  std::vector<char> filled(keys.size(), 0);
+  size_t num_remote{0};
+  for (int cnt{0}; cnt < recv_displs[num_proc]; cnt++) {
+    auto const pos{static_cast<size_t>(recv_pos[cnt])};
+    if (filled[pos]) continue;
+    filled[pos] = 1;
+    num_remote++;
+    if (use_slot_id_) slot_id_ptr[pos] = recv_slot[cnt];
+    for (size_t j{0}; j < vec_per_line_; j++) {
+      memcpy(data_ptrs[j] + pos * emb_vec_size_,
+             recv_data.data() + cnt * line_size + j * emb_vec_size_,
+             emb_vec_size_ * sizeof(float));
+    }
+  }
+  if (num_want != 0) {
+    HCTR_LOG_S(INFO, WORLD) << "HMEM-Cache PS: peer cache served " << num_remote << " / "
+                            << num_want << " SSD-bound keys" << std::endl;
+  }
+  return filled;
+}
+#endif
+
 template <typename TypeKey>
 HMemCache<TypeKey>::HMemCache(size_t num_cached_pass, double target_hit_rate, size_t max_num_evict,
                               size_t max_vocabulary_size, std::string sparse_model_file,
@@ -61,12 +177,16 @@ HMemCache<TypeKey>::HMemCache(size_t num_cached_pass, double target_hit_rate, si
       emb_vec_size_{emb_vec_size},
       vec_per_line_{vec_per_line[opt_type]},
       resource_manager_{resource_manager},
+      peer_cache_{std::getenv("HCTR_ETC_PEER_CACHE") != nullptr &&
+                  resource_manager->get_num_process() > 1},
+      async_wb_{std::getenv("HCTR_HMEM_CACHE_ASYNC_WB") != nullptr},
       sparse_model_file_ptr_(std::make_shared<SparseModelFileTS<TypeKey>>(
           sparse_model_file, local_path, use_slot_id, opt_type, emb_vec_size, resource_manager)) {
   // +1 is reserved for a temp buffer
   key_idx_maps_.resize(num_block_ + 1);
   slot_ids_.resize(num_block_ + 1);
   cache_datas_.resize(num_block_ + 1);
+  block_dirty_.assign(num_block_ + 1, 0);
 #pragma omp parallel for num_threads(num_block_ + 1)
   for (auto i = 0; i < num_block_ + 1; i++) {
     key_idx_maps_[i].reserve(block_capacity_);
@@ -78,6 +198,52 @@ HMemCache<TypeKey>::HMemCache(size_t num_cached_pass, double target_hit_rate, si
       cache_data.resize(block_capacity_ * emb_vec_size_);
     }
   }
+  if (async_wb_) {
+    HCTR_LOG_S(INFO, ROOT) << "HMEM-Cache PS: background write-back of dirty blocks enabled"
+                           << std::endl;
+    wb_thread_ = std::thread([this] { write_back_loop_(); });
+  }
+}
+
+template <typename TypeKey>
+HMemCache<TypeKey>::~HMemCache() {
+  if (async_wb_) {
+    {
+      std::lock_guard<std::mutex> lock(wb_mutex_);
+      wb_terminate_ = true;
+    }
+    wb_cv_.notify_one();
+    wb_thread_.join();
+  }
+}
+
+template <typename TypeKey>
+void HMemCache<TypeKey>::write_back_loop_() {
+  std::unique_lock<std::mutex> lock(wb_mutex_);
+  while (true) {
+    wb_cv_.wait(lock, [this] {
+      return wb_terminate_ ||
+             std::any_of(block_dirty_.begin(), block_dirty_.begin() + num_block_,
+                         [](char dirty) { return dirty != 0; });
+    });
+    if (wb_terminate_) return;
+    // Flush oldest-first: the block next in line for eviction benefits most from being clean.
+    auto num_blk{is_full_ ? num_block_ : (head_id_ + 1)};
+    auto tail_id{is_full_ ? (head_id_ + 1) % num_block_ : 0};
+    for (auto cnt{0}; cnt < num_blk; cnt++) {
+      auto blk_idx{(tail_id + cnt) % num_block_};
+      if (!block_dirty_[blk_idx]) continue;
+      sparse_model_file_ptr_->dump_update(key_idx_maps_[blk_idx], slot_ids_[blk_idx],
+                                          cache_datas_[blk_idx]);
+      block_dirty_[blk_idx] = 0;
+      break;
+    }
+    // Drop the lock between dumps so a pending read/write waits for at most one block; the
+    // wait predicate re-fires immediately while dirty blocks remain.
+    lock.unlock();
+    std::this_thread::yield();
+    lock.lock();
+  }
 }
 
 template <typename TypeKey>
@@ -112,6 +278,7 @@ void HMemCache<TypeKey>::read(TypeKey *key_ptr, size_t &len, size_t *slot_id_ptr
   if (data_ptrs.size() != vec_per_line_) {
     HCTR_OWN_THROW(Error_t::WrongInput, "Num of data files and pointers doesn't equal");
   }
+  std::lock_guard<std::mutex> wb_lock(wb_mutex_);
   auto const num_thread{24};
   std::vector<std::vector<std::vector<TypeKey>>> sub_exist_keys(
       num_thread, std::vector<std::vector<TypeKey>>(2));
@@ -186,6 +353,20 @@ void HMemCache<TypeKey>::read(TypeKey *key_ptr, size_t &len, size_t *slot_id_ptr
     }
   }
 
+#ifdef ENABLE_MPI
+  // Peer host-memory tier: satisfy as many SSD-bound keys as possible from the DRAM blocks of
+  // the other nodes. The collective exchange runs before the parallel sections below, so MPI
+  // is only ever entered from the main thread.
+  std::vector<char> peer_filled;
+  if (peer_cache_) {
+    size_t *peer_slot_id_ptr{slot_id_ptr + idx_vecs[0].size()};
+    std::vector<float *> peer_data_ptrs(data_ptrs.size());
+    std::transform(data_ptrs.begin(), data_ptrs.end(), peer_data_ptrs.begin(),
+                   [&](float *ptr) { return ptr + idx_vecs[0].size() * emb_vec_size_; });
+    peer_filled = peer_fetch_(keys_vec[1], peer_slot_id_ptr, peer_data_ptrs);
+  }
+#endif
+
   omp_set_nested(2);
 #pragma omp parallel sections
   {
@@ -196,6 +377,7 @@ void HMemCache<TypeKey>::read(TypeKey *key_ptr, size_t &len, size_t *slot_id_ptr
           std::swap(key_idx_maps_[tail_id], key_idx_maps_[num_block_]);
           std::swap(slot_ids_[tail_id], slot_ids_[num_block_]);
           std::swap(cache_datas_[tail_id], cache_datas_[num_block_]);
+          std::swap(block_dirty_[tail_id], block_dirty_[num_block_]);
         }
         key_idx_maps_[tail_id].clear();
         for (size_t i{0}; i < len; i++) {
@@ -220,7 +402,40 @@ void HMemCache<TypeKey>::read(TypeKey *key_ptr, size_t &len, size_t *slot_id_ptr
       std::vector<float *> tmp_data_ptrs(data_ptrs.size());
       std::transform(data_ptrs.begin(), data_ptrs.end(), tmp_data_ptrs.begin(),
                      [&](float *ptr) { return ptr + idx_vecs[0].size() * emb_vec_size_; });
+#ifdef ENABLE_MPI
+      if (peer_cache_) {
+        // Only the positions the peer tier couldn't serve still need the SSD round trip.
+        std::vector<size_t> ssd_idx_vec, pos_vec;
+        for (size_t i{0}; i < idx_vecs[1].size(); i++) {
+          if (!peer_filled[i]) {
+            ssd_idx_vec.push_back(idx_vecs[1][i]);
+            pos_vec.push_back(i);
+          }
+        }
+        if (!ssd_idx_vec.empty()) {
+          std::vector<size_t> ssd_slot_ids(ssd_idx_vec.size());
+          std::vector<std::vector<float>> ssd_datas(
+              vec_per_line_, std::vector<float>(ssd_idx_vec.size() * emb_vec_size_));
+          std::vector<float *> ssd_data_ptrs;
+          for (auto &ssd_data : ssd_datas) {
+            ssd_data_ptrs.push_back(ssd_data.data());
+          }
+          sparse_model_file_ptr_->load(ssd_idx_vec, ssd_slot_ids.data(), ssd_data_ptrs);
+          for (size_t cnt{0}; cnt < pos_vec.size(); cnt++) {
+            auto const pos{pos_vec[cnt]};
+            if (use_slot_id_) tmp_slot_id_ptr[pos] = ssd_slot_ids[cnt];
+            for (size_t i{0}; i < vec_per_line_; i++) {
+              memcpy(tmp_data_ptrs[i] + pos * emb_vec_size_,
+                     ssd_data_ptrs[i] + cnt * emb_vec_size_, emb_vec_size_ * sizeof(float));
+            }
+          }
+        }
+      } else {
+        sparse_model_file_ptr_->load(idx_vecs[1], tmp_slot_id_ptr, tmp_data_ptrs);
+      }
+#else
       sparse_model_file_ptr_->load(idx_vecs[1], tmp_slot_id_ptr, tmp_data_ptrs);
+#endif
       if (!is_full_ || (hit_rate < target_hit_rate_ && pass_counter < max_num_evict_)) {
         size_t offset{idx_vecs[0].size()};
         bool is_empty{idx_vecs[1].size() == 0};
@@ -240,22 +455,29 @@ void HMemCache<TypeKey>::read(TypeKey *key_ptr, size_t &len, size_t *slot_id_ptr
 
   if (!is_full_ || (hit_rate < target_hit_rate_ && pass_counter < max_num_evict_)) {
     if (is_full_) {
-      sparse_model_file_ptr_->dump_update(key_idx_maps_[num_block_], slot_ids_[num_block_],
-                                          cache_datas_[num_block_]);
+      // Blocks already trickled to SSD by the write-back thread need no dump on eviction.
+      if (block_dirty_[num_block_]) {
+        sparse_model_file_ptr_->dump_update(key_idx_maps_[num_block_], slot_ids_[num_block_],
+                                            cache_datas_[num_block_]);
+        block_dirty_[num_block_] = 0;
+      }
       pass_counter++;
     }
     head_id_ = tail_id;
+    block_dirty_[head_id_] = 1;
     if (!is_full_ && (head_id_ == num_block_ - 1)) {
       is_full_ = true;
     }
   }
   HCTR_LOG_S(INFO, WORLD) << "HMEM-Cache PS: Hit rate [load]: " << std::setprecision(4)
                           << (hit_rate * 100.) << " %" << std::endl;
+  if (async_wb_) wb_cv_.notify_one();
 }
 
 template <typename TypeKey>
 void HMemCache<TypeKey>::write(const TypeKey *key_ptr, size_t len, size_t const *slot_id_ptr,
                                std::vector<float *> &data_ptrs) {
+  std::lock_guard<std::mutex> wb_lock(wb_mutex_);
   size_t const num_thread(24);
   std::vector<std::vector<std::vector<size_t>>> sub_src_idx_vecs(num_thread);
   std::vector<std::vector<std::vector<size_t>>> sub_dst_idx_vecs(num_thread);
@@ -329,6 +551,10 @@ void HMemCache<TypeKey>::write(const TypeKey *key_ptr, size_t len, size_t const
     offset += num_elem;
   }
 
+  for (auto dst_idx : dst_idx_vecs[0]) {
+    block_dirty_[dst_idx / block_capacity_] = 1;
+  }
+
   omp_set_nested(2);
 #pragma omp parallel sections
   {
@@ -358,11 +584,13 @@ void HMemCache<TypeKey>::write(const TypeKey *key_ptr, size_t len, size_t const
     HCTR_LOG_S(INFO, WORLD) << "HMEM-Cache PS: Hit rate [dump]: " << std::setprecision(4)
                             << hit_rate << " %" << std::endl;
   }
+  if (async_wb_) wb_cv_.notify_one();
 }
 
 template <typename TypeKey>
 void HMemCache<TypeKey>::sync_to_ssd() {
   if (!is_full_ && head_id_ == -1) return;
+  std::lock_guard<std::mutex> wb_lock(wb_mutex_);
   auto num_blk{is_full_ ? num_block_ : (head_id_ + 1)};
   auto tail_id{is_full_ ? (head_id_ + 1) % num_block_ : 0};
   HCTR_LOG(INFO, ROOT, "Sync blocks from HMEM-Cache to SSD\n");
@@ -372,8 +600,12 @@ void HMemCache<TypeKey>::sync_to_ssd() {
   }
   for (auto cnt{0}; cnt < num_blk; cnt++) {
     auto blk_idx{(tail_id + cnt) % num_block_};
-    sparse_model_file_ptr_->dump_update(key_idx_maps_[blk_idx], slot_ids_[blk_idx],
-                                        cache_datas_[blk_idx]);
+    // Only the residue the write-back thread hasn't flushed yet needs a dump here.
+    if (block_dirty_[blk_idx]) {
+      sparse_model_file_ptr_->dump_update(key_idx_maps_[blk_idx], slot_ids_[blk_idx],
+                                          cache_datas_[blk_idx]);
+      block_dirty_[blk_idx] = 0;
+    }
     if (resource_manager_->is_master_process()) {
       bar.progress(cnt + 1, num_blk);
     }
@@ -509,6 +509,10 @@ template <typename TypeKey>
 void SparseModelFileTS<TypeKey>::load(std::vector<size_t> const& mem_src_idx, size_t* slot_id_ptr,
                                       std::vector<float*>& data_ptrs) {
   try {
+    static bool const direct_io{std::getenv("HCTR_SMFTS_DIRECT_IO") != nullptr};
+    if (direct_io && load_direct_(mem_src_idx, slot_id_ptr, data_ptrs)) {
+      return;
+    }
     if (!mmap_handler_.mapped_to_file_) {
       mmap_to_memory_();
     }
@@ -535,6 +539,103 @@ void SparseModelFileTS<TypeKey>::load(std::vector<size_t> const& mem_src_idx, si
   }
 }
 
+template <typename TypeKey>
+bool SparseModelFileTS<TypeKey>::load_direct_(std::vector<size_t> const& ssd_idx_vec,
+                                              size_t* slot_id_ptr,
+                                              std::vector<float*>& data_ptrs) {
+  size_t const len{ssd_idx_vec.size()};
+  if (len == 0) return true;
+  if (data_ptrs.size() != mmap_handler_.get_data_files().size()) {
+    HCTR_OWN_THROW(Error_t::WrongInput, "Num of data files and pointers doesn't equal");
+  }
+  // Direct reads bypass the page cache, so dirty pages of the writable mapping must reach the
+  // disk first or the read would return stale lines.
+  if (mmap_handler_.mapped_to_file_) flush_mmap_to_disk_();
+
+  if (use_slot_id_) {
+#pragma omp parallel for num_threads(24)
+    for (size_t cnt = 0; cnt < len; cnt++) {
+      slot_id_ptr[cnt] = slot_ids[ssd_idx_vec[cnt]];
+    }
+  }
+
+  // Order the requested lines by their file position and merge runs separated by less than
+  // max_gap_bytes into one extent, so a pass load turns into a few large sequential reads
+  // instead of page-sized random ones.
+  std::vector<size_t> order(len);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(),
+            [&](size_t a, size_t b) { return ssd_idx_vec[a] < ssd_idx_vec[b]; });
+
+  size_t const line_bytes{emb_vec_size_ * sizeof(float)};
+  size_t constexpr block_bytes{4096};           // O_DIRECT offset/length/buffer alignment
+  size_t constexpr max_gap_bytes{1ul << 20};    // read through holes smaller than this
+  size_t constexpr max_extent_bytes{64ul << 20};  // bounds the bounce buffer
+
+  std::vector<std::pair<size_t, size_t>> extents;  // [begin, end) into order
+  for (size_t pos{0}; pos < len;) {
+    size_t end{pos + 1};
+    while (end < len &&
+           (ssd_idx_vec[order[end]] - ssd_idx_vec[order[end - 1]]) * line_bytes <= max_gap_bytes &&
+           (ssd_idx_vec[order[end]] - ssd_idx_vec[order[pos]] + 1) * line_bytes <=
+               max_extent_bytes) {
+      end++;
+    }
+    extents.emplace_back(pos, end);
+    pos = end;
+  }
+
+  void* bounce_raw{nullptr};
+  size_t bounce_bytes{0};
+  auto const& data_files{mmap_handler_.get_data_files()};
+  for (size_t i{0}; i < data_ptrs.size(); i++) {
+    int fd{open(data_files[i].c_str(), O_RDONLY | O_DIRECT)};
+    if (fd == -1) {
+      HCTR_LOG_S(WARNING, ROOT) << "O_DIRECT open failed for " << data_files[i]
+                                << "; falling back to the mmap load path" << std::endl;
+      if (bounce_raw != nullptr) free(bounce_raw);
+      return false;
+    }
+    for (auto const& extent : extents) {
+      size_t const first_byte{ssd_idx_vec[order[extent.first]] * line_bytes};
+      size_t const last_byte{(ssd_idx_vec[order[extent.second - 1]] + 1) * line_bytes};
+      size_t const aligned_begin{first_byte / block_bytes * block_bytes};
+      size_t const aligned_bytes{(last_byte - aligned_begin + block_bytes - 1) / block_bytes *
+                                 block_bytes};
+      if (aligned_bytes > bounce_bytes) {
+        if (bounce_raw != nullptr) free(bounce_raw);
+        if (posix_memalign(&bounce_raw, block_bytes, aligned_bytes) != 0) {
+          close(fd);
+          HCTR_OWN_THROW(Error_t::OutOfMemory, "Can't allocate aligned read buffer");
+        }
+        bounce_bytes = aligned_bytes;
+      }
+      char* bounce{static_cast<char*>(bounce_raw)};
+      size_t read_bytes{0};
+      while (read_bytes < aligned_bytes) {
+        auto ret{pread(fd, bounce + read_bytes, aligned_bytes - read_bytes,
+                       aligned_begin + read_bytes)};
+        if (ret < 0) {
+          close(fd);
+          free(bounce_raw);
+          HCTR_OWN_THROW(Error_t::BrokenFile, "Direct read failed for " + data_files[i]);
+        }
+        if (ret == 0) break;  // the aligned tail may extend past EOF
+        read_bytes += ret;
+      }
+#pragma omp parallel for num_threads(24)
+      for (size_t pos = extent.first; pos < extent.second; pos++) {
+        auto const cnt{order[pos]};
+        memcpy(data_ptrs[i] + cnt * emb_vec_size_,
+               bounce + ssd_idx_vec[cnt] * line_bytes - aligned_begin, line_bytes);
+      }
+    }
+    close(fd);
+  }
+  if (bounce_raw != nullptr) free(bounce_raw);
+  return true;
+}
+
 template <typename TypeKey>
 void SparseModelFileTS<TypeKey>::dump_update(HashTableType& dump_key_idx_map,
                                              std::vector<size_t>& slot_id_vec,
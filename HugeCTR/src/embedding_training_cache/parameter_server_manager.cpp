@@ -17,6 +17,9 @@
 #include "embedding_training_cache/parameter_server_manager.hpp"
 
 #include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
 
 namespace HugeCTR {
 
@@ -56,7 +59,14 @@ ParameterServerManager<TypeKey>::ParameterServerManager(
       }
     }
 
+    prefetch_enabled_ = std::getenv("HCTR_ETC_PREFETCH") != nullptr;
+
     for (size_t i{0}; i < ps_types.size(); i++) {
+      emb_vec_sizes_.push_back(embedding_params[i].embedding_vec_size);
+      vecs_per_line_.push_back(vec_per_line[embedding_params[i].opt_params.optimizer]);
+      use_slot_ids_.push_back(embedding_types[i] == Embedding_t::LocalizedSlotSparseEmbeddingHash ||
+                              embedding_types[i] ==
+                                  Embedding_t::LocalizedSlotSparseEmbeddingOneHot);
       switch (ps_types[i]) {
         case TrainPSType_t::Staged: {
           HCTR_LOG(INFO, ROOT, "Enable HMEM-Based Parameter Server\n");
@@ -161,6 +171,33 @@ ParameterServerManager<TypeKey>::ParameterServerManager(
         hbm_blobs_buff->allocate();
       }
     }
+
+    if (prefetch_enabled_) {
+      HCTR_LOG(INFO, ROOT, "Enable keyset prefetching for the embedding training cache\n");
+      // One staging bag per table so a whole pass can be staged while the previous one trains.
+      // Only the portions the pull path writes are allocated; the GPU scratch tensors stay in
+      // buf_bag_, which the staged content is copied into at pass-switch time.
+      auto staging_blobs_buff{GeneralBuffer2<CudaHostAllocator>::create()};
+      staging_bags_.resize(ps_.size());
+      staged_files_.resize(ps_.size());
+      staged_hit_sizes_.resize(ps_.size(), 0);
+      staged_key_pos_.resize(ps_.size());
+      staged_miss_keys_.resize(ps_.size());
+      for (auto& staging_bag : staging_bags_) {
+        Tensor2<TypeKey> tensor_keys;
+        Tensor2<size_t> tensor_slot_id;
+        staging_blobs_buff->reserve({buffer_size}, &tensor_keys);
+        staging_blobs_buff->reserve({buffer_size}, &tensor_slot_id);
+        staging_blobs_buff->reserve({buffer_size, max_vec_size}, &(staging_bag.embedding));
+        staging_bag.opt_states.resize(num_vec_per_key - 1);
+        for (auto& opt_state : staging_bag.opt_states) {
+          staging_blobs_buff->reserve({buffer_size, max_vec_size}, &opt_state);
+        }
+        staging_bag.keys = tensor_keys.shrink();
+        staging_bag.slot_id = tensor_slot_id.shrink();
+      }
+      staging_blobs_buff->allocate();
+    }
   } catch (const internal_runtime_error& rt_err) {
     HCTR_LOG_S(ERROR, WORLD) << rt_err.what() << std::endl;
     throw rt_err;
@@ -170,6 +207,142 @@ ParameterServerManager<TypeKey>::ParameterServerManager(
   }
 }
 
+template <typename TypeKey>
+void ParameterServerManager<TypeKey>::prefetch(const std::vector<std::string>& keyset_file_list) {
+  if (!prefetch_enabled_) {
+    HCTR_LOG_S(WARNING, ROOT) << "Keyset prefetching is disabled (set HCTR_ETC_PREFETCH to "
+                                 "enable); the next update() will pull synchronously"
+                              << std::endl;
+    return;
+  }
+  if (keyset_file_list.size() != ps_.size()) {
+    HCTR_OWN_THROW(Error_t::WrongInput, "num of keyset_file and num of embeddings don't equal");
+  }
+  wait_prefetch();
+  prefetch_future_ = std::async(std::launch::async, [this, keyset_file_list] {
+    for (size_t i{0}; i < ps_.size(); i++) {
+      auto const& keyset_file{keyset_file_list[i]};
+      std::ifstream keyset_stream(keyset_file, std::ifstream::binary);
+      if (!keyset_stream.is_open()) {
+        HCTR_OWN_THROW(Error_t::WrongInput, "Cannot open the file: " + keyset_file);
+      }
+      size_t file_size_in_byte{std::filesystem::file_size(keyset_file)};
+      if (file_size_in_byte == 0) {
+        HCTR_OWN_THROW(Error_t::WrongInput, keyset_file + " is empty");
+      }
+      std::vector<TypeKey> keyset(file_size_in_byte / sizeof(TypeKey));
+      keyset_stream.read(reinterpret_cast<char*>(keyset.data()), file_size_in_byte);
+
+      staged_key_pos_[i].clear();
+      staged_miss_keys_[i].clear();
+      staged_miss_keys_[i].insert(keyset.begin(), keyset.end());
+      ps_[i]->set_keyset(std::move(keyset));
+
+      size_t hit_size{0};
+      ps_[i]->pull(staging_bags_[i], hit_size);
+      staged_hit_sizes_[i] = hit_size;
+
+      auto key_ptr{Tensor2<TypeKey>::stretch_from(staging_bags_[i].keys).get_ptr()};
+      staged_key_pos_[i].reserve(hit_size);
+      for (size_t cnt{0}; cnt < hit_size; cnt++) {
+        staged_key_pos_[i].emplace(key_ptr[cnt], cnt);
+        staged_miss_keys_[i].erase(key_ptr[cnt]);
+      }
+      staged_files_[i] = keyset_file;
+      HCTR_LOG_S(INFO, ROOT) << "Prefetched " << hit_size << " keys of keyset " << keyset_file
+                             << " into the staging buffer" << std::endl;
+    }
+  });
+}
+
+template <typename TypeKey>
+void ParameterServerManager<TypeKey>::wait_prefetch() {
+  if (prefetch_future_.valid()) {
+    prefetch_future_.get();
+  }
+}
+
+template <typename TypeKey>
+void ParameterServerManager<TypeKey>::patch_prefetched(size_t i, size_t dump_size) {
+  if (!prefetch_enabled_ || staged_files_[i].empty() || dump_size == 0) return;
+
+  auto dump_key_ptr{Tensor2<TypeKey>::stretch_from(buf_bag_.keys).get_ptr()};
+  auto dump_slot_id_ptr{Tensor2<size_t>::stretch_from(buf_bag_.slot_id).get_ptr()};
+  auto staged_key_ptr{Tensor2<TypeKey>::stretch_from(staging_bags_[i].keys).get_ptr()};
+  auto staged_slot_id_ptr{Tensor2<size_t>::stretch_from(staging_bags_[i].slot_id).get_ptr()};
+
+  std::vector<float*> src_ptrs{buf_bag_.embedding.get_ptr()};
+  std::vector<float*> dst_ptrs{staging_bags_[i].embedding.get_ptr()};
+  for (size_t j{0}; j < vecs_per_line_[i] - 1; j++) {
+    src_ptrs.push_back(buf_bag_.opt_states[j].get_ptr());
+    dst_ptrs.push_back(staging_bags_[i].opt_states[j].get_ptr());
+  }
+
+  auto const vec_size{emb_vec_sizes_[i]};
+  size_t num_patched{0};
+  for (size_t cnt{0}; cnt < dump_size; cnt++) {
+    auto key{dump_key_ptr[cnt]};
+    size_t pos;
+    auto it{staged_key_pos_[i].find(key)};
+    if (it != staged_key_pos_[i].end()) {
+      pos = it->second;
+    } else if (staged_miss_keys_[i].count(key) != 0) {
+      // The key was absent from the sparse model at prefetch time and first trained in this
+      // pass, but it belongs to the staged keyset: append it to the staging bag.
+      pos = staged_hit_sizes_[i]++;
+      staged_key_ptr[pos] = key;
+      staged_key_pos_[i].emplace(key, pos);
+      staged_miss_keys_[i].erase(key);
+    } else {
+      continue;
+    }
+    if (use_slot_ids_[i]) staged_slot_id_ptr[pos] = dump_slot_id_ptr[cnt];
+    for (size_t j{0}; j < vecs_per_line_[i]; j++) {
+      memcpy(dst_ptrs[j] + pos * vec_size, src_ptrs[j] + cnt * vec_size,
+             vec_size * sizeof(float));
+    }
+    num_patched++;
+  }
+  HCTR_LOG_S(INFO, ROOT) << "Refreshed " << num_patched
+                         << " staged vectors with the latest dump" << std::endl;
+}
+
+template <typename TypeKey>
+bool ParameterServerManager<TypeKey>::use_prefetched(size_t i, const std::string& keyset_file,
+                                                     size_t& hit_size) {
+  if (!prefetch_enabled_ || staged_files_[i].empty()) return false;
+  if (staged_files_[i] != keyset_file) {
+    HCTR_LOG_S(WARNING, ROOT) << "Prefetched keyset " << staged_files_[i]
+                              << " doesn't match the requested " << keyset_file
+                              << "; falling back to a synchronous pull" << std::endl;
+    staged_files_[i].clear();
+    staged_key_pos_[i].clear();
+    staged_miss_keys_[i].clear();
+    return false;
+  }
+
+  hit_size = staged_hit_sizes_[i];
+  auto staged_key_ptr{Tensor2<TypeKey>::stretch_from(staging_bags_[i].keys).get_ptr()};
+  auto key_ptr{Tensor2<TypeKey>::stretch_from(buf_bag_.keys).get_ptr()};
+  memcpy(key_ptr, staged_key_ptr, hit_size * sizeof(TypeKey));
+  if (use_slot_ids_[i]) {
+    auto staged_slot_id_ptr{Tensor2<size_t>::stretch_from(staging_bags_[i].slot_id).get_ptr()};
+    auto slot_id_ptr{Tensor2<size_t>::stretch_from(buf_bag_.slot_id).get_ptr()};
+    memcpy(slot_id_ptr, staged_slot_id_ptr, hit_size * sizeof(size_t));
+  }
+  memcpy(buf_bag_.embedding.get_ptr(), staging_bags_[i].embedding.get_ptr(),
+         hit_size * emb_vec_sizes_[i] * sizeof(float));
+  for (size_t j{0}; j < vecs_per_line_[i] - 1; j++) {
+    memcpy(buf_bag_.opt_states[j].get_ptr(), staging_bags_[i].opt_states[j].get_ptr(),
+           hit_size * emb_vec_sizes_[i] * sizeof(float));
+  }
+
+  staged_files_[i].clear();
+  staged_key_pos_[i].clear();
+  staged_miss_keys_[i].clear();
+  return true;
+}
+
 template class ParameterServerManager<long long>;
 template class ParameterServerManager<unsigned>;
 
@@ -19,6 +19,7 @@
 #include <omp.h>
 
 #include <algorithm>
+#include <cstdlib>
 #include <execution>
 #include <fstream>
 #include <iterator>
@@ -134,12 +135,17 @@ template <typename TypeKey>
 SparseModelEntity<TypeKey>::SparseModelEntity(const std::string &sparse_model_file,
                                               Embedding_t embedding_type, size_t emb_vec_size,
                                               std::shared_ptr<ResourceManager> resource_manager)
-    : is_distributed_(embedding_type == Embedding_t::DistributedSlotSparseEmbeddingHash),
+    : delta_flush_(std::getenv("HCTR_DELTA_CHECKPOINT") != nullptr),
+      is_distributed_(embedding_type == Embedding_t::DistributedSlotSparseEmbeddingHash),
       emb_vec_size_(emb_vec_size),
       resource_manager_(resource_manager),
       sparse_model_file_(SparseModelFile<TypeKey>(sparse_model_file, embedding_type, emb_vec_size,
                                                   resource_manager)) {
   sparse_model_file_.load_emb_tbl_to_mem(exist_key_idx_mapping_, host_emb_tabel_);
+  if (delta_flush_) {
+    HCTR_LOG_S(INFO, ROOT) << "HCTR_DELTA_CHECKPOINT is set: only keys updated since the last "
+                           << "flush will be written back to the sparse model file" << std::endl;
+  }
 }
 
 template <typename TypeKey>
@@ -328,6 +334,12 @@ void SparseModelEntity<TypeKey>::dump_vec_by_key(BufferBag &buf_bag, const size_
       cnt_new_keys += chunk_new_key_idx_mapping[tid].size();
     }
 
+    // Every dumped key may now differ from its on-disk copy; remember it so a
+    // delta flush only writes these rows back.
+    if (delta_flush_) {
+      dirty_keys_.insert(key_ptr, key_ptr + dump_size);
+    }
+
     size_t extended_table_size = host_emb_tabel_.size() + cnt_new_keys * emb_vec_size_;
     host_emb_tabel_.resize(extended_table_size);
 
@@ -378,9 +390,15 @@ void SparseModelEntity<TypeKey>::flush_emb_tbl_to_ssd() {
     new_vec_idx.reserve(new_key_idx_mapping_.size());
 
     for (const auto &exist_pair : exist_key_idx_mapping_) {
+      if (delta_flush_ && dirty_keys_.find(exist_pair.first) == dirty_keys_.end()) continue;
       exist_keys.push_back(exist_pair.first);
       exist_vec_idx.push_back(exist_pair.second.second);
     }
+    if (delta_flush_) {
+      HCTR_LOG_S(INFO, ROOT) << "Delta flush: " << exist_keys.size() << " of "
+                             << exist_key_idx_mapping_.size() << " existing keys are dirty, "
+                             << new_key_idx_mapping_.size() << " keys are new" << std::endl;
+    }
     for (const auto &new_pair : new_key_idx_mapping_) {
       new_keys.push_back(new_pair.first);
       new_slots.push_back(new_pair.second.first);
@@ -405,6 +423,8 @@ void SparseModelEntity<TypeKey>::flush_emb_tbl_to_ssd() {
       HCTR_MPI_THROW(MPI_Barrier(MPI_COMM_WORLD));
     }
 #endif
+    // The file now matches the host table again, so all keys start clean.
+    dirty_keys_.clear();
     HCTR_LOG(INFO, ROOT, "Done!\n");
   } catch (const internal_runtime_error &rt_err) {
     HCTR_LOG_S(ERROR, WORLD) << rt_err.what() << std::endl;
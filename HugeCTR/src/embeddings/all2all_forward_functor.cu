@@ -152,6 +152,79 @@ template void SparseEmbeddingFunctors::all2all_forward<__half>(
     const Tensors2<__half> &send_tensors, Tensors2<__half> &recv_tensors,
     const ResourceManager &resource_manager);
 
+template <typename Type>
+void SparseEmbeddingFunctors::all2all_forward_chunk(
+    size_t sample_offset, size_t sample_count, size_t batch_size_per_gpu, size_t slot_num,
+    size_t embedding_vec_size, const Tensors2<Type> &send_tensors, Tensors2<Type> &recv_tensors,
+    const ResourceManager &resource_manager, const std::vector<cudaStream_t> &comm_streams) {
+  size_t local_gpu_count = resource_manager.get_local_gpu_count();
+  size_t total_gpu_count = resource_manager.get_global_gpu_count();
+
+  size_t num_proc = resource_manager.get_num_process();
+  if (total_gpu_count != (num_proc * local_gpu_count)) {
+    HCTR_OWN_THROW(Error_t::WrongInput, "Error: the total gpu count doesn't match");
+  }
+
+  // Elements one sample contributes to each peer; within a (src, dst) block the layout is
+  // sample-major, so a sample range maps onto one contiguous sub-block per peer.
+  auto slots_of_gpu = [&](size_t global_id) {
+    return slot_num / total_gpu_count + ((global_id < (slot_num % total_gpu_count)) ? 1 : 0);
+  };
+
+  std::vector<size_t> send_per_sample(local_gpu_count);
+  for (size_t i = 0; i < local_gpu_count; i++) {
+    size_t global_id = resource_manager.get_local_gpu(i)->get_global_id();
+    send_per_sample[i] = slots_of_gpu(global_id) * embedding_vec_size;
+  }
+  std::vector<size_t> recv_per_sample(total_gpu_count);
+  for (size_t j = 0; j < total_gpu_count; j++) {
+    recv_per_sample[j] = slots_of_gpu(j) * embedding_vec_size;
+  }
+
+  ncclDataType_t type;
+  switch (sizeof(Type)) {
+    case 2:
+      type = ncclHalf;
+      break;
+    case 4:
+      type = ncclFloat;
+      break;
+    default:
+      HCTR_OWN_THROW(Error_t::WrongInput, "Error: Type not support by now");
+  }
+
+  HCTR_LIB_THROW(ncclGroupStart());
+  for (size_t i = 0; i < local_gpu_count; i++) {
+    const auto &local_gpu = resource_manager.get_local_gpu(i);
+    size_t dst_offset = 0;
+    for (size_t j = 0; j < total_gpu_count; j++) {
+      const Type *src_chunk = send_tensors[i].get_ptr() +
+                              j * batch_size_per_gpu * send_per_sample[i] +
+                              sample_offset * send_per_sample[i];
+      Type *dst_chunk = recv_tensors[i].get_ptr() + dst_offset + sample_offset * recv_per_sample[j];
+      dst_offset += batch_size_per_gpu * recv_per_sample[j];
+
+      HCTR_LIB_THROW(ncclSend(src_chunk, sample_count * send_per_sample[i], type, j,
+                              local_gpu->get_nccl(), comm_streams[i]));
+      HCTR_LIB_THROW(ncclRecv(dst_chunk, sample_count * recv_per_sample[j], type, j,
+                              local_gpu->get_nccl(), comm_streams[i]));
+    }
+  }
+  HCTR_LIB_THROW(ncclGroupEnd());
+
+  return;
+}
+
+template void SparseEmbeddingFunctors::all2all_forward_chunk<float>(
+    size_t sample_offset, size_t sample_count, size_t batch_size_per_gpu, size_t slot_num,
+    size_t embedding_vec_size, const Tensors2<float> &send_tensors, Tensors2<float> &recv_tensors,
+    const ResourceManager &resource_manager, const std::vector<cudaStream_t> &comm_streams);
+
+template void SparseEmbeddingFunctors::all2all_forward_chunk<__half>(
+    size_t sample_offset, size_t sample_count, size_t batch_size_per_gpu, size_t slot_num,
+    size_t embedding_vec_size, const Tensors2<__half> &send_tensors, Tensors2<__half> &recv_tensors,
+    const ResourceManager &resource_manager, const std::vector<cudaStream_t> &comm_streams);
+
 #else
 
 template <typename Type>
@@ -273,6 +346,68 @@ template void SparseEmbeddingFunctors::all2all_forward<__half>(
     size_t embedding_vec_size, const Tensors2<__half> &send_tensors, Tensors2<__half> &recv_tensors,
     const ResourceManager &resource_manager);
 
+template <typename Type>
+void SparseEmbeddingFunctors::all2all_forward_chunk(
+    size_t sample_offset, size_t sample_count, size_t batch_size_per_gpu,
+    const std::vector<size_t> &slot_num_per_gpu, size_t embedding_vec_size,
+    const Tensors2<Type> &send_tensors, Tensors2<Type> &recv_tensors,
+    const ResourceManager &resource_manager, const std::vector<cudaStream_t> &comm_streams) {
+  size_t local_gpu_count = resource_manager.get_local_gpu_count();
+
+  // Elements one sample contributes to each peer; within a (src, dst) block the layout is
+  // sample-major, so a sample range maps onto one contiguous sub-block per peer.
+  std::vector<size_t> elems_per_sample(local_gpu_count);
+  for (size_t id = 0; id < local_gpu_count; id++) {
+    elems_per_sample[id] = slot_num_per_gpu[id] * embedding_vec_size;
+  }
+
+  ncclDataType_t type;
+  switch (sizeof(Type)) {
+    case 2:
+      type = ncclHalf;
+      break;
+    case 4:
+      type = ncclFloat;
+      break;
+    default:
+      HCTR_OWN_THROW(Error_t::WrongInput, "Error: Type not support by now");
+  }
+
+  HCTR_LIB_THROW(ncclGroupStart());
+  for (size_t i = 0; i < local_gpu_count; i++) {
+    const auto &local_gpu = resource_manager.get_local_gpu(i);
+    size_t dst_offset = 0;
+    for (size_t j = 0; j < local_gpu_count; j++) {
+      const Type *src_chunk = send_tensors[i].get_ptr() +
+                              j * batch_size_per_gpu * elems_per_sample[i] +
+                              sample_offset * elems_per_sample[i];
+      Type *dst_chunk =
+          recv_tensors[i].get_ptr() + dst_offset + sample_offset * elems_per_sample[j];
+      dst_offset += batch_size_per_gpu * elems_per_sample[j];
+
+      HCTR_LIB_THROW(ncclSend(src_chunk, sample_count * elems_per_sample[i], type, j,
+                              local_gpu->get_nccl(), comm_streams[i]));
+      HCTR_LIB_THROW(ncclRecv(dst_chunk, sample_count * elems_per_sample[j], type, j,
+                              local_gpu->get_nccl(), comm_streams[i]));
+    }
+  }
+  HCTR_LIB_THROW(ncclGroupEnd());
+
+  return;
+}
+
+template void SparseEmbeddingFunctors::all2all_forward_chunk<float>(
+    size_t sample_offset, size_t sample_count, size_t batch_size_per_gpu,
+    const std::vector<size_t> &slot_num_per_gpu, size_t embedding_vec_size,
+    const Tensors2<float> &send_tensors, Tensors2<float> &recv_tensors,
+    const ResourceManager &resource_manager, const std::vector<cudaStream_t> &comm_streams);
+
+template void SparseEmbeddingFunctors::all2all_forward_chunk<__half>(
+    size_t sample_offset, size_t sample_count, size_t batch_size_per_gpu,
+    const std::vector<size_t> &slot_num_per_gpu, size_t embedding_vec_size,
+    const Tensors2<__half> &send_tensors, Tensors2<__half> &recv_tensors,
+    const ResourceManager &resource_manager, const std::vector<cudaStream_t> &comm_streams);
+
 #endif
 
 }  // namespace HugeCTR
@@ -17,6 +17,7 @@
 #include <thrust/sort.h>
 
 #include <algorithm>
+#include <cstdlib>
 #include <cub/cub.cuh>
 #include <filesystem>
 #include <numeric>
@@ -265,6 +266,13 @@ DistributedSlotSparseEmbeddingHash<TypeHashKey, TypeEmbeddingComp>::
                      &tensor);
         utest_forward_temp_tensors_.push_back(tensor);
       }
+      // touched-row bitmaps for incremental dumping (one bit per hash table value row)
+      if (std::getenv("HCTR_KAFKA_SYNC_INTERVAL")) {
+        track_touched_rows_ = true;
+        Tensor2<uint32_t> tensor;
+        buf->reserve({(max_vocabulary_size_per_gpu_ + 31) / 32}, &tensor);
+        touched_rows_tensors_.push_back(tensor);
+      }
       // temp storage for filter keys
       {
         size_t max_nnz = embedding_data_.embedding_params_.get_universal_batch_size() *
@@ -298,6 +306,11 @@ DistributedSlotSparseEmbeddingHash<TypeHashKey, TypeEmbeddingComp>::
       context.set_device(embedding_data_.get_local_gpu(id).get_device_id());
       embedding_optimizers_[id].initialize(embedding_data_.get_local_gpu(id));
 
+      if (track_touched_rows_) {
+        HCTR_LIB_THROW(cudaMemsetAsync(touched_rows_tensors_[id].get_ptr(), 0,
+                                       touched_rows_tensors_[id].get_size_in_bytes(),
+                                       embedding_data_.get_local_gpu(id).get_stream()));
+      }
     }  // end of for(int id = 0; id < embedding_data_.get_local_gpu_count(); id++)
 
     if (!embedding_data_.embedding_params_.slot_size_array.empty()) {
@@ -581,6 +594,102 @@ void DistributedSlotSparseEmbeddingHash<TypeHashKey, TypeEmbeddingComp>::load_pa
   functors_.sync_all_gpus(embedding_data_.get_resource_manager());
 }
 
+template <typename TypeHashKey, typename TypeEmbeddingComp>
+bool DistributedSlotSparseEmbeddingHash<TypeHashKey, TypeEmbeddingComp>::reshard_parameters(
+    BufferBag &buf_bag, size_t *num) {
+  Tensor2<TypeHashKey> keys = Tensor2<TypeHashKey>::stretch_from(buf_bag.keys);
+  Tensor2<float> &embeddings = buf_bag.embedding;
+  TypeHashKey *key_ptr = keys.get_ptr();
+  float *embedding_ptr = embeddings.get_ptr();
+
+  const auto &resource_manager = embedding_data_.get_resource_manager();
+  const int n_ranks = resource_manager.get_num_process();
+  const int my_rank = resource_manager.get_process_id();
+  const size_t global_gpu_count = resource_manager.get_global_gpu_count();
+  const size_t embedding_vec_size = embedding_data_.embedding_params_.embedding_vec_size;
+
+  // Partition the dumped pairs by the rank that owns them under the current topology. The pairs
+  // are pulled into per-rank staging vectors so the bag itself can be compacted in place below.
+  std::vector<std::vector<TypeHashKey>> keys_per_rank(n_ranks);
+  std::vector<std::vector<float>> vecs_per_rank(n_ranks);
+  for (size_t i = 0; i < *num; i++) {
+    const TypeHashKey key = key_ptr[i];
+    const int dst_rank = resource_manager.get_process_id_from_gpu_global_id(
+        static_cast<size_t>(key) % global_gpu_count);
+    keys_per_rank[dst_rank].push_back(key);
+    const float *vec_ptr = embedding_ptr + i * embedding_vec_size;
+    vecs_per_rank[dst_rank].insert(vecs_per_rank[dst_rank].end(), vec_ptr,
+                                   vec_ptr + embedding_vec_size);
+  }
+
+  size_t num_local = keys_per_rank[my_rank].size();
+  memcpy(key_ptr, keys_per_rank[my_rank].data(), num_local * sizeof(TypeHashKey));
+  memcpy(embedding_ptr, vecs_per_rank[my_rank].data(),
+         num_local * embedding_vec_size * sizeof(float));
+
+#ifdef ENABLE_MPI
+  if (n_ranks > 1) {
+    const MPI_Datatype key_type = (sizeof(TypeHashKey) == 8) ? MPI_LONG_LONG : MPI_UNSIGNED;
+
+    std::vector<int> send_counts(n_ranks, 0), recv_counts(n_ranks, 0);
+    for (int p = 0; p < n_ranks; p++) {
+      if (p != my_rank) send_counts[p] = static_cast<int>(keys_per_rank[p].size());
+    }
+    HCTR_MPI_THROW(MPI_Alltoall(send_counts.data(), 1, MPI_INT, recv_counts.data(), 1, MPI_INT,
+                                MPI_COMM_WORLD));
+
+    std::vector<int> send_displs(n_ranks + 1, 0), recv_displs(n_ranks + 1, 0);
+    for (int p = 0; p < n_ranks; p++) {
+      send_displs[p + 1] = send_displs[p] + send_counts[p];
+      recv_displs[p + 1] = recv_displs[p] + recv_counts[p];
+    }
+
+    const size_t num_remote = recv_displs[n_ranks];
+    if (num_local + num_remote > keys.get_dimensions()[0]) {
+      HCTR_OWN_THROW(Error_t::OutOfMemory,
+                     "BufferBag cannot hold the keys migrated to this rank, its capacity was "
+                     "sized for the previous topology");
+    }
+
+    std::vector<TypeHashKey> send_keys(send_displs[n_ranks]);
+    std::vector<float> send_vecs(static_cast<size_t>(send_displs[n_ranks]) * embedding_vec_size);
+    for (int p = 0; p < n_ranks; p++) {
+      if (p == my_rank) continue;
+      std::copy(keys_per_rank[p].begin(), keys_per_rank[p].end(),
+                send_keys.begin() + send_displs[p]);
+      std::copy(vecs_per_rank[p].begin(), vecs_per_rank[p].end(),
+                send_vecs.begin() + static_cast<size_t>(send_displs[p]) * embedding_vec_size);
+    }
+
+    // Receive directly behind the keys this rank keeps, so the bag stays densely packed.
+    HCTR_MPI_THROW(MPI_Alltoallv(send_keys.data(), send_counts.data(), send_displs.data(),
+                                 key_type, key_ptr + num_local, recv_counts.data(),
+                                 recv_displs.data(), key_type, MPI_COMM_WORLD));
+
+    std::vector<int> send_vec_counts(n_ranks), recv_vec_counts(n_ranks);
+    std::vector<int> send_vec_displs(n_ranks), recv_vec_displs(n_ranks);
+    for (int p = 0; p < n_ranks; p++) {
+      send_vec_counts[p] = send_counts[p] * static_cast<int>(embedding_vec_size);
+      recv_vec_counts[p] = recv_counts[p] * static_cast<int>(embedding_vec_size);
+      send_vec_displs[p] = send_displs[p] * static_cast<int>(embedding_vec_size);
+      recv_vec_displs[p] = recv_displs[p] * static_cast<int>(embedding_vec_size);
+    }
+    HCTR_MPI_THROW(MPI_Alltoallv(send_vecs.data(), send_vec_counts.data(), send_vec_displs.data(),
+                                 MPI_FLOAT, embedding_ptr + num_local * embedding_vec_size,
+                                 recv_vec_counts.data(), recv_vec_displs.data(), MPI_FLOAT,
+                                 MPI_COMM_WORLD));
+
+    HCTR_LOG_S(INFO, WORLD) << "Resharded embedding: " << num_local << " keys stay, "
+                            << (*num - num_local) << " sent, " << num_remote << " received"
+                            << std::endl;
+    num_local += num_remote;
+  }
+#endif
+
+  *num = num_local;
+  return true;
+}
+
 template <typename TypeHashKey, typename TypeEmbeddingComp>
 void DistributedSlotSparseEmbeddingHash<TypeHashKey, TypeEmbeddingComp>::load_parameters(
     const Tensor2<TypeHashKey> &keys, const Tensor2<float> &embeddings, size_t num,
@@ -980,15 +1089,8 @@ void DistributedSlotSparseEmbeddingHash<TypeHashKey, TypeEmbeddingComp>::dump_pa
     hs->write(vec_file, reinterpret_cast<char *>(h_hash_table_value), total_count * vec_size, true);
   } else if (data_source_params.type == DataSourceType_t::Local) {
     // TODO: Move to self-contained DataSourceBackend implementation.
-    std::ofstream key_stream(key_file, std::ofstream::binary | std::ofstream::trunc);
-    std::ofstream vec_stream(vec_file, std::ofstream::binary | std::ofstream::trunc);
-    // check if the file is opened successfully
-    if (!vec_stream.is_open() || !key_stream.is_open()) {
-      HCTR_OWN_THROW(Error_t::WrongInput, "Error: file not open for writing");
-      return;
-    }
-    key_stream.write(reinterpret_cast<char *>(h_key_ptr), total_count * key_size);
-    vec_stream.write(reinterpret_cast<char *>(h_hash_table_value), total_count * vec_size);
+    parallel_file_write(key_file, h_key_ptr, total_count * key_size);
+    parallel_file_write(vec_file, h_hash_table_value, total_count * vec_size);
   } else {
     HCTR_OWN_THROW(Error_t::WrongInput, "Filesystem not supported yet.");
   }
@@ -1163,6 +1265,24 @@ void DistributedSlotSparseEmbeddingHash<TypeHashKey, TypeEmbeddingComp>::reset()
   }
 }
 
+template <typename TypeHashKey, typename TypeEmbeddingComp>
+bool DistributedSlotSparseEmbeddingHash<TypeHashKey, TypeEmbeddingComp>::dump_incremental(
+    std::vector<long long> &keys, std::vector<float> &vectors) {
+  if (!track_touched_rows_) {
+    return false;
+  }
+
+  std::vector<TypeHashKey> typed_keys;
+  functors_.get_touched_update_params_results(
+      embedding_data_.embedding_params_.embedding_vec_size, hash_table_value_tensors_, hash_tables_,
+      touched_rows_tensors_, typed_keys, vectors, embedding_data_.get_resource_manager());
+
+  keys.resize(typed_keys.size());
+  std::transform(typed_keys.begin(), typed_keys.end(), keys.begin(),
+                 [](TypeHashKey key) { return static_cast<long long>(key); });
+  return true;
+}
+
 template <typename TypeHashKey, typename TypeEmbeddingComp>
 void DistributedSlotSparseEmbeddingHash<TypeHashKey, TypeEmbeddingComp>::reset_optimizer() {
   CudaDeviceContext context;
@@ -112,6 +112,150 @@ __global__ void forward_sum_align2_kernel(int batch_size, int slot_num, int embe
   }
 }
 
+// float4-vectorized variant for the float output path: each thread owns four consecutive
+// elements of the embedding vector, so every row is fetched with 128-bit loads.
+template <typename TypeKey>
+__global__ void forward_sum_align4_kernel(int batch_size, int slot_num, int embedding_vec_size,
+                                          const TypeKey *row_offset,
+                                          const size_t *hash_value_index,
+                                          const float *hash_table_value,
+                                          float *embedding_feature) {
+  int bid = blockIdx.x;   // each block corresponding to one sample
+  int tid = threadIdx.x;  // each thread corresponding to four elements of the embedding vector
+
+  if (bid < batch_size && tid < embedding_vec_size) {
+    const float4 *hash_table_value4 = reinterpret_cast<const float4 *>(hash_table_value);
+    float4 *embedding_feature4 = reinterpret_cast<float4 *>(embedding_feature);
+
+    for (int i = 0; i < slot_num; i++) {
+      int feature_row_index = bid * slot_num + i;
+      TypeKey value_offset = row_offset[feature_row_index];
+      TypeKey feature_num =
+          row_offset[feature_row_index + 1] - value_offset;  // number of hash values in one slot
+
+      float4 sum = {0.0f, 0.0f, 0.0f, 0.0f};
+
+      // reduce in a slot
+      for (int j = 0; j < feature_num; j++) {
+        size_t value_index = hash_value_index[value_offset + j];
+        if (value_index != std::numeric_limits<size_t>::max()) {
+          float4 value = hash_table_value4[value_index * embedding_vec_size + tid];
+          sum.x += value.x;
+          sum.y += value.y;
+          sum.z += value.z;
+          sum.w += value.w;
+        }
+      }
+
+      // store the embedding vector
+      embedding_feature4[feature_row_index * embedding_vec_size + tid] = sum;
+    }
+  }
+}
+
+// Slot-parallel variant of forward_sum_kernel: one block per (sample, slot) pair instead of a
+// serial loop over the slots. With many small slots the loop kernels only expose batch_size
+// blocks of parallelism and the slot loop dominates, so models with 100+ slots run far below
+// the GPU's occupancy limit.
+template <typename TypeKey, typename TypeEmbeddingComp>
+__global__ void forward_sum_slot_parallel_kernel(int batch_size, int slot_num,
+                                                 int embedding_vec_size, const TypeKey *row_offset,
+                                                 const size_t *hash_value_index,
+                                                 const float *hash_table_value,
+                                                 TypeEmbeddingComp *embedding_feature) {
+  int bid = blockIdx.x;   // each block corresponding to one (sample, slot) pair
+  int tid = threadIdx.x;  // each thread corresponding to one element in the embedding vector
+
+  if (bid < batch_size && tid < embedding_vec_size) {
+    int feature_row_index = bid * slot_num + blockIdx.y;
+    TypeKey value_offset = row_offset[feature_row_index];
+    TypeKey feature_num = row_offset[feature_row_index + 1] - value_offset;
+
+    float sum = 0.0f;
+
+    // reduce in a slot
+    for (int j = 0; j < feature_num; j++) {
+      size_t value_index = hash_value_index[value_offset + j];
+      sum += (value_index != std::numeric_limits<size_t>::max())
+                 ? hash_table_value[value_index * embedding_vec_size + tid]
+                 : 0.0f;
+    }
+
+    // store the embedding vector
+    embedding_feature[feature_row_index * embedding_vec_size + tid] =
+        TypeConvertFunc<TypeEmbeddingComp, float>::convert(sum);
+  }
+}
+
+// Slot-parallel variant of forward_sum_align2_kernel.
+template <typename TypeKey>
+__global__ void forward_sum_align2_slot_parallel_kernel(
+    int batch_size, int slot_num, int embedding_vec_size, const TypeKey *row_offset,
+    const size_t *hash_value_index, const float *hash_table_value, __half *embedding_feature) {
+  int bid = blockIdx.x;   // each block corresponding to one (sample, slot) pair
+  int tid = threadIdx.x;  // each thread corresponding to one element in the embedding vector
+
+  if (bid < batch_size && tid < embedding_vec_size) {
+    const float2 *hash_table_value2 = reinterpret_cast<const float2 *>(hash_table_value);
+    __half2 *embedding_feature2 = reinterpret_cast<__half2 *>(embedding_feature);
+
+    int feature_row_index = bid * slot_num + blockIdx.y;
+    TypeKey value_offset = row_offset[feature_row_index];
+    TypeKey feature_num = row_offset[feature_row_index + 1] - value_offset;
+
+    // use float type to do accumulation
+    float2 sum2 = {0.0f, 0.0f};
+    for (int j = 0; j < feature_num; j++) {
+      size_t value_index = hash_value_index[value_offset + j];
+      sum2.x += (value_index != std::numeric_limits<size_t>::max())
+                    ? hash_table_value2[value_index * embedding_vec_size + tid].x
+                    : 0.0f;
+      sum2.y += (value_index != std::numeric_limits<size_t>::max())
+                    ? hash_table_value2[value_index * embedding_vec_size + tid].y
+                    : 0.0f;
+    }
+    __half2 sum = __float22half2_rn(sum2);
+
+    // store the embedding vector
+    embedding_feature2[feature_row_index * embedding_vec_size + tid] = sum;
+  }
+}
+
+// Slot-parallel variant of forward_sum_align4_kernel.
+template <typename TypeKey>
+__global__ void forward_sum_align4_slot_parallel_kernel(
+    int batch_size, int slot_num, int embedding_vec_size, const TypeKey *row_offset,
+    const size_t *hash_value_index, const float *hash_table_value, float *embedding_feature) {
+  int bid = blockIdx.x;   // each block corresponding to one (sample, slot) pair
+  int tid = threadIdx.x;  // each thread corresponding to four elements of the embedding vector
+
+  if (bid < batch_size && tid < embedding_vec_size) {
+    const float4 *hash_table_value4 = reinterpret_cast<const float4 *>(hash_table_value);
+    float4 *embedding_feature4 = reinterpret_cast<float4 *>(embedding_feature);
+
+    int feature_row_index = bid * slot_num + blockIdx.y;
+    TypeKey value_offset = row_offset[feature_row_index];
+    TypeKey feature_num = row_offset[feature_row_index + 1] - value_offset;
+
+    float4 sum = {0.0f, 0.0f, 0.0f, 0.0f};
+
+    // reduce in a slot
+    for (int j = 0; j < feature_num; j++) {
+      size_t value_index = hash_value_index[value_offset + j];
+      if (value_index != std::numeric_limits<size_t>::max()) {
+        float4 value = hash_table_value4[value_index * embedding_vec_size + tid];
+        sum.x += value.x;
+        sum.y += value.y;
+        sum.z += value.z;
+        sum.w += value.w;
+      }
+    }
+
+    // store the embedding vector
+    embedding_feature4[feature_row_index * embedding_vec_size + tid] = sum;
+  }
+}
+
 // forward kernel funcion: for combiner=mean in LocalizedEmbedding
 template <typename TypeKey, typename TypeEmbeddingComp>
 __global__ void forward_mean_kernel(int batch_size, int slot_num, int embedding_vec_size,
@@ -194,25 +338,333 @@ __global__ void forward_mean_align2_kernel(int batch_size, int slot_num, int emb
   }
 }
 
+// float4-vectorized variant for the float output path; accumulation matches
+// forward_mean_kernel, only the loads/stores are widened.
+template <typename TypeKey>
+__global__ void forward_mean_align4_kernel(int batch_size, int slot_num, int embedding_vec_size,
+                                           const TypeKey *row_offset,
+                                           const size_t *hash_value_index,
+                                           const float *hash_table_value,
+                                           float *embedding_feature) {
+  int bid = blockIdx.x;   // each block corresponding to one sample
+  int tid = threadIdx.x;  // each thread corresponding to four elements of the embedding vector
+
+  if (bid < batch_size && tid < embedding_vec_size) {
+    const float4 *hash_table_value4 = reinterpret_cast<const float4 *>(hash_table_value);
+    float4 *embedding_feature4 = reinterpret_cast<float4 *>(embedding_feature);
+
+    for (int i = 0; i < slot_num; i++) {
+      int feature_row_index = bid * slot_num + i;
+      TypeKey value_offset = row_offset[feature_row_index];
+      int feature_num =
+          row_offset[feature_row_index + 1] - value_offset;  // number of hash values in one slot
+
+      float4 sum = {0.0f, 0.0f, 0.0f, 0.0f};
+
+      // reduce in a slot
+      for (int j = 0; j < feature_num; j++) {
+        size_t value_index = hash_value_index[value_offset + j];
+        if (value_index != std::numeric_limits<size_t>::max()) {
+          float4 value = hash_table_value4[value_index * embedding_vec_size + tid];
+          sum.x += value.x;
+          sum.y += value.y;
+          sum.z += value.z;
+          sum.w += value.w;
+        }
+      }
+
+      float scaler = 1.0f;
+      if (feature_num > 1) {
+        scaler = 1.0f / feature_num;
+      }
+
+      // store the embedding vector
+      sum.x *= scaler;
+      sum.y *= scaler;
+      sum.z *= scaler;
+      sum.w *= scaler;
+      embedding_feature4[feature_row_index * embedding_vec_size + tid] = sum;
+    }
+  }
+}
+
+// Slot-parallel variant of forward_mean_kernel.
+template <typename TypeKey, typename TypeEmbeddingComp>
+__global__ void forward_mean_slot_parallel_kernel(int batch_size, int slot_num,
+                                                  int embedding_vec_size, const TypeKey *row_offset,
+                                                  const size_t *hash_value_index,
+                                                  const float *hash_table_value,
+                                                  TypeEmbeddingComp *embedding_feature) {
+  int bid = blockIdx.x;   // each block corresponding to one (sample, slot) pair
+  int tid = threadIdx.x;  // each thread corresponding to one element in the embedding vector
+
+  if (bid < batch_size && tid < embedding_vec_size) {
+    int feature_row_index = bid * slot_num + blockIdx.y;
+    TypeKey value_offset = row_offset[feature_row_index];
+    int feature_num = row_offset[feature_row_index + 1] - value_offset;
+
+    float sum = 0.0f;
+
+    // reduce in a slot
+    for (int j = 0; j < feature_num; j++) {
+      size_t value_index = hash_value_index[value_offset + j];
+      sum += (value_index != std::numeric_limits<size_t>::max())
+                 ? hash_table_value[value_index * embedding_vec_size + tid]
+                 : 0.0f;
+    }
+
+    float scaler = 1.0f;
+    if (feature_num > 1) {
+      scaler = 1.0f / feature_num;
+    }
+
+    // store the embedding vector
+    embedding_feature[feature_row_index * embedding_vec_size + tid] =
+        TypeConvertFunc<TypeEmbeddingComp, float>::convert(sum * scaler);
+  }
+}
+
+// Slot-parallel variant of forward_mean_align2_kernel.
+template <typename TypeKey>
+__global__ void forward_mean_align2_slot_parallel_kernel(
+    int batch_size, int slot_num, int embedding_vec_size, const TypeKey *row_offset,
+    const size_t *hash_value_index, const float *hash_table_value, __half *embedding_feature) {
+  int bid = blockIdx.x;   // each block corresponding to one (sample, slot) pair
+  int tid = threadIdx.x;  // each thread corresponding to one element in the embedding vector
+
+  if (bid < batch_size && tid < embedding_vec_size) {
+    const float2 *hash_table_value2 = reinterpret_cast<const float2 *>(hash_table_value);
+    __half2 *embedding_feature2 = reinterpret_cast<__half2 *>(embedding_feature);
+
+    int feature_row_index = bid * slot_num + blockIdx.y;
+    TypeKey value_offset = row_offset[feature_row_index];
+    int feature_num = row_offset[feature_row_index + 1] - value_offset;
+
+    // use float to do accumulation
+    float2 sum = {0.0f, 0.0f};
+    for (int j = 0; j < feature_num; j++) {
+      size_t value_index = hash_value_index[value_offset + j];
+      sum.x += (value_index != std::numeric_limits<size_t>::max())
+                   ? hash_table_value2[value_index * embedding_vec_size + tid].x
+                   : 0.0f;
+      sum.y += (value_index != std::numeric_limits<size_t>::max())
+                   ? hash_table_value2[value_index * embedding_vec_size + tid].y
+                   : 0.0f;
+    }
+    __half2 sum2 = __float22half2_rn(sum);
+
+    float scaler = 1.0f;
+    if (feature_num > 1) {
+      scaler = 1.0f / feature_num;
+    }
+    __half2 scaler2 = __float2half2_rn(scaler);
+
+    // store the embedding vector
+    embedding_feature2[feature_row_index * embedding_vec_size + tid] = __hmul2(sum2, scaler2);
+  }
+}
+
+// Slot-parallel variant of forward_mean_align4_kernel.
+template <typename TypeKey>
+__global__ void forward_mean_align4_slot_parallel_kernel(
+    int batch_size, int slot_num, int embedding_vec_size, const TypeKey *row_offset,
+    const size_t *hash_value_index, const float *hash_table_value, float *embedding_feature) {
+  int bid = blockIdx.x;   // each block corresponding to one (sample, slot) pair
+  int tid = threadIdx.x;  // each thread corresponding to four elements of the embedding vector
+
+  if (bid < batch_size && tid < embedding_vec_size) {
+    const float4 *hash_table_value4 = reinterpret_cast<const float4 *>(hash_table_value);
+    float4 *embedding_feature4 = reinterpret_cast<float4 *>(embedding_feature);
+
+    int feature_row_index = bid * slot_num + blockIdx.y;
+    TypeKey value_offset = row_offset[feature_row_index];
+    int feature_num = row_offset[feature_row_index + 1] - value_offset;
+
+    float4 sum = {0.0f, 0.0f, 0.0f, 0.0f};
+
+    // reduce in a slot
+    for (int j = 0; j < feature_num; j++) {
+      size_t value_index = hash_value_index[value_offset + j];
+      if (value_index != std::numeric_limits<size_t>::max()) {
+        float4 value = hash_table_value4[value_index * embedding_vec_size + tid];
+        sum.x += value.x;
+        sum.y += value.y;
+        sum.z += value.z;
+        sum.w += value.w;
+      }
+    }
+
+    float scaler = 1.0f;
+    if (feature_num > 1) {
+      scaler = 1.0f / feature_num;
+    }
+
+    // store the embedding vector
+    sum.x *= scaler;
+    sum.y *= scaler;
+    sum.z *= scaler;
+    sum.w *= scaler;
+    embedding_feature4[feature_row_index * embedding_vec_size + tid] = sum;
+  }
+}
+
+// INT8 variant of forward_sum_kernel: the embedding rows are stored as int8 plus one float
+// scale per row and are dequantized into the fp32 accumulators. The row traffic is already a
+// quarter of the fp32 path, so no vectorized variants are provided.
+template <typename TypeKey, typename TypeEmbeddingComp>
+__global__ void forward_sum_quantized_kernel(int batch_size, int slot_num, int embedding_vec_size,
+                                             const TypeKey *row_offset,
+                                             const size_t *hash_value_index,
+                                             const int8_t *quantized_table, const float *row_scale,
+                                             TypeEmbeddingComp *embedding_feature) {
+  int bid = blockIdx.x;   // each block corresponding to one sample
+  int tid = threadIdx.x;  // each thread corresponding to one element in the embedding vector
+
+  if (bid < batch_size && tid < embedding_vec_size) {
+    for (int i = 0; i < slot_num; i++) {
+      int feature_row_index = bid * slot_num + i;
+      TypeKey value_offset = row_offset[feature_row_index];
+      TypeKey feature_num =
+          row_offset[feature_row_index + 1] - value_offset;  // number of hash values in one slot
+
+      float sum = 0.0f;
+
+      // reduce in a slot
+      for (int j = 0; j < feature_num; j++) {
+        size_t value_index = hash_value_index[value_offset + j];
+        if (value_index != std::numeric_limits<size_t>::max()) {
+          sum += row_scale[value_index] *
+                 static_cast<float>(quantized_table[value_index * embedding_vec_size + tid]);
+        }
+      }
+
+      // store the embedding vector
+      embedding_feature[feature_row_index * embedding_vec_size + tid] =
+          TypeConvertFunc<TypeEmbeddingComp, float>::convert(sum);
+    }
+  }
+}
+
+// INT8 variant of forward_mean_kernel
+template <typename TypeKey, typename TypeEmbeddingComp>
+__global__ void forward_mean_quantized_kernel(int batch_size, int slot_num, int embedding_vec_size,
+                                              const TypeKey *row_offset,
+                                              const size_t *hash_value_index,
+                                              const int8_t *quantized_table, const float *row_scale,
+                                              TypeEmbeddingComp *embedding_feature) {
+  int bid = blockIdx.x;   // each block corresponding to one sample
+  int tid = threadIdx.x;  // each thread corresponding to one element in the embedding vector
+
+  if (bid < batch_size && tid < embedding_vec_size) {
+    for (int i = 0; i < slot_num; i++) {
+      int feature_row_index = bid * slot_num + i;
+      TypeKey value_offset = row_offset[feature_row_index];
+      int feature_num =
+          row_offset[feature_row_index + 1] - value_offset;  // number of hash values in one slot
+
+      float sum = 0.0f;
+
+      // reduce in a slot
+      for (int j = 0; j < feature_num; j++) {
+        size_t value_index = hash_value_index[value_offset + j];
+        if (value_index != std::numeric_limits<size_t>::max()) {
+          sum += row_scale[value_index] *
+                 static_cast<float>(quantized_table[value_index * embedding_vec_size + tid]);
+        }
+      }
+
+      float scaler = 1.0f;
+      if (feature_num > 1) {
+        scaler = 1.0f / feature_num;
+      }
+
+      // store the embedding vector
+      embedding_feature[feature_row_index * embedding_vec_size + tid] =
+          TypeConvertFunc<TypeEmbeddingComp, float>::convert(sum * scaler);
+    }
+  }
+}
+
+// With this many slots or more, the per-sample loop kernels spend most of their time in the
+// serial slot loop, so the launchers switch to the slot-parallel variants with one block per
+// (sample, slot) pair.
+constexpr size_t SLOT_PARALLEL_MIN_SLOTS = 32;
+
 // do sum reduction
 template <typename TypeHashKey, typename TypeEmbeddingComp>
 void forward_sum(size_t batch_size, size_t slot_num, size_t embedding_vec_size,
                  const TypeHashKey *row_offset, const size_t *hash_value_index,
                  const float *hash_table_value, TypeEmbeddingComp *embedding_feature,
                  cudaStream_t stream) {
-  const size_t grid_size = batch_size;  // each block corresponds to a sample
   const size_t block_size =
       embedding_vec_size;  // each thread corresponds to one element in an embedding vector
+  if (slot_num >= SLOT_PARALLEL_MIN_SLOTS) {
+    const dim3 grid_size(batch_size, slot_num);
+    forward_sum_slot_parallel_kernel<<<grid_size, block_size, 0, stream>>>(
+        batch_size, slot_num, embedding_vec_size, row_offset, hash_value_index, hash_table_value,
+        embedding_feature);
+    return;
+  }
+  const size_t grid_size = batch_size;  // each block corresponds to a sample
   forward_sum_kernel<<<grid_size, block_size, 0, stream>>>(batch_size, slot_num, embedding_vec_size,
                                                            row_offset, hash_value_index,
                                                            hash_table_value, embedding_feature);
 }
 
+// do sum reduction with float4 loads when the embedding vector allows it
+template <typename TypeHashKey>
+void forward_sum(size_t batch_size, size_t slot_num, size_t embedding_vec_size,
+                 const TypeHashKey *row_offset, const size_t *hash_value_index,
+                 const float *hash_table_value, float *embedding_feature, cudaStream_t stream) {
+  if (slot_num >= SLOT_PARALLEL_MIN_SLOTS) {
+    const dim3 grid_size(batch_size, slot_num);  // each block corresponds to a (sample, slot) pair
+    if (embedding_vec_size >= 32 && embedding_vec_size % 4 == 0) {
+      const size_t block_size = embedding_vec_size / 4;
+      forward_sum_align4_slot_parallel_kernel<<<grid_size, block_size, 0, stream>>>(
+          batch_size, slot_num, embedding_vec_size / 4, row_offset, hash_value_index,
+          hash_table_value, embedding_feature);
+    } else {
+      const size_t block_size = embedding_vec_size;
+      forward_sum_slot_parallel_kernel<<<grid_size, block_size, 0, stream>>>(
+          batch_size, slot_num, embedding_vec_size, row_offset, hash_value_index, hash_table_value,
+          embedding_feature);
+    }
+    return;
+  }
+  const size_t grid_size = batch_size;  // each block corresponds to a sample
+  if (embedding_vec_size >= 32 && embedding_vec_size % 4 == 0) {
+    const size_t block_size = embedding_vec_size / 4;
+    forward_sum_align4_kernel<<<grid_size, block_size, 0, stream>>>(
+        batch_size, slot_num, embedding_vec_size / 4, row_offset, hash_value_index,
+        hash_table_value, embedding_feature);
+  } else {
+    const size_t block_size = embedding_vec_size;
+    forward_sum_kernel<<<grid_size, block_size, 0, stream>>>(
+        batch_size, slot_num, embedding_vec_size, row_offset, hash_value_index, hash_table_value,
+        embedding_feature);
+  }
+}
+
 // do sum reduction
 template <typename TypeHashKey>
 void forward_sum(size_t batch_size, size_t slot_num, size_t embedding_vec_size,
                  const TypeHashKey *row_offset, const size_t *hash_value_index,
                  const float *hash_table_value, __half *embedding_feature, cudaStream_t stream) {
+  if (slot_num >= SLOT_PARALLEL_MIN_SLOTS) {
+    const dim3 grid_size(batch_size, slot_num);  // each block corresponds to a (sample, slot) pair
+    if (embedding_vec_size % 2 == 0) {
+      const size_t block_size = embedding_vec_size / 2;
+      forward_sum_align2_slot_parallel_kernel<<<grid_size, block_size, 0, stream>>>(
+          batch_size, slot_num, embedding_vec_size / 2, row_offset, hash_value_index,
+          hash_table_value, embedding_feature);
+    } else {
+      const size_t block_size = embedding_vec_size;
+      forward_sum_slot_parallel_kernel<<<grid_size, block_size, 0, stream>>>(
+          batch_size, slot_num, embedding_vec_size, row_offset, hash_value_index, hash_table_value,
+          embedding_feature);
+    }
+    return;
+  }
   const size_t grid_size = batch_size;  // each block corresponds to a sample
   if (embedding_vec_size % 2 == 0) {
     const size_t block_size = embedding_vec_size / 2;
@@ -233,17 +685,73 @@ void forward_mean(size_t batch_size, size_t slot_num, size_t embedding_vec_size,
                   const TypeHashKey *row_offset, const size_t *hash_value_index,
                   const float *hash_table_value, TypeEmbeddingComp *embedding_feature,
                   cudaStream_t stream) {
-  const size_t grid_size = batch_size;
   const size_t block_size = embedding_vec_size;
+  if (slot_num >= SLOT_PARALLEL_MIN_SLOTS) {
+    const dim3 grid_size(batch_size, slot_num);
+    forward_mean_slot_parallel_kernel<<<grid_size, block_size, 0, stream>>>(
+        batch_size, slot_num, embedding_vec_size, row_offset, hash_value_index, hash_table_value,
+        embedding_feature);
+    return;
+  }
+  const size_t grid_size = batch_size;
   forward_mean_kernel<<<grid_size, block_size, 0, stream>>>(
       batch_size, slot_num, embedding_vec_size, row_offset, hash_value_index, hash_table_value,
       embedding_feature);
 }
 
+// do mean reduction with float4 loads when the embedding vector allows it
+template <typename TypeHashKey>
+void forward_mean(size_t batch_size, size_t slot_num, size_t embedding_vec_size,
+                  const TypeHashKey *row_offset, const size_t *hash_value_index,
+                  const float *hash_table_value, float *embedding_feature, cudaStream_t stream) {
+  if (slot_num >= SLOT_PARALLEL_MIN_SLOTS) {
+    const dim3 grid_size(batch_size, slot_num);  // each block corresponds to a (sample, slot) pair
+    if (embedding_vec_size >= 32 && embedding_vec_size % 4 == 0) {
+      const size_t block_size = embedding_vec_size / 4;
+      forward_mean_align4_slot_parallel_kernel<<<grid_size, block_size, 0, stream>>>(
+          batch_size, slot_num, embedding_vec_size / 4, row_offset, hash_value_index,
+          hash_table_value, embedding_feature);
+    } else {
+      const size_t block_size = embedding_vec_size;
+      forward_mean_slot_parallel_kernel<<<grid_size, block_size, 0, stream>>>(
+          batch_size, slot_num, embedding_vec_size, row_offset, hash_value_index, hash_table_value,
+          embedding_feature);
+    }
+    return;
+  }
+  const size_t grid_size = batch_size;
+  if (embedding_vec_size >= 32 && embedding_vec_size % 4 == 0) {
+    const size_t block_size = embedding_vec_size / 4;
+    forward_mean_align4_kernel<<<grid_size, block_size, 0, stream>>>(
+        batch_size, slot_num, embedding_vec_size / 4, row_offset, hash_value_index,
+        hash_table_value, embedding_feature);
+  } else {
+    const size_t block_size = embedding_vec_size;
+    forward_mean_kernel<<<grid_size, block_size, 0, stream>>>(
+        batch_size, slot_num, embedding_vec_size, row_offset, hash_value_index, hash_table_value,
+        embedding_feature);
+  }
+}
+
 template <typename TypeHashKey>
 void forward_mean(size_t batch_size, size_t slot_num, size_t embedding_vec_size,
                   const TypeHashKey *row_offset, const size_t *hash_value_index,
                   const float *hash_table_value, __half *embedding_feature, cudaStream_t stream) {
+  if (slot_num >= SLOT_PARALLEL_MIN_SLOTS) {
+    const dim3 grid_size(batch_size, slot_num);  // each block corresponds to a (sample, slot) pair
+    if (embedding_vec_size % 2 == 0) {
+      const size_t block_size = embedding_vec_size / 2;
+      forward_mean_align2_slot_parallel_kernel<<<grid_size, block_size, 0, stream>>>(
+          batch_size, slot_num, embedding_vec_size / 2, row_offset, hash_value_index,
+          hash_table_value, embedding_feature);
+    } else {
+      const size_t block_size = embedding_vec_size;
+      forward_mean_slot_parallel_kernel<<<grid_size, block_size, 0, stream>>>(
+          batch_size, slot_num, embedding_vec_size, row_offset, hash_value_index, hash_table_value,
+          embedding_feature);
+    }
+    return;
+  }
   const size_t grid_size = batch_size;
   if (embedding_vec_size % 2 == 0) {
     const size_t block_size = embedding_vec_size / 2;
@@ -258,6 +766,26 @@ void forward_mean(size_t batch_size, size_t slot_num, size_t embedding_vec_size,
   }
 }
 
+// do sum/mean reduction from the int8 copy of the embedding table
+template <typename TypeHashKey, typename TypeEmbeddingComp>
+void forward_quantized(int combiner, size_t batch_size, size_t slot_num, size_t embedding_vec_size,
+                       const TypeHashKey *row_offset, const size_t *hash_value_index,
+                       const int8_t *quantized_table, const float *row_scale,
+                       TypeEmbeddingComp *embedding_feature, cudaStream_t stream) {
+  const size_t grid_size = batch_size;  // each block corresponds to a sample
+  const size_t block_size =
+      embedding_vec_size;  // each thread corresponds to one element in an embedding vector
+  if (combiner == 0) {
+    forward_sum_quantized_kernel<<<grid_size, block_size, 0, stream>>>(
+        batch_size, slot_num, embedding_vec_size, row_offset, hash_value_index, quantized_table,
+        row_scale, embedding_feature);
+  } else {
+    forward_mean_quantized_kernel<<<grid_size, block_size, 0, stream>>>(
+        batch_size, slot_num, embedding_vec_size, row_offset, hash_value_index, quantized_table,
+        row_scale, embedding_feature);
+  }
+}
+
 }  // namespace
 
 /**
@@ -333,6 +861,69 @@ template void SparseEmbeddingFunctors::forward_per_gpu<long long, __half>(
     HashTable<long long, size_t> &hash_table, const Tensor2<float> &hash_table_value,
     Tensor2<size_t> &hash_value_index, Tensor2<__half> &embedding_feature, cudaStream_t stream);
 
+/**
+ * forward propagation on each GPU serving the lookup from the int8 copy of the embedding
+ * table instead of the fp32 one; everything else matches forward_per_gpu().
+ * @param quantized_table int8 embedding rows
+ * @param row_scale per-row dequantization scales
+ */
+template <typename TypeHashKey, typename TypeEmbeddingComp>
+void SparseEmbeddingFunctors::forward_per_gpu_quantized(
+    size_t batch_size, size_t slot_num, size_t embedding_vec_size, int combiner, bool train,
+    const Tensor2<TypeHashKey> &row_offset, const Tensor2<TypeHashKey> &hash_key, size_t nnz,
+    HashTable<TypeHashKey, size_t> &hash_table, const Tensor2<char> &quantized_table,
+    const Tensor2<float> &row_scale, Tensor2<size_t> &hash_value_index,
+    Tensor2<TypeEmbeddingComp> &embedding_feature, cudaStream_t stream) {
+  try {
+    if (train) {
+      hash_table.get_insert(hash_key.get_ptr(), hash_value_index.get_ptr(), nnz, stream);
+    } else {
+      hash_table.get_mark(hash_key.get_ptr(), hash_value_index.get_ptr(), nnz, stream);
+    }
+
+    if (combiner != 0 && combiner != 1) {
+      HCTR_OWN_THROW(Error_t::WrongInput, "Invalid combiner type ");
+    }
+    forward_quantized(combiner, batch_size, slot_num, embedding_vec_size, row_offset.get_ptr(),
+                      hash_value_index.get_ptr(),
+                      reinterpret_cast<const int8_t *>(quantized_table.get_ptr()),
+                      row_scale.get_ptr(), embedding_feature.get_ptr(), stream);
+  } catch (const std::runtime_error &rt_err) {
+    HCTR_LOG_S(ERROR, WORLD) << rt_err.what() << std::endl;
+    throw;
+  }
+
+  return;
+}
+
+template void SparseEmbeddingFunctors::forward_per_gpu_quantized<unsigned int, float>(
+    size_t batch_size, size_t slot_num, size_t embedding_vec_size, int combiner, bool train,
+    const Tensor2<unsigned int> &row_offset, const Tensor2<unsigned int> &hash_key, size_t nnz,
+    HashTable<unsigned int, size_t> &hash_table, const Tensor2<char> &quantized_table,
+    const Tensor2<float> &row_scale, Tensor2<size_t> &hash_value_index,
+    Tensor2<float> &embedding_feature, cudaStream_t stream);
+
+template void SparseEmbeddingFunctors::forward_per_gpu_quantized<long long, float>(
+    size_t batch_size, size_t slot_num, size_t embedding_vec_size, int combiner, bool train,
+    const Tensor2<long long> &row_offset, const Tensor2<long long> &hash_key, size_t nnz,
+    HashTable<long long, size_t> &hash_table, const Tensor2<char> &quantized_table,
+    const Tensor2<float> &row_scale, Tensor2<size_t> &hash_value_index,
+    Tensor2<float> &embedding_feature, cudaStream_t stream);
+
+template void SparseEmbeddingFunctors::forward_per_gpu_quantized<unsigned int, __half>(
+    size_t batch_size, size_t slot_num, size_t embedding_vec_size, int combiner, bool train,
+    const Tensor2<unsigned int> &row_offset, const Tensor2<unsigned int> &hash_key, size_t nnz,
+    HashTable<unsigned int, size_t> &hash_table, const Tensor2<char> &quantized_table,
+    const Tensor2<float> &row_scale, Tensor2<size_t> &hash_value_index,
+    Tensor2<__half> &embedding_feature, cudaStream_t stream);
+
+template void SparseEmbeddingFunctors::forward_per_gpu_quantized<long long, __half>(
+    size_t batch_size, size_t slot_num, size_t embedding_vec_size, int combiner, bool train,
+    const Tensor2<long long> &row_offset, const Tensor2<long long> &hash_key, size_t nnz,
+    HashTable<long long, size_t> &hash_table, const Tensor2<char> &quantized_table,
+    const Tensor2<float> &row_scale, Tensor2<size_t> &hash_value_index,
+    Tensor2<__half> &embedding_feature, cudaStream_t stream);
+
 template <typename TypeHashKey, typename TypeEmbeddingComp>
 void SparseEmbeddingFunctors::forward_sum_per_gpu(
     size_t batch_size, size_t slot_num, size_t embedding_vec_size, int combiner, bool train,
@@ -23,9 +23,9 @@ namespace {
 
 // reorder operation after all2all in forward propagation
 template <typename TypeEmbeddingComp>
-__global__ void forward_reorder_kernel(int batch_size_per_gpu, int slot_num, int embedding_vec_size,
-                                       int gpu_num, const TypeEmbeddingComp *input,
-                                       TypeEmbeddingComp *output) {
+__global__ void forward_reorder_kernel(int sample_offset, int batch_size_per_gpu, int slot_num,
+                                       int embedding_vec_size, int gpu_num,
+                                       const TypeEmbeddingComp *input, TypeEmbeddingComp *output) {
   // blockDim.x = embedding_vec_size; // each thread corresponding to one element of embedding
   // vector gridDim.x = batch_size / gpu_num = samples_per_gpu; // each block corresponding to one
   // sample on each GPU Each thread needs to process slot_num slots
@@ -33,9 +33,9 @@ __global__ void forward_reorder_kernel(int batch_size_per_gpu, int slot_num, int
   int tid = threadIdx.x;
   int bid = blockIdx.x;
 
-  int sample_id = bid;  // sample_id on the current GPU
+  int sample_id = sample_offset + bid;  // sample_id on the current GPU
 
-  if ((bid < batch_size_per_gpu) && (tid < embedding_vec_size)) {
+  if ((sample_id < batch_size_per_gpu) && (tid < embedding_vec_size)) {
     int dst_offset =
         sample_id * slot_num * embedding_vec_size;  // offset for the first slot of one sample
     int dst_stride = embedding_vec_size;            // stride from slot to slot
@@ -59,8 +59,8 @@ __global__ void forward_reorder_kernel(int batch_size_per_gpu, int slot_num, int
 }
 
 // reorder operation after all2all in forward propagation
-__global__ void forward_reorder_align2_kernel(int batch_size_per_gpu, int slot_num,
-                                              int embedding_vec_size, int gpu_num,
+__global__ void forward_reorder_align2_kernel(int sample_offset, int batch_size_per_gpu,
+                                              int slot_num, int embedding_vec_size, int gpu_num,
                                               const __half *input, __half *output) {
   // blockDim.x = embedding_vec_size; // each thread corresponding to one element of embedding
   // vector gridDim.x = batch_size / gpu_num = samples_per_gpu; // each block corresponding to one
@@ -69,9 +69,9 @@ __global__ void forward_reorder_align2_kernel(int batch_size_per_gpu, int slot_n
   int tid = threadIdx.x;
   int bid = blockIdx.x;
 
-  int sample_id = bid;  // sample_id on the current GPU
+  int sample_id = sample_offset + bid;  // sample_id on the current GPU
 
-  if ((bid < batch_size_per_gpu) && (tid < embedding_vec_size)) {
+  if ((sample_id < batch_size_per_gpu) && (tid < embedding_vec_size)) {
     const __half2 *input2 = reinterpret_cast<const __half2 *>(input);
     __half2 *output2 = reinterpret_cast<__half2 *>(output);
 
@@ -98,27 +98,31 @@ __global__ void forward_reorder_align2_kernel(int batch_size_per_gpu, int slot_n
 }
 
 template <typename TypeEmbeddingComp>
-void do_forward_reorder(size_t batch_size_per_gpu, size_t slot_num, size_t embedding_vec_size,
-                        size_t total_gpu_count, const TypeEmbeddingComp *input,
-                        TypeEmbeddingComp *output, cudaStream_t stream) {
-  const size_t grid_size = batch_size_per_gpu;
+void do_forward_reorder(size_t sample_offset, size_t sample_count, size_t batch_size_per_gpu,
+                        size_t slot_num, size_t embedding_vec_size, size_t total_gpu_count,
+                        const TypeEmbeddingComp *input, TypeEmbeddingComp *output,
+                        cudaStream_t stream) {
+  const size_t grid_size = sample_count;
   const size_t block_size = embedding_vec_size;
-  forward_reorder_kernel<<<grid_size, block_size, 0, stream>>>(
-      batch_size_per_gpu, slot_num, embedding_vec_size, total_gpu_count, input, output);
+  forward_reorder_kernel<<<grid_size, block_size, 0, stream>>>(sample_offset, batch_size_per_gpu,
+                                                               slot_num, embedding_vec_size,
+                                                               total_gpu_count, input, output);
 }
 
-void do_forward_reorder(size_t batch_size_per_gpu, size_t slot_num, size_t embedding_vec_size,
-                        size_t total_gpu_count, const __half *input, __half *output,
-                        cudaStream_t stream) {
-  const size_t grid_size = batch_size_per_gpu;
+void do_forward_reorder(size_t sample_offset, size_t sample_count, size_t batch_size_per_gpu,
+                        size_t slot_num, size_t embedding_vec_size, size_t total_gpu_count,
+                        const __half *input, __half *output, cudaStream_t stream) {
+  const size_t grid_size = sample_count;
   if (embedding_vec_size % 2 == 0) {
     const size_t block_size = embedding_vec_size / 2;
     forward_reorder_align2_kernel<<<grid_size, block_size, 0, stream>>>(
-        batch_size_per_gpu, slot_num, embedding_vec_size / 2, total_gpu_count, input, output);
+        sample_offset, batch_size_per_gpu, slot_num, embedding_vec_size / 2, total_gpu_count, input,
+        output);
   } else {
     const size_t block_size = embedding_vec_size;
     forward_reorder_kernel<<<grid_size, block_size, 0, stream>>>(
-        batch_size_per_gpu, slot_num, embedding_vec_size, total_gpu_count, input, output);
+        sample_offset, batch_size_per_gpu, slot_num, embedding_vec_size, total_gpu_count, input,
+        output);
   }
 }
 
@@ -170,8 +174,8 @@ void SparseEmbeddingFunctors::forward_reorder(size_t batch_size_per_gpu, size_t
     const auto &local_gpu = resource_manager.get_local_gpu(id);
     context.set_device(local_gpu->get_device_id());
 
-    do_forward_reorder(batch_size_per_gpu, slot_num, embedding_vec_size, total_gpu_count,
-                       src_tensors[id].get_ptr(), dst_tensors[id].get_ptr(),
+    do_forward_reorder(0, batch_size_per_gpu, batch_size_per_gpu, slot_num, embedding_vec_size,
+                       total_gpu_count, src_tensors[id].get_ptr(), dst_tensors[id].get_ptr(),
                        local_gpu->get_stream());
   }
 }
@@ -186,4 +190,33 @@ template void SparseEmbeddingFunctors::forward_reorder<__half>(
     const Tensors2<__half> &src_tensors, Tensors2<__half> &dst_tensors,
     const ResourceManager &resource_manager);
 
+template <typename TypeEmbeddingComp>
+void SparseEmbeddingFunctors::forward_reorder_chunk(
+    size_t sample_offset, size_t sample_count, size_t batch_size_per_gpu, size_t slot_num,
+    size_t embedding_vec_size, const Tensors2<TypeEmbeddingComp> &src_tensors,
+    Tensors2<TypeEmbeddingComp> &dst_tensors, const ResourceManager &resource_manager) {
+  CudaDeviceContext context;
+  size_t local_gpu_count = resource_manager.get_local_gpu_count();
+  size_t total_gpu_count = resource_manager.get_global_gpu_count();
+
+  for (size_t id = 0; id < local_gpu_count; id++) {
+    const auto &local_gpu = resource_manager.get_local_gpu(id);
+    context.set_device(local_gpu->get_device_id());
+
+    do_forward_reorder(sample_offset, sample_count, batch_size_per_gpu, slot_num,
+                       embedding_vec_size, total_gpu_count, src_tensors[id].get_ptr(),
+                       dst_tensors[id].get_ptr(), local_gpu->get_stream());
+  }
+}
+
+template void SparseEmbeddingFunctors::forward_reorder_chunk<float>(
+    size_t sample_offset, size_t sample_count, size_t batch_size_per_gpu, size_t slot_num,
+    size_t embedding_vec_size, const Tensors2<float> &src_tensors, Tensors2<float> &dst_tensors,
+    const ResourceManager &resource_manager);
+
+template void SparseEmbeddingFunctors::forward_reorder_chunk<__half>(
+    size_t sample_offset, size_t sample_count, size_t batch_size_per_gpu, size_t slot_num,
+    size_t embedding_vec_size, const Tensors2<__half> &src_tensors, Tensors2<__half> &dst_tensors,
+    const ResourceManager &resource_manager);
+
 }  // namespace HugeCTR
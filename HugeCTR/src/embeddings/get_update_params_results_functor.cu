@@ -180,6 +180,117 @@ void SparseEmbeddingFunctors::get_update_params_results(
   return;
 }
 
+namespace {
+
+template <typename TypeHashKey>
+__global__ void select_touched_pairs_kernel(size_t max_entries, const size_t *num_entries,
+                                            const TypeHashKey *keys, const size_t *value_indices,
+                                            const uint32_t *touched_rows, int embedding_vec_size,
+                                            const float *hash_table_value, TypeHashKey *out_keys,
+                                            float *out_values, size_t *out_count) {
+  const size_t i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i < max_entries && i < *num_entries) {
+    const size_t row = value_indices[i];
+    if (touched_rows[row / 32] & (1u << (row % 32))) {
+      const size_t slot = atomicAdd(reinterpret_cast<unsigned long long *>(out_count), 1ull);
+      out_keys[slot] = keys[i];
+      const float *src = &hash_table_value[row * embedding_vec_size];
+      float *dst = &out_values[slot * embedding_vec_size];
+      for (int j = 0; j < embedding_vec_size; j++) {
+        dst[j] = src[j];
+      }
+    }
+  }
+}
+
+}  // namespace
+
+template <typename TypeHashKey>
+void SparseEmbeddingFunctors::get_touched_update_params_results(
+    size_t embedding_vec_size, const Tensors2<float> &hash_table_value_tensors,
+    const std::vector<std::shared_ptr<HashTable<TypeHashKey, size_t>>> &hash_tables,
+    Tensors2<uint32_t> &touched_rows_tensors, std::vector<TypeHashKey> &h_keys,
+    std::vector<float> &h_vectors, const ResourceManager &resource_manager) {
+  CudaDeviceContext context;
+
+  const size_t local_gpu_count = resource_manager.get_local_gpu_count();
+  for (size_t id = 0; id < local_gpu_count; id++) {
+    const auto &local_gpu = resource_manager.get_local_gpu(id);
+    context.set_device(local_gpu->get_device_id());
+    cudaStream_t stream = local_gpu->get_stream();
+
+    const size_t count = hash_tables[id]->get_size(stream);
+    if (count == 0) {
+      continue;
+    }
+
+    TypeHashKey *d_keys;
+    size_t *d_value_index;
+    size_t *d_dump_counter;
+    TypeHashKey *d_out_keys;
+    float *d_out_values;
+    size_t *d_out_count;
+    HCTR_LIB_THROW(cudaMalloc(&d_keys, count * sizeof(TypeHashKey)));
+    HCTR_LIB_THROW(cudaMalloc(&d_value_index, count * sizeof(size_t)));
+    HCTR_LIB_THROW(cudaMalloc(&d_dump_counter, sizeof(size_t)));
+    HCTR_LIB_THROW(cudaMalloc(&d_out_keys, count * sizeof(TypeHashKey)));
+    HCTR_LIB_THROW(cudaMalloc(&d_out_values, count * embedding_vec_size * sizeof(float)));
+    HCTR_LIB_THROW(cudaMalloc(&d_out_count, sizeof(size_t)));
+    HCTR_LIB_THROW(cudaMemsetAsync(d_out_count, 0, sizeof(size_t), stream));
+
+    // Dump all resident <key, row> pairs, then keep only those whose row is marked.
+    hash_tables[id]->dump(d_keys, d_value_index, d_dump_counter, stream);
+
+    constexpr size_t block_size = 256;
+    const size_t grid_size = (count + block_size - 1) / block_size;
+    select_touched_pairs_kernel<<<grid_size, block_size, 0, stream>>>(
+        count, d_dump_counter, d_keys, d_value_index, touched_rows_tensors[id].get_ptr(),
+        static_cast<int>(embedding_vec_size), hash_table_value_tensors[id].get_ptr(), d_out_keys,
+        d_out_values, d_out_count);
+    HCTR_LIB_THROW(cudaPeekAtLastError());
+
+    // The bitmap only accumulates updates until the next collection.
+    HCTR_LIB_THROW(cudaMemsetAsync(touched_rows_tensors[id].get_ptr(), 0,
+                                   touched_rows_tensors[id].get_size_in_bytes(), stream));
+
+    size_t num_touched = 0;
+    HCTR_LIB_THROW(cudaMemcpyAsync(&num_touched, d_out_count, sizeof(size_t),
+                                   cudaMemcpyDeviceToHost, stream));
+    HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+
+    if (num_touched > 0) {
+      const size_t key_offset = h_keys.size();
+      const size_t value_offset = h_vectors.size();
+      h_keys.resize(key_offset + num_touched);
+      h_vectors.resize(value_offset + num_touched * embedding_vec_size);
+      HCTR_LIB_THROW(cudaMemcpy(&h_keys[key_offset], d_out_keys, num_touched * sizeof(TypeHashKey),
+                                cudaMemcpyDeviceToHost));
+      HCTR_LIB_THROW(cudaMemcpy(&h_vectors[value_offset], d_out_values,
+                                num_touched * embedding_vec_size * sizeof(float),
+                                cudaMemcpyDeviceToHost));
+    }
+
+    HCTR_LIB_THROW(cudaFree(d_keys));
+    HCTR_LIB_THROW(cudaFree(d_value_index));
+    HCTR_LIB_THROW(cudaFree(d_dump_counter));
+    HCTR_LIB_THROW(cudaFree(d_out_keys));
+    HCTR_LIB_THROW(cudaFree(d_out_values));
+    HCTR_LIB_THROW(cudaFree(d_out_count));
+  }
+}
+
+template void SparseEmbeddingFunctors::get_touched_update_params_results<unsigned int>(
+    size_t embedding_vec_size, const Tensors2<float> &hash_table_value_tensors,
+    const std::vector<std::shared_ptr<HashTable<unsigned int, size_t>>> &hash_tables,
+    Tensors2<uint32_t> &touched_rows_tensors, std::vector<unsigned int> &h_keys,
+    std::vector<float> &h_vectors, const ResourceManager &resource_manager);
+
+template void SparseEmbeddingFunctors::get_touched_update_params_results<long long>(
+    size_t embedding_vec_size, const Tensors2<float> &hash_table_value_tensors,
+    const std::vector<std::shared_ptr<HashTable<long long, size_t>>> &hash_tables,
+    Tensors2<uint32_t> &touched_rows_tensors, std::vector<long long> &h_keys,
+    std::vector<float> &h_vectors, const ResourceManager &resource_manager);
+
 template void SparseEmbeddingFunctors::get_update_params_results<unsigned int>(
     size_t embedding_vec_size, size_t vocabulary_size,
     const Tensors2<float> &hash_table_value_tensors,
@@ -69,6 +69,32 @@ __global__ void frequent_local_reduce(const emtype* __restrict__ gradients_in,
   }
 }
 
+/* Fused single-node backward: each network applies the gradients of its own samples straight
+ * into the owner instance's embedding vectors over NVLink, so the frequent categories need
+ * neither a local staging buffer nor a separate update pass */
+template <typename dtype, typename emtype>
+__global__ void frequent_direct_reduce(const emtype* __restrict__ gradients,
+                                       float* const* __restrict__ embedding_vectors_pointers,
+                                       size_t local_samples_offset,
+                                       const dtype* __restrict__ category_location,
+                                       uint32_t num_frequent_per_model, uint32_t embedding_vec_size,
+                                       FrequentEmbeddingCompressionView<dtype>* indices,
+                                       const float* __restrict__ lr_ptr, const float scale) {
+  const float lr = __ldg(lr_ptr) / scale;
+  const uint32_t num_frequent_sample_indices = *indices->d_num_frequent_sample_indices;
+
+  for (uint32_t i = blockIdx.x; i < num_frequent_sample_indices; i += gridDim.x) {
+    uint32_t local_sample_index = indices->frequent_sample_indices[i];
+    dtype category = indices->samples[local_samples_offset + local_sample_index];
+    dtype frequent_index = category_location[2 * category + 1];
+    float* embedding_vectors = embedding_vectors_pointers[frequent_index / num_frequent_per_model];
+
+    atomicAdd(embedding_vectors + frequent_index * embedding_vec_size + threadIdx.x,
+              -lr * TypeConvertFunc<float, emtype>::convert(
+                        gradients[local_sample_index * embedding_vec_size + threadIdx.x]));
+  }
+}
+
 template <typename emtype>
 __forceinline__ __device__ void update_model_direct_common(
     const emtype* const* __restrict__ gradients_pointers, float* __restrict__ embedding_vectors,
@@ -158,6 +184,7 @@ FrequentEmbeddingSingleNode<dtype, emtype>::FrequentEmbeddingSingleNode(
 
   buf->reserve({model.num_instances, 1}, &embedding_vectors_cache_pointers_);
   buf->reserve({model.num_instances, 1}, &partial_gradients_pointers_);
+  buf->reserve({model.num_instances, 1}, &embedding_vectors_pointers_);
   if (sizeof(emtype) != sizeof(float)) {
     buf->reserve({max_num_frequent_categories, embedding_vec_size},
                  &frequent_embedding_vectors_cache_);
@@ -376,6 +403,29 @@ void FrequentEmbeddingSingleNode<dtype, emtype>::local_reduce(const emtype* grad
   frequent_data_.local_reduce(gradients, this, stream);
 }
 
+/* Fused alternative to local_reduce + update_model_direct: the gradients of this network's
+ * samples are applied straight into the owner instances' embedding vectors across NVLink.
+ * Only valid when the vectors are distinct from the forward cache, i.e. emtype != float */
+template <typename dtype, typename emtype>
+void FrequentEmbeddingSingleNode<dtype, emtype>::local_reduce_direct(const emtype* gradients,
+                                                                     float* dev_lr, float scale,
+                                                                     cudaStream_t stream) {
+  const auto num_instances = frequent_data_.model_.num_instances;
+  const auto network_id = frequent_data_.model_.global_instance_id;
+  const uint32_t num_frequent_per_model = frequent_data_.model_.num_frequent / num_instances;
+  size_t local_samples_size =
+      ceildiv<size_t>(this->data_->batch_size, num_instances) * this->data_->table_sizes.size();
+
+  int n_blocks = 16 * frequent_data_.gpu_resource_.get_sm_count();
+
+  frequent_embedding_kernels::
+      frequent_direct_reduce<<<n_blocks, frequent_data_.embedding_vec_size_, 0, stream>>>(
+          gradients, embedding_vectors_pointers_.get_ptr(), network_id * local_samples_size,
+          frequent_data_.model_.category_location.get_ptr(), num_frequent_per_model,
+          frequent_data_.embedding_vec_size_, this->indices_view_, dev_lr, scale);
+  HCTR_LIB_THROW(cudaPeekAtLastError());
+}
+
 template <typename dtype, typename emtype>
 void FrequentEmbeddingMultiNode<dtype, emtype>::local_reduce(const emtype* gradients,
                                                              cudaStream_t stream) {
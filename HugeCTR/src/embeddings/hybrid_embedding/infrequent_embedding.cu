@@ -17,6 +17,7 @@
 #include <cuda_runtime.h>
 
 #include <algorithm>
+#include <cstdlib>
 #include <cub/cub.cuh>
 #include <iostream>
 #include <utility>
@@ -268,17 +269,33 @@ void InfrequentEmbedding_IB_NVLINK<dtype, emtype>::init_comms(size_t embedding_v
                                                               const GPUResource* gpu_resource,
                                                               GeneralBuffer2<CudaAllocator>* i_buf,
                                                               size_t max_buf_size) {
+  comm_compress_fp16_ = std::is_same<emtype, float>::value &&
+                        std::getenv("HCTR_INFREQUENT_COMM_FP16") != nullptr;
+  if (comm_compress_fp16_ && embedding_vec_size % 2 != 0) {
+    HCTR_LOG_S(WARNING, ROOT) << "HCTR_INFREQUENT_COMM_FP16 requires an even embedding vector "
+                              << "size, falling back to FP32 messages" << std::endl;
+    comm_compress_fp16_ = false;
+  }
+  if (comm_compress_fp16_) {
+    HCTR_LOG_S(INFO, ROOT) << "Infrequent embedding: packing all-to-all messages as FP16"
+                           << std::endl;
+  }
+
+  // With FP16 compression the buffers stay emtype(=float)-typed but each "element" seen by NCCL
+  // carries two packed __half values, so the data field width on the wire is halved.
+  size_t comm_vec_size = comm_compress_fp16_ ? embedding_vec_size / 2 : embedding_vec_size;
+
   infrequent_forward_comm_buffers_ = std::make_unique<AllToAllStorage<emtype>>(i_buf, max_buf_size);
   infrequent_backward_comm_buffers_ =
       std::make_unique<AllToAllStorage<emtype>>(i_buf, max_buf_size);
   infrequent_forward_comms_ = std::make_unique<AllToAll_Multi_NCCL<emtype>>(
       infrequent_forward_comm_buffers_->send_buffer, infrequent_forward_comm_buffers_->recv_buffer,
       get_model_indices_offsets_ptr(), get_network_indices_offsets_ptr(), gpu_resource,
-      embedding_vec_size);
+      comm_vec_size);
   infrequent_backward_comms_ = std::make_unique<AllToAll_Multi_NCCL<emtype>>(
       infrequent_backward_comm_buffers_->send_buffer,
       infrequent_backward_comm_buffers_->recv_buffer, get_network_indices_offsets_ptr(),
-      get_model_indices_offsets_ptr(), gpu_resource, embedding_vec_size);
+      get_model_indices_offsets_ptr(), gpu_resource, comm_vec_size);
 }
 
 template <typename dtype, typename emtype>
@@ -300,6 +317,28 @@ void InfrequentEmbedding_IB_NVLINK<dtype, emtype>::forward_model(emtype* message
   auto embedding_vec_size = embedding_vec_size_;
   auto num_instances = model_.num_instances;
 
+  if (comm_compress_fp16_) {
+    // FP16 wire format: the conversion is fused into the pack kernel, the message occupies the
+    // first half of the (float-typed) comm buffer.
+    auto compressed_buffer = reinterpret_cast<__half*>(message_buffer);
+    auto copy_desc = CopyDescriptors::make_OneToOne<float, __half, 1>(
+        embedding_vec_size,
+        [=] __device__() { return indices->model_indices_offsets[num_instances]; },
+        [=] __device__(size_t i) -> CopyDescriptors::CopyDetails<float, __half, 1> {
+          uint32_t index = indices->model_indices[i];
+          dtype category = indices->samples[index];
+          dtype location = category_location[2 * category + 1];
+
+          return {infrequent_embedding_vectors + location * embedding_vec_size,
+                  {compressed_buffer + i * embedding_vec_size},
+                  {true}};
+        });
+
+    shuffle(copy_desc, stream, data_->samples.get_num_elements() / model_.num_instances / 8);
+    HCTR_LIB_THROW(cudaPeekAtLastError());
+    return;
+  }
+
   auto copy_desc = CopyDescriptors::make_OneToOne<float, emtype, 1>(
       embedding_vec_size,
       [=] __device__() { return indices->model_indices_offsets[num_instances]; },
@@ -325,6 +364,23 @@ void InfrequentEmbedding_IB_NVLINK<dtype, emtype>::forward_network(const emtype*
   auto embedding_vec_size = embedding_vec_size_;
   auto num_instances = model_.num_instances;
 
+  if (comm_compress_fp16_) {
+    auto compressed_buffer = reinterpret_cast<const __half*>(message_buffer);
+    auto copy_desc = CopyDescriptors::make_OneToOne<__half, emtype, 1>(
+        embedding_vec_size,
+        [=] __device__() { return indices->network_indices_offsets[num_instances]; },
+        [=] __device__(size_t i) -> CopyDescriptors::CopyDetails<__half, emtype, 1> {
+          uint32_t index = indices->network_indices[i];
+          return {compressed_buffer + i * embedding_vec_size,
+                  {output_ptr + index * embedding_vec_size},
+                  {true}};
+        });
+
+    shuffle(copy_desc, stream, data_->samples.get_num_elements() / model_.num_instances / 8);
+    HCTR_LIB_THROW(cudaPeekAtLastError());
+    return;
+  }
+
   auto copy_desc = CopyDescriptors::make_OneToOne<emtype, emtype, 1>(
       embedding_vec_size,
       [=] __device__() { return indices->network_indices_offsets[num_instances]; },
@@ -347,6 +403,24 @@ void InfrequentEmbedding_IB_NVLINK<dtype, emtype>::update_network(const emtype*
   auto embedding_vec_size = embedding_vec_size_;
   auto num_instances = model_.num_instances;
 
+  if (comm_compress_fp16_) {
+    auto compressed_buffer = reinterpret_cast<__half*>(message_buffer);
+    auto copy_desc = CopyDescriptors::make_OneToOne<emtype, __half, 1>(
+        embedding_vec_size,
+        [=] __device__() { return indices->network_indices_offsets[num_instances]; },
+        [=] __device__(size_t i) -> CopyDescriptors::CopyDetails<emtype, __half, 1> {
+          uint32_t index = indices->network_indices[i];
+
+          return {gradients + index * embedding_vec_size,
+                  {compressed_buffer + i * embedding_vec_size},
+                  {true}};
+        });
+
+    shuffle(copy_desc, stream, data_->samples.get_num_elements() / model_.num_instances / 8);
+    HCTR_LIB_THROW(cudaPeekAtLastError());
+    return;
+  }
+
   auto copy_desc = CopyDescriptors::make_OneToOne<emtype, emtype, 1>(
       embedding_vec_size,
       [=] __device__() { return indices->network_indices_offsets[num_instances]; },
@@ -372,17 +446,25 @@ void InfrequentEmbedding_IB_NVLINK<dtype, emtype>::update_model(const emtype* me
 
   uint32_t n_blocks = gpu_resource_.get_sm_count();
 
-  sgd_atomic_update(
-      message_buffer, infrequent_embedding_vectors_.get_ptr(),
-      [indices, num_instances] __device__() {
-        return indices->model_indices_offsets[num_instances];
-      },
-      [indices, category_location] __device__(uint32_t i) {
-        uint32_t index = indices->model_indices[i];
-        dtype category = indices->samples[index];
-        return category_location[2 * category + 1];
-      },
-      n_blocks, embedding_vec_size_, dev_lr, scale, stream);
+  auto get_num_indices = [indices, num_instances] __device__() {
+    return indices->model_indices_offsets[num_instances];
+  };
+  auto get_index = [indices, category_location] __device__(uint32_t i) {
+    uint32_t index = indices->model_indices[i];
+    dtype category = indices->samples[index];
+    return category_location[2 * category + 1];
+  };
+
+  if (comm_compress_fp16_) {
+    // The update kernel converts each __half gradient back to float before the atomicAdd, so the
+    // accumulation into the FP32 embedding vectors is unaffected by the wire compression.
+    sgd_atomic_update(reinterpret_cast<const __half*>(message_buffer),
+                      infrequent_embedding_vectors_.get_ptr(), get_num_indices, get_index, n_blocks,
+                      embedding_vec_size_, dev_lr, scale, stream);
+  } else {
+    sgd_atomic_update(message_buffer, infrequent_embedding_vectors_.get_ptr(), get_num_indices,
+                      get_index, n_blocks, embedding_vec_size_, dev_lr, scale, stream);
+  }
 }
 
 template <typename dtype, typename emtype>
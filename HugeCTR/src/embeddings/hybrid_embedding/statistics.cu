@@ -17,6 +17,7 @@
 #include <cuda_runtime.h>
 
 #include <algorithm>
+#include <cstdlib>
 #include <cub/cub.cuh>
 #include <iostream>
 #include <vector>
@@ -160,6 +161,79 @@ static __global__ void calculate_frequent_model_table_offsets(
   offsets[div_id * (n_tables + 1) + table_id] = start;
 }
 
+/** Count how many of the `num_top` most frequent categories observed in the current
+ * statistics window belong to the frequent embedding set of the model.
+ * A category is frequent iff category_location[2 * category] == num_instances.
+ */
+template <typename dtype>
+static __global__ void count_frequent_overlap(const dtype *__restrict__ categories_sorted,
+                                              const dtype *__restrict__ category_location,
+                                              uint32_t *overlap_count, size_t num_top,
+                                              size_t num_instances) {
+  size_t tid = blockDim.x * blockIdx.x + threadIdx.x;
+  if (tid < num_top) {
+    dtype category = categories_sorted[tid];
+    if (category_location[2 * category] == (dtype)num_instances) {
+      atomicAdd(overlap_count, 1);
+    }
+  }
+}
+
+constexpr int SKETCH_DEPTH = 4;
+
+/** Per-row hash of the count-min sketch (64-bit finalizer, row acts as the seed). */
+static __device__ __forceinline__ size_t sketch_hash(size_t category, uint32_t row,
+                                                     size_t width_mask) {
+  uint64_t x = (uint64_t)category + 0x9e3779b97f4a7c15ull * (row + 1);
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdull;
+  x ^= x >> 33;
+  x *= 0xc4ceb9fe1a85ec53ull;
+  x ^= x >> 33;
+  return (size_t)(x & width_mask);
+}
+
+template <typename dtype>
+static __global__ void sketch_count(const dtype *__restrict__ samples, size_t num_samples,
+                                    uint32_t *sketch, size_t width, size_t width_mask) {
+  size_t tid = blockDim.x * blockIdx.x + threadIdx.x;
+  if (tid < num_samples) {
+    size_t category = (size_t)samples[tid];
+    for (uint32_t row = 0; row < SKETCH_DEPTH; ++row) {
+      atomicAdd(sketch + row * width + sketch_hash(category, row, width_mask), 1);
+    }
+  }
+}
+
+/** Publish each category whose estimated count reaches min_count exactly once: the occurrence
+ * that flips the claim bit appends the (category, estimate) pair to the candidate list.
+ */
+template <typename dtype>
+static __global__ void sketch_select_candidates(
+    const dtype *__restrict__ samples, size_t num_samples, const uint32_t *__restrict__ sketch,
+    size_t width, size_t width_mask, uint32_t min_count, unsigned long long *claim_bitmap,
+    dtype *candidate_categories, uint32_t *candidate_counts, uint32_t *num_candidates) {
+  size_t tid = blockDim.x * blockIdx.x + threadIdx.x;
+  if (tid >= num_samples) {
+    return;
+  }
+  size_t category = (size_t)samples[tid];
+  uint32_t estimate = sketch[sketch_hash(category, 0, width_mask)];
+  for (uint32_t row = 1; row < SKETCH_DEPTH; ++row) {
+    estimate = min(estimate, sketch[row * width + sketch_hash(category, row, width_mask)]);
+  }
+  if (estimate < min_count) {
+    return;
+  }
+  unsigned long long bit = 1ull << (category & 63);
+  if (atomicOr(claim_bitmap + (category >> 6), bit) & bit) {
+    return;  // another occurrence already published this category
+  }
+  uint32_t pos = atomicAdd(num_candidates, 1);
+  candidate_categories[pos] = samples[tid];
+  candidate_counts[pos] = estimate;
+}
+
 }  // namespace statistics_kernels
 
 ///
@@ -178,6 +252,34 @@ void Statistics<dtype>::sort_categories_by_count(const Tensor2<dtype> &samples,
   counts_sorted.reset_shape({num_unique_categories, 1});
 }
 
+///
+/// Compare the top categories of the current statistics window with the frequent categories
+/// selected by the model: returns how many of the `num_frequent` hottest categories in the
+/// window are part of the frequent embedding. The caller needs to refresh categories_sorted
+/// with sort_categories_by_count() first.
+///
+template <typename dtype>
+uint32_t Statistics<dtype>::calculate_frequent_overlap(const Tensor2<dtype> &category_location,
+                                                       dtype num_frequent, uint32_t num_instances,
+                                                       cudaStream_t stream) {
+  size_t num_top = std::min((size_t)num_frequent, (size_t)num_unique_categories);
+  uint32_t *d_overlap_count = frequent_overlap_count.get_ptr();
+  HCTR_LIB_THROW(cudaMemsetAsync(d_overlap_count, 0, sizeof(uint32_t), stream));
+  if (num_top > 0) {
+    constexpr size_t TPB_overlap = 256;
+    const size_t n_blocks_overlap = ceildiv<size_t>(num_top, TPB_overlap);
+    statistics_kernels::count_frequent_overlap<<<n_blocks_overlap, TPB_overlap, 0, stream>>>(
+        categories_sorted.get_ptr(), category_location.get_ptr(), d_overlap_count, num_top,
+        (size_t)num_instances);
+    HCTR_LIB_THROW(cudaPeekAtLastError());
+  }
+  uint32_t h_overlap_count = 0;
+  HCTR_LIB_THROW(cudaMemcpyAsync((void *)&h_overlap_count, (void *)d_overlap_count,
+                                 sizeof(uint32_t), cudaMemcpyDeviceToHost, stream));
+  HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+  return h_overlap_count;
+}
+
 template <typename dtype>
 struct InfrequentSelectOp {
   const dtype *category_location;
@@ -192,19 +294,46 @@ struct InfrequentSelectOp {
 
 template <typename dtype>
 void Statistics<dtype>::reserve_temp_storage(std::shared_ptr<GeneralBuffer2<CudaAllocator>> buf) {
+  // The sketch estimator only makes sense when num_categories describes the real category space
+  // (its claim bitmap is indexed by category); callers passing a placeholder keep the exact sort.
+  use_sketch_ = (std::getenv("HCTR_HYBRID_SKETCH_STATISTICS") != nullptr) && num_categories > 1;
+  if (use_sketch_) {
+    if (const char *min_count_str = std::getenv("HCTR_HYBRID_SKETCH_MIN_COUNT")) {
+      sketch_min_count_ = (uint32_t)std::max(1L, atol(min_count_str));
+    }
+    sketch_width_ = 1;
+    while (sketch_width_ < 2 * num_samples) {
+      sketch_width_ <<= 1;
+    }
+    buf->reserve({statistics_kernels::SKETCH_DEPTH * sketch_width_, 1}, &sketch_counters_);
+    buf->reserve({((size_t)num_categories + 1 + 63) / 64, 1}, &sketch_claim_bitmap_);
+    HCTR_LOG_S(INFO, ROOT) << "Hybrid embedding statistics: count-min sketch estimation enabled "
+                           << "(depth " << statistics_kernels::SKETCH_DEPTH << ", width "
+                           << sketch_width_ << ", min count " << sketch_min_count_ << ")"
+                           << std::endl;
+  }
+
   size_t size_sort_keys_temp = 0;
   sort_categories_by_count_temp_storages_.resize(7);
-  HCTR_LIB_THROW(cub::DeviceRadixSort::SortKeys((void *)nullptr, size_sort_keys_temp,
-                                                (dtype *)nullptr, (dtype *)nullptr,
-                                                (int)num_samples, 0, sizeof(dtype) * 8, 0));
-  buf->reserve({size_sort_keys_temp, 1}, &sort_categories_by_count_temp_storages_[0]);
-  buf->reserve({num_samples * sizeof(dtype), 1}, &sort_categories_by_count_temp_storages_[1]);
-  size_t size_unique_categories_temp = 0;
-  HCTR_LIB_THROW(cub::DeviceRunLengthEncode::Encode(
-      (void *)nullptr, size_unique_categories_temp, (dtype *)nullptr, (dtype *)nullptr,
-      (uint32_t *)nullptr, (uint32_t *)nullptr, (int)num_samples, 0));
-
-  buf->reserve({size_unique_categories_temp, 1}, &sort_categories_by_count_temp_storages_[2]);
+  if (use_sketch_) {
+    // The sketch replaces the keys sort and the run-length encode of the exact path; only the
+    // candidate arrays and the final descending sort are needed.
+    buf->reserve({1, 1}, &sort_categories_by_count_temp_storages_[0]);
+    buf->reserve({1, 1}, &sort_categories_by_count_temp_storages_[1]);
+    buf->reserve({1, 1}, &sort_categories_by_count_temp_storages_[2]);
+  } else {
+    HCTR_LIB_THROW(cub::DeviceRadixSort::SortKeys((void *)nullptr, size_sort_keys_temp,
+                                                  (dtype *)nullptr, (dtype *)nullptr,
+                                                  (int)num_samples, 0, sizeof(dtype) * 8, 0));
+    buf->reserve({size_sort_keys_temp, 1}, &sort_categories_by_count_temp_storages_[0]);
+    buf->reserve({num_samples * sizeof(dtype), 1}, &sort_categories_by_count_temp_storages_[1]);
+    size_t size_unique_categories_temp = 0;
+    HCTR_LIB_THROW(cub::DeviceRunLengthEncode::Encode(
+        (void *)nullptr, size_unique_categories_temp, (dtype *)nullptr, (dtype *)nullptr,
+        (uint32_t *)nullptr, (uint32_t *)nullptr, (int)num_samples, 0));
+
+    buf->reserve({size_unique_categories_temp, 1}, &sort_categories_by_count_temp_storages_[2]);
+  }
   buf->reserve({num_samples * sizeof(dtype), 1}, &sort_categories_by_count_temp_storages_[3]);
   buf->reserve({num_samples * sizeof(uint32_t), 1}, &sort_categories_by_count_temp_storages_[4]);
   buf->reserve({sizeof(uint32_t), 1}, &sort_categories_by_count_temp_storages_[5]);
@@ -251,6 +380,11 @@ void Statistics<dtype>::sort_categories_by_count(const dtype *samples, size_t nu
     HCTR_LOG_S(ERROR, WORLD) << "Num samples: " << std::hex << num_samples << std::dec << std::endl;
     HCTR_OWN_THROW(Error_t::WrongInput, "num_samples is too large, overflow for int type");
   }
+  if (use_sketch_) {
+    estimate_categories_by_count(samples, num_samples, categories_sorted, counts_sorted,
+                                 num_unique_categories, stream);
+    return;
+  }
   void *p_sort_keys_temp =
       reinterpret_cast<void *>(sort_categories_by_count_temp_storages_[0].get_ptr());  // void*
   dtype *p_sort_keys_out =
@@ -286,6 +420,57 @@ void Statistics<dtype>::sort_categories_by_count(const dtype *samples, size_t nu
       sizeof(uint32_t) * 8, stream));
 }
 
+///
+/// Sketch-based replacement of the exact count: a count-min sketch absorbs every occurrence,
+/// then the categories estimated at sketch_min_count_ or more are compacted (one entry per
+/// category via the claim bitmap) and sorted in decreasing order of estimated count. Yields the
+/// same frequent-set selection as the exact path whenever the frequent count threshold is at
+/// least sketch_min_count_, while never sorting the full calibration sample.
+///
+template <typename dtype>
+void Statistics<dtype>::estimate_categories_by_count(const dtype *samples, size_t num_samples,
+                                                     dtype *categories_sorted,
+                                                     uint32_t *counts_sorted,
+                                                     uint32_t &num_unique_categories,
+                                                     cudaStream_t stream) {
+  dtype *p_candidate_categories =
+      reinterpret_cast<dtype *>(sort_categories_by_count_temp_storages_[3].get_ptr());
+  uint32_t *p_candidate_counts =
+      reinterpret_cast<uint32_t *>(sort_categories_by_count_temp_storages_[4].get_ptr());
+  uint32_t *p_num_candidates =
+      reinterpret_cast<uint32_t *>(sort_categories_by_count_temp_storages_[5].get_ptr());
+  void *p_sort_pairs_temp =
+      reinterpret_cast<void *>(sort_categories_by_count_temp_storages_[6].get_ptr());
+
+  uint32_t *d_sketch = sketch_counters_.get_ptr();
+  unsigned long long *d_claim_bitmap = sketch_claim_bitmap_.get_ptr();
+  HCTR_LIB_THROW(cudaMemsetAsync(d_sketch, 0, sketch_counters_.get_size_in_bytes(), stream));
+  HCTR_LIB_THROW(
+      cudaMemsetAsync(d_claim_bitmap, 0, sketch_claim_bitmap_.get_size_in_bytes(), stream));
+  HCTR_LIB_THROW(cudaMemsetAsync(p_num_candidates, 0, sizeof(uint32_t), stream));
+
+  constexpr size_t TPB_sketch = 256;
+  const size_t n_blocks_sketch = ceildiv<size_t>(num_samples, TPB_sketch);
+  const size_t width_mask = sketch_width_ - 1;
+  statistics_kernels::sketch_count<<<n_blocks_sketch, TPB_sketch, 0, stream>>>(
+      samples, num_samples, d_sketch, sketch_width_, width_mask);
+  HCTR_LIB_THROW(cudaPeekAtLastError());
+
+  statistics_kernels::sketch_select_candidates<<<n_blocks_sketch, TPB_sketch, 0, stream>>>(
+      samples, num_samples, d_sketch, sketch_width_, width_mask, sketch_min_count_, d_claim_bitmap,
+      p_candidate_categories, p_candidate_counts, p_num_candidates);
+  HCTR_LIB_THROW(cudaPeekAtLastError());
+
+  HCTR_LIB_THROW(cudaMemcpyAsync((void *)&num_unique_categories, (void *)p_num_candidates,
+                                 sizeof(uint32_t), cudaMemcpyDeviceToHost, stream));
+  HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+
+  size_t temp_size = sort_categories_by_count_temp_storages_[6].get_size_in_bytes();
+  HCTR_LIB_THROW(cub::DeviceRadixSort::SortPairsDescending(
+      p_sort_pairs_temp, temp_size, p_candidate_counts, counts_sorted, p_candidate_categories,
+      categories_sorted, (int)num_unique_categories, 0, sizeof(uint32_t) * 8, stream));
+}
+
 template <typename dtype>
 void Statistics<dtype>::calculate_frequent_and_infrequent_categories(
     dtype *frequent_categories, dtype *infrequent_categories, dtype *category_location,
@@ -17,6 +17,7 @@
 #include <cuda_runtime.h>
 
 #include <collectives/all_reduce_comm.hpp>
+#include <cstdlib>
 #include <vector>
 
 #include "HugeCTR/include/common.hpp"
@@ -75,6 +76,55 @@ HybridSparseEmbedding<dtype, emtype>::HybridSparseEmbedding(
     HCTR_LOG_S(INFO, ROOT) << "Using Hybrid Embedding with train batch " << get_batch_size(true)
                            << " and eval batch " << get_batch_size(false) << std::endl;
 
+    // Opt-in monitoring of the frequent-category set: keep streaming frequency statistics of
+    // recent train batches and report every N iterations how much the observed distribution
+    // drifted away from the frequent categories selected at initialization.
+    if (const char* drift_check_env = std::getenv("HCTR_HYBRID_DRIFT_CHECK_ITERS")) {
+      size_t drift_check_iters = std::atoll(drift_check_env);
+      if (drift_check_iters > 0) {
+        if (graph_mode_) {
+          HCTR_LOG(WARNING, ROOT, "HCTR_HYBRID_DRIFT_CHECK_ITERS is ignored in graph mode\n");
+        } else {
+          drift_check_iters_ = drift_check_iters;
+          HCTR_LOG_S(INFO, ROOT) << "Hybrid embedding will check frequent-category drift every "
+                                 << drift_check_iters_ << " iterations" << std::endl;
+        }
+      }
+    }
+
+    // Opt-in precompute of the batch indices on a side stream: as soon as the async reader has
+    // split a batch, its index calculation is launched ahead of the pipeline so that the train
+    // stream only waits for the result instead of computing it on the critical path.
+    if (std::getenv("HCTR_PRECOMPUTE_INDICES")) {
+      if (graph_mode_) {
+        HCTR_LOG(WARNING, ROOT, "HCTR_PRECOMPUTE_INDICES is ignored in graph mode\n");
+      } else {
+        precompute_indices_enabled_ = true;
+        HCTR_LOG(INFO, ROOT,
+                 "Hybrid embedding will precompute batch indices on a side stream\n");
+      }
+    }
+
+    // Opt-in fused backward for the frequent categories: each gpu applies the gradients of its
+    // own samples straight into the owner instances' embedding vectors over NVLink, so neither
+    // the per-gpu staging buffers nor the separate update pass are needed anymore.
+    if (std::getenv("HCTR_FREQUENT_DIRECT_REDUCE")) {
+      if (embedding_params_.communication_type != CommunicationType::NVLink_SingleNode) {
+        HCTR_LOG(WARNING, ROOT,
+                 "HCTR_FREQUENT_DIRECT_REDUCE requires single-node NVLink communication, "
+                 "ignoring\n");
+      } else if (sizeof(emtype) == sizeof(float)) {
+        HCTR_LOG(WARNING, ROOT,
+                 "HCTR_FREQUENT_DIRECT_REDUCE requires mixed precision (in fp32 the embedding "
+                 "vectors double as the forward cache), ignoring\n");
+      } else {
+        frequent_direct_reduce_ = true;
+        HCTR_LOG(INFO, ROOT,
+                 "Frequent embedding gradients will be reduced directly into the owner "
+                 "instances' vectors over NVLink\n");
+      }
+    }
+
     // 1. initialize optimizer
     for (size_t id = 0; id < local_gpu_count; id++) {
       OptParams opt_params;
@@ -347,6 +397,7 @@ HybridSparseEmbedding<dtype, emtype>::HybridSparseEmbedding(
       std::vector<emtype *> interaction_layer_input_pointers_eval(local_gpu_count);
       std::vector<const emtype *> gradients_pointers(local_gpu_count);
       std::vector<const emtype *> frequent_partial_gradients_pointers(local_gpu_count);
+      std::vector<float *> frequent_vectors_pointers(local_gpu_count);
 
       for (uint32_t i = 0; i < local_gpu_count; i++) {
         frequent_vectors_cache_pointers[i] =
@@ -356,6 +407,8 @@ HybridSparseEmbedding<dtype, emtype>::HybridSparseEmbedding(
         interaction_layer_input_pointers_eval[i] = evaluate_output_tensors_[i].get_ptr();
         frequent_partial_gradients_pointers[i] =
             frequent_embeddings_single_node_[i].frequent_data_.get_gradients().get_ptr();
+        frequent_vectors_pointers[i] = frequent_embeddings_single_node_[i]
+                                           .frequent_data_.frequent_embedding_vectors_.get_ptr();
       }
 
       for (uint32_t i = 0; i < local_gpu_count; i++) {
@@ -374,6 +427,10 @@ HybridSparseEmbedding<dtype, emtype>::HybridSparseEmbedding(
             frequent_embeddings_single_node_[i].partial_gradients_pointers_.get_ptr(),
             frequent_partial_gradients_pointers.data(), local_gpu_count * sizeof(emtype *),
             cudaMemcpyHostToDevice, get_local_gpu(i).get_stream()));
+        HCTR_LIB_THROW(cudaMemcpyAsync(
+            frequent_embeddings_single_node_[i].embedding_vectors_pointers_.get_ptr(),
+            frequent_vectors_pointers.data(), local_gpu_count * sizeof(float *),
+            cudaMemcpyHostToDevice, get_local_gpu(i).get_stream()));
       }
     }
 
@@ -591,10 +648,46 @@ void HybridSparseEmbedding<dtype, emtype>::assign_input_tensors(bool is_train, s
     train_inflight_id_ = inflight_id;
     current_train_batch_size_ = batch_size;
     current_train_batch_cached_ = cached;
+    train_indices_precomputed_ = false;
   } else {
     eval_inflight_id_ = inflight_id;
     current_eval_batch_size_ = batch_size;
     current_eval_batch_cached_ = cached;
+    eval_indices_precomputed_ = false;
+  }
+}
+
+template <typename dtype, typename emtype>
+void HybridSparseEmbedding<dtype, emtype>::precompute_indices(bool is_train) {
+  if (!precompute_indices_enabled_) {
+    return;
+  }
+  const bool cached = is_train ? current_train_batch_cached_ : current_eval_batch_cached_;
+  if (cached) {
+    return;
+  }
+  const size_t batch_size = is_train ? current_train_batch_size_ : current_eval_batch_size_;
+  auto &batch_indices = is_train ? train_batch_indices_.at(train_inflight_id_)
+                                 : eval_batch_indices_.at(eval_inflight_id_);
+
+  size_t local_gpu_count = resource_manager_->get_local_gpu_count();
+#pragma omp parallel for num_threads(local_gpu_count)
+  for (size_t i = 0; i < local_gpu_count; i++) {
+    auto &gpu = get_local_gpu(i);
+    CudaDeviceContext context(gpu.get_device_id());
+    cudaStream_t side_stream = gpu.get_stream("indices_precompute");
+
+    // The reader records this event on its split-3-way stream once the sparse tensors of the
+    // assigned batch are filled
+    HCTR_LIB_THROW(cudaStreamWaitEvent(side_stream, gpu.get_event("sparse_tensors_ready")));
+    batch_indices.compute(i, batch_size, side_stream);
+    HCTR_LIB_THROW(cudaEventRecord(gpu.get_event("indices_ready"), side_stream));
+  }
+
+  if (is_train) {
+    train_indices_precomputed_ = true;
+  } else {
+    eval_indices_precomputed_ = true;
   }
 }
 
@@ -610,11 +703,20 @@ void HybridSparseEmbedding<dtype, emtype>::index_calculation(bool is_train, int
 
   if (is_train) {
     if (!current_train_batch_cached_) {
-      batch_indices.compute(i, current_train_batch_size_, stream);
+      if (train_indices_precomputed_) {
+        // Already computed ahead on the side stream by precompute_indices()
+        HCTR_LIB_THROW(cudaStreamWaitEvent(stream, gpu.get_event("indices_ready")));
+      } else {
+        batch_indices.compute(i, current_train_batch_size_, stream);
+      }
     }
   } else {  // eval
     if (!current_eval_batch_cached_) {
-      batch_indices.compute(i, current_eval_batch_size_, stream);
+      if (eval_indices_precomputed_) {
+        HCTR_LIB_THROW(cudaStreamWaitEvent(stream, gpu.get_event("indices_ready")));
+      } else {
+        batch_indices.compute(i, current_eval_batch_size_, stream);
+      }
     }
   }
 
@@ -622,6 +724,60 @@ void HybridSparseEmbedding<dtype, emtype>::index_calculation(bool is_train, int
   // Data type and indices
   get_frequent_embedding(i).set_current_indices(&batch_indices.get_frequent(i));
   get_infrequent_embedding(i).set_current_indices(&batch_indices.get_infrequent(i));
+
+  if (is_train && drift_check_iters_ > 0 && i == 0) {
+    update_frequent_category_drift(i, stream);
+  }
+}
+
+///
+/// Maintain a sliding window of recent train batches in the statistics data and periodically
+/// measure how far the observed frequent categories have drifted away from the frequent
+/// embedding set selected at initialization. The window and the model are replicated across
+/// gpus, so measuring on the first local gpu is sufficient.
+///
+template <typename dtype, typename emtype>
+void HybridSparseEmbedding<dtype, emtype>::update_frequent_category_drift(int i,
+                                                                          cudaStream_t stream) {
+  auto &batch_indices = train_batch_indices_.at(train_inflight_id_);
+  auto &window = data_statistics_[i];
+
+  // Overwrite the oldest slice of the statistics window with the current batch. Both hold the
+  // unique-category encoding produced by data_to_unique_categories(). Incomplete batches are
+  // skipped so that the window only contains full slices.
+  const size_t slice_size = window.batch_size * window.table_sizes.size();
+  if (current_train_batch_size_ == window.batch_size) {
+    dtype *dst = window.samples.get_ptr() + drift_window_pos_ * slice_size;
+    HCTR_LIB_THROW(cudaMemcpyAsync(dst, batch_indices.get_data(i).samples.get_ptr(),
+                                   slice_size * sizeof(dtype), cudaMemcpyDeviceToDevice, stream));
+    drift_window_pos_ = (drift_window_pos_ + 1) % window.num_iterations;
+  }
+
+  if (++train_steps_ % drift_check_iters_ != 0) {
+    return;
+  }
+
+  statistics_[i].sort_categories_by_count(window.samples.get_ptr(),
+                                          window.num_iterations * slice_size,
+                                          statistics_[i].categories_sorted.get_ptr(),
+                                          statistics_[i].counts_sorted.get_ptr(),
+                                          statistics_[i].num_unique_categories, stream);
+  uint32_t num_overlap = statistics_[i].calculate_frequent_overlap(
+      model_[i].category_location, model_[i].num_frequent, model_[i].num_instances, stream);
+
+  const size_t num_top =
+      std::min((size_t)model_[i].num_frequent, (size_t)statistics_[i].num_unique_categories);
+  const double overlap = num_top > 0 ? (double)num_overlap / (double)num_top : 1.0;
+  HCTR_LOG_S(INFO, ROOT) << "Hybrid embedding drift check at iteration " << train_steps_ << ": "
+                         << num_overlap << " of the " << num_top
+                         << " hottest observed categories are frequent (overlap " << overlap << ")"
+                         << std::endl;
+  if (overlap < 0.9) {
+    HCTR_LOG_S(WARNING, ROOT) << "The frequent embedding set drifted away from the observed "
+                                 "category distribution, consider re-initializing the model to "
+                                 "recalibrate it"
+                              << std::endl;
+  }
 }
 
 template <typename dtype, typename emtype>
@@ -659,7 +815,16 @@ void HybridSparseEmbedding<dtype, emtype>::freq_backward(int i) {
   cudaStream_t stream = gpu.get_stream();
 
   if (frequent_embeddings_single_node_.size()) {
-    frequent_embeddings_single_node_[i].local_reduce(train_output_tensors_[i].get_ptr(), stream);
+    if (frequent_direct_reduce_) {
+      // Fused path: apply the gradients straight into the owner instances' vectors. The barrier
+      // in infreq_model_backward guarantees completion before the next iteration's forward_model
+      float *dev_lr = lr_scheds_[i]->get_learning_rate();
+      float scale = opt_params_[i].scaler;
+      frequent_embeddings_single_node_[i].local_reduce_direct(train_output_tensors_[i].get_ptr(),
+                                                              dev_lr, scale, stream);
+    } else {
+      frequent_embeddings_single_node_[i].local_reduce(train_output_tensors_[i].get_ptr(), stream);
+    }
   } else {
     frequent_embeddings_multi_node_[i].local_reduce(train_output_tensors_[i].get_ptr(), stream);
     if (!grouped_all_reduce_) {
@@ -803,7 +968,9 @@ void HybridSparseEmbedding<dtype, emtype>::infreq_model_backward(int i) {
 
     float *dev_lr = lr_scheds_[i]->get_learning_rate();
     float scale = opt_params_[i].scaler;
-    frequent_embeddings_single_node_[i].update_model_direct(dev_lr, scale, stream);
+    if (!frequent_direct_reduce_) {
+      frequent_embeddings_single_node_[i].update_model_direct(dev_lr, scale, stream);
+    }
 
     infrequent_embeddings_single_node_[i].update_model_direct(dev_lr, scale, stream);
   }
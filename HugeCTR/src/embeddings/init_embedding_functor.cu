@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <cstdlib>
+
 #include "HugeCTR/include/data_simulator.hpp"
 #include "HugeCTR/include/embeddings/sparse_embedding_functors.hpp"
 #include "HugeCTR/include/general_buffer2.hpp"
@@ -29,6 +31,17 @@ void SparseEmbeddingFunctors::init_embedding_per_gpu(size_t gid, size_t total_gp
                                                      const GPUResource &gpu_resource) {
   CudaDeviceContext context(gpu_resource.get_device_id());
 
+  // Counter-based deterministic init: with HCTR_DETERMINISTIC_INIT=<seed>, each value is a
+  // pure function of (seed, slot, row, col) via Philox, so the initialized tables are bitwise
+  // identical for any GPU count. The per-replica curand sequences stay the default since
+  // their output depends on how slots land on GPUs.
+  bool deterministic_init = false;
+  uint64_t init_seed = 0;
+  if (const char *env = std::getenv("HCTR_DETERMINISTIC_INIT")) {
+    deterministic_init = true;
+    init_seed = std::strtoull(env, nullptr, 10);
+  }
+
   size_t *slot_ids_ptr = slot_ids.get_ptr();
 
   size_t key_offset = 0;
@@ -41,9 +54,17 @@ void SparseEmbeddingFunctors::init_embedding_per_gpu(size_t gid, size_t total_gp
                              << ", value_index_offset=" << value_index_offset << std::endl;
 
       float up_bound = sqrt(1.f / slot_size);
-      HugeCTR::UniformGenerator::fill(
-          embedding_tables[j++], -up_bound, up_bound, gpu_resource.get_sm_count(),
-          gpu_resource.get_replica_variant_curand_generator(), gpu_resource.get_stream());
+      if (deterministic_init) {
+        HugeCTR::PhiloxUniformGenerator::fill(embedding_tables[j].get_ptr(), slot_size,
+                                              embedding_vec_size, -up_bound, up_bound, i, 0,
+                                              init_seed, gpu_resource.get_sm_count(),
+                                              gpu_resource.get_stream());
+        j++;
+      } else {
+        HugeCTR::UniformGenerator::fill(
+            embedding_tables[j++], -up_bound, up_bound, gpu_resource.get_sm_count(),
+            gpu_resource.get_replica_variant_curand_generator(), gpu_resource.get_stream());
+      }
 
       memset_const(slot_ids_ptr, i, slot_size, gpu_resource.get_stream());
 
@@ -16,6 +16,7 @@
 #include <thrust/execution_policy.h>
 #include <thrust/sort.h>
 
+#include <cstdlib>
 #include <cub/cub.cuh>
 #include <filesystem>
 #include <numeric>
@@ -166,6 +167,50 @@ LocalizedSlotSparseEmbeddingHash<TypeHashKey, TypeEmbeddingComp>::LocalizedSlotS
     HCTR_LOG_S(INFO, ROOT) << "max_vocabulary_size_per_gpu_=" << max_vocabulary_size_per_gpu_
                            << std::endl;
 
+    // Opt-in chunked all2all pipeline: split the forward exchange into N sample slices and
+    // overlap each slice's reorder with the next slice's communication.
+    if (const char *env = std::getenv("HCTR_ALL2ALL_CHUNKS")) {
+      int num_chunks = std::atoi(env);
+      if (num_chunks > 1) {
+        all2all_chunk_num_ = num_chunks;
+        HCTR_LOG_S(INFO, ROOT) << "LocalizedSlotSparseEmbeddingHash: chunked all2all pipeline with "
+                               << all2all_chunk_num_ << " slices" << std::endl;
+      }
+    }
+
+    // Opt-in CUDA-graph execution of the train-time forward()/backward(): the launch-only
+    // compute stage is recorded once per GPU and replayed afterwards, removing the
+    // per-iteration kernel launch overhead.
+    if (const char *env = std::getenv("HCTR_EMBEDDING_GRAPH")) {
+      if (std::atoi(env) != 0) {
+        use_train_graph_ = true;
+        if (all2all_chunk_num_ > 1) {
+          HCTR_LOG_S(WARNING, ROOT)
+              << "HCTR_EMBEDDING_GRAPH: disabling the chunked all2all pipeline; its side "
+                 "streams and events cannot be captured into the graphs"
+              << std::endl;
+          all2all_chunk_num_ = 1;
+        }
+        size_t local_gpu_count = embedding_data_.get_resource_manager().get_local_gpu_count();
+        fprop_graphs_.resize(local_gpu_count);
+        bprop_graphs_.resize(local_gpu_count);
+        fprop_captured_nnz_.resize(local_gpu_count, 0);
+        HCTR_LOG_S(INFO, ROOT)
+            << "LocalizedSlotSparseEmbeddingHash: train forward/backward will replay CUDA graphs"
+            << std::endl;
+      }
+    }
+
+    // Opt-in int8 serving of the forward lookup: the fp32 table stays the master copy for
+    // the optimizer, forward reads an int8 shadow with one dequantization scale per row.
+    if (const char *env = std::getenv("HCTR_INT8_EMBEDDING")) {
+      if (std::atoi(env) != 0) {
+        use_quantized_read_ = true;
+        HCTR_LOG_S(INFO, ROOT) << "LocalizedSlotSparseEmbeddingHash: int8 embedding read path"
+                               << std::endl;
+      }
+    }
+
     CudaDeviceContext context;
     for (size_t id = 0; id < embedding_data_.get_resource_manager().get_local_gpu_count(); id++) {
       context.set_device(embedding_data_.get_local_gpu(id).get_device_id());
@@ -214,6 +259,22 @@ LocalizedSlotSparseEmbeddingHash<TypeHashKey, TypeEmbeddingComp>::LocalizedSlotS
         }
         hash_table_value_tensors_.push_back(block->as_tensor());
       }
+
+      // int8 shadow of the hash table value and the per-row dequantization scales
+      if (use_quantized_read_) {
+        {
+          Tensor2<char> tensor;
+          buf->reserve(
+              {max_vocabulary_size_per_gpu_, embedding_data_.embedding_params_.embedding_vec_size},
+              &tensor);
+          quantized_table_tensors_.push_back(tensor);
+        }
+        {
+          Tensor2<float> tensor;
+          buf->reserve({max_vocabulary_size_per_gpu_, 1}, &tensor);
+          quantized_scale_tensors_.push_back(tensor);
+        }
+      }
       {
         Tensor2<TypeHashKey> tensor;
         buf->reserve({embedding_data_.embedding_params_.get_batch_size(true),
@@ -478,6 +539,7 @@ void LocalizedSlotSparseEmbeddingHash<TypeHashKey, TypeEmbeddingComp>::load_para
                   embedding_data_.embedding_params_.embedding_vec_size,
                   max_vocabulary_size_per_gpu_, hash_table_value_tensors_,
                   hash_table_slot_id_tensors_, hash_tables_);
+  quantized_table_ready_ = false;
 }
 
 template <typename TypeHashKey, typename TypeEmbeddingComp>
@@ -487,6 +549,7 @@ void LocalizedSlotSparseEmbeddingHash<TypeHashKey, TypeEmbeddingComp>::load_para
                   embedding_data_.embedding_params_.embedding_vec_size,
                   max_vocabulary_size_per_gpu_, hash_table_value_tensors_,
                   hash_table_slot_id_tensors_, hash_tables_);
+  quantized_table_ready_ = false;
 }
 
 template <typename TypeHashKey, typename TypeEmbeddingComp>
@@ -1159,17 +1222,9 @@ void LocalizedSlotSparseEmbeddingHash<TypeHashKey, TypeEmbeddingComp>::dump_para
     hs->write(vec_file, reinterpret_cast<char *>(h_hash_table_value), total_count * vec_size, true);
   } else if (data_source_params.type == DataSourceType_t::Local) {
     // TODO: Move to self-contained DataSourceBackend implementation.
-    std::ofstream key_stream(key_file, std::ofstream::binary | std::ofstream::trunc);
-    std::ofstream slot_stream(slot_file, std::ofstream::binary | std::ofstream::trunc);
-    std::ofstream vec_stream(vec_file, std::ofstream::binary | std::ofstream::trunc);
-    // check if the file is opened successfully
-    if (!vec_stream.is_open() || !key_stream.is_open() || !slot_stream.is_open()) {
-      HCTR_OWN_THROW(Error_t::WrongInput, "Error: file not open for writing");
-      return;
-    }
-    key_stream.write(reinterpret_cast<char *>(h_key_ptr), total_count * key_size);
-    slot_stream.write(reinterpret_cast<char *>(h_hash_table_slot_id), total_count * slot_size);
-    vec_stream.write(reinterpret_cast<char *>(h_hash_table_value), total_count * vec_size);
+    parallel_file_write(key_file, h_key_ptr, total_count * key_size);
+    parallel_file_write(slot_file, h_hash_table_slot_id, total_count * slot_size);
+    parallel_file_write(vec_file, h_hash_table_value, total_count * vec_size);
   } else {
     HCTR_OWN_THROW(Error_t::WrongInput, "Filesystem not supported yet.");
   }
@@ -1288,6 +1343,233 @@ void LocalizedSlotSparseEmbeddingHash<TypeHashKey, TypeEmbeddingComp>::dump_para
   }
 }
 
+namespace {
+
+/**
+ * On-disk header of a device-native hash table snapshot (dump_parameters_raw). The fields
+ * checked on load pin the snapshot to a table of the same key type, capacity and container
+ * type as the one that was dumped.
+ */
+struct RawSnapshotHeader {
+  static constexpr uint64_t MAGIC = 0x5741525254434855ull;  // "UHCTRRAW"
+  uint64_t magic;
+  uint64_t version;
+  uint64_t key_bytes;
+  uint64_t table_bytes;       /**< bytes of the raw slot array */
+  uint64_t count;             /**< used rows of the value / slot-id tensors (value head) */
+  uint64_t embedding_vec_size;
+};
+
+/**
+ * Size of the pinned staging buffer the raw snapshot is streamed through. Split into two
+ * halves so the file write of one chunk overlaps the device copy of the next.
+ */
+constexpr size_t RAW_SNAPSHOT_STAGING_BYTES = 64ul * 1024 * 1024;
+
+}  // namespace
+
+template <typename TypeHashKey, typename TypeEmbeddingComp>
+void LocalizedSlotSparseEmbeddingHash<TypeHashKey, TypeEmbeddingComp>::dump_parameters_raw(
+    const std::string &snapshot_dir) const {
+  CudaDeviceContext context;
+  size_t local_gpu_count = embedding_data_.get_resource_manager().get_local_gpu_count();
+  size_t embedding_vec_size = embedding_data_.embedding_params_.embedding_vec_size;
+  int my_rank = embedding_data_.get_resource_manager().get_process_id();
+
+  if (!std::filesystem::exists(snapshot_dir)) {
+    std::filesystem::create_directories(snapshot_dir);
+  }
+
+  char *h_staging;
+  HCTR_LIB_THROW(cudaMallocHost(&h_staging, RAW_SNAPSHOT_STAGING_BYTES));
+  const size_t half = RAW_SNAPSHOT_STAGING_BYTES / 2;
+
+  for (size_t id = 0; id < local_gpu_count; id++) {
+    context.set_device(embedding_data_.get_local_gpu(id).get_device_id());
+    cudaStream_t stream = embedding_data_.get_local_gpu(id).get_stream();
+
+    size_t count = hash_tables_[id]->get_value_head(stream);
+    HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+
+    RawSnapshotHeader header{};
+    header.magic = RawSnapshotHeader::MAGIC;
+    header.version = 1;
+    header.key_bytes = sizeof(TypeHashKey);
+    header.table_bytes = hash_tables_[id]->get_raw_table_bytes();
+    header.count = count;
+    header.embedding_vec_size = embedding_vec_size;
+
+    const std::string file(snapshot_dir + "/raw_snapshot." + std::to_string(my_rank) + "." +
+                           std::to_string(id));
+    std::ofstream ofs(file, std::ofstream::binary | std::ofstream::trunc);
+    if (!ofs.is_open()) {
+      HCTR_OWN_THROW(Error_t::WrongInput, "Error: file not open for writing: " + file);
+    }
+    ofs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    HCTR_LOG_S(INFO, WORLD) << "Rank" << my_rank << ": Dump raw hash table snapshot from GPU" << id
+                            << std::endl;
+
+    cudaEvent_t events[2];
+    for (int s = 0; s < 2; s++) {
+      HCTR_LIB_THROW(cudaEventCreateWithFlags(&events[s], cudaEventDisableTiming));
+    }
+
+    // Stream total_bytes through the two staging halves: the device-to-host copy of chunk
+    // n + 1 runs while chunk n is written out.
+    auto stream_to_file = [&](auto issue_copy, size_t total_bytes) {
+      size_t sizes[2] = {0, 0};
+      size_t submitted = 0, head = 0, tail = 0;
+      while (submitted < total_bytes || head < tail) {
+        while (submitted < total_bytes && tail - head < 2) {
+          const int slot = tail % 2;
+          const size_t chunk = std::min(half, total_bytes - submitted);
+          issue_copy(h_staging + slot * half, submitted, chunk);
+          HCTR_LIB_THROW(cudaEventRecord(events[slot], stream));
+          sizes[slot] = chunk;
+          submitted += chunk;
+          tail++;
+        }
+        const int slot = head % 2;
+        HCTR_LIB_THROW(cudaEventSynchronize(events[slot]));
+        ofs.write(h_staging + slot * half, sizes[slot]);
+        head++;
+      }
+    };
+
+    stream_to_file(
+        [&](char *h_dst, size_t offset, size_t bytes) {
+          hash_tables_[id]->download_raw_table(h_dst, offset, bytes, stream);
+        },
+        header.table_bytes);
+
+    const char *slot_id_ptr =
+        reinterpret_cast<const char *>(hash_table_slot_id_tensors_[id].get_ptr());
+    stream_to_file(
+        [&](char *h_dst, size_t offset, size_t bytes) {
+          HCTR_LIB_THROW(
+              cudaMemcpyAsync(h_dst, slot_id_ptr + offset, bytes, cudaMemcpyDeviceToHost, stream));
+        },
+        count * sizeof(size_t));
+
+    const char *value_ptr = reinterpret_cast<const char *>(hash_table_value_tensors_[id].get_ptr());
+    stream_to_file(
+        [&](char *h_dst, size_t offset, size_t bytes) {
+          HCTR_LIB_THROW(
+              cudaMemcpyAsync(h_dst, value_ptr + offset, bytes, cudaMemcpyDeviceToHost, stream));
+        },
+        count * embedding_vec_size * sizeof(float));
+
+    for (int s = 0; s < 2; s++) {
+      HCTR_LIB_THROW(cudaEventDestroy(events[s]));
+    }
+  }
+  HCTR_LIB_THROW(cudaFreeHost(h_staging));
+  HCTR_LOG(INFO, ROOT, "Done\n");
+}
+
+template <typename TypeHashKey, typename TypeEmbeddingComp>
+void LocalizedSlotSparseEmbeddingHash<TypeHashKey, TypeEmbeddingComp>::load_parameters_raw(
+    const std::string &snapshot_dir) {
+  CudaDeviceContext context;
+  size_t local_gpu_count = embedding_data_.get_resource_manager().get_local_gpu_count();
+  size_t embedding_vec_size = embedding_data_.embedding_params_.embedding_vec_size;
+  int my_rank = embedding_data_.get_resource_manager().get_process_id();
+
+  char *h_staging;
+  HCTR_LIB_THROW(cudaMallocHost(&h_staging, RAW_SNAPSHOT_STAGING_BYTES));
+  const size_t half = RAW_SNAPSHOT_STAGING_BYTES / 2;
+
+  for (size_t id = 0; id < local_gpu_count; id++) {
+    context.set_device(embedding_data_.get_local_gpu(id).get_device_id());
+    cudaStream_t stream = embedding_data_.get_local_gpu(id).get_stream();
+
+    const std::string file(snapshot_dir + "/raw_snapshot." + std::to_string(my_rank) + "." +
+                           std::to_string(id));
+    std::ifstream ifs(file, std::ifstream::binary);
+    if (!ifs.is_open()) {
+      HCTR_OWN_THROW(Error_t::WrongInput, "Error: file not open for reading: " + file);
+    }
+
+    RawSnapshotHeader header{};
+    ifs.read(reinterpret_cast<char *>(&header), sizeof(header));
+    if (!ifs || header.magic != RawSnapshotHeader::MAGIC || header.version != 1) {
+      HCTR_OWN_THROW(Error_t::BrokenFile, "Error: not a raw hash table snapshot: " + file);
+    }
+    if (header.key_bytes != sizeof(TypeHashKey) ||
+        header.table_bytes != hash_tables_[id]->get_raw_table_bytes() ||
+        header.embedding_vec_size != embedding_vec_size ||
+        header.count > max_vocabulary_size_per_gpu_) {
+      HCTR_OWN_THROW(Error_t::WrongInput,
+                     "Error: raw snapshot " + file +
+                         " does not match the current table layout; it can only be restored on "
+                         "the same GPU mapping, capacity and container type it was dumped from");
+    }
+
+    HCTR_LOG_S(INFO, WORLD) << "Rank" << my_rank << ": Load raw hash table snapshot to GPU" << id
+                            << std::endl;
+
+    cudaEvent_t events[2];
+    for (int s = 0; s < 2; s++) {
+      HCTR_LIB_THROW(cudaEventCreateWithFlags(&events[s], cudaEventDisableTiming));
+    }
+
+    // Stream total_bytes through the two staging halves: the file read of chunk n + 1 runs
+    // while chunk n is copied to the device. A slot is reused only after its copy finished.
+    auto stream_from_file = [&](auto issue_copy, size_t total_bytes) {
+      bool used[2] = {false, false};
+      size_t consumed = 0;
+      int slot = 0;
+      while (consumed < total_bytes) {
+        const size_t chunk = std::min(half, total_bytes - consumed);
+        if (used[slot]) {
+          HCTR_LIB_THROW(cudaEventSynchronize(events[slot]));
+        }
+        ifs.read(h_staging + slot * half, chunk);
+        if (!ifs) {
+          HCTR_OWN_THROW(Error_t::BrokenFile, "Error: raw snapshot truncated: " + file);
+        }
+        issue_copy(h_staging + slot * half, consumed, chunk);
+        HCTR_LIB_THROW(cudaEventRecord(events[slot], stream));
+        used[slot] = true;
+        consumed += chunk;
+        slot ^= 1;
+      }
+    };
+
+    stream_from_file(
+        [&](const char *h_src, size_t offset, size_t bytes) {
+          hash_tables_[id]->upload_raw_table(h_src, offset, bytes, stream);
+        },
+        header.table_bytes);
+
+    char *slot_id_ptr = reinterpret_cast<char *>(hash_table_slot_id_tensors_[id].get_ptr());
+    stream_from_file(
+        [&](const char *h_src, size_t offset, size_t bytes) {
+          HCTR_LIB_THROW(
+              cudaMemcpyAsync(slot_id_ptr + offset, h_src, bytes, cudaMemcpyHostToDevice, stream));
+        },
+        header.count * sizeof(size_t));
+
+    char *value_ptr = reinterpret_cast<char *>(hash_table_value_tensors_[id].get_ptr());
+    stream_from_file(
+        [&](const char *h_src, size_t offset, size_t bytes) {
+          HCTR_LIB_THROW(
+              cudaMemcpyAsync(value_ptr + offset, h_src, bytes, cudaMemcpyHostToDevice, stream));
+        },
+        header.count * embedding_vec_size * sizeof(float));
+
+    hash_tables_[id]->set_value_head(header.count, stream);
+
+    for (int s = 0; s < 2; s++) {
+      HCTR_LIB_THROW(cudaEventDestroy(events[s]));
+    }
+  }
+  functors_.sync_all_gpus(embedding_data_.get_resource_manager());
+  HCTR_LIB_THROW(cudaFreeHost(h_staging));
+  HCTR_LOG(INFO, ROOT, "Done\n");
+}
+
 template <typename TypeHashKey, typename TypeEmbeddingComp>
 void LocalizedSlotSparseEmbeddingHash<TypeHashKey, TypeEmbeddingComp>::dump_opt_states(
     std::ofstream &stream, std::string write_path, const DataSourceParams &data_source_params) {
@@ -1399,6 +1681,7 @@ void LocalizedSlotSparseEmbeddingHash<TypeHashKey, TypeEmbeddingComp>::reset() {
   for (size_t i = 0; i < embedding_data_.get_resource_manager().get_local_gpu_count(); i++) {
     HCTR_LIB_THROW(cudaStreamSynchronize(embedding_data_.get_local_gpu(i).get_stream()));
   }
+  quantized_table_ready_ = false;
 }
 
 template <typename TypeHashKey, typename TypeEmbeddingComp>
@@ -332,6 +332,14 @@ LocalizedSlotSparseEmbeddingOneHot<TypeHashKey, TypeEmbeddingComp>::
     }
 #endif
 
+    // Device-side barrier for the fused P2P forward/backward kernels, so that the peer
+    // stores are ordered with their consumers without synchronizing the host
+    if (embedding_data_.get_resource_manager().get_local_gpu_count() > 1) {
+      gpu_barrier_ = std::make_unique<GPUBarrier>(
+          embedding_data_.get_resource_manager().get_local_gpu_count(),
+          embedding_data_.get_resource_manager().get_local_gpu_device_id_list(), true);
+    }
+
     std::shared_ptr<GeneralBuffer2<CudaManagedAllocator>> unified_buf =
         GeneralBuffer2<CudaManagedAllocator>::create();
     unified_buf->reserve({embedding_data_.get_resource_manager().get_local_gpu_count()},
@@ -642,6 +650,14 @@ LocalizedSlotSparseEmbeddingOneHot<TypeHashKey, TypeEmbeddingComp>::
     }
 #endif
 
+    // Device-side barrier for the fused P2P forward/backward kernels, so that the peer
+    // stores are ordered with their consumers without synchronizing the host
+    if (embedding_data_.get_resource_manager().get_local_gpu_count() > 1) {
+      gpu_barrier_ = std::make_unique<GPUBarrier>(
+          embedding_data_.get_resource_manager().get_local_gpu_count(),
+          embedding_data_.get_resource_manager().get_local_gpu_device_id_list(), true);
+    }
+
     std::shared_ptr<GeneralBuffer2<CudaManagedAllocator>> unified_buf =
         GeneralBuffer2<CudaManagedAllocator>::create();
     unified_buf->reserve({embedding_data_.get_resource_manager().get_local_gpu_count()},
@@ -1211,17 +1227,9 @@ void LocalizedSlotSparseEmbeddingOneHot<TypeHashKey, TypeEmbeddingComp>::dump_pa
     hs->write(vec_file, reinterpret_cast<char *>(h_hash_table_value), total_count * vec_size, true);
   } else if (data_source_params.type == DataSourceType_t::Local) {
     // TODO: Move to self-contained DataSourceBackend implementation.
-    std::ofstream key_stream(key_file, std::ofstream::binary | std::ofstream::trunc);
-    std::ofstream slot_stream(slot_file, std::ofstream::binary | std::ofstream::trunc);
-    std::ofstream vec_stream(vec_file, std::ofstream::binary | std::ofstream::trunc);
-    // check if the file is opened successfully
-    if (!vec_stream.is_open() || !key_stream.is_open() || !slot_stream.is_open()) {
-      HCTR_OWN_THROW(Error_t::WrongInput, "Error: file not open for writing");
-      return;
-    }
-    key_stream.write(reinterpret_cast<char *>(h_key_ptr), total_count * key_size);
-    slot_stream.write(reinterpret_cast<char *>(h_hash_table_slot_id), total_count * slot_size);
-    vec_stream.write(reinterpret_cast<char *>(h_hash_table_value), total_count * vec_size);
+    parallel_file_write(key_file, h_key_ptr, total_count * key_size);
+    parallel_file_write(slot_file, h_hash_table_slot_id, total_count * slot_size);
+    parallel_file_write(vec_file, h_hash_table_value, total_count * vec_size);
   } else {
     HCTR_OWN_THROW(Error_t::WrongInput, "Filesystem not supported yet.");
   }
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2021, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "HugeCTR/include/embeddings/sparse_embedding_functors.hpp"
+#include "HugeCTR/include/utils.cuh"
+
+namespace HugeCTR {
+
+namespace {
+
+// One block per row: the block first reduces the absolute maximum of the row in shared
+// memory, then rescales every element to int8 with scale = absmax / 127. When value_index
+// is given, entry i quantizes row value_index[i]; duplicated indices write identical
+// results, so the redundant stores after update_params() are benign.
+__global__ void quantize_rows_kernel(size_t num_entries, int embedding_vec_size,
+                                     const size_t *value_index, const float *hash_table_value,
+                                     int8_t *quantized_table, float *row_scale) {
+  extern __shared__ float absmax_smem[];
+
+  size_t entry = blockIdx.x;
+  if (entry >= num_entries) {
+    return;
+  }
+  size_t row = (value_index != nullptr) ? value_index[entry] : entry;
+  if (row == std::numeric_limits<size_t>::max()) {
+    return;
+  }
+
+  int tid = threadIdx.x;
+  const float *src = hash_table_value + row * embedding_vec_size;
+
+  absmax_smem[tid] = (tid < embedding_vec_size) ? fabsf(src[tid]) : 0.0f;
+  __syncthreads();
+  // blockDim.x is the embedding vector size rounded up to a power of two
+  for (int stride = blockDim.x / 2; stride > 0; stride >>= 1) {
+    if (tid < stride) {
+      absmax_smem[tid] = fmaxf(absmax_smem[tid], absmax_smem[tid + stride]);
+    }
+    __syncthreads();
+  }
+  float scale = absmax_smem[0] / 127.0f;
+
+  if (tid < embedding_vec_size) {
+    int8_t quantized = 0;
+    if (scale > 0.0f) {
+      float rounded = rintf(src[tid] / scale);
+      rounded = fmaxf(-127.0f, fminf(127.0f, rounded));
+      quantized = static_cast<int8_t>(rounded);
+    }
+    quantized_table[row * embedding_vec_size + tid] = quantized;
+  }
+  if (tid == 0) {
+    row_scale[row] = scale;
+  }
+}
+
+void quantize_rows(size_t num_entries, size_t embedding_vec_size, const size_t *value_index,
+                   const float *hash_table_value, int8_t *quantized_table, float *row_scale,
+                   cudaStream_t stream) {
+  if (num_entries == 0) {
+    return;
+  }
+  size_t block_size = 1;
+  while (block_size < embedding_vec_size) {
+    block_size <<= 1;
+  }
+  const size_t grid_size = num_entries;  // each block corresponds to a row
+  quantize_rows_kernel<<<grid_size, block_size, block_size * sizeof(float), stream>>>(
+      num_entries, embedding_vec_size, value_index, hash_table_value, quantized_table, row_scale);
+}
+
+}  // namespace
+
+void SparseEmbeddingFunctors::quantize_embedding_rows(size_t num_rows, size_t embedding_vec_size,
+                                                      const Tensor2<float> &hash_table_value,
+                                                      Tensor2<char> &quantized_table,
+                                                      Tensor2<float> &row_scale,
+                                                      cudaStream_t stream) {
+  quantize_rows(num_rows, embedding_vec_size, nullptr, hash_table_value.get_ptr(),
+                reinterpret_cast<int8_t *>(quantized_table.get_ptr()), row_scale.get_ptr(), stream);
+}
+
+void SparseEmbeddingFunctors::quantize_embedding_rows(const Tensor2<size_t> &hash_value_index,
+                                                      size_t num_entries, size_t embedding_vec_size,
+                                                      const Tensor2<float> &hash_table_value,
+                                                      Tensor2<char> &quantized_table,
+                                                      Tensor2<float> &row_scale,
+                                                      cudaStream_t stream) {
+  quantize_rows(num_entries, embedding_vec_size, hash_value_index.get_ptr(),
+                hash_table_value.get_ptr(),
+                reinterpret_cast<int8_t *>(quantized_table.get_ptr()), row_scale.get_ptr(), stream);
+}
+
+}  // namespace HugeCTR
@@ -16,6 +16,10 @@
 
 #include <thrust/sort.h>  // for implictly including cub headers
 
+#include <cstdlib>
+#include <mutex>
+#include <unordered_map>
+
 #include "HugeCTR/include/embeddings/hybrid_embedding/statistics.hpp"
 #include "HugeCTR/include/embeddings/sparse_embedding_functors.hpp"
 #include "HugeCTR/include/utils.cuh"
@@ -172,6 +176,102 @@ __global__ void opt_sgd_atomic_kernel(int nnz, int embedding_vec_size, float lr_
   }
 }
 
+__global__ void iota_kernel(int nnz, uint32_t *out) {
+  int i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i < nnz) {
+    out[i] = i;
+  }
+}
+
+// Key-clustered variant of opt_sgd_atomic_kernel: consumes (value_index, sample_id) pairs that
+// have been sorted by value_index, so all occurrences of a hot key are contiguous. Each block
+// walks one chunk of the sorted sequence and accumulates runs of equal indices in registers,
+// issuing a single atomicAdd per run per element instead of one per occurrence. For power-law
+// batches this collapses the contention on hot rows to at most one atomic per block.
+template <typename TypeEmbeddingComp>
+__global__ void opt_sgd_sorted_kernel(int nnz, int embedding_vec_size, float lr_scale,
+                                      const size_t *sorted_value_index,
+                                      const uint32_t *sorted_sample_ids,
+                                      const TypeEmbeddingComp *wgrad, float *hash_table_value,
+                                      int items_per_block) {
+  int tid = threadIdx.x;
+  int start = blockIdx.x * items_per_block;
+  int end = min(nnz, start + items_per_block);
+
+  if (tid < embedding_vec_size && start < nnz) {
+    float accum = 0.0f;
+    size_t cur_index = sorted_value_index[start];
+    for (int i = start; i < end; i++) {
+      size_t value_index = sorted_value_index[i];
+      if (value_index != cur_index) {
+        atomicAdd(&hash_table_value[cur_index * embedding_vec_size + tid], accum);
+        cur_index = value_index;
+        accum = 0.0f;
+      }
+      size_t sample_id = sorted_sample_ids[i];
+      accum += -lr_scale * TypeConvertFunc<float, TypeEmbeddingComp>::convert(
+                               wgrad[sample_id * embedding_vec_size + tid]);
+    }
+    atomicAdd(&hash_table_value[cur_index * embedding_vec_size + tid], accum);
+  }
+}
+
+// Per-device scratch for the sorted SGD update: pair buffers for the radix sort plus the cub
+// temp storage, grown on demand and reused across iterations.
+struct SortedUpdateWorkspace {
+  size_t capacity{0};
+  size_t *value_index_out{nullptr};
+  uint32_t *sample_ids{nullptr};
+  uint32_t *sample_ids_out{nullptr};
+  void *cub_temp{nullptr};
+  size_t cub_temp_bytes{0};
+};
+
+template <typename TypeEmbeddingComp>
+void opt_sgd_sorted(size_t nnz, size_t embedding_vec_size, float lr_scale,
+                    const size_t *hash_value_index, const TypeEmbeddingComp *wgrad,
+                    float *hash_table_value, cudaStream_t stream) {
+  static std::mutex workspace_guard;
+  static std::unordered_map<int, SortedUpdateWorkspace> workspaces;
+
+  int device_id = -1;
+  HCTR_LIB_THROW(cudaGetDevice(&device_id));
+  SortedUpdateWorkspace *ws{nullptr};
+  {
+    std::lock_guard<std::mutex> lock(workspace_guard);
+    ws = &workspaces[device_id];
+  }
+  if (ws->capacity < nnz) {
+    HCTR_LIB_THROW(cudaFree(ws->value_index_out));
+    HCTR_LIB_THROW(cudaFree(ws->sample_ids));
+    HCTR_LIB_THROW(cudaFree(ws->sample_ids_out));
+    HCTR_LIB_THROW(cudaFree(ws->cub_temp));
+    HCTR_LIB_THROW(cudaMalloc(&ws->value_index_out, nnz * sizeof(size_t)));
+    HCTR_LIB_THROW(cudaMalloc(&ws->sample_ids, nnz * sizeof(uint32_t)));
+    HCTR_LIB_THROW(cudaMalloc(&ws->sample_ids_out, nnz * sizeof(uint32_t)));
+    ws->cub_temp_bytes = 0;
+    HCTR_LIB_THROW(cub::DeviceRadixSort::SortPairs(
+        nullptr, ws->cub_temp_bytes, hash_value_index, ws->value_index_out, ws->sample_ids,
+        ws->sample_ids_out, nnz, 0, sizeof(size_t) * 8, stream));
+    HCTR_LIB_THROW(cudaMalloc(&ws->cub_temp, ws->cub_temp_bytes));
+    ws->capacity = nnz;
+  }
+
+  constexpr size_t block_size = 256;
+  iota_kernel<<<(nnz + block_size - 1) / block_size, block_size, 0, stream>>>(
+      static_cast<int>(nnz), ws->sample_ids);
+  size_t temp_bytes = ws->cub_temp_bytes;
+  HCTR_LIB_THROW(cub::DeviceRadixSort::SortPairs(
+      ws->cub_temp, temp_bytes, hash_value_index, ws->value_index_out, ws->sample_ids,
+      ws->sample_ids_out, nnz, 0, sizeof(size_t) * 8, stream));
+
+  size_t grid_size = max(1ul, (nnz - 1) / num_samples_per_block + 1);
+  opt_sgd_sorted_kernel<<<grid_size, embedding_vec_size, 0, stream>>>(
+      static_cast<int>(nnz), static_cast<int>(embedding_vec_size), lr_scale, ws->value_index_out,
+      ws->sample_ids_out, wgrad, hash_table_value, num_samples_per_block);
+  HCTR_LIB_THROW(cudaPeekAtLastError());
+}
+
 }  // namespace
 
 template <typename TypeEmbeddingComp>
@@ -179,6 +279,16 @@ void SparseEmbeddingFunctors::opt_sgd_atomic_cached<TypeEmbeddingComp>(
     size_t num_samples, size_t embedding_vec_size, const size_t *hash_value_index, float lr,
     float scaler, const TypeEmbeddingComp *wgrad, float *hash_table_value, size_t *top_categories,
     size_t &size_top_categories, cudaStream_t stream, bool force_stats) {
+  // Key-clustered update (HCTR_SGD_SORTED_UPDATE): sort the batch by embedding row first so
+  // the scattered atomic adds of power-law batches become segmented register reductions. The
+  // default shared-memory top-category path only absorbs the hottest max_size_top_categories
+  // rows; the sorted path handles arbitrary skew at the price of one radix sort per batch.
+  static const bool sorted_update{std::getenv("HCTR_SGD_SORTED_UPDATE") != nullptr};
+  if (sorted_update) {
+    opt_sgd_sorted(num_samples, embedding_vec_size, lr / scaler, hash_value_index, wgrad,
+                   hash_table_value, stream);
+    return;
+  }
   static bool perform_stats = true;
   if (perform_stats || force_stats) {
     uint32_t num_unique_categories;
@@ -231,6 +341,33 @@ void SparseEmbeddingFunctors::update_params<TypeEmbeddingComp>(
   return;
 }
 
+namespace {
+
+__global__ void mark_touched_rows_kernel(int nnz, const size_t *hash_value_index,
+                                         uint32_t *touched_rows) {
+  const int i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i < nnz) {
+    const size_t row = hash_value_index[i];
+    atomicOr(&touched_rows[row / 32], 1u << (row % 32));
+  }
+}
+
+}  // namespace
+
+void SparseEmbeddingFunctors::mark_touched_rows(size_t nnz,
+                                                const Tensor2<size_t> &hash_value_index,
+                                                Tensor2<uint32_t> &touched_rows,
+                                                cudaStream_t stream) {
+  if (nnz == 0) {
+    return;
+  }
+  constexpr size_t block_size = 256;
+  const size_t grid_size = (nnz + block_size - 1) / block_size;
+  mark_touched_rows_kernel<<<grid_size, block_size, 0, stream>>>(
+      static_cast<int>(nnz), hash_value_index.get_ptr(), touched_rows.get_ptr());
+  HCTR_LIB_THROW(cudaPeekAtLastError());
+}
+
 template void SparseEmbeddingFunctors::opt_sgd_atomic_cached<float>(
     size_t num_samples, size_t embedding_vec_size, const size_t *hash_value_index, float lr,
     float scaler, const float *wgrad, float *hash_table_value, size_t *top_categories,
@@ -14,11 +14,33 @@
  * limitations under the License.
  */
 
+#include <cstdlib>
 #include <exchange_wgrad.hpp>
 #include <utils.hpp>
 
 namespace HugeCTR {
 
+namespace {
+
+__global__ void compress_fp16_kernel(const float* wgrad, float* residual, __half* comp, int n) {
+  int i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i < n) {
+    float val = wgrad[i] + residual[i];
+    __half h = __float2half(val);
+    residual[i] = val - __half2float(h);
+    comp[i] = h;
+  }
+}
+
+__global__ void decompress_fp16_kernel(const __half* comp, float* wgrad, int n) {
+  int i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i < n) {
+    wgrad[i] = __half2float(comp[i]);
+  }
+}
+
+}  // namespace
+
 template <typename T>
 NetworkExchangeWgrad<T>::NetworkExchangeWgrad(
     const std::shared_ptr<ResourceManager>& resource_manager)
@@ -82,6 +104,18 @@ GroupedExchangeWgrad<T>::GroupedExchangeWgrad(
     embed_wgrad_buffs_[g] = bufs_[g]->create_block<T>();
   }
 
+  if (std::getenv("HCTR_WGRAD_COMPRESS_FP16")) {
+    if (std::is_same<T, float>::value) {
+      compress_fp16_ = true;
+      HCTR_LOG_S(INFO, ROOT)
+          << "Grouped wgrad exchange: FP16 transport compression with error feedback" << std::endl;
+    } else {
+      HCTR_LOG_S(WARNING, ROOT) << "HCTR_WGRAD_COMPRESS_FP16 has no effect: the wgrads are "
+                                   "already exchanged in FP16"
+                                << std::endl;
+    }
+  }
+
   auto ar_comm = resource_manager_->get_ar_comm();
   ar_handle_ = ar_comm->register_coll();
 }
@@ -105,6 +139,24 @@ void GroupedExchangeWgrad<T>::allocate() {
     ar_comm->set_coll_buf(ar_handle_, bufs_[g]->get_ptr(), bufs_[g]->get_size_in_bytes(), g);
   }
   ar_comm->register_coll_buf(ar_handle_);
+
+  ar_size_bytes_ = bufs_[0]->get_size_in_bytes();
+  if (compress_fp16_) {
+    size_t num_elems = bufs_[0]->get_size_in_bytes() / sizeof(T);
+    compress_bufs_.resize(num_gpus_);
+    compress_tensors_.resize(num_gpus_);
+    residual_tensors_.resize(num_gpus_);
+    for (size_t g = 0; g < num_gpus_; g++) {
+      auto& gpu_resource = resource_manager_->get_local_gpu(g);
+      CudaDeviceContext context(gpu_resource->get_device_id());
+      compress_bufs_[g] = GeneralBuffer2<CudaAllocator>::create();
+      compress_bufs_[g]->reserve({num_elems}, &compress_tensors_[g]);
+      compress_bufs_[g]->reserve({num_elems}, &residual_tensors_[g]);
+      compress_bufs_[g]->allocate();
+      HCTR_LIB_THROW(cudaMemset(residual_tensors_[g].get_ptr(), 0,
+                                residual_tensors_[g].get_size_in_bytes()));
+    }
+  }
 }
 
 template <typename T>
@@ -117,10 +169,25 @@ void GroupedExchangeWgrad<T>::update_embed_wgrad_size(size_t size) {
 
   auto ar_comm = resource_manager_->get_ar_comm();
   ar_comm->update_size(ar_handle_, network_wgrad_size_ + embed_wgrad_size_);
+  ar_size_bytes_ = network_wgrad_size_ + embed_wgrad_size_;
 }
 
 template <typename T>
 void GroupedExchangeWgrad<T>::allreduce(size_t device_id, cudaStream_t stream) {
+  if (compress_fp16_) {
+    auto& gpu_resource = resource_manager_->get_local_gpu(device_id);
+    float* wgrad = reinterpret_cast<float*>(bufs_[device_id]->get_ptr());
+    __half* comp = compress_tensors_[device_id].get_ptr();
+    float* residual = residual_tensors_[device_id].get_ptr();
+    int num_elems = ar_size_bytes_ / sizeof(float);
+    constexpr int block_dim = 256;
+    int grid_dim = (num_elems + block_dim - 1) / block_dim;
+    compress_fp16_kernel<<<grid_dim, block_dim, 0, stream>>>(wgrad, residual, comp, num_elems);
+    HCTR_LIB_THROW(ncclAllReduce(comp, comp, num_elems, NcclDataType<__half>::getType(), ncclSum,
+                                 gpu_resource->get_nccl(), stream));
+    decompress_fp16_kernel<<<grid_dim, block_dim, 0, stream>>>(comp, wgrad, num_elems);
+    return;
+  }
   auto ar_comm = resource_manager_->get_ar_comm();
   ar_comm->all_reduce(ar_handle_, stream, device_id);
 }
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "HugeCTR/include/gemm_algo_cache.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <tuple>
+
+#include "HugeCTR/include/common.hpp"
+
+namespace HugeCTR {
+
+namespace {
+
+constexpr char kCacheMagic[] = "HugeCTR.GemmAlgoCache.v1";
+constexpr size_t kAlgoWords = sizeof(cublasLtMatmulAlgo_t) / sizeof(uint64_t);
+
+}  // namespace
+
+bool GemmAlgoCache::Key::operator<(const Key& rhs) const {
+  return std::tie(m, n, k, data_type, arch, op, epilogue) <
+         std::tie(rhs.m, rhs.n, rhs.k, rhs.data_type, rhs.arch, rhs.op, rhs.epilogue);
+}
+
+GemmAlgoCache& GemmAlgoCache::get() {
+  static GemmAlgoCache instance;
+  return instance;
+}
+
+void GemmAlgoCache::set_file(const std::string& path) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  path_ = path;
+
+  std::ifstream fs(path_);
+  if (!fs.is_open()) {
+    HCTR_LOG_S(INFO, ROOT) << "GEMM algorithm cache " << path_
+                           << " does not exist yet. It is written after algorithm search."
+                           << std::endl;
+    return;
+  }
+
+  std::string magic;
+  size_t version = 0;
+  fs >> magic >> version;
+  if (magic != kCacheMagic || version != cublasLtGetVersion()) {
+    HCTR_LOG_S(WARNING, ROOT) << "GEMM algorithm cache " << path_
+                              << " was written by a different cublasLt version. Re-tuning."
+                              << std::endl;
+    return;
+  }
+
+  size_t num_loaded = 0;
+  Key key;
+  uint64_t words[kAlgoWords];
+  while (fs >> key.m >> key.n >> key.k >> key.data_type >> key.arch >> key.op >> key.epilogue) {
+    for (size_t i = 0; i < kAlgoWords; ++i) {
+      if (!(fs >> std::hex >> words[i] >> std::dec)) {
+        HCTR_OWN_THROW(Error_t::BrokenFile, "GEMM algorithm cache file is truncated.");
+      }
+    }
+    cublasLtMatmulAlgo_t algo;
+    std::memcpy(&algo, words, sizeof(algo));
+    entries_[key] = algo;
+    ++num_loaded;
+  }
+  HCTR_LOG_S(INFO, ROOT) << "Loaded " << num_loaded << " tuned GEMM algorithms from " << path_
+                         << std::endl;
+}
+
+bool GemmAlgoCache::find(const Key& key, cublasLtMatmulAlgo_t* algo) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return false;
+  }
+  *algo = it->second;
+  return true;
+}
+
+void GemmAlgoCache::update(const Key& key, const cublasLtMatmulAlgo_t& algo) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_[key] = algo;
+  dirty_ = true;
+}
+
+void GemmAlgoCache::flush() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (path_.empty() || !dirty_) {
+    return;
+  }
+
+  std::ofstream fs(path_, std::ofstream::trunc);
+  if (!fs.is_open()) {
+    HCTR_OWN_THROW(Error_t::FileCannotOpen, "Cannot write GEMM algorithm cache: " + path_);
+  }
+  fs << kCacheMagic << " " << cublasLtGetVersion() << "\n";
+  for (const auto& entry : entries_) {
+    const Key& key = entry.first;
+    uint64_t words[kAlgoWords];
+    std::memcpy(words, &entry.second, sizeof(entry.second));
+    fs << key.m << " " << key.n << " " << key.k << " " << key.data_type << " " << key.arch << " "
+       << key.op << " " << key.epilogue;
+    for (size_t i = 0; i < kAlgoWords; ++i) {
+      fs << " " << std::hex << words[i] << std::dec;
+    }
+    fs << "\n";
+  }
+  dirty_ = false;
+  HCTR_LOG_S(INFO, ROOT) << "Saved " << entries_.size() << " tuned GEMM algorithms to " << path_
+                         << std::endl;
+}
+
+}  // namespace HugeCTR
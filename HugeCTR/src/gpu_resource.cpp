@@ -14,7 +14,9 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <common.hpp>
+#include <cstdlib>
 #include <gpu_resource.hpp>
 #include <utils.hpp>
 
@@ -22,12 +24,15 @@ namespace HugeCTR {
 
 GPUResource::GPUResource(int device_id, size_t local_id, size_t global_id,
                          unsigned long long replica_uniform_seed,
-                         unsigned long long replica_variant_seed, const ncclComm_t& comm)
+                         unsigned long long replica_variant_seed, const ncclComm_t& comm,
+                         ncclComm_t island_comm, bool own_comms)
     : device_id_(device_id),
       local_id_(local_id),
       global_id_(global_id),
       stream_name_("default"),
-      comm_(comm) {
+      comm_(comm),
+      island_comm_(island_comm),
+      own_comms_(own_comms) {
   CudaDeviceContext context(device_id);
   HCTR_LIB_THROW(
       curandCreateGenerator(&replica_variant_curand_generator_, CURAND_RNG_PSEUDO_DEFAULT));
@@ -59,6 +64,19 @@ GPUResource::GPUResource(int device_id, size_t local_id, size_t global_id,
   HCTR_LIB_THROW(cudaDeviceGetAttribute(&sm_count, cudaDevAttrMultiProcessorCount, device_id));
   sm_count_ = sm_count;
 
+  // Background work (metrics, cache refresh, index precompute) runs on a lowest-priority stream
+  // and is asked to clamp its grids to a fraction of the SMs, so it cannot steal the whole device
+  // from the critical path. The fraction is tunable with HCTR_BACKGROUND_SM_PERCENT (default 25).
+  int least_priority, greatest_priority;
+  HCTR_LIB_THROW(cudaDeviceGetStreamPriorityRange(&least_priority, &greatest_priority));
+  background_stream_ =
+      stream_event_manager_.get_stream("background_stream_", cudaStreamNonBlocking, least_priority);
+  int background_sm_percent = 25;
+  if (const char* env = std::getenv("HCTR_BACKGROUND_SM_PERCENT")) {
+    background_sm_percent = std::max(1, std::min(100, std::atoi(env)));
+  }
+  background_sm_count_ = std::max<size_t>(1, sm_count_ * background_sm_percent / 100);
+
   HCTR_LIB_THROW(cudaDeviceGetAttribute(&cc_major_, cudaDevAttrComputeCapabilityMajor, device_id));
   HCTR_LIB_THROW(cudaDeviceGetAttribute(&cc_minor_, cudaDevAttrComputeCapabilityMinor, device_id));
 }
@@ -66,7 +84,16 @@ GPUResource::GPUResource(int device_id, size_t local_id, size_t global_id,
 GPUResource::~GPUResource() {
   try {
     CudaDeviceContext context(device_id_);
-    HCTR_LIB_THROW(ncclCommDestroy(comm_));
+    if (own_comms_) {
+      HCTR_LIB_THROW(ncclCommDestroy(comm_));
+      if (island_comm_ != nullptr) {
+        HCTR_LIB_THROW(ncclCommDestroy(island_comm_));
+      }
+    }
+    // group communicators are created per resource manager and never cached
+    for (auto& group_comm : group_comms_) {
+      HCTR_LIB_THROW(ncclCommDestroy(group_comm));
+    }
     HCTR_LIB_THROW(curandDestroyGenerator(replica_uniform_curand_generator_));
     HCTR_LIB_THROW(curandDestroyGenerator(replica_variant_curand_generator_));
     HCTR_LIB_THROW(cublasDestroy(cublas_handle_));
@@ -95,4 +122,12 @@ const cudaEvent_t& GPUResource::get_event(const std::string& name) {
   return stream_event_manager_.get_event(name, cudaEventDisableTiming);
 }
 
+size_t GPUResource::get_event_handle(const std::string& name) {
+  return stream_event_manager_.get_event_handle(name, cudaEventDisableTiming);
+}
+
+const cudaEvent_t& GPUResource::get_event(size_t handle) const {
+  return stream_event_manager_.get_event(handle);
+}
+
 }  // namespace HugeCTR
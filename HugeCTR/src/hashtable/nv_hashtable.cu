@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 
+#include <cstdlib>
+
+#include "HugeCTR/include/hashtable/bucketed_hash_map.cuh"
 #include "HugeCTR/include/hashtable/cudf/concurrent_unordered_map.cuh"
 #include "HugeCTR/include/hashtable/nv_hashtable.hpp"
 #include "thrust/pair.h"
@@ -70,6 +73,111 @@ __global__ void get_insert_kernel(Table* table, const typename Table::key_type*
   }
 }
 
+// Contention-aware variant of get_insert_kernel for power-law key distributions: lanes holding
+// the same key are grouped with __match_any_sync, one elected lane walks the table and the rest
+// take the value over a shuffle. A key repeated across a whole warp then costs a single CAS
+// chain instead of 32 colliding ones, and no lane ever spins on a slot whose inserting lane
+// sits in the same warp.
+template <typename Table>
+__global__ void get_insert_dedup_kernel(Table* table, const typename Table::key_type* const keys,
+                                        typename Table::mapped_type* const vals, size_t len,
+                                        size_t* d_counter) {
+  ReplaceOp<typename Table::mapped_type> op;
+  const size_t i = blockIdx.x * blockDim.x + threadIdx.x;
+  const unsigned int active = __ballot_sync(0xffffffffu, i < len);
+  if (i < len) {
+    const typename Table::key_type key = keys[i];
+    const unsigned int group = __match_any_sync(active, key);
+    const int leader = __ffs(group) - 1;
+    typename Table::mapped_type val;
+    if (static_cast<int>(threadIdx.x % warpSize) == leader) {
+      auto it = table->get_insert(key, op, d_counter);
+      assert(it != table->end() && "error: get_insert fails: table is full");
+      val = it->second;
+    }
+    val = __shfl_sync(group, val, leader);
+    vals[i] = val;
+  }
+}
+
+template <typename T>
+__device__ inline T volatile_load(const T* addr) {
+  return *reinterpret_cast<const volatile T*>(addr);
+}
+
+template <typename T>
+__device__ inline T atomic_cas_key(T* addr, T compare, T val) {
+  if constexpr (sizeof(T) == 8) {
+    return (T)atomicCAS(reinterpret_cast<unsigned long long*>(addr), (unsigned long long)compare,
+                        (unsigned long long)val);
+  } else {
+    return (T)atomicCAS(reinterpret_cast<unsigned int*>(addr), (unsigned int)compare,
+                        (unsigned int)val);
+  }
+}
+
+template <typename T>
+__global__ void fill_kernel(T* data, size_t len, T val) {
+  const size_t i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i < len) {
+    data[i] = val;
+  }
+}
+
+// get_insert behind a direct-mapped <key, value> cache, for online-training streams where
+// consecutive batches repeat most of their keys: a cache hit skips the table walk entirely.
+// The cache stays coherent by construction because get_insert never remaps an existing key;
+// only the bulk mutation APIs invalidate it, and they flush the whole cache. All cache accesses
+// are volatile (L2) or atomic, so no SM can see a half-updated slot through its L1.
+template <typename Table>
+__global__ void get_insert_cached_kernel(Table* table, const typename Table::key_type* const keys,
+                                         typename Table::mapped_type* const vals, size_t len,
+                                         size_t* d_counter, typename Table::key_type* cache_keys,
+                                         typename Table::mapped_type* cache_vals,
+                                         size_t num_slots) {
+  using key_type = typename Table::key_type;
+  using mapped_type = typename Table::mapped_type;
+  const key_type empty_key = std::numeric_limits<key_type>::max();
+  const key_type busy_key = empty_key - 1; /**< marks a slot whose value is being rewritten */
+  ReplaceOp<mapped_type> op;
+  const size_t i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i < len) {
+    const key_type key = keys[i];
+    const size_t slot = (static_cast<size_t>(key) * 2654435761ul) % num_slots;
+    // A slot is republished key-last behind a fence, so re-checking the key after taking the
+    // value rejects any concurrent replacement; the same key always maps to the same value.
+    if (volatile_load(cache_keys + slot) == key) {
+      const mapped_type val = volatile_load(cache_vals + slot);
+      // Seqlock validation: the fence orders the value load before the key re-check, pairing
+      // with the writer's fences. Without it the re-check may be serviced first and miss a
+      // concurrent republish, returning another key's value index.
+      __threadfence();
+      if (volatile_load(cache_keys + slot) == key) {
+        vals[i] = val;
+        return;
+      }
+    }
+    auto it = table->get_insert(key, op, d_counter);
+    assert(it != table->end() && "error: get_insert fails: table is full");
+    const mapped_type val = it->second;
+    vals[i] = val;
+    // Single-writer slot update: claim the published key with a CAS, rewrite the value while the
+    // slot reads busy, then republish. Keys that collide with the sentinels are never cached.
+    const key_type cur = volatile_load(cache_keys + slot);
+    if (cur != key && cur != busy_key && key != busy_key && key != empty_key) {
+      if (atomic_cas_key(cache_keys + slot, cur, busy_key) == cur) {
+        // The busy marker must be visible before the value rewrite; atomicCAS does not order the
+        // stores after it, and a value store surfacing while the slot still reads the old key
+        // would slip through both reader key checks.
+        __threadfence();
+        *reinterpret_cast<volatile mapped_type*>(cache_vals + slot) = val;
+        __threadfence();
+        *reinterpret_cast<volatile key_type*>(cache_keys + slot) = key;
+      }
+    }
+  }
+}
+
 template <typename Table>
 __global__ void get_mark_kernel(Table* table, const typename Table::key_type* const keys,
                                 typename Table::mapped_type* const vals, size_t len) {
@@ -172,24 +280,68 @@ class HashTableContainer
             capacity, std::numeric_limits<ValType>::max()) {}
 };
 
+template <typename KeyType, typename ValType>
+class BucketedHashTableContainer
+    : public bucketed_hash_map<KeyType, ValType, std::numeric_limits<KeyType>::max()> {
+ public:
+  BucketedHashTableContainer(size_t capacity)
+      : bucketed_hash_map<KeyType, ValType, std::numeric_limits<KeyType>::max()>(
+            capacity, std::numeric_limits<ValType>::max()) {}
+};
+
 template <typename KeyType, typename ValType>
 HashTable<KeyType, ValType>::HashTable(size_t capacity, size_t count) : capacity_(capacity) {
-  container_ =
-      new HashTableContainer<KeyType, ValType>(static_cast<size_t>(capacity / LOAD_FACTOR));
+  // Opt-in bucketed probing container: its bucket probes stay bounded near full occupancy,
+  // so the slot array can be sized at a >0.9 load factor instead of 0.75.
+  bool use_bucketed = false;
+  if (const char* env = std::getenv("HCTR_BUCKETED_HASHTABLE")) {
+    use_bucketed = std::atoi(env) != 0;
+  }
+  if (const char* env = std::getenv("HCTR_HASHTABLE_WARP_DEDUP")) {
+    warp_dedup_ = std::atoi(env) != 0;
+  }
+  // Opt-in direct-mapped lookup cache in front of get_insert, sized in slots. Worth enabling for
+  // online-training streams where consecutive batches repeat most of their keys.
+  if (const char* env = std::getenv("HCTR_LOOKUP_CACHE_SLOTS")) {
+    lookup_cache_slots_ = std::atoll(env);
+  }
+  if (use_bucketed) {
+    container_ = nullptr;
+    bucketed_container_ = new BucketedHashTableContainer<KeyType, ValType>(
+        static_cast<size_t>(capacity / BUCKETED_LOAD_FACTOR));
+  } else {
+    container_ =
+        new HashTableContainer<KeyType, ValType>(static_cast<size_t>(capacity / LOAD_FACTOR));
+    bucketed_container_ = nullptr;
+  }
 
   // Allocate device-side counter and copy user input to it
   HCTR_LIB_THROW(cudaMalloc((void**)&d_counter_, sizeof(size_t)));
   HCTR_LIB_THROW(cudaMalloc((void**)&d_container_size_, sizeof(size_t)));
   HCTR_LIB_THROW(cudaMemcpy(d_counter_, &count, sizeof(size_t), cudaMemcpyHostToDevice));
+
+  if (lookup_cache_slots_ > 0) {
+    HCTR_LIB_THROW(cudaMalloc((void**)&d_cache_keys_, lookup_cache_slots_ * sizeof(KeyType)));
+    HCTR_LIB_THROW(cudaMalloc((void**)&d_cache_vals_, lookup_cache_slots_ * sizeof(ValType)));
+    flush_lookup_cache(0);
+    HCTR_LIB_THROW(cudaStreamSynchronize(0));
+    HCTR_LOG(INFO, ROOT, "HashTable get_insert lookup cache enabled: %zu slots\n",
+             lookup_cache_slots_);
+  }
 }
 
 template <typename KeyType, typename ValType>
 HashTable<KeyType, ValType>::~HashTable() {
   try {
     delete container_;
+    delete bucketed_container_;
     // De-allocate device-side counter
     HCTR_LIB_THROW(cudaFree(d_counter_));
     HCTR_LIB_THROW(cudaFree(d_container_size_));
+    if (d_cache_keys_ != nullptr) {
+      HCTR_LIB_THROW(cudaFree(d_cache_keys_));
+      HCTR_LIB_THROW(cudaFree(d_cache_vals_));
+    }
   } catch (const std::runtime_error& rt_err) {
     HCTR_LOG_S(ERROR, WORLD) << rt_err.what() << std::endl;
   }
@@ -202,7 +354,12 @@ void HashTable<KeyType, ValType>::insert(const KeyType* d_keys, const ValType* d
     return;
   }
   const int grid_size = (len - 1) / BLOCK_SIZE_ + 1;
-  insert_kernel<<<grid_size, BLOCK_SIZE_, 0, stream>>>(container_, d_keys, d_vals, len);
+  if (bucketed_container_) {
+    insert_kernel<<<grid_size, BLOCK_SIZE_, 0, stream>>>(bucketed_container_, d_keys, d_vals, len);
+  } else {
+    insert_kernel<<<grid_size, BLOCK_SIZE_, 0, stream>>>(container_, d_keys, d_vals, len);
+  }
+  flush_lookup_cache(stream);
 }
 
 template <typename KeyType, typename ValType>
@@ -212,8 +369,41 @@ void HashTable<KeyType, ValType>::get_insert(const KeyType* d_keys, ValType* d_v
     return;
   }
   const int grid_size = (len - 1) / BLOCK_SIZE_ + 1;
-  get_insert_kernel<<<grid_size, BLOCK_SIZE_, 0, stream>>>(container_, d_keys, d_vals, len,
-                                                           d_counter_);
+  if (bucketed_container_) {
+    if (lookup_cache_slots_ > 0) {
+      get_insert_cached_kernel<<<grid_size, BLOCK_SIZE_, 0, stream>>>(
+          bucketed_container_, d_keys, d_vals, len, d_counter_, d_cache_keys_, d_cache_vals_,
+          lookup_cache_slots_);
+    } else if (warp_dedup_) {
+      get_insert_dedup_kernel<<<grid_size, BLOCK_SIZE_, 0, stream>>>(bucketed_container_, d_keys,
+                                                                     d_vals, len, d_counter_);
+    } else {
+      get_insert_kernel<<<grid_size, BLOCK_SIZE_, 0, stream>>>(bucketed_container_, d_keys, d_vals,
+                                                               len, d_counter_);
+    }
+  } else {
+    if (lookup_cache_slots_ > 0) {
+      get_insert_cached_kernel<<<grid_size, BLOCK_SIZE_, 0, stream>>>(
+          container_, d_keys, d_vals, len, d_counter_, d_cache_keys_, d_cache_vals_,
+          lookup_cache_slots_);
+    } else if (warp_dedup_) {
+      get_insert_dedup_kernel<<<grid_size, BLOCK_SIZE_, 0, stream>>>(container_, d_keys, d_vals,
+                                                                     len, d_counter_);
+    } else {
+      get_insert_kernel<<<grid_size, BLOCK_SIZE_, 0, stream>>>(container_, d_keys, d_vals, len,
+                                                               d_counter_);
+    }
+  }
+}
+
+template <typename KeyType, typename ValType>
+void HashTable<KeyType, ValType>::flush_lookup_cache(cudaStream_t stream) {
+  if (lookup_cache_slots_ == 0) {
+    return;
+  }
+  const int grid_size = (lookup_cache_slots_ - 1) / BLOCK_SIZE_ + 1;
+  fill_kernel<<<grid_size, BLOCK_SIZE_, 0, stream>>>(d_cache_keys_, lookup_cache_slots_,
+                                                     std::numeric_limits<KeyType>::max());
 }
 
 template <typename KeyType, typename ValType>
@@ -223,7 +413,12 @@ void HashTable<KeyType, ValType>::get_mark(const KeyType* d_keys, ValType* d_val
     return;
   }
   const int grid_size = (len - 1) / BLOCK_SIZE_ + 1;
-  get_mark_kernel<<<grid_size, BLOCK_SIZE_, 0, stream>>>(container_, d_keys, d_vals, len);
+  if (bucketed_container_) {
+    get_mark_kernel<<<grid_size, BLOCK_SIZE_, 0, stream>>>(bucketed_container_, d_keys, d_vals,
+                                                           len);
+  } else {
+    get_mark_kernel<<<grid_size, BLOCK_SIZE_, 0, stream>>>(container_, d_keys, d_vals, len);
+  }
 }
 
 template <typename KeyType, typename ValType>
@@ -233,7 +428,11 @@ void HashTable<KeyType, ValType>::get(const KeyType* d_keys, ValType* d_vals, si
     return;
   }
   const int grid_size = (len - 1) / BLOCK_SIZE_ + 1;
-  search_kernel<<<grid_size, BLOCK_SIZE_, 0, stream>>>(container_, d_keys, d_vals, len);
+  if (bucketed_container_) {
+    search_kernel<<<grid_size, BLOCK_SIZE_, 0, stream>>>(bucketed_container_, d_keys, d_vals, len);
+  } else {
+    search_kernel<<<grid_size, BLOCK_SIZE_, 0, stream>>>(container_, d_keys, d_vals, len);
+  }
 }
 
 template <typename KeyType, typename ValType>
@@ -241,14 +440,20 @@ size_t HashTable<KeyType, ValType>::get_size(cudaStream_t stream) const {
   /* size variable on Host and device, total capacity of the hashtable */
   size_t container_size;
 
-  const size_t hash_capacity = container_->size();
+  const size_t hash_capacity =
+      bucketed_container_ ? bucketed_container_->size() : container_->size();
 
   /* grid_size and allocating/initializing variable on dev, launching kernel*/
   const int grid_size = (hash_capacity - 1) / BLOCK_SIZE_ + 1;
 
   HCTR_LIB_THROW(cudaMemsetAsync(d_container_size_, 0, sizeof(size_t), stream));
-  size_kernel<<<grid_size, BLOCK_SIZE_, 0, stream>>>(container_, hash_capacity, d_container_size_,
-                                                     empty_key);
+  if (bucketed_container_) {
+    size_kernel<<<grid_size, BLOCK_SIZE_, 0, stream>>>(bucketed_container_, hash_capacity,
+                                                       d_container_size_, empty_key);
+  } else {
+    size_kernel<<<grid_size, BLOCK_SIZE_, 0, stream>>>(container_, hash_capacity, d_container_size_,
+                                                       empty_key);
+  }
   HCTR_LIB_THROW(cudaMemcpyAsync(&container_size, d_container_size_, sizeof(size_t),
                                  cudaMemcpyDeviceToHost, stream));
   HCTR_LIB_THROW(cudaStreamSynchronize(stream));
@@ -268,7 +473,8 @@ size_t HashTable<KeyType, ValType>::get_value_head(cudaStream_t stream) const {
 template <typename KeyType, typename ValType>
 void HashTable<KeyType, ValType>::dump(KeyType* d_key, ValType* d_val, size_t* d_dump_counter,
                                        cudaStream_t stream) const {
-  size_t search_length = static_cast<size_t>(capacity_ / LOAD_FACTOR);
+  size_t search_length = bucketed_container_ ? bucketed_container_->size()
+                                             : static_cast<size_t>(capacity_ / LOAD_FACTOR);
   // Before we call the kernel, set the global counter to 0
   HCTR_LIB_THROW(cudaMemset(d_dump_counter, 0, sizeof(size_t)));
   // grid size according to the searching length.
@@ -276,8 +482,13 @@ void HashTable<KeyType, ValType>::dump(KeyType* d_key, ValType* d_val, size_t* d
   // dump_kernel: dump bucket container_[0, search_length) to d_key and d_val, and report
   // how many buckets are dumped in d_dump_counter.
   size_t shared_size = sizeof(*d_key) * BLOCK_SIZE_ + sizeof(*d_val) * BLOCK_SIZE_;
-  dump_kernel<<<grid_size, BLOCK_SIZE_, shared_size, stream>>>(
-      d_key, d_val, container_, 0, search_length, d_dump_counter, empty_key);
+  if (bucketed_container_) {
+    dump_kernel<<<grid_size, BLOCK_SIZE_, shared_size, stream>>>(
+        d_key, d_val, bucketed_container_, 0, search_length, d_dump_counter, empty_key);
+  } else {
+    dump_kernel<<<grid_size, BLOCK_SIZE_, shared_size, stream>>>(
+        d_key, d_val, container_, 0, search_length, d_dump_counter, empty_key);
+  }
 }
 
 template <typename KeyType, typename ValType>
@@ -287,18 +498,53 @@ void HashTable<KeyType, ValType>::set(const KeyType* d_keys, const ValType* d_va
     return;
   }
   const int grid_size = (len - 1) / BLOCK_SIZE_ + 1;
-  insert_kernel<<<grid_size, BLOCK_SIZE_, 0, stream>>>(container_, d_keys, d_vals, len);
+  if (bucketed_container_) {
+    insert_kernel<<<grid_size, BLOCK_SIZE_, 0, stream>>>(bucketed_container_, d_keys, d_vals, len);
+  } else {
+    insert_kernel<<<grid_size, BLOCK_SIZE_, 0, stream>>>(container_, d_keys, d_vals, len);
+  }
+  flush_lookup_cache(stream);
 }
 
 template <typename KeyType, typename ValType>
 size_t HashTable<KeyType, ValType>::get_capacity() const {
-  return (container_->size());
+  return bucketed_container_ ? bucketed_container_->size() : container_->size();
 }
 
 template <typename KeyType, typename ValType>
 void HashTable<KeyType, ValType>::clear(cudaStream_t stream) {
-  container_->clear_async(stream);
+  if (bucketed_container_) {
+    bucketed_container_->clear_async(stream);
+  } else {
+    container_->clear_async(stream);
+  }
   set_value_head(0, stream);
+  flush_lookup_cache(stream);
+}
+
+template <typename KeyType, typename ValType>
+size_t HashTable<KeyType, ValType>::get_raw_table_bytes() const {
+  if (bucketed_container_) {
+    return bucketed_container_->size() *
+           sizeof(typename BucketedHashTableContainer<KeyType, ValType>::value_type);
+  }
+  return container_->size() * sizeof(typename HashTableContainer<KeyType, ValType>::value_type);
+}
+
+template <typename KeyType, typename ValType>
+void HashTable<KeyType, ValType>::download_raw_table(void* h_dst, size_t offset, size_t num_bytes,
+                                                     cudaStream_t stream) const {
+  const char* src = bucketed_container_ ? (const char*)bucketed_container_->data()
+                                        : (const char*)container_->data();
+  HCTR_LIB_THROW(cudaMemcpyAsync(h_dst, src + offset, num_bytes, cudaMemcpyDeviceToHost, stream));
+}
+
+template <typename KeyType, typename ValType>
+void HashTable<KeyType, ValType>::upload_raw_table(const void* h_src, size_t offset,
+                                                   size_t num_bytes, cudaStream_t stream) {
+  char* dst = bucketed_container_ ? (char*)bucketed_container_->data() : (char*)container_->data();
+  HCTR_LIB_THROW(cudaMemcpyAsync(dst + offset, h_src, num_bytes, cudaMemcpyHostToDevice, stream));
+  flush_lookup_cache(stream);
 }
 
 template class HashTable<unsigned int, size_t>;
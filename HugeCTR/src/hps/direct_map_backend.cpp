@@ -14,6 +14,10 @@
  * limitations under the License.
  */
 
+#include <numa.h>
+#include <numaif.h>
+#include <sys/mman.h>
+
 #include <algorithm>
 #include <atomic>
 #include <base/debug/logger.hpp>
@@ -24,6 +28,13 @@
 #include <hps/hier_parameter_server_base.hpp>
 #include <random>
 
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+#ifndef MAP_HUGE_1GB
+#define MAP_HUGE_1GB (30 << MAP_HUGE_SHIFT)
+#endif
+
 // TODO: Remove me!
 #pragma GCC diagnostic error "-Wconversion"
 
@@ -40,6 +51,13 @@ DirectMapBackend<TKey>::DirectMapBackend(const size_t max_get_batch_size,
   HCTR_LOG_S(DEBUG, WORLD) << "Created blank database backend in local memory!" << std::endl;
 }
 
+template <typename TKey>
+DirectMapBackend<TKey>::~DirectMapBackend() {
+  if (owned_vals_ != nullptr) {
+    munmap(owned_vals_, owned_vals_nbytes_);
+  }
+}
+
 template <typename TPartition>
 size_t DirectMapBackend<TPartition>::size(const std::string& table_name) const {
   HCTR_CHECK_HINT(table_name == single_table_name,
@@ -71,6 +89,92 @@ std::string GetEnv(std::string key) {
 
 }  // namespace
 
+template <typename TKey>
+const char* DirectMapBackend<TKey>::rehost_values(const char* const values, const size_t nbytes) {
+  // Try 1 GiB pages first, then the default hugepage size (typically 2 MiB), then transparent
+  // hugepages on a plain mapping. The explicit sizes require preallocated pools (hugepagesz=1G /
+  // vm.nr_hugepages), so failing over silently is the expected path on unprepared hosts.
+  const char* page_kind = "1 GiB hugepages";
+  size_t page_size = 1ull << 30;
+  owned_vals_nbytes_ = (nbytes + page_size - 1) / page_size * page_size;
+  void* mem = mmap(nullptr, owned_vals_nbytes_, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_HUGE_1GB, -1, 0);
+  if (mem == MAP_FAILED) {
+    page_kind = "default-size hugepages";
+    page_size = 1ull << 21;
+    owned_vals_nbytes_ = (nbytes + page_size - 1) / page_size * page_size;
+    mem = mmap(nullptr, owned_vals_nbytes_, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+  }
+  if (mem == MAP_FAILED) {
+    page_kind = "transparent hugepages";
+    owned_vals_nbytes_ = nbytes;
+    mem = mmap(nullptr, owned_vals_nbytes_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+               -1, 0);
+    HCTR_CHECK_HINT(mem != MAP_FAILED, "unable to map %zu bytes for the value store\n",
+                    owned_vals_nbytes_);
+    madvise(mem, owned_vals_nbytes_, MADV_HUGEPAGE);
+  }
+
+  // The placement policy must be installed before first touch; the copy below faults the pages
+  // in. Default is to interleave the array across all nodes, so that the random fetch traffic
+  // of all sockets shares the aggregate bandwidth; HCTR_DIRECT_MAP_NUMA=bind:<node> pins it.
+  std::string numa_policy = GetEnv("HCTR_DIRECT_MAP_NUMA");
+  if (numa_policy.empty()) {
+    numa_policy = "interleave";
+  }
+  if (numa_available() < 0) {
+    HCTR_LOG_S(WARNING, WORLD) << get_name()
+                               << " backend; NUMA is unavailable, value store placement is left to "
+                                  "the kernel."
+                               << std::endl;
+  } else if (numa_policy.rfind("bind:", 0) == 0) {
+    const int node = std::stoi(numa_policy.substr(5));
+    struct bitmask* nodes = numa_allocate_nodemask();
+    numa_bitmask_setbit(nodes, node);
+    if (mbind(mem, owned_vals_nbytes_, MPOL_BIND, nodes->maskp, nodes->size + 1, 0) != 0) {
+      HCTR_LOG_S(WARNING, WORLD) << get_name() << " backend; mbind to node " << node
+                                 << " failed, value store placement is left to the kernel."
+                                 << std::endl;
+    }
+    numa_bitmask_free(nodes);
+  } else if (numa_policy == "interleave") {
+    if (numa_max_node() > 0 &&
+        mbind(mem, owned_vals_nbytes_, MPOL_INTERLEAVE, numa_all_nodes_ptr->maskp,
+              numa_all_nodes_ptr->size + 1, 0) != 0) {
+      HCTR_LOG_S(WARNING, WORLD) << get_name()
+                                 << " backend; mbind (interleave) failed, value store placement is "
+                                    "left to the kernel."
+                                 << std::endl;
+    }
+  } else {
+    HCTR_LOG_S(WARNING, WORLD) << get_name() << " backend; unknown HCTR_DIRECT_MAP_NUMA policy '"
+                               << numa_policy << "', value store placement is left to the kernel."
+                               << std::endl;
+  }
+
+  // Fault the pages in and fill them with the borrowed values, one chunk per thread.
+  {
+    std::vector<std::future<void>> tasks;
+    tasks.reserve(parallel_level);
+    const size_t chunk = (nbytes + parallel_level - 1) / parallel_level;
+    for (ulong i = 0; i < parallel_level; i++) {
+      tasks.emplace_back(ThreadPool::get().submit([&, i]() {
+        const size_t beg = std::min(nbytes, i * chunk);
+        const size_t end = std::min(nbytes, (i + 1) * chunk);
+        std::memcpy(static_cast<char*>(mem) + beg, values + beg, end - beg);
+      }));
+    }
+    ThreadPool::await(tasks.begin(), tasks.end());
+  }
+
+  HCTR_LOG_S(INFO, WORLD) << get_name() << " backend; rehosted " << nbytes
+                          << " value bytes on " << page_kind << " (NUMA policy: " << numa_policy
+                          << ")." << std::endl;
+  owned_vals_ = static_cast<char*>(mem);
+  return owned_vals_;
+}
+
 template <typename TKey>
 bool DirectMapBackend<TKey>::insert(const std::string& table_name, const size_t num_pairs,
                                     const TKey* const keys, const char* const values,
@@ -89,6 +193,15 @@ bool DirectMapBackend<TKey>::insert(const std::string& table_name, const size_t
     this->option_empty_feat = std::stoull(GetEnv("SAMGRAPH_EMPTY_FEAT"));
   }
 
+  if (GetEnv("HCTR_DIRECT_MAP_HUGEPAGES") == "1") {
+    // With SAMGRAPH_EMPTY_FEAT the source array only backs the wrapped offset range.
+    size_t num_src_rows = num_pairs;
+    if (this->option_empty_feat != 0) {
+      num_src_rows = std::min(num_src_rows, (size_t)1 << this->option_empty_feat);
+    }
+    this->val_ptr = rehost_values(values, num_src_rows * value_size);
+  }
+
   return true;
 }
 
@@ -112,6 +225,11 @@ size_t DirectMapBackend<TKey>::fetch(const std::string& table_name, const size_t
     tasks.emplace_back(ThreadPool::get().submit([&, i]() {
       // Traverse through keys, and fetch them one by one.
       size_t num_batches = 0;
+      // Prefetch cursor that runs ahead of the serving position; the random rows miss in every
+      // cache level, so pulling the next few rows of this partition in early hides the DRAM
+      // latency behind the copy of the current row.
+      const TKey* pf = keys;
+      const ptrdiff_t prefetch_span = 8 * (ptrdiff_t)parallel_level;
       for (const TKey* k = keys; k != keys_end; num_batches++) {
         // Check time budget.
         const auto elapsed = std::chrono::high_resolution_clock::now() - begin;
@@ -120,6 +238,19 @@ size_t DirectMapBackend<TKey>::fetch(const std::string& table_name, const size_t
         size_t batch_size = 0;
         for (; k != keys_end; k++) {
           if ((ulong)(*k) % parallel_level == i) {
+            if (pf <= k) {
+              pf = k + 1;
+            }
+            for (int issued = 0; pf != keys_end && issued < 2 && pf - k < prefetch_span; pf++) {
+              if ((ulong)(*pf) % parallel_level == i) {
+                size_t pf_off = (size_t)(*pf);
+                if (this->option_empty_feat != 0) {
+                  pf_off = pf_off % (1 << this->option_empty_feat);
+                }
+                __builtin_prefetch(this->val_ptr + pf_off * val_len_nbytes, 0, 1);
+                issued++;
+              }
+            }
             size_t src_off = (size_t)(*k);
             if (this->option_empty_feat != 0) {
               src_off = src_off % (1 << this->option_empty_feat);
@@ -169,6 +300,9 @@ size_t DirectMapBackend<TKey>::fetch(const std::string& table_name, const size_t
         for (int partidx = 0; partidx < parallel_level; partidx++) {
           tasks.emplace_back(ThreadPool::get().submit([&]() {
             const size_t* i = indices;
+            // Same prefetch scheme as the direct key fetch above.
+            const size_t* pf = indices;
+            const ptrdiff_t prefetch_span = 8 * (ptrdiff_t)parallel_level;
             for (size_t num_batches = 0; i != indices_end; num_batches++) {
               // Check time budget.
               const auto elapsed = std::chrono::high_resolution_clock::now() - begin;
@@ -177,6 +311,21 @@ size_t DirectMapBackend<TKey>::fetch(const std::string& table_name, const size_t
               for (; i != indices_end; i++) {
                 const TKey& k = keys[*i];
                 if ((ulong)(k) % parallel_level == partidx) {
+                  if (pf <= i) {
+                    pf = i + 1;
+                  }
+                  for (int issued = 0; pf != indices_end && issued < 2 && pf - i < prefetch_span;
+                       pf++) {
+                    const TKey& pf_k = keys[*pf];
+                    if ((ulong)(pf_k) % parallel_level == partidx) {
+                      size_t pf_off = (size_t)(pf_k);
+                      if (this->option_empty_feat != 0) {
+                        pf_off = pf_off % (1 << this->option_empty_feat);
+                      }
+                      __builtin_prefetch(val_ptr + pf_off * val_len_nbytes, 0, 1);
+                      issued++;
+                    }
+                  }
                   size_t src_off = (size_t)(k);
                   if (this->option_empty_feat != 0) {
                     src_off = src_off % (1 << this->option_empty_feat);
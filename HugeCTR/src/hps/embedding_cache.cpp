@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 
+#include <base/debug/perf_counters.hpp>
+#include <chrono>
+#include <cstring>
 #include <hps/embedding_cache.hpp>
 #include <hps/hier_parameter_server.hpp>
 #include <hps/memory_pool.hpp>
@@ -79,6 +82,8 @@ EmbeddingCache<TypeHashKey>::EmbeddingCache(const InferenceParams& inference_par
            inference_params.sparse_model_files.size());
   HCTR_LOG(INFO, ROOT, "Use GPU embedding cache: %s, cache size percentage: %f\n",
            b2s(inference_params.use_gpu_embedding_cache), inference_params.cache_size_percentage);
+  HCTR_LOG(INFO, ROOT, "Use second-level GPU cache: %s, cache size percentage: %f\n",
+           b2s(inference_params.use_l2_gpu_cache), inference_params.l2_cache_size_percentage);
   HCTR_LOG(INFO, ROOT, "Use I64 input key: %s\n", b2s(inference_params.i64_input_key));
   HCTR_LOG(INFO, ROOT, "Configured cache hit rate threshold: %f\n",
            inference_params.hit_rate_threshold);
@@ -101,6 +106,28 @@ EmbeddingCache<TypeHashKey>::EmbeddingCache(const InferenceParams& inference_par
   cache_config_.model_name_ = inference_params.model_name;
   cache_config_.cuda_dev_id_ = inference_params.device_id;
   cache_config_.use_gpu_embedding_cache_ = inference_params.use_gpu_embedding_cache;
+  cache_config_.enable_cache_prefetch_ =
+      inference_params.enable_cache_prefetch && inference_params.use_gpu_embedding_cache;
+  cache_config_.cache_prefetch_interval_ = inference_params.cache_prefetch_interval;
+  cache_config_.use_l2_gpu_embedding_cache_ = inference_params.use_l2_gpu_cache &&
+                                              inference_params.use_gpu_embedding_cache &&
+                                              inference_params.l2_cache_size_percentage > 0;
+  cache_config_.l2_cache_size_percentage_ = inference_params.l2_cache_size_percentage;
+
+  // Resolve the GPU cache set associativity per table. Tables without a configured value use the
+  // 2-way default.
+  cache_config_.set_associativity_per_table_.reserve(cache_config_.num_emb_table_);
+  for (size_t i = 0; i < cache_config_.num_emb_table_; i++) {
+    const size_t set_associativity = i < inference_params.gpu_cache_set_associativity.size()
+                                         ? inference_params.gpu_cache_set_associativity[i]
+                                         : SET_ASSOCIATIVITY;
+    if (set_associativity != 2 && set_associativity != 4 && set_associativity != 8 &&
+        set_associativity != 16) {
+      HCTR_OWN_THROW(Error_t::WrongInput,
+                     "gpucache_set_associativity entries must be one of {2, 4, 8, 16}");
+    }
+    cache_config_.set_associativity_per_table_.emplace_back(set_associativity);
+  }
 
   if (ps_config.embedding_vec_size_.find(inference_params.model_name) ==
           ps_config.embedding_vec_size_.end() ||
@@ -141,9 +168,17 @@ EmbeddingCache<TypeHashKey>::EmbeddingCache(const InferenceParams& inference_par
       }
       const size_t num_feature_in_cache = static_cast<size_t>(
           static_cast<double>(cache_config_.cache_size_percentage_) * static_cast<double>(row_num));
+      const size_t num_feature_per_set =
+          SLAB_SIZE * cache_config_.set_associativity_per_table_[i];
       cache_config_.num_set_in_cache_.emplace_back(
-          (num_feature_in_cache + SLAB_SIZE * SET_ASSOCIATIVITY - 1) /
-          (SLAB_SIZE * SET_ASSOCIATIVITY));
+          (num_feature_in_cache + num_feature_per_set - 1) / num_feature_per_set);
+      if (cache_config_.use_l2_gpu_embedding_cache_) {
+        const size_t num_feature_in_l2_cache =
+            static_cast<size_t>(static_cast<double>(cache_config_.l2_cache_size_percentage_) *
+                                static_cast<double>(row_num));
+        cache_config_.num_set_in_l2_cache_.emplace_back(std::max<size_t>(
+            1, (num_feature_in_l2_cache + num_feature_per_set - 1) / num_feature_per_set));
+      }
     }
   }
 
@@ -156,8 +191,22 @@ EmbeddingCache<TypeHashKey>::EmbeddingCache(const InferenceParams& inference_par
     // Allocate resources.
     gpu_emb_caches_.reserve(cache_config_.num_emb_table_);
     for (size_t i = 0; i < cache_config_.num_emb_table_; i++) {
-      gpu_emb_caches_.emplace_back(std::make_unique<Cache>(cache_config_.num_set_in_cache_[i],
-                                                           cache_config_.embedding_vec_size_[i]));
+      gpu_emb_caches_.emplace_back(
+          gpu_cache::create_gpu_cache<TypeHashKey, uint64_t,
+                                      std::numeric_limits<TypeHashKey>::max(), SLAB_SIZE>(
+              cache_config_.set_associativity_per_table_[i], cache_config_.num_set_in_cache_[i],
+              cache_config_.embedding_vec_size_[i]));
+    }
+
+    if (cache_config_.use_l2_gpu_embedding_cache_) {
+      gpu_l2_emb_caches_.reserve(cache_config_.num_emb_table_);
+      for (size_t i = 0; i < cache_config_.num_emb_table_; i++) {
+        gpu_l2_emb_caches_.emplace_back(
+            gpu_cache::create_gpu_cache<TypeHashKey, uint64_t,
+                                        std::numeric_limits<TypeHashKey>::max(), SLAB_SIZE>(
+                cache_config_.set_associativity_per_table_[i],
+                cache_config_.num_set_in_l2_cache_[i], cache_config_.embedding_vec_size_[i]));
+      }
     }
 
     insert_streams_.reserve(cache_config_.num_emb_table_);
@@ -173,11 +222,46 @@ EmbeddingCache<TypeHashKey>::EmbeddingCache(const InferenceParams& inference_par
       cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking);
       refresh_streams_.push_back(stream);
     }
+
+    for (size_t id = 0; id < cache_config_.num_emb_table_; id++) {
+      const std::string labels = "{model=\"" + cache_config_.model_name_ + "\",device=\"" +
+                                 std::to_string(cache_config_.cuda_dev_id_) + "\",table=\"" +
+                                 cache_config_.embedding_table_name_[id] + "\"}";
+      perf_queries_.push_back(
+          &PerfCounters::get().counter("hugectr_embedding_cache_queries_total" + labels));
+      perf_misses_.push_back(
+          &PerfCounters::get().counter("hugectr_embedding_cache_misses_total" + labels));
+      perf_evictions_.push_back(
+          &PerfCounters::get().counter("hugectr_embedding_cache_evictions_total" + labels));
+      if (cache_config_.use_l2_gpu_embedding_cache_) {
+        perf_l2_queries_.push_back(
+            &PerfCounters::get().counter("hugectr_embedding_cache_l2_queries_total" + labels));
+        perf_l2_misses_.push_back(
+            &PerfCounters::get().counter("hugectr_embedding_cache_l2_misses_total" + labels));
+        perf_l2_evictions_.push_back(
+            &PerfCounters::get().counter("hugectr_embedding_cache_l2_evictions_total" + labels));
+      }
+    }
+    HCTR_LIB_THROW(cudaHostAlloc(reinterpret_cast<void**>(&h_evict_counts_),
+                                 2 * cache_config_.num_emb_table_ * sizeof(size_t),
+                                 cudaHostAllocPortable));
+    memset(h_evict_counts_, 0, 2 * cache_config_.num_emb_table_ * sizeof(size_t));
+    last_evict_counts_.assign(2 * cache_config_.num_emb_table_, 0);
+  }
+
+  // Spawn the query-history-driven prefetch worker.
+  if (cache_config_.enable_cache_prefetch_) {
+    query_history_.resize(cache_config_.num_emb_table_);
+    prefetch_worker_ = std::thread(&EmbeddingCache<TypeHashKey>::prefetcher_loop_, this);
   }
 }
 
 template <typename TypeHashKey>
 EmbeddingCache<TypeHashKey>::~EmbeddingCache() {
+  if (prefetch_worker_.joinable()) {
+    prefetch_terminate_ = true;
+    prefetch_worker_.join();
+  }
   if (cache_config_.use_gpu_embedding_cache_) {
     // Swap device.
     CudaDeviceContext dev_restorer;
@@ -191,6 +275,8 @@ EmbeddingCache<TypeHashKey>::~EmbeddingCache() {
       cudaStreamDestroy(stream);
     }
     refresh_streams_.clear();
+    cudaFreeHost(h_evict_counts_);
+    h_evict_counts_ = nullptr;
   }
 }
 
@@ -198,13 +284,18 @@ template <typename TypeHashKey>
 void EmbeddingCache<TypeHashKey>::lookup(size_t const table_id, float* const d_vectors,
                                          const void* const h_keys, size_t const num_keys,
                                          float const hit_rate_threshold, cudaStream_t stream) {
+  const auto lookup_start = std::chrono::steady_clock::now();
   MemoryBlock* memory_block = nullptr;
   while (memory_block == nullptr) {
     memory_block = reinterpret_cast<MemoryBlock*>(parameter_server_->apply_buffer(
         cache_config_.model_name_, cache_config_.cuda_dev_id_, CACHE_SPACE_TYPE::WORKER));
   }
   EmbeddingCacheWorkspace workspace_handler = memory_block->worker_buffer;
+  if (cache_config_.enable_cache_prefetch_) {
+    record_query_history_(table_id, h_keys, num_keys);
+  }
   if (cache_config_.use_gpu_embedding_cache_) {
+    std::shared_lock<std::shared_mutex> resize_lock(cache_resize_mutex_);
     // Swap device.
     CudaDeviceContext dev_restorer;
     HCTR_LIB_THROW(cudaSetDevice(cache_config_.cuda_dev_id_));
@@ -239,6 +330,65 @@ void EmbeddingCache<TypeHashKey>::lookup(size_t const table_id, float* const d_v
                                    cudaMemcpyDeviceToHost, stream));
     // Set async flag
     HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+
+    // Consult the second GPU cache tier for the keys the first tier missed, so that only keys
+    // missed by both tiers have to travel across PCIe to the parameter server.
+    if (cache_config_.use_l2_gpu_embedding_cache_ &&
+        workspace_handler.h_missing_length_[table_id] > 0) {
+      const size_t l1_missing_length = workspace_handler.h_missing_length_[table_id];
+      const size_t l2_task_per_warp_tile = (l1_missing_length < 1000000) ? 1 : 32;
+      gpu_l2_emb_caches_[table_id]->Query(
+          static_cast<TypeHashKey*>(workspace_handler.d_missing_embeddingcolumns_[table_id]),
+          l1_missing_length, workspace_handler.d_l2_hit_emb_vec_[table_id],
+          workspace_handler.d_l2_missing_index_[table_id],
+          static_cast<TypeHashKey*>(workspace_handler.d_l2_missing_embeddingcolumns_[table_id]),
+          workspace_handler.d_l2_missing_length_ + table_id, stream, l2_task_per_warp_tile);
+      HCTR_LIB_THROW(cudaMemcpyAsync(workspace_handler.h_l2_missing_length_ + table_id,
+                                     workspace_handler.d_l2_missing_length_ + table_id,
+                                     sizeof(size_t), cudaMemcpyDeviceToHost, stream));
+      HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+      const size_t l2_missing_length = workspace_handler.h_l2_missing_length_[table_id];
+
+      if (!perf_l2_queries_.empty()) {
+        perf_l2_queries_[table_id]->fetch_add(l1_missing_length, std::memory_order_relaxed);
+        perf_l2_misses_[table_id]->fetch_add(l2_missing_length, std::memory_order_relaxed);
+      }
+
+      // Slots missed by both tiers get the default value; the synchronous path below overwrites
+      // them with the parameter-server results.
+      fill_default_emb_vec_async(workspace_handler.d_l2_hit_emb_vec_[table_id],
+                                 cache_config_.default_value_for_each_table[table_id],
+                                 workspace_handler.d_l2_missing_index_[table_id], l2_missing_length,
+                                 cache_config_.embedding_vec_size_[table_id], BLOCK_SIZE_, stream);
+      merge_emb_vec_async(workspace_handler.d_hit_emb_vec_[table_id],
+                          workspace_handler.d_l2_hit_emb_vec_[table_id],
+                          workspace_handler.d_missing_index_[table_id], l1_missing_length,
+                          cache_config_.embedding_vec_size_[table_id], BLOCK_SIZE_, stream);
+
+      // Shrink the miss set to the keys both tiers missed and re-index it into the hit buffer, so
+      // the regular miss handling below only touches the parameter server for true misses.
+      compose_missing_index_async(workspace_handler.d_missing_index_[table_id],
+                                  workspace_handler.d_l2_missing_index_[table_id],
+                                  l2_missing_length, BLOCK_SIZE_, stream);
+      HCTR_LIB_THROW(cudaMemcpyAsync(workspace_handler.d_missing_embeddingcolumns_[table_id],
+                                     workspace_handler.d_l2_missing_embeddingcolumns_[table_id],
+                                     l2_missing_length * sizeof(TypeHashKey),
+                                     cudaMemcpyDeviceToDevice, stream));
+      HCTR_LIB_THROW(cudaMemcpyAsync(workspace_handler.d_missing_index_[table_id],
+                                     workspace_handler.d_l2_missing_index_[table_id],
+                                     l2_missing_length * sizeof(uint64_t),
+                                     cudaMemcpyDeviceToDevice, stream));
+      HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+      workspace_handler.h_missing_length_[table_id] = l2_missing_length;
+    }
+
+    num_unique_queries_ += workspace_handler.h_unique_length_[table_id];
+    num_lookup_misses_ += workspace_handler.h_missing_length_[table_id];
+    perf_queries_[table_id]->fetch_add(workspace_handler.h_unique_length_[table_id],
+                                       std::memory_order_relaxed);
+    perf_misses_[table_id]->fetch_add(workspace_handler.h_missing_length_[table_id],
+                                      std::memory_order_relaxed);
+
     if (workspace_handler.h_unique_length_[table_id] == 0) {
       workspace_handler.h_hit_rate_[table_id] = 1.0;
     } else {
@@ -305,6 +455,14 @@ void EmbeddingCache<TypeHashKey>::lookup(size_t const table_id, float* const d_v
     HCTR_LIB_THROW(cudaStreamSynchronize(stream));
     parameter_server_->free_buffer(memory_block);
   }
+
+  // EWMA with 1/8 weight; relaxed ordering is fine, the value only paces refresh sweeps
+  const uint64_t lookup_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                                 std::chrono::steady_clock::now() - lookup_start)
+                                 .count();
+  const uint64_t prev = lookup_latency_ewma_us_.load(std::memory_order_relaxed);
+  lookup_latency_ewma_us_.store(prev == 0 ? lookup_us : (prev * 7 + lookup_us) / 8,
+                                std::memory_order_relaxed);
 }
 
 template <typename TypeHashKey>
@@ -313,6 +471,7 @@ void EmbeddingCache<TypeHashKey>::insert(const size_t table_id,
                                          cudaStream_t stream) {
   // If GPU embedding cache is enabled
   if (cache_config_.use_gpu_embedding_cache_) {
+    std::shared_lock<std::shared_mutex> resize_lock(cache_resize_mutex_);
     // Swap device.
     CudaDeviceContext dev_restorer;
     HCTR_LIB_THROW(cudaSetDevice(cache_config_.cuda_dev_id_));
@@ -320,6 +479,29 @@ void EmbeddingCache<TypeHashKey>::insert(const size_t table_id,
         static_cast<TypeHashKey*>(workspace_handler.d_missing_embeddingcolumns_[table_id]),
         workspace_handler.h_missing_length_[table_id],
         workspace_handler.d_missing_emb_vec_[table_id], stream);
+    if (cache_config_.use_l2_gpu_embedding_cache_) {
+      gpu_l2_emb_caches_[table_id]->Replace(
+          static_cast<TypeHashKey*>(workspace_handler.d_missing_embeddingcolumns_[table_id]),
+          workspace_handler.h_missing_length_[table_id],
+          workspace_handler.d_missing_emb_vec_[table_id], stream);
+    }
+
+    // Eviction accounting: publish the delta of the previous async readback, then snapshot the
+    // device counter again behind this Replace. One 8-byte D2H copy per insert keeps the
+    // overhead negligible; the published counters trail the cache by at most one insert.
+    const size_t l1_seen = h_evict_counts_[table_id];
+    perf_evictions_[table_id]->fetch_add(l1_seen - last_evict_counts_[table_id],
+                                         std::memory_order_relaxed);
+    last_evict_counts_[table_id] = l1_seen;
+    gpu_emb_caches_[table_id]->ReadEvictionCount(h_evict_counts_ + table_id, stream);
+    if (cache_config_.use_l2_gpu_embedding_cache_) {
+      const size_t l2_slot = cache_config_.num_emb_table_ + table_id;
+      const size_t l2_seen = h_evict_counts_[l2_slot];
+      perf_l2_evictions_[table_id]->fetch_add(l2_seen - last_evict_counts_[l2_slot],
+                                              std::memory_order_relaxed);
+      last_evict_counts_[l2_slot] = l2_seen;
+      gpu_l2_emb_caches_[table_id]->ReadEvictionCount(h_evict_counts_ + l2_slot, stream);
+    }
   }
 }
 
@@ -329,12 +511,18 @@ void EmbeddingCache<TypeHashKey>::init(const size_t table_id,
                                        cudaStream_t stream) {
   // If GPU embedding cache is enabled
   if (cache_config_.use_gpu_embedding_cache_) {
+    std::shared_lock<std::shared_mutex> resize_lock(cache_resize_mutex_);
     // Swap device.
     CudaDeviceContext dev_restorer;
     HCTR_LIB_THROW(cudaSetDevice(cache_config_.cuda_dev_id_));
     gpu_emb_caches_[table_id]->Replace(
         static_cast<TypeHashKey*>(refeshspace_handler.d_refresh_embeddingcolumns_),
         *refeshspace_handler.h_length_, refeshspace_handler.d_refresh_emb_vec_, stream);
+    if (cache_config_.use_l2_gpu_embedding_cache_) {
+      gpu_l2_emb_caches_[table_id]->Replace(
+          static_cast<TypeHashKey*>(refeshspace_handler.d_refresh_embeddingcolumns_),
+          *refeshspace_handler.h_length_, refeshspace_handler.d_refresh_emb_vec_, stream);
+    }
   }
 }
 
@@ -344,6 +532,7 @@ void EmbeddingCache<TypeHashKey>::dump(const size_t table_id, void* const d_keys
                                        const size_t end_index, cudaStream_t stream) {
   // If GPU embedding cache is enabled
   if (cache_config_.use_gpu_embedding_cache_) {
+    std::shared_lock<std::shared_mutex> resize_lock(cache_resize_mutex_);
     // Check for corner case
     if (start_index >= cache_config_.num_set_in_cache_[table_id]) {
       HCTR_OWN_THROW(Error_t::WrongInput, "Error: Invalid value for start_index.");
@@ -366,6 +555,7 @@ void EmbeddingCache<TypeHashKey>::refresh(const size_t table_id, const void* con
                                           cudaStream_t stream) {
   // If GPU embedding cache is enabled
   if (cache_config_.use_gpu_embedding_cache_) {
+    std::shared_lock<std::shared_mutex> resize_lock(cache_resize_mutex_);
     // Check for corner case
     if (length == 0) {
       return;
@@ -376,11 +566,217 @@ void EmbeddingCache<TypeHashKey>::refresh(const size_t table_id, const void* con
     // Call GPU cache API
     gpu_emb_caches_[table_id]->Update(static_cast<const TypeHashKey*>(d_keys), length, d_vectors,
                                       stream, SLAB_SIZE);
+    if (cache_config_.use_l2_gpu_embedding_cache_) {
+      gpu_l2_emb_caches_[table_id]->Update(static_cast<const TypeHashKey*>(d_keys), length,
+                                           d_vectors, stream, SLAB_SIZE);
+    }
+  }
+}
+
+template <typename TypeHashKey>
+std::pair<size_t, size_t> EmbeddingCache<TypeHashKey>::get_and_reset_lookup_stats() {
+  return {num_unique_queries_.exchange(0), num_lookup_misses_.exchange(0)};
+}
+
+template <typename TypeHashKey>
+void EmbeddingCache<TypeHashKey>::resize(const float cache_size_percentage) {
+  if (!cache_config_.use_gpu_embedding_cache_ || cache_size_percentage <= 0.f ||
+      cache_size_percentage == cache_config_.cache_size_percentage_) {
+    return;
+  }
+  try {
+    // Swap device.
+    CudaDeviceContext dev_restorer;
+    HCTR_LIB_THROW(cudaSetDevice(cache_config_.cuda_dev_id_));
+    cudaStream_t stream;
+    HCTR_LIB_THROW(cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking));
+
+    const double scale =
+        static_cast<double>(cache_size_percentage) / cache_config_.cache_size_percentage_;
+    for (size_t i = 0; i < cache_config_.num_emb_table_; i++) {
+      const size_t old_num_set = cache_config_.num_set_in_cache_[i];
+      const size_t new_num_set = std::max<size_t>(1, old_num_set * scale);
+      if (new_num_set == old_num_set) {
+        continue;
+      }
+      auto new_cache =
+          gpu_cache::create_gpu_cache<TypeHashKey, uint64_t,
+                                      std::numeric_limits<TypeHashKey>::max(), SLAB_SIZE>(
+              cache_config_.set_associativity_per_table_[i], new_num_set,
+              cache_config_.embedding_vec_size_[i]);
+
+      // Migration buffers for one dump chunk. The chunk is bounded so the value buffer stays
+      // small even for wide embedding vectors.
+      const size_t keys_per_set = SLAB_SIZE * cache_config_.set_associativity_per_table_[i];
+      const size_t chunk_num_set = std::max<size_t>(1, 65536 / keys_per_set);
+      const size_t chunk_capacity = chunk_num_set * keys_per_set;
+      TypeHashKey* d_keys;
+      TypeHashKey* d_missing_keys;
+      float* d_values;
+      uint64_t* d_missing_index;
+      size_t* d_lengths;
+      HCTR_LIB_THROW(cudaMalloc((void**)&d_keys, chunk_capacity * sizeof(TypeHashKey)));
+      HCTR_LIB_THROW(cudaMalloc((void**)&d_missing_keys, chunk_capacity * sizeof(TypeHashKey)));
+      HCTR_LIB_THROW(cudaMalloc(
+          (void**)&d_values,
+          chunk_capacity * cache_config_.embedding_vec_size_[i] * sizeof(float)));
+      HCTR_LIB_THROW(cudaMalloc((void**)&d_missing_index, chunk_capacity * sizeof(uint64_t)));
+      HCTR_LIB_THROW(cudaMalloc((void**)&d_lengths, 2 * sizeof(size_t)));
+
+      // Carry the resident entries over chunk by chunk with the Dump/Query/Replace machinery.
+      // Lookups are held off for this table's migration only; a shrinking cache simply evicts
+      // the overflow during Replace.
+      std::unique_lock<std::shared_mutex> resize_lock(cache_resize_mutex_);
+      for (size_t set_idx = 0; set_idx < old_num_set; set_idx += chunk_num_set) {
+        const size_t end_set = std::min(old_num_set, set_idx + chunk_num_set);
+        gpu_emb_caches_[i]->Dump(d_keys, d_lengths, set_idx, end_set, stream);
+        size_t h_lengths[2];
+        HCTR_LIB_THROW(cudaMemcpyAsync(h_lengths, d_lengths, sizeof(size_t),
+                                       cudaMemcpyDeviceToHost, stream));
+        HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+        if (h_lengths[0] == 0) {
+          continue;
+        }
+        gpu_emb_caches_[i]->Query(d_keys, h_lengths[0], d_values, d_missing_index, d_missing_keys,
+                                  d_lengths + 1, stream);
+        HCTR_LIB_THROW(cudaMemcpyAsync(h_lengths + 1, d_lengths + 1, sizeof(size_t),
+                                       cudaMemcpyDeviceToHost, stream));
+        HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+        // The dumped keys are resident by definition and nothing can evict them while the
+        // exclusive lock is held, so a non-empty miss set should not happen; skip the chunk
+        // rather than inserting unmatched values.
+        if (h_lengths[1] != 0) {
+          continue;
+        }
+        new_cache->Replace(d_keys, h_lengths[0], d_values, stream);
+        HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+      }
+      gpu_emb_caches_[i] = std::move(new_cache);
+      cache_config_.num_set_in_cache_[i] = new_num_set;
+      resize_lock.unlock();
+
+      HCTR_LIB_THROW(cudaFree(d_keys));
+      HCTR_LIB_THROW(cudaFree(d_missing_keys));
+      HCTR_LIB_THROW(cudaFree(d_values));
+      HCTR_LIB_THROW(cudaFree(d_missing_index));
+      HCTR_LIB_THROW(cudaFree(d_lengths));
+    }
+    HCTR_LIB_THROW(cudaStreamDestroy(stream));
+
+    HCTR_LOG_S(INFO, WORLD) << "Resized the GPU embedding cache of model "
+                            << cache_config_.model_name_ << " on device "
+                            << cache_config_.cuda_dev_id_ << " from "
+                            << cache_config_.cache_size_percentage_ << " to "
+                            << cache_size_percentage << std::endl;
+    cache_config_.cache_size_percentage_ = cache_size_percentage;
+  } catch (const std::runtime_error& rt_err) {
+    HCTR_LOG_S(ERROR, WORLD) << rt_err.what() << std::endl;
+    throw;
+  }
+}
+
+template <typename TypeHashKey>
+void EmbeddingCache<TypeHashKey>::record_query_history_(const size_t table_id,
+                                                        const void* const h_keys,
+                                                        const size_t num_keys) {
+  const TypeHashKey* const keys = static_cast<const TypeHashKey*>(h_keys);
+
+  std::lock_guard<std::mutex> lock(history_mutex_);
+  std::unordered_map<TypeHashKey, uint32_t>& freqs = query_history_[table_id];
+  for (size_t i = 0; i < num_keys; i++) {
+    freqs[keys[i]]++;
+  }
+}
+
+template <typename TypeHashKey>
+void EmbeddingCache<TypeHashKey>::prefetcher_loop_() {
+  const auto interval = std::chrono::duration<float>(cache_config_.cache_prefetch_interval_);
+
+  while (!prefetch_terminate_) {
+    std::this_thread::sleep_for(interval);
+    if (prefetch_terminate_) {
+      break;
+    }
+
+    for (size_t table_id = 0; table_id < cache_config_.num_emb_table_; table_id++) {
+      // Drain rising keys from the sliding-window frequency sketch. Aging the counts makes keys
+      // that stopped being queried fade out, so the sketch tracks hot-key drift.
+      std::vector<TypeHashKey> hot_keys;
+      {
+        std::lock_guard<std::mutex> lock(history_mutex_);
+        std::unordered_map<TypeHashKey, uint32_t>& freqs = query_history_[table_id];
+        for (auto it = freqs.begin(); it != freqs.end();) {
+          if (it->second >= PREFETCH_HOT_THRESHOLD_) {
+            hot_keys.push_back(it->first);
+          }
+          it->second /= 2;
+          if (it->second) {
+            ++it;
+          } else {
+            it = freqs.erase(it);
+          }
+        }
+      }
+      if (hot_keys.empty()) {
+        continue;
+      }
+      const size_t capacity = SLAB_SIZE * cache_config_.set_associativity_per_table_[table_id] *
+                              cache_config_.num_set_in_refresh_workspace_;
+      if (!capacity) {
+        continue;
+      }
+      if (hot_keys.size() > capacity) {
+        hot_keys.resize(capacity);
+      }
+
+      // Single attempt; if all refresh buffers are busy, just try again next round.
+      MemoryBlock* const memory_block = reinterpret_cast<MemoryBlock*>(parameter_server_->apply_buffer(
+          cache_config_.model_name_, cache_config_.cuda_dev_id_, CACHE_SPACE_TYPE::REFRESHER));
+      if (!memory_block) {
+        continue;
+      }
+      EmbeddingCacheRefreshspace refreshspace_handler = memory_block->refresh_buffer;
+      try {
+        // Swap device.
+        CudaDeviceContext dev_restorer;
+        HCTR_LIB_THROW(cudaSetDevice(cache_config_.cuda_dev_id_));
+        cudaStream_t stream = refresh_streams_[table_id];
+
+        // Fetch the rising keys from the parameter server and push them into the GPU cache via
+        // the regular refresh machinery, entirely off the lookup critical path.
+        std::memcpy(refreshspace_handler.h_refresh_embeddingcolumns_, hot_keys.data(),
+                    hot_keys.size() * sizeof(TypeHashKey));
+        parameter_server_->lookup(refreshspace_handler.h_refresh_embeddingcolumns_, hot_keys.size(),
+                                  refreshspace_handler.h_refresh_emb_vec_, cache_config_.model_name_,
+                                  table_id);
+        HCTR_LIB_THROW(cudaMemcpyAsync(refreshspace_handler.d_refresh_embeddingcolumns_,
+                                       refreshspace_handler.h_refresh_embeddingcolumns_,
+                                       hot_keys.size() * sizeof(TypeHashKey),
+                                       cudaMemcpyHostToDevice, stream));
+        HCTR_LIB_THROW(cudaMemcpyAsync(
+            refreshspace_handler.d_refresh_emb_vec_, refreshspace_handler.h_refresh_emb_vec_,
+            hot_keys.size() * cache_config_.embedding_vec_size_[table_id] * sizeof(float),
+            cudaMemcpyHostToDevice, stream));
+        refresh(table_id, refreshspace_handler.d_refresh_embeddingcolumns_,
+                refreshspace_handler.d_refresh_emb_vec_, hot_keys.size(), stream);
+        HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+
+        HCTR_LOG_S(TRACE, WORLD) << "Prefetched " << hot_keys.size() << " hot keys into table "
+                                 << table_id << " of the GPU embedding cache." << std::endl;
+      } catch (const std::runtime_error& rt_err) {
+        HCTR_LOG_S(ERROR, WORLD) << rt_err.what() << std::endl;
+      }
+      parameter_server_->free_buffer(memory_block);
+    }
   }
 }
 
 template <typename TypeHashKey>
 void EmbeddingCache<TypeHashKey>::finalize() {
+  if (prefetch_worker_.joinable()) {
+    prefetch_terminate_ = true;
+    prefetch_worker_.join();
+  }
   if (cache_config_.use_gpu_embedding_cache_) {
     std::lock_guard<std::mutex> lock(mutex_);
 
@@ -414,6 +810,7 @@ EmbeddingCacheWorkspace EmbeddingCache<TypeHashKey>::create_workspace() {
   }
   // If GPU embedding cache is enabled.
   workspace_handler.use_gpu_embedding_cache_ = cache_config_.use_gpu_embedding_cache_;
+  workspace_handler.use_l2_gpu_embedding_cache_ = cache_config_.use_l2_gpu_embedding_cache_;
   if (cache_config_.use_gpu_embedding_cache_) {
     CudaDeviceContext dev_restorer;
     HCTR_LIB_THROW(cudaSetDevice(cache_config_.cuda_dev_id_));
@@ -466,6 +863,26 @@ EmbeddingCacheWorkspace EmbeddingCache<TypeHashKey>::create_workspace() {
                                     cache_config_.embedding_vec_size_[i] * sizeof(float)));
       workspace_handler.d_missing_emb_vec_.push_back(d_missing_emb_vec);
 
+      if (cache_config_.use_l2_gpu_embedding_cache_) {
+        float* d_l2_hit_emb_vec;
+        HCTR_LIB_THROW(cudaMalloc(reinterpret_cast<void**>(&d_l2_hit_emb_vec),
+                                  cache_config_.max_query_len_per_emb_table_[i] *
+                                      cache_config_.embedding_vec_size_[i] * sizeof(float)));
+        workspace_handler.d_l2_hit_emb_vec_.push_back(d_l2_hit_emb_vec);
+
+        void* d_l2_missing_embeddingcolumns;
+        HCTR_LIB_THROW(
+            cudaMalloc(&d_l2_missing_embeddingcolumns,
+                       cache_config_.max_query_len_per_emb_table_[i] * sizeof(TypeHashKey)));
+        workspace_handler.d_l2_missing_embeddingcolumns_.push_back(d_l2_missing_embeddingcolumns);
+
+        uint64_t* d_l2_missing_index;
+        HCTR_LIB_THROW(
+            cudaMalloc(reinterpret_cast<void**>(&d_l2_missing_index),
+                       cache_config_.max_query_len_per_emb_table_[i] * sizeof(uint64_t)));
+        workspace_handler.d_l2_missing_index_.push_back(d_l2_missing_index);
+      }
+
       const size_t capacity = static_cast<size_t>(cache_config_.max_query_len_per_emb_table_[i] /
                                                   UNIQUE_OP_LOAD_FACTOR);
       workspace_handler.unique_op_obj_.push_back(new UniqueOp(capacity));
@@ -483,6 +900,13 @@ EmbeddingCacheWorkspace EmbeddingCache<TypeHashKey>::create_workspace() {
     HCTR_LIB_THROW(cudaHostAlloc(reinterpret_cast<void**>(&workspace_handler.h_hit_rate_),
                                  cache_config_.num_emb_table_ * sizeof(double),
                                  cudaHostAllocPortable));
+    if (cache_config_.use_l2_gpu_embedding_cache_) {
+      HCTR_LIB_THROW(cudaMalloc(reinterpret_cast<void**>(&workspace_handler.d_l2_missing_length_),
+                                cache_config_.num_emb_table_ * sizeof(size_t)));
+      HCTR_LIB_THROW(
+          cudaHostAlloc(reinterpret_cast<void**>(&workspace_handler.h_l2_missing_length_),
+                        cache_config_.num_emb_table_ * sizeof(size_t), cudaHostAllocPortable));
+    }
   }
   return workspace_handler;
 }
@@ -519,6 +943,14 @@ void EmbeddingCache<TypeHashKey>::destroy_workspace(EmbeddingCacheWorkspace& wor
       workspace_handler.d_missing_index_[i] = nullptr;
       HCTR_LIB_THROW(cudaFree(workspace_handler.d_missing_emb_vec_[i]));
       workspace_handler.d_missing_emb_vec_[i] = nullptr;
+      if (cache_config_.use_l2_gpu_embedding_cache_) {
+        HCTR_LIB_THROW(cudaFree(workspace_handler.d_l2_hit_emb_vec_[i]));
+        workspace_handler.d_l2_hit_emb_vec_[i] = nullptr;
+        HCTR_LIB_THROW(cudaFree(workspace_handler.d_l2_missing_embeddingcolumns_[i]));
+        workspace_handler.d_l2_missing_embeddingcolumns_[i] = nullptr;
+        HCTR_LIB_THROW(cudaFree(workspace_handler.d_l2_missing_index_[i]));
+        workspace_handler.d_l2_missing_index_[i] = nullptr;
+      }
       delete static_cast<UniqueOp*>(workspace_handler.unique_op_obj_[i]);
     }
 
@@ -532,6 +964,12 @@ void EmbeddingCache<TypeHashKey>::destroy_workspace(EmbeddingCacheWorkspace& wor
     workspace_handler.h_missing_length_ = nullptr;
     HCTR_LIB_THROW(cudaFreeHost(workspace_handler.h_hit_rate_));
     workspace_handler.h_hit_rate_ = nullptr;
+    if (cache_config_.use_l2_gpu_embedding_cache_) {
+      HCTR_LIB_THROW(cudaFree(workspace_handler.d_l2_missing_length_));
+      workspace_handler.d_l2_missing_length_ = nullptr;
+      HCTR_LIB_THROW(cudaFreeHost(workspace_handler.h_l2_missing_length_));
+      workspace_handler.h_l2_missing_length_ = nullptr;
+    }
   }
 }
 
@@ -544,12 +982,15 @@ EmbeddingCacheRefreshspace EmbeddingCache<TypeHashKey>::create_refreshspace() {
                                                cache_config_.num_set_in_cache_.end());
     const int max_embedding_size = *max_element(cache_config_.embedding_vec_size_.begin(),
                                                 cache_config_.embedding_vec_size_.end());
-    const size_t max_num_keys = (SLAB_SIZE * SET_ASSOCIATIVITY) * max_num_cache_set;
+    const size_t max_set_associativity =
+        *max_element(cache_config_.set_associativity_per_table_.begin(),
+                     cache_config_.set_associativity_per_table_.end());
+    const size_t max_num_keys = (SLAB_SIZE * max_set_associativity) * max_num_cache_set;
     const size_t max_num_key_in_buffer =
         cache_config_.cache_refresh_percentage_per_iteration * max_num_keys;
     cache_config_.num_set_in_refresh_workspace_ =
-        (max_num_key_in_buffer + SLAB_SIZE * SET_ASSOCIATIVITY - 1) /
-        (SLAB_SIZE * SET_ASSOCIATIVITY);
+        (max_num_key_in_buffer + SLAB_SIZE * max_set_associativity - 1) /
+        (SLAB_SIZE * max_set_associativity);
 
     // Swap device.
     CudaDeviceContext dev_restorer;
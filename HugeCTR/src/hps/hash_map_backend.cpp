@@ -40,6 +40,15 @@
 
 namespace HugeCTR {
 
+// Number of hash table probes to keep in flight at a time. Buckets are prefetched this many keys
+// ahead of the probe position, so that the DRAM latency of the bucket load overlaps with hashing
+// the subsequent keys (F14/Swiss-table-style batched probing).
+static constexpr size_t BATCH_PROBE_WINDOW = 16;
+
+// Minimum number of key positions per radix-partition chunk. Below this, spreading the
+// histogram and scatter passes over more workers costs more in task handoff than it saves.
+static constexpr size_t RADIX_PARTITION_MIN_CHUNK = 4096;
+
 #ifdef HCTR_HASH_MAP_BACKEND_CONTAINS_
 #error HCTR_HASH_MAP_BACKEND_CONTAINS_ already defined. Potential naming conflict!
 #else
@@ -47,6 +56,12 @@ namespace HugeCTR {
   hit_count += part.entries.find((KEY)) != part.entries.end()
 #endif
 
+#ifdef HCTR_HASH_MAP_BACKEND_PREFETCH_
+#error HCTR_HASH_MAP_BACKEND_PREFETCH_ already defined. Potential naming conflict!
+#else
+#define HCTR_HASH_MAP_BACKEND_PREFETCH_(KEY) part.entries.prefetch((KEY))
+#endif
+
 #ifdef HCTR_HASH_MAP_BACKEND_INSERT_
 #error HCTR_HASH_MAP_BACKEND_INSERT_ already defined. Potential naming conflict!
 #else
@@ -120,12 +135,157 @@ HashMapBackend<TKey>::HashMapBackend(const size_t num_partitions, const size_t a
                                      const size_t max_get_batch_size,
                                      const size_t max_set_batch_size, const size_t overflow_margin,
                                      const DatabaseOverflowPolicy_t overflow_policy,
-                                     const double overflow_resolution_target)
+                                     const double overflow_resolution_target,
+                                     const size_t expiry_seconds)
     : TBase(max_get_batch_size, max_set_batch_size, overflow_margin, overflow_policy,
             overflow_resolution_target),
       num_partitions_{num_partitions},
-      allocation_rate_{allocation_rate} {
+      allocation_rate_{allocation_rate},
+      expiry_seconds_{expiry_seconds} {
   HCTR_LOG_S(DEBUG, WORLD) << "Created blank database backend in local memory!" << std::endl;
+  if (expiry_seconds_) {
+    expiry_compaction_worker_ = std::thread(&HashMapBackend<TKey>::expiry_compaction_loop_, this);
+    HCTR_LOG_S(INFO, WORLD) << get_name() << " backend; entries expire after " << expiry_seconds_
+                            << " s without access." << std::endl;
+  }
+}
+
+template <typename TKey>
+HashMapBackend<TKey>::~HashMapBackend() {
+  if (expiry_compaction_worker_.joinable()) {
+    expiry_compaction_terminate_ = true;
+    expiry_compaction_worker_.join();
+  }
+}
+
+template <typename TKey>
+void HashMapBackend<TKey>::expiry_compaction_loop_() {
+  // Sweep often enough that entries linger at most ~10% beyond their nominal lifetime.
+  const std::chrono::seconds sweep_interval{std::max<size_t>(1, expiry_seconds_ / 10)};
+
+  while (!expiry_compaction_terminate_) {
+    // Sleep in small steps so shutdown stays responsive.
+    for (auto slept = std::chrono::seconds::zero(); slept < sweep_interval;
+         slept += std::chrono::seconds(1)) {
+      if (expiry_compaction_terminate_) {
+        return;
+      }
+      std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+
+    // Snapshot the table names, then sweep one partition at a time.
+    std::vector<std::string> table_names;
+    {
+      const std::shared_lock lock(read_write_guard_);
+      for (const auto& pair : tables_) {
+        table_names.emplace_back(pair.first);
+      }
+    }
+
+    for (const std::string& table_name : table_names) {
+      const std::shared_lock lock(read_write_guard_);
+      const auto& tables_it = tables_.find(table_name);
+      if (tables_it == tables_.end()) {
+        continue;
+      }
+
+      size_t num_expired = 0;
+      for (TPartition& part : tables_it->second) {
+        // Collect the expired keys under the shared lock; lookups can proceed meanwhile.
+        const time_t expiry_horizon = std::time(nullptr) - expiry_seconds_;
+        std::vector<TKey> expired_keys;
+        {
+          const std::shared_lock part_lock(*part.read_write_guard);
+          for (const auto& entry : part.entries) {
+            if (entry.second.last_access < expiry_horizon) {
+              expired_keys.emplace_back(entry.first);
+            }
+          }
+        }
+
+        // Evict in bounded batches, re-checking under the exclusive lock because a fetch or
+        // insert may have refreshed an entry since the scan.
+        for (auto k_it = expired_keys.begin(); k_it != expired_keys.end();) {
+          const auto& batch_end =
+              std::min(k_it + this->max_set_batch_size_, expired_keys.end());
+          const std::unique_lock part_lock(*part.read_write_guard);
+          for (; k_it != batch_end; k_it++) {
+            const auto& it = part.entries.find(*k_it);
+            if (it == part.entries.end() || it->second.last_access >= expiry_horizon) {
+              continue;
+            }
+            part.value_ptrs.emplace_back(it->second.value);
+            part.entries.erase(it);
+            num_expired++;
+          }
+        }
+      }
+
+      if (num_expired) {
+        HCTR_LOG_S(DEBUG, WORLD) << get_name() << " backend; Table " << table_name
+                                 << ": compacted " << num_expired << " expired entries."
+                                 << std::endl;
+      }
+    }
+  }
+}
+
+template <typename TKey>
+template <typename TPartIndexOf>
+void HashMapBackend<TKey>::radix_partition_(TPartIndexOf&& part_index_of, const size_t num_keys,
+                                            std::vector<size_t>& run_offsets,
+                                            std::vector<size_t>& order) const {
+  const size_t num_chunks =
+      std::min(ThreadPool::get().size(),
+               (num_keys + RADIX_PARTITION_MIN_CHUNK - 1) / RADIX_PARTITION_MIN_CHUNK);
+  const size_t chunk_size = (num_keys + num_chunks - 1) / num_chunks;
+
+  std::vector<size_t> part_of(num_keys);
+  std::vector<size_t> histograms(num_chunks * num_partitions_, 0);
+
+  // Pass 1: hash each key exactly once and count the keys per (chunk, partition).
+  std::vector<std::future<void>> tasks;
+  tasks.reserve(num_chunks);
+  for (size_t c = 0; c < num_chunks; c++) {
+    tasks.emplace_back(ThreadPool::get().submit([&, c]() {
+      const size_t chunk_end = std::min((c + 1) * chunk_size, num_keys);
+      size_t* const histogram = &histograms[c * num_partitions_];
+      for (size_t i = c * chunk_size; i < chunk_end; i++) {
+        const size_t p = part_index_of(i);
+        part_of[i] = p;
+        histogram[p]++;
+      }
+    }));
+  }
+  ThreadPool::await(tasks.begin(), tasks.end());
+
+  // Exclusive prefix sum over (partition, chunk): chunk c scatters into partition p right
+  // after the keys that the earlier chunks contributed to p, so runs stay in batch order.
+  run_offsets.resize(num_partitions_ + 1);
+  size_t offset = 0;
+  for (size_t p = 0; p < num_partitions_; p++) {
+    run_offsets[p] = offset;
+    for (size_t c = 0; c < num_chunks; c++) {
+      const size_t count = histograms[c * num_partitions_ + p];
+      histograms[c * num_partitions_ + p] = offset;
+      offset += count;
+    }
+  }
+  run_offsets[num_partitions_] = offset;
+
+  // Pass 2: scatter the key positions into their partition runs.
+  order.resize(num_keys);
+  tasks.clear();
+  for (size_t c = 0; c < num_chunks; c++) {
+    tasks.emplace_back(ThreadPool::get().submit([&, c]() {
+      const size_t chunk_end = std::min((c + 1) * chunk_size, num_keys);
+      size_t* const scatter = &histograms[c * num_partitions_];
+      for (size_t i = c * chunk_size; i < chunk_end; i++) {
+        order[scatter[part_of[i]]++] = i;
+      }
+    }));
+  }
+  ThreadPool::await(tasks.begin(), tasks.end());
 }
 
 template <typename TPartition>
@@ -140,6 +300,7 @@ size_t HashMapBackend<TPartition>::size(const std::string& table_name) const {
 
   size_t num_keys = 0;
   for (const TPartition& part : tables_it->second) {
+    std::shared_lock part_lock(*part.read_write_guard);
     num_keys += part.entries.size();
   }
   return num_keys;
@@ -179,6 +340,7 @@ size_t HashMapBackend<TKey>::contains(const std::string& table_name, const size_
 
       // Check partition.
       const TPartition& part = parts[HCTR_KEY_TO_PART_INDEX(*keys)];
+      std::shared_lock part_lock(*part.read_write_guard);
       HCTR_HASH_MAP_BACKEND_CONTAINS_(*keys);
     } break;
     default: {
@@ -187,6 +349,7 @@ size_t HashMapBackend<TKey>::contains(const std::string& table_name, const size_
 
       if (parts.size() == 1) {
         const TPartition& part = parts.front();
+        std::shared_lock part_lock(*part.read_write_guard);
 
         // Traverse through keys.
         size_t num_batches = 0;
@@ -201,9 +364,18 @@ size_t HashMapBackend<TKey>::contains(const std::string& table_name, const size_
             break;
           }
 
-          // Query next batch.
+          // Query next batch. The prefetch stage runs `BATCH_PROBE_WINDOW` keys ahead of the
+          // probe stage.
           const TKey* const batch_end = std::min(&k[this->max_get_batch_size_], keys_end);
+          const TKey* pf = k;
+          for (const TKey* const pf_end = std::min(&k[BATCH_PROBE_WINDOW], batch_end); pf != pf_end;
+               pf++) {
+            HCTR_HASH_MAP_BACKEND_PREFETCH_(*pf);
+          }
           for (; k != batch_end; k++) {
+            if (pf != batch_end) {
+              HCTR_HASH_MAP_BACKEND_PREFETCH_(*pf++);
+            }
             HCTR_HASH_MAP_BACKEND_CONTAINS_(*k);
           }
 
@@ -216,12 +388,19 @@ size_t HashMapBackend<TKey>::contains(const std::string& table_name, const size_
         std::atomic<size_t> joint_hit_count{0};
         std::atomic<size_t> joint_ign_count{0};
 
+        // Hash each key exactly once. The per-partition tasks below filter on the precomputed
+        // partition index, instead of re-hashing the entire batch in every task.
+        std::vector<size_t> part_indices(num_keys);
+        std::transform(keys, keys_end, part_indices.begin(),
+                       [&](const TKey& key) { return HCTR_KEY_TO_PART_INDEX(key); });
+
         // Process partitions.
         std::vector<std::future<void>> tasks;
         tasks.reserve(parts.size());
 
         for (const TPartition& part : parts) {
           tasks.emplace_back(ThreadPool::get().submit([&]() {
+            std::shared_lock part_lock(*part.read_write_guard);
             size_t hit_count = 0;
 
             size_t num_batches = 0;
@@ -234,7 +413,7 @@ size_t HashMapBackend<TKey>::contains(const std::string& table_name, const size_
 
                 size_t ign_count = 0;
                 for (; k != keys_end; k++) {
-                  if (HCTR_KEY_TO_PART_INDEX(*k) == part.index) {
+                  if (part_indices[k - keys] == part.index) {
                     ign_count++;
                   }
                 }
@@ -242,15 +421,23 @@ size_t HashMapBackend<TKey>::contains(const std::string& table_name, const size_
                 break;
               }
 
-              // Query next batch.
+              // Query next batch, `BATCH_PROBE_WINDOW` probes in flight at a time.
               size_t batch_size = 0;
-              for (; k != keys_end; k++) {
-                if (HCTR_KEY_TO_PART_INDEX(*k) == part.index) {
-                  HCTR_HASH_MAP_BACKEND_CONTAINS_(*k);
-                  if (++batch_size >= this->max_get_batch_size_) {
-                    break;
+              while (k != keys_end && batch_size < this->max_get_batch_size_) {
+                const TKey* window[BATCH_PROBE_WINDOW];
+                size_t window_size = 0;
+                for (; k != keys_end && window_size < BATCH_PROBE_WINDOW &&
+                       batch_size + window_size < this->max_get_batch_size_;
+                     k++) {
+                  if (part_indices[k - keys] == part.index) {
+                    window[window_size++] = k;
+                    HCTR_HASH_MAP_BACKEND_PREFETCH_(*k);
                   }
                 }
+                batch_size += window_size;
+                for (size_t w = 0; w != window_size; w++) {
+                  HCTR_HASH_MAP_BACKEND_CONTAINS_(*window[w]);
+                }
               }
 
               HCTR_LOG_S(TRACE, WORLD)
@@ -280,21 +467,31 @@ template <typename TKey>
 bool HashMapBackend<TKey>::insert(const std::string& table_name, const size_t num_pairs,
                                   const TKey* const keys, const char* const values,
                                   const size_t value_size) {
-  std::unique_lock lock(this->read_write_guard_);
-
-  // Locate the partitions, or create them, if they do not exist yet.
-  const auto& tables_it = tables_.try_emplace(table_name).first;
-  std::vector<TPartition>& parts = tables_it->second;
-  if (parts.empty()) {
-    HCTR_CHECK(value_size > 0 && value_size <= allocation_rate_);
+  std::shared_lock lock(this->read_write_guard_);
 
-    parts.reserve(num_partitions_);
-    for (size_t i = 0; i < num_partitions_; i++) {
-      parts.emplace_back(i, value_size);
+  // Locate the partitions, or create them, if they do not exist yet. Partition creation is the
+  // only mutation that requires exclusive access to the table mapping.
+  auto tables_it = tables_.find(table_name);
+  if (tables_it == tables_.end() || tables_it->second.empty()) {
+    lock.unlock();
+    {
+      std::unique_lock write_lock(this->read_write_guard_);
+
+      std::vector<TPartition>& parts = tables_.try_emplace(table_name).first->second;
+      if (parts.empty()) {
+        HCTR_CHECK(value_size > 0 && value_size <= allocation_rate_);
+
+        parts.reserve(num_partitions_);
+        for (size_t i = 0; i < num_partitions_; i++) {
+          parts.emplace_back(i, value_size);
+        }
+      }
     }
-  } else {
-    HCTR_CHECK(parts.size() == num_partitions_);
+    lock.lock();
+    tables_it = tables_.find(table_name);
   }
+  std::vector<TPartition>& parts = tables_it->second;
+  HCTR_CHECK(parts.size() == num_partitions_);
 
   size_t num_inserts = 0;
 
@@ -305,6 +502,7 @@ bool HashMapBackend<TKey>::insert(const std::string& table_name, const size_t nu
     case 1: {
       TPartition& part = parts[HCTR_KEY_TO_PART_INDEX(*keys)];
       HCTR_CHECK(part.value_size == value_size);
+      std::unique_lock part_lock(*part.read_write_guard);
 
       // Check overflow condition.
       if (part.entries.size() >= this->overflow_margin_) {
@@ -322,6 +520,7 @@ bool HashMapBackend<TKey>::insert(const std::string& table_name, const size_t nu
       if (parts.size() == 1) {
         TPartition& part = parts.front();
         HCTR_CHECK(part.value_size == value_size);
+        std::unique_lock part_lock(*part.read_write_guard);
 
         // Step through batch-by-batch.
         for (const TKey* k = keys; k != keys_end;) {
@@ -348,6 +547,7 @@ bool HashMapBackend<TKey>::insert(const std::string& table_name, const size_t nu
 
         for (TPartition& part : parts) {
           tasks.emplace_back(ThreadPool::get().submit([&]() {
+            std::unique_lock part_lock(*part.read_write_guard);
             size_t num_inserts = 0;
 
             // Step through batch-by-batch.
@@ -396,7 +596,7 @@ size_t HashMapBackend<TKey>::fetch(const std::string& table_name, const size_t n
                                    const DatabaseMissCallback& on_miss,
                                    const std::chrono::nanoseconds& time_budget) {
   const auto begin = std::chrono::high_resolution_clock::now();
-  std::unique_lock lock(this->read_write_guard_);
+  std::shared_lock lock(this->read_write_guard_);
 
   // Locate the partitions.
   const auto& tables_it = tables_.find(table_name);
@@ -426,6 +626,7 @@ size_t HashMapBackend<TKey>::fetch(const std::string& table_name, const size_t n
 
       // Perform query.
       TPartition& part = parts[HCTR_KEY_TO_PART_INDEX(*keys)];
+      std::shared_lock part_lock(*part.read_write_guard);
       const time_t now = std::time(nullptr);
 
       HCTR_HASH_MAP_BACKEND_FETCH_(*keys, 0);
@@ -436,6 +637,7 @@ size_t HashMapBackend<TKey>::fetch(const std::string& table_name, const size_t n
 
       if (parts.size() == 1) {
         TPartition& part = parts.front();
+        std::shared_lock part_lock(*part.read_write_guard);
 
         // Step through batch-by-batch.
         size_t num_batches = 0;
@@ -457,8 +659,17 @@ size_t HashMapBackend<TKey>::fetch(const std::string& table_name, const size_t n
           const size_t prev_hit_count = hit_count;
           const time_t now = std::time(nullptr);
 
+          // The prefetch stage runs `BATCH_PROBE_WINDOW` keys ahead of the probe stage.
           const TKey* const batch_end = std::min(&k[this->max_get_batch_size_], keys_end);
+          const TKey* pf = k;
+          for (const TKey* const pf_end = std::min(&k[BATCH_PROBE_WINDOW], batch_end); pf != pf_end;
+               pf++) {
+            HCTR_HASH_MAP_BACKEND_PREFETCH_(*pf);
+          }
           for (; k != batch_end; k++) {
+            if (pf != batch_end) {
+              HCTR_HASH_MAP_BACKEND_PREFETCH_(*pf++);
+            }
             HCTR_HASH_MAP_BACKEND_FETCH_(*k, k - keys);
           }
 
@@ -472,17 +683,28 @@ size_t HashMapBackend<TKey>::fetch(const std::string& table_name, const size_t n
         std::atomic<size_t> joint_hit_count{0};
         std::atomic<size_t> joint_ign_count{0};
 
+        // Radix-partition the batch into per-partition runs of key positions. Each key is
+        // hashed exactly once, and the per-partition tasks below walk only their own
+        // contiguous run, instead of filtering the entire batch.
+        std::vector<size_t> run_offsets;
+        std::vector<size_t> order;
+        radix_partition_([&](const size_t i) { return HCTR_KEY_TO_PART_INDEX(keys[i]); },
+                         num_keys, run_offsets, order);
+
         // Spawn threads.
         std::vector<std::future<void>> tasks;
         tasks.reserve(parts.size());
 
         for (TPartition& part : parts) {
           tasks.emplace_back(ThreadPool::get().submit([&]() {
+            std::shared_lock part_lock(*part.read_write_guard);
             size_t hit_count = 0;
 
-            // Traverse through keys, and fetch them one by one.
-            size_t num_batches = 0;
-            for (const TKey* k = keys; k != keys_end; num_batches++) {
+            const size_t* r = order.data() + run_offsets[part.index];
+            const size_t* const run_end = order.data() + run_offsets[part.index + 1];
+
+            // Traverse through the partition's run of keys, and fetch them one by one.
+            for (size_t num_batches = 0; r != run_end; num_batches++) {
               // Check time budget.
               const auto elapsed = std::chrono::high_resolution_clock::now() - begin;
               if (elapsed >= time_budget) {
@@ -490,35 +712,36 @@ size_t HashMapBackend<TKey>::fetch(const std::string& table_name, const size_t n
                     << get_name() << " backend; Table " << table_name << ": Timeout!" << std::endl;
 
                 size_t ign_count = 0;
-                for (; k != keys_end; k++) {
-                  if (HCTR_KEY_TO_PART_INDEX(*k) == part.index) {
-                    on_miss(k - keys);
-                    ign_count++;
-                  }
+                for (; r != run_end; r++) {
+                  on_miss(*r);
+                  ign_count++;
                 }
                 joint_ign_count += ign_count;
                 break;
               }
 
-              // Perform a bunch of queries.
+              // Perform a bunch of queries, `BATCH_PROBE_WINDOW` probes in flight at a time.
               const size_t prev_hit_count = hit_count;
               const time_t now = std::time(nullptr);
 
-              size_t batch_size = 0;
-              for (; k != keys_end; k++) {
-                if (HCTR_KEY_TO_PART_INDEX(*k) == part.index) {
-                  HCTR_HASH_MAP_BACKEND_FETCH_(*k, k - keys);
-                  if (++batch_size >= this->max_get_batch_size_) {
-                    break;
-                  }
+              const size_t* const batch_end = std::min(&r[this->max_get_batch_size_], run_end);
+              const size_t* pf = r;
+              for (const size_t* const pf_end = std::min(&r[BATCH_PROBE_WINDOW], batch_end);
+                   pf != pf_end; pf++) {
+                HCTR_HASH_MAP_BACKEND_PREFETCH_(keys[*pf]);
+              }
+              for (; r != batch_end; r++) {
+                if (pf != batch_end) {
+                  HCTR_HASH_MAP_BACKEND_PREFETCH_(keys[*pf++]);
                 }
+                HCTR_HASH_MAP_BACKEND_FETCH_(keys[*r], *r);
               }
 
               HCTR_LOG_S(TRACE, WORLD)
                   << get_name() << " backend; Table " << table_name << ", partition " << part.index
-                  << ", batch " << num_batches << ": " << (hit_count - prev_hit_count) << " / "
-                  << batch_size << " hits. Time: " << elapsed.count() << " / "
-                  << time_budget.count() << " ns." << std::endl;
+                  << ", batch " << num_batches << ": " << (hit_count - prev_hit_count)
+                  << " hits. Time: " << elapsed.count() << " / " << time_budget.count() << " ns."
+                  << std::endl;
             }
 
             joint_hit_count += hit_count;
@@ -544,7 +767,7 @@ size_t HashMapBackend<TKey>::fetch(const std::string& table_name, const size_t n
                                    const DatabaseMissCallback& on_miss,
                                    const std::chrono::nanoseconds& time_budget) {
   const auto begin = std::chrono::high_resolution_clock::now();
-  std::unique_lock lock(read_write_guard_);
+  std::shared_lock lock(read_write_guard_);
 
   // Locate the partitions.
   const auto& tables_it = tables_.find(table_name);
@@ -575,6 +798,7 @@ size_t HashMapBackend<TKey>::fetch(const std::string& table_name, const size_t n
       // Precalc constants.
       const TKey& k = keys[*indices];
       TPartition& part = parts[HCTR_KEY_TO_PART_INDEX(k)];
+      std::shared_lock part_lock(*part.read_write_guard);
 
       // Perform query.
       const time_t now = std::time(nullptr);
@@ -586,6 +810,7 @@ size_t HashMapBackend<TKey>::fetch(const std::string& table_name, const size_t n
 
       if (parts.size() == 1) {
         TPartition& part = parts.front();
+        std::shared_lock part_lock(*part.read_write_guard);
 
         // Step through batch-by-batch.
         size_t num_batches = 0;
@@ -607,8 +832,17 @@ size_t HashMapBackend<TKey>::fetch(const std::string& table_name, const size_t n
           const size_t prev_hit_count = hit_count;
           const time_t now = std::time(nullptr);
 
+          // The prefetch stage runs `BATCH_PROBE_WINDOW` keys ahead of the probe stage.
           const size_t* const batch_end = std::min(&i[this->max_get_batch_size_], indices_end);
+          const size_t* pf = i;
+          for (const size_t* const pf_end = std::min(&i[BATCH_PROBE_WINDOW], batch_end);
+               pf != pf_end; pf++) {
+            HCTR_HASH_MAP_BACKEND_PREFETCH_(keys[*pf]);
+          }
           for (; i != batch_end; i++) {
+            if (pf != batch_end) {
+              HCTR_HASH_MAP_BACKEND_PREFETCH_(keys[*pf++]);
+            }
             HCTR_HASH_MAP_BACKEND_FETCH_(keys[*i], *i);
           }
 
@@ -622,17 +856,29 @@ size_t HashMapBackend<TKey>::fetch(const std::string& table_name, const size_t n
         std::atomic<size_t> joint_hit_count{0};
         std::atomic<size_t> joint_ign_count{0};
 
+        // Radix-partition the batch into per-partition runs of positions into `indices`. Each
+        // key is hashed exactly once, and the per-partition tasks below walk only their own
+        // contiguous run, instead of filtering the entire batch.
+        std::vector<size_t> run_offsets;
+        std::vector<size_t> order;
+        radix_partition_(
+            [&](const size_t i) { return HCTR_KEY_TO_PART_INDEX(keys[indices[i]]); }, num_indices,
+            run_offsets, order);
+
         // Process partitions.
         std::vector<std::future<void>> tasks;
         tasks.reserve(parts.size());
 
         for (TPartition& part : parts) {
           tasks.emplace_back(ThreadPool::get().submit([&]() {
+            std::shared_lock part_lock(*part.read_write_guard);
             size_t hit_count = 0;
 
-            // Traverse through keys batch-wise.
-            const size_t* i = indices;
-            for (size_t num_batches = 0; i != indices_end; num_batches++) {
+            const size_t* r = order.data() + run_offsets[part.index];
+            const size_t* const run_end = order.data() + run_offsets[part.index + 1];
+
+            // Traverse through the partition's run of keys batch-wise.
+            for (size_t num_batches = 0; r != run_end; num_batches++) {
               // Check time budget.
               const auto elapsed = std::chrono::high_resolution_clock::now() - begin;
               if (elapsed >= time_budget) {
@@ -640,39 +886,39 @@ size_t HashMapBackend<TKey>::fetch(const std::string& table_name, const size_t n
                     << get_name() << " backend; Table " << table_name << ": Timeout!" << std::endl;
 
                 size_t ign_count = 0;
-                for (; i != indices_end; i++) {
-                  if (HCTR_KEY_TO_PART_INDEX(keys[*i]) == part.index) {
-                    on_miss(*i);
-                    ign_count++;
-                  }
+                for (; r != run_end; r++) {
+                  on_miss(indices[*r]);
+                  ign_count++;
                 }
                 joint_ign_count += ign_count;
                 break;
               }
 
-              // Step through batch 1 by 1 and fetch.
+              // Step through batch, `BATCH_PROBE_WINDOW` probes in flight at a time.
               const size_t prev_hit_count = hit_count;
               const time_t now = std::time(nullptr);
 
-              size_t batch_size = 0;
-              for (; i != indices_end; i++) {
-                const TKey& k = keys[*i];
-                if (HCTR_KEY_TO_PART_INDEX(k) == part.index) {
-                  HCTR_HASH_MAP_BACKEND_FETCH_(k, *i);
-                  if (++batch_size >= this->max_get_batch_size_) {
-                    break;
-                  }
+              const size_t* const batch_end = std::min(&r[this->max_get_batch_size_], run_end);
+              const size_t* pf = r;
+              for (const size_t* const pf_end = std::min(&r[BATCH_PROBE_WINDOW], batch_end);
+                   pf != pf_end; pf++) {
+                HCTR_HASH_MAP_BACKEND_PREFETCH_(keys[indices[*pf]]);
+              }
+              for (; r != batch_end; r++) {
+                if (pf != batch_end) {
+                  HCTR_HASH_MAP_BACKEND_PREFETCH_(keys[indices[*pf++]]);
                 }
+                HCTR_HASH_MAP_BACKEND_FETCH_(keys[indices[*r]], indices[*r]);
               }
 
               HCTR_LOG_S(TRACE, WORLD)
                   << get_name() << " backend; Table " << table_name << ", partition " << part.index
-                  << ", batch " << num_batches << ": " << (hit_count - prev_hit_count) << " / "
-                  << batch_size << " hits. Time: " << elapsed.count() << " / "
-                  << time_budget.count() << " ns." << std::endl;
-
-              joint_hit_count += hit_count;
+                  << ", batch " << num_batches << ": " << (hit_count - prev_hit_count)
+                  << " hits. Time: " << elapsed.count() << " / " << time_budget.count() << " ns."
+                  << std::endl;
             }
+
+            joint_hit_count += hit_count;
           }));
         }
         ThreadPool::await(tasks.begin(), tasks.end());
@@ -713,7 +959,7 @@ size_t HashMapBackend<TKey>::evict(const std::string& table_name) {
 template <typename TKey>
 size_t HashMapBackend<TKey>::evict(const std::string& table_name, const size_t num_keys,
                                    const TKey* const keys) {
-  std::unique_lock lock(this->read_write_guard_);
+  std::shared_lock lock(this->read_write_guard_);
 
   // Locate the partitions.
   const auto& tables_it = tables_.find(table_name);
@@ -730,6 +976,7 @@ size_t HashMapBackend<TKey>::evict(const std::string& table_name, const size_t n
     } break;
     case 1: {
       TPartition& part = parts[HCTR_KEY_TO_PART_INDEX(*keys)];
+      std::unique_lock part_lock(*part.read_write_guard);
       HCTR_HASH_MAP_BACKEND_EVICT_(*keys);
     } break;
     default: {
@@ -738,6 +985,7 @@ size_t HashMapBackend<TKey>::evict(const std::string& table_name, const size_t n
 
       if (parts.size() == 1) {
         TPartition& part = parts.front();
+        std::unique_lock part_lock(*part.read_write_guard);
 
         // Traverse through keys batch-wise.
         size_t num_batches = 0;
@@ -763,6 +1011,7 @@ size_t HashMapBackend<TKey>::evict(const std::string& table_name, const size_t n
 
         for (TPartition& part : parts) {
           tasks.emplace_back(ThreadPool::get().submit([&]() {
+            std::unique_lock part_lock(*part.read_write_guard);
             size_t hit_count = 0;
 
             // Traverse through keys, batch-by-batch.
@@ -875,6 +1124,35 @@ size_t HashMapBackend<TKey>::resolve_overflow_(const std::string& table_name, TP
 
   size_t hit_count = 0;
 
+  // A user-installed victim selector takes precedence over the built-in policies.
+  if (this->overflow_victim_selector_) {
+    // Fetch keys and last access times.
+    std::vector<std::pair<TKey, time_t>> candidates;
+    candidates.reserve(part.entries.size());
+    for (const auto& entry : part.entries) {
+      candidates.emplace_back(entry.first, entry.second.last_access);
+    }
+    const size_t num_victims = (part.entries.size() > this->overflow_resolution_target_)
+                                   ? part.entries.size() - this->overflow_resolution_target_
+                                   : 0;
+
+    std::vector<TKey> victims;
+    this->overflow_victim_selector_(table_name, candidates, num_victims, victims);
+
+    HCTR_LOG_S(TRACE, WORLD) << this->get_name() << " backend; Partition " << table_name << '/'
+                             << part.index << " is overflowing (size = " << part.entries.size()
+                             << " > " << this->overflow_margin_ << "): Attempting to evict "
+                             << victims.size() << " CUSTOM-selected key/value pairs!" << std::endl;
+
+    for (const TKey& k : victims) {
+      HCTR_HASH_MAP_BACKEND_EVICT_(k);
+      if (part.entries.size() <= this->overflow_resolution_target_) {
+        break;
+      }
+    }
+    return hit_count;
+  }
+
   switch (this->overflow_policy_) {
     case DatabaseOverflowPolicy_t::EvictOldest: {
       // Fetch keys and insert times.
@@ -14,17 +14,26 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <cstdlib>
 #include <filesystem>
+#include <fstream>
+#include <numeric>
 #include <hps/direct_map_backend.hpp>
 #include <hps/hash_map_backend.hpp>
 #include <hps/hier_parameter_server.hpp>
 #include <hps/inference_utils.hpp>
 #include <hps/kafka_message.hpp>
 #include <hps/modelloader.hpp>
+#include <hps/multi_process_hash_map_backend.hpp>
+#include <hps/near_cache_backend.hpp>
 #include <hps/redis_backend.hpp>
 #include <hps/rocksdb_backend.hpp>
 #include <regex>
+#include <thread>
+#include <thread_pool.hpp>
 #include <vector>
 
 #include "base/debug/logger.hpp"
@@ -112,22 +121,44 @@ HierParameterServer<TypeHashKey>::HierParameterServer(
             conf.overflow_policy, conf.overflow_resolution_target);
         break;
 
+      case DatabaseType_t::MultiProcessHashMap:
+        HCTR_LOG_S(INFO, WORLD) << "Creating shared-memory CPU database backend..." << std::endl;
+        volatile_db_ = std::make_unique<MultiProcessHashMapBackend<TypeHashKey>>(
+            conf.shared_memory_name, conf.shared_memory_size, conf.max_get_batch_size,
+            conf.max_set_batch_size, conf.overflow_margin, conf.overflow_policy,
+            conf.overflow_resolution_target);
+        break;
+
       case DatabaseType_t::HashMap:
       case DatabaseType_t::ParallelHashMap:
         HCTR_LOG_S(INFO, WORLD) << "Creating HashMap CPU database backend..." << std::endl;
         volatile_db_ = std::make_unique<HashMapBackend<TypeHashKey>>(
             conf.num_partitions, conf.allocation_rate, conf.max_get_batch_size,
             conf.max_set_batch_size, conf.overflow_margin, conf.overflow_policy,
-            conf.overflow_resolution_target);
+            conf.overflow_resolution_target, conf.expiry_seconds);
         break;
 
-      case DatabaseType_t::RedisCluster:
+      case DatabaseType_t::RedisCluster: {
         HCTR_LOG_S(INFO, WORLD) << "Creating RedisCluster backend..." << std::endl;
-        volatile_db_ = std::make_unique<RedisClusterBackend<TypeHashKey>>(
+        auto redis = std::make_unique<RedisClusterBackend<TypeHashKey>>(
             conf.address, conf.user_name, conf.password, conf.num_partitions,
             conf.max_get_batch_size, conf.max_set_batch_size, conf.refresh_time_after_fetch,
             conf.overflow_margin, conf.overflow_policy, conf.overflow_resolution_target);
-        break;
+        // Keys that repeat across nearby lookup sessions can be served from an in-process near
+        // cache instead of crossing the network again; updates arriving through insert (e.g.,
+        // from the online update stream) invalidate the near copies.
+        size_t near_capacity{0};
+        if (const char* env = std::getenv("HCTR_REDIS_NEAR_CACHE")) {
+          near_capacity = std::strtoull(env, nullptr, 10);
+        }
+        if (near_capacity > 0) {
+          volatile_db_ = std::make_unique<NearCacheBackend<TypeHashKey>>(
+              std::move(redis), near_capacity, conf.num_partitions, conf.max_get_batch_size,
+              conf.max_set_batch_size);
+        } else {
+          volatile_db_ = std::move(redis);
+        }
+      } break;
 
       default:
         HCTR_DIE("Selected backend (volatile_db.type = %d) is not supported!", conf.type);
@@ -179,10 +210,43 @@ HierParameterServer<TypeHashKey>::HierParameterServer(
       init_ec(inference_params_array[i], model_cache_map_[inference_params_array[i].model_name]);
     }
   }
+
+  // Arbitrate GPU cache capacity between co-located models based on their observed traffic.
+  long arbitration_interval_sec{0};
+  if (const char* env = std::getenv("HCTR_CACHE_ARBITRATION_SEC")) {
+    arbitration_interval_sec = std::atol(env);
+  }
+  if (arbitration_interval_sec > 0 && model_cache_map_.size() > 1) {
+    HCTR_LOG_S(INFO, WORLD) << "GPU cache capacity will be arbitrated between models every "
+                            << arbitration_interval_sec << " s" << std::endl;
+    cache_arbitration_worker_ = std::thread([this, arbitration_interval_sec]() {
+      const std::chrono::seconds interval(arbitration_interval_sec);
+      while (!cache_arbitration_terminate_) {
+        std::this_thread::sleep_for(interval);
+        if (cache_arbitration_terminate_) {
+          break;
+        }
+        arbitrate_cache_memory_();
+      }
+    });
+  }
 }
 
 template <typename TypeHashKey>
 HierParameterServer<TypeHashKey>::~HierParameterServer() {
+  // Stop real-time ingestion before tearing down the staging machinery it writes to.
+  volatile_db_source_.reset();
+  persistent_db_source_.reset();
+  if (cache_arbitration_worker_.joinable()) {
+    cache_arbitration_terminate_ = true;
+    cache_arbitration_worker_.join();
+  }
+  // Stop the group-commit worker and drain any staged updates.
+  if (group_commit_worker_.joinable()) {
+    group_commit_terminate_ = true;
+    group_commit_worker_.join();
+    apply_staged_updates_();
+  }
   for (auto it = model_cache_map_.begin(); it != model_cache_map_.end(); it++) {
     for (auto& v : it->second) {
       v.second->finalize();
@@ -342,24 +406,261 @@ void HierParameterServer<TypeHashKey>::update_database_per_model(
 
   // TODO: Update embedding cache!
 
+  // Group-commit mode: stage the delivered updates and batch-apply them on a timer, so that
+  // online-training refresh does not contend with the serving path on every delivery.
+  const bool group_commit = inference_params.update_source.group_commit;
+
   // Turn on background updates.
   if (volatile_db_source_) {
-    volatile_db_source_->engage([&](const std::string& tag, const size_t num_pairs,
-                                    const TypeHashKey* keys, const char* values,
-                                    const size_t value_size) -> bool {
+    volatile_db_source_->engage([&, group_commit](const std::string& tag, const size_t num_pairs,
+                                                  const TypeHashKey* keys, const char* values,
+                                                  const size_t value_size) -> bool {
+      if (group_commit) {
+        return this->stage_update_(volatile_db_staged_updates_, tag, num_pairs, keys, values,
+                                   value_size);
+      }
       // Try a search. If we can find the value, override it. If not, do nothing.
       return insert_fn(volatile_db_.get(), tag, num_pairs, keys, values, value_size);
     });
   }
 
   if (persistent_db_source_) {
-    persistent_db_source_->engage([&](const std::string& tag, const size_t num_pairs,
-                                      const TypeHashKey* keys, const char* values,
-                                      const size_t value_size) -> bool {
+    persistent_db_source_->engage([&, group_commit](const std::string& tag, const size_t num_pairs,
+                                                    const TypeHashKey* keys, const char* values,
+                                                    const size_t value_size) -> bool {
+      if (group_commit) {
+        return this->stage_update_(persistent_db_staged_updates_, tag, num_pairs, keys, values,
+                                   value_size);
+      }
       // For persistent, we always insert.
       return insert_fn(persistent_db_.get(), tag, num_pairs, keys, values, value_size);
     });
   }
+
+  if (group_commit && (volatile_db_source_ || persistent_db_source_) &&
+      !group_commit_worker_.joinable()) {
+    const std::chrono::milliseconds staleness_bound(
+        inference_params.update_source.group_commit_staleness_ms);
+    group_commit_worker_ = std::thread([this, staleness_bound]() {
+      while (!group_commit_terminate_) {
+        std::this_thread::sleep_for(staleness_bound);
+        apply_staged_updates_();
+      }
+    });
+  }
+}
+
+template <typename TypeHashKey>
+void HierParameterServer<TypeHashKey>::ingest_model_table(
+    const std::string& model_name, const std::string& table_name, const size_t num_pairs,
+    const void* const keys, const size_t key_size_bytes, const float* const vectors,
+    const size_t embedding_vec_size) {
+  // Validate the shard against the model manifest before touching any database.
+  if (key_size_bytes != sizeof(TypeHashKey)) {
+    HCTR_OWN_THROW(Error_t::WrongInput, "Key width " + std::to_string(key_size_bytes) +
+                                            " doesn't match the key type of this parameter "
+                                            "server (" +
+                                            std::to_string(sizeof(TypeHashKey)) + " bytes).");
+  }
+  const auto table_names_it = ps_config_.emb_table_name_.find(model_name);
+  if (table_names_it == ps_config_.emb_table_name_.end()) {
+    HCTR_OWN_THROW(Error_t::WrongInput,
+                   "Model " + model_name + " is not registered with this parameter server.");
+  }
+  const auto& table_names = table_names_it->second;
+  size_t table_id = 0;
+  while (table_id < table_names.size() && table_names[table_id] != table_name) {
+    table_id++;
+  }
+  if (table_id == table_names.size()) {
+    HCTR_OWN_THROW(Error_t::WrongInput,
+                   "Model " + model_name + " has no embedding table named " + table_name + ".");
+  }
+  const size_t expected_vec_size = ps_config_.embedding_vec_size_.at(model_name)[table_id];
+  if (embedding_vec_size != expected_vec_size) {
+    HCTR_OWN_THROW(Error_t::WrongInput,
+                   "Embedding vector size " + std::to_string(embedding_vec_size) + " of table " +
+                       table_name + " doesn't match the configured size " +
+                       std::to_string(expected_vec_size) + ".");
+  }
+
+  const std::string tag_name = make_tag_name(model_name, table_name);
+  const auto* const typed_keys = reinterpret_cast<const TypeHashKey*>(keys);
+  const auto* const values = reinterpret_cast<const char*>(vectors);
+
+  // Populate volatile database(s), subject to the configured cache rate.
+  if (volatile_db_) {
+    const size_t volatile_capacity = volatile_db_->capacity(tag_name);
+    const size_t volatile_cache_amount =
+        (num_pairs <= volatile_capacity)
+            ? num_pairs
+            : static_cast<size_t>(volatile_db_cache_rate_ *
+                                      static_cast<double>(volatile_capacity) +
+                                  0.5);
+    HCTR_CHECK(volatile_db_->insert(tag_name, volatile_cache_amount, typed_keys, values,
+                                    embedding_vec_size * sizeof(float)));
+    volatile_db_->synchronize();
+    HCTR_LOG_S(INFO, WORLD) << "Table: " << tag_name << "; ingested " << volatile_cache_amount
+                            << " / " << num_pairs << " embeddings into volatile database ("
+                            << volatile_db_->get_name() << ")." << std::endl;
+  }
+
+  // Persistent database - by definition - always gets all keys.
+  if (persistent_db_) {
+    HCTR_CHECK(persistent_db_->insert(tag_name, num_pairs, typed_keys, values,
+                                      embedding_vec_size * sizeof(float)));
+    HCTR_LOG_S(INFO, WORLD) << "Table: " << tag_name << "; ingested " << num_pairs
+                            << " embeddings into persistent database ("
+                            << persistent_db_->get_name() << ")." << std::endl;
+  }
+}
+
+template <typename TypeHashKey>
+bool HierParameterServer<TypeHashKey>::stage_update_(UpdateStagingBuffer& staging,
+                                                     const std::string& tag,
+                                                     const size_t num_pairs,
+                                                     const TypeHashKey* const keys,
+                                                     const char* const values,
+                                                     const size_t value_size) {
+  std::lock_guard<std::mutex> lock(staged_updates_guard_);
+  auto& [staged_value_size, staged_keys, staged_values] = staging[tag];
+  if (staged_keys.empty()) {
+    staged_value_size = value_size;
+  } else if (staged_value_size != value_size) {
+    // Cannot mix value sizes within one batched insert. Reject, so the source backs off and
+    // redelivers after the next flush has drained the staging buffer.
+    return false;
+  }
+  staged_keys.insert(staged_keys.end(), keys, &keys[num_pairs]);
+  staged_values.insert(staged_values.end(), values, &values[num_pairs * value_size]);
+  return true;
+}
+
+template <typename TypeHashKey>
+void HierParameterServer<TypeHashKey>::apply_staged_updates_() {
+  // Move the staged data out under the lock, then insert without holding it, so that staging
+  // remains cheap for the message sources.
+  UpdateStagingBuffer volatile_staged;
+  UpdateStagingBuffer persistent_staged;
+  {
+    std::lock_guard<std::mutex> lock(staged_updates_guard_);
+    volatile_staged.swap(volatile_db_staged_updates_);
+    persistent_staged.swap(persistent_db_staged_updates_);
+  }
+
+  auto apply_fn = [](DatabaseBackend<TypeHashKey>* const db, UpdateStagingBuffer& staged) {
+    for (auto& staged_it : staged) {
+      const auto& [value_size, keys, values] = staged_it.second;
+      if (keys.empty()) {
+        continue;
+      }
+      HCTR_LOG(DEBUG, WORLD,
+               "Database \"%s\" group commit for tag: \"%s\", num_pairs: %zu, value_size: %zu "
+               "bytes\n",
+               db->get_name(), staged_it.first.c_str(), keys.size(), value_size);
+      try {
+        db->insert(staged_it.first, keys.size(), keys.data(), values.data(), value_size);
+      } catch (const std::exception& e) {
+        HCTR_LOG_S(ERROR, WORLD) << "Group commit to database \"" << db->get_name()
+                                 << "\" failed: " << e.what() << std::endl;
+      }
+    }
+  };
+  if (volatile_db_) {
+    apply_fn(volatile_db_.get(), volatile_staged);
+  }
+  if (persistent_db_) {
+    apply_fn(persistent_db_.get(), persistent_staged);
+  }
+}
+
+template <typename TypeHashKey>
+void HierParameterServer<TypeHashKey>::arbitrate_cache_memory_() {
+  // One arbitration round per device: the model with the most cache misses since the last round
+  // may take capacity from a co-located model that is (nearly) idle in comparison.
+  constexpr float min_cache_percentage = 0.05f;
+  constexpr float donor_shrink_factor = 0.8f;
+  constexpr size_t idle_traffic_ratio = 10;
+
+  struct ModelTraffic {
+    std::string model_name;
+    std::shared_ptr<EmbeddingCacheBase> cache;
+    size_t num_queries;
+    size_t num_misses;
+  };
+  std::map<int64_t, std::vector<ModelTraffic>> traffic_per_device;
+  for (auto& model_it : model_cache_map_) {
+    for (auto& device_it : model_it.second) {
+      if (!device_it.second->use_gpu_embedding_cache()) {
+        continue;
+      }
+      const auto [num_queries, num_misses] = device_it.second->get_and_reset_lookup_stats();
+      traffic_per_device[device_it.first].push_back(
+          {model_it.first, device_it.second, num_queries, num_misses});
+    }
+  }
+
+  for (auto& [device_id, traffic] : traffic_per_device) {
+    if (traffic.size() < 2) {
+      continue;
+    }
+    auto receiver_it = std::max_element(
+        traffic.begin(), traffic.end(),
+        [](const ModelTraffic& a, const ModelTraffic& b) { return a.num_misses < b.num_misses; });
+    if (receiver_it->num_misses == 0) {
+      continue;
+    }
+    // The donor is the least-queried model, and only qualifies if its traffic is negligible next
+    // to the receiver's and its cache still has headroom above the floor to give away.
+    auto donor_it = std::min_element(
+        traffic.begin(), traffic.end(),
+        [](const ModelTraffic& a, const ModelTraffic& b) { return a.num_queries < b.num_queries; });
+    const float donor_pct = donor_it->cache->get_cache_config().cache_size_percentage_;
+    if (donor_it == receiver_it ||
+        donor_it->num_queries * idle_traffic_ratio >= receiver_it->num_queries ||
+        donor_pct * donor_shrink_factor < min_cache_percentage) {
+      continue;
+    }
+
+    // Convert the donated share into bytes so that the receiver grows by the same amount of GPU
+    // memory even when the two models cache tables of different shapes.
+    auto cache_bytes_per_percentage = [](const embedding_cache_config& config) {
+      double bytes = 0.;
+      for (size_t i = 0; i < config.num_emb_table_; i++) {
+        bytes += static_cast<double>(config.num_set_in_cache_[i]) *
+                 config.set_associativity_per_table_[i] * SLAB_SIZE *
+                 config.embedding_vec_size_[i] * sizeof(float) / config.cache_size_percentage_;
+      }
+      return bytes;
+    };
+    const double donated_bytes =
+        cache_bytes_per_percentage(donor_it->cache->get_cache_config()) * donor_pct *
+        (1.f - donor_shrink_factor);
+    const embedding_cache_config& receiver_config = receiver_it->cache->get_cache_config();
+    const float receiver_pct = receiver_config.cache_size_percentage_;
+    const float receiver_new_pct = std::min(
+        1.f, receiver_pct + static_cast<float>(donated_bytes /
+                                               cache_bytes_per_percentage(receiver_config)));
+    if (receiver_new_pct <= receiver_pct) {
+      continue;
+    }
+
+    HCTR_LOG_S(INFO, WORLD) << "Cache arbitration on device " << device_id << ": model "
+                            << donor_it->model_name << " (" << donor_it->num_queries
+                            << " queries) donates to model " << receiver_it->model_name << " ("
+                            << receiver_it->num_queries << " queries, " << receiver_it->num_misses
+                            << " misses); cache shares " << donor_pct << " -> "
+                            << donor_pct * donor_shrink_factor << " and " << receiver_pct << " -> "
+                            << receiver_new_pct << std::endl;
+    try {
+      // Shrink the donor first so that the GPU memory is available before the receiver grows.
+      donor_it->cache->resize(donor_pct * donor_shrink_factor);
+      receiver_it->cache->resize(receiver_new_pct);
+    } catch (const std::runtime_error& e) {
+      HCTR_LOG_S(ERROR, WORLD) << "Cache arbitration on device " << device_id
+                               << " failed: " << e.what() << std::endl;
+    }
+  }
 }
 
 template <typename TypeHashKey>
@@ -373,6 +674,42 @@ void HierParameterServer<TypeHashKey>::init_ec(
                     inference_params.sparse_model_files[j]);
     HCTR_LOG(INFO, ROOT, "EC initialization for model: \"%s\", num_tables: %d\n",
              inference_params.model_name.c_str(), inference_params.sparse_model_files.size());
+
+    // Hotness-ranked warm start: if per-key access frequencies were persisted next to the table
+    // (a "key_freq" file parallel to "key", one int64 count per key), fill the cache with the
+    // hottest keys first instead of file order, so the first requests after a deploy do not pay
+    // the full miss cost. Without the file the sequential behavior is kept.
+    std::vector<size_t> hot_order;
+    const std::string freq_file = inference_params.sparse_model_files[j] + "/key_freq";
+    if (std::filesystem::exists(freq_file)) {
+      const size_t num_key = rawreader->getkeycount();
+      if (std::filesystem::file_size(freq_file) == num_key * sizeof(long long)) {
+        std::vector<long long> freq(num_key);
+        std::ifstream freq_stream(freq_file, std::ifstream::binary);
+        freq_stream.read(reinterpret_cast<char*>(freq.data()), num_key * sizeof(long long));
+        // Only the prefix that actually fits in the cache needs to be ordered.
+        const embedding_cache_config& any_config =
+            embedding_cache_map.begin()->second->get_cache_config();
+        const size_t warm_capacity = std::min(
+            num_key, any_config.num_set_in_cache_[j] * any_config.set_associativity_per_table_[j] *
+                         SLAB_SIZE);
+        hot_order.resize(num_key);
+        std::iota(hot_order.begin(), hot_order.end(), (size_t)0);
+        std::partial_sort(hot_order.begin(), hot_order.begin() + warm_capacity, hot_order.end(),
+                          [&freq](size_t a, size_t b) { return freq[a] > freq[b]; });
+        HCTR_LOG_S(INFO, ROOT) << "EC warm start for table \""
+                               << inference_params.embedding_table_names[j] << "\": the "
+                               << warm_capacity << " hottest of " << num_key
+                               << " keys go in first" << std::endl;
+      } else {
+        HCTR_LOG_S(WARNING, ROOT) << freq_file
+                                  << " does not match the key count, falling back to file order"
+                                  << std::endl;
+      }
+    }
+    std::vector<TypeHashKey> staging_keys;
+    std::vector<float> staging_vecs;
+
     for (auto device_id : inference_params.deployed_devices) {
       HCTR_LOG(INFO, ROOT, "EC initialization on device: %d\n", device_id);
       cudaStream_t stream = embedding_cache_map[device_id]->get_refresh_streams()[j];
@@ -387,25 +724,50 @@ void HierParameterServer<TypeHashKey>::init_ec(
       // initilize the embedding cache for each table
       const size_t stride_set = floor(cache_config.num_set_in_cache_[j] *
                                       cache_config.cache_refresh_percentage_per_iteration);
-      size_t length = SLAB_SIZE * SET_ASSOCIATIVITY * stride_set;
+      size_t length = SLAB_SIZE * cache_config.set_associativity_per_table_[j] * stride_set;
       size_t num_iteration = 0;
       for (size_t idx_set = 0; idx_set + stride_set < cache_config.num_set_in_cache_[j];
            idx_set += stride_set) {
         refreshspace_handler.h_length_ = &length;
-        // copy the embedding keys from reader to refresh space
-        HCTR_LIB_THROW(cudaMemcpyAsync(refreshspace_handler.d_refresh_embeddingcolumns_,
-                                       reinterpret_cast<const TypeHashKey*>(rawreader->getkeys()) +
-                                           (*refreshspace_handler.h_length_ * num_iteration),
-                                       *refreshspace_handler.h_length_ * sizeof(TypeHashKey),
-                                       cudaMemcpyHostToDevice, stream));
-        // copy the embedding vectors from reader to refresh space
-        HCTR_LIB_THROW(cudaMemcpyAsync(
-            refreshspace_handler.d_refresh_emb_vec_,
-            reinterpret_cast<const float*>(rawreader->getvectors()) +
-                (*refreshspace_handler.h_length_ * num_iteration *
-                 cache_config.embedding_vec_size_[j]),
-            *refreshspace_handler.h_length_ * cache_config.embedding_vec_size_[j] * sizeof(float),
-            cudaMemcpyHostToDevice, stream));
+        if (hot_order.empty()) {
+          // copy the embedding keys from reader to refresh space
+          HCTR_LIB_THROW(cudaMemcpyAsync(
+              refreshspace_handler.d_refresh_embeddingcolumns_,
+              reinterpret_cast<const TypeHashKey*>(rawreader->getkeys()) +
+                  (*refreshspace_handler.h_length_ * num_iteration),
+              *refreshspace_handler.h_length_ * sizeof(TypeHashKey), cudaMemcpyHostToDevice,
+              stream));
+          // copy the embedding vectors from reader to refresh space
+          HCTR_LIB_THROW(cudaMemcpyAsync(
+              refreshspace_handler.d_refresh_emb_vec_,
+              reinterpret_cast<const float*>(rawreader->getvectors()) +
+                  (*refreshspace_handler.h_length_ * num_iteration *
+                   cache_config.embedding_vec_size_[j]),
+              *refreshspace_handler.h_length_ * cache_config.embedding_vec_size_[j] * sizeof(float),
+              cudaMemcpyHostToDevice, stream));
+        } else {
+          // gather the keys and vectors in hotness order through a host staging buffer
+          const size_t vec_size = cache_config.embedding_vec_size_[j];
+          const size_t offset = length * num_iteration;
+          if (offset + length > hot_order.size()) {
+            break;  // fewer ranked keys than cache capacity, the rest stays cold
+          }
+          const auto* keys_ptr = reinterpret_cast<const TypeHashKey*>(rawreader->getkeys());
+          const auto* vecs_ptr = reinterpret_cast<const float*>(rawreader->getvectors());
+          staging_keys.resize(length);
+          staging_vecs.resize(length * vec_size);
+          for (size_t idx = 0; idx < length; idx++) {
+            const size_t src = hot_order[offset + idx];
+            staging_keys[idx] = keys_ptr[src];
+            std::copy_n(&vecs_ptr[src * vec_size], vec_size, &staging_vecs[idx * vec_size]);
+          }
+          HCTR_LIB_THROW(cudaMemcpyAsync(refreshspace_handler.d_refresh_embeddingcolumns_,
+                                         staging_keys.data(), length * sizeof(TypeHashKey),
+                                         cudaMemcpyHostToDevice, stream));
+          HCTR_LIB_THROW(cudaMemcpyAsync(refreshspace_handler.d_refresh_emb_vec_,
+                                         staging_vecs.data(), length * vec_size * sizeof(float),
+                                         cudaMemcpyHostToDevice, stream));
+        }
 
         embedding_cache_map[device_id]->init(j, refreshspace_handler, stream);
         HCTR_LIB_THROW(cudaStreamSynchronize(stream));
@@ -634,6 +996,54 @@ void HierParameterServer<TypeHashKey>::lookup(const void* const h_keys, const si
 #endif
 }
 
+template <typename TypeHashKey>
+void HierParameterServer<TypeHashKey>::lookup(const std::vector<const void*>& h_keys_per_table,
+                                              const std::vector<size_t>& lengths_per_table,
+                                              const std::vector<float*>& h_vectors_per_table,
+                                              const std::string& model_name) {
+  HCTR_CHECK_HINT(h_keys_per_table.size() == lengths_per_table.size() &&
+                      h_keys_per_table.size() == h_vectors_per_table.size(),
+                  "Error: parameter server gather-lookup argument count mismatch!\n");
+
+  const size_t num_tables = h_keys_per_table.size();
+  if (!num_tables) {
+    return;
+  }
+  const auto start_time = std::chrono::high_resolution_clock::now();
+
+  // Fan out all tables' key sets in one pass. Each backend already coalesces its own requests
+  // (Redis pipelines, RocksDB MultiGet), so issuing the per-table fetches concurrently collapses
+  // the former one-round-trip-per-table sequence into a single overlapped batch.
+  //
+  // The per-table tasks must not run on the default pool: a table lookup reaches backends that
+  // submit their own nested batches to that pool and block on them, and a worker blocked inside a
+  // task never picks up queued work. Once gather tasks occupy every default worker, the nested
+  // batches can never be scheduled and the lookup hangs, so the fan-out gets a dedicated pool.
+  static ThreadPool gather_pool("ps_gather");
+  std::vector<std::future<void>> tasks;
+  tasks.reserve(num_tables);
+
+  for (size_t table_id = 0; table_id < num_tables; table_id++) {
+    if (!lengths_per_table[table_id]) {
+      continue;
+    }
+    tasks.emplace_back(gather_pool.submit([this, &h_keys_per_table, &lengths_per_table,
+                                           &h_vectors_per_table, &model_name, table_id]() {
+      this->lookup(h_keys_per_table[table_id], lengths_per_table[table_id],
+                   h_vectors_per_table[table_id], model_name, table_id);
+    }));
+  }
+  ThreadPool::await(tasks.begin(), tasks.end());
+
+  const auto end_time = std::chrono::high_resolution_clock::now();
+  const auto duration =
+      std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+#ifdef ENABLE_INFERENCE
+  HCTR_LOG_S(TRACE, WORLD) << "Parameter server gather-lookup across " << num_tables
+                           << " tables took " << duration.count() << " us." << std::endl;
+#endif
+}
+
 template <typename TypeHashKey>
 void HierParameterServer<TypeHashKey>::refresh_embedding_cache(const std::string& model_name,
                                                                const int device_id) {
@@ -656,62 +1066,121 @@ void HierParameterServer<TypeHashKey>::refresh_embedding_cache(const std::string
   }
   timer_refresh.start();
   std::vector<cudaStream_t> streams = embedding_cache->get_refresh_streams();
-  // apply the memory block for embedding cache refresh workspace
-  MemoryBlock* memory_block = nullptr;
-  while (memory_block == nullptr) {
-    memory_block = reinterpret_cast<MemoryBlock*>(
-        this->apply_buffer(model_name, device_id, CACHE_SPACE_TYPE::REFRESHER));
-  }
-  EmbeddingCacheRefreshspace refreshspace_handler = memory_block->refresh_buffer;
   // Refresh the embedding cache for each table
   const size_t stride_set = cache_config.num_set_in_refresh_workspace_;
-  HugeCTR::Timer timer;
+
+  // QoS pacing: with HCTR_REFRESH_SLA_US set, each refresh chunk only starts while the
+  // cache's recent lookup latency is under the target, so the sweep yields to serving
+  // traffic instead of competing with it. HCTR_REFRESH_DEADLINE_SEC (default 600) bounds
+  // the total wall-clock of the sweep: once it passes, the remaining chunks run
+  // unconditionally so the cache never stays stale longer than the deadline.
+  const char* sla_str = std::getenv("HCTR_REFRESH_SLA_US");
+  const long sla_us = sla_str ? atol(sla_str) : 0;
+  const char* deadline_str = std::getenv("HCTR_REFRESH_DEADLINE_SEC");
+  const long deadline_sec = std::max(1l, deadline_str ? atol(deadline_str) : 600);
+  const auto refresh_deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(deadline_sec);
+  size_t total_chunks{0};
+  std::atomic<size_t> done_chunks{0};
   for (size_t i = 0; i < cache_config.num_emb_table_; i++) {
-    for (size_t idx_set = 0; idx_set < cache_config.num_set_in_cache_[i]; idx_set += stride_set) {
-      const size_t end_idx = (idx_set + stride_set > cache_config.num_set_in_cache_[i])
-                                 ? cache_config.num_set_in_cache_[i]
-                                 : idx_set + stride_set;
-      timer.start();
-      embedding_cache->dump(i, refreshspace_handler.d_refresh_embeddingcolumns_,
-                            refreshspace_handler.d_length_, idx_set, end_idx, streams[i]);
-
-      HCTR_LIB_THROW(cudaMemcpyAsync(refreshspace_handler.h_length_, refreshspace_handler.d_length_,
-                                     sizeof(size_t), cudaMemcpyDeviceToHost, streams[i]));
-      HCTR_LIB_THROW(cudaStreamSynchronize(streams[i]));
-      HCTR_LIB_THROW(cudaMemcpyAsync(refreshspace_handler.h_refresh_embeddingcolumns_,
-                                     refreshspace_handler.d_refresh_embeddingcolumns_,
-                                     *refreshspace_handler.h_length_ * sizeof(TypeHashKey),
-                                     cudaMemcpyDeviceToHost, streams[i]));
-      HCTR_LIB_THROW(cudaStreamSynchronize(streams[i]));
-      timer.stop();
-      HCTR_LOG_S(INFO, ROOT) << "Embedding Cache dumping the number of " << stride_set
-                             << " sets takes: " << timer.elapsedSeconds() << "s" << std::endl;
-      timer.start();
-      this->lookup(
-          reinterpret_cast<const TypeHashKey*>(refreshspace_handler.h_refresh_embeddingcolumns_),
-          *refreshspace_handler.h_length_, refreshspace_handler.h_refresh_emb_vec_, model_name, i);
-      HCTR_LIB_THROW(cudaMemcpyAsync(
-          refreshspace_handler.d_refresh_emb_vec_, refreshspace_handler.h_refresh_emb_vec_,
-          *refreshspace_handler.h_length_ * cache_config.embedding_vec_size_[i] * sizeof(float),
-          cudaMemcpyHostToDevice, streams[i]));
-      HCTR_LIB_THROW(cudaStreamSynchronize(streams[i]));
-      timer.stop();
-      HCTR_LOG_S(INFO, ROOT) << "Parameter Server looking up the number of "
-                             << *refreshspace_handler.h_length_
-                             << " keys takes: " << timer.elapsedSeconds() << "s" << std::endl;
-      timer.start();
-      embedding_cache->refresh(
-          static_cast<int>(i), refreshspace_handler.d_refresh_embeddingcolumns_,
-          refreshspace_handler.d_refresh_emb_vec_, *refreshspace_handler.h_length_, streams[i]);
-      timer.stop();
-      HCTR_LOG_S(INFO, ROOT) << "Embedding Cache refreshing the number of "
-                             << *refreshspace_handler.h_length_
-                             << " keys takes: " << timer.elapsedSeconds() << "s" << std::endl;
-      HCTR_LIB_THROW(cudaStreamSynchronize(streams[i]));
-    }
+    total_chunks += (cache_config.num_set_in_cache_[i] + stride_set - 1) / stride_set;
+  }
+
+  // Per-table refresh workers (HCTR_REFRESH_WORKERS, default 4): every worker acquires its own
+  // refresh workspace from the REFRESHER pool and sweeps one table on that table's refresh
+  // stream, so the dump / lookup / replace pipelines of independent tables overlap instead of
+  // running back to back. Concurrency is bounded by the worker budget and by the number of
+  // REFRESHER memory blocks; a worker that cannot get a workspace simply waits for one, exactly
+  // like the former single sweep did.
+  const char* workers_str = std::getenv("HCTR_REFRESH_WORKERS");
+  const size_t num_workers = std::min<size_t>(std::max<size_t>(cache_config.num_emb_table_, 1),
+                                              std::max(1l, workers_str ? atol(workers_str) : 4));
+  ThreadPool refresh_pool("ec_refresh", num_workers);
+  std::vector<std::future<void>> refresh_tasks;
+  refresh_tasks.reserve(cache_config.num_emb_table_);
+
+  for (size_t i = 0; i < cache_config.num_emb_table_; i++) {
+    refresh_tasks.emplace_back(refresh_pool.submit([&, i]() {
+      CudaDeviceContext dev_restorer;
+      HCTR_LIB_THROW(cudaSetDevice(device_id));
+
+      // apply the memory block for embedding cache refresh workspace
+      MemoryBlock* memory_block = nullptr;
+      while (memory_block == nullptr) {
+        memory_block = reinterpret_cast<MemoryBlock*>(
+            this->apply_buffer(model_name, device_id, CACHE_SPACE_TYPE::REFRESHER));
+      }
+      EmbeddingCacheRefreshspace refreshspace_handler = memory_block->refresh_buffer;
+
+      try {
+        HugeCTR::Timer timer;
+        for (size_t idx_set = 0; idx_set < cache_config.num_set_in_cache_[i];
+             idx_set += stride_set) {
+          if (sla_us > 0) {
+            while (embedding_cache->get_recent_lookup_latency_us() > sla_us &&
+                   std::chrono::steady_clock::now() < refresh_deadline) {
+              std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+          }
+          const size_t end_idx = (idx_set + stride_set > cache_config.num_set_in_cache_[i])
+                                     ? cache_config.num_set_in_cache_[i]
+                                     : idx_set + stride_set;
+          timer.start();
+          embedding_cache->dump(i, refreshspace_handler.d_refresh_embeddingcolumns_,
+                                refreshspace_handler.d_length_, idx_set, end_idx, streams[i]);
+
+          HCTR_LIB_THROW(cudaMemcpyAsync(refreshspace_handler.h_length_,
+                                         refreshspace_handler.d_length_, sizeof(size_t),
+                                         cudaMemcpyDeviceToHost, streams[i]));
+          HCTR_LIB_THROW(cudaStreamSynchronize(streams[i]));
+          HCTR_LIB_THROW(cudaMemcpyAsync(refreshspace_handler.h_refresh_embeddingcolumns_,
+                                         refreshspace_handler.d_refresh_embeddingcolumns_,
+                                         *refreshspace_handler.h_length_ * sizeof(TypeHashKey),
+                                         cudaMemcpyDeviceToHost, streams[i]));
+          HCTR_LIB_THROW(cudaStreamSynchronize(streams[i]));
+          timer.stop();
+          HCTR_LOG_S(INFO, ROOT) << "Embedding Cache dumping the number of " << stride_set
+                                 << " sets takes: " << timer.elapsedSeconds() << "s" << std::endl;
+          timer.start();
+          this->lookup(reinterpret_cast<const TypeHashKey*>(
+                           refreshspace_handler.h_refresh_embeddingcolumns_),
+                       *refreshspace_handler.h_length_, refreshspace_handler.h_refresh_emb_vec_,
+                       model_name, i);
+          HCTR_LIB_THROW(cudaMemcpyAsync(
+              refreshspace_handler.d_refresh_emb_vec_, refreshspace_handler.h_refresh_emb_vec_,
+              *refreshspace_handler.h_length_ * cache_config.embedding_vec_size_[i] * sizeof(float),
+              cudaMemcpyHostToDevice, streams[i]));
+          HCTR_LIB_THROW(cudaStreamSynchronize(streams[i]));
+          timer.stop();
+          HCTR_LOG_S(INFO, ROOT) << "Parameter Server looking up the number of "
+                                 << *refreshspace_handler.h_length_
+                                 << " keys takes: " << timer.elapsedSeconds() << "s" << std::endl;
+          timer.start();
+          embedding_cache->refresh(
+              static_cast<int>(i), refreshspace_handler.d_refresh_embeddingcolumns_,
+              refreshspace_handler.d_refresh_emb_vec_, *refreshspace_handler.h_length_, streams[i]);
+          timer.stop();
+          HCTR_LOG_S(INFO, ROOT) << "Embedding Cache refreshing the number of "
+                                 << *refreshspace_handler.h_length_
+                                 << " keys takes: " << timer.elapsedSeconds() << "s" << std::endl;
+          HCTR_LIB_THROW(cudaStreamSynchronize(streams[i]));
+          done_chunks++;
+          if (sla_us > 0) {
+            HCTR_LOG_S(INFO, ROOT) << "Embedding cache refresh progress: " << done_chunks << "/"
+                                   << total_chunks << " chunks" << std::endl;
+          }
+        }
+      } catch (...) {
+        this->free_buffer(memory_block);
+        throw;
+      }
+      this->free_buffer(memory_block);
+    }));
+  }
+  // get() instead of wait() so that a failed table sweep surfaces its exception here.
+  for (auto& task : refresh_tasks) {
+    task.get();
   }
-  // apply the memory block for embedding cache refresh workspace
-  this->free_buffer(memory_block);
   timer_refresh.stop();
   HCTR_LOG_S(INFO, ROOT) << "The total Time of embedding cache refresh is : "
                          << timer_refresh.elapsedSeconds() << "s" << std::endl;
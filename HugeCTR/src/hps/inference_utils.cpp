@@ -47,10 +47,12 @@ bool VolatileDatabaseParams::operator==(const VolatileDatabaseParams& p) const {
          address == p.address && user_name == p.user_name && password == p.password &&
          num_partitions == p.num_partitions && allocation_rate == p.allocation_rate &&
          max_get_batch_size == p.max_get_batch_size && max_set_batch_size == p.max_set_batch_size &&
+         shared_memory_name == p.shared_memory_name && shared_memory_size == p.shared_memory_size &&
          // Overflow handling related.
          refresh_time_after_fetch == p.refresh_time_after_fetch &&
          overflow_margin == p.overflow_margin && overflow_policy == p.overflow_policy &&
          overflow_resolution_target == p.overflow_resolution_target &&
+         expiry_seconds == p.expiry_seconds &&
          // Caching behavior related.
          initial_cache_rate == p.initial_cache_rate &&
          cache_missed_embeddings == p.cache_missed_embeddings &&
@@ -79,7 +81,8 @@ bool UpdateSourceParams::operator==(const UpdateSourceParams& p) const {
          brokers == p.brokers && metadata_refresh_interval_ms == p.metadata_refresh_interval_ms &&
          receive_buffer_size == p.receive_buffer_size && poll_timeout_ms == p.poll_timeout_ms &&
          max_batch_size == p.max_batch_size && failure_backoff_ms == p.failure_backoff_ms &&
-         max_commit_interval == p.max_commit_interval;
+         max_commit_interval == p.max_commit_interval && group_commit == p.group_commit &&
+         group_commit_staleness_ms == p.group_commit_staleness_ms;
 }
 bool UpdateSourceParams::operator!=(const UpdateSourceParams& p) const { return !operator==(p); }
 
@@ -92,6 +95,7 @@ VolatileDatabaseParams::VolatileDatabaseParams(
     // Overflow handling related.
     const bool refresh_time_after_fetch, const size_t overflow_margin,
     const DatabaseOverflowPolicy_t overflow_policy, const double overflow_resolution_target,
+    const size_t expiry_seconds,
     // Caching behavior related.
     const double initial_cache_rate, const bool cache_missed_embeddings,
     // Real-time update mechanism related.
@@ -110,6 +114,7 @@ VolatileDatabaseParams::VolatileDatabaseParams(
       overflow_margin(overflow_margin),
       overflow_policy(overflow_policy),
       overflow_resolution_target(overflow_resolution_target),
+      expiry_seconds(expiry_seconds),
       // Caching behavior related.
       initial_cache_rate(initial_cache_rate),
       cache_missed_embeddings(cache_missed_embeddings),
@@ -268,6 +273,11 @@ void parameter_server_config::init(const std::string& hps_json_config_file) {
 
     params.max_commit_interval =
         get_value_from_json_soft<size_t>(update_source, "max_commit_interval", 32);
+
+    params.group_commit = get_value_from_json_soft<bool>(update_source, "group_commit", false);
+
+    params.group_commit_staleness_ms =
+        get_value_from_json_soft<size_t>(update_source, "group_commit_staleness_ms", 1'000);
   }
   // Persistent database parameters.
   PersistentDatabaseParams persistent_db_params;
@@ -325,6 +335,12 @@ void parameter_server_config::init(const std::string& hps_json_config_file) {
     params.max_set_batch_size =
         get_value_from_json_soft<size_t>(volatile_db, "max_set_batch_size", 10'000);
 
+    params.shared_memory_name = get_value_from_json_soft<std::string>(
+        volatile_db, "shared_memory_name", "hps_shared_memory");
+
+    params.shared_memory_size = get_value_from_json_soft<size_t>(
+        volatile_db, "shared_memory_size", 16UL * 1024 * 1024 * 1024);
+
     // Overflow handling related.
     params.refresh_time_after_fetch =
         get_value_from_json_soft<bool>(volatile_db, "refresh_time_after_fetch", false);
@@ -336,6 +352,8 @@ void parameter_server_config::init(const std::string& hps_json_config_file) {
     params.overflow_resolution_target =
         get_value_from_json_soft<double>(volatile_db, "overflow_resolution_target", 0.8);
 
+    params.expiry_seconds = get_value_from_json_soft<size_t>(volatile_db, "expiry_seconds", 0);
+
     // Caching behavior related.
     params.initial_cache_rate =
         get_value_from_json_soft<double>(volatile_db, "initial_cache_rate", 1.0);
@@ -407,6 +425,29 @@ void parameter_server_config::init(const std::string& hps_json_config_file) {
     params.cache_refresh_percentage_per_iteration =
         get_value_from_json_soft<float>(model, "cache_refresh_percentage_per_iteration", 0);
 
+    // Background query-history-driven prefetch into the GPU embedding cache.
+    params.enable_cache_prefetch =
+        get_value_from_json_soft<bool>(model, "enable_cache_prefetch", false);
+    params.cache_prefetch_interval =
+        get_value_from_json_soft<float>(model, "cache_prefetch_interval", 1.0);
+
+    // Optional second GPU-memory cache tier between the GPU embedding cache and the CPU backends.
+    params.use_l2_gpu_cache = get_value_from_json_soft<bool>(model, "gpucachel2", false);
+    params.l2_cache_size_percentage = get_value_from_json_soft<float>(model, "gpucachel2per", 0.0);
+
+    // Per-table set associativity of the GPU embedding cache (2/4/8/16-way).
+    params.gpu_cache_set_associativity.clear();
+    if (model.find("gpucache_set_associativity") != model.end()) {
+      auto gpu_cache_set_associativity = get_json(model, "gpucache_set_associativity");
+      if (gpu_cache_set_associativity.is_array()) {
+        for (size_t table_index = 0; table_index < gpu_cache_set_associativity.size();
+             ++table_index) {
+          params.gpu_cache_set_associativity.emplace_back(
+              gpu_cache_set_associativity[table_index].get<size_t>());
+        }
+      }
+    }
+
     // [11] deployed_device_list -> std::vector<int>
     auto deployed_device_list = get_json(model, "deployed_device_list");
     params.deployed_devices.clear();
@@ -654,6 +695,13 @@ HugeCTR::DatabaseType_t get_hps_database_type(const nlohmann::json& json, const
 
   enum_value = HugeCTR::DatabaseType_t::ParallelHashMap;
   names = {hctr_enum_to_c_str(enum_value), "parallel_hashmap", "parallel_hash", "parallel_map"};
+  for (const char* name : names)
+    if (tmp == name) {
+      return enum_value;
+    }
+
+  enum_value = HugeCTR::DatabaseType_t::MultiProcessHashMap;
+  names = {hctr_enum_to_c_str(enum_value), "multi_process_hashmap", "multi_process", "shared_memory"};
   for (const char* name : names)
     if (tmp == name) {
       return enum_value;
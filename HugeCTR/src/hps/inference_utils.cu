@@ -93,4 +93,24 @@ void decompress_emb_vec_async(const float* d_unique_src_ptr, const uint64_t* d_u
       d_unique_src_ptr, d_unique_index_ptr, d_decompress_dst_ptr, decompress_len, emb_vec_size);
 }
 
+// Kernels to compose the miss index of the second-level cache with the miss index of the
+// first-level cache, i.e. d_inner_missing_index[i] = d_outer_missing_index[d_inner_missing_index[i]]
+__global__ void compose_missing_index(const uint64_t* d_outer_missing_index,
+                                      uint64_t* d_inner_missing_index, const size_t len) {
+  const size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx < len) {
+    d_inner_missing_index[idx] = d_outer_missing_index[d_inner_missing_index[idx]];
+  }
+}
+
+void compose_missing_index_async(const uint64_t* d_outer_missing_index_ptr,
+                                 uint64_t* d_inner_missing_index_ptr, const size_t missing_len,
+                                 const size_t BLOCK_SIZE, cudaStream_t stream) {
+  if (missing_len == 0) {
+    return;
+  }
+  compose_missing_index<<<((missing_len - 1) / BLOCK_SIZE) + 1, BLOCK_SIZE, 0, stream>>>(
+      d_outer_missing_index_ptr, d_inner_missing_index_ptr, missing_len);
+}
+
 }  // namespace HugeCTR
@@ -14,6 +14,10 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <hps/lookup_session.hpp>
 #include <utils.hpp>
 
@@ -41,10 +45,53 @@ LookupSession::LookupSession(const InferenceParams& inference_params,
              inference_params_.model_name.c_str(), inference_params_.device_id);
 
     CudaDeviceContext context(inference_params_.device_id);
+    // Two lanes per table: online lookups run at the greatest stream priority, batch scoring at
+    // the least, so the hardware scheduler lets small online queries preempt large batch ones.
+    int least_priority{0};
+    int greatest_priority{0};
+    HCTR_LIB_THROW(cudaDeviceGetStreamPriorityRange(&least_priority, &greatest_priority));
     for (size_t idx = 0; idx < inference_params_.sparse_model_files.size(); ++idx) {
       cudaStream_t stream;
-      cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking);
+      cudaStreamCreateWithPriority(&stream, cudaStreamNonBlocking, greatest_priority);
       lookup_streams_.push_back(stream);
+      cudaStreamCreateWithPriority(&stream, cudaStreamNonBlocking, least_priority);
+      batch_lookup_streams_.push_back(stream);
+    }
+
+    if (const char* env = std::getenv("HCTR_BATCH_LOOKUP_CONCURRENCY")) {
+      batch_admission_limit_ = std::max(std::atol(env), 1l);
+    }
+
+    if (const char* env = std::getenv("HCTR_LOOKUP_COALESCE_US")) {
+      coalesce_window_us_ = std::atol(env);
+    }
+    const size_t num_tables = inference_params_.sparse_model_files.size();
+    if (coalesce_window_us_ > 0 &&
+        (inference_params_.maxnum_catfeature_query_per_table_per_sample.size() < num_tables ||
+         inference_params_.embedding_vecsize_per_table.size() < num_tables)) {
+      HCTR_LOG(WARNING, ROOT,
+               "HCTR_LOOKUP_COALESCE_US is ignored because the per-table query capacities or "
+               "vector sizes are unknown\n");
+      coalesce_window_us_ = 0;
+    }
+    if (coalesce_window_us_ > 0) {
+      HCTR_LOG_S(INFO, ROOT) << "Lookup requests will be coalesced within a "
+                             << coalesce_window_us_ << " us window" << std::endl;
+      const size_t key_size =
+          inference_params_.i64_input_key ? sizeof(long long) : sizeof(unsigned int);
+      for (size_t table_id{0}; table_id < num_tables; ++table_id) {
+        const size_t capacity =
+            inference_params_.max_batchsize *
+            inference_params_.maxnum_catfeature_query_per_table_per_sample[table_id];
+        coalesce_capacities_.push_back(capacity);
+        coalesce_queues_.emplace_back(new CoalesceQueue);
+        h_coalesced_keys_.emplace_back(capacity * key_size);
+        float* d_vectors;
+        HCTR_LIB_THROW(cudaMalloc(
+            (void**)&d_vectors,
+            capacity * inference_params_.embedding_vecsize_per_table[table_id] * sizeof(float)));
+        d_coalesced_vectors_.push_back(d_vectors);
+      }
     }
   } catch (const std::runtime_error& rt_err) {
     HCTR_LOG_S(ERROR, WORLD) << rt_err.what() << std::endl;
@@ -55,11 +102,17 @@ LookupSession::LookupSession(const InferenceParams& inference_params,
 
 LookupSession::~LookupSession() {
   CudaDeviceContext context(inference_params_.device_id);
+  for (auto d_vectors : d_coalesced_vectors_) cudaFree(d_vectors);
   for (auto stream : lookup_streams_) cudaStreamDestroy(stream);
+  for (auto stream : batch_lookup_streams_) cudaStreamDestroy(stream);
 }
 
 void LookupSession::lookup(const void* const h_keys, float* const d_vectors, const size_t num_keys,
                            const size_t table_id) {
+  if (coalesce_window_us_ > 0 && num_keys > 0) {
+    lookup_coalesced_(h_keys, d_vectors, num_keys, table_id);
+    return;
+  }
   CudaDeviceContext context(inference_params_.device_id);
   // embedding_cache lookup
   embedding_cache_->lookup(table_id, d_vectors, h_keys, num_keys,
@@ -67,6 +120,132 @@ void LookupSession::lookup(const void* const h_keys, float* const d_vectors, con
   HCTR_LIB_THROW(cudaStreamSynchronize(lookup_streams_[table_id]));
 }
 
+void LookupSession::lookup(const void* const h_keys, float* const d_vectors, const size_t num_keys,
+                           const size_t table_id, const Priority priority) {
+  if (priority == Priority::Low) {
+    lookup_low_priority_(h_keys, d_vectors, num_keys, table_id);
+    return;
+  }
+  lookup(h_keys, d_vectors, num_keys, table_id);
+}
+
+void LookupSession::lookup_low_priority_(const void* const h_keys, float* const d_vectors,
+                                         const size_t num_keys, const size_t table_id) {
+  // Batch scoring skips the coalescing window; its queries are large already. Admission is
+  // bounded so that concurrent batch jobs leave worker buffers for the online lane.
+  {
+    std::unique_lock<std::mutex> lock(batch_admission_mutex_);
+    batch_admission_cv_.wait(lock, [this] { return batch_inflight_ < batch_admission_limit_; });
+    ++batch_inflight_;
+  }
+  try {
+    CudaDeviceContext context(inference_params_.device_id);
+    embedding_cache_->lookup(table_id, d_vectors, h_keys, num_keys,
+                             inference_params_.hit_rate_threshold,
+                             batch_lookup_streams_[table_id]);
+    HCTR_LIB_THROW(cudaStreamSynchronize(batch_lookup_streams_[table_id]));
+  } catch (...) {
+    {
+      std::lock_guard<std::mutex> lock(batch_admission_mutex_);
+      --batch_inflight_;
+    }
+    batch_admission_cv_.notify_one();
+    throw;
+  }
+  {
+    std::lock_guard<std::mutex> lock(batch_admission_mutex_);
+    --batch_inflight_;
+  }
+  batch_admission_cv_.notify_one();
+}
+
+void LookupSession::lookup_coalesced_(const void* const h_keys, float* const d_vectors,
+                                      const size_t num_keys, const size_t table_id) {
+  auto& queue = *coalesce_queues_[table_id];
+  PendingLookup request{h_keys, d_vectors, num_keys};
+
+  std::unique_lock<std::mutex> lock(queue.mutex);
+  queue.requests.push_back(&request);
+  if (queue.leader_active) {
+    // A window is open: let the leader know one more request arrived and wait for the result.
+    queue.cv.notify_all();
+    queue.cv.wait(lock, [&request] { return request.done; });
+    return;
+  }
+
+  // This thread leads the window: wait for followers until the deadline or a full batch.
+  queue.leader_active = true;
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::microseconds(coalesce_window_us_);
+  queue.cv.wait_until(lock, deadline, [this, &queue, table_id] {
+    size_t num_batched_keys{0};
+    for (const auto* req : queue.requests) num_batched_keys += req->num_keys;
+    return num_batched_keys >= coalesce_capacities_[table_id];
+  });
+
+  std::vector<PendingLookup*> batch;
+  batch.swap(queue.requests);
+  queue.leader_active = false;
+  lock.unlock();
+
+  execute_coalesced_(table_id, batch);
+
+  lock.lock();
+  for (auto* req : batch) req->done = true;
+  queue.cv.notify_all();
+}
+
+void LookupSession::execute_coalesced_(const size_t table_id,
+                                       const std::vector<PendingLookup*>& batch) {
+  CudaDeviceContext context(inference_params_.device_id);
+  auto& queue = *coalesce_queues_[table_id];
+  // Serialize the merged queries per table; the next window may already assemble meanwhile.
+  std::lock_guard<std::mutex> exec_lock(queue.exec_mutex);
+
+  const size_t key_size =
+      inference_params_.i64_input_key ? sizeof(long long) : sizeof(unsigned int);
+  const size_t vec_size = inference_params_.embedding_vecsize_per_table[table_id];
+  const size_t capacity = coalesce_capacities_[table_id];
+  const auto stream = lookup_streams_[table_id];
+  char* h_merged_keys = h_coalesced_keys_[table_id].data();
+
+  size_t start{0};
+  while (start < batch.size()) {
+    // a request larger than the staging buffers keeps the direct path
+    if (batch[start]->num_keys > capacity) {
+      embedding_cache_->lookup(table_id, batch[start]->d_vectors, batch[start]->h_keys,
+                               batch[start]->num_keys, inference_params_.hit_rate_threshold,
+                               stream);
+      HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+      ++start;
+      continue;
+    }
+
+    // merge as many consecutive key sets as fit into the staging buffers
+    size_t end{start};
+    size_t num_merged_keys{0};
+    while (end < batch.size() && num_merged_keys + batch[end]->num_keys <= capacity) {
+      memcpy(h_merged_keys + num_merged_keys * key_size, batch[end]->h_keys,
+             batch[end]->num_keys * key_size);
+      num_merged_keys += batch[end]->num_keys;
+      ++end;
+    }
+
+    // one fused cache query, then scatter the vectors back to the request buffers
+    embedding_cache_->lookup(table_id, d_coalesced_vectors_[table_id], h_merged_keys,
+                             num_merged_keys, inference_params_.hit_rate_threshold, stream);
+    size_t vec_offset{0};
+    for (size_t i{start}; i < end; ++i) {
+      HCTR_LIB_THROW(cudaMemcpyAsync(
+          batch[i]->d_vectors, d_coalesced_vectors_[table_id] + vec_offset,
+          batch[i]->num_keys * vec_size * sizeof(float), cudaMemcpyDeviceToDevice, stream));
+      vec_offset += batch[i]->num_keys * vec_size;
+    }
+    HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+    start = end;
+  }
+}
+
 void LookupSession::lookup(const std::vector<const void*>& h_keys_per_table,
                            const std::vector<float*>& d_vectors_per_table,
                            const std::vector<size_t>& num_keys_per_table) {
@@ -86,4 +265,4 @@ void LookupSession::lookup(const std::vector<const void*>& h_keys_per_table,
   }
 }
 
-}  // namespace HugeCTR
\ No newline at end of file
+}  // namespace HugeCTR
@@ -20,7 +20,9 @@
 #include <common.hpp>
 #include <cstddef>
 #include <hps/inference_utils.hpp>
+#include <hps/key_compactor.hpp>
 #include <hps/modelloader.hpp>
+#include <sstream>
 #include <parser.hpp>
 #include <string>
 #include <unordered_set>
@@ -109,8 +111,22 @@ void RawModelLoader<TKey, TValue>::load(const std::string& table_name, const std
   } else {
     std::vector<long long> i64_key_vec(num_key, 0);
     key_stream.read(reinterpret_cast<char*>(i64_key_vec.data()), key_file_size_in_byte);
+    // Narrow the 64-bit keys on file into the 32-bit key space. compact_key_32 keeps keys below
+    // 2^32 unchanged and hashes only the long tail, so this degenerates to the plain cast for
+    // models trained in 32-bit key mode. The compactor proves the mapping is collision-free on
+    // this key set; lookup clients recompute the same mapping on their query keys.
+    KeyCompactor32 compactor;
     std::transform(i64_key_vec.begin(), i64_key_vec.end(), embedding_table_->keys.begin(),
-                   [](long long key) { return static_cast<unsigned>(key); });
+                   [&compactor](long long key) {
+                     return compactor.add(static_cast<uint64_t>(key));
+                   });
+    if (compactor.has_collision()) {
+      const auto [key_a, key_b] = compactor.collision_keys();
+      std::ostringstream os;
+      os << "Error: keys " << key_a << " and " << key_b << " of table " << table_name
+         << " collide in the 32-bit key space; deploy this model with 64-bit keys";
+      HCTR_OWN_THROW(Error_t::WrongInput, os.str());
+    }
   }
 
   embedding_table_->vectors.resize(num_float_val_in_vec_file);
@@ -0,0 +1,567 @@
+/*
+ * Copyright (c) 2021, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <xxh3.h>
+
+#include <algorithm>
+#include <base/debug/logger.hpp>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <hps/hier_parameter_server_base.hpp>
+#include <hps/multi_process_hash_map_backend.hpp>
+#include <random>
+#include <thread>
+
+// TODO: Remove me!
+#pragma GCC diagnostic error "-Wconversion"
+
+#define HCTR_KEY_TO_SLOT_INDEX(KEY) (XXH3_64bits(&(KEY), sizeof(TKey)) % table->num_slots)
+
+namespace HugeCTR {
+
+template <typename TKey>
+MultiProcessHashMapBackend<TKey>::MultiProcessHashMapBackend(
+    const std::string& shared_memory_name, const size_t shared_memory_size,
+    const size_t max_get_batch_size, const size_t max_set_batch_size, const size_t overflow_margin,
+    const DatabaseOverflowPolicy_t overflow_policy, const double overflow_resolution_target)
+    : TBase(max_get_batch_size, max_set_batch_size, overflow_margin, overflow_policy,
+            overflow_resolution_target),
+      shared_memory_name_(shared_memory_name),
+      shared_memory_size_(shared_memory_size) {
+  HCTR_CHECK(shared_memory_size > sizeof(ShmHeader));
+
+  // Try to create the arena. Exactly one process on the host wins this race and becomes
+  // responsible for initializing the header.
+  int fd = shm_open(shared_memory_name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0664);
+  if (fd >= 0) {
+    is_creator_ = true;
+    HCTR_CHECK_HINT(!ftruncate(fd, static_cast<off_t>(shared_memory_size_)),
+                    "Unable to size shared memory '%s': %s\n", shared_memory_name_.c_str(),
+                    strerror(errno));
+  } else {
+    HCTR_CHECK_HINT(errno == EEXIST, "Unable to create shared memory '%s': %s\n",
+                    shared_memory_name_.c_str(), strerror(errno));
+    fd = shm_open(shared_memory_name_.c_str(), O_RDWR, 0664);
+    HCTR_CHECK_HINT(fd >= 0, "Unable to open shared memory '%s': %s\n",
+                    shared_memory_name_.c_str(), strerror(errno));
+
+    // Await the creator having sized the segment.
+    struct stat file_stats;
+    for (;;) {
+      HCTR_CHECK_HINT(!fstat(fd, &file_stats), "Unable to stat shared memory '%s': %s\n",
+                      shared_memory_name_.c_str(), strerror(errno));
+      if (file_stats.st_size > 0) {
+        break;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    shared_memory_size_ = static_cast<size_t>(file_stats.st_size);
+  }
+
+  arena_ =
+      mmap(nullptr, shared_memory_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  HCTR_CHECK_HINT(arena_ != MAP_FAILED, "Unable to map shared memory '%s': %s\n",
+                  shared_memory_name_.c_str(), strerror(errno));
+  header_ = static_cast<ShmHeader*>(arena_);
+
+  if (is_creator_) {
+    header_->arena_size = shared_memory_size_;
+    header_->alloc_offset = (sizeof(ShmHeader) + 7) / 8 * 8;
+    header_->num_tables = 0;
+
+    pthread_mutexattr_t mutex_attr;
+    pthread_mutexattr_init(&mutex_attr);
+    pthread_mutexattr_setpshared(&mutex_attr, PTHREAD_PROCESS_SHARED);
+    pthread_mutex_init(&header_->alloc_guard, &mutex_attr);
+    pthread_mutexattr_destroy(&mutex_attr);
+
+    // Publish. Attaching processes spin on the magic number below.
+    __atomic_store_n(&header_->magic, SHM_MAGIC, __ATOMIC_RELEASE);
+  } else {
+    while (__atomic_load_n(&header_->magic, __ATOMIC_ACQUIRE) != SHM_MAGIC) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  }
+
+  HCTR_LOG_S(INFO, WORLD) << (is_creator_ ? "Created" : "Attached to") << " shared memory arena '"
+                          << shared_memory_name_ << "' (" << shared_memory_size_ << " bytes)."
+                          << std::endl;
+}
+
+template <typename TKey>
+MultiProcessHashMapBackend<TKey>::~MultiProcessHashMapBackend() {
+  // Only unmap. The arena is deliberately left in place, since sibling processes (and successors)
+  // keep using it. Remove it via shm_unlink / /dev/shm, if it is no longer wanted.
+  if (arena_) {
+    munmap(arena_, shared_memory_size_);
+    arena_ = nullptr;
+    header_ = nullptr;
+  }
+}
+
+template <typename TKey>
+typename MultiProcessHashMapBackend<TKey>::ShmTable* MultiProcessHashMapBackend<TKey>::find_table_(
+    const std::string& table_name) const {
+  const size_t num_tables = __atomic_load_n(&header_->num_tables, __ATOMIC_ACQUIRE);
+  for (size_t i = 0; i < num_tables; i++) {
+    ShmTable* const table = &header_->tables[i];
+    if (table_name == table->name) {
+      return table;
+    }
+  }
+  return nullptr;
+}
+
+template <typename TKey>
+typename MultiProcessHashMapBackend<TKey>::ShmTable*
+MultiProcessHashMapBackend<TKey>::get_or_create_table_(const std::string& table_name,
+                                                       const size_t num_pairs,
+                                                       const size_t value_size) {
+  ShmTable* table = find_table_(table_name);
+  if (!table) {
+    pthread_mutex_lock(&header_->alloc_guard);
+    table = find_table_(table_name);
+    if (!table) {
+      HCTR_CHECK_HINT(header_->num_tables < MAX_TABLES,
+                      "Shared memory arena '%s' cannot hold more tables!\n",
+                      shared_memory_name_.c_str());
+      HCTR_CHECK_HINT(table_name.size() <= MAX_TABLE_NAME_LENGTH, "Table name '%s' is too long!\n",
+                      table_name.c_str());
+
+      // Size the table for the initial bulk load (with headroom), but never beyond the configured
+      // overflow margin.
+      size_t num_slots = std::max<size_t>(num_pairs * 2, PROBE_WINDOW);
+      if (this->overflow_margin_ < std::numeric_limits<size_t>::max() / 2) {
+        num_slots = std::min(num_slots, this->overflow_margin_ * 2);
+      }
+      const size_t slot_stride = sizeof(ShmSlot) + (value_size + 7) / 8 * 8;
+      const size_t slots_bytes = num_slots * slot_stride;
+      HCTR_CHECK_HINT(header_->alloc_offset + slots_bytes <= header_->arena_size,
+                      "Shared memory arena '%s' is too small for table %s (%zu more bytes "
+                      "needed)!\n",
+                      shared_memory_name_.c_str(), table_name.c_str(),
+                      header_->alloc_offset + slots_bytes - header_->arena_size);
+
+      ShmTable* const new_table = &header_->tables[header_->num_tables];
+      std::strncpy(new_table->name, table_name.c_str(), MAX_TABLE_NAME_LENGTH);
+      new_table->name[MAX_TABLE_NAME_LENGTH] = '\0';
+      new_table->slots_offset = header_->alloc_offset;
+      new_table->num_slots = num_slots;
+      new_table->slot_stride = slot_stride;
+      new_table->value_size = value_size;
+      new_table->num_entries = 0;
+      header_->alloc_offset += slots_bytes;
+
+      pthread_rwlockattr_t lock_attr;
+      pthread_rwlockattr_init(&lock_attr);
+      pthread_rwlockattr_setpshared(&lock_attr, PTHREAD_PROCESS_SHARED);
+      pthread_rwlock_init(&new_table->lock, &lock_attr);
+      pthread_rwlockattr_destroy(&lock_attr);
+
+      // Mark all slots as vacant.
+      for (size_t i = 0; i < num_slots; i++) {
+        slot_at_(*new_table, i)->key = EMPTY_SLOT_SENTINEL;
+      }
+
+      HCTR_LOG_S(INFO, WORLD) << get_name() << " backend; Created table " << table_name << " ("
+                              << num_slots << " slots, " << slots_bytes
+                              << " bytes in shared memory)." << std::endl;
+
+      // Publish directory entry.
+      __atomic_store_n(&header_->num_tables, header_->num_tables + 1, __ATOMIC_RELEASE);
+      table = new_table;
+    }
+    pthread_mutex_unlock(&header_->alloc_guard);
+  }
+  HCTR_CHECK_HINT(table->value_size == value_size,
+                  "Table %s: Value size mismatch (%zu <> %zu)!\n", table_name.c_str(),
+                  table->value_size, value_size);
+  return table;
+}
+
+template <typename TKey>
+size_t MultiProcessHashMapBackend<TKey>::capacity(const std::string& table_name) const {
+  const ShmTable* const table = find_table_(table_name);
+  return table ? table->num_slots : this->overflow_margin_;
+}
+
+template <typename TKey>
+size_t MultiProcessHashMapBackend<TKey>::size(const std::string& table_name) const {
+  const ShmTable* const table = find_table_(table_name);
+  return table ? table->num_entries : 0;
+}
+
+template <typename TKey>
+size_t MultiProcessHashMapBackend<TKey>::contains(
+    const std::string& table_name, const size_t num_keys, const TKey* const keys,
+    const std::chrono::nanoseconds& time_budget) const {
+  ShmTable* const table = find_table_(table_name);
+  if (!table) {
+    return TBase::contains(table_name, num_keys, keys, time_budget);
+  }
+
+  size_t hit_count = 0;
+  pthread_rwlock_rdlock(&table->lock);
+  const TKey* const keys_end = &keys[num_keys];
+  for (const TKey* k = keys; k != keys_end; k++) {
+    const size_t base = HCTR_KEY_TO_SLOT_INDEX(*k);
+    for (size_t j = 0; j < PROBE_WINDOW; j++) {
+      if (slot_at_(*table, (base + j) % table->num_slots)->key == *k) {
+        hit_count++;
+        break;
+      }
+    }
+  }
+  pthread_rwlock_unlock(&table->lock);
+
+  HCTR_LOG_S(TRACE, WORLD) << get_name() << " backend. Table: " << table_name << ". Found "
+                           << hit_count << " / " << num_keys << " keys." << std::endl;
+  return hit_count;
+}
+
+template <typename TKey>
+bool MultiProcessHashMapBackend<TKey>::insert(const std::string& table_name, const size_t num_pairs,
+                                              const TKey* const keys, const char* const values,
+                                              const size_t value_size) {
+  ShmTable* const table = get_or_create_table_(table_name, num_pairs, value_size);
+
+  const time_t now = std::time(nullptr);
+  std::random_device entropy;
+  std::default_random_engine generator(entropy());
+  std::uniform_int_distribution<size_t> distribution(0, PROBE_WINDOW - 1);
+
+  size_t num_inserts = 0;
+  pthread_rwlock_wrlock(&table->lock);
+  for (size_t i = 0; i < num_pairs; i++) {
+    const TKey k = keys[i];
+    HCTR_CHECK_HINT(k != EMPTY_SLOT_SENTINEL, "Key value %llu is reserved!\n",
+                    static_cast<unsigned long long>(k));
+
+    // Probe the window; remember the first vacant slot and the eviction victim candidate.
+    const size_t base = HCTR_KEY_TO_SLOT_INDEX(k);
+    ShmSlot* dst = nullptr;
+    ShmSlot* vacant = nullptr;
+    ShmSlot* victim = nullptr;
+    for (size_t j = 0; j < PROBE_WINDOW; j++) {
+      ShmSlot* const slot = slot_at_(*table, (base + j) % table->num_slots);
+      if (slot->key == k) {
+        dst = slot;
+        break;
+      }
+      if (slot->key == EMPTY_SLOT_SENTINEL) {
+        if (!vacant) {
+          vacant = slot;
+        }
+      } else if (!victim || slot->last_access < victim->last_access) {
+        victim = slot;
+      }
+    }
+
+    if (!dst) {
+      if (vacant) {
+        dst = vacant;
+        table->num_entries++;
+        num_inserts++;
+      } else {
+        // Window is full. Overwrite a victim as dictated by the overflow policy.
+        switch (this->overflow_policy_) {
+          case DatabaseOverflowPolicy_t::EvictOldest:
+            dst = victim;
+            break;
+          case DatabaseOverflowPolicy_t::EvictRandom:
+            dst = slot_at_(*table, (base + distribution(generator)) % table->num_slots);
+            break;
+          default:
+            HCTR_DIE("Unsupported overflow policy!\n");
+            break;
+        }
+      }
+    }
+    dst->key = k;
+    dst->last_access = now;
+    std::memcpy(slot_value_(dst), &values[i * value_size], value_size);
+  }
+  pthread_rwlock_unlock(&table->lock);
+
+  HCTR_LOG_S(TRACE, WORLD) << get_name() << " backend. Table: " << table_name << ". Inserted "
+                           << num_inserts << " + updated " << (num_pairs - num_inserts)
+                           << " entries." << std::endl;
+  return true;
+}
+
+template <typename TKey>
+size_t MultiProcessHashMapBackend<TKey>::fetch(const std::string& table_name, const size_t num_keys,
+                                               const TKey* const keys,
+                                               const DatabaseHitCallback& on_hit,
+                                               const DatabaseMissCallback& on_miss,
+                                               const std::chrono::nanoseconds& time_budget) {
+  const auto begin = std::chrono::high_resolution_clock::now();
+
+  ShmTable* const table = find_table_(table_name);
+  if (!table) {
+    return TBase::fetch(table_name, num_keys, keys, on_hit, on_miss, time_budget);
+  }
+
+  const time_t now = std::time(nullptr);
+  size_t hit_count = 0;
+  size_t skip_count = 0;
+
+  pthread_rwlock_rdlock(&table->lock);
+  for (size_t i = 0; i < num_keys; i++) {
+    // Check time budget at batch granularity.
+    if (i % this->max_get_batch_size_ == 0) {
+      const auto elapsed = std::chrono::high_resolution_clock::now() - begin;
+      if (elapsed >= time_budget) {
+        for (; i < num_keys; i++) {
+          on_miss(i);
+          skip_count++;
+        }
+        break;
+      }
+    }
+
+    const TKey k = keys[i];
+    const size_t base = HCTR_KEY_TO_SLOT_INDEX(k);
+    ShmSlot* hit = nullptr;
+    for (size_t j = 0; j < PROBE_WINDOW; j++) {
+      ShmSlot* const slot = slot_at_(*table, (base + j) % table->num_slots);
+      if (slot->key == k) {
+        hit = slot;
+        break;
+      }
+    }
+    if (hit) {
+      on_hit(i, slot_value_(hit), table->value_size);
+      // Benign race: timestamps only steer eviction order.
+      hit->last_access = now;
+      hit_count++;
+    } else {
+      on_miss(i);
+    }
+  }
+  pthread_rwlock_unlock(&table->lock);
+
+  if (skip_count) {
+    HCTR_LOG_S(WARNING, WORLD) << get_name() << " backend. Table: " << table_name
+                               << ". Time budget exhausted. Skipped " << skip_count << " keys."
+                               << std::endl;
+  }
+  HCTR_LOG_S(TRACE, WORLD) << get_name() << " backend. Table: " << table_name << ". Fetched "
+                           << hit_count << " / " << num_keys << " values." << std::endl;
+  return hit_count;
+}
+
+template <typename TKey>
+size_t MultiProcessHashMapBackend<TKey>::fetch(const std::string& table_name,
+                                               const size_t num_indices,
+                                               const size_t* const indices, const TKey* const keys,
+                                               const DatabaseHitCallback& on_hit,
+                                               const DatabaseMissCallback& on_miss,
+                                               const std::chrono::nanoseconds& time_budget) {
+  const auto begin = std::chrono::high_resolution_clock::now();
+
+  ShmTable* const table = find_table_(table_name);
+  if (!table) {
+    return TBase::fetch(table_name, num_indices, indices, keys, on_hit, on_miss, time_budget);
+  }
+
+  const time_t now = std::time(nullptr);
+  size_t hit_count = 0;
+  size_t skip_count = 0;
+
+  pthread_rwlock_rdlock(&table->lock);
+  const size_t* const indices_end = &indices[num_indices];
+  for (const size_t* i = indices; i != indices_end; i++) {
+    // Check time budget at batch granularity.
+    if ((i - indices) % this->max_get_batch_size_ == 0) {
+      const auto elapsed = std::chrono::high_resolution_clock::now() - begin;
+      if (elapsed >= time_budget) {
+        for (; i != indices_end; i++) {
+          on_miss(*i);
+          skip_count++;
+        }
+        break;
+      }
+    }
+
+    const TKey k = keys[*i];
+    const size_t base = HCTR_KEY_TO_SLOT_INDEX(k);
+    ShmSlot* hit = nullptr;
+    for (size_t j = 0; j < PROBE_WINDOW; j++) {
+      ShmSlot* const slot = slot_at_(*table, (base + j) % table->num_slots);
+      if (slot->key == k) {
+        hit = slot;
+        break;
+      }
+    }
+    if (hit) {
+      on_hit(*i, slot_value_(hit), table->value_size);
+      // Benign race: timestamps only steer eviction order.
+      hit->last_access = now;
+      hit_count++;
+    } else {
+      on_miss(*i);
+    }
+  }
+  pthread_rwlock_unlock(&table->lock);
+
+  if (skip_count) {
+    HCTR_LOG_S(WARNING, WORLD) << get_name() << " backend. Table: " << table_name
+                               << ". Time budget exhausted. Skipped " << skip_count << " keys."
+                               << std::endl;
+  }
+  HCTR_LOG_S(TRACE, WORLD) << get_name() << " backend. Table: " << table_name << ". Fetched "
+                           << hit_count << " / " << num_indices << " values." << std::endl;
+  return hit_count;
+}
+
+template <typename TKey>
+size_t MultiProcessHashMapBackend<TKey>::evict(const std::string& table_name) {
+  ShmTable* const table = find_table_(table_name);
+  if (!table) {
+    return 0;
+  }
+
+  // Mark all slots as vacant. The slot array itself stays reserved in the arena, since the bump
+  // allocator cannot reclaim it and successors will likely reuse the table anyway.
+  pthread_rwlock_wrlock(&table->lock);
+  const size_t hit_count = table->num_entries;
+  for (size_t i = 0; i < table->num_slots; i++) {
+    slot_at_(*table, i)->key = EMPTY_SLOT_SENTINEL;
+  }
+  table->num_entries = 0;
+  pthread_rwlock_unlock(&table->lock);
+
+  HCTR_LOG_S(INFO, WORLD) << get_name() << " backend. Table " << table_name << " erased ("
+                          << hit_count << " entries)." << std::endl;
+  return hit_count;
+}
+
+template <typename TKey>
+size_t MultiProcessHashMapBackend<TKey>::evict(const std::string& table_name, const size_t num_keys,
+                                               const TKey* const keys) {
+  ShmTable* const table = find_table_(table_name);
+  if (!table) {
+    return 0;
+  }
+
+  size_t hit_count = 0;
+  pthread_rwlock_wrlock(&table->lock);
+  const TKey* const keys_end = &keys[num_keys];
+  for (const TKey* k = keys; k != keys_end; k++) {
+    const size_t base = HCTR_KEY_TO_SLOT_INDEX(*k);
+    for (size_t j = 0; j < PROBE_WINDOW; j++) {
+      ShmSlot* const slot = slot_at_(*table, (base + j) % table->num_slots);
+      if (slot->key == *k) {
+        slot->key = EMPTY_SLOT_SENTINEL;
+        table->num_entries--;
+        hit_count++;
+        break;
+      }
+    }
+  }
+  pthread_rwlock_unlock(&table->lock);
+
+  HCTR_LOG_S(TRACE, WORLD) << get_name() << " backend. Table " << table_name << ". Erased "
+                           << hit_count << " / " << num_keys << " entries." << std::endl;
+  return hit_count;
+}
+
+template <typename TKey>
+std::vector<std::string> MultiProcessHashMapBackend<TKey>::find_tables(
+    const std::string& model_name) {
+  const std::string& tag_prefix = HierParameterServerBase::make_tag_name(model_name, "", false);
+
+  std::vector<std::string> matches;
+  const size_t num_tables = __atomic_load_n(&header_->num_tables, __ATOMIC_ACQUIRE);
+  for (size_t i = 0; i < num_tables; i++) {
+    const ShmTable& table = header_->tables[i];
+    if (std::strncmp(table.name, tag_prefix.c_str(), tag_prefix.size()) == 0) {
+      matches.emplace_back(table.name);
+    }
+  }
+  return matches;
+}
+
+template <typename TKey>
+void MultiProcessHashMapBackend<TKey>::dump_bin(const std::string& table_name,
+                                                std::ofstream& file) {
+  ShmTable* const table = find_table_(table_name);
+  if (!table) {
+    return;
+  }
+
+  pthread_rwlock_rdlock(&table->lock);
+
+  // Store value size.
+  const uint32_t value_size = static_cast<uint32_t>(table->value_size);
+  file.write(reinterpret_cast<const char*>(&value_size), sizeof(uint32_t));
+
+  // Store values.
+  for (size_t i = 0; i < table->num_slots; i++) {
+    ShmSlot* const slot = slot_at_(*table, i);
+    if (slot->key != EMPTY_SLOT_SENTINEL) {
+      file.write(reinterpret_cast<const char*>(&slot->key), sizeof(TKey));
+      file.write(slot_value_(slot), value_size);
+    }
+  }
+  pthread_rwlock_unlock(&table->lock);
+}
+
+template <typename TKey>
+void MultiProcessHashMapBackend<TKey>::dump_sst(const std::string& table_name,
+                                                rocksdb::SstFileWriter& file) {
+  ShmTable* const table = find_table_(table_name);
+  if (!table) {
+    return;
+  }
+
+  pthread_rwlock_rdlock(&table->lock);
+
+  // Created sorted list of keys.
+  std::vector<std::pair<TKey, const char*>> entries;
+  entries.reserve(table->num_entries);
+  for (size_t i = 0; i < table->num_slots; i++) {
+    ShmSlot* const slot = slot_at_(*table, i);
+    if (slot->key != EMPTY_SLOT_SENTINEL) {
+      entries.emplace_back(slot->key, slot_value_(slot));
+    }
+  }
+  std::sort(entries.begin(), entries.end(),
+            [](const auto& a, const auto& b) { return a.first < b.first; });
+
+  // Iterate over pairs and insert.
+  rocksdb::Slice k_view{nullptr, sizeof(TKey)};
+  rocksdb::Slice v_view{nullptr, table->value_size};
+
+  for (const std::pair<TKey, const char*>& entry : entries) {
+    k_view.data_ = reinterpret_cast<const char*>(&entry.first);
+    v_view.data_ = entry.second;
+    HCTR_ROCKSDB_CHECK(file.Put(k_view, v_view));
+  }
+  pthread_rwlock_unlock(&table->lock);
+}
+
+template class MultiProcessHashMapBackend<unsigned int>;
+template class MultiProcessHashMapBackend<long long>;
+
+}  // namespace HugeCTR
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2021, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <base/debug/logger.hpp>
+#include <hps/near_cache_backend.hpp>
+#include <mutex>
+
+// TODO: Remove me!
+#pragma GCC diagnostic error "-Wconversion"
+
+namespace HugeCTR {
+
+template <typename TKey>
+NearCacheBackend<TKey>::NearCacheBackend(std::unique_ptr<VolatileBackend<TKey>> distant,
+                                         const size_t near_capacity, const size_t num_partitions,
+                                         const size_t max_get_batch_size,
+                                         const size_t max_set_batch_size)
+    : TBase(max_get_batch_size, max_set_batch_size, near_capacity,
+            DatabaseOverflowPolicy_t::EvictOldest, 1.0),
+      distant_(std::move(distant)),
+      near_(num_partitions, 256 * 1024 * 1024, max_get_batch_size, max_set_batch_size,
+            std::max<size_t>(near_capacity / num_partitions, 1),
+            DatabaseOverflowPolicy_t::EvictOldest, 0.8) {
+  HCTR_LOG_S(INFO, WORLD) << "Created near cache (up to " << near_.capacity("")
+                          << " entries per table) in front of " << distant_->get_name()
+                          << " backend." << std::endl;
+}
+
+template <typename TKey>
+bool NearCacheBackend<TKey>::insert(const std::string& table_name, const size_t num_pairs,
+                                    const TKey* const keys, const char* const values,
+                                    const size_t value_size) {
+  // Drop the near copies first, so a fetch racing with this update can at worst re-admit the
+  // fresh value. Bulk loads pass through unaffected; nothing is cached for them yet.
+  near_.evict(table_name, num_pairs, keys);
+  return distant_->insert(table_name, num_pairs, keys, values, value_size);
+}
+
+template <typename TKey>
+size_t NearCacheBackend<TKey>::fetch(const std::string& table_name, const size_t num_keys,
+                                     const TKey* const keys, const DatabaseHitCallback& on_hit,
+                                     const DatabaseMissCallback& on_miss,
+                                     const std::chrono::nanoseconds& time_budget) {
+  // The near tier reports misses from its partition workers; collect them under a lock and
+  // resolve them against the distant backend in one batched round trip.
+  std::vector<size_t> missed;
+  std::mutex missed_guard;
+  size_t hit_count = near_.fetch(
+      table_name, num_keys, keys, on_hit,
+      [&](const size_t index) {
+        const std::lock_guard lock(missed_guard);
+        missed.push_back(index);
+      },
+      time_budget);
+
+  if (!missed.empty()) {
+    hit_count += fetch_distant_(table_name, missed, keys, on_hit, on_miss, time_budget);
+  }
+
+  HCTR_LOG_S(TRACE, WORLD) << get_name() << " backend; Table " << table_name << ": " << hit_count
+                           << " / " << num_keys << " hits, " << missed.size()
+                           << " forwarded to distant backend." << std::endl;
+  return hit_count;
+}
+
+template <typename TKey>
+size_t NearCacheBackend<TKey>::fetch(const std::string& table_name, const size_t num_indices,
+                                     const size_t* const indices, const TKey* const keys,
+                                     const DatabaseHitCallback& on_hit,
+                                     const DatabaseMissCallback& on_miss,
+                                     const std::chrono::nanoseconds& time_budget) {
+  std::vector<size_t> missed;
+  std::mutex missed_guard;
+  size_t hit_count = near_.fetch(
+      table_name, num_indices, indices, keys, on_hit,
+      [&](const size_t index) {
+        const std::lock_guard lock(missed_guard);
+        missed.push_back(index);
+      },
+      time_budget);
+
+  if (!missed.empty()) {
+    hit_count += fetch_distant_(table_name, missed, keys, on_hit, on_miss, time_budget);
+  }
+
+  HCTR_LOG_S(TRACE, WORLD) << get_name() << " backend; Table " << table_name << ": " << hit_count
+                           << " / " << num_indices << " hits, " << missed.size()
+                           << " forwarded to distant backend." << std::endl;
+  return hit_count;
+}
+
+template <typename TKey>
+size_t NearCacheBackend<TKey>::fetch_distant_(const std::string& table_name,
+                                              const std::vector<size_t>& indices,
+                                              const TKey* const keys,
+                                              const DatabaseHitCallback& on_hit,
+                                              const DatabaseMissCallback& on_miss,
+                                              const std::chrono::nanoseconds& time_budget) {
+  // Values are copied out right away, so the distant backend may reuse its buffers; the
+  // gathered pairs are admitted into the near tier in one batched insert afterwards.
+  std::vector<TKey> admit_keys;
+  std::vector<char> admit_values;
+  size_t admit_value_size = 0;
+  std::mutex admit_guard;
+  admit_keys.reserve(indices.size());
+
+  const size_t hit_count = distant_->fetch(
+      table_name, indices.size(), indices.data(), keys,
+      [&](const size_t index, const char* const value, const size_t value_size) {
+        on_hit(index, value, value_size);
+        const std::lock_guard lock(admit_guard);
+        admit_value_size = value_size;
+        admit_keys.push_back(keys[index]);
+        admit_values.insert(admit_values.end(), value, &value[value_size]);
+      },
+      on_miss, time_budget);
+
+  if (!admit_keys.empty()) {
+    near_.insert(table_name, admit_keys.size(), admit_keys.data(), admit_values.data(),
+                 admit_value_size);
+  }
+  return hit_count;
+}
+
+template <typename TKey>
+size_t NearCacheBackend<TKey>::evict(const std::string& table_name) {
+  near_.evict(table_name);
+  return distant_->evict(table_name);
+}
+
+template <typename TKey>
+size_t NearCacheBackend<TKey>::evict(const std::string& table_name, const size_t num_keys,
+                                     const TKey* const keys) {
+  near_.evict(table_name, num_keys, keys);
+  return distant_->evict(table_name, num_keys, keys);
+}
+
+template class NearCacheBackend<unsigned int>;
+template class NearCacheBackend<long long>;
+
+}  // namespace HugeCTR
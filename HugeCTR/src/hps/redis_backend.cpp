@@ -488,13 +488,16 @@ size_t RedisClusterBackend<TKey>::fetch(const std::string& table_name, const siz
           const std::string& hkey_v = HCTR_REDIS_VALUE_HKEY();
 
           try {
-            std::vector<size_t> i_vals;
+            std::vector<std::vector<size_t>> i_vals_per_batch;
             std::vector<std::string_view> k_views;
             std::vector<std::optional<std::string>> v_opts;
             std::shared_ptr<std::vector<TKey>> touched_keys;
 
-            size_t num_batches = 0;
-            for (const TKey* k = keys; k != keys_end; num_batches++) {
+            // Stage all of this partition's batches into one pipeline, so the shard answers
+            // them in a single round trip instead of one blocking HMGET per batch.
+            sw::redis::Pipeline pipeline = redis_->pipeline(hkey_v, false);
+
+            for (const TKey* k = keys; k != keys_end;) {
               // Check time budget.
               const auto elapsed = std::chrono::high_resolution_clock::now() - begin;
               if (elapsed >= time_budget) {
@@ -504,7 +507,7 @@ size_t RedisClusterBackend<TKey>::fetch(const std::string& table_name, const siz
                 size_t ign_count = 0;
                 for (; k != keys_end; k++) {
                   if (HCTR_KEY_TO_PART_INDEX(*k) == part) {
-                    on_miss(0);
+                    on_miss(k - keys);
                     ign_count++;
                   }
                 }
@@ -514,12 +517,13 @@ size_t RedisClusterBackend<TKey>::fetch(const std::string& table_name, const siz
 
               // Prepare query.
               k_views.clear();
-              i_vals.clear();
+              std::vector<size_t> i_vals;
               for (; k != keys_end; k++) {
                 if (HCTR_KEY_TO_PART_INDEX(*k) == part) {
                   i_vals.emplace_back(k - keys);
                   k_views.emplace_back(reinterpret_cast<const char*>(k), sizeof(TKey));
                   if (k_views.size() >= this->max_get_batch_size_) {
+                    k++;
                     break;
                   }
                 }
@@ -527,46 +531,56 @@ size_t RedisClusterBackend<TKey>::fetch(const std::string& table_name, const siz
               if (k_views.empty()) {
                 continue;
               }
+              pipeline.hmget(hkey_v, k_views.begin(), k_views.end());
+              i_vals_per_batch.emplace_back(std::move(i_vals));
+            }
 
-              // Launch query.
-              v_opts.clear();
-              v_opts.reserve(k_views.size());
-              redis_->hmget(hkey_v, k_views.begin(), k_views.end(), std::back_inserter(v_opts));
+            if (!i_vals_per_batch.empty()) {
+              // Launch queries.
+              sw::redis::QueuedReplies replies = pipeline.exec();
 
               // Process results.
-              auto i_vals_it = i_vals.begin();
-              for (const auto& v_opt : v_opts) {
-                if (v_opt) {
-                  on_hit(*i_vals_it, v_opt->data(), v_opt->size());
-                  hit_count++;
-
-                  if (this->refresh_time_after_fetch_) {
-                    if (!touched_keys) {
-                      touched_keys = std::make_shared<std::vector<TKey>>();
+              for (size_t num_batches = 0; num_batches < i_vals_per_batch.size(); num_batches++) {
+                const std::vector<size_t>& i_vals = i_vals_per_batch[num_batches];
+                v_opts.clear();
+                v_opts.reserve(i_vals.size());
+                replies.get(num_batches, std::back_inserter(v_opts));
+
+                auto i_vals_it = i_vals.begin();
+                for (const auto& v_opt : v_opts) {
+                  if (v_opt) {
+                    on_hit(*i_vals_it, v_opt->data(), v_opt->size());
+                    hit_count++;
+
+                    if (this->refresh_time_after_fetch_) {
+                      if (!touched_keys) {
+                        touched_keys = std::make_shared<std::vector<TKey>>();
+                      }
+                      touched_keys->emplace_back(keys[*i_vals_it]);
                     }
-                    touched_keys->emplace_back(keys[*i_vals_it]);
+                  } else {
+                    on_miss(*i_vals_it);
                   }
-                } else {
-                  on_miss(*i_vals_it);
+                  i_vals_it++;
                 }
-                i_vals_it++;
-              }
-              HCTR_CHECK(i_vals_it == i_vals.end());
+                HCTR_CHECK(i_vals_it == i_vals.end());
 
-              // Refresh timestamps if desired.
-              if (touched_keys && !touched_keys->empty()) {
-                const time_t now = std::time(nullptr);
+                // Refresh timestamps if desired.
+                if (touched_keys && !touched_keys->empty()) {
+                  const time_t now = std::time(nullptr);
 
-                this->background_worker_.submit([this, table_name, part, touched_keys, now]() {
-                  const std::string& hkey_t = HCTR_REDIS_TIME_HKEY();
-                  touch_(hkey_t, touched_keys, now);
-                });
-                touched_keys.reset();
-              }
+                  this->background_worker_.submit([this, table_name, part, touched_keys, now]() {
+                    const std::string& hkey_t = HCTR_REDIS_TIME_HKEY();
+                    touch_(hkey_t, touched_keys, now);
+                  });
+                  touched_keys.reset();
+                }
 
-              HCTR_LOG_S(TRACE, WORLD) << get_name() << " backend. Partition " << hkey_v
-                                       << ", batch " << num_batches << ": Fetched " << v_opts.size()
-                                       << " keys. Hits " << hit_count << '.' << std::endl;
+                HCTR_LOG_S(TRACE, WORLD)
+                    << get_name() << " backend. Partition " << hkey_v << ", batch " << num_batches
+                    << ": Fetched " << v_opts.size() << " keys. Hits " << hit_count << '.'
+                    << std::endl;
+              }
             }
           } catch (...) {
             std::unique_lock lock(error_guard);
@@ -677,14 +691,17 @@ size_t RedisClusterBackend<TKey>::fetch(const std::string& table_name, const siz
           // Precalc constants.
           const std::string& hkey_v = HCTR_REDIS_VALUE_HKEY();
 
-          std::vector<size_t> i_vals;
+          std::vector<std::vector<size_t>> i_vals_per_batch;
           std::vector<std::string_view> k_views;
           std::vector<std::optional<std::string>> v_opts;
           std::shared_ptr<std::vector<TKey>> touched_keys;
 
           try {
-            size_t num_batches = 0;
-            for (const size_t* i = indices; i != indices_end; num_batches++) {
+            // Stage all of this partition's batches into one pipeline, so the shard answers
+            // them in a single round trip instead of one blocking HMGET per batch.
+            sw::redis::Pipeline pipeline = redis_->pipeline(hkey_v, false);
+
+            for (const size_t* i = indices; i != indices_end;) {
               // Check time budget.
               const auto elapsed = std::chrono::high_resolution_clock::now() - begin;
               if (elapsed >= time_budget) {
@@ -705,13 +722,14 @@ size_t RedisClusterBackend<TKey>::fetch(const std::string& table_name, const siz
 
               // Prepare query.
               k_views.clear();
-              i_vals.clear();
+              std::vector<size_t> i_vals;
               for (; i != indices_end; i++) {
                 const TKey& k = keys[*i];
                 if (HCTR_KEY_TO_PART_INDEX(k) == part) {
                   i_vals.emplace_back(*i);
                   k_views.emplace_back(reinterpret_cast<const char*>(&k), sizeof(TKey));
                   if (k_views.size() >= this->max_get_batch_size_) {
+                    i++;
                     break;
                   }
                 }
@@ -719,46 +737,56 @@ size_t RedisClusterBackend<TKey>::fetch(const std::string& table_name, const siz
               if (k_views.empty()) {
                 continue;
               }
+              pipeline.hmget(hkey_v, k_views.begin(), k_views.end());
+              i_vals_per_batch.emplace_back(std::move(i_vals));
+            }
 
-              // Launch query.
-              v_opts.clear();
-              v_opts.reserve(k_views.size());
-              redis_->hmget(hkey_v, k_views.begin(), k_views.end(), std::back_inserter(v_opts));
+            if (!i_vals_per_batch.empty()) {
+              // Launch queries.
+              sw::redis::QueuedReplies replies = pipeline.exec();
 
               // Process results.
-              auto i_vals_it = i_vals.begin();
-              for (const auto& v_opt : v_opts) {
-                if (v_opt) {
-                  on_hit(*i_vals_it, v_opt->data(), v_opt->size());
-                  hit_count++;
-
-                  if (this->refresh_time_after_fetch_) {
-                    if (!touched_keys) {
-                      touched_keys = std::make_shared<std::vector<TKey>>();
+              for (size_t num_batches = 0; num_batches < i_vals_per_batch.size(); num_batches++) {
+                const std::vector<size_t>& i_vals = i_vals_per_batch[num_batches];
+                v_opts.clear();
+                v_opts.reserve(i_vals.size());
+                replies.get(num_batches, std::back_inserter(v_opts));
+
+                auto i_vals_it = i_vals.begin();
+                for (const auto& v_opt : v_opts) {
+                  if (v_opt) {
+                    on_hit(*i_vals_it, v_opt->data(), v_opt->size());
+                    hit_count++;
+
+                    if (this->refresh_time_after_fetch_) {
+                      if (!touched_keys) {
+                        touched_keys = std::make_shared<std::vector<TKey>>();
+                      }
+                      touched_keys->emplace_back(keys[*i_vals_it]);
                     }
-                    touched_keys->emplace_back(keys[*i_vals_it]);
+                  } else {
+                    on_miss(*i_vals_it);
                   }
-                } else {
-                  on_miss(*i_vals_it);
+                  i_vals_it++;
                 }
-                i_vals_it++;
-              }
-              HCTR_CHECK(i_vals_it == i_vals.end());
+                HCTR_CHECK(i_vals_it == i_vals.end());
 
-              // Refresh timestamps if desired.
-              if (touched_keys && !touched_keys->empty()) {
-                const time_t now = std::time(nullptr);
+                // Refresh timestamps if desired.
+                if (touched_keys && !touched_keys->empty()) {
+                  const time_t now = std::time(nullptr);
 
-                this->background_worker_.submit([this, table_name, part, touched_keys, now]() {
-                  const std::string& hkey_t = HCTR_REDIS_TIME_HKEY();
-                  touch_(hkey_t, touched_keys, now);
-                });
-                touched_keys.reset();
-              }
+                  this->background_worker_.submit([this, table_name, part, touched_keys, now]() {
+                    const std::string& hkey_t = HCTR_REDIS_TIME_HKEY();
+                    touch_(hkey_t, touched_keys, now);
+                  });
+                  touched_keys.reset();
+                }
 
-              HCTR_LOG_S(TRACE, WORLD) << get_name() << " backend. Partition " << hkey_v
-                                       << ", batch " << num_batches << ": Fetched " << v_opts.size()
-                                       << " keys. Hits " << hit_count << '.' << std::endl;
+                HCTR_LOG_S(TRACE, WORLD)
+                    << get_name() << " backend. Partition " << hkey_v << ", batch " << num_batches
+                    << ": Fetched " << v_opts.size() << " keys. Hits " << hit_count << '.'
+                    << std::endl;
+              }
             }
           } catch (...) {
             std::unique_lock lock(error_guard);
@@ -1088,6 +1116,62 @@ void RedisClusterBackend<TKey>::check_and_resolve_overflow_(const std::string& h
                            << " is overflowing (size = " << part_size << " > "
                            << this->overflow_margin_ << "). Attempting to resolve..." << std::endl;
 
+  // A user-installed victim selector takes precedence over the built-in policies.
+  if (this->overflow_victim_selector_) {
+    // Fetch keys and insert times.
+    std::vector<std::pair<std::string, std::string>> kt_views;
+    kt_views.reserve(part_size);
+    redis_->hgetall(hkey_t, std::back_inserter(kt_views));
+
+    std::vector<std::pair<TKey, time_t>> candidates;
+    candidates.reserve(kt_views.size());
+    for (const auto& kt : kt_views) {
+      HCTR_CHECK_HINT(kt.first.size() == sizeof(TKey), "Key size mismatch!(%d <> %d)!",
+                      kt.first.size(), sizeof(TKey));
+      HCTR_CHECK_HINT(kt.second.size() == sizeof(time_t), "Value size mismatch!(%d <> %d)!",
+                      kt.second.size(), sizeof(time_t));
+      candidates.emplace_back(*reinterpret_cast<const TKey*>(kt.first.data()),
+                              *reinterpret_cast<const time_t*>(kt.second.data()));
+    }
+    const size_t num_victims = (part_size > this->overflow_resolution_target_)
+                                   ? part_size - this->overflow_resolution_target_
+                                   : 0;
+
+    std::vector<TKey> victims;
+    this->overflow_victim_selector_(hkey_v, candidates, num_victims, victims);
+
+    // Delete items.
+    std::vector<std::string_view> k_views;
+    k_views.reserve(this->max_set_batch_size_);
+
+    const auto v_end = victims.end();
+    for (auto v_it = victims.begin(); v_it != v_end;) {
+      // Collect a batch.
+      k_views.clear();
+      for (; v_it != v_end; v_it++) {
+        k_views.emplace_back(reinterpret_cast<const char*>(&*v_it), sizeof(TKey));
+        if (k_views.size() >= this->max_set_batch_size_) {
+          v_it++;
+          break;
+        }
+      }
+
+      // Perform deletion.
+      HCTR_LOG_S(TRACE, WORLD) << get_name() << " partition " << hkey_v << " (size = " << part_size
+                               << "). Attempting to evict " << k_views.size()
+                               << " CUSTOM-selected key/value pairs." << std::endl;
+      redis_->hdel(hkey_v, k_views.begin(), k_views.end());
+      redis_->hdel(hkey_t, k_views.begin(), k_views.end());
+
+      // Overflow resolved?
+      part_size = redis_->hlen(hkey_t);
+      if (part_size <= this->overflow_resolution_target_) {
+        break;
+      }
+    }
+    return;
+  }
+
   // Select overflow resolution policy.
   switch (this->overflow_policy_) {
     case DatabaseOverflowPolicy_t::EvictOldest: {
@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 
+#include <rocksdb/filter_policy.h>
+#include <rocksdb/table.h>
+
 #include <base/debug/logger.hpp>
 #include <hps/hier_parameter_server_base.hpp>
 #include <hps/rocksdb_backend.hpp>
@@ -42,8 +45,24 @@ RocksDBBackend<TKey>::RocksDBBackend(const std::string& path, const size_t num_t
   // Configure various behaviors and options used in later operations.
   column_family_options_.OptimizeForPointLookup(8);
   column_family_options_.OptimizeLevelStyleCompaction();
-  // Need to tune: read_options_.readahead_size
-  // Need to tune: read_options_.verify_checksums
+
+  // Tune SST filters for the pure point-lookup access pattern of embedding tables. Full-format
+  // bloom filters let Get/MultiGet reject absent keys without touching data blocks, and pinning
+  // the filter/index blocks keeps these hot structures resident across queries.
+  {
+    rocksdb::BlockBasedTableOptions table_options;
+    table_options.filter_policy.reset(rocksdb::NewBloomFilterPolicy(10, false));
+    table_options.whole_key_filtering = true;
+    table_options.cache_index_and_filter_blocks = true;
+    table_options.pin_l0_filter_and_index_blocks_in_cache = true;
+    table_options.data_block_index_type =
+        rocksdb::BlockBasedTableOptions::DataBlockIndexType::kDataBlockBinaryAndHash;
+    column_family_options_.table_factory.reset(
+        rocksdb::NewBlockBasedTableFactory(table_options));
+  }
+
+  // Embedding fetches never scan ranges, so sequential readahead would just pollute the cache.
+  read_options_.readahead_size = 0;
   write_options_.sync = false;
 
   // Enumerate column families.
@@ -64,52 +64,19 @@ __global__ void init_kernel(KeyType* keys, CounterType* vals, CounterType* count
   }
 }
 
-template <typename KeyType, typename CounterType>
-__global__ void dump_kernel(KeyType* d_key, const KeyType* keys, const CounterType* vals,
-                            const size_t offset, const size_t search_length, size_t* d_dump_counter,
-                            const KeyType empty_key) {
-  /* Per block accumulator */
-  __shared__ size_t block_acc;
-
-  const size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
-
-  /* Initialize */
-  if (threadIdx.x == 0) {
-    block_acc = 0;
-  }
-  __syncthreads();
-
-  KeyType read_key;
-  CounterType read_val;
-  bool valid_slot = false;
-  // Each thread gather the key and value from slot assigned to them.
-  if (idx < search_length) {
-    read_key = keys[offset + idx];
-    if (read_key != empty_key) {
-      valid_slot = true;
-      atomicAdd(&block_acc, 1);
-      read_val = vals[offset + idx];
-    }
-  }
-  __syncthreads();
-
-  // Each block accumulate the dump count to global counter
-  if (threadIdx.x == 0) {
-    atomicAdd(d_dump_counter, block_acc);
-  }
-
-  // Each thread store one slot's data back to global memory, d_dump_counter is how many slots in
-  // total dumped.
-  if (valid_slot) {
-    d_key[read_val] = read_key;
-  }
+// Single-thread kernel that publishes the unique key count, i.e. the distance the global counter
+// travelled while the get_insert kernel deduplicated the batch.
+template <typename CounterType>
+__global__ void dump_counter_kernel(size_t* d_output_counter, const CounterType* d_global_counter,
+                                    const CounterType init_counter_val) {
+  *d_output_counter = static_cast<size_t>(*d_global_counter - init_counter_val);
 }
 
 template <typename KeyType, typename CounterType, typename hasher>
 __global__ void get_insert_kernel(const KeyType* d_key, CounterType* d_val, const size_t len,
                                   KeyType* keys, CounterType* vals, const size_t capacity,
-                                  CounterType* d_global_counter, const KeyType empty_key,
-                                  const CounterType empty_val) {
+                                  CounterType* d_global_counter, KeyType* d_unique_key,
+                                  const KeyType empty_key, const CounterType empty_val) {
   const size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
   if (idx < len) {
     KeyType target_key = d_key[idx];
@@ -128,6 +95,9 @@ __global__ void get_insert_kernel(const KeyType* d_key, CounterType* d_val, cons
         CounterType result_val;
         result_val = atomicAdd(d_global_counter, 1);
         d_val[idx] = result_val;
+        // The CAS winner owns this unique key, store it to the compacted output directly. This
+        // replaces a separate capacity-wide dump pass over the hashtable.
+        d_unique_key[result_val] = target_key;
         target_val_pos = result_val;
         break;
       } else if (target_key == old_key) {
@@ -206,21 +176,22 @@ void unique_op<KeyType, CounterType, empty_key, empty_val, hasher>::unique(
   // Set to the device of this op
   HCTR_LIB_THROW(cudaSetDevice(dev_));
 
-  // Set the d_output_counter to 0
-  HCTR_LIB_THROW(cudaMemsetAsync(d_output_counter, 0, sizeof(size_t), stream));
-
   if (len == 0) {
+    // Set the d_output_counter to 0
+    HCTR_LIB_THROW(cudaMemsetAsync(d_output_counter, 0, sizeof(size_t), stream));
     return;
   }
 
-  // Launch get_insert kernel to do unique
+  // Launch get_insert kernel to do unique. The kernel emits the compacted unique keys directly as
+  // the deduplication hashtable is built, so no separate dump pass over the table is needed.
   get_insert_kernel<KeyType, CounterType, hasher>
-      <<<(len - 1) / BLOCK_SIZE_ + 1, BLOCK_SIZE_, 0, stream>>>(
-          d_key, d_output_index, len, keys_, vals_, capacity_, counter_, empty_key, empty_val);
+      <<<(len - 1) / BLOCK_SIZE_ + 1, BLOCK_SIZE_, 0, stream>>>(d_key, d_output_index, len, keys_,
+                                                                vals_, capacity_, counter_,
+                                                                d_unique_key, empty_key, empty_val);
 
-  // Launch dump kernel
-  dump_kernel<KeyType, CounterType><<<(capacity_ - 1) / BLOCK_SIZE_ + 1, BLOCK_SIZE_, 0, stream>>>(
-      d_unique_key, keys_, vals_, 0, capacity_, d_output_counter, empty_key);
+  // Publish the unique key count
+  dump_counter_kernel<CounterType>
+      <<<1, 1, 0, stream>>>(d_output_counter, counter_, init_counter_val_);
 
   HCTR_LIB_THROW(cudaGetLastError());
 }
@@ -154,6 +154,37 @@ __global__ void embedding_feature_combine_tiled_kernel(const float* input, __hal
   }    // end if
 }
 
+template <typename TypeEmbedding>
+__global__ void fused_embedding_feature_combine_kernel(
+    const EmbeddingFeatureCombineParams<TypeEmbedding>* params, int batch_size) {
+  const auto& block = cooperative_groups::this_thread_block();
+  // each block partition corresponding to one sample, blockIdx.y selects the table
+  const int bid = block.group_index().x;
+  // each thread corresponding to one element in the embedding vector
+  const int tid = block.thread_rank();
+  const EmbeddingFeatureCombineParams<TypeEmbedding> p = params[block.group_index().y];
+
+  if (bid < batch_size && tid < p.embedding_vec_size) {
+    for (int i = 0; i < p.slot_num; i++) {
+      int feature_row_index = bid * p.slot_num + i;
+      int row_offset = p.row_ptrs[feature_row_index];  // row offset within input
+      int feature_num =
+          p.row_ptrs[feature_row_index + 1] - row_offset;  // num of feature vectors in one slot
+
+      float tmp = 0.0f;
+      // reduce in one slot
+      for (int j = 0; j < feature_num; j++)
+        tmp += p.input[(row_offset + j) * p.embedding_vec_size + tid];
+
+      if (p.combiner_type == EmbeddingFeatureCombiner_t::Mean && feature_num > 1) {
+        tmp /= feature_num;
+      }
+      p.output[feature_row_index * p.embedding_vec_size + tid] =
+          TypeConvertFunc<TypeEmbedding, float>::convert(tmp);
+    }  // end for
+  }    // end if
+}
+
 template <typename TypeEmbedding>
 void launch_embedding_feature_combine_kernel(const float* input, TypeEmbedding* output,
                                              const int* row_ptrs, int batch_size, int slot_num,
@@ -260,7 +291,75 @@ void EmbeddingFeatureCombiner<TypeEmbedding>::fprop(bool is_train) {
 #endif
 }
 
+template <typename TypeEmbedding>
+EmbeddingFeatureCombineParams<TypeEmbedding>
+EmbeddingFeatureCombiner<TypeEmbedding>::get_combine_params() {
+  EmbeddingFeatureCombineParams<TypeEmbedding> params;
+  params.input = in_tensors_[0]->get_ptr();
+  params.output = out_tensors_[0].get_ptr();
+  params.row_ptrs = row_ptrs_tensors_[0]->get_ptr();
+  params.slot_num = slot_num_;
+  params.embedding_vec_size = embedding_vec_size_;
+  params.combiner_type = combiner_type_;
+  return params;
+}
+
+template <typename TypeEmbedding>
+FusedEmbeddingFeatureCombine<TypeEmbedding>::FusedEmbeddingFeatureCombine(
+    const std::vector<std::shared_ptr<Layer>>& combiners, int batch_size,
+    const std::shared_ptr<GPUResource>& gpu_resource)
+    : batch_size_(batch_size), gpu_resource_(gpu_resource) {
+  try {
+    if (combiners.empty()) {
+      HCTR_OWN_THROW(Error_t::WrongInput, "There is no combiner layer to fuse");
+    }
+    h_params_.reserve(combiners.size());
+    for (const auto& combiner : combiners) {
+      auto typed_combiner = dynamic_cast<EmbeddingFeatureCombiner<TypeEmbedding>*>(combiner.get());
+      if (typed_combiner == nullptr) {
+        HCTR_OWN_THROW(Error_t::WrongInput,
+                       "The layer to fuse is not an EmbeddingFeatureCombiner of this type");
+      }
+      h_params_.push_back(typed_combiner->get_combine_params());
+      max_embedding_vec_size_ =
+          std::max(max_embedding_vec_size_, h_params_.back().embedding_vec_size);
+    }
+
+    CudaDeviceContext context(gpu_resource_->get_device_id());
+    const size_t params_size_in_byte =
+        h_params_.size() * sizeof(EmbeddingFeatureCombineParams<TypeEmbedding>);
+    HCTR_LIB_THROW(cudaMalloc((void**)&d_params_, params_size_in_byte));
+    HCTR_LIB_THROW(
+        cudaMemcpy(d_params_, h_params_.data(), params_size_in_byte, cudaMemcpyHostToDevice));
+  } catch (const std::runtime_error& rt_err) {
+    HCTR_LOG_S(ERROR, WORLD) << rt_err.what() << std::endl;
+    throw;
+  }
+}
+
+template <typename TypeEmbedding>
+FusedEmbeddingFeatureCombine<TypeEmbedding>::~FusedEmbeddingFeatureCombine() {
+  CudaDeviceContext context(gpu_resource_->get_device_id());
+  cudaFree(d_params_);
+}
+
+template <typename TypeEmbedding>
+void FusedEmbeddingFeatureCombine<TypeEmbedding>::fprop() {
+  CudaDeviceContext context(gpu_resource_->get_device_id());
+  // one launch covers all tables: blockIdx.y is the table, blockIdx.x the sample
+  dim3 grid(batch_size_, h_params_.size());
+  fused_embedding_feature_combine_kernel<<<grid, max_embedding_vec_size_, 0,
+                                           gpu_resource_->get_stream()>>>(d_params_, batch_size_);
+
+#ifndef NDEBUG
+  cudaDeviceSynchronize();
+  HCTR_LIB_THROW(cudaGetLastError());
+#endif
+}
+
 template class EmbeddingFeatureCombiner<float>;
 template class EmbeddingFeatureCombiner<__half>;
+template class FusedEmbeddingFeatureCombine<float>;
+template class FusedEmbeddingFeatureCombine<__half>;
 
 }  // namespace HugeCTR
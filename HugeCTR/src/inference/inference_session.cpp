@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <inference/embedding_feature_combiner.hpp>
 #include <inference/inference_session.hpp>
 #include <iostream>
 #include <resource_managers/resource_manager_core.hpp>
@@ -25,17 +26,20 @@ InferenceSessionBase::~InferenceSessionBase() = default;
 
 std::shared_ptr<InferenceSessionBase> InferenceSessionBase::create(
     const std::string& model_config_path, const InferenceParams& inference_params,
-    const std::shared_ptr<EmbeddingCacheBase>& embedding_cache) {
-  return std::make_shared<InferenceSession>(model_config_path, inference_params, embedding_cache);
+    const std::shared_ptr<EmbeddingCacheBase>& embedding_cache, const bool embedding_only) {
+  return std::make_shared<InferenceSession>(model_config_path, inference_params, embedding_cache,
+                                            nullptr, embedding_only);
 }
 
 InferenceSession::InferenceSession(const std::string& model_config_path,
                                    const InferenceParams& inference_params,
                                    const std::shared_ptr<EmbeddingCacheBase>& embedding_cache,
-                                   std::shared_ptr<ResourceManager> resource_manager)
+                                   std::shared_ptr<ResourceManager> resource_manager,
+                                   const bool embedding_only)
     : InferenceSessionBase(),
       config_(read_json_file(model_config_path)),
       embedding_table_slot_size_({0}),
+      embedding_only_(embedding_only),
       embedding_cache_(embedding_cache),
       inference_parser_(config_),
       inference_params_(inference_params) {
@@ -56,28 +60,29 @@ InferenceSession::InferenceSession(const std::string& model_config_path,
     HCTR_LOG(INFO, ROOT, "Use cuda graph: %s\n", b2s(inference_params.use_cuda_graph));
     HCTR_LOG(INFO, ROOT, "Max batchsize: %lu\n", inference_params.max_batchsize);
     HCTR_LOG(INFO, ROOT, "Use I64 input key: %s\n", b2s(inference_params.i64_input_key));
-    Network* network_ptr;
-    inference_parser_.create_pipeline(
-        inference_params_, dense_input_tensorbag_, row_ptrs_tensors_, embedding_features_tensors_,
-        embedding_table_slot_size_, &embedding_feature_combiners_, &network_ptr, resource_manager_);
-
-    auto dense_network_feedforward =
-        std::make_shared<StreamContextScheduleable>([=] { network_->predict(); });
-    predict_network_pipeline_ = Pipeline(
-        "default", resource_manager_->get_local_gpu_from_device_id(inference_params.device_id),
-        {dense_network_feedforward});
-
-    network_ = std::move(std::unique_ptr<Network>(network_ptr));
-    network_->initialize(false);
-    if (inference_params.use_algorithm_search) {
-      network_->search_algorithm();
-    }
-    if (inference_params_.dense_model_file.size() > 0) {
-      network_->upload_params_to_device_inference(inference_params_.dense_model_file);
-    }
-    if (inference_params_.non_trainable_params_file.size() > 0) {
-      network_->upload_non_trainable_params_to_device_inference(
-          inference_params_.non_trainable_params_file);
+    Network* network_ptr{nullptr};
+    inference_parser_.create_pipeline(inference_params_, dense_input_tensorbag_, row_ptrs_tensors_,
+                                      embedding_features_tensors_, embedding_table_slot_size_,
+                                      &embedding_feature_combiners_,
+                                      embedding_only_ ? nullptr : &network_ptr, resource_manager_);
+
+    if (embedding_only_) {
+      HCTR_LOG(INFO, ROOT,
+               "Embedding-only session: the dense network is not built; combined embedding "
+               "features are served through predict_embedding_only\n");
+    } else {
+      network_ = std::move(std::unique_ptr<Network>(network_ptr));
+      network_->initialize(false);
+      if (inference_params.use_algorithm_search) {
+        network_->search_algorithm();
+      }
+      if (inference_params_.dense_model_file.size() > 0) {
+        network_->upload_params_to_device_inference(inference_params_.dense_model_file);
+      }
+      if (inference_params_.non_trainable_params_file.size() > 0) {
+        network_->upload_non_trainable_params_to_device_inference(
+            inference_params_.non_trainable_params_file);
+      }
     }
     CudaDeviceContext context(inference_params_.device_id);
     for (size_t idx = 0; idx < inference_params_.sparse_model_files.size(); ++idx) {
@@ -85,16 +90,77 @@ InferenceSession::InferenceSession(const std::string& model_config_path,
       cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking);
       streams_.push_back(stream);
     }
-    h_row_ptrs_ = (int*)malloc((inference_params_.max_batchsize * inference_parser_.slot_num +
-                                inference_parser_.num_embedding_tables) *
-                               sizeof(int));
+    // Both host buffers take part in cuda memcpys every predict (h_row_ptrs_ as a D2H
+    // destination, h_keys_ as the embedding cache lookup source), so allocate them pinned.
+    HCTR_LIB_THROW(cudaMallocHost((void**)&h_row_ptrs_,
+                                  (inference_params_.max_batchsize * inference_parser_.slot_num +
+                                   inference_parser_.num_embedding_tables) *
+                                      sizeof(int)));
     // h_keys_ is a void pointer, which serves key types of both long long and unsigned int
-    h_keys_ = malloc(inference_params_.max_batchsize *
-                     inference_parser_.max_feature_num_per_sample * sizeof(long long));
+    HCTR_LIB_THROW(cudaMallocHost(&h_keys_,
+                                  inference_params_.max_batchsize *
+                                      inference_parser_.max_feature_num_per_sample *
+                                      sizeof(long long)));
     HCTR_LIB_THROW(cudaMalloc((void**)&d_embedding_vectors_,
                               inference_params_.max_batchsize *
                                   inference_parser_.max_embedding_vector_size_per_sample *
                                   sizeof(float)));
+    const size_t row_ptrs_size = inference_params_.max_batchsize * inference_parser_.slot_num +
+                                 inference_parser_.num_embedding_tables;
+    HCTR_LIB_THROW(cudaMalloc((void**)&d_row_ptrs_, row_ptrs_size * sizeof(int)));
+    HCTR_LIB_THROW(cudaMemset(d_row_ptrs_, 0, row_ptrs_size * sizeof(int)));
+
+    // Bind the combiner inputs to the session-owned buffers once. The bindings (and thus the
+    // pointers baked into the captured graph) stay valid for the lifetime of the session;
+    // predict only has to refresh the buffer contents.
+    size_t acc_vectors_offset{0};
+    size_t acc_row_ptrs_offset{0};
+    for (size_t i = 0; i < inference_parser_.num_embedding_tables; ++i) {
+      auto row_ptrs_dims = row_ptrs_tensors_[i]->get_dimensions();
+      std::shared_ptr<TensorBuffer2> row_ptrs_buff =
+          PreallocatedBuffer2<int>::create(d_row_ptrs_ + acc_row_ptrs_offset, row_ptrs_dims);
+      bind_tensor_to_buffer(row_ptrs_dims, row_ptrs_buff, row_ptrs_tensors_[i]);
+      acc_row_ptrs_offset +=
+          inference_params_.max_batchsize * inference_parser_.slot_num_for_tables[i] + 1;
+
+      auto embedding_features_dims = embedding_features_tensors_[i]->get_dimensions();
+      std::shared_ptr<TensorBuffer2> embedding_features_buff = PreallocatedBuffer2<float>::create(
+          d_embedding_vectors_ + acc_vectors_offset, embedding_features_dims);
+      bind_tensor_to_buffer(embedding_features_dims, embedding_features_buff,
+                            embedding_features_tensors_[i]);
+      acc_vectors_offset += inference_params_.max_batchsize *
+                            inference_parser_.max_feature_num_for_tables[i] *
+                            inference_parser_.embed_vec_size_for_tables[i];
+    }
+
+    // The feature combiners and the dense network form one fixed-shape pipeline, so a single
+    // graph replay covers the whole post-embedding forward instead of per-layer launches.
+    std::vector<std::shared_ptr<Scheduleable>> scheduleable_list;
+    auto local_gpu = resource_manager_->get_local_gpu_from_device_id(inference_params.device_id);
+    if (inference_parser_.num_embedding_tables > 1) {
+      // With multiple tables, one fused launch replaces the per-table combine kernels.
+      if (inference_params_.use_mixed_precision) {
+        auto fused_combiner = std::make_shared<FusedEmbeddingFeatureCombine<__half>>(
+            embedding_feature_combiners_, inference_params_.max_batchsize, local_gpu);
+        scheduleable_list.push_back(
+            std::make_shared<StreamContextScheduleable>([=] { fused_combiner->fprop(); }));
+      } else {
+        auto fused_combiner = std::make_shared<FusedEmbeddingFeatureCombine<float>>(
+            embedding_feature_combiners_, inference_params_.max_batchsize, local_gpu);
+        scheduleable_list.push_back(
+            std::make_shared<StreamContextScheduleable>([=] { fused_combiner->fprop(); }));
+      }
+    } else {
+      for (size_t i = 0; i < inference_parser_.num_embedding_tables; ++i) {
+        scheduleable_list.push_back(std::make_shared<StreamContextScheduleable>(
+            [=] { embedding_feature_combiners_[i]->fprop(false); }));
+      }
+    }
+    if (!embedding_only_) {
+      scheduleable_list.push_back(
+          std::make_shared<StreamContextScheduleable>([=] { network_->predict(); }));
+    }
+    predict_network_pipeline_ = Pipeline("default", local_gpu, scheduleable_list);
   } catch (const std::runtime_error& rt_err) {
     HCTR_LOG_S(ERROR, WORLD) << rt_err.what() << std::endl;
     throw;
@@ -104,14 +170,15 @@ InferenceSession::InferenceSession(const std::string& model_config_path,
 
 InferenceSession::~InferenceSession() {
   CudaDeviceContext context(inference_params_.device_id);
+  cudaFree(d_row_ptrs_);
   cudaFree(d_embedding_vectors_);
-  free(h_keys_);
-  free(h_row_ptrs_);
+  cudaFreeHost(h_keys_);
+  cudaFreeHost(h_row_ptrs_);
   for (auto stream : streams_) cudaStreamDestroy(stream);
 }
 
-void InferenceSession::predict(float* d_dense, void* h_embeddingcolumns, int* d_row_ptrs,
-                               float* d_output, int num_samples, bool table_major_key_layout) {
+void InferenceSession::lookup_and_stage_(void* h_embeddingcolumns, int* d_row_ptrs,
+                                         int num_samples, bool table_major_key_layout) {
   size_t num_embedding_tables = inference_parser_.num_embedding_tables;
   if (num_embedding_tables != row_ptrs_tensors_.size() ||
       num_embedding_tables != embedding_features_tensors_.size() ||
@@ -140,6 +207,32 @@ void InferenceSession::predict(float* d_dense, void* h_embeddingcolumns, int* d_
   }
   void* h_keys_for_ec = table_major_key_layout ? h_embeddingcolumns : h_keys_;
 
+  // In the table-major layout the caller's buffer feeds the embedding cache lookups directly.
+  // Some serving backends hand us pageable memory there; route it through a pooled pinned
+  // block (one extra host memcpy) so the per-table H2D copies stay pinned transfers. Pinned
+  // or registered caller buffers are used as-is.
+  void* staged_keys = nullptr;
+  if (table_major_key_layout) {
+    cudaPointerAttributes attributes;
+    cudaError_t query = cudaPointerGetAttributes(&attributes, h_embeddingcolumns);
+    if (query != cudaSuccess) {
+      cudaGetLastError();  // older drivers report unregistered memory as an error
+    }
+    if (query != cudaSuccess || attributes.type == cudaMemoryTypeUnregistered) {
+      const size_t key_size =
+          inference_params_.i64_input_key ? sizeof(long long) : sizeof(unsigned int);
+      size_t total_keys{0};
+      size_t row_ptrs_offset{0};
+      for (size_t i = 0; i < num_embedding_tables; ++i) {
+        row_ptrs_offset += num_samples * inference_parser_.slot_num_for_tables[i] + 1;
+        total_keys += h_row_ptrs_[row_ptrs_offset - 1];
+      }
+      staged_keys = pinned_staging_pool_.acquire(total_keys * key_size);
+      memcpy(staged_keys, h_embeddingcolumns, total_keys * key_size);
+      h_keys_for_ec = staged_keys;
+    }
+  }
+
   CudaDeviceContext context(
       resource_manager_->get_local_gpu_from_device_id(inference_params_.device_id)
           ->get_device_id());
@@ -168,6 +261,36 @@ void InferenceSession::predict(float* d_dense, void* h_embeddingcolumns, int* d_
   for (size_t i = 0; i < num_embedding_tables; ++i) {
     HCTR_LIB_THROW(cudaStreamSynchronize(streams_[i]));
   }
+  if (staged_keys) {
+    pinned_staging_pool_.release(staged_keys);
+  }
+
+  // Stage the row pointers into the session-owned buffer the combiner tensors are bound to.
+  // The caller packs them by num_samples while the bindings use max_batchsize strides, so
+  // each table is copied to its fixed offset.
+  acc_row_ptrs_offset = 0;
+  size_t dst_row_ptrs_offset{0};
+  cudaStream_t stream =
+      resource_manager_->get_local_gpu_from_device_id(inference_params_.device_id)->get_stream();
+  for (size_t i = 0; i < num_embedding_tables; ++i) {
+    const size_t num_row_ptrs = num_samples * inference_parser_.slot_num_for_tables[i] + 1;
+    HCTR_LIB_THROW(cudaMemcpyAsync(d_row_ptrs_ + dst_row_ptrs_offset,
+                                   d_row_ptrs + acc_row_ptrs_offset, num_row_ptrs * sizeof(int),
+                                   cudaMemcpyDeviceToDevice, stream));
+    acc_row_ptrs_offset += num_row_ptrs;
+    dst_row_ptrs_offset +=
+        inference_params_.max_batchsize * inference_parser_.slot_num_for_tables[i] + 1;
+  }
+}
+
+void InferenceSession::predict(float* d_dense, void* h_embeddingcolumns, int* d_row_ptrs,
+                               float* d_output, int num_samples, bool table_major_key_layout) {
+  if (embedding_only_) {
+    HCTR_OWN_THROW(Error_t::IllegalCall,
+                   "predict is unavailable: this session was created for embedding-only serving");
+  }
+  CudaDeviceContext context(inference_params_.device_id);
+  lookup_and_stage_(h_embeddingcolumns, d_row_ptrs, num_samples, table_major_key_layout);
 
   // convert dense input to dense tensor
   auto dense_dims = dense_input_tensorbag_.get_dimensions();
@@ -186,30 +309,7 @@ void InferenceSession::predict(float* d_dense, void* h_embeddingcolumns, int* d_
         resource_manager_->get_local_gpu_from_device_id(inference_params_.device_id)->get_stream());
   }
 
-  acc_vectors_offset = 0;
-  acc_row_ptrs_offset = 0;
-  for (size_t i = 0; i < num_embedding_tables; ++i) {
-    // bind row ptrs input to row ptrs tensor
-    auto row_ptrs_dims = row_ptrs_tensors_[i]->get_dimensions();
-    std::shared_ptr<TensorBuffer2> row_ptrs_buff =
-        PreallocatedBuffer2<int>::create(d_row_ptrs + acc_row_ptrs_offset, row_ptrs_dims);
-    bind_tensor_to_buffer(row_ptrs_dims, row_ptrs_buff, row_ptrs_tensors_[i]);
-    acc_row_ptrs_offset += num_samples * inference_parser_.slot_num_for_tables[i] + 1;
-
-    // bind embedding vectors from looking up to embedding features tensor
-    auto embedding_features_dims = embedding_features_tensors_[i]->get_dimensions();
-    std::shared_ptr<TensorBuffer2> embeddding_features_buff = PreallocatedBuffer2<float>::create(
-        d_embedding_vectors_ + acc_vectors_offset, embedding_features_dims);
-    bind_tensor_to_buffer(embedding_features_dims, embeddding_features_buff,
-                          embedding_features_tensors_[i]);
-    acc_vectors_offset += inference_params_.max_batchsize *
-                          inference_parser_.max_feature_num_for_tables[i] *
-                          inference_parser_.embed_vec_size_for_tables[i];
-    // feature combiner feedforward
-    embedding_feature_combiners_[i]->fprop(false);
-  }
-
-  // dense network feedforward
+  // feature combiner and dense network feedforward
 
   if (inference_params_.use_cuda_graph) {
     predict_network_pipeline_.run_graph();
@@ -233,4 +333,50 @@ void InferenceSession::predict(float* d_dense, void* h_embeddingcolumns, int* d_
       resource_manager_->get_local_gpu_from_device_id(inference_params_.device_id)->get_stream()));
 }
 
+void InferenceSession::predict_embedding_only(void* h_embeddingcolumns, int* d_row_ptrs,
+                                              float* d_embedding_features, int num_samples,
+                                              bool table_major_key_layout) {
+  if (!embedding_only_) {
+    HCTR_OWN_THROW(Error_t::IllegalCall,
+                   "predict_embedding_only requires a session created with embedding_only");
+  }
+  CudaDeviceContext context(inference_params_.device_id);
+  lookup_and_stage_(h_embeddingcolumns, d_row_ptrs, num_samples, table_major_key_layout);
+
+  // Feature combiners only; no dense network follows.
+  if (inference_params_.use_cuda_graph) {
+    predict_network_pipeline_.run_graph();
+  } else {
+    predict_network_pipeline_.run();
+  }
+
+  // Export the combined features table by table. Each combiner output is contiguous, so the
+  // first num_samples rows can be copied out in one transfer per table.
+  cudaStream_t stream =
+      resource_manager_->get_local_gpu_from_device_id(inference_params_.device_id)->get_stream();
+  size_t dst_offset{0};
+  for (size_t i = 0; i < inference_parser_.num_embedding_tables; ++i) {
+    const size_t num_elements = static_cast<size_t>(num_samples) *
+                                inference_parser_.slot_num_for_tables[i] *
+                                inference_parser_.embed_vec_size_for_tables[i];
+    if (inference_params_.use_mixed_precision) {
+      auto combiner = dynamic_cast<EmbeddingFeatureCombiner<__half>*>(
+          embedding_feature_combiners_[i].get());
+      HCTR_CHECK_HINT(combiner != nullptr, "unexpected embedding feature combiner type\n");
+      convert_array_on_device(d_embedding_features + dst_offset,
+                              combiner->get_combine_params().output, num_elements, stream);
+    } else {
+      auto combiner =
+          dynamic_cast<EmbeddingFeatureCombiner<float>*>(embedding_feature_combiners_[i].get());
+      HCTR_CHECK_HINT(combiner != nullptr, "unexpected embedding feature combiner type\n");
+      HCTR_LIB_THROW(cudaMemcpyAsync(d_embedding_features + dst_offset,
+                                     combiner->get_combine_params().output,
+                                     num_elements * sizeof(float), cudaMemcpyDeviceToDevice,
+                                     stream));
+    }
+    dst_offset += num_elements;
+  }
+  HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+}
+
 }  // namespace HugeCTR
@@ -17,11 +17,14 @@
 #include <base/debug/logger.hpp>
 #include <io/filesystem.hpp>
 #include <io/hadoop_filesystem.hpp>
+#include <io/local_filesystem.hpp>
 
 namespace HugeCTR {
 
 FileSystem* DataSourceParams::create() const {
   switch (type) {
+    case DataSourceType_t::Local:
+      return new LocalFileSystem{};
     case DataSourceType_t::HDFS:
 #ifdef ENABLE_HDFS
       return new HadoopFileSystem{server, port};
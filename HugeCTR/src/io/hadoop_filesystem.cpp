@@ -16,15 +16,65 @@
 
 #include "io/hadoop_filesystem.hpp"
 
+#include <algorithm>
 #include <base/debug/logger.hpp>
+#include <cstring>
 #include <exception>
 #include <fstream>
 #include <iostream>
+#include <map>
 
 #include "nlohmann/json.hpp"
 
 namespace HugeCTR {
 #ifdef ENABLE_HDFS
+
+namespace {
+
+// Every reader worker constructs its own HadoopFileSystem through DataSourceParams::create, so
+// without pooling each of them opens a separate connection to the name node. Share one hdfsFS
+// per (name node, port) endpoint instead and hand it out refcounted.
+struct PooledConnection {
+  hdfsFS fs = nullptr;
+  int ref_count = 0;
+};
+
+std::mutex g_connection_pool_mutex;
+std::map<std::pair<std::string, int>, PooledConnection> g_connection_pool;
+
+hdfsFS acquire_connection(const std::string& namenode, int port) {
+  std::lock_guard<std::mutex> lock(g_connection_pool_mutex);
+
+  auto& conn = g_connection_pool[{namenode, port}];
+  if (!conn.fs) {
+    hdfsBuilder* const bld = hdfsNewBuilder();
+    HCTR_CHECK_HINT(bld, "Unable to create HDFS builder.");
+
+    hdfsBuilderSetNameNode(bld, namenode.empty() ? nullptr : namenode.c_str());
+    hdfsBuilderSetNameNodePort(bld, port);
+    hdfsBuilderSetForceNewInstance(bld);
+
+    conn.fs = hdfsBuilderConnect(bld);
+  }
+  conn.ref_count++;
+  return conn.fs;
+}
+
+void release_connection(const std::string& namenode, int port) {
+  std::lock_guard<std::mutex> lock(g_connection_pool_mutex);
+
+  auto it = g_connection_pool.find({namenode, port});
+  if (it == g_connection_pool.end() || !it->second.fs) {
+    return;
+  }
+  if (--it->second.ref_count == 0) {
+    const int res = hdfsDisconnect(it->second.fs);
+    HCTR_CHECK_HINT(!res, "Unable to disconnect HDFS.");
+    g_connection_pool.erase(it);
+  }
+}
+
+}  // namespace
 void HdfsConfigs::set_buffer_size(int32_t buffer_size) { this->buffer_size = buffer_size; }
 
 void HdfsConfigs::set_replication(int16_t replication) { this->replication = replication; }
@@ -106,42 +156,29 @@ HadoopFileSystem::HadoopFileSystem(const std::string& name_node, const int port)
   connect_to_local();
 }
 
-HadoopFileSystem::~HadoopFileSystem() { disconnect(); }
+HadoopFileSystem::~HadoopFileSystem() {
+  reset_readahead_window();
+  disconnect();
+}
 
 void HadoopFileSystem::disconnect() {
   if (fs_) {
-    const int res = hdfsDisconnect(fs_);
-    HCTR_CHECK_HINT(!res, "Unable to disconnect HDFS.");
+    release_connection(configs_.namenode, configs_.port);
     fs_ = nullptr;
   }
 
   if (local_fs_) {
-    const int res = hdfsDisconnect(local_fs_);
-    HCTR_CHECK_HINT(!res, "Unable to disconnect local FS.");
+    release_connection("", 0);
     local_fs_ = nullptr;
   }
 }
 void HadoopFileSystem::connect() {
-  hdfsBuilder* const bld = hdfsNewBuilder();
-  HCTR_CHECK_HINT(bld, "Unable to create HDFS builder.");
-
-  hdfsBuilderSetNameNode(bld, configs_.namenode.c_str());
-  hdfsBuilderSetNameNodePort(bld, configs_.port);
-  hdfsBuilderSetForceNewInstance(bld);
-
-  fs_ = hdfsBuilderConnect(bld);
+  fs_ = acquire_connection(configs_.namenode, configs_.port);
   HCTR_CHECK_HINT(fs_, "Unable to connect to HDFS.");
 }
 
 void HadoopFileSystem::connect_to_local() {
-  hdfsBuilder* const bld = hdfsNewBuilder();
-  HCTR_CHECK_HINT(bld, "Unable to create HDFS builder.");
-
-  hdfsBuilderSetNameNode(bld, nullptr);
-  hdfsBuilderSetNameNodePort(bld, 0);
-  hdfsBuilderSetForceNewInstance(bld);
-
-  local_fs_ = hdfsBuilderConnect(bld);
+  local_fs_ = acquire_connection("", 0);
   HCTR_CHECK_HINT(local_fs_, "Unable to connect to Local FS.");
 }
 
@@ -227,21 +264,102 @@ int HadoopFileSystem::write(const std::string& path, const void* const data, con
   return num_written;
 }
 
-int HadoopFileSystem::read(const std::string& path, void* const buffer, const size_t buffer_size,
-                           const size_t offset) {
-  HCTR_CHECK_HINT(fs_, "Not connected to HDFS.");
-  HCTR_CHECK_HINT(buffer, "Buffer pointer is invalid.");
-
+int HadoopFileSystem::read_direct(const std::string& path, void* const buffer,
+                                  const size_t buffer_size, const size_t offset) {
   hdfsFile file = hdfsOpenFile(fs_, path.c_str(), O_RDONLY, 0, 0, 0);
   HCTR_CHECK_HINT(file, "Failed to open HDFS file.");
 
   const tSize num_read = hdfsPread(fs_, file, offset, buffer, buffer_size);
-  HCTR_CHECK_HINT(num_read == buffer_size, "Reading HDFS file failed.");
   HCTR_CHECK_HINT(!hdfsCloseFile(fs_, file), "Closing HDFS file failed.");
 
   return num_read;
 }
 
+void HadoopFileSystem::fill_readahead_window() {
+  while (readahead_window_.size() < static_cast<size_t>(READAHEAD_DEPTH)) {
+    ReadaheadSlot slot;
+    if (!readahead_buffer_pool_.empty()) {
+      slot.data = std::move(readahead_buffer_pool_.back());
+      readahead_buffer_pool_.pop_back();
+    } else {
+      slot.data.resize(READAHEAD_BLOCK_SIZE);
+    }
+    slot.offset = readahead_next_offset_;
+    // Each block read opens its own handle: hdfsPread on a shared handle is not safe to issue
+    // concurrently, and the open cost is amortized over the whole block.
+    char* const dst = slot.data.data();
+    const std::string block_path = readahead_path_;
+    const size_t block_offset = slot.offset;
+    slot.pending = std::async(std::launch::async, [this, block_path, dst, block_offset]() {
+      return read_direct(block_path, dst, READAHEAD_BLOCK_SIZE, block_offset);
+    });
+    readahead_next_offset_ += READAHEAD_BLOCK_SIZE;
+    readahead_window_.push_back(std::move(slot));
+  }
+}
+
+void HadoopFileSystem::reset_readahead_window() {
+  std::lock_guard<std::mutex> lock(readahead_mutex_);
+  for (auto& slot : readahead_window_) {
+    if (!slot.resolved) {
+      slot.pending.wait();
+    }
+    readahead_buffer_pool_.push_back(std::move(slot.data));
+  }
+  readahead_window_.clear();
+  readahead_path_.clear();
+}
+
+int HadoopFileSystem::read(const std::string& path, void* const buffer, const size_t buffer_size,
+                           const size_t offset) {
+  HCTR_CHECK_HINT(fs_, "Not connected to HDFS.");
+  HCTR_CHECK_HINT(buffer, "Buffer pointer is invalid.");
+
+  std::lock_guard<std::mutex> lock(readahead_mutex_);
+
+  // The window only helps a sequential scan; restart it when the caller jumps elsewhere.
+  if (path != readahead_path_ || offset != readahead_consumer_offset_) {
+    for (auto& slot : readahead_window_) {
+      if (!slot.resolved) {
+        slot.pending.wait();
+      }
+      readahead_buffer_pool_.push_back(std::move(slot.data));
+    }
+    readahead_window_.clear();
+    readahead_path_ = path;
+    readahead_next_offset_ = offset;
+    readahead_consumer_offset_ = offset;
+  }
+  fill_readahead_window();
+
+  size_t copied = 0;
+  while (copied < buffer_size) {
+    ReadaheadSlot& slot = readahead_window_.front();
+    if (!slot.resolved) {
+      slot.size = slot.pending.get();
+      slot.resolved = true;
+    }
+    const size_t slot_pos = readahead_consumer_offset_ - slot.offset;
+    HCTR_CHECK_HINT(static_cast<size_t>(slot.size) > slot_pos, "Reading HDFS file failed.");
+    const size_t copy_len =
+        std::min(static_cast<size_t>(slot.size) - slot_pos, buffer_size - copied);
+    std::memcpy(static_cast<char*>(buffer) + copied, slot.data.data() + slot_pos, copy_len);
+    copied += copy_len;
+    readahead_consumer_offset_ += copy_len;
+
+    if (readahead_consumer_offset_ == slot.offset + static_cast<size_t>(slot.size)) {
+      // A short block means EOF; anything still missing cannot be served.
+      const bool at_eof = static_cast<size_t>(slot.size) < READAHEAD_BLOCK_SIZE;
+      readahead_buffer_pool_.push_back(std::move(slot.data));
+      readahead_window_.pop_front();
+      HCTR_CHECK_HINT(!at_eof || copied == buffer_size, "Reading HDFS file failed.");
+      fill_readahead_window();
+    }
+  }
+
+  return copied;
+}
+
 void HadoopFileSystem::copy(const std::string& source_path, const std::string& target_path) {
   HCTR_CHECK_HINT(fs_, "Not connected to HDFS.");
 
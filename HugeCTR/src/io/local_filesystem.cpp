@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2021, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <base/debug/logger.hpp>
+#include <filesystem>
+#include <io/local_filesystem.hpp>
+
+namespace HugeCTR {
+
+LocalFileSystem::~LocalFileSystem() {
+#ifdef ENABLE_IO_URING
+  wait_all();
+  if (ring_ready_) {
+    io_uring_queue_exit(&ring_);
+  }
+#endif
+}
+
+size_t LocalFileSystem::get_file_size(const std::string& path) const {
+  std::error_code ec;
+  const auto size = std::filesystem::file_size(path, ec);
+  if (ec) {
+    HCTR_LOG_S(ERROR, WORLD) << "Cannot stat file: " << path << ' ' << HCTR_LOCATION()
+                             << std::endl;
+    return 0;
+  }
+  return size;
+}
+
+void LocalFileSystem::create_dir(const std::string& path) {
+  std::filesystem::create_directories(path);
+}
+
+void LocalFileSystem::delete_file(const std::string& path, const bool recursive) {
+  if (recursive) {
+    std::filesystem::remove_all(path);
+  } else {
+    std::filesystem::remove(path);
+  }
+}
+
+void LocalFileSystem::fetch(const std::string& source_path, const std::string& target_path) {
+  copy(source_path, target_path);
+}
+
+void LocalFileSystem::upload(const std::string& source_path, const std::string& target_path) {
+  copy(source_path, target_path);
+}
+
+int LocalFileSystem::write(const std::string& path, const void* const data, const size_t data_size,
+                           const bool overwrite) {
+  const int flags = O_WRONLY | O_CREAT | (overwrite ? O_TRUNC : O_APPEND);
+  const int fd = open(path.c_str(), flags, 0644);
+  if (fd == -1) {
+    HCTR_LOG_S(ERROR, WORLD) << "Cannot open file for write: " << path << ' ' << HCTR_LOCATION()
+                             << std::endl;
+    return -1;
+  }
+  size_t num_written = 0;
+  while (num_written < data_size) {
+    const ssize_t ret =
+        ::write(fd, static_cast<const char*>(data) + num_written, data_size - num_written);
+    if (ret <= 0) {
+      break;
+    }
+    num_written += ret;
+  }
+  close(fd);
+  return static_cast<int>(num_written);
+}
+
+int LocalFileSystem::read(const std::string& path, void* const buffer, const size_t buffer_size,
+                          const size_t offset) {
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd == -1) {
+    HCTR_LOG_S(ERROR, WORLD) << "Cannot open file for read: " << path << ' ' << HCTR_LOCATION()
+                             << std::endl;
+    return -1;
+  }
+  size_t num_read = 0;
+  while (num_read < buffer_size) {
+    const ssize_t ret = pread(fd, static_cast<char*>(buffer) + num_read, buffer_size - num_read,
+                              offset + num_read);
+    if (ret <= 0) {
+      break;
+    }
+    num_read += ret;
+  }
+  close(fd);
+  return static_cast<int>(num_read);
+}
+
+void LocalFileSystem::copy(const std::string& source_file, const std::string& target_file) {
+  std::error_code ec;
+  std::filesystem::copy_file(source_file, target_file,
+                             std::filesystem::copy_options::overwrite_existing, ec);
+  if (ec) {
+    HCTR_OWN_THROW(Error_t::WrongInput, "Cannot copy " + source_file + " to " + target_file);
+  }
+}
+
+int LocalFileSystem::batch_fetch(const std::string& source_dir, const std::string& target_dir) {
+  create_dir(target_dir);
+  int num_files = 0;
+  for (const auto& entry : std::filesystem::directory_iterator(source_dir)) {
+    if (entry.is_regular_file()) {
+      copy(entry.path().string(), target_dir + "/" + entry.path().filename().string());
+      num_files++;
+    }
+  }
+  return num_files;
+}
+
+int LocalFileSystem::batch_upload(const std::string& source_dir, const std::string& target_dir) {
+  return batch_fetch(source_dir, target_dir);
+}
+
+#ifdef ENABLE_IO_URING
+
+void LocalFileSystem::read_async(const std::string& path, void* const buffer,
+                                 const size_t buffer_size, const size_t offset,
+                                 ReadCallback on_complete) {
+  if (!ring_ready_) {
+    if (io_uring_queue_init(RING_DEPTH, &ring_, 0) < 0) {
+      HCTR_LOG(WARNING, ROOT, "io_uring unavailable, falling back to synchronous reads\n");
+      FileSystem::read_async(path, buffer, buffer_size, offset, std::move(on_complete));
+      return;
+    }
+    ring_ready_ = true;
+  }
+
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd == -1) {
+    HCTR_LOG_S(ERROR, WORLD) << "Cannot open file for read: " << path << ' ' << HCTR_LOCATION()
+                             << std::endl;
+    on_complete(-1);
+    return;
+  }
+
+  while (num_inflight_ >= RING_DEPTH) {
+    reap_one_();
+  }
+
+  io_uring_sqe* const sqe = io_uring_get_sqe(&ring_);
+  HCTR_CHECK_HINT(sqe != nullptr, "io_uring submission queue unexpectedly full");
+  auto* const pending = new PendingRead{fd, std::move(on_complete)};
+  io_uring_prep_read(sqe, fd, buffer, buffer_size, offset);
+  io_uring_sqe_set_data(sqe, pending);
+  io_uring_submit(&ring_);
+  num_inflight_++;
+}
+
+void LocalFileSystem::wait_all() {
+  while (num_inflight_ > 0) {
+    reap_one_();
+  }
+}
+
+void LocalFileSystem::reap_one_() {
+  io_uring_cqe* cqe;
+  const int ret = io_uring_wait_cqe(&ring_, &cqe);
+  HCTR_CHECK_HINT(ret == 0, "io_uring_wait_cqe failed with %d", ret);
+  auto* const pending = static_cast<PendingRead*>(io_uring_cqe_get_data(cqe));
+  const int bytes_read = cqe->res;
+  io_uring_cqe_seen(&ring_, cqe);
+  num_inflight_--;
+  close(pending->fd);
+  pending->on_complete(bytes_read);
+  delete pending;
+}
+
+#endif
+
+}  // namespace HugeCTR
@@ -15,6 +15,7 @@
  */
 
 #include <algorithm>
+#include <cstdlib>
 #include <functional>
 #include <layers/batch_norm_layer.hpp>
 #include <string>
@@ -30,8 +31,140 @@ namespace {
 
 template <typename T>
 using ToStringType = typename std::conditional<std::is_same<T, __half>::value, float, T>::type;
+
+__device__ __forceinline__ float to_float(float val) { return val; }
+__device__ __forceinline__ float to_float(__half val) { return __half2float(val); }
+
+/**
+ * Per-feature partial sums for SyncBN. Each block owns one feature column and reduces two
+ * moments over the local batch; the two rows of `stats` are laid out contiguously so a single
+ * all-reduce exchanges both.
+ */
+template <typename T>
+__global__ void bn_local_moments_kernel(const T* in, int batch_size, int num_feature,
+                                        float* stats) {
+  __shared__ float s_sum[2];
+  const int feature = blockIdx.x;
+  float sum = 0.f, sum_sq = 0.f;
+  for (int row = threadIdx.x; row < batch_size; row += blockDim.x) {
+    const float val = to_float(in[row * num_feature + feature]);
+    sum += val;
+    sum_sq += val * val;
+  }
+  for (int offset = warpSize / 2; offset > 0; offset >>= 1) {
+    sum += __shfl_down_sync(0xffffffff, sum, offset);
+    sum_sq += __shfl_down_sync(0xffffffff, sum_sq, offset);
+  }
+  if (threadIdx.x == 0) {
+    s_sum[0] = s_sum[1] = 0.f;
+  }
+  __syncthreads();
+  if ((threadIdx.x & (warpSize - 1)) == 0) {
+    atomicAdd(&s_sum[0], sum);
+    atomicAdd(&s_sum[1], sum_sq);
+  }
+  __syncthreads();
+  if (threadIdx.x == 0) {
+    stats[feature] = s_sum[0];
+    stats[num_feature + feature] = s_sum[1];
+  }
 }
 
+/**
+ * Turns the globally reduced sums into mean / inverse stddev and folds them into the running
+ * statistics the same way cuDNN does with `factor`.
+ */
+__global__ void bn_sync_finalize_kernel(int num_feature, float inv_count, float factor, float eps,
+                                        const float* stats, float* save_mean, float* save_inv_var,
+                                        float* running_mean, float* running_var) {
+  const int feature = blockIdx.x * blockDim.x + threadIdx.x;
+  if (feature < num_feature) {
+    const float mean = stats[feature] * inv_count;
+    float var = stats[num_feature + feature] * inv_count - mean * mean;
+    var = (var > 0.f) ? var : 0.f;
+    save_mean[feature] = mean;
+    save_inv_var[feature] = rsqrtf(var + eps);
+    running_mean[feature] = (1.f - factor) * running_mean[feature] + factor * mean;
+    running_var[feature] = (1.f - factor) * running_var[feature] + factor * var;
+  }
+}
+
+template <typename T>
+__global__ void bn_fwd_apply_kernel(const T* in, T* out, int len, int num_feature,
+                                    const float* gamma, const float* beta, const float* save_mean,
+                                    const float* save_inv_var) {
+  for (int idx = blockIdx.x * blockDim.x + threadIdx.x; idx < len; idx += blockDim.x * gridDim.x) {
+    const int feature = idx % num_feature;
+    const float x_hat = (to_float(in[idx]) - save_mean[feature]) * save_inv_var[feature];
+    out[idx] = T(gamma[feature] * x_hat + beta[feature]);
+  }
+}
+
+/**
+ * Per-feature partial sums of dy and dy * x_hat, packed like bn_local_moments_kernel. After the
+ * all-reduce these are both the dbeta / dgamma sums and the correction terms for dx.
+ */
+template <typename T>
+__global__ void bn_bwd_local_terms_kernel(const T* in, const T* dy, int batch_size,
+                                          int num_feature, const float* save_mean,
+                                          const float* save_inv_var, float* stats) {
+  __shared__ float s_sum[2];
+  const int feature = blockIdx.x;
+  float sum_dy = 0.f, sum_dy_x_hat = 0.f;
+  for (int row = threadIdx.x; row < batch_size; row += blockDim.x) {
+    const int idx = row * num_feature + feature;
+    const float dy_val = to_float(dy[idx]);
+    const float x_hat = (to_float(in[idx]) - save_mean[feature]) * save_inv_var[feature];
+    sum_dy += dy_val;
+    sum_dy_x_hat += dy_val * x_hat;
+  }
+  for (int offset = warpSize / 2; offset > 0; offset >>= 1) {
+    sum_dy += __shfl_down_sync(0xffffffff, sum_dy, offset);
+    sum_dy_x_hat += __shfl_down_sync(0xffffffff, sum_dy_x_hat, offset);
+  }
+  if (threadIdx.x == 0) {
+    s_sum[0] = s_sum[1] = 0.f;
+  }
+  __syncthreads();
+  if ((threadIdx.x & (warpSize - 1)) == 0) {
+    atomicAdd(&s_sum[0], sum_dy);
+    atomicAdd(&s_sum[1], sum_dy_x_hat);
+  }
+  __syncthreads();
+  if (threadIdx.x == 0) {
+    stats[feature] = s_sum[0];
+    stats[num_feature + feature] = s_sum[1];
+  }
+}
+
+/**
+ * dgamma / dbeta from the reduced terms. The dense wgrad buffer is all-reduced again by the
+ * trainer, so the globally reduced sums are pre-divided by the GPU count to come out right.
+ */
+__global__ void bn_bwd_dgamma_kernel(int num_feature, const float* stats, float inv_num_gpus,
+                                     float* gamma_grad, float* beta_grad) {
+  const int feature = blockIdx.x * blockDim.x + threadIdx.x;
+  if (feature < num_feature) {
+    beta_grad[feature] = stats[feature] * inv_num_gpus;
+    gamma_grad[feature] = stats[num_feature + feature] * inv_num_gpus;
+  }
+}
+
+template <typename T>
+__global__ void bn_bwd_dx_kernel(const T* in, const T* dy, T* dx, int len, int num_feature,
+                                 const float* gamma, const float* save_mean,
+                                 const float* save_inv_var, const float* stats, float inv_count) {
+  for (int idx = blockIdx.x * blockDim.x + threadIdx.x; idx < len; idx += blockDim.x * gridDim.x) {
+    const int feature = idx % num_feature;
+    const float x_hat = (to_float(in[idx]) - save_mean[feature]) * save_inv_var[feature];
+    const float dy_val = to_float(dy[idx]) - stats[feature] * inv_count -
+                         x_hat * stats[num_feature + feature] * inv_count;
+    dx[idx] = T(gamma[feature] * save_inv_var[feature] * dy_val);
+  }
+}
+
+}  // namespace
+
 template <typename T>
 BatchNormLayer<T>::BatchNormLayer(const std::shared_ptr<BufferBlock2<float>>& weight_buff,
                                   const std::shared_ptr<BufferBlock2<float>>& wgrad_buff,
@@ -42,7 +175,8 @@ BatchNormLayer<T>::BatchNormLayer(const std::shared_ptr<BufferBlock2<float>>& we
                                   std::vector<Initializer_t> initializer_types)
     : Layer(gpu_resource, initializer_types),
       params_(params),
-      mode_(CUDNN_BATCHNORM_PER_ACTIVATION) {
+      mode_(CUDNN_BATCHNORM_PER_ACTIVATION),
+      sync_bn_requested_(std::getenv("HCTR_SYNC_BN") != nullptr) {
   CudaDeviceContext context(get_device_id());
   const auto& in_tensor_dim = in_tensor.get_dimensions();
   const auto& out_tensor_dim = out_tensor.get_dimensions();
@@ -92,6 +226,11 @@ BatchNormLayer<T>::BatchNormLayer(const std::shared_ptr<BufferBlock2<float>>& we
   // save running mean & var (cache)
   blob_buff->reserve(gamma_dim, &result_save_mean_);
   blob_buff->reserve(gamma_dim, &result_save_inv_var_);
+
+  // packed statistics exchange buffer for SyncBN (two moments / reduction terms per feature)
+  if (sync_bn_requested_) {
+    blob_buff->reserve({2, num_feature}, &sync_stats_);
+  }
 }
 
 template <typename T>
@@ -117,6 +256,19 @@ void BatchNormLayer<T>::initialize() {
   internal_host_buf->reserve({num_feature}, &h_result_running_var_);
 
   internal_host_buf->allocate();
+
+  if (sync_bn_requested_) {
+    int num_global_gpus = 1;
+    HCTR_LIB_THROW(ncclCommCount(get_gpu().get_nccl(), &num_global_gpus));
+    num_global_gpus_ = num_global_gpus;
+    // With a single GPU the local statistics already are the global ones; fall back to the
+    // fused cuDNN path in that case.
+    sync_bn_ = (num_global_gpus_ > 1);
+    if (sync_bn_) {
+      HCTR_LOG_S(INFO, ROOT) << "SyncBN enabled: BatchNorm statistics are all-reduced across "
+                             << num_global_gpus_ << " GPUs (HCTR_SYNC_BN)" << std::endl;
+    }
+  }
 }
 
 template <typename T>
@@ -137,7 +289,29 @@ void BatchNormLayer<T>::fprop(bool is_train) {
   float* result_save_mean = result_save_mean_.get_ptr();
   float* result_save_inv_var = result_save_inv_var_.get_ptr();
 
-  if (is_train) {
+  if (is_train && sync_bn_) {
+    // SyncBN: compute both moments locally, exchange them with one packed all-reduce, then
+    // normalize with the global statistics. cuDNN's fused training forward cannot consume
+    // externally reduced statistics, so this path applies the normalization itself.
+    const int batch_size = in_tensor.get_dimensions()[0];
+    const int num_feature = in_tensor.get_dimensions()[1];
+    const int len = batch_size * num_feature;
+    float* stats = sync_stats_.get_ptr();
+    cudaStream_t stream = get_gpu().get_stream();
+
+    bn_local_moments_kernel<<<num_feature, 256, 0, stream>>>(in, batch_size, num_feature, stats);
+    HCTR_LIB_THROW(ncclAllReduce(stats, stats, 2 * num_feature, ncclFloat32, ncclSum,
+                                 get_gpu().get_nccl(), stream));
+
+    const float inv_count = 1.f / (static_cast<float>(batch_size) * num_global_gpus_);
+    constexpr int block_dim = 256;
+    bn_sync_finalize_kernel<<<(num_feature + block_dim - 1) / block_dim, block_dim, 0, stream>>>(
+        num_feature, inv_count, static_cast<float>(params_.factor),
+        static_cast<float>(params_.eps), stats, result_save_mean, result_save_inv_var,
+        result_running_mean, result_running_var);
+    bn_fwd_apply_kernel<<<(len + block_dim - 1) / block_dim, block_dim, 0, stream>>>(
+        in, out, len, num_feature, gamma, beta, result_save_mean, result_save_inv_var);
+  } else if (is_train) {
     HCTR_LIB_THROW(cudnnBatchNormalizationForwardTraining(
         get_gpu().get_cudnn_handle(), mode_, &one, &zero, in_out_desc_, in, in_out_desc_, out,
         gamma_beta_desc_, gamma, beta, params_.factor, result_running_mean, result_running_var,
@@ -168,6 +342,32 @@ void BatchNormLayer<T>::bprop() {
   float* result_save_mean = result_save_mean_.get_ptr();
   float* result_save_inv_var = result_save_inv_var_.get_ptr();
 
+  if (sync_bn_) {
+    // The forward pass normalized with global statistics, so the two backward reduction terms
+    // (sum dy, sum dy * x_hat) must be global as well. Same scheme as fprop: one packed
+    // all-reduce per layer. Positioned identically in the layer walk on every GPU, these calls
+    // match up without further ordering constraints in Network::train.
+    const int batch_size = in_tensor.get_dimensions()[0];
+    const int num_feature = in_tensor.get_dimensions()[1];
+    const int len = batch_size * num_feature;
+    float* stats = sync_stats_.get_ptr();
+    cudaStream_t stream = get_gpu().get_stream();
+
+    bn_bwd_local_terms_kernel<<<num_feature, 256, 0, stream>>>(
+        in, out, batch_size, num_feature, result_save_mean, result_save_inv_var, stats);
+    HCTR_LIB_THROW(ncclAllReduce(stats, stats, 2 * num_feature, ncclFloat32, ncclSum,
+                                 get_gpu().get_nccl(), stream));
+
+    const float inv_count = 1.f / (static_cast<float>(batch_size) * num_global_gpus_);
+    constexpr int block_dim = 256;
+    bn_bwd_dgamma_kernel<<<(num_feature + block_dim - 1) / block_dim, block_dim, 0, stream>>>(
+        num_feature, stats, 1.f / num_global_gpus_, gamma_grad, beta_grad);
+    bn_bwd_dx_kernel<<<(len + block_dim - 1) / block_dim, block_dim, 0, stream>>>(
+        in, out, in, len, num_feature, gamma, result_save_mean, result_save_inv_var, stats,
+        inv_count);
+    return;
+  }
+
   HCTR_LIB_THROW(cudnnBatchNormalizationBackward(
       get_gpu().get_cudnn_handle(), mode_, &one, &zero, &one, &zero, in_out_desc_, in, in_out_desc_,
       out, in_out_desc_, in, gamma_beta_desc_, gamma, gamma_grad, beta_grad, params_.eps,
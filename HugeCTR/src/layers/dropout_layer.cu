@@ -14,11 +14,15 @@
  * limitations under the License.
  */
 
+#include <curand_kernel.h>
+
 #include <HugeCTR/include/utils.hpp>
 #include <algorithm>
 #include <cstdio>
+#include <cstdlib>
 #include <ctime>
 #include <functional>
+#include <random>
 #include <layers/dropout_layer.hpp>
 #include <prims/linalg/binary_op.cuh>
 #include <utils.cuh>
@@ -30,6 +34,39 @@
 
 namespace HugeCTR {
 
+namespace {
+
+constexpr int DROPOUT_BLOCK_DIM = 256;
+constexpr int DROPOUT_MAX_GRID_DIM = 1024;
+
+// Applies the dropout mask generated from a Philox counter. fprop and bprop launch this with
+// the same (seed, offset) and identical grids, so every thread regenerates exactly the random
+// numbers it drew in forward and no mask ever touches global memory.
+template <typename T>
+__global__ void dropout_philox_kernel(T* out, const T* __restrict__ in, int size, float rate,
+                                      float scale, uint64_t seed, uint64_t offset) {
+  int tid = blockIdx.x * blockDim.x + threadIdx.x;
+  int stride = blockDim.x * gridDim.x;
+
+  curandStatePhilox4_32_10_t state;
+  curand_init(seed, tid, offset, &state);
+
+  for (int i = tid; 4 * i < size; i += stride) {
+    float4 rand = curand_uniform4(&state);
+    float r[4] = {rand.x, rand.y, rand.z, rand.w};
+#pragma unroll
+    for (int k = 0; k < 4; ++k) {
+      int idx = 4 * i + k;
+      if (idx < size) {
+        float keep = (r[k] > rate) ? scale : 0.f;
+        out[idx] = static_cast<T>(static_cast<float>(in[idx]) * keep);
+      }
+    }
+  }
+}
+
+}  // namespace
+
 template <typename T>
 DropoutLayer<T>::DropoutLayer(const Tensor2<T>& in_tensor, const Tensor2<T>& out_tensor,
                               const std::shared_ptr<GeneralBuffer2<CudaAllocator>> blobs_buff,
@@ -45,6 +82,16 @@ DropoutLayer<T>::DropoutLayer(const Tensor2<T>& in_tensor, const Tensor2<T>& out
 
   CudaDeviceContext context(get_device_id());
 
+  // With HCTR_DROPOUT_PHILOX set, the mask is regenerated from a Philox counter in bprop
+  // instead of being kept in the cudnn reserve space, so neither the reserve space nor the
+  // cudnn RNG state is allocated and the mask never round-trips through global memory.
+  use_philox_ = std::getenv("HCTR_DROPOUT_PHILOX") != nullptr;
+  if (use_philox_) {
+    std::random_device rd;
+    philox_seed_ = (static_cast<uint64_t>(rd()) << 32) | rd();
+    return;
+  }
+
   size_t num_feature = in_tensor_dim[1];
   int batch_size = in_tensor_dim[0];
   cudnnDataType_t data_type = CudnnDataType<T>::getType();
@@ -74,6 +121,9 @@ DropoutLayer<T>::DropoutLayer(const Tensor2<T>& in_tensor, const Tensor2<T>& out
 
 template <typename T>
 DropoutLayer<T>::~DropoutLayer() {
+  if (use_philox_) {
+    return;
+  }
   try {
     HCTR_LIB_THROW(cudnnDestroyDropoutDescriptor(dropout_descriptor_));
     HCTR_LIB_THROW(cudaFree(cudnn_status_));
@@ -88,9 +138,23 @@ void DropoutLayer<T>::fprop(bool is_train) {
   CudaDeviceContext context(get_device_id());
 
   if (is_train) {
-    HCTR_LIB_THROW(cudnnDropoutForward(
-        get_gpu().get_cudnn_handle(), dropout_descriptor_, in_out_desc_, in_tensors_[0].get_ptr(),
-        in_out_desc_, out_tensors_[0].get_ptr(), mask_.get_ptr(), reserveSpaceSizeInBytes_));
+    if (use_philox_) {
+      const int size = in_tensors_[0].get_num_elements();
+      const int grid_dim =
+          std::min((size / 4) / DROPOUT_BLOCK_DIM + 1, DROPOUT_MAX_GRID_DIM);
+      philox_fprop_offset_ = philox_offset_;
+      // Each thread draws ceil(size / (4 * stride)) uniform4's; skip past them for the next
+      // iteration so masks do not repeat.
+      const int stride = DROPOUT_BLOCK_DIM * grid_dim;
+      philox_offset_ += (size / 4 + stride) / stride;
+      dropout_philox_kernel<<<grid_dim, DROPOUT_BLOCK_DIM, 0, get_gpu().get_stream()>>>(
+          out_tensors_[0].get_ptr(), in_tensors_[0].get_ptr(), size, rate_, scale_, philox_seed_,
+          philox_fprop_offset_);
+    } else {
+      HCTR_LIB_THROW(cudnnDropoutForward(
+          get_gpu().get_cudnn_handle(), dropout_descriptor_, in_out_desc_, in_tensors_[0].get_ptr(),
+          in_out_desc_, out_tensors_[0].get_ptr(), mask_.get_ptr(), reserveSpaceSizeInBytes_));
+    }
   } else {
     HCTR_LIB_THROW(cudaMemcpyAsync(out_tensors_[0].get_ptr(), in_tensors_[0].get_ptr(),
                                    in_tensors_[0].get_size_in_bytes(), cudaMemcpyDeviceToDevice,
@@ -106,9 +170,17 @@ void DropoutLayer<T>::fprop(bool is_train) {
 template <typename T>
 void DropoutLayer<T>::bprop() {
   CudaDeviceContext context(get_device_id());
-  HCTR_LIB_THROW(cudnnDropoutBackward(
-      get_gpu().get_cudnn_handle(), dropout_descriptor_, in_out_desc_, out_tensors_[0].get_ptr(),
-      in_out_desc_, in_tensors_[0].get_ptr(), mask_.get_ptr(), reserveSpaceSizeInBytes_));
+  if (use_philox_) {
+    const int size = in_tensors_[0].get_num_elements();
+    const int grid_dim = std::min((size / 4) / DROPOUT_BLOCK_DIM + 1, DROPOUT_MAX_GRID_DIM);
+    dropout_philox_kernel<<<grid_dim, DROPOUT_BLOCK_DIM, 0, get_gpu().get_stream()>>>(
+        in_tensors_[0].get_ptr(), out_tensors_[0].get_ptr(), size, rate_, scale_, philox_seed_,
+        philox_fprop_offset_);
+  } else {
+    HCTR_LIB_THROW(cudnnDropoutBackward(
+        get_gpu().get_cudnn_handle(), dropout_descriptor_, in_out_desc_, out_tensors_[0].get_ptr(),
+        in_out_desc_, in_tensors_[0].get_ptr(), mask_.get_ptr(), reserveSpaceSizeInBytes_));
+  }
 
 #ifndef NDEBUG
   cudaDeviceSynchronize();
@@ -50,20 +50,46 @@ __global__ void fm_order2_kernel(const __half* in, __half* out, int batch_size,
   int bid = blockIdx.x;
 
   if (tid < emb_vec_size && bid < batch_size) {
-    __half emb_sum = __float2half(0.0f);
-    __half emb_sum_square = __float2half(0.0f);
-    __half emb_square_sum = __float2half(0.0f);
+    float emb_sum = 0.0f;
+    float emb_square_sum = 0.0f;
     int offset = bid * slot_num * emb_vec_size + tid;
 
     for (int i = 0; i < slot_num; i++) {
       int index = offset + i * emb_vec_size;
-      __half temp = in[index];
+      float temp = __half2float(in[index]);
       emb_sum += temp;
       emb_square_sum += temp * temp;
     }
-    emb_sum_square = emb_sum * emb_sum;
+    float emb_sum_square = emb_sum * emb_sum;
 
-    out[bid * emb_vec_size + tid] = __float2half(0.5f) * (emb_sum_square - emb_square_sum);
+    out[bid * emb_vec_size + tid] = __float2half(0.5f * (emb_sum_square - emb_square_sum));
+  }
+}
+
+// half2 variant for even vector sizes: each thread owns two adjacent columns, so every load
+// and store moves a full __half2 while the sums and squared sums accumulate in FP32
+// registers. The slot loop is the only pass over the input.
+__global__ void fm_order2_kernel_half2(const __half2* in, __half2* out, int batch_size,
+                                       int slot_num, int emb_vec_size_h2) {
+  int tid = threadIdx.x;
+  int bid = blockIdx.x;
+
+  if (tid < emb_vec_size_h2 && bid < batch_size) {
+    float2 emb_sum = {0.0f, 0.0f};
+    float2 emb_square_sum = {0.0f, 0.0f};
+    int offset = bid * slot_num * emb_vec_size_h2 + tid;
+
+    for (int i = 0; i < slot_num; i++) {
+      float2 temp = __half22float2(in[offset + i * emb_vec_size_h2]);
+      emb_sum.x += temp.x;
+      emb_sum.y += temp.y;
+      emb_square_sum.x += temp.x * temp.x;
+      emb_square_sum.y += temp.y * temp.y;
+    }
+    float2 result = {0.5f * (emb_sum.x * emb_sum.x - emb_square_sum.x),
+                     0.5f * (emb_sum.y * emb_sum.y - emb_square_sum.y)};
+
+    out[bid * emb_vec_size_h2 + tid] = __float22half2_rn(result);
   }
 }
 
@@ -94,21 +120,85 @@ __global__ void fm_order2_dgrad_kernel(const __half* in, const __half* top_grad,
   int bid = blockIdx.x;
 
   if (tid < emb_vec_size && bid < batch_size) {
-    __half emb_sum = __float2half(0.0f);
+    float emb_sum = 0.0f;
     int offset = bid * slot_num * emb_vec_size + tid;
 
     for (int i = 0; i < slot_num; i++) {
       int index = offset + i * emb_vec_size;
-      emb_sum += in[index];
+      emb_sum += __half2float(in[index]);
     }
-    __half tgrad = top_grad[bid * emb_vec_size + tid];
+    float tgrad = __half2float(top_grad[bid * emb_vec_size + tid]);
     for (int i = 0; i < slot_num; i++) {
       int index = offset + i * emb_vec_size;
-      dgrad[index] = tgrad * (emb_sum - in[index]);
+      dgrad[index] = __float2half(tgrad * (emb_sum - __half2float(in[index])));
     }
   }
 }
 
+__global__ void fm_order2_dgrad_kernel_half2(const __half2* in, const __half2* top_grad,
+                                             __half2* dgrad, int batch_size, int slot_num,
+                                             int emb_vec_size_h2) {
+  int tid = threadIdx.x;
+  int bid = blockIdx.x;
+
+  if (tid < emb_vec_size_h2 && bid < batch_size) {
+    float2 emb_sum = {0.0f, 0.0f};
+    int offset = bid * slot_num * emb_vec_size_h2 + tid;
+
+    for (int i = 0; i < slot_num; i++) {
+      float2 temp = __half22float2(in[offset + i * emb_vec_size_h2]);
+      emb_sum.x += temp.x;
+      emb_sum.y += temp.y;
+    }
+    float2 tgrad = __half22float2(top_grad[bid * emb_vec_size_h2 + tid]);
+    for (int i = 0; i < slot_num; i++) {
+      int index = offset + i * emb_vec_size_h2;
+      float2 temp = __half22float2(in[index]);
+      float2 result = {tgrad.x * (emb_sum.x - temp.x), tgrad.y * (emb_sum.y - temp.y)};
+      dgrad[index] = __float22half2_rn(result);
+    }
+  }
+}
+
+// Launch helpers so the templated fprop/bprop pick the half2 kernels whenever the vector
+// size allows the vectorized layout.
+void launch_fm_order2(const float* in, float* out, int batch_size, int slot_num, int emb_vec_size,
+                      cudaStream_t stream) {
+  fm_order2_kernel<<<batch_size, emb_vec_size, 0, stream>>>(in, out, batch_size, slot_num,
+                                                            emb_vec_size);
+}
+
+void launch_fm_order2(const __half* in, __half* out, int batch_size, int slot_num,
+                      int emb_vec_size, cudaStream_t stream) {
+  if (emb_vec_size % 2 == 0) {
+    fm_order2_kernel_half2<<<batch_size, emb_vec_size / 2, 0, stream>>>(
+        reinterpret_cast<const __half2*>(in), reinterpret_cast<__half2*>(out), batch_size,
+        slot_num, emb_vec_size / 2);
+  } else {
+    fm_order2_kernel<<<batch_size, emb_vec_size, 0, stream>>>(in, out, batch_size, slot_num,
+                                                              emb_vec_size);
+  }
+}
+
+void launch_fm_order2_dgrad(const float* in, const float* top_grad, float* dgrad, int batch_size,
+                            int slot_num, int emb_vec_size, cudaStream_t stream) {
+  fm_order2_dgrad_kernel<<<batch_size, emb_vec_size, 0, stream>>>(in, top_grad, dgrad, batch_size,
+                                                                  slot_num, emb_vec_size);
+}
+
+void launch_fm_order2_dgrad(const __half* in, const __half* top_grad, __half* dgrad,
+                            int batch_size, int slot_num, int emb_vec_size, cudaStream_t stream) {
+  if (emb_vec_size % 2 == 0) {
+    fm_order2_dgrad_kernel_half2<<<batch_size, emb_vec_size / 2, 0, stream>>>(
+        reinterpret_cast<const __half2*>(in), reinterpret_cast<const __half2*>(top_grad),
+        reinterpret_cast<__half2*>(dgrad), batch_size, slot_num, emb_vec_size / 2);
+  } else {
+    fm_order2_dgrad_kernel<<<batch_size, emb_vec_size, 0, stream>>>(in, top_grad, dgrad,
+                                                                    batch_size, slot_num,
+                                                                    emb_vec_size);
+  }
+}
+
 }  // end of namespace
 
 template <typename T>
@@ -149,10 +239,7 @@ void FmOrder2Layer<T>::fprop(bool is_train) {
   const T* in = in_tensors_[0].get_ptr();
   T* out = out_tensors_[0].get_ptr();
 
-  dim3 blockSize(embedding_vec_size_, 1, 1);
-  dim3 grdiSize(batch_size_, 1, 1);
-  fm_order2_kernel<<<grdiSize, blockSize, 0, get_gpu().get_stream()>>>(
-      in, out, batch_size_, slot_num_, embedding_vec_size_);
+  launch_fm_order2(in, out, batch_size_, slot_num_, embedding_vec_size_, get_gpu().get_stream());
 }
 
 template <typename T>
@@ -162,13 +249,10 @@ void FmOrder2Layer<T>::bprop() {
   T* in = in_tensors_[0].get_ptr();
   const T* out = out_tensors_[0].get_ptr();
 
-  dim3 blockSize(embedding_vec_size_, 1, 1);
-  dim3 gridSize(batch_size_, 1, 1);
-  fm_order2_dgrad_kernel<<<gridSize, blockSize, 0, get_gpu().get_stream()>>>(in,
-                                                                             out,  // top_grad
-                                                                             in,   // dgrad
-                                                                             batch_size_, slot_num_,
-                                                                             embedding_vec_size_);
+  launch_fm_order2_dgrad(in,
+                         out,  // top_grad
+                         in,   // dgrad
+                         batch_size_, slot_num_, embedding_vec_size_, get_gpu().get_stream());
 }
 
 template class FmOrder2Layer<float>;
@@ -15,6 +15,7 @@
  */
 
 #include <cstdio>
+#include <gemm_algo_cache.hpp>
 #include <layers/fused_relu_bias_fully_connected_layer.hpp>
 #include <linalg/reduce.cuh>
 #include <utils.cuh>
@@ -494,149 +495,176 @@ void FusedReluBiasFullyConnectedLayer::search_algorithm() {
   HCTR_LIB_THROW(cudaEventCreate(&start));
   HCTR_LIB_THROW(cudaEventCreate(&stop));
 
-  cublasLtMatmulHeuristicResult_t heuristic_result[max_algo_count] = {0};
-  int algo_count = 0;
-  HCTR_LIB_THROW(cublasLtMatmulAlgoGetHeuristic(
-      get_gpu().get_cublaslt_handle(), cublas_op_desc_, cublas_kernel_desc_, cublas_bottom_desc_,
-      cublas_top_desc_, cublas_top_desc_, cublas_preference_, max_algo_count, heuristic_result,
-      &algo_count));
-
-  if (algo_count == 0) {
-    HCTR_LIB_THROW(CUBLAS_STATUS_NOT_SUPPORTED);
-  }
-
-  // if(get_device_id()==0) HCTR_LOG(INFO, WORLD, "M: %d, N: %d, K: %d\n", m, n, k);
-  for (int algoIdx = 0; algoIdx < algo_count; algoIdx++) {
-    cublasStatus_t status = CUBLAS_STATUS_SUCCESS;
-
-    const float alpha = 1.0f;
-    const float beta = 0.0f;
-    HCTR_LIB_THROW(cudaEventRecord(start, get_gpu().get_stream()));
-    for (size_t i = 0; i < repeat_num && status == CUBLAS_STATUS_SUCCESS; ++i) {
-      status =
-          cublasLtMatmul(get_gpu().get_cublaslt_handle(), cublas_op_desc_, &alpha, kernel,
-                         cublas_kernel_desc_, bottom, cublas_bottom_desc_, &beta, top,
-                         cublas_top_desc_, top, cublas_top_desc_, &heuristic_result[algoIdx].algo,
-                         cublaslt_workspace_, cublaslt_workspace_size_, get_gpu().get_stream());
-    }
-    HCTR_LIB_THROW(cudaEventRecord(stop, get_gpu().get_stream()));
-    HCTR_LIB_THROW(cudaEventSynchronize(stop));
-    HCTR_LIB_THROW(cudaEventElapsedTime(&time, start, stop));
-
-    // Avg Time(ms) for this alorithm for fprop GEMM
-    time = time / repeat_num;
-    // Skip if the algorithm is supported for fprop configuration
-    if (status != CUBLAS_STATUS_SUCCESS) {
-      //      HCTR_LOG(INFO, WORLD, "The algorithms %d is not supported for fprop, skipped.\n",
-      //      testAlgo);
-      continue;
+  // Consult the autotune cache first so the measurement below only runs once per
+  // (shape, arch, datatype, epilogue) and later jobs reuse the tuned algorithm.
+  auto& algo_cache = GemmAlgoCache::get();
+  const int arch = get_gpu().get_cc_major() * 10 + get_gpu().get_cc_minor();
+  auto make_key = [&](GemmAlgoCache::GemmOp op, cublasLtMatmulDesc_t op_desc) {
+    cublasLtEpilogue_t epi = CUBLASLT_EPILOGUE_DEFAULT;
+    size_t size_written = 0;
+    HCTR_LIB_THROW(cublasLtMatmulDescGetAttribute(op_desc, CUBLASLT_MATMUL_DESC_EPILOGUE, &epi,
+                                                  sizeof(epi), &size_written));
+    return GemmAlgoCache::Key{
+        m, n, k, CUDA_R_16F, arch, static_cast<int>(op), static_cast<int>(epi)};
+  };
+
+  const auto fprop_key = make_key(GemmAlgoCache::GemmOp::Fprop, cublas_op_desc_);
+  if (!algo_cache.find(fprop_key, &falgo_k_)) {
+    cublasLtMatmulHeuristicResult_t heuristic_result[max_algo_count] = {0};
+    int algo_count = 0;
+    HCTR_LIB_THROW(cublasLtMatmulAlgoGetHeuristic(
+        get_gpu().get_cublaslt_handle(), cublas_op_desc_, cublas_kernel_desc_, cublas_bottom_desc_,
+        cublas_top_desc_, cublas_top_desc_, cublas_preference_, max_algo_count, heuristic_result,
+        &algo_count));
+
+    if (algo_count == 0) {
+      HCTR_LIB_THROW(CUBLAS_STATUS_NOT_SUPPORTED);
     }
 
-    // if(get_device_id()==0) HCTR_LOG(INFO, WORLD, "Algo: %d, wavesCount: %f, time: %f\n",
-    //           (int)heuristic_result[algoIdx].algo,
-    //           heuristic_result[algoIdx].wavesCount,
-    //           time);
-    // Record the optimal time and algorithm
-    if (time < shortestTime) {
-      shortestTime = time;
-      memcpy(&falgo_k_, &heuristic_result[algoIdx].algo, sizeof(falgo_k_));
-      // if(get_device_id()==0) HCTR_LOG(INFO, WORLD, "Picked algorithm: %d",
-      // heuristic_result[algoIdx].algo);
+    // if(get_device_id()==0) HCTR_LOG(INFO, WORLD, "M: %d, N: %d, K: %d\n", m, n, k);
+    for (int algoIdx = 0; algoIdx < algo_count; algoIdx++) {
+      cublasStatus_t status = CUBLAS_STATUS_SUCCESS;
+
+      const float alpha = 1.0f;
+      const float beta = 0.0f;
+      HCTR_LIB_THROW(cudaEventRecord(start, get_gpu().get_stream()));
+      for (size_t i = 0; i < repeat_num && status == CUBLAS_STATUS_SUCCESS; ++i) {
+        status =
+            cublasLtMatmul(get_gpu().get_cublaslt_handle(), cublas_op_desc_, &alpha, kernel,
+                           cublas_kernel_desc_, bottom, cublas_bottom_desc_, &beta, top,
+                           cublas_top_desc_, top, cublas_top_desc_, &heuristic_result[algoIdx].algo,
+                           cublaslt_workspace_, cublaslt_workspace_size_, get_gpu().get_stream());
+      }
+      HCTR_LIB_THROW(cudaEventRecord(stop, get_gpu().get_stream()));
+      HCTR_LIB_THROW(cudaEventSynchronize(stop));
+      HCTR_LIB_THROW(cudaEventElapsedTime(&time, start, stop));
+
+      // Avg Time(ms) for this alorithm for fprop GEMM
+      time = time / repeat_num;
+      // Skip if the algorithm is supported for fprop configuration
+      if (status != CUBLAS_STATUS_SUCCESS) {
+        //      HCTR_LOG(INFO, WORLD, "The algorithms %d is not supported for fprop, skipped.\n",
+        //      testAlgo);
+        continue;
+      }
+
+      // if(get_device_id()==0) HCTR_LOG(INFO, WORLD, "Algo: %d, wavesCount: %f, time: %f\n",
+      //           (int)heuristic_result[algoIdx].algo,
+      //           heuristic_result[algoIdx].wavesCount,
+      //           time);
+      // Record the optimal time and algorithm
+      if (time < shortestTime) {
+        shortestTime = time;
+        memcpy(&falgo_k_, &heuristic_result[algoIdx].algo, sizeof(falgo_k_));
+        // if(get_device_id()==0) HCTR_LOG(INFO, WORLD, "Picked algorithm: %d",
+        // heuristic_result[algoIdx].algo);
+      }
     }
+    algo_cache.update(fprop_key, falgo_k_);
   }
 
   // dRelu in backward pass
   // Reset shortestTime
   shortestTime = std::numeric_limits<float>::max();
-  cublasLtMatmulHeuristicResult_t heuristic_result_dRelu[max_algo_count] = {0};
-  int algo_count_dRelu = 0;
-  HCTR_LIB_THROW(cublasLtMatmulAlgoGetHeuristic(
-      get_gpu().get_cublaslt_handle(), cublas_op_desc_bprop_, cublas_kernel_desc_,
-      cublas_dRelu_top_desc_, cublas_dRelu_bottom_desc_, cublas_dRelu_bottom_desc_,
-      cublas_preference_dRelu_, max_algo_count, heuristic_result_dRelu, &algo_count_dRelu));
-
-  if (algo_count_dRelu == 0) {
-    HCTR_LIB_THROW(CUBLAS_STATUS_NOT_SUPPORTED);
-  }
-
-  for (int algoIdx = 0; algoIdx < algo_count_dRelu; algoIdx++) {
-    cublasStatus_t status = CUBLAS_STATUS_SUCCESS;
-
-    const float alpha = 1.0f;
-    const float beta = 0.0f;
-    HCTR_LIB_THROW(cudaEventRecord(start, get_gpu().get_stream()));
-    for (size_t i = 0; i < repeat_num && status == CUBLAS_STATUS_SUCCESS; ++i) {
-      status = cublasLtMatmul(get_gpu().get_cublaslt_handle(), cublas_op_desc_bprop_, &alpha,
-                              kernel, cublas_kernel_desc_, top, cublas_dRelu_top_desc_, &beta,
-                              bottom, cublas_dRelu_bottom_desc_, bottom, cublas_dRelu_bottom_desc_,
-                              &heuristic_result_dRelu[algoIdx].algo, cublaslt_workspace_dRelu_,
-                              cublaslt_workspace_size_, get_gpu().get_stream());
+  const auto dgrad_key = make_key(GemmAlgoCache::GemmOp::DGrad, cublas_op_desc_bprop_);
+  if (!algo_cache.find(dgrad_key, &balgo_dRelu_)) {
+    cublasLtMatmulHeuristicResult_t heuristic_result_dRelu[max_algo_count] = {0};
+    int algo_count_dRelu = 0;
+    HCTR_LIB_THROW(cublasLtMatmulAlgoGetHeuristic(
+        get_gpu().get_cublaslt_handle(), cublas_op_desc_bprop_, cublas_kernel_desc_,
+        cublas_dRelu_top_desc_, cublas_dRelu_bottom_desc_, cublas_dRelu_bottom_desc_,
+        cublas_preference_dRelu_, max_algo_count, heuristic_result_dRelu, &algo_count_dRelu));
+
+    if (algo_count_dRelu == 0) {
+      HCTR_LIB_THROW(CUBLAS_STATUS_NOT_SUPPORTED);
     }
-    HCTR_LIB_THROW(cudaEventRecord(stop, get_gpu().get_stream()));
-    HCTR_LIB_THROW(cudaEventSynchronize(stop));
-    HCTR_LIB_THROW(cudaEventElapsedTime(&time, start, stop));
 
-    // Avg Time(ms) for this alorithm for fprop GEMM
-    time = time / repeat_num;
-    // Skip if the algorithm is supported for fprop configuration
-    if (status != CUBLAS_STATUS_SUCCESS) {
-      //      HCTR_LOG(INFO, WORLD, "The algorithms %d is not supported for fprop, skipped.\n",
-      //      testAlgo);
-      continue;
-    }
-    // Record the optimal time and algorithm
-    if (time < shortestTime) {
-      shortestTime = time;
-      memcpy(&balgo_dRelu_, &heuristic_result_dRelu[algoIdx].algo, sizeof(balgo_dRelu_));
+    for (int algoIdx = 0; algoIdx < algo_count_dRelu; algoIdx++) {
+      cublasStatus_t status = CUBLAS_STATUS_SUCCESS;
+
+      const float alpha = 1.0f;
+      const float beta = 0.0f;
+      HCTR_LIB_THROW(cudaEventRecord(start, get_gpu().get_stream()));
+      for (size_t i = 0; i < repeat_num && status == CUBLAS_STATUS_SUCCESS; ++i) {
+        status = cublasLtMatmul(get_gpu().get_cublaslt_handle(), cublas_op_desc_bprop_, &alpha,
+                                kernel, cublas_kernel_desc_, top, cublas_dRelu_top_desc_, &beta,
+                                bottom, cublas_dRelu_bottom_desc_, bottom,
+                                cublas_dRelu_bottom_desc_, &heuristic_result_dRelu[algoIdx].algo,
+                                cublaslt_workspace_dRelu_, cublaslt_workspace_size_,
+                                get_gpu().get_stream());
+      }
+      HCTR_LIB_THROW(cudaEventRecord(stop, get_gpu().get_stream()));
+      HCTR_LIB_THROW(cudaEventSynchronize(stop));
+      HCTR_LIB_THROW(cudaEventElapsedTime(&time, start, stop));
+
+      // Avg Time(ms) for this alorithm for fprop GEMM
+      time = time / repeat_num;
+      // Skip if the algorithm is supported for fprop configuration
+      if (status != CUBLAS_STATUS_SUCCESS) {
+        //      HCTR_LOG(INFO, WORLD, "The algorithms %d is not supported for fprop, skipped.\n",
+        //      testAlgo);
+        continue;
+      }
+      // Record the optimal time and algorithm
+      if (time < shortestTime) {
+        shortestTime = time;
+        memcpy(&balgo_dRelu_, &heuristic_result_dRelu[algoIdx].algo, sizeof(balgo_dRelu_));
+      }
     }
+    algo_cache.update(dgrad_key, balgo_dRelu_);
   }
 
   // wgrad in backward pass
   // Reset shortestTime
   shortestTime = std::numeric_limits<float>::max();
-  cublasLtMatmulHeuristicResult_t heuristic_result_wgrad[max_algo_count] = {0};
-  int algo_count_wgrad = 0;
-  HCTR_LIB_THROW(cublasLtMatmulAlgoGetHeuristic(
-      get_gpu().get_cublaslt_handle(), cublas_op_desc_wgrad_, cublas_dRelu_top_desc_,
-      cublas_dRelu_bottom_desc_, cublas_kernel_desc_, cublas_kernel_desc_, cublas_preference_wgrad_,
-      max_algo_count, heuristic_result_wgrad, &algo_count_wgrad));
-
-  if (algo_count_wgrad == 0) {
-    HCTR_LIB_THROW(CUBLAS_STATUS_NOT_SUPPORTED);
-  }
-
-  for (int algoIdx = 0; algoIdx < algo_count_wgrad; algoIdx++) {
-    cublasStatus_t status = CUBLAS_STATUS_SUCCESS;
-
-    const float alpha = 1.0f;
-    const float beta = 1.0f;
-    HCTR_LIB_THROW(cudaEventRecord(start, get_gpu().get_stream()));
-    for (size_t i = 0; i < repeat_num && status == CUBLAS_STATUS_SUCCESS; ++i) {
-      status = cublasLtMatmul(get_gpu().get_cublaslt_handle(), cublas_op_desc_wgrad_, &alpha, top,
-                              cublas_dRelu_top_desc_, bottom, cublas_dRelu_bottom_desc_, &beta,
-                              kernel, cublas_kernel_desc_, kernel, cublas_kernel_desc_,
-                              &heuristic_result_wgrad[algoIdx].algo, cublaslt_workspace_wgrad_,
-                              cublaslt_workspace_size_, get_gpu().get_stream());
+  const auto wgrad_key = make_key(GemmAlgoCache::GemmOp::WGrad, cublas_op_desc_wgrad_);
+  if (!algo_cache.find(wgrad_key, &balgo_wgrad_)) {
+    cublasLtMatmulHeuristicResult_t heuristic_result_wgrad[max_algo_count] = {0};
+    int algo_count_wgrad = 0;
+    HCTR_LIB_THROW(cublasLtMatmulAlgoGetHeuristic(
+        get_gpu().get_cublaslt_handle(), cublas_op_desc_wgrad_, cublas_dRelu_top_desc_,
+        cublas_dRelu_bottom_desc_, cublas_kernel_desc_, cublas_kernel_desc_,
+        cublas_preference_wgrad_, max_algo_count, heuristic_result_wgrad, &algo_count_wgrad));
+
+    if (algo_count_wgrad == 0) {
+      HCTR_LIB_THROW(CUBLAS_STATUS_NOT_SUPPORTED);
     }
-    HCTR_LIB_THROW(cudaEventRecord(stop, get_gpu().get_stream()));
-    HCTR_LIB_THROW(cudaEventSynchronize(stop));
-    HCTR_LIB_THROW(cudaEventElapsedTime(&time, start, stop));
 
-    // Avg Time(ms) for this alorithm for fprop GEMM
-    time = time / repeat_num;
-    // HCTR_LOG(INFO, WORLD, "algoIdx: %d, time: %f, shortest time: %f\n", algoIdx, time,
-    // shortestTime); Skip if the algorithm is supported for fprop configuration
-    if (status != CUBLAS_STATUS_SUCCESS) {
-      //      HCTR_LOG(INFO, WORLD, "The algorithms %d is not supported for fprop, skipped.\n",
-      //      testAlgo);
-      continue;
-    }
-    // Record the optimal time and algorithm
-    if (time < shortestTime) {
-      shortestTime = time;
-      // HCTR_LOG(INFO, WORLD, "wgrad cublasMatmul algoIdx: %d, time: %f\n", algoIdx, shortestTime);
-      memcpy(&balgo_wgrad_, &heuristic_result_wgrad[algoIdx].algo, sizeof(balgo_wgrad_));
+    for (int algoIdx = 0; algoIdx < algo_count_wgrad; algoIdx++) {
+      cublasStatus_t status = CUBLAS_STATUS_SUCCESS;
+
+      const float alpha = 1.0f;
+      const float beta = 1.0f;
+      HCTR_LIB_THROW(cudaEventRecord(start, get_gpu().get_stream()));
+      for (size_t i = 0; i < repeat_num && status == CUBLAS_STATUS_SUCCESS; ++i) {
+        status = cublasLtMatmul(get_gpu().get_cublaslt_handle(), cublas_op_desc_wgrad_, &alpha, top,
+                                cublas_dRelu_top_desc_, bottom, cublas_dRelu_bottom_desc_, &beta,
+                                kernel, cublas_kernel_desc_, kernel, cublas_kernel_desc_,
+                                &heuristic_result_wgrad[algoIdx].algo, cublaslt_workspace_wgrad_,
+                                cublaslt_workspace_size_, get_gpu().get_stream());
+      }
+      HCTR_LIB_THROW(cudaEventRecord(stop, get_gpu().get_stream()));
+      HCTR_LIB_THROW(cudaEventSynchronize(stop));
+      HCTR_LIB_THROW(cudaEventElapsedTime(&time, start, stop));
+
+      // Avg Time(ms) for this alorithm for fprop GEMM
+      time = time / repeat_num;
+      // HCTR_LOG(INFO, WORLD, "algoIdx: %d, time: %f, shortest time: %f\n", algoIdx, time,
+      // shortestTime); Skip if the algorithm is supported for fprop configuration
+      if (status != CUBLAS_STATUS_SUCCESS) {
+        //      HCTR_LOG(INFO, WORLD, "The algorithms %d is not supported for fprop, skipped.\n",
+        //      testAlgo);
+        continue;
+      }
+      // Record the optimal time and algorithm
+      if (time < shortestTime) {
+        shortestTime = time;
+        // HCTR_LOG(INFO, WORLD, "wgrad cublasMatmul algoIdx: %d, time: %f\n", algoIdx,
+        // shortestTime);
+        memcpy(&balgo_wgrad_, &heuristic_result_wgrad[algoIdx].algo, sizeof(balgo_wgrad_));
+      }
     }
+    algo_cache.update(wgrad_key, balgo_wgrad_);
   }
 
   // Reset shortestTime
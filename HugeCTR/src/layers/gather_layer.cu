@@ -78,6 +78,16 @@ GatherLayer<T>::GatherLayer(const Tensor2<T>& in_tensor, Tensor2<T>& out_tensor,
     out_tensor_.push_back(out_tensor);
     in_tensors_.push_back(in_tensor);
 
+    // Consecutive indices select a contiguous block of rows; remember the start so the
+    // forward/backward passes degrade to plain device copies.
+    contiguous_start_ = indices.data()[0];
+    for (size_t i = 1; i < num_indices; i++) {
+      if (indices.data()[i] != contiguous_start_ + static_cast<int>(i)) {
+        contiguous_start_ = -1;
+        break;
+      }
+    }
+
   } catch (const std::runtime_error& rt_err) {
     HCTR_LOG_S(ERROR, WORLD) << rt_err.what() << std::endl;
     throw;
@@ -99,8 +109,14 @@ void GatherLayer<T>::fprop(bool is_train) {
   Tensor2<T>& out_tensor = out_tensor_[0];
   T* out = out_tensor.get_ptr();
   T* in = in_tensor.get_ptr();
-  gather_kernel<<<n_blocks, block_size, 0, get_gpu().get_stream()>>>(
-      true, in, out, tensor_size, num_indices, indices_.get_ptr());
+  if (contiguous_start_ >= 0) {
+    HCTR_LIB_THROW(cudaMemcpyAsync(out, in + contiguous_start_ * tensor_size,
+                                   num_indices * tensor_size * sizeof(T),
+                                   cudaMemcpyDeviceToDevice, get_gpu().get_stream()));
+  } else {
+    gather_kernel<<<n_blocks, block_size, 0, get_gpu().get_stream()>>>(
+        true, in, out, tensor_size, num_indices, indices_.get_ptr());
+  }
 #ifndef NDEBUG
   cudaDeviceSynchronize();
   HCTR_LIB_THROW(cudaGetLastError());
@@ -117,8 +133,14 @@ void GatherLayer<T>::bprop() {
   T* in = in_tensor.get_ptr();
   int h = in_tensor.get_dimensions()[0];
   initialize_array<<<n_blocks, block_size, 0, get_gpu().get_stream()>>>(in, h * tensor_size, T(0));
-  gather_kernel<<<n_blocks, block_size, 0, get_gpu().get_stream()>>>(
-      false, in, out, tensor_size, num_indices, indices_.get_ptr());
+  if (contiguous_start_ >= 0) {
+    HCTR_LIB_THROW(cudaMemcpyAsync(in + contiguous_start_ * tensor_size, out,
+                                   num_indices * tensor_size * sizeof(T),
+                                   cudaMemcpyDeviceToDevice, get_gpu().get_stream()));
+  } else {
+    gather_kernel<<<n_blocks, block_size, 0, get_gpu().get_stream()>>>(
+        false, in, out, tensor_size, num_indices, indices_.get_ptr());
+  }
 #ifndef NDEBUG
   cudaDeviceSynchronize();
   HCTR_LIB_THROW(cudaGetLastError());
@@ -34,6 +34,20 @@
 
 namespace HugeCTR {
 
+namespace {
+
+template <typename T>
+__global__ void cast_seq_len_kernel(int* dev_seq_lengths, const T* seq_len_tensor, int batch_size,
+                                    int max_seq_len) {
+  int gid = blockIdx.x * blockDim.x + threadIdx.x;
+  if (gid < batch_size) {
+    int len = static_cast<int>(seq_len_tensor[gid]);
+    dev_seq_lengths[gid] = max(0, min(len, max_seq_len));
+  }
+}
+
+}  // namespace
+
 template <typename T>
 GRULayer<T>::GRULayer(const std::shared_ptr<BufferBlock2<T>>& weight_buff,
                       const std::shared_ptr<BufferBlock2<T>>& wgrad_buff,
@@ -41,6 +55,17 @@ GRULayer<T>::GRULayer(const std::shared_ptr<BufferBlock2<T>>& weight_buff,
                       size_t batch_size, size_t SeqLength, size_t embedding_vec_size,
                       const std::shared_ptr<GPUResource>& gpu_resource,
                       std::vector<Initializer_t> initializer_types)
+    : GRULayer(weight_buff, wgrad_buff, in_tensor, Tensor2<T>(), out_tensor, hiddenSize,
+               batch_size, SeqLength, embedding_vec_size, gpu_resource, initializer_types) {}
+
+template <typename T>
+GRULayer<T>::GRULayer(const std::shared_ptr<BufferBlock2<T>>& weight_buff,
+                      const std::shared_ptr<BufferBlock2<T>>& wgrad_buff,
+                      const Tensor2<T>& in_tensor, const Tensor2<T>& seq_len_tensor,
+                      const Tensor2<T>& out_tensor, size_t hiddenSize, size_t batch_size,
+                      size_t SeqLength, size_t embedding_vec_size,
+                      const std::shared_ptr<GPUResource>& gpu_resource,
+                      std::vector<Initializer_t> initializer_types)
     : Layer(gpu_resource, initializer_types) {
   try {
     CudaDeviceContext context(get_device_id());
@@ -48,6 +73,11 @@ GRULayer<T>::GRULayer(const std::shared_ptr<BufferBlock2<T>>& weight_buff,
     const auto& in_tensor_dim = in_tensor.get_dimensions();
     const auto& out_tensor_dim = out_tensor.get_dimensions();
 
+    variable_seq_len_ = !seq_len_tensor.get_dimensions().empty();
+    if (variable_seq_len_) {
+      seq_len_tensor_ = seq_len_tensor;
+    }
+
     // 2. dim match?
     // seqLength = in_tensor_dim[1];
     // m = out_tensor_dim[1];
@@ -94,7 +124,7 @@ GRULayer<T>::GRULayer(const std::shared_ptr<BufferBlock2<T>>& weight_buff,
         miniBatch,                                 // int batchSize,
         embedding_vec_size_,                       // int vectorSize,
         seqLengthArray,                            // const int seqLengthArray[],
-        NULL                                       // void *paddingFill
+        variable_seq_len_ ? &padding_fill_ : NULL  // void *paddingFill
         ));
 
     HCTR_LIB_THROW(cudnnSetRNNDataDescriptor(
@@ -106,7 +136,7 @@ GRULayer<T>::GRULayer(const std::shared_ptr<BufferBlock2<T>>& weight_buff,
         miniBatch,                                 // int batchSize,
         hiddenSize_,                               // int vectorSize,
         seqLengthArray,                            // const int seqLengthArray[],
-        NULL                                       // void *paddingFill
+        variable_seq_len_ ? &padding_fill_ : NULL  // void *paddingFill
         ));
     dimHidden[0] = 1 * 1;
     dimHidden[1] = miniBatch;
@@ -123,26 +153,49 @@ GRULayer<T>::GRULayer(const std::shared_ptr<BufferBlock2<T>>& weight_buff,
     HCTR_LIB_THROW(
         cudnnSetDropoutDescriptor(dropoutDesc, cudnnHandle, dropout, states, stateSize, seed));
 
-    HCTR_LIB_THROW(cudnnSetRNNDescriptor_v8(
-        rnnDesc,
-        CUDNN_RNN_ALGO_STANDARD,    // cudnnRNNAlgo_t algo,
-        CUDNN_GRU,                  // cudnnRNNMode_t cellMode,
-        CUDNN_RNN_SINGLE_INP_BIAS,  // cudnnRNNBiasMode_t biasMode,
-        CUDNN_UNIDIRECTIONAL,       // cudnnDirectionMode_t dirMode,
-        CUDNN_LINEAR_INPUT,         // CUDNN_SKIP_INPUT, //CUDNN_LINEAR_INPUT, //cudnnRNNInputMode_t
-                             // inputMode, CUDNN_SKIP_INPUT :without multiplying input by the weight
-                             // matrix
-        data_type,             // cudnnDataType_t dataType,
-        data_type,             // cudnnDataType_t mathPrec,
-        CUDNN_TENSOR_OP_MATH,  // CUDNN_DEFAULT_MATH , //cudnnMathType_t mathType,
-        embedding_vec_size_,   // int32_t embedding_vec_size, When the inputMode=CUDNN_SKIP_INPUT,
-                               // the embedding_vec_size should match the hiddenSize value
-        hiddenSize_,           // int32_t hiddenSize,
-        hiddenSize_,           // int32_t projSize,
-        1,                     // int32_t numLayers, BIDIRECTIONAL=2
-        dropoutDesc,           // cudnnDropoutDescriptor_t dropoutDesc,
-        CUDNN_RNN_PADDED_IO_DISABLED  // uint32_t auxFlags
-        ));
+    auto set_rnn_descriptor = [&](cudnnRNNAlgo_t algo) {
+      return cudnnSetRNNDescriptor_v8(
+          rnnDesc,
+          algo,                       // cudnnRNNAlgo_t algo,
+          CUDNN_GRU,                  // cudnnRNNMode_t cellMode,
+          CUDNN_RNN_SINGLE_INP_BIAS,  // cudnnRNNBiasMode_t biasMode,
+          CUDNN_UNIDIRECTIONAL,       // cudnnDirectionMode_t dirMode,
+          CUDNN_LINEAR_INPUT,  // CUDNN_SKIP_INPUT, //CUDNN_LINEAR_INPUT, //cudnnRNNInputMode_t
+                               // inputMode, CUDNN_SKIP_INPUT :without multiplying input by the
+                               // weight matrix
+          data_type,             // cudnnDataType_t dataType,
+          data_type,             // cudnnDataType_t mathPrec,
+          CUDNN_TENSOR_OP_MATH,  // CUDNN_DEFAULT_MATH , //cudnnMathType_t mathType,
+          embedding_vec_size_,   // int32_t embedding_vec_size, When the
+                                 // inputMode=CUDNN_SKIP_INPUT, the embedding_vec_size should
+                                 // match the hiddenSize value
+          hiddenSize_,           // int32_t hiddenSize,
+          hiddenSize_,           // int32_t projSize,
+          1,                     // int32_t numLayers, BIDIRECTIONAL=2
+          dropoutDesc,           // cudnnDropoutDescriptor_t dropoutDesc,
+          variable_seq_len_ ? CUDNN_RNN_PADDED_IO_ENABLED
+                            : CUDNN_RNN_PADDED_IO_DISABLED  // uint32_t auxFlags
+      );
+    };
+
+    // The persistent algorithm keeps the recurrent weights on chip across the time steps, which
+    // is a large win for the small hidden sizes typical of session models. Whether it is
+    // supported depends on the hidden size and the architecture, so probe it and fall back to
+    // the standard algorithm when cuDNN rejects the configuration.
+    cudnnStatus_t status = set_rnn_descriptor(CUDNN_RNN_ALGO_PERSIST_STATIC);
+    if (status == CUDNN_STATUS_SUCCESS) {
+      status = cudnnGetRNNTempSpaceSizes(cudnnHandle, rnnDesc, CUDNN_FWD_MODE_TRAINING, in_Desc,
+                                         &workSpaceSize, &reserveSpaceSize);
+    }
+    if (status != CUDNN_STATUS_SUCCESS) {
+      HCTR_LOG_S(INFO, ROOT) << "The persistent RNN algorithm is not supported for GRU hidden "
+                                "size "
+                             << hiddenSize_ << ", falling back to the standard algorithm."
+                             << std::endl;
+      HCTR_LIB_THROW(set_rnn_descriptor(CUDNN_RNN_ALGO_STANDARD));
+      HCTR_LIB_THROW(cudnnGetRNNTempSpaceSizes(cudnnHandle, rnnDesc, CUDNN_FWD_MODE_TRAINING,
+                                               in_Desc, &workSpaceSize, &reserveSpaceSize));
+    }
 
     // const int seqLengthArray[in_tensor_dim[0]] = { [0...10] = int(in_tensor_dim[1]) };
     // const int seqLengthArray[m] ={n,n....n};
@@ -150,8 +203,6 @@ GRULayer<T>::GRULayer(const std::shared_ptr<BufferBlock2<T>>& weight_buff,
     // = { [0 . . . 3 ] = 3 };
 
     HCTR_LIB_THROW(cudnnGetRNNWeightSpaceSize(cudnnHandle, rnnDesc, &weightSpaceSize));
-    HCTR_LIB_THROW(cudnnGetRNNTempSpaceSizes(cudnnHandle, rnnDesc, CUDNN_FWD_MODE_TRAINING, in_Desc,
-                                             &workSpaceSize, &reserveSpaceSize));
     // std::vector<size_t> weight_dim = {weightSpaceSize/sizeof(T), 1};
     // std::vector<size_t> dx_dim =  {inputTensorSize, 1};
     // std::vector<size_t> dy_dim =  {outputTensorSize, 1};
@@ -224,6 +275,29 @@ GRULayer<T>::GRULayer(const std::shared_ptr<BufferBlock2<T>>& weight_buff,
   }
 }
 
+template <typename T>
+void GRULayer<T>::refresh_seq_length_descriptors() {
+  cudaStream_t stream = get_gpu().get_stream();
+  const int block_size = 256;
+  const int grid_size = static_cast<int>((miniBatch + block_size - 1) / block_size);
+  cast_seq_len_kernel<<<grid_size, block_size, 0, stream>>>(
+      devSeqLengthArray, seq_len_tensor_.get_ptr(), static_cast<int>(miniBatch),
+      static_cast<int>(seqLength_));
+  // cudnnSetRNNDataDescriptor reads the lengths from the host.
+  HCTR_LIB_THROW(cudaMemcpyAsync(seqLengthArray, devSeqLengthArray, miniBatch * sizeof(int),
+                                 cudaMemcpyDeviceToHost, stream));
+  HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+
+  HCTR_LIB_THROW(cudnnSetRNNDataDescriptor(in_Desc, data_type,
+                                           CUDNN_RNN_DATA_LAYOUT_SEQ_MAJOR_UNPACKED, seqLength_,
+                                           miniBatch, embedding_vec_size_, seqLengthArray,
+                                           &padding_fill_));
+  HCTR_LIB_THROW(cudnnSetRNNDataDescriptor(out_Desc, data_type,
+                                           CUDNN_RNN_DATA_LAYOUT_SEQ_MAJOR_UNPACKED, seqLength_,
+                                           miniBatch, hiddenSize_, seqLengthArray,
+                                           &padding_fill_));
+}
+
 //#define KERAS_CHECK
 template <typename T>
 void GRULayer<T>::fprop(bool is_train) {
@@ -304,6 +378,10 @@ void GRULayer<T>::fprop(bool is_train) {
   HCTR_LIB_THROW(cudnnDestroyTensorDescriptor(wDesc));
   HCTR_LIB_THROW(cudnnDestroyTensorDescriptor(bDesc));
 #endif
+  if (variable_seq_len_) {
+    refresh_seq_length_descriptors();
+  }
+
   // CUDNN GRU
   // T tmp[hiddenTensorSize];
   // HCTR_LIB_THROW(cudaMemcpy(tmp, weight + weightSpaceSize/sizeof(T), sizeof(T) *
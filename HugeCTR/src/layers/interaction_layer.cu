@@ -21,6 +21,7 @@
 #include <mma.h>
 
 #include <common.hpp>
+#include <cstdlib>
 #include <layers/interaction_layer.hpp>
 #include <type_traits>
 #include <utils.hpp>
@@ -846,6 +847,102 @@ __global__ void gather_concat_bprop_kernel(const T *out, T *in0, T *mat, const i
   }
 }
 
+// Fused variants of the concat + batched GEMM + gather pipeline above: one block works on
+// one sample, stages the virtual [mlp | emb] matrix in shared memory and emits the mlp
+// passthrough plus the flattened triangle directly, so the [batch, n_ins, n_ins] dot
+// matrix and both concat copies never touch global memory.
+template <typename T>
+__global__ void fused_interaction_fprop_kernel(const T *in_mlp, const T *in_emb, T *out,
+                                               const int h, const int n_ins, const int w) {
+  extern __shared__ char fused_smem[];
+  T *s_x = reinterpret_cast<T *>(fused_smem);
+  const int n_emb = n_ins - 1;
+  const int num_pairs = n_ins * (n_ins - 1) / 2;
+  const int out_len = w + num_pairs + 1;
+  const int nthreads = blockDim.x * blockDim.y;
+  const int tid = threadIdx.y * blockDim.x + threadIdx.x;
+
+  for (int bid = blockIdx.x; bid < h; bid += gridDim.x) {
+    const T *mlp = in_mlp + bid * w;
+    const T *emb = in_emb + static_cast<size_t>(bid) * n_emb * w;
+    for (int i = tid; i < n_ins * w; i += nthreads) {
+      s_x[i] = (i < w) ? mlp[i] : emb[i - w];
+    }
+    __syncthreads();
+
+    T *sample_out = out + static_cast<size_t>(bid) * out_len;
+    for (int i = tid; i < w; i += nthreads) {
+      sample_out[i] = s_x[i];
+    }
+    for (int p = threadIdx.y; p < num_pairs; p += blockDim.y) {
+      // invert p == col * (col - 1) / 2 + row with row < col
+      int col = (1 + static_cast<int>(sqrtf(8.f * p + 1.f))) / 2;
+      while (col * (col - 1) / 2 > p) --col;
+      while ((col + 1) * col / 2 <= p) ++col;
+      int row = p - col * (col - 1) / 2;
+
+      float dot = 0.f;
+      for (int k = threadIdx.x; k < w; k += blockDim.x) {
+        dot += static_cast<float>(s_x[row * w + k]) * static_cast<float>(s_x[col * w + k]);
+      }
+      for (int offset = warpSize / 2; offset > 0; offset >>= 1) {
+        dot += __shfl_down_sync(0xffffffff, dot, offset);
+      }
+      if (threadIdx.x == 0) {
+        sample_out[w + p] = dot;
+      }
+    }
+    __syncthreads();
+  }
+}
+
+template <typename T>
+__global__ void fused_interaction_bprop_kernel(const T *up_grad, T *mlp_grad, T *emb_grad,
+                                               const int h, const int n_ins, const int w) {
+  extern __shared__ char fused_smem[];
+  T *s_x = reinterpret_cast<T *>(fused_smem);
+  const int n_emb = n_ins - 1;
+  const int num_pairs = n_ins * (n_ins - 1) / 2;
+  T *s_g = s_x + n_ins * w;
+  const int out_len = w + num_pairs + 1;
+  const int nthreads = blockDim.x * blockDim.y;
+  const int tid = threadIdx.y * blockDim.x + threadIdx.x;
+
+  for (int bid = blockIdx.x; bid < h; bid += gridDim.x) {
+    // the input tensors still hold the forward activations; stage them before the
+    // gradients overwrite them in place
+    const T *mlp = mlp_grad + bid * w;
+    const T *emb = emb_grad + static_cast<size_t>(bid) * n_emb * w;
+    const T *up = up_grad + static_cast<size_t>(bid) * out_len;
+    for (int i = tid; i < n_ins * w; i += nthreads) {
+      s_x[i] = (i < w) ? mlp[i] : emb[i - w];
+    }
+    for (int p = tid; p < num_pairs; p += nthreads) {
+      s_g[p] = up[w + p];
+    }
+    __syncthreads();
+
+    for (int r = threadIdx.y; r < n_ins; r += blockDim.y) {
+      for (int k = threadIdx.x; k < w; k += blockDim.x) {
+        float acc = (r == 0) ? static_cast<float>(up[k]) : 0.f;
+        for (int c = 0; c < n_ins; ++c) {
+          if (c == r) continue;
+          int row = (r < c) ? r : c;
+          int col = (r < c) ? c : r;
+          float g = static_cast<float>(s_g[col * (col - 1) / 2 + row]);
+          acc += g * static_cast<float>(s_x[c * w + k]);
+        }
+        if (r == 0) {
+          mlp_grad[bid * w + k] = acc;
+        } else {
+          emb_grad[static_cast<size_t>(bid) * n_emb * w + (r - 1) * w + k] = acc;
+        }
+      }
+    }
+    __syncthreads();
+  }
+}
+
 }  // anonymous namespace
 
 template <typename T>
@@ -875,7 +972,12 @@ void InteractionLayer<T>::init(const Tensor2<T> &in_bottom_mlp_tensor,
     }
 
     size_t n_ins = 1 + second_in_dims[1];
-    if (std::is_same<T, __half>::value == false) {
+    fused_fp32_ = std::is_same<T, float>::value && std::getenv("HCTR_FUSED_INTERACTION_FP32");
+    if (fused_fp32_) {
+      HCTR_LOG_S(INFO, ROOT) << "HCTR_FUSED_INTERACTION_FP32 is set. InteractionLayer uses the "
+                                "fused fp32 kernels." << std::endl;
+    }
+    if (std::is_same<T, __half>::value == false && !fused_fp32_) {
       size_t concat_dims_width = first_in_dims[1] + second_in_dims[1] * second_in_dims[2];
       std::vector<size_t> concat_dims = {first_in_dims[0], concat_dims_width};
 
@@ -948,6 +1050,25 @@ InteractionLayer<T>::~InteractionLayer(){};
 template <typename T>
 void InteractionLayer<T>::fprop(bool is_train) {
   CudaDeviceContext context(get_device_id());
+  if (fused_fp32_) {
+    T *in_mlp = get_in_tensors(is_train)[0].get_ptr();
+    T *in_emb = get_in_tensors(is_train)[1].get_ptr();
+    T *output = out_tensors_[0].get_ptr();
+    const int h = get_in_tensors(is_train)[0].get_dimensions()[0];
+    const int in_w = get_in_tensors(is_train)[0].get_dimensions()[1];
+    const int n_ins = 1 + get_in_tensors(is_train)[1].get_dimensions()[1];
+
+    dim3 grid(get_gpu().get_sm_count() * 8, 1, 1);
+    dim3 block(32, 8, 1);
+    size_t smem_size = sizeof(T) * n_ins * in_w;
+    fused_interaction_fprop_kernel<<<grid, block, smem_size, get_gpu().get_stream()>>>(
+        in_mlp, in_emb, output, h, n_ins, in_w);
+#ifndef NDEBUG
+    HCTR_LIB_THROW(cudaDeviceSynchronize());
+    HCTR_LIB_THROW(cudaGetLastError());
+#endif
+    return;
+  }
   // phase 0: concat
   T *concat = internal_tensors_[0].get_ptr();
   T *in_mlp = get_in_tensors(is_train)[0].get_ptr();
@@ -1027,6 +1148,25 @@ void InteractionLayer<__half>::fprop(bool is_train) {
 template <typename T>
 void InteractionLayer<T>::bprop() {
   CudaDeviceContext context(get_device_id());
+  if (fused_fp32_) {
+    T *up_grad = out_tensors_[0].get_ptr();
+    T *mlp_grad = get_in_tensors(true)[0].get_ptr();
+    T *emb_grad = get_in_tensors(true)[1].get_ptr();
+    const int h = get_in_tensors(true)[0].get_dimensions()[0];
+    const int in_w = get_in_tensors(true)[0].get_dimensions()[1];
+    const int n_ins = 1 + get_in_tensors(true)[1].get_dimensions()[1];
+
+    dim3 grid(get_gpu().get_sm_count() * 8, 1, 1);
+    dim3 block(32, 8, 1);
+    size_t smem_size = sizeof(T) * (n_ins * in_w + n_ins * (n_ins - 1) / 2);
+    fused_interaction_bprop_kernel<<<grid, block, smem_size, get_gpu().get_stream()>>>(
+        up_grad, mlp_grad, emb_grad, h, n_ins, in_w);
+#ifndef NDEBUG
+    HCTR_LIB_THROW(cudaDeviceSynchronize());
+    HCTR_LIB_THROW(cudaGetLastError());
+#endif
+    return;
+  }
   // phase 0:
   T *gather = out_tensors_[0].get_ptr();
   T *in0 = get_in_tensors(true)[0].get_ptr();
@@ -43,6 +43,54 @@ namespace {
 template <typename T>
 using ToStringType = typename std::conditional<std::is_same<T, __half>::value, float, T>::type;
 
+// Chan's parallel combination of two Welford partials (count, mean, M2).
+__inline__ __device__ void welford_combine(float b_mean, float b_m2, float b_count, float& mean,
+                                           float& m2, float& count) {
+  float new_count = count + b_count;
+  if (new_count == 0.f) return;
+  float delta = b_mean - mean;
+  mean += delta * b_count / new_count;
+  m2 += b_m2 + delta * delta * count * b_count / new_count;
+  count = new_count;
+}
+
+__inline__ __device__ void warpReduceWelford(float& mean, float& m2, float& count) {
+  for (int i = WARP_SIZE / 2; i > 0; i >>= 1) {
+    float b_mean = __shfl_xor_sync(FINAL_MASK, mean, i);
+    float b_m2 = __shfl_xor_sync(FINAL_MASK, m2, i);
+    float b_count = __shfl_xor_sync(FINAL_MASK, count, i);
+    welford_combine(b_mean, b_m2, b_count, mean, m2, count);
+  }
+}
+
+__inline__ __device__ void blockReduceWelford(float& mean, float& m2, float& count) {
+  static __shared__ float s_mean[MAX_WARP_NUM];
+  static __shared__ float s_m2[MAX_WARP_NUM];
+  static __shared__ float s_count[MAX_WARP_NUM];
+  int lane = threadIdx.x & 0x1f;
+  int wid = threadIdx.x >> 5;
+
+  warpReduceWelford(mean, m2, count);
+
+  if (blockDim.x > WARP_SIZE) {
+    if (lane == 0) {
+      s_mean[wid] = mean;
+      s_m2[wid] = m2;
+      s_count[wid] = count;
+    }
+    __syncthreads();
+
+    bool valid = threadIdx.x < ((blockDim.x - 1) >> 5) + 1;
+    mean = valid ? s_mean[lane] : 0.f;
+    m2 = valid ? s_m2[lane] : 0.f;
+    count = valid ? s_count[lane] : 0.f;
+    warpReduceWelford(mean, m2, count);
+  }
+}
+
+// Single-pass statistics: each thread keeps a running Welford triple over its strided slice of
+// the row and the triples are combined across the block, so the input is read once for the
+// statistics instead of once for the mean and again for the variance.
 template <typename T>
 __global__ void layer_norm_kernel(T* out, const T* __restrict input, T* result_var, T* result_mean,
                                   const T* __restrict gamma, const T* __restrict beta, int batch,
@@ -50,40 +98,117 @@ __global__ void layer_norm_kernel(T* out, const T* __restrict input, T* result_v
   __shared__ float s_mean;
   __shared__ float s_variance;
 
+  float count = 0.0f;
   float mean = 0.0f;
-  float t_mean = 0.0f;
-  float variance = 0.0f;
-  float t_variance = 0.0f;
+  float m2 = 0.0f;
 
-  float local_out = 0.0f;
   for (int idx = threadIdx.x; idx < hidden_dim; idx += blockDim.x) {
-    local_out = static_cast<float>(input[blockIdx.x * hidden_dim + idx]);
-    mean += local_out;
+    float x = static_cast<float>(input[blockIdx.x * hidden_dim + idx]);
+    count += 1.f;
+    float delta = x - mean;
+    mean += delta / count;
+    m2 += delta * (x - mean);
   }
-  t_mean = blockDim.x <= 32 ? warpReduceSum<float>(mean) : blockReduceSum<float>(mean);
-  if (threadIdx.x == 0) s_mean = t_mean / hidden_dim;
-  __syncthreads();
-
-  float tmp = 0.0f;
-  for (int idx = threadIdx.x; idx < hidden_dim; idx += blockDim.x) {
-    local_out = static_cast<float>(input[blockIdx.x * hidden_dim + idx]);
-    variance += (local_out - s_mean) * (local_out - s_mean);
+  if (blockDim.x <= 32) {
+    warpReduceWelford(mean, m2, count);
+  } else {
+    blockReduceWelford(mean, m2, count);
+  }
+  if (threadIdx.x == 0) {
+    s_mean = mean;
+    s_variance = m2 / hidden_dim + eps;  // get epsilon
   }
-  t_variance = blockDim.x <= 32 ? warpReduceSum<float>(variance) : blockReduceSum<float>(variance);
-  if (threadIdx.x == 0) s_variance = t_variance / hidden_dim + eps;  // get epsilon
   __syncthreads();
 
   result_mean[blockIdx.x] = static_cast<T>(s_mean);
   result_var[blockIdx.x] = static_cast<T>(s_variance);
 
   for (int idx = threadIdx.x; idx < hidden_dim; idx += blockDim.x) {
-    local_out = static_cast<float>(input[blockIdx.x * hidden_dim + idx]);
+    float local_out = static_cast<float>(input[blockIdx.x * hidden_dim + idx]);
     out[blockIdx.x * hidden_dim + idx] =
         static_cast<T>(((local_out - s_mean) * rsqrtf(s_variance)) * (float)(__ldg(&gamma[idx])) +
                        (float)(__ldg(&beta[idx])));
   }
 }
 
+// float4 variant of layer_norm_kernel for rows whose width is a multiple of 4.
+__global__ void layer_norm_vec4_kernel(float* out, const float* __restrict input,
+                                       float* result_var, float* result_mean,
+                                       const float* __restrict gamma,
+                                       const float* __restrict beta, int batch, int hidden_dim,
+                                       double eps) {
+  __shared__ float s_mean;
+  __shared__ float s_variance;
+
+  const int hidden4 = hidden_dim / 4;
+  const float4* input4 = reinterpret_cast<const float4*>(input) + blockIdx.x * hidden4;
+  float4* out4 = reinterpret_cast<float4*>(out) + blockIdx.x * hidden4;
+  const float4* gamma4 = reinterpret_cast<const float4*>(gamma);
+  const float4* beta4 = reinterpret_cast<const float4*>(beta);
+
+  float count = 0.0f;
+  float mean = 0.0f;
+  float m2 = 0.0f;
+
+  for (int idx = threadIdx.x; idx < hidden4; idx += blockDim.x) {
+    float4 x = input4[idx];
+    float v[4] = {x.x, x.y, x.z, x.w};
+#pragma unroll
+    for (int k = 0; k < 4; ++k) {
+      count += 1.f;
+      float delta = v[k] - mean;
+      mean += delta / count;
+      m2 += delta * (v[k] - mean);
+    }
+  }
+  if (blockDim.x <= 32) {
+    warpReduceWelford(mean, m2, count);
+  } else {
+    blockReduceWelford(mean, m2, count);
+  }
+  if (threadIdx.x == 0) {
+    s_mean = mean;
+    s_variance = m2 / hidden_dim + eps;  // get epsilon
+  }
+  __syncthreads();
+
+  result_mean[blockIdx.x] = s_mean;
+  result_var[blockIdx.x] = s_variance;
+
+  float rstd = rsqrtf(s_variance);
+  for (int idx = threadIdx.x; idx < hidden4; idx += blockDim.x) {
+    float4 x = input4[idx];
+    float4 g = __ldg(gamma4 + idx);
+    float4 b = __ldg(beta4 + idx);
+    float4 y;
+    y.x = (x.x - s_mean) * rstd * g.x + b.x;
+    y.y = (x.y - s_mean) * rstd * g.y + b.y;
+    y.z = (x.z - s_mean) * rstd * g.z + b.z;
+    y.w = (x.w - s_mean) * rstd * g.w + b.w;
+    out4[idx] = y;
+  }
+}
+
+void launch_layer_norm_kernel(float* out, const float* in, float* result_var, float* result_mean,
+                              const float* gamma, const float* beta, int batch, int hidden_dim,
+                              double eps, dim3 grid_size, dim3 block_size, cudaStream_t stream) {
+  if (hidden_dim % 4 == 0) {
+    layer_norm_vec4_kernel<<<grid_size, block_size, 0, stream>>>(
+        out, in, result_var, result_mean, gamma, beta, batch, hidden_dim, eps);
+  } else {
+    layer_norm_kernel<<<grid_size, block_size, 0, stream>>>(out, in, result_var, result_mean,
+                                                            gamma, beta, batch, hidden_dim, eps);
+  }
+}
+
+void launch_layer_norm_kernel(__half* out, const __half* in, __half* result_var,
+                              __half* result_mean, const __half* gamma, const __half* beta,
+                              int batch, int hidden_dim, double eps, dim3 grid_size,
+                              dim3 block_size, cudaStream_t stream) {
+  layer_norm_kernel<<<grid_size, block_size, 0, stream>>>(out, in, result_var, result_mean, gamma,
+                                                          beta, batch, hidden_dim, eps);
+}
+
 template <typename T>
 __global__ void layer_norm_backward1(const T* __restrict__ out_grad, const T* __restrict__ X_data,
                                      const T* __restrict__ vars, const T* __restrict__ means,
@@ -447,8 +572,9 @@ void LayerNormLayer<T>::fprop(bool is_train) {
   dim3 block_size(min(hidden_dim, static_cast<size_t>(MAX_THREADS)), 1, 1);
   dim3 grid_size(batch, 1, 1);
 
-  layer_norm_kernel<<<grid_size, block_size, 0, get_gpu().get_stream()>>>(
-      out, in, result_save_var, result_save_mean, gamma, beta, batch, hidden_dim, params_.eps);
+  launch_layer_norm_kernel(out, in, result_save_var, result_save_mean, gamma, beta, batch,
+                           hidden_dim, params_.eps, grid_size, block_size,
+                           get_gpu().get_stream());
 }
 
 template <typename T>
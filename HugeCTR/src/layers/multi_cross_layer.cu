@@ -18,6 +18,8 @@
 #include <linalg/gemv.h>
 #include <math.h>
 
+#include <cstdlib>
+
 #include <layers/multi_cross_layer.hpp>
 #include <linalg/binary_op.cuh>
 // #include <linalg/gemm.cuh>
@@ -303,6 +305,119 @@ void rows_sum(Tensor2<T>& out, const Tensor2<T>& mat, cudaStream_t stream) {
                            [] __device__(T in, int i) { return in; });
 }
 
+// The cross layer's hidden state is one scalar per sample, so the whole stack collapses
+// to alternating block-wide dot products and axpy updates on a sample's vector. The fused
+// kernels below run every layer in one launch, keeping x, y and dy of the sample resident
+// in shared memory; only the per-layer outputs backward needs are written to global
+// memory. Weight gradients are accumulated with atomics, which trades the bitwise
+// determinism of the unfused reduction kernels for the fusion.
+constexpr int kMaxFusedCrossLayers = 16;
+
+template <typename T>
+struct CrossLayerPtrs {
+  const T* kernels[kMaxFusedCrossLayers];
+  const T* biases[kMaxFusedCrossLayers];
+  T* outputs[kMaxFusedCrossLayers];  // y_i
+  T* hiddens[kMaxFusedCrossLayers];  // v_i, one scalar per sample
+  T* kernel_grads[kMaxFusedCrossLayers];
+  T* bias_grads[kMaxFusedCrossLayers];
+};
+
+__device__ __forceinline__ float block_reduce_sum(float acc, float* s_red) {
+  s_red[threadIdx.x] = acc;
+  __syncthreads();
+  for (int stride = blockDim.x / 2; stride > 0; stride >>= 1) {
+    if (threadIdx.x < stride) {
+      s_red[threadIdx.x] += s_red[threadIdx.x + stride];
+    }
+    __syncthreads();
+  }
+  float sum = s_red[0];
+  __syncthreads();
+  return sum;
+}
+
+template <typename T>
+__global__ void fused_cross_fprop_kernel(const T* input, CrossLayerPtrs<T> ptrs,
+                                         const int num_layers, const int h, const int w) {
+  extern __shared__ char cross_smem[];
+  T* s_x = reinterpret_cast<T*>(cross_smem);
+  T* s_y = s_x + w;
+  float* s_red = reinterpret_cast<float*>(s_y + w);
+
+  for (int bid = blockIdx.x; bid < h; bid += gridDim.x) {
+    const T* x = input + static_cast<size_t>(bid) * w;
+    for (int j = threadIdx.x; j < w; j += blockDim.x) {
+      s_x[j] = x[j];
+      s_y[j] = s_x[j];
+    }
+    __syncthreads();
+
+    for (int i = 0; i < num_layers; ++i) {
+      float acc = 0.f;
+      for (int j = threadIdx.x; j < w; j += blockDim.x) {
+        acc += static_cast<float>(s_y[j]) * static_cast<float>(ptrs.kernels[i][j]);
+      }
+      float v = block_reduce_sum(acc, s_red);
+      if (threadIdx.x == 0) {
+        ptrs.hiddens[i][bid] = v;
+      }
+      T* y_out = ptrs.outputs[i] + static_cast<size_t>(bid) * w;
+      for (int j = threadIdx.x; j < w; j += blockDim.x) {
+        T val = s_x[j] * static_cast<T>(v) + s_y[j] + ptrs.biases[i][j];
+        s_y[j] = val;
+        y_out[j] = val;
+      }
+      __syncthreads();
+    }
+  }
+}
+
+template <typename T>
+__global__ void fused_cross_bprop_kernel(const T* input, const T* grad, CrossLayerPtrs<T> ptrs,
+                                         const int num_layers, const int h, const int w,
+                                         T* dx_out) {
+  extern __shared__ char cross_smem[];
+  T* s_x = reinterpret_cast<T*>(cross_smem);
+  T* s_dy = s_x + w;
+  T* s_dx = s_dy + w;
+  float* s_red = reinterpret_cast<float*>(s_dx + w);
+
+  for (int bid = blockIdx.x; bid < h; bid += gridDim.x) {
+    const T* x = input + static_cast<size_t>(bid) * w;
+    const T* dy_in = grad + static_cast<size_t>(bid) * w;
+    for (int j = threadIdx.x; j < w; j += blockDim.x) {
+      s_x[j] = x[j];
+      s_dy[j] = dy_in[j];
+      s_dx[j] = 0.f;
+    }
+    __syncthreads();
+
+    for (int i = num_layers - 1; i >= 0; --i) {
+      float hi = static_cast<float>(ptrs.hiddens[i][bid]);
+      float acc = 0.f;
+      for (int j = threadIdx.x; j < w; j += blockDim.x) {
+        s_dx[j] += s_dy[j] * static_cast<T>(hi);
+        acc += static_cast<float>(s_dy[j]) * static_cast<float>(s_x[j]);
+      }
+      float dv = block_reduce_sum(acc, s_red);
+      const T* y_prev =
+          (i == 0) ? s_x : ptrs.outputs[i - 1] + static_cast<size_t>(bid) * w;
+      for (int j = threadIdx.x; j < w; j += blockDim.x) {
+        atomicAdd(&ptrs.kernel_grads[i][j],
+                  static_cast<T>(dv * static_cast<float>(y_prev[j])));
+        atomicAdd(&ptrs.bias_grads[i][j], s_dy[j]);
+        s_dy[j] += static_cast<T>(dv * static_cast<float>(ptrs.kernels[i][j]));
+      }
+      __syncthreads();
+    }
+    for (int j = threadIdx.x; j < w; j += blockDim.x) {
+      dx_out[static_cast<size_t>(bid) * w + j] = s_dx[j] + s_dy[j];
+    }
+    __syncthreads();
+  }
+}
+
 }  // namespace
 
 /*
@@ -410,6 +525,12 @@ MultiCrossLayer<T>::MultiCrossLayer(
       HCTR_OWN_THROW(Error_t::WrongInput, "num_layers < 1");
     }
 
+    if (std::getenv("HCTR_FUSED_CROSS_LAYER") && num_layers <= kMaxFusedCrossLayers) {
+      fused_stack_ = true;
+      HCTR_LOG_S(INFO, ROOT) << "HCTR_FUSED_CROSS_LAYER is set. MultiCrossLayer runs the cross "
+                                "stack in one kernel per direction." << std::endl;
+    }
+
     std::vector<size_t> weight_bias_dim = {1, vec_length};
     reserve_master_weight_tensor(master_weight_buff, weight_bias_dim);
     for (int i = 0; i < num_layers; i++) {
@@ -512,6 +633,24 @@ void MultiCrossLayer<T>::fprop(bool is_train) {
     hidden_tensors.push_back(vec_tensors_[i]);
   }
 
+  if (fused_stack_) {
+    const int h = blob_tensors_[0].get_dimensions()[0];
+    const int w = blob_tensors_[0].get_dimensions()[1];
+    CrossLayerPtrs<T> ptrs{};
+    for (int i = 0; i < num_layers_; i++) {
+      ptrs.kernels[i] = kernel_tensors[i].get_ptr();
+      ptrs.biases[i] = bias_tensors[i].get_ptr();
+      ptrs.outputs[i] = output_tensors[i].get_ptr();
+      ptrs.hiddens[i] = hidden_tensors[i].get_ptr();
+    }
+    constexpr int block_size = 256;
+    int grid_size = std::min(h, static_cast<int>(get_gpu().get_sm_count()) * 8);
+    size_t smem_size = 2 * w * sizeof(T) + block_size * sizeof(float);
+    fused_cross_fprop_kernel<<<grid_size, block_size, smem_size, get_gpu().get_stream()>>>(
+        blob_tensors_[0].get_ptr(), ptrs, num_layers_, h, w);
+    return;
+  }
+
   MultiCrossForwardFunctor<T>()(get_gpu().get_stream(), get_gpu().get_cublas_handle(),
                                 blob_tensors_[0], kernel_tensors, bias_tensors, output_tensors,
                                 hidden_tensors, num_layers_);
@@ -537,6 +676,33 @@ void MultiCrossLayer<T>::bprop() {
     forward_output_tensors.push_back(blob_tensors_[i + 1]);
   }
 
+  if (fused_stack_) {
+    const int h = blob_tensors_[0].get_dimensions()[0];
+    const int w = blob_tensors_[0].get_dimensions()[1];
+    CrossLayerPtrs<T> ptrs{};
+    for (int i = 0; i < num_layers_; i++) {
+      ptrs.kernels[i] = kernel_tensors[i].get_ptr();
+      ptrs.hiddens[i] = forward_hidden_tensors[i].get_ptr();
+      ptrs.kernel_grads[i] = kernel_output_tensors[i].get_ptr();
+      ptrs.bias_grads[i] = bias_output_tensors[i].get_ptr();
+      if (i < num_layers_ - 1) {
+        ptrs.outputs[i] = forward_output_tensors[i].get_ptr();
+      }
+      // the unfused path overwrites the bias gradient while it accumulates the kernel
+      // gradient; match that by clearing only the bias gradient before the atomics
+      HCTR_LIB_THROW(cudaMemsetAsync(bias_output_tensors[i].get_ptr(), 0,
+                                     bias_output_tensors[i].get_size_in_bytes(),
+                                     get_gpu().get_stream()));
+    }
+    constexpr int block_size = 256;
+    int grid_size = std::min(h, static_cast<int>(get_gpu().get_sm_count()) * 8);
+    size_t smem_size = 3 * w * sizeof(T) + block_size * sizeof(float);
+    fused_cross_bprop_kernel<<<grid_size, block_size, smem_size, get_gpu().get_stream()>>>(
+        blob_tensors_[0].get_ptr(), blob_tensors_[num_layers_].get_ptr(), ptrs, num_layers_, h, w,
+        blob_tensors_[0].get_ptr());
+    return;
+  }
+
   MultiCrossBackwardFunctor<T>()(
       get_gpu().get_stream(), blob_tensors_[0], kernel_tensors, forward_output_tensors,
       forward_hidden_tensors, blob_tensors_[num_layers_], blob_tensors_[0], kernel_output_tensors,
@@ -26,6 +26,204 @@
 
 namespace HugeCTR {
 
+namespace {
+
+constexpr int kMaxFusedHeadDim = 128;
+constexpr int kFusedBlockSize = 128;
+
+__device__ __forceinline__ float block_reduce_sum(float val, float* s_red) {
+  s_red[threadIdx.x] = val;
+  __syncthreads();
+  for (int stride = blockDim.x / 2; stride > 0; stride /= 2) {
+    if (threadIdx.x < stride) {
+      s_red[threadIdx.x] += s_red[threadIdx.x + stride];
+    }
+    __syncthreads();
+  }
+  float sum = s_red[0];
+  __syncthreads();
+  return sum;
+}
+
+/**
+ * Streaming-softmax attention forward. One block processes one query row: the key dimension
+ * is consumed with a running max / running sum so the [seq, seq] score matrix is never
+ * materialized. Writes out = softmax(Q K^T / sqrt(d)) V and the per-row logsumexp needed to
+ * reconstruct the probabilities in the backward pass.
+ */
+template <typename T>
+__global__ void fused_attention_fprop_kernel(const T* query, const T* key, const T* value, T* out,
+                                             float* lse, const int from_seq_len,
+                                             const int to_seq_len, const int head_dim) {
+  __shared__ float s_q[kMaxFusedHeadDim];
+  __shared__ float s_acc[kMaxFusedHeadDim];
+  __shared__ float s_red[kFusedBlockSize];
+
+  const int row = blockIdx.x % from_seq_len;
+  const int bh = blockIdx.x / from_seq_len;
+  const float scale = rsqrtf(static_cast<float>(head_dim));
+
+  const T* q_row = query + (static_cast<size_t>(bh) * from_seq_len + row) * head_dim;
+  for (int t = threadIdx.x; t < head_dim; t += blockDim.x) {
+    s_q[t] = static_cast<float>(q_row[t]);
+    s_acc[t] = 0.f;
+  }
+  __syncthreads();
+
+  float running_max = -1e20f;
+  float running_sum = 0.f;
+
+  for (int j = 0; j < to_seq_len; ++j) {
+    const T* k_row = key + (static_cast<size_t>(bh) * to_seq_len + j) * head_dim;
+    const T* v_row = value + (static_cast<size_t>(bh) * to_seq_len + j) * head_dim;
+
+    float partial = 0.f;
+    for (int t = threadIdx.x; t < head_dim; t += blockDim.x) {
+      partial += s_q[t] * static_cast<float>(k_row[t]);
+    }
+    const float score = block_reduce_sum(partial, s_red) * scale;
+
+    const float new_max = fmaxf(running_max, score);
+    const float correction = expf(running_max - new_max);
+    const float prob = expf(score - new_max);
+    for (int t = threadIdx.x; t < head_dim; t += blockDim.x) {
+      s_acc[t] = s_acc[t] * correction + prob * static_cast<float>(v_row[t]);
+    }
+    running_max = new_max;
+    running_sum = running_sum * correction + prob;
+    __syncthreads();
+  }
+
+  T* out_row = out + (static_cast<size_t>(bh) * from_seq_len + row) * head_dim;
+  for (int t = threadIdx.x; t < head_dim; t += blockDim.x) {
+    out_row[t] = static_cast<T>(s_acc[t] / running_sum);
+  }
+  if (threadIdx.x == 0) {
+    lse[static_cast<size_t>(bh) * from_seq_len + row] = running_max + logf(running_sum);
+  }
+}
+
+/**
+ * Backward, query side. Recomputes the probabilities from the saved logsumexp, accumulates
+ * dQ_i = sum_j P_ij (dP_ij - D_i) K_j / sqrt(d) with D_i = dot(dOut_i, Out_i), and stores
+ * D_i for the key/value pass. Reads the saved forward query; the live query tensor receives
+ * the gradient.
+ */
+template <typename T>
+__global__ void fused_attention_bprop_dq_kernel(const T* query, const T* key, const T* value,
+                                                const T* out, const T* dout, const float* lse,
+                                                float* row_dot, T* dquery, const int from_seq_len,
+                                                const int to_seq_len, const int head_dim) {
+  __shared__ float s_q[kMaxFusedHeadDim];
+  __shared__ float s_do[kMaxFusedHeadDim];
+  __shared__ float s_dq[kMaxFusedHeadDim];
+  __shared__ float s_red[kFusedBlockSize];
+
+  const int row = blockIdx.x % from_seq_len;
+  const int bh = blockIdx.x / from_seq_len;
+  const size_t row_offset = (static_cast<size_t>(bh) * from_seq_len + row) * head_dim;
+  const float scale = rsqrtf(static_cast<float>(head_dim));
+
+  float partial = 0.f;
+  for (int t = threadIdx.x; t < head_dim; t += blockDim.x) {
+    s_q[t] = static_cast<float>(query[row_offset + t]);
+    s_do[t] = static_cast<float>(dout[row_offset + t]);
+    s_dq[t] = 0.f;
+    partial += s_do[t] * static_cast<float>(out[row_offset + t]);
+  }
+  __syncthreads();
+  const float dot_do_out = block_reduce_sum(partial, s_red);
+  if (threadIdx.x == 0) {
+    row_dot[static_cast<size_t>(bh) * from_seq_len + row] = dot_do_out;
+  }
+
+  const float row_lse = lse[static_cast<size_t>(bh) * from_seq_len + row];
+  for (int j = 0; j < to_seq_len; ++j) {
+    const T* k_row = key + (static_cast<size_t>(bh) * to_seq_len + j) * head_dim;
+    const T* v_row = value + (static_cast<size_t>(bh) * to_seq_len + j) * head_dim;
+
+    float score_partial = 0.f;
+    float dprob_partial = 0.f;
+    for (int t = threadIdx.x; t < head_dim; t += blockDim.x) {
+      score_partial += s_q[t] * static_cast<float>(k_row[t]);
+      dprob_partial += s_do[t] * static_cast<float>(v_row[t]);
+    }
+    const float score = block_reduce_sum(score_partial, s_red) * scale;
+    const float dprob = block_reduce_sum(dprob_partial, s_red);
+
+    const float coef = expf(score - row_lse) * (dprob - dot_do_out) * scale;
+    for (int t = threadIdx.x; t < head_dim; t += blockDim.x) {
+      s_dq[t] += coef * static_cast<float>(k_row[t]);
+    }
+    __syncthreads();
+  }
+
+  for (int t = threadIdx.x; t < head_dim; t += blockDim.x) {
+    dquery[row_offset + t] = static_cast<T>(s_dq[t]);
+  }
+}
+
+/**
+ * Backward, key/value side. One block per key position; the gradient is written back into
+ * the key/value tensors only after the column's forward values have been consumed, so the
+ * tensors can serve as their own gradient buffers. Must run after the dQ kernel, which
+ * produces row_dot.
+ */
+template <typename T>
+__global__ void fused_attention_bprop_dkv_kernel(const T* query, T* key, T* value, const T* dout,
+                                                 const float* lse, const float* row_dot,
+                                                 const int from_seq_len, const int to_seq_len,
+                                                 const int head_dim) {
+  __shared__ float s_k[kMaxFusedHeadDim];
+  __shared__ float s_v[kMaxFusedHeadDim];
+  __shared__ float s_dk[kMaxFusedHeadDim];
+  __shared__ float s_dv[kMaxFusedHeadDim];
+  __shared__ float s_red[kFusedBlockSize];
+
+  const int col = blockIdx.x % to_seq_len;
+  const int bh = blockIdx.x / to_seq_len;
+  const size_t col_offset = (static_cast<size_t>(bh) * to_seq_len + col) * head_dim;
+  const float scale = rsqrtf(static_cast<float>(head_dim));
+
+  for (int t = threadIdx.x; t < head_dim; t += blockDim.x) {
+    s_k[t] = static_cast<float>(key[col_offset + t]);
+    s_v[t] = static_cast<float>(value[col_offset + t]);
+    s_dk[t] = 0.f;
+    s_dv[t] = 0.f;
+  }
+  __syncthreads();
+
+  for (int i = 0; i < from_seq_len; ++i) {
+    const size_t row_offset = (static_cast<size_t>(bh) * from_seq_len + i) * head_dim;
+    const T* q_row = query + row_offset;
+    const T* do_row = dout + row_offset;
+
+    float score_partial = 0.f;
+    float dprob_partial = 0.f;
+    for (int t = threadIdx.x; t < head_dim; t += blockDim.x) {
+      score_partial += static_cast<float>(q_row[t]) * s_k[t];
+      dprob_partial += static_cast<float>(do_row[t]) * s_v[t];
+    }
+    const float score = block_reduce_sum(score_partial, s_red) * scale;
+    const float dprob = block_reduce_sum(dprob_partial, s_red);
+
+    const float prob = expf(score - lse[static_cast<size_t>(bh) * from_seq_len + i]);
+    const float coef = prob * (dprob - row_dot[static_cast<size_t>(bh) * from_seq_len + i]) * scale;
+    for (int t = threadIdx.x; t < head_dim; t += blockDim.x) {
+      s_dk[t] += coef * static_cast<float>(q_row[t]);
+      s_dv[t] += prob * static_cast<float>(do_row[t]);
+    }
+    __syncthreads();
+  }
+
+  for (int t = threadIdx.x; t < head_dim; t += blockDim.x) {
+    key[col_offset + t] = static_cast<T>(s_dk[t]);
+    value[col_offset + t] = static_cast<T>(s_dv[t]);
+  }
+}
+
+}  // namespace
+
 template <typename T>
 MultiHeadAttentionLayer<T>::MultiHeadAttentionLayer(
     const Tensors2<T>& in_tensors, Tensor2<T>& out_tensor,
@@ -47,6 +245,9 @@ MultiHeadAttentionLayer<T>::MultiHeadAttentionLayer(
       HCTR_OWN_THROW(Error_t::WrongInput,
                      "MultiHeadAttentionLayer needs 2 input tensors: query and key");
     }
+    // With a third (value) input the layer computes the whole attention output with a
+    // streaming-softmax kernel instead of emitting the score matrix.
+    fused_attention_ = (num_ == 3);
     if (in_tensors[1].get_dimensions().size() != dims_) {
       HCTR_OWN_THROW(Error_t::WrongInput, "All the input tensors must have the same num of dims");
     }
@@ -70,8 +271,26 @@ MultiHeadAttentionLayer<T>::MultiHeadAttentionLayer(
 
     size_t h = in_tensors[0].get_dimensions()[0];
     size_t b = in_tensors[0].get_dimensions()[1];
-    std::vector<size_t> out_dim = {h, b, m, k};
-    blobs_buff->reserve(out_dim, &out_tensor);
+    size_t d = in_tensors[0].get_dimensions()[dims_ - 1];
+    if (fused_attention_) {
+      if (in_tensors[2].get_dimensions() != in_tensors[1].get_dimensions()) {
+        HCTR_OWN_THROW(Error_t::WrongInput,
+                       "The value tensor must have the same shape as the key tensor");
+      }
+      if (d > kMaxFusedHeadDim) {
+        HCTR_OWN_THROW(Error_t::WrongInput,
+                       "Fused attention supports head dimensions up to 128 only");
+      }
+      std::vector<size_t> out_dim = {h, b, m, d};
+      blobs_buff->reserve(out_dim, &out_tensor);
+      blobs_buff->reserve(out_dim, &fprop_out_);
+      std::vector<size_t> stats_dim = {h, b, m};
+      blobs_buff->reserve(stats_dim, &softmax_lse_);
+      blobs_buff->reserve(stats_dim, &bprop_row_dot_);
+    } else {
+      std::vector<size_t> out_dim = {h, b, m, k};
+      blobs_buff->reserve(out_dim, &out_tensor);
+    }
 
     out_tensor_ = out_tensor;
 
@@ -102,6 +321,28 @@ void MultiHeadAttentionLayer<T>::fprop(bool is_train) {
   size_per_head = in_tensor_dim[dims_ - 1];
   to_seq_len = out_tensor_dim[dims_ - 1];
 
+  if (fused_attention_) {
+    T* value = in_tensors_[2].get_ptr();
+    to_seq_len = in_tensors_[1].get_dimensions()[dims_ - 2];
+    const int grid_size = head_num * batch_size * from_seq_len;
+    fused_attention_fprop_kernel<<<grid_size, kFusedBlockSize, 0, get_gpu().get_stream()>>>(
+        query, key, value, out, softmax_lse_.get_ptr(), from_seq_len, to_seq_len, size_per_head);
+
+    // The backward pass needs the forward query and output: the query tensor is overwritten
+    // with its gradient and the output tensor arrives holding the output gradient.
+    HCTR_LIB_THROW(cudaMemcpyAsync((void*)fprop_inputA_.get_ptr(), (void*)query,
+                                   in_tensors_[0].get_size_in_bytes(), cudaMemcpyDeviceToDevice,
+                                   get_gpu().get_stream()));
+    HCTR_LIB_THROW(cudaMemcpyAsync((void*)fprop_out_.get_ptr(), (void*)out,
+                                   out_tensor_.get_size_in_bytes(), cudaMemcpyDeviceToDevice,
+                                   get_gpu().get_stream()));
+#ifndef NDEBUG
+    cudaDeviceSynchronize();
+    HCTR_LIB_THROW(cudaGetLastError());
+#endif
+    return;
+  }
+
   const int batch_count = head_num * batch_size;
   const int m = from_seq_len;
   const int n = to_seq_len;
@@ -153,6 +394,27 @@ void MultiHeadAttentionLayer<T>::bprop() {
   size_per_head = in_tensor_dim[dims_ - 1];
   to_seq_len = out_tensor_dim[dims_ - 1];
 
+  if (fused_attention_) {
+    T* value = in_tensors_[2].get_ptr();
+    to_seq_len = in_tensors_[1].get_dimensions()[dims_ - 2];
+    const int batch_count = head_num * batch_size;
+
+    // The dQ pass also produces the per-row dot(dOut, Out) terms the dK/dV pass consumes.
+    fused_attention_bprop_dq_kernel<<<batch_count * (int)from_seq_len, kFusedBlockSize, 0,
+                                      get_gpu().get_stream()>>>(
+        fprop_inputA_.get_ptr(), key, value, fprop_out_.get_ptr(), out, softmax_lse_.get_ptr(),
+        bprop_row_dot_.get_ptr(), query, from_seq_len, to_seq_len, size_per_head);
+    fused_attention_bprop_dkv_kernel<<<batch_count * (int)to_seq_len, kFusedBlockSize, 0,
+                                       get_gpu().get_stream()>>>(
+        fprop_inputA_.get_ptr(), key, value, out, softmax_lse_.get_ptr(),
+        bprop_row_dot_.get_ptr(), from_seq_len, to_seq_len, size_per_head);
+#ifndef NDEBUG
+    cudaDeviceSynchronize();
+    HCTR_LIB_THROW(cudaGetLastError());
+#endif
+    return;
+  }
+
   const int batch_count = head_num * batch_size;
   const int m = from_seq_len;
   const int n = size_per_head;
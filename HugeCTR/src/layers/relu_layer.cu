@@ -43,6 +43,34 @@ __global__ void forward_half2_relu_kernel(__half* top, const __half* bottom, int
   }
 }
 
+template <typename T>
+__global__ void forward_relu_mask_kernel(T* top, const T* bottom, unsigned int* mask, int size) {
+  constexpr int kWarpSize = 32;
+  int lane_id = threadIdx.x % kWarpSize;
+  int stride = blockDim.x * gridDim.x;
+  // The grid stride is a multiple of the warp size, so the loop bound is warp-uniform and every
+  // lane reaches the ballot even in the tail word.
+  const T zero = TypeFunc<T>::zero();
+  for (int i = blockIdx.x * blockDim.x + threadIdx.x; i - lane_id < size; i += stride) {
+    T t = (i < size) ? bottom[i] : zero;
+    bool pos = (i < size) && (t > zero);
+    unsigned int ballot = __ballot_sync(0xFFFFFFFF, pos);
+    if (lane_id == 0) mask[i / kWarpSize] = ballot;
+    if (i < size) top[i] = pos ? t : zero;
+  }
+}
+
+template <typename T>
+__global__ void backward_relu_mask_kernel(T* bottom, const T* top, const unsigned int* mask,
+                                          int size) {
+  constexpr int kWarpSize = 32;
+  const T zero = TypeFunc<T>::zero();
+  for (int i = blockIdx.x * blockDim.x + threadIdx.x; i < size; i += blockDim.x * gridDim.x) {
+    bool pos = (mask[i / kWarpSize] >> (i % kWarpSize)) & 1u;
+    bottom[i] = pos ? __ldg(top + i) : zero;
+  }
+}
+
 __global__ void backward_half2_relu_kernel(__half* bottom, const __half* top, int size) {
   const __half2 zero = TypeFunc<__half2>::zero();
   __half2* bottom2 = reinterpret_cast<__half2*>(bottom);
@@ -68,16 +96,39 @@ ReluLayer<T>::ReluLayer(const Tensor2<T>& in_tensor, const Tensor2<T>& out_tenso
   out_tensors_.push_back(out_tensor);
 }
 
+template <typename T>
+ReluLayer<T>::ReluLayer(const Tensor2<T>& in_tensor, const Tensor2<T>& out_tensor,
+                        const Tensor2<unsigned int>& mask_tensor,
+                        const std::shared_ptr<GPUResource>& gpu_resource)
+    : Layer(gpu_resource) {
+  assert(in_tensor.get_num_elements() == out_tensor.get_num_elements());
+  assert(in_tensor.get_num_elements() % 2 == 0);
+  assert(mask_tensor.get_num_elements() >= (in_tensor.get_num_elements() + 31) / 32);
+
+  in_tensors_.push_back(in_tensor);
+  out_tensors_.push_back(out_tensor);
+  mask_tensor_ = mask_tensor;
+  in_place_ = true;
+}
+
 template <typename T>
 void ReluLayer<T>::fprop(bool is_train) {
   CudaDeviceContext context(get_device_id());
 
   int len = in_tensors_[0].get_num_elements();
 
-  auto fop = [] __device__(T in) { return (in > T(0)) ? in : T(0); };
-
-  MLCommon::LinAlg::unaryOp(out_tensors_[0].get_ptr(), in_tensors_[0].get_ptr(), len, fop,
-                            get_gpu().get_stream());
+  if (in_place_) {
+    const size_t BLOCK_DIM = 1024;
+    const size_t MAX_GRID_DIM = 1024;
+    const size_t grid_dim = std::min((len - 1) / BLOCK_DIM + 1, MAX_GRID_DIM);
+    forward_relu_mask_kernel<<<grid_dim, BLOCK_DIM, 0, get_gpu().get_stream()>>>(
+        out_tensors_[0].get_ptr(), in_tensors_[0].get_ptr(), mask_tensor_.get_ptr(), len);
+  } else {
+    auto fop = [] __device__(T in) { return (in > T(0)) ? in : T(0); };
+
+    MLCommon::LinAlg::unaryOp(out_tensors_[0].get_ptr(), in_tensors_[0].get_ptr(), len, fop,
+                              get_gpu().get_stream());
+  }
 
 #ifndef NDEBUG
   cudaDeviceSynchronize();
@@ -91,10 +142,18 @@ void ReluLayer<T>::bprop() {
 
   int len = in_tensors_[0].get_num_elements();
 
-  auto bop = [] __device__(T d_out, T d_in) { return (d_in > T(0)) ? d_out : T(0); };
-
-  MLCommon::LinAlg::binaryOp(in_tensors_[0].get_ptr(), out_tensors_[0].get_ptr(),
-                             in_tensors_[0].get_ptr(), len, bop, get_gpu().get_stream());
+  if (in_place_) {
+    const size_t BLOCK_DIM = 1024;
+    const size_t MAX_GRID_DIM = 1024;
+    const size_t grid_dim = std::min((len - 1) / BLOCK_DIM + 1, MAX_GRID_DIM);
+    backward_relu_mask_kernel<<<grid_dim, BLOCK_DIM, 0, get_gpu().get_stream()>>>(
+        in_tensors_[0].get_ptr(), out_tensors_[0].get_ptr(), mask_tensor_.get_ptr(), len);
+  } else {
+    auto bop = [] __device__(T d_out, T d_in) { return (d_in > T(0)) ? d_out : T(0); };
+
+    MLCommon::LinAlg::binaryOp(in_tensors_[0].get_ptr(), out_tensors_[0].get_ptr(),
+                               in_tensors_[0].get_ptr(), len, bop, get_gpu().get_stream());
+  }
 
 #ifndef NDEBUG
   cudaDeviceSynchronize();
@@ -114,16 +173,41 @@ ReluLayer<__half>::ReluLayer(const Tensor2<__half>& bottom_tensor,
   top_tensor_ = top_tensor;
 }
 
+ReluLayer<__half>::ReluLayer(const Tensor2<__half>& bottom_tensor,
+                             const Tensor2<__half>& top_tensor,
+                             const Tensor2<unsigned int>& mask_tensor,
+                             const std::shared_ptr<GPUResource>& gpu_resource)
+    : Layer(gpu_resource) {
+  assert(get_size_from_dims(bottom_tensor.get_dimensions()) ==
+         get_size_from_dims(top_tensor.get_dimensions()));
+  assert(get_size_from_dims(bottom_tensor.get_dimensions()) % 2 == 0);
+  assert(mask_tensor.get_num_elements() >=
+         (get_size_from_dims(bottom_tensor.get_dimensions()) + 31) / 32);
+
+  bottom_tensor_ = bottom_tensor;
+  top_tensor_ = top_tensor;
+  mask_tensor_ = mask_tensor;
+  in_place_ = true;
+}
+
 void ReluLayer<__half>::fprop(bool is_train) {
   CudaDeviceContext context(get_device_id());
 
   const size_t BLOCK_DIM = 1024;
   const size_t MAX_GRID_DIM = 1024;
 
-  const size_t size = bottom_tensor_.get_num_elements() / 2;
-  const size_t grid_dim = std::min((size - 1) / BLOCK_DIM + 1, MAX_GRID_DIM);
-  forward_half2_relu_kernel<<<grid_dim, BLOCK_DIM, 0, get_gpu().get_stream()>>>(
-      top_tensor_.get_ptr(), bottom_tensor_.get_ptr(), size);
+  if (in_place_) {
+    const size_t size = bottom_tensor_.get_num_elements();
+    const size_t grid_dim = std::min((size - 1) / BLOCK_DIM + 1, MAX_GRID_DIM);
+    forward_relu_mask_kernel<<<grid_dim, BLOCK_DIM, 0, get_gpu().get_stream()>>>(
+        top_tensor_.get_ptr(), bottom_tensor_.get_ptr(), mask_tensor_.get_ptr(),
+        static_cast<int>(size));
+  } else {
+    const size_t size = bottom_tensor_.get_num_elements() / 2;
+    const size_t grid_dim = std::min((size - 1) / BLOCK_DIM + 1, MAX_GRID_DIM);
+    forward_half2_relu_kernel<<<grid_dim, BLOCK_DIM, 0, get_gpu().get_stream()>>>(
+        top_tensor_.get_ptr(), bottom_tensor_.get_ptr(), size);
+  }
 
 #ifndef NDEBUG
   cudaDeviceSynchronize();
@@ -137,10 +221,18 @@ void ReluLayer<__half>::bprop() {
   const size_t BLOCK_DIM = 1024;
   const size_t MAX_GRID_DIM = 1024;
 
-  const size_t size = bottom_tensor_.get_num_elements() / 2;
-  const size_t grid_dim = std::min((size - 1) / BLOCK_DIM + 1, MAX_GRID_DIM);
-  backward_half2_relu_kernel<<<grid_dim, BLOCK_DIM, 0, get_gpu().get_stream()>>>(
-      bottom_tensor_.get_ptr(), top_tensor_.get_ptr(), size);
+  if (in_place_) {
+    const size_t size = bottom_tensor_.get_num_elements();
+    const size_t grid_dim = std::min((size - 1) / BLOCK_DIM + 1, MAX_GRID_DIM);
+    backward_relu_mask_kernel<<<grid_dim, BLOCK_DIM, 0, get_gpu().get_stream()>>>(
+        bottom_tensor_.get_ptr(), top_tensor_.get_ptr(), mask_tensor_.get_ptr(),
+        static_cast<int>(size));
+  } else {
+    const size_t size = bottom_tensor_.get_num_elements() / 2;
+    const size_t grid_dim = std::min((size - 1) / BLOCK_DIM + 1, MAX_GRID_DIM);
+    backward_half2_relu_kernel<<<grid_dim, BLOCK_DIM, 0, get_gpu().get_stream()>>>(
+        bottom_tensor_.get_ptr(), top_tensor_.get_ptr(), size);
+  }
 
 #ifndef NDEBUG
   cudaDeviceSynchronize();
@@ -15,6 +15,7 @@
  */
 
 #include <common.hpp>
+#include <cstdlib>
 #include <layers/reshape_layer.hpp>
 #include <utils.hpp>
 
@@ -87,6 +88,8 @@ ReshapeLayer<T>::ReshapeLayer(const Tensor2<T>& in_tensor, Tensor2<T>& out_tenso
         HCTR_OWN_THROW(Error_t::WrongInput, "Output tensor dimension is not supported.");
     }
 
+    zero_copy_view_ = in_tensor.get_buffer() == out_tensor.get_buffer();
+
     in_tensors_.push_back(in_tensor);
     out_tensors_.push_back(out_tensor);
 
@@ -116,7 +119,14 @@ ReshapeLayer<T>::ReshapeLayer(const Tensor2<T>& in_tensor, Tensor2<T>& out_tenso
 
     size_t in_dims_1 = selected.empty() ? in_dims[1] : n_active_slot_;
     std::vector<size_t> out_dims = {in_dims[0], in_dims_1 * in_dims[2]};
-    blobs_buff->reserve(out_dims, &out_tensor);
+    if (in_place_ && std::getenv("HCTR_ZERO_COPY_RESHAPE")) {
+      // A pure reshape only changes the dimensions, so the output can alias the input buffer
+      // and fprop/bprop become metadata-only.
+      out_tensor = in_tensor.reshape(out_dims);
+      zero_copy_view_ = true;
+    } else {
+      blobs_buff->reserve(out_dims, &out_tensor);
+    }
 
     if (!in_place_) {
       unsigned int i = 0;
@@ -161,7 +171,9 @@ void ReshapeLayer<T>::prop_common(bool forward, bool is_train, cudaStream_t stre
   Tensor2<T>& out_tensor = out_tensors_[0];
 
   if (in_place_) {
-    if (forward) {
+    if (zero_copy_view_) {
+      // The output shares the input buffer; nothing to move.
+    } else if (forward) {
       HCTR_LIB_THROW(cudaMemcpyAsync(out_tensor.get_ptr(), in_tensor.get_ptr(),
                                      in_tensor.get_size_in_bytes(), cudaMemcpyDeviceToDevice,
                                      stream));
@@ -16,6 +16,7 @@
 
 #include <common.hpp>
 #include <cstdint>
+#include <cstdlib>
 #include <layers/slice_layer.hpp>
 #include <utils.cuh>
 #include <utils.hpp>
@@ -48,6 +49,36 @@ __global__ void slice_bwd_kernel(const T* const __restrict__ out, T* const __res
   }
 }
 
+constexpr int MAX_FUSED_SLICES = 8;
+
+template <typename T>
+struct SliceBwdFusedArgs {
+  const T* outs[MAX_FUSED_SLICES];
+  int2 slices[MAX_FUSED_SLICES];
+  int num_slices;
+};
+
+// Single pass over the input gradient: each element sums the contributions of every slice
+// covering its column and is written once, replacing the zero-fill pass plus one
+// read-modify-write pass per slice. With add_to_in set (aliased first output), the input
+// already holds that branch's gradient and the sum is accumulated on top of it.
+template <typename T>
+__global__ void slice_bwd_fused_kernel(T* const __restrict__ in, const SliceBwdFusedArgs<T> args,
+                                       const int2 in_dim, const bool add_to_in) {
+  for (int mi = blockIdx.x; mi < in_dim.x; mi += gridDim.x) {
+    for (int ni = threadIdx.x; ni < in_dim.y; ni += blockDim.x) {
+      T sum = add_to_in ? in[mi * in_dim.y + ni] : T(0);
+      for (int s = 0; s < args.num_slices; s++) {
+        const int2 slice = args.slices[s];
+        if (ni >= slice.x && ni < slice.x + slice.y) {
+          sum += args.outs[s][mi * slice.y + ni - slice.x];
+        }
+      }
+      in[mi * in_dim.y + ni] = sum;
+    }
+  }
+}
+
 }  // anonymous namespace
 
 template <typename T>
@@ -91,7 +122,16 @@ SliceLayer<T>::SliceLayer(const Tensor2<T>& in_tensor, Tensors2<T>& out_tensors,
       }
       size_t out_w = cur_max - cur_min;
       std::vector<size_t> out_dims = {height, out_w};
-      {
+      // Zero-copy fast path (HCTR_SLICE_ALIAS): when the first slice covers the whole input
+      // width, its output can alias the input tensor instead of owning a copy. This is the
+      // shape graph analysis generates when a tensor feeds several consumers. Only the first
+      // slice may alias; a second aliased branch would overwrite the first one's gradient.
+      if (out_tensors.empty() && cur_min == 0 && cur_max == in_w &&
+          std::getenv("HCTR_SLICE_ALIAS")) {
+        out_tensors.push_back(in_tensor);
+        out_tensors_.push_back(in_tensor);
+        alias_first_ = true;
+      } else {
         Tensor2<T> tensor;
         blobs_buff->reserve(out_dims, &tensor);
         out_tensors.push_back(tensor);
@@ -122,7 +162,8 @@ void SliceLayer<T>::fprop(bool is_train) {
   int2 in_dim = {static_cast<int>(in_tensor_.get_dimensions()[0]),
                  static_cast<int>(in_tensor_.get_dimensions()[1])};
   int grid_size = std::min(in_dim.x, n_blocks);
-  for (std::size_t i = 0; i < out_tensors_.size(); i++) {
+  // When the first output aliases the input, its data is already in place.
+  for (std::size_t i = alias_first_ ? 1 : 0; i < out_tensors_.size(); i++) {
     Tensor2<T>& out_tensor = out_tensors_[i];
     T* out = out_tensor.get_ptr();
     int2 slice = {slices_start_[i], static_cast<int>(out_tensor.get_dimensions()[1])};
@@ -142,8 +183,29 @@ void SliceLayer<T>::bprop() {
   int2 in_dim = {static_cast<int>(in_tensor_.get_dimensions()[0]),
                  static_cast<int>(in_tensor_.get_dimensions()[1])};
   int grid_size = std::min(in_dim.x, n_blocks);
-  initialize_array<<<n_blocks, block_size, 0, stream>>>(in, in_dim.x * in_dim.y, T(0));
-  for (std::size_t i = 0; i < out_tensors_.size(); i++) {
+  const std::size_t first = alias_first_ ? 1 : 0;
+  const std::size_t num_copied = out_tensors_.size() - first;
+  if (num_copied == 0) {
+    // Single aliased output: the input gradient is already in place.
+    return;
+  }
+  if (num_copied <= MAX_FUSED_SLICES) {
+    // Fused path: one pass writes each input gradient element once, instead of a zero-fill
+    // followed by one read-modify-write pass per slice.
+    SliceBwdFusedArgs<T> args{};
+    args.num_slices = static_cast<int>(num_copied);
+    for (std::size_t i = first; i < out_tensors_.size(); i++) {
+      args.outs[i - first] = out_tensors_[i].get_ptr();
+      args.slices[i - first] = {slices_start_[i],
+                                static_cast<int>(out_tensors_[i].get_dimensions()[1])};
+    }
+    slice_bwd_fused_kernel<<<grid_size, block_size, 0, stream>>>(in, args, in_dim, alias_first_);
+    return;
+  }
+  if (!alias_first_) {
+    initialize_array<<<n_blocks, block_size, 0, stream>>>(in, in_dim.x * in_dim.y, T(0));
+  }
+  for (std::size_t i = first; i < out_tensors_.size(); i++) {
     Tensor2<T>& out_tensor = out_tensors_[i];
     T* out = out_tensor.get_ptr();
     int2 slice = {slices_start_[i], static_cast<int>(out_tensor.get_dimensions()[1])};
@@ -31,6 +31,18 @@ __forceinline__ __device__ void atomic_global_sum_div(T val, T *acc, float div)
   return;
 }
 
+// Scales every gradient row by its sample's weight, see Loss::set_sample_weight_tensor. Launched
+// right behind do_compute on the same stream, so weighted training costs one sweep over dgrad
+// instead of duplicated samples in the data.
+template <typename T>
+__global__ void scale_dgrad_by_sample_weight_kernel(T *dgrad, const float *sample_weight,
+                                                    int batch_size, int feature_dim) {
+  const int i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i < batch_size * feature_dim) {
+    dgrad[i] = static_cast<float>(dgrad[i]) * sample_weight[i / feature_dim];
+  }
+}
+
 }  // namespace
 
 template <typename T>
@@ -100,6 +112,13 @@ void Loss<T>::compute(bool is_train, long long current_batchsize, float rterm) {
   do_compute(input, label, loss, current_batchsize, feature_dim, scaler_, rterm, label_weight,
              is_train, get_gpu().get_stream());
   if (is_train) {
+    if (sample_weight_tensor_.allocated() && current_batchsize > 0) {
+      const int BLOCK_SIZE = 256;
+      const int num_elems = current_batchsize * feature_dim;
+      scale_dgrad_by_sample_weight_kernel<<<(num_elems - 1) / BLOCK_SIZE + 1, BLOCK_SIZE, 0,
+                                            get_gpu().get_stream()>>>(
+          input, sample_weight_tensor_.get_ptr(), current_batchsize, feature_dim);
+    }
     // once current_batchsize < batch_size in train we set the rest dgrad to 0
     if (current_batchsize < batch_size) {
       HCTR_LIB_THROW(cudaMemsetAsync(input + current_batchsize * feature_dim, 0,
@@ -146,8 +165,9 @@ CrossEntropyLoss<T>::CrossEntropyLoss(const Tensor2<float> &label_tensor,
   const auto &label_dim = label_tensor.get_dimensions();
   int feature_dim = input_dim[1];
 
-  if (feature_dim != 2) {
-    HCTR_OWN_THROW(Error_t::WrongInput, "The feature dimension of CE loss input should be 2");
+  if (feature_dim < 2) {
+    HCTR_OWN_THROW(Error_t::WrongInput,
+                   "The feature dimension of CE loss input should be at least 2");
   }
   if (input_dim[0] != label_dim[0]) {
     HCTR_OWN_THROW(Error_t::WrongInput,
@@ -200,10 +220,81 @@ __global__ void CrossEntropy_Kernel(T *input, const float *label, float *cel_los
   }
 }
 
+// Fused softmax + cross-entropy for multi-class heads (feature_dim > 2): one block per sample
+// streams the logits (running max, then exp-sum), so no [batch, num_classes] probability tensor
+// is ever materialized, and the gradient overwrites the logits in the same launch. The label of
+// a sample is its target class index. The two-class case keeps the dedicated kernel above.
+template <typename T>
+__global__ void SoftmaxCrossEntropy_Kernel(T *input, const float *label, float *cel_loss,
+                                           int batch_size, int total_gpu_count, int num_classes,
+                                           float scaler, float rterm, float label_weight,
+                                           bool is_train) {
+  __shared__ float s_max;
+  __shared__ float s_sum;
+  __shared__ float s_target_logit;
+
+  if (blockIdx.x == 0 && threadIdx.x == 0) {
+    atomicAdd(cel_loss, rterm * label_weight);
+  }
+
+  for (int i = blockIdx.x; i < batch_size; i += gridDim.x) {
+    T *logits = input + (size_t)i * num_classes;
+    const int target = (int)label[i];
+
+    // Streaming max for numerical stability
+    float max_val = -1e30f;
+    for (int j = threadIdx.x; j < num_classes; j += blockDim.x) {
+      max_val = fmaxf(max_val, (float)logits[j]);
+    }
+    max_val = blockReduceMax(max_val);
+    if (threadIdx.x == 0) {
+      s_max = max_val;
+      s_target_logit = (float)logits[target];
+    }
+    __syncthreads();
+
+    // Streaming sum of exp(x - max); log-sum-exp needs no second materialized pass
+    float sum_exp = 0.0f;
+    for (int j = threadIdx.x; j < num_classes; j += blockDim.x) {
+      sum_exp += expf((float)logits[j] - s_max);
+    }
+    sum_exp = blockReduceSum(sum_exp);
+    if (threadIdx.x == 0) {
+      s_sum = sum_exp;
+    }
+    __syncthreads();
+
+    // Fused gradient (train) or probabilities (eval), overwriting the logits
+    for (int j = threadIdx.x; j < num_classes; j += blockDim.x) {
+      const float prob = expf((float)logits[j] - s_max) / s_sum;
+      if (is_train) {
+        logits[j] = (prob - (j == target ? 1.0f : 0.0f)) / batch_size * scaler / total_gpu_count;
+      } else {
+        logits[j] = prob;
+      }
+    }
+    if (threadIdx.x == 0) {
+      const float sample_loss = s_max + logf(s_sum) - s_target_logit;
+      atomicAdd(cel_loss, sample_loss / batch_size * label_weight);
+    }
+    __syncthreads();
+  }
+}
+
 template <typename T>
 void CrossEntropyLoss<T>::do_compute(T *input, const float *label, float *loss, int batch_size,
                                      int feature_dim, float scaler, float rterm, float label_weight,
                                      bool is_train, cudaStream_t stream) {
+  if (feature_dim > 2) {
+    if (batch_size > 0) {
+      HCTR_LIB_THROW(cudaMemsetAsync(loss, 0, sizeof(float), stream));
+      const int block_size = 256;
+      SoftmaxCrossEntropy_Kernel<<<batch_size, block_size, 0, stream>>>(
+          input, label, loss, batch_size, Loss<T>::get_total_gpu_count(), feature_dim, scaler,
+          rterm, label_weight, is_train);
+    }
+    return;
+  }
   int block_size = min(batch_size, 1024);
   size_t smem_size = block_size * sizeof(float);
   if (block_size > 0) {
@@ -280,6 +371,96 @@ void BinaryCrossEntropyLoss<T>::do_compute(T *input, const float *label, float *
   }
 }
 
+namespace {
+
+// Kernel-argument wrapper so the head descriptors travel by value with the launch instead of
+// through an extra H2D copy.
+template <typename T>
+struct FusedBCEHeadArray {
+  FusedBCEHead<T> heads[MAX_FUSED_BCE_HEADS];
+};
+
+// One pass over all heads: blockIdx.y selects the head, each thread handles four consecutive
+// samples of it. Gradients overwrite the inputs and every head's scalar loss is accumulated into
+// its own loss tensor, exactly as the per-head BinaryCrossEntropy_Kernel would.
+template <typename T>
+__global__ void FusedBinaryCrossEntropy_Kernel(FusedBCEHeadArray<T> head_array, int batch_size,
+                                               float scaler, int total_gpu_count, float rterm,
+                                               bool is_train) {
+  const FusedBCEHead<T> head = head_array.heads[blockIdx.y];
+  int tid = blockIdx.x * blockDim.x + threadIdx.x;
+  float val = 0.0f;
+#pragma unroll
+  for (int k = 0; k < 4; ++k) {
+    const int i = 4 * tid + k;
+    if (i < batch_size) {
+      const float x = head.input[i];
+      const float y = head.label[i];
+      if (x >= 0) {
+        float exp_neg_x = exp(-x);
+        head.input[i] = is_train ? ((1 - y) - exp_neg_x / (1 + exp_neg_x)) * scaler /
+                                       (float)batch_size / total_gpu_count
+                                 : 1 / (1 + exp_neg_x);
+        val += x * (1 - y) + log(1 + exp_neg_x);
+      } else {
+        float exp_x = exp(x);
+        head.input[i] = is_train
+                            ? (-y + exp_x / (1 + exp_x)) * scaler / (float)batch_size /
+                                  total_gpu_count
+                            : exp_x / (exp_x + 1);
+        val += -x * y + log(1 + exp_x);
+      }
+    }
+  }
+  float ret = blockReduceSum(val) * head.label_weight;
+  if (threadIdx.x == 0 && 4 * blockIdx.x * blockDim.x < batch_size) {
+    ret = (blockIdx.x == 0) ? ret / batch_size + rterm : ret / batch_size;
+    atomicAdd(head.loss, ret);
+  }
+}
+
+}  // namespace
+
+template <typename T>
+void fused_bce_compute(const std::vector<FusedBCEHead<T>>& heads, long long current_batchsize,
+                       float scaler, int total_gpu_count, float rterm, bool is_train,
+                       cudaStream_t stream) {
+  if (heads.empty() || static_cast<int>(heads.size()) > MAX_FUSED_BCE_HEADS) {
+    HCTR_OWN_THROW(Error_t::WrongInput, "fused_bce_compute: invalid number of heads");
+  }
+  const int batch_size = heads[0].batch_size;
+  FusedBCEHeadArray<T> head_array;
+  for (size_t i = 0; i < heads.size(); ++i) {
+    head_array.heads[i] = heads[i];
+    HCTR_LIB_THROW(cudaMemsetAsync(heads[i].loss, 0, sizeof(float), stream));
+  }
+  const int block_size = 512;
+  dim3 grid((current_batchsize + 4 * block_size - 1) / (4 * block_size), heads.size());
+  if (grid.x > 0) {
+    FusedBinaryCrossEntropy_Kernel<<<grid, block_size, 0, stream>>>(
+        head_array, static_cast<int>(current_batchsize), scaler, total_gpu_count, rterm, is_train);
+  }
+  // Mirror Loss::compute(): an incomplete last batch leaves stale values past current_batchsize,
+  // zero them so bprop sees no gradient there.
+  if (is_train && current_batchsize < batch_size) {
+    for (const auto& head : heads) {
+      HCTR_LIB_THROW(cudaMemsetAsync(head.input + current_batchsize, 0,
+                                     (batch_size - current_batchsize) * sizeof(T), stream));
+    }
+  }
+}
+
+template <typename T>
+FusedBCEHead<T> BinaryCrossEntropyLoss<T>::get_fused_head(bool is_train) {
+  FusedBCEHead<T> head;
+  head.input = Loss<T>::get_input_tensors(is_train)[0].get_ptr();
+  head.label = Loss<T>::get_label_tensors(is_train)[0].get_ptr();
+  head.loss = Loss<T>::get_loss_tensors()[0].get_ptr();
+  head.label_weight = Loss<T>::get_label_weight();
+  head.batch_size = Loss<T>::get_input_tensors(is_train)[0].get_dimensions()[0];
+  return head;
+}
+
 __forceinline__ __device__ __host__ float cross_entropy_loss(float x, float y) {
   float loss = 0.f;
   if (x >= 0) {
@@ -397,5 +578,9 @@ template class CrossEntropyLoss<__half>;
 template class CrossEntropyLoss<float>;
 template class BinaryCrossEntropyLoss<__half>;
 template class BinaryCrossEntropyLoss<float>;
+template void fused_bce_compute<__half>(const std::vector<FusedBCEHead<__half>>&, long long, float,
+                                        int, float, bool, cudaStream_t);
+template void fused_bce_compute<float>(const std::vector<FusedBCEHead<float>>&, long long, float,
+                                       int, float, bool, cudaStream_t);
 
 }  // namespace HugeCTR
@@ -16,6 +16,7 @@
 
 #include <omp.h>
 
+#include <cstdlib>
 #include <cub/cub.cuh>
 #include <diagnose.hpp>
 #include <general_buffer2.hpp>
@@ -92,6 +93,19 @@ void copy_all<__half>(float* y_pred, float* y_label, __half* x_pred, float* x_la
   copy_all_kernel<<<grid, block, 0, stream>>>(y_pred, y_label, x_pred, x_label, num_elems);
 }
 
+template <typename PredType>
+__global__ void sketch_histogram_kernel(const PredType* preds, const float* labels, int num_elems,
+                                        int num_bins, CountType* hist) {
+  // hist holds num_bins counters for the positives followed by num_bins for the negatives
+  int tid_base = blockIdx.x * blockDim.x + threadIdx.x;
+  for (int tid = tid_base; tid < num_elems; tid += blockDim.x * gridDim.x) {
+    float pred = TypeConvertFunc<float, PredType>::convert(preds[tid]);
+    int bin = min(max(static_cast<int>(pred * num_bins), 0), num_bins - 1);
+    int offset = labels[tid] > 0.5f ? bin : num_bins + bin;
+    atomicAdd(&hist[offset], 1u);
+  }
+}
+
 __global__ void init_classes_kernel(int* classes, size_t num_valid_samples, size_t num_classes) {
   size_t tid_base = blockIdx.x * blockDim.x + threadIdx.x;
   for (size_t tid = tid_base; tid < num_valid_samples * num_classes;
@@ -671,6 +685,35 @@ AUC<T>::AUC(int batch_size_per_gpu, int n_batches, int label_dim,
   const size_t num_streams = std::min(4lu, num_classes_);
   auto& all_device_list = resource_manager_->get_local_gpu_device_id_list();
 
+  async_local_reduce_ = std::getenv("HCTR_ASYNC_AUC") != nullptr;
+  if (async_local_reduce_) {
+    HCTR_LOG_S(INFO, ROOT) << "HCTR_ASYNC_AUC is set. The AUC local reduce runs on a "
+                              "low-priority stream and overlaps with the next eval batch."
+                           << std::endl;
+    side_streams_.resize(num_local_gpus_);
+    fork_events_.resize(num_local_gpus_);
+    join_events_.resize(num_local_gpus_);
+  }
+
+  if (const char* sketch_env = std::getenv("HCTR_AUC_SKETCH_BINS")) {
+    if (num_classes_ > 1) {
+      HCTR_LOG_S(WARNING, ROOT) << "HCTR_AUC_SKETCH_BINS is ignored for multi-label AUC."
+                                << std::endl;
+    } else {
+      sketch_num_bins_ = atoi(sketch_env);
+      if (sketch_num_bins_ <= 0) {
+        sketch_num_bins_ = num_bins_per_gpu_;
+      }
+      use_sketch_ = true;
+      sketch_hist_.resize(num_local_gpus_);
+      HCTR_LOG_S(INFO, ROOT) << "HCTR_AUC_SKETCH_BINS is set. AUC is approximated from "
+                             << sketch_num_bins_
+                             << "-bin prediction histograms merged with one all-reduce; the "
+                                "error is bounded by the bin width "
+                             << 1.0 / sketch_num_bins_ << "." << std::endl;
+    }
+  }
+
   size_t max_num_local_samples = (batch_size_per_gpu_ * n_batches_);
   for (int i = 0; i < num_local_gpus_; i++) {
     int device_id = resource_manager_->get_local_gpu(i)->get_device_id();
@@ -680,6 +723,19 @@ AUC<T>::AUC(int batch_size_per_gpu, int n_batches, int label_dim,
     for (auto& stream : streams_[i]) {
       HCTR_LIB_THROW(cudaStreamCreate(&stream));
     }
+    if (use_sketch_) {
+      size_t hist_size = 2 * sketch_num_bins_ * sizeof(CountType);
+      HCTR_LIB_THROW(cudaMalloc(&sketch_hist_[i], hist_size));
+      HCTR_LIB_THROW(cudaMemset(sketch_hist_[i], 0, hist_size));
+    }
+    if (async_local_reduce_) {
+      int least_priority, greatest_priority;
+      HCTR_LIB_THROW(cudaDeviceGetStreamPriorityRange(&least_priority, &greatest_priority));
+      HCTR_LIB_THROW(cudaStreamCreateWithPriority(&side_streams_[i], cudaStreamNonBlocking,
+                                                  least_priority));
+      HCTR_LIB_THROW(cudaEventCreateWithFlags(&fork_events_[i], cudaEventDisableTiming));
+      HCTR_LIB_THROW(cudaEventCreateWithFlags(&join_events_[i], cudaEventDisableTiming));
+    }
     per_class_aucs_.resize(num_classes_);
 
     std::vector<int> peers;
@@ -733,13 +789,36 @@ void AUC<T>::local_reduce(int local_gpu_id, RawMetricMap raw_metrics) {
   auto stream = resource_manager_->get_local_gpu(local_gpu_id)->get_stream();
   int num_sms = resource_manager_->get_local_gpu(local_gpu_id)->get_sm_count();
 
+  if (use_sketch_) {
+    // Only the histogram counters are kept; the raw samples are never buffered or exchanged.
+    dim3 grid(num_sms * 2, 1, 1);
+    dim3 block(1024, 1, 1);
+    sketch_histogram_kernel<<<grid, block, 0, stream>>>(
+        pred_tensor.get_ptr(), label_tensor.get_ptr(), num_valid_samples, sketch_num_bins_,
+        sketch_hist_[local_gpu_id]);
+    offset += num_valid_samples;
+    if (local_gpu_id == 0) {
+      num_total_samples_ += current_batch_size_;
+    }
+    return;
+  }
+
+  cudaStream_t work_stream = stream;
+  if (async_local_reduce_) {
+    // Fork: the side stream picks up the raw predictions and labels once the eval stream has
+    // produced them, while the eval stream continues with the next batch.
+    HCTR_LIB_THROW(cudaEventRecord(fork_events_[local_gpu_id], stream));
+    HCTR_LIB_THROW(cudaStreamWaitEvent(side_streams_[local_gpu_id], fork_events_[local_gpu_id], 0));
+    work_stream = side_streams_[local_gpu_id];
+  }
+
   if (num_classes_ == 1) {
     copy_all<T>(st.fst(0).d_preds() + offset, st.fst(0).d_labels() + offset, pred_tensor.get_ptr(),
-                label_tensor.get_ptr(), num_valid_samples, num_sms, stream);
+                label_tensor.get_ptr(), num_valid_samples, num_sms, work_stream);
   } else {
     size_t input_size = num_valid_samples * num_classes_;
     if (st.realloc_local_reduce_storage(input_size)) {
-      init_classes(st.d_lr_class_ids(), num_valid_samples, num_classes_, num_sms, stream);
+      init_classes(st.d_lr_class_ids(), num_valid_samples, num_classes_, num_sms, work_stream);
     }
 
     if (std::is_same<T, float>::value) {
@@ -748,17 +827,18 @@ void AUC<T>::local_reduce(int local_gpu_id, RawMetricMap raw_metrics) {
             workspace, size, st.d_lr_class_ids(), st.d_lr_sorted_class_ids(),
             (int*)pred_tensor.get_ptr(), (int*)st.d_lr_sorted_preds(), input_size, 0,
             8,  // begin_bit, end_bit
-            stream);
+            work_stream);
       });
     } else {
-      copy_pred<T>(st.d_lr_unsorted_preds(), pred_tensor.get_ptr(), input_size, num_sms, stream);
+      copy_pred<T>(st.d_lr_unsorted_preds(), pred_tensor.get_ptr(), input_size, num_sms,
+                   work_stream);
 
       CUB_allocate_and_launch(st, 0, [&](void* workspace, size_t& size) {
         return cub::DeviceRadixSort::SortPairs(
             workspace, size, st.d_lr_class_ids(), st.d_lr_sorted_class_ids(),
             (int*)st.d_lr_unsorted_preds(), (int*)st.d_lr_sorted_preds(), input_size, 0,
             8,  // begin_bit, end_bit
-            stream);
+            work_stream);
       });
     }
 
@@ -767,9 +847,17 @@ void AUC<T>::local_reduce(int local_gpu_id, RawMetricMap raw_metrics) {
           workspace, size, st.d_lr_class_ids(), st.d_lr_sorted_class_ids(),
           (int*)label_tensor.get_ptr(), (int*)st.d_lr_sorted_labels(), input_size, 0,
           8,  // begin_bit, end_bit
-          stream);
+          work_stream);
     });
-    HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+    if (async_local_reduce_) {
+      // The copy streams wait on the device instead of blocking the host until the sort is done.
+      HCTR_LIB_THROW(cudaEventRecord(join_events_[local_gpu_id], work_stream));
+      for (auto& copy_stream : streams_[local_gpu_id]) {
+        HCTR_LIB_THROW(cudaStreamWaitEvent(copy_stream, join_events_[local_gpu_id], 0));
+      }
+    } else {
+      HCTR_LIB_THROW(cudaStreamSynchronize(work_stream));
+    }
 
     size_t num_streams = streams_[local_gpu_id].size();
     for (size_t class_id = 0; class_id < num_classes_; class_id++) {
@@ -784,6 +872,15 @@ void AUC<T>::local_reduce(int local_gpu_id, RawMetricMap raw_metrics) {
     }
   }
 
+  if (async_local_reduce_) {
+    // Join: the next eval forward pass overwrites the raw tensors, so the eval stream waits
+    // until the reduction has consumed them. Work queued on the internal buffers keeps running.
+    if (num_classes_ == 1) {
+      HCTR_LIB_THROW(cudaEventRecord(join_events_[local_gpu_id], work_stream));
+    }
+    HCTR_LIB_THROW(cudaStreamWaitEvent(stream, join_events_[local_gpu_id], 0));
+  }
+
   offset += num_valid_samples;
 
   if (local_gpu_id == 0) {
@@ -850,6 +947,15 @@ float AUC<T>::finalize_metric_per_gpu(int local_id) {
   int device_id = gpu_resource->get_device_id();
   CudaDeviceContext context(device_id);
 
+  if (async_local_reduce_) {
+    // Drain the side stream so every batch has landed in the internal buffers.
+    HCTR_LIB_THROW(cudaStreamSynchronize(side_streams_[local_id]));
+  }
+
+  if (use_sketch_) {
+    return finalize_sketch_metric(local_id);
+  }
+
   float result = 0.0;
   if (num_classes_ == 1) {
     result = finalize_class_metric(st.fst(0).d_preds(), st.fst(0).d_labels(), local_id,
@@ -871,6 +977,37 @@ float AUC<T>::finalize_metric_per_gpu(int local_id) {
   return result;
 }
 
+template <typename T>
+float AUC<T>::finalize_sketch_metric(int local_id) {
+  auto gpu_resource = resource_manager_->get_local_gpu(local_id).get();
+  auto& stream = gpu_resource->get_stream();
+  CountType* hist = sketch_hist_[local_id];
+  const int num_counters = 2 * sketch_num_bins_;
+
+  // One small all-reduce merges the per-GPU histograms instead of redistributing the samples.
+  metric_comm::allreduce(hist, hist, num_counters, gpu_resource, stream);
+
+  std::vector<CountType> h_hist(num_counters);
+  HCTR_LIB_THROW(cudaMemcpyAsync(h_hist.data(), hist, num_counters * sizeof(CountType),
+                                 cudaMemcpyDeviceToHost, stream));
+  HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+  HCTR_LIB_THROW(cudaMemsetAsync(hist, 0, num_counters * sizeof(CountType), stream));
+
+  // Pairs within one bin count as ties; the error is bounded by the bin width.
+  double weighted = 0.0, cum_neg = 0.0, total_pos = 0.0;
+  for (int bin = 0; bin < sketch_num_bins_; bin++) {
+    double pos = h_hist[bin];
+    double neg = h_hist[sketch_num_bins_ + bin];
+    weighted += pos * (cum_neg + 0.5 * neg);
+    cum_neg += neg;
+    total_pos += pos;
+  }
+  if (total_pos == 0.0 || cum_neg == 0.0) {
+    return 0.5f;
+  }
+  return static_cast<float>(weighted / (total_pos * cum_neg));
+}
+
 template <typename T>
 float AUC<T>::finalize_class_metric(float* d_preds, float* d_labels, int local_id,
                                     size_t num_local_samples) {
@@ -1713,15 +1850,14 @@ SMAPE<T>::SMAPE(int batch_size_per_gpu, const std::shared_ptr<ResourceManager>&
       resource_manager_(resource_manager),
       num_local_gpus_(resource_manager_->get_local_gpu_count()),
       error_(resource_manager_->get_local_gpu_count()),
-      checked_local_(std::vector<int>(resource_manager->get_local_gpu_count(), 0)),
+      checked_local_(std::vector<size_t>(resource_manager->get_local_gpu_count(), 0)),
       error_local_(std::vector<float>(resource_manager->get_local_gpu_count(), 0)),
-      checked_global_(0),
-      error_global_(0),
       n_batches_(0) {
   for (int i = 0; i < num_local_gpus_; i++) {
     int device_id = resource_manager_->get_local_gpu(i)->get_device_id();
     CudaDeviceContext context(device_id);
     HCTR_LIB_THROW(cudaMalloc((void**)(&(error_[i])), sizeof(float)));
+    HCTR_LIB_THROW(cudaMemset(error_[i], 0, sizeof(float)));
   }
 }
 
@@ -1764,72 +1900,69 @@ void SMAPE<T>::local_reduce(int local_gpu_id, RawMetricMap raw_metrics) {
   dim3 grid(160, 1, 1);
   dim3 block(1024, 1, 1);
 
-  cudaMemsetAsync(error_[local_gpu_id], 0, sizeof(float), local_gpu->get_stream());
+  // Accumulate this batch's error into the per-GPU running sum. Partial statistics are only
+  // merged across GPUs and ranks in finalize_metric(), so the per-batch path has no host
+  // synchronization and no inter-node traffic.
   collect_error<T><<<grid, block, 0, local_gpu->get_stream()>>>(
       pred_tensor.get_ptr(), label_tensor.get_ptr(), num_valid_samples, error_[local_gpu_id]);
 
-  checked_local_[local_gpu_id] = num_valid_samples;
-  HCTR_LIB_THROW(cudaMemcpyAsync(&error_local_[local_gpu_id], error_[local_gpu_id], sizeof(float),
-                                 cudaMemcpyDeviceToHost, local_gpu->get_stream()));
+  checked_local_[local_gpu_id] += num_valid_samples;
 }
 
 template <typename T>
 void SMAPE<T>::global_reduce(int n_nets) {
-  int checked_inter = 0;
-  float error_inter = 0;
+  // Per-rank partial sums stay on device until finalize_metric()
+  n_batches_++;
+}
 
-  for (auto& error_local : error_local_) {
-    error_inter += error_local;
-  }
-  for (auto& checked_local : checked_local_) {
-    checked_inter += checked_local;
+template <typename T>
+float SMAPE<T>::finalize_metric() {
+  float error_inter = 0.0f;
+  size_t checked_inter = 0;
+  for (int i = 0; i < num_local_gpus_; i++) {
+    const auto& local_gpu = resource_manager_->get_local_gpu(i);
+    CudaDeviceContext context(local_gpu->get_device_id());
+    HCTR_LIB_THROW(cudaMemcpyAsync(&error_local_[i], error_[i], sizeof(float),
+                                   cudaMemcpyDeviceToHost, local_gpu->get_stream()));
+    HCTR_LIB_THROW(cudaStreamSynchronize(local_gpu->get_stream()));
+    HCTR_LIB_THROW(cudaMemsetAsync(error_[i], 0, sizeof(float), local_gpu->get_stream()));
+
+    error_inter += error_local_[i];
+    checked_inter += checked_local_[i];
+    checked_local_[i] = 0;
   }
 
 #ifdef ENABLE_MPI
   if (resource_manager_->get_num_process() > 1) {
     float error_reduced = 0;
-    int checked_reduced = 0;
+    unsigned long long checked_send = checked_inter;
+    unsigned long long checked_reduced = 0;
     HCTR_MPI_THROW(
         MPI_Reduce(&error_inter, &error_reduced, 1, MPI_FLOAT, MPI_SUM, 0, MPI_COMM_WORLD));
-    HCTR_MPI_THROW(
-        MPI_Reduce(&checked_inter, &checked_reduced, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD));
+    HCTR_MPI_THROW(MPI_Reduce(&checked_send, &checked_reduced, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM,
+                              0, MPI_COMM_WORLD));
     error_inter = error_reduced;
     checked_inter = checked_reduced;
   }
 #endif
 
-  error_global_ += error_inter;
-  checked_global_ += checked_inter;
-
-  n_batches_++;
-}
-
-template <typename T>
-float SMAPE<T>::finalize_metric() {
   float ret = 0.0f;
   if (resource_manager_->is_master_process()) {
-    if (n_batches_) {
-      ret = ((float)error_global_) / (float)(checked_global_);
+    if (n_batches_ and checked_inter) {
+      ret = error_inter / (float)checked_inter;
     }
   }
 #ifdef ENABLE_MPI
   HCTR_MPI_THROW(MPI_Barrier(MPI_COMM_WORLD));
   HCTR_MPI_THROW(MPI_Bcast(&ret, 1, MPI_FLOAT, 0, MPI_COMM_WORLD));
 #endif
-  error_global_ = 0;
-  checked_global_ = 0;
-  for (auto& error_local : error_local_) {
-    error_local = 0;
-  }
-  for (auto& checked_local : checked_local_) {
-    checked_local = 0;
-  }
   n_batches_ = 0;
   return ret;
 }
 
 template <typename T, ReallocType_t U>
-ReallocBuffer<T, U>::ReallocBuffer() : num_elements_(0), ptr_(nullptr) {
+ReallocBuffer<T, U>::ReallocBuffer()
+    : num_elements_(0), ptr_(nullptr), va_base_(0), va_reserved_(0) {
   CUdevice device;
   HCTR_LIB_THROW(cudaGetDevice(&device));
 
@@ -1899,39 +2032,32 @@ void ReallocBuffer<T, U>::realloc_ptr_mmap(void** ptr, size_t old_size, size_t n
   size_t reserve_size = new_size - old_size;
   MMAP_DEBUG("Old %lu New %lu Reserve %lu bytes\n", old_size, new_size, reserve_size);
 
-  // First step: create the neccessary virtual memory range
-  // Second step: create physical memory rchunk and perform VM -> PM mapping
-  // Most of the complexity is in first step when old_size != 0
-  // Second step is common across different scenarios in first step
-
-  // Physical memory handle
-  CUmemGenericAllocationHandle allocHandle;
-  CUdeviceptr new_ptr = 0;
-  if (old_size == 0) {
-    // Reserve a virtual address range
-    HCTR_LIB_THROW(cuMemAddressReserve(&new_ptr, reserve_size, 0, 0, 0));
-    vm_ranges_.push_back({new_ptr, reserve_size});
-    *ptr = (void*)new_ptr;
-  } else {
-    // Try to reserve virtual memory at the end of old ptr
-    const CUresult status =
-        cuMemAddressReserve(&new_ptr, reserve_size, 0, (CUdeviceptr)((uint64_t)*ptr + old_size), 0);
-
-    if ((status != CUDA_SUCCESS) || ((void*)new_ptr != (void*)((uint64_t)*ptr + old_size))) {
-      // We couldn't get the address we wanted, so fall back to the slow path
-      MMAP_DEBUG("Failed to extend VM range\n");
-
-      // Don’t leak new_ptr if you got one
-      if (new_ptr) {
-        HCTR_LIB_THROW(cuMemAddressFree(new_ptr, reserve_size));
-      }
-
-      // Now reserve the new, bigger VA range
-      HCTR_LIB_THROW(cuMemAddressReserve(&new_ptr, new_size, 0, 0, 0));
+  // First step: make sure [va_base_, va_base_ + new_size) is backed by a virtual address range.
+  // Virtual address space is plentiful, so we reserve far more of it than requested upfront;
+  // physical memory is only committed chunk by chunk as the buffer actually grows.
+  // Second step: create a new physical memory chunk and map it right behind the mapped prefix.
+  // As long as growth stays within the reservation, the first step is a no-op, so growing is
+  // O(new chunks mapped) with zero copies.
+
+  if (new_size > va_reserved_) {
+    // Reservation exhausted (or first allocation): reserve a new VA range, generously sized and
+    // doubled on every exhaustion
+    size_t va_size = std::max(new_size, std::max(2 * va_reserved_, va_reserve_default_));
+    get_aligned_size(va_size);
+
+    CUdeviceptr new_base = 0;
+    if (cuMemAddressReserve(&new_base, va_size, 0, 0, 0) != CUDA_SUCCESS) {
+      // The generous reservation was not granted, fall back to the minimal one
+      MMAP_DEBUG("Failed to reserve %lu bytes of VA space, retrying with %lu\n", va_size, new_size);
+      va_size = new_size;
+      HCTR_LIB_THROW(cuMemAddressReserve(&new_base, va_size, 0, 0, 0));
+    }
 
-      // Map first part of new VA range to existing physical memory chunks, enabling their access
+    if (old_size) {
+      // Map the beginning of the new VA range to the existing physical memory chunks. This only
+      // rewrites page tables, the data itself is not copied.
       std::vector<std::pair<CUdeviceptr, size_t>> new_mmap_ranges;
-      CUdeviceptr tmp = new_ptr;
+      CUdeviceptr tmp = new_base;
       MMAP_DEBUG("Remapping VM -> PM\n");
       for (auto handle : pm_handles_) {
         auto size = handle.second;
@@ -1942,7 +2068,7 @@ void ReallocBuffer<T, U>::realloc_ptr_mmap(void** ptr, size_t old_size, size_t n
 
       // Set access permissions
       HCTR_LIB_THROW(
-          cuMemSetAccess(new_ptr, old_size, &(access_desc_->at(0)), access_desc_->size()));
+          cuMemSetAccess(new_base, old_size, &(access_desc_->at(0)), access_desc_->size()));
 
       // Unmap old mappings
       for (auto range : mmap_ranges_) {
@@ -1950,25 +2076,25 @@ void ReallocBuffer<T, U>::realloc_ptr_mmap(void** ptr, size_t old_size, size_t n
       }
       // Clear old mappings, save new mappings
       mmap_ranges_ = new_mmap_ranges;
+    }
 
-      // Free up previous VA allocations
-      MMAP_DEBUG("Freeing %lu old VM allocations\n", vm_ranges_.size());
-      for (auto range : vm_ranges_) {
-        HCTR_LIB_THROW(cuMemAddressFree(range.first, range.second));
-      }
-
-      // Save new VA allocation information
-      vm_ranges_.clear();
-      vm_ranges_.push_back({new_ptr, new_size});
-
-      *ptr = (void*)new_ptr;
-      new_ptr = (CUdeviceptr)(((uint64_t)new_ptr) + old_size);
-    } else {
-      vm_ranges_.push_back({new_ptr, reserve_size});
+    // Free up previous VA allocations
+    MMAP_DEBUG("Freeing %lu old VM allocations\n", vm_ranges_.size());
+    for (auto range : vm_ranges_) {
+      HCTR_LIB_THROW(cuMemAddressFree(range.first, range.second));
     }
+
+    // Save new VA allocation information
+    vm_ranges_.clear();
+    vm_ranges_.push_back({new_base, va_size});
+    va_base_ = new_base;
+    va_reserved_ = va_size;
   }
+  *ptr = (void*)va_base_;
 
-  // Finally, create new physical memory chunk
+  // Finally, create the new physical memory chunk and map it at the end of the used prefix
+  CUdeviceptr new_ptr = (CUdeviceptr)((uint64_t)va_base_ + old_size);
+  CUmemGenericAllocationHandle allocHandle;
   HCTR_LIB_THROW(cuMemCreate(&allocHandle, reserve_size, &prop_, 0));
   pm_handles_.push_back({allocHandle, reserve_size});
 
@@ -2004,6 +2130,9 @@ void ReallocBuffer<T, U>::release_mmap_memory() {
     HCTR_LIB_THROW(cuMemRelease(handle.first));
   }
   pm_handles_.clear();
+
+  va_base_ = 0;
+  va_reserved_ = 0;
 }
 
 template class AverageLoss<float>;
@@ -16,6 +16,7 @@
 
 #include <omp.h>
 
+#include <cstdlib>
 #include <layers/fully_connected_layer.hpp>
 #include <layers/relu_layer.hpp>
 #include <network.hpp>
@@ -27,11 +28,62 @@ namespace HugeCTR {
 void conv_weight_gpu(size_t grid, size_t block, __half* dst, const float* src, int elems,
                      cudaStream_t stream);
 
+template <typename T>
+void accum_wgrad_gpu(size_t grid, size_t block, T* accum, const T* wgrad, int elems, bool first,
+                     cudaStream_t stream);
+
+template <typename T>
+void finalize_wgrad_gpu(size_t grid, size_t block, T* wgrad, const T* accum, float inv_steps,
+                        int elems, cudaStream_t stream);
+
 Network::Network(const std::shared_ptr<CPUResource>& cpu_resource,
                  const std::shared_ptr<GPUResource>& gpu_resource, bool use_mixed_precision)
     : cpu_resource_(cpu_resource),
       gpu_resource_(gpu_resource),
-      use_mixed_precision_(use_mixed_precision) {}
+      use_mixed_precision_(use_mixed_precision) {
+  // One kernel for all BCE heads of a multi-task model instead of one launch each; opt-in since
+  // it only pays off with several heads.
+  fuse_loss_heads_ = std::getenv("HCTR_FUSE_LOSS_HEADS") != nullptr;
+}
+
+template <typename T>
+static bool try_fused_bce(const std::map<std::string, std::unique_ptr<ILoss>>& losses,
+                          bool is_train, long long current_batchsize, float rterm,
+                          cudaStream_t stream) {
+  std::vector<FusedBCEHead<T>> heads;
+  float scaler = 1.f;
+  int total_gpu_count = 1;
+  for (const auto& pair : losses) {
+    auto* bce = dynamic_cast<BinaryCrossEntropyLoss<T>*>(pair.second.get());
+    if (bce == nullptr) {
+      return false;
+    }
+    heads.push_back(bce->get_fused_head(is_train));
+    scaler = bce->get_scaler();
+    total_gpu_count = bce->get_total_gpu_count();
+  }
+  if (static_cast<int>(heads.size()) > MAX_FUSED_BCE_HEADS) {
+    return false;
+  }
+  fused_bce_compute(heads, current_batchsize, scaler, total_gpu_count, rterm, is_train, stream);
+  return true;
+}
+
+bool Network::fused_loss_compute(bool is_train, long long current_batchsize, float rterm) {
+  if (!fuse_loss_heads_) {
+    return false;
+  }
+  auto& losses = is_train ? train_losses_ : evaluate_losses_;
+  if (losses.size() < 2) {
+    return false;
+  }
+  if (use_mixed_precision_) {
+    return try_fused_bce<__half>(losses, is_train, current_batchsize, rterm,
+                                 gpu_resource_->get_stream());
+  }
+  return try_fused_bce<float>(losses, is_train, current_batchsize, rterm,
+                              gpu_resource_->get_stream());
+}
 
 void Network::update_params() {
   optimizer_->update();
@@ -78,14 +130,20 @@ void Network::train(long long current_batchsize) {
 
   float rterm = train_losses_.begin()->second->regularizer_compute_rterm();
 
-  for (std::map<std::string, std::unique_ptr<ILoss>>::iterator iter = train_losses_.begin();
-       iter != train_losses_.end(); ++iter) {
-    iter->second->compute(true, current_batchsize, rterm);
+  if (!fused_loss_compute(true, current_batchsize, rterm)) {
+    for (std::map<std::string, std::unique_ptr<ILoss>>::iterator iter = train_losses_.begin();
+         iter != train_losses_.end(); ++iter) {
+      iter->second->compute(true, current_batchsize, rterm);
+    }
   }
 
   train_losses_.begin()->second->regularizer_initialize_wgrad(true);  // Only 1 regularizer for now
 
-  prop_layers(train_layers_ptr, false, true);
+  if (ar_bucket_count_ > 1) {
+    bprop_bucketed_exchange(train_layers_ptr);
+  } else {
+    prop_layers(train_layers_ptr, false, true);
+  }
 
   return;
 }
@@ -100,9 +158,11 @@ void Network::eval(long long current_batchsize) {
 
   float rterm = evaluate_losses_.begin()->second->regularizer_compute_rterm();
 
-  for (std::map<std::string, std::unique_ptr<ILoss>>::iterator iter = evaluate_losses_.begin();
-       iter != evaluate_losses_.end(); ++iter) {
-    iter->second->compute(false, current_batchsize, rterm);
+  if (!fused_loss_compute(false, current_batchsize, rterm)) {
+    for (std::map<std::string, std::unique_ptr<ILoss>>::iterator iter = evaluate_losses_.begin();
+         iter != evaluate_losses_.end(); ++iter) {
+      iter->second->compute(false, current_batchsize, rterm);
+    }
   }
 
   evaluate_losses_.begin()->second->regularizer_initialize_wgrad(
@@ -363,6 +423,111 @@ void Network::exchange_wgrad() {
   }
 }
 
+void Network::enable_bucketed_wgrad_exchange(int num_buckets) {
+  if (num_buckets <= 1 || ar_bucket_count_ > 1) {
+    return;
+  }
+  HCTR_CHECK_HINT(train_layer_wgrad_watermarks_.size() == train_layers_.size(),
+                  "wgrad watermarks were not recorded for this network");
+  CudaDeviceContext context(get_device_id());
+  HCTR_LIB_THROW(cudaStreamCreateWithFlags(&ar_bucket_stream_, cudaStreamNonBlocking));
+  HCTR_LIB_THROW(cudaEventCreateWithFlags(&ar_bucket_ready_event_, cudaEventDisableTiming));
+  HCTR_LIB_THROW(cudaEventCreateWithFlags(&ar_bucket_done_event_, cudaEventDisableTiming));
+  ar_bucket_count_ = num_buckets;
+  HCTR_LOG_S(INFO, ROOT) << "Bucketed wgrad exchange enabled with " << num_buckets << " buckets"
+                         << std::endl;
+}
+
+void Network::enable_grad_accumulation(int num_steps) {
+  if (num_steps <= 1 || grad_accum_steps_ > 1) {
+    return;
+  }
+  CudaDeviceContext context(get_device_id());
+  grad_accum_buff_ = GeneralBuffer2<CudaAllocator>::create();
+  if (use_mixed_precision_) {
+    grad_accum_buff_->reserve({wgrad_tensor_half_.get_num_elements()}, &wgrad_accum_tensor_half_);
+  } else {
+    grad_accum_buff_->reserve({wgrad_tensor_.get_num_elements()}, &wgrad_accum_tensor_);
+  }
+  grad_accum_buff_->allocate();
+  grad_accum_steps_ = num_steps;
+  HCTR_LOG_S(INFO, ROOT) << "Gradient accumulation enabled with " << num_steps << " micro-batches"
+                         << std::endl;
+}
+
+void Network::accumulate_wgrad(bool final_micro_batch) {
+  CudaDeviceContext context(get_device_id());
+  const size_t elems = use_mixed_precision_ ? wgrad_tensor_half_.get_num_elements()
+                                            : wgrad_tensor_.get_num_elements();
+  const size_t BLOCK = 256;
+  size_t GRID = (elems - 1) / BLOCK + 1;
+  GRID = GRID > 10 * gpu_resource_->get_sm_count() ? 10 * gpu_resource_->get_sm_count() : GRID;
+  const cudaStream_t stream = gpu_resource_->get_stream();
+
+  if (!final_micro_batch) {
+    if (use_mixed_precision_) {
+      accum_wgrad_gpu(GRID, BLOCK, wgrad_accum_tensor_half_.get_ptr(),
+                      wgrad_tensor_half_.get_ptr(), elems, !grad_accum_pending_, stream);
+    } else {
+      accum_wgrad_gpu(GRID, BLOCK, wgrad_accum_tensor_.get_ptr(), wgrad_tensor_.get_ptr(), elems,
+                      !grad_accum_pending_, stream);
+    }
+    grad_accum_pending_ = true;
+    return;
+  }
+
+  // The loss already averages every micro-batch over its own size, so the accumulated sum is N
+  // full-batch gradient estimates; averaging it keeps the step magnitude of a single batch.
+  const float inv_steps = 1.f / grad_accum_steps_;
+  if (use_mixed_precision_) {
+    finalize_wgrad_gpu(GRID, BLOCK, wgrad_tensor_half_.get_ptr(),
+                       wgrad_accum_tensor_half_.get_ptr(), inv_steps, elems, stream);
+  } else {
+    finalize_wgrad_gpu(GRID, BLOCK, wgrad_tensor_.get_ptr(), wgrad_accum_tensor_.get_ptr(),
+                       inv_steps, elems, stream);
+  }
+  grad_accum_pending_ = false;
+}
+
+void Network::bprop_bucketed_exchange(const std::vector<Layer*>& layers) {
+  const size_t num_elements = use_mixed_precision_ ? wgrad_tensor_half_.get_num_elements()
+                                                   : wgrad_tensor_.get_num_elements();
+  const size_t bucket_elements = (num_elements + ar_bucket_count_ - 1) / ar_bucket_count_;
+  const cudaStream_t stream = gpu_resource_->get_stream();
+
+  // Backward visits the layers in reverse creation order, so once layer i has run, every wgrad
+  // at an offset >= watermark[i - 1] holds its final value. Whenever at least one bucket's
+  // worth of new elements becomes final, the slice is handed to NCCL on the side stream, which
+  // overlaps the exchange with the backward pass of the remaining layers. Every GPU derives
+  // the same slices from the same watermarks, so the collectives match across ranks.
+  size_t pending_end = num_elements;  // exclusive upper end of the not-yet-exchanged region
+  for (size_t i = layers.size(); i-- > 0;) {
+    layers[i]->bprop();
+    const size_t final_begin = (i == 0) ? 0 : train_layer_wgrad_watermarks_[i - 1];
+    if (pending_end > final_begin &&
+        (pending_end - final_begin >= bucket_elements || i == 0)) {
+      HCTR_LIB_THROW(cudaEventRecord(ar_bucket_ready_event_, stream));
+      HCTR_LIB_THROW(cudaStreamWaitEvent(ar_bucket_stream_, ar_bucket_ready_event_));
+      if (use_mixed_precision_) {
+        __half* slice = wgrad_tensor_half_.get_ptr() + final_begin;
+        HCTR_LIB_THROW(ncclAllReduce((const void*)slice, (void*)slice, pending_end - final_begin,
+                                     ncclHalf, ncclSum, gpu_resource_->get_nccl(),
+                                     ar_bucket_stream_));
+      } else {
+        float* slice = wgrad_tensor_.get_ptr() + final_begin;
+        HCTR_LIB_THROW(ncclAllReduce((const void*)slice, (void*)slice, pending_end - final_begin,
+                                     ncclFloat, ncclSum, gpu_resource_->get_nccl(),
+                                     ar_bucket_stream_));
+      }
+      pending_end = final_begin;
+    }
+  }
+
+  // The optimizer consumes the wgrads on the compute stream right after train() returns.
+  HCTR_LIB_THROW(cudaEventRecord(ar_bucket_done_event_, ar_bucket_stream_));
+  HCTR_LIB_THROW(cudaStreamWaitEvent(stream, ar_bucket_done_event_));
+}
+
 void Network::copy_weights_from_train_layers_to_evaluate_layers() {
   // HCTR_LOG(INFO, ROOT, "Copying trainable weights from train layers to evaluate layers\n");
   CudaDeviceContext context(get_device_id());
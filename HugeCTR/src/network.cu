@@ -24,4 +24,49 @@ void conv_weight_gpu(size_t grid, size_t block, __half* dst, const float* src, i
   convert_array<<<grid, block, 0, stream>>>(dst, src, elems);
 }
 
+namespace {
+
+template <typename T>
+__global__ void accum_wgrad_kernel(T* accum, const T* wgrad, int elems, bool first) {
+  const int tid = blockIdx.x * blockDim.x + threadIdx.x;
+  for (int i = tid; i < elems; i += blockDim.x * gridDim.x) {
+    const float sum = first ? 0.f : TypeConvertFunc<float, T>::convert(accum[i]);
+    accum[i] =
+        TypeConvertFunc<T, float>::convert(sum + TypeConvertFunc<float, T>::convert(wgrad[i]));
+  }
+}
+
+template <typename T>
+__global__ void finalize_wgrad_kernel(T* wgrad, const T* accum, float inv_steps, int elems) {
+  const int tid = blockIdx.x * blockDim.x + threadIdx.x;
+  for (int i = tid; i < elems; i += blockDim.x * gridDim.x) {
+    const float sum = TypeConvertFunc<float, T>::convert(accum[i]) +
+                      TypeConvertFunc<float, T>::convert(wgrad[i]);
+    wgrad[i] = TypeConvertFunc<T, float>::convert(sum * inv_steps);
+  }
+}
+
+}  // namespace
+
+template <typename T>
+void accum_wgrad_gpu(size_t grid, size_t block, T* accum, const T* wgrad, int elems, bool first,
+                     cudaStream_t stream) {
+  accum_wgrad_kernel<<<grid, block, 0, stream>>>(accum, wgrad, elems, first);
+}
+
+template <typename T>
+void finalize_wgrad_gpu(size_t grid, size_t block, T* wgrad, const T* accum, float inv_steps,
+                        int elems, cudaStream_t stream) {
+  finalize_wgrad_kernel<<<grid, block, 0, stream>>>(wgrad, accum, inv_steps, elems);
+}
+
+template void accum_wgrad_gpu<float>(size_t, size_t, float*, const float*, int, bool,
+                                     cudaStream_t);
+template void accum_wgrad_gpu<__half>(size_t, size_t, __half*, const __half*, int, bool,
+                                      cudaStream_t);
+template void finalize_wgrad_gpu<float>(size_t, size_t, float*, const float*, float, int,
+                                        cudaStream_t);
+template void finalize_wgrad_gpu<__half>(size_t, size_t, __half*, const __half*, float, int,
+                                         cudaStream_t);
+
 }  // end namespace HugeCTR
@@ -59,6 +59,7 @@ std::unique_ptr<Optimizer> Optimizer::Create(const OptParams& params,
       auto epsilon = params.hyperparams.adagrad.epsilon;
       ret.reset(new AdaGradOptimizer<T>(weight_main, wgrad, opt_buff, gpu_resource, lr,
                                         initial_accu_value, epsilon, scaler));
+      break;
     }
     case Optimizer_t::MomentumSGD: {
       auto learning_rate = params.lr;
@@ -23,8 +23,8 @@ namespace HugeCTR {
 namespace {
 
 template <typename T>
-__global__ void ada_grad_update_kernel(int len, float* weight, const T* wgrad, T* sum, float lr,
-                                       const float epsilon, float scaler) {
+__device__ inline void ada_grad_update_device(int len, float* weight, const T* wgrad, T* sum,
+                                              float lr, const float epsilon, float scaler) {
   const int i = blockIdx.x * blockDim.x + threadIdx.x;
   if (i < len) {
     float gi = TypeConvertFunc<float, T>::convert(wgrad[i]) / scaler;
@@ -35,6 +35,18 @@ __global__ void ada_grad_update_kernel(int len, float* weight, const T* wgrad, T
     sum[i] = TypeConvertFunc<T, float>::convert(accum_);
   }
 }
+
+template <typename T>
+__global__ void ada_grad_update_kernel(int len, float* weight, const T* wgrad, T* sum, float lr,
+                                       const float epsilon, float scaler) {
+  ada_grad_update_device(len, weight, wgrad, sum, lr, epsilon, scaler);
+}
+
+template <typename T>
+__global__ void ada_grad_update_kernel(int len, float* weight, const T* wgrad, T* sum,
+                                       const float* lr_ptr, const float epsilon, float scaler) {
+  ada_grad_update_device(len, weight, wgrad, sum, *lr_ptr, epsilon, scaler);
+}
 }  // namespace
 
 template <typename T>
@@ -69,8 +81,14 @@ void AdaGradOptimizer<T>::update() {
 
   float* weight = weight_main_.get_ptr();
   const T* wgrad = wgrad_.get_ptr();
-  ada_grad_update_kernel<<<grid_dim, block_dim, 0, gpu_resource_->get_stream()>>>(
-      len, weight, wgrad, accum_.get_ptr(), lr_, epsilon_, scaler_);
+  if (gpu_learning_rate_scheduler_ == nullptr) {
+    ada_grad_update_kernel<<<grid_dim, block_dim, 0, gpu_resource_->get_stream()>>>(
+        len, weight, wgrad, accum_.get_ptr(), lr_, epsilon_, scaler_);
+  } else {
+    const float* lr_ptr = gpu_learning_rate_scheduler_->get_learning_rate();
+    ada_grad_update_kernel<<<grid_dim, block_dim, 0, gpu_resource_->get_stream()>>>(
+        len, weight, wgrad, accum_.get_ptr(), lr_ptr, epsilon_, scaler_);
+  }
 
 #ifndef NDEBUG
   cudaDeviceSynchronize();
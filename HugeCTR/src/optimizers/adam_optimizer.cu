@@ -24,9 +24,9 @@ namespace HugeCTR {
 namespace {
 
 template <typename T>
-__global__ void adam_update_kernel(int len, float* weight, T* m, T* v, const T* wgrad,
-                                   float alpha_t, float beta1, float beta2, float epsilon,
-                                   float scaler) {
+__device__ inline void adam_update_device(int len, float* weight, T* m, T* v, const T* wgrad,
+                                          float alpha_t, float beta1, float beta2, float epsilon,
+                                          float scaler) {
   const int i = blockIdx.x * blockDim.x + threadIdx.x;
   if (i < len) {
     float gi = TypeConvertFunc<float, T>::convert(wgrad[i]) / scaler;
@@ -38,6 +38,21 @@ __global__ void adam_update_kernel(int len, float* weight, T* m, T* v, const T*
   }
 }
 
+template <typename T>
+__global__ void adam_update_kernel(int len, float* weight, T* m, T* v, const T* wgrad,
+                                   float alpha_t, float beta1, float beta2, float epsilon,
+                                   float scaler) {
+  adam_update_device(len, weight, m, v, wgrad, alpha_t, beta1, beta2, epsilon, scaler);
+}
+
+template <typename T>
+__global__ void adam_update_kernel(int len, float* weight, T* m, T* v, const T* wgrad,
+                                   const float* lr_ptr, float bias_correction, float beta1,
+                                   float beta2, float epsilon, float scaler) {
+  const float alpha_t = *lr_ptr * bias_correction;
+  adam_update_device(len, weight, m, v, wgrad, alpha_t, beta1, beta2, epsilon, scaler);
+}
+
 }  // namespace
 
 template <typename T>
@@ -76,15 +91,24 @@ void AdamOptimizer<T>::update() {
   const size_t grid_dim = (len - 1) / block_dim + 1;
 
   ++t_;
-  const float alpha_t = lr_ * sqrt(1 - pow(beta2_, t_)) / (1 - pow(beta1_, t_));
+  // The bias correction only depends on the step, so the device-resident learning rate can be
+  // folded in inside the kernel without any host-side read of the scheduled value
+  const float bias_correction = sqrt(1 - pow(beta2_, t_)) / (1 - pow(beta1_, t_));
 
   float* weight = weight_main_.get_ptr();
 
   T* m = m_.get_ptr();
   T* v = v_.get_ptr();
   const T* wgrad = wgrad_.get_ptr();
-  adam_update_kernel<<<grid_dim, block_dim, 0, gpu_resource_->get_stream()>>>(
-      len, weight, m, v, wgrad, alpha_t, beta1_, beta2_, epsilon_, scaler_);
+  if (gpu_learning_rate_scheduler_ == nullptr) {
+    const float alpha_t = lr_ * bias_correction;
+    adam_update_kernel<<<grid_dim, block_dim, 0, gpu_resource_->get_stream()>>>(
+        len, weight, m, v, wgrad, alpha_t, beta1_, beta2_, epsilon_, scaler_);
+  } else {
+    const float* lr_ptr = gpu_learning_rate_scheduler_->get_learning_rate();
+    adam_update_kernel<<<grid_dim, block_dim, 0, gpu_resource_->get_stream()>>>(
+        len, weight, m, v, wgrad, lr_ptr, bias_correction, beta1_, beta2_, epsilon_, scaler_);
+  }
 #ifndef NDEBUG
   HCTR_LIB_THROW(cudaDeviceSynchronize());
   HCTR_LIB_THROW(cudaGetLastError());
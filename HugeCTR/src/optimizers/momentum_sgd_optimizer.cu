@@ -24,8 +24,9 @@ namespace HugeCTR {
 namespace {
 
 template <typename T>
-__global__ void momentum_sgd_update_kernel(int len, float* weight, T* momentum, const T* wgrad,
-                                           float lr, float momentum_factor, float scaler) {
+__device__ inline void momentum_sgd_update_device(int len, float* weight, T* momentum,
+                                                  const T* wgrad, float lr, float momentum_factor,
+                                                  float scaler) {
   int idx = blockDim.x * blockIdx.x + threadIdx.x;
   if (idx < len) {
     float mv = momentum_factor * TypeConvertFunc<float, T>::convert(momentum[idx]) -
@@ -36,6 +37,19 @@ __global__ void momentum_sgd_update_kernel(int len, float* weight, T* momentum,
   return;
 }
 
+template <typename T>
+__global__ void momentum_sgd_update_kernel(int len, float* weight, T* momentum, const T* wgrad,
+                                           float lr, float momentum_factor, float scaler) {
+  momentum_sgd_update_device(len, weight, momentum, wgrad, lr, momentum_factor, scaler);
+}
+
+template <typename T>
+__global__ void momentum_sgd_update_kernel(int len, float* weight, T* momentum, const T* wgrad,
+                                           const float* lr_ptr, float momentum_factor,
+                                           float scaler) {
+  momentum_sgd_update_device(len, weight, momentum, wgrad, *lr_ptr, momentum_factor, scaler);
+}
+
 }  // namespace
 template <typename T>
 MomentumSGDOptimizer<T>::MomentumSGDOptimizer(const Tensor2<float>& weight, const Tensor2<T>& wgrad,
@@ -70,8 +84,14 @@ void MomentumSGDOptimizer<T>::update() {
 
   T* momentum = momentum_.get_ptr();
   T* wgrad = wgrad_.get_ptr();
-  momentum_sgd_update_kernel<<<grid_dim, block_dim, 0, gpu_resource_->get_stream()>>>(
-      len, weight, momentum, wgrad, lr_, momentum_factor_, scaler_);
+  if (gpu_learning_rate_scheduler_ == nullptr) {
+    momentum_sgd_update_kernel<<<grid_dim, block_dim, 0, gpu_resource_->get_stream()>>>(
+        len, weight, momentum, wgrad, lr_, momentum_factor_, scaler_);
+  } else {
+    const float* lr_ptr = gpu_learning_rate_scheduler_->get_learning_rate();
+    momentum_sgd_update_kernel<<<grid_dim, block_dim, 0, gpu_resource_->get_stream()>>>(
+        len, weight, momentum, wgrad, lr_ptr, momentum_factor_, scaler_);
+  }
 
 #ifndef NDEBUG
   HCTR_LIB_THROW(cudaDeviceSynchronize());
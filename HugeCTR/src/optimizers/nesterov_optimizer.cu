@@ -24,8 +24,8 @@ namespace HugeCTR {
 namespace {
 
 template <typename T>
-__global__ void nesterov_update_kernel(int len, float* weight, T* accum, const T* wgrad, float lr,
-                                       float mu, float scaler) {
+__device__ inline void nesterov_update_device(int len, float* weight, T* accum, const T* wgrad,
+                                              float lr, float mu, float scaler) {
   const int i = blockIdx.x * blockDim.x + threadIdx.x;
   if (i < len) {
     float accum_old = TypeConvertFunc<float, T>::convert(accum[i]);
@@ -35,6 +35,18 @@ __global__ void nesterov_update_kernel(int len, float* weight, T* accum, const T
   }
 }
 
+template <typename T>
+__global__ void nesterov_update_kernel(int len, float* weight, T* accum, const T* wgrad, float lr,
+                                       float mu, float scaler) {
+  nesterov_update_device(len, weight, accum, wgrad, lr, mu, scaler);
+}
+
+template <typename T>
+__global__ void nesterov_update_kernel(int len, float* weight, T* accum, const T* wgrad,
+                                       const float* lr_ptr, float mu, float scaler) {
+  nesterov_update_device(len, weight, accum, wgrad, *lr_ptr, mu, scaler);
+}
+
 }  // namespace
 
 template <typename T>
@@ -68,8 +80,14 @@ void NesterovOptimizer<T>::update() {
   float* weight = weight_main_.get_ptr();
   T* accum = accum_.get_ptr();
   T* wgrad = wgrad_.get_ptr();
-  nesterov_update_kernel<<<grid_dim, block_dim, 0, gpu_resource_->get_stream()>>>(
-      len, weight, accum, wgrad, lr_, mu_, scaler_);
+  if (gpu_learning_rate_scheduler_ == nullptr) {
+    nesterov_update_kernel<<<grid_dim, block_dim, 0, gpu_resource_->get_stream()>>>(
+        len, weight, accum, wgrad, lr_, mu_, scaler_);
+  } else {
+    const float* lr_ptr = gpu_learning_rate_scheduler_->get_learning_rate();
+    nesterov_update_kernel<<<grid_dim, block_dim, 0, gpu_resource_->get_stream()>>>(
+        len, weight, accum, wgrad, lr_ptr, mu_, scaler_);
+  }
 
 #ifndef NDEBUG
   HCTR_LIB_THROW(cudaDeviceSynchronize());
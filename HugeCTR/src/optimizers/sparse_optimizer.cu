@@ -13,25 +13,71 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <cstdlib>
+#include <limits>
+
 #include "HugeCTR/include/embedding.hpp"
 #include "HugeCTR/include/utils.cuh"
 #include "cub/device/device_radix_sort.cuh"
 #include "cub/device/device_run_length_encode.cuh"
 #include "cub/device/device_scan.cuh"
+#include "cub/device/device_select.cuh"
+#include "cub/iterator/counting_input_iterator.cuh"
 
 namespace HugeCTR {
 
+namespace {
+
+// Selects the non-empty slots of the wgrad aggregation hash table, in slot order so that
+// the groups stay laid out contiguously by ascending offset.
+struct HashAggNonEmptySlotOp {
+  const uint32_t *hash_counts;
+  __host__ __device__ __forceinline__ HashAggNonEmptySlotOp(const uint32_t *hash_counts)
+      : hash_counts(hash_counts) {}
+  __device__ __forceinline__ bool operator()(const uint32_t &slot) const {
+    return hash_counts[slot] > 0;
+  }
+};
+
+}  // namespace
+
 template <typename TypeHashKey, typename TypeEmbeddingComp>
 EmbeddingOptimizer<TypeHashKey, TypeEmbeddingComp>::EmbeddingOptimizer(
     size_t max_vocabulary_size_per_gpu_, SparseEmbeddingHashParams &param,
     const std::shared_ptr<GeneralBuffer2<CudaAllocator>> &buf)
     : param(param) {
+  // Optional 8-bit optimizer state: keep the Adam moments / AdaGrad accumulators as int8
+  // with one fp32 scale per embedding row and fuse the dequant/requant into the update
+  // kernels, cutting the optimizer state memory to roughly a quarter.
+  if (param.opt_params.quantized_opt_states || std::getenv("HCTR_QUANTIZED_OPT_STATE")) {
+    const bool supported = (param.opt_params.update_type == Update_t::Local) &&
+                           (param.opt_params.optimizer == Optimizer_t::Adam ||
+                            param.opt_params.optimizer == Optimizer_t::AdaGrad);
+    if (supported) {
+      use_quantized_opt_state_ = true;
+      HCTR_LOG_S(INFO, ROOT) << "Using 8-bit optimizer states with per-row scales" << std::endl;
+    } else {
+      HCTR_LOG_S(WARNING, ROOT) << "Quantized optimizer states only support Adam/AdaGrad with "
+                                   "local update, ignored"
+                                << std::endl;
+    }
+  }
+
   // new optimizer params used by update_params
   // should be match with HugeCTR/src/parsers/create_embedding.cpp
   // should be match with HugeCTR/src/pybind/model.cpp
   switch (param.opt_params.optimizer) {
     case Optimizer_t::Adam:  // adam
     {
+      if (use_quantized_opt_state_) {
+        buf->reserve({max_vocabulary_size_per_gpu_, param.embedding_vec_size},
+                     &opt_m_quantized_tensors_);
+        buf->reserve({max_vocabulary_size_per_gpu_, 1}, &opt_m_scale_tensors_);
+        buf->reserve({max_vocabulary_size_per_gpu_, param.embedding_vec_size},
+                     &opt_v_quantized_tensors_);
+        buf->reserve({max_vocabulary_size_per_gpu_, 1}, &opt_v_scale_tensors_);
+        break;
+      }
       {
         buf->reserve({max_vocabulary_size_per_gpu_, param.embedding_vec_size},
                      &opt_tensors_.opt_m_tensors_);
@@ -46,6 +92,12 @@ EmbeddingOptimizer<TypeHashKey, TypeEmbeddingComp>::EmbeddingOptimizer(
     }
     case Optimizer_t::AdaGrad:  // nesterov
     {
+      if (use_quantized_opt_state_) {
+        buf->reserve({max_vocabulary_size_per_gpu_, param.embedding_vec_size},
+                     &opt_accm_quantized_tensors_);
+        buf->reserve({max_vocabulary_size_per_gpu_, 1}, &opt_accm_scale_tensors_);
+        break;
+      }
       buf->reserve({max_vocabulary_size_per_gpu_, param.embedding_vec_size},
                    &opt_tensors_.opt_accm_tensors_);
       break;
@@ -111,10 +163,95 @@ EmbeddingOptimizer<TypeHashKey, TypeEmbeddingComp>::EmbeddingOptimizer(
 
     buf->reserve({size}, &temp_storage_scan_tensors_);
   }
+
+  // Optional hash-based wgrad aggregation: group the duplicate keys through a device hash
+  // table of the touched keys instead of radix-sorting every (key, sample) pair. Pays off
+  // when the number of touched keys is far below the number of samples.
+  if (std::getenv("HCTR_WGRAD_HASH_AGG")) {
+    const size_t max_nnz = param.get_batch_size(true) * param.max_feature_num;
+    size_t capacity = 1;
+    while (capacity < 2 * max_nnz) {
+      capacity *= 2;
+    }
+    use_hash_aggregation_ = true;
+    hash_agg_capacity_ = capacity;
+    HCTR_LOG_S(INFO, ROOT) << "Using hash-based wgrad aggregation with " << capacity
+                           << " slots in update_params()" << std::endl;
+
+    buf->reserve({1, capacity}, &hash_agg_key_tensors_);
+    buf->reserve({1, capacity}, &hash_agg_count_tensors_);
+    buf->reserve({1, capacity}, &hash_agg_offset_tensors_);
+    buf->reserve({1, max_nnz}, &hash_agg_entry_slot_tensors_);
+    buf->reserve({1, max_nnz}, &hash_agg_unique_slot_tensors_);
+    {
+      size_t size = 0;
+      cub::DeviceScan::InclusiveSum((void *)nullptr, size, (uint32_t *)nullptr, (uint32_t *)nullptr,
+                                    capacity);
+      buf->reserve({size}, &temp_storage_agg_scan_tensors_);
+    }
+    {
+      size_t size = 0;
+      cub::CountingInputIterator<uint32_t> counting(0);
+      HashAggNonEmptySlotOp select_op(nullptr);
+      cub::DeviceSelect::If((void *)nullptr, size, counting, (uint32_t *)nullptr,
+                            (uint32_t *)nullptr, capacity, select_op);
+      buf->reserve({size}, &temp_storage_agg_select_tensors_);
+    }
+  }
+
+  // Optional gradient-delayed update: accumulate the scaled wgrads into a per-row delta
+  // buffer and fold it into the embedding table every K steps with one dense pass, trading
+  // bounded staleness for the amortized per-step update cost. Only the stateless SGD
+  // optimizer stays numerically equivalent under delayed application.
+  if (const char *env_k = std::getenv("HCTR_DELAYED_WGRAD_K")) {
+    const int interval = std::atoi(env_k);
+    if (interval > 1) {
+      if (param.opt_params.optimizer == Optimizer_t::SGD) {
+        delayed_update_interval_ = interval;
+        buf->reserve({max_vocabulary_size_per_gpu_, param.embedding_vec_size},
+                     &wgrad_delta_tensors_);
+        HCTR_LOG_S(INFO, ROOT) << "Delayed wgrad update: folding the accumulated deltas into "
+                                  "the embedding table every "
+                               << interval << " steps" << std::endl;
+      } else {
+        HCTR_LOG_S(WARNING, ROOT) << "HCTR_DELAYED_WGRAD_K only supports the SGD optimizer "
+                                     "(stateful optimizers change semantics), ignored"
+                                  << std::endl;
+      }
+    }
+  }
 }
 
 template <typename TypeHashKey, typename TypeEmbeddingComp>
 void EmbeddingOptimizer<TypeHashKey, TypeEmbeddingComp>::initialize(const GPUResource &local_gpu) {
+  if (use_quantized_opt_state_) {
+    // all-zero quantized states and scales represent zero-initialized moments/accumulators;
+    // a non-zero AdaGrad initial_accu_value cannot be represented before the first update
+    if (param.opt_params.optimizer == Optimizer_t::Adam) {
+      HCTR_LIB_THROW(cudaMemsetAsync(opt_m_quantized_tensors_.get_ptr(), 0,
+                                     opt_m_quantized_tensors_.get_size_in_bytes(),
+                                     local_gpu.get_stream()));
+      HCTR_LIB_THROW(cudaMemsetAsync(opt_m_scale_tensors_.get_ptr(), 0,
+                                     opt_m_scale_tensors_.get_size_in_bytes(),
+                                     local_gpu.get_stream()));
+      HCTR_LIB_THROW(cudaMemsetAsync(opt_v_quantized_tensors_.get_ptr(), 0,
+                                     opt_v_quantized_tensors_.get_size_in_bytes(),
+                                     local_gpu.get_stream()));
+      HCTR_LIB_THROW(cudaMemsetAsync(opt_v_scale_tensors_.get_ptr(), 0,
+                                     opt_v_scale_tensors_.get_size_in_bytes(),
+                                     local_gpu.get_stream()));
+      param.opt_params.hyperparams.adam.times = 0;
+    } else {
+      HCTR_LIB_THROW(cudaMemsetAsync(opt_accm_quantized_tensors_.get_ptr(), 0,
+                                     opt_accm_quantized_tensors_.get_size_in_bytes(),
+                                     local_gpu.get_stream()));
+      HCTR_LIB_THROW(cudaMemsetAsync(opt_accm_scale_tensors_.get_ptr(), 0,
+                                     opt_accm_scale_tensors_.get_size_in_bytes(),
+                                     local_gpu.get_stream()));
+    }
+    return;
+  }
+
   switch (param.opt_params.optimizer) {
     case Optimizer_t::Adam:  // adam
       HCTR_LIB_THROW(cudaMemsetAsync(opt_tensors_.opt_m_tensors_.get_ptr(), 0,
@@ -157,6 +294,13 @@ void EmbeddingOptimizer<TypeHashKey, TypeEmbeddingComp>::initialize(const GPURes
       throw std::runtime_error(
           std::string("[HCDEBUG][ERROR] Runtime error: Invalid optimizer type\n"));
   }
+
+  if (delayed_update_interval_ > 0) {
+    HCTR_LIB_THROW(cudaMemsetAsync(wgrad_delta_tensors_.get_ptr(), 0,
+                                   wgrad_delta_tensors_.get_size_in_bytes(),
+                                   local_gpu.get_stream()));
+    delayed_update_step_ = 0;
+  }
 }
 
 namespace {
@@ -212,6 +356,73 @@ __global__ void value_count_kernel_1(int nnz, const size_t *hash_value_index_sor
   }
 }
 
+constexpr size_t hash_agg_empty_key = std::numeric_limits<size_t>::max();
+
+__device__ __forceinline__ size_t hash_agg_slot(size_t key, size_t capacity) {
+  key ^= key >> 33;
+  key *= 0xff51afd7ed558ccdul;
+  key ^= key >> 33;
+  return key & (capacity - 1);
+}
+
+// Insert every key into an open-addressing hash table of the touched keys and count the
+// occurrences per slot. Each entry remembers the slot of its key for the scatter step.
+__global__ void hash_agg_insert_kernel(int nnz, const size_t *hash_value_index, size_t capacity,
+                                       size_t *hash_keys, uint32_t *hash_counts,
+                                       uint32_t *entry_slot) {
+  for (int gid = blockIdx.x * blockDim.x + threadIdx.x; gid < nnz; gid += blockDim.x * gridDim.x) {
+    size_t key = hash_value_index[gid];
+    size_t slot = hash_agg_slot(key, capacity);
+    while (true) {
+      unsigned long long int old =
+          atomicCAS(reinterpret_cast<unsigned long long int *>(&hash_keys[slot]),
+                    static_cast<unsigned long long int>(hash_agg_empty_key),
+                    static_cast<unsigned long long int>(key));
+      if (old == static_cast<unsigned long long int>(hash_agg_empty_key) ||
+          old == static_cast<unsigned long long int>(key)) {
+        break;
+      }
+      slot = (slot + 1) & (capacity - 1);
+    }
+    entry_slot[gid] = slot;
+    atomicAdd(&hash_counts[slot], 1);
+  }
+}
+
+// Scatter each (key, sample) pair into its group's contiguous range. The inclusive scan of
+// the counts gives the end of each slot's range and atomicSub hands out distinct positions
+// within it, so the result matches the layout the sort path produces.
+template <typename TypeKey>
+__global__ void hash_agg_scatter_kernel(int nnz, const size_t *hash_value_index,
+                                        const TypeKey *sample_id, const uint32_t *entry_slot,
+                                        const uint32_t *hash_offsets, uint32_t *hash_counts,
+                                        size_t *hash_value_index_sort, TypeKey *sample_id_sort) {
+  for (int gid = blockIdx.x * blockDim.x + threadIdx.x; gid < nnz; gid += blockDim.x * gridDim.x) {
+    uint32_t slot = entry_slot[gid];
+    uint32_t pos = hash_offsets[slot] - atomicSub(&hash_counts[slot], 1);
+    hash_value_index_sort[pos] = hash_value_index[gid];
+    sample_id_sort[pos] = sample_id[gid];
+  }
+}
+
+// Emit the start offset of each group in ascending order, one group per non-empty slot,
+// plus the terminating nnz that accumulate_gradients() expects.
+__global__ void hash_agg_group_offset_kernel(int nnz, const uint32_t *num_groups_ptr,
+                                             const uint32_t *unique_slots,
+                                             const uint32_t *hash_offsets,
+                                             const uint32_t *hash_counts,
+                                             uint32_t *hash_value_index_count_offset) {
+  uint32_t num_groups = *num_groups_ptr;
+  for (int gid = blockIdx.x * blockDim.x + threadIdx.x; gid < num_groups;
+       gid += blockDim.x * gridDim.x) {
+    uint32_t slot = unique_slots[gid];
+    hash_value_index_count_offset[gid] = hash_offsets[slot] - hash_counts[slot];
+  }
+  if (blockIdx.x * blockDim.x + threadIdx.x == 0) {
+    hash_value_index_count_offset[num_groups] = nnz;
+  }
+}
+
 // Helper function to accumulate the weight gradients for a thread's embedding vector
 template <typename TypeKey, typename TypeEmbeddingComp>
 __device__ __forceinline__ float accumulate_gradients(int embedding_vec_size,
@@ -432,6 +643,113 @@ __global__ void opt_adagrad_kernel(uint32_t hash_value_index_count_num, int embe
   }
 }
 
+// block-wide max(|x|) over one embedding row; blockDim.x == embedding_vec_size and is not
+// necessarily a power of two, so the out-of-range peers are skipped
+__forceinline__ __device__ float opt_state_row_absmax(float x, float *smem) {
+  smem[threadIdx.x] = fabsf(x);
+  __syncthreads();
+  int pow2 = 1;
+  while (pow2 < blockDim.x) {
+    pow2 <<= 1;
+  }
+  for (int stride = pow2 >> 1; stride > 0; stride >>= 1) {
+    if (threadIdx.x < stride) {
+      int peer = threadIdx.x + stride;
+      if (peer < blockDim.x && smem[peer] > smem[threadIdx.x]) {
+        smem[threadIdx.x] = smem[peer];
+      }
+    }
+    __syncthreads();
+  }
+  float result = smem[0];
+  __syncthreads();
+  return result;
+}
+
+__forceinline__ __device__ int8_t quantize_opt_state(float x, float scale) {
+  if (scale == 0.0f) {
+    return 0;
+  }
+  float q = rintf(x / scale);
+  q = fmaxf(fminf(q, 127.0f), -127.0f);
+  return static_cast<int8_t>(q);
+}
+
+// Local update for Adam with 8-bit moments: dequantize mi/vi with the per-row scales, update
+// them in fp32, then requantize against the new row maxima. The whole block works on one row,
+// so the scale reductions reuse the existing one-block-per-key launch shape.
+template <typename TypeKey, typename TypeEmbeddingComp>
+__global__ void opt_adam_kernel_quantized(
+    uint32_t hash_value_index_count_num, int embedding_vec_size, const AdamOptHyperParams adam,
+    int8_t *m_quantized, float *m_scale, int8_t *v_quantized, float *v_scale, float alpha_t,
+    const TypeKey *sample_id, const size_t *hash_value_index_sort,
+    const uint32_t *hash_value_index_count_offset, const TypeEmbeddingComp *wgrad,
+    float *hash_table_value, float scaler) {
+  extern __shared__ float reduce_smem[];
+  int bid = blockIdx.x;
+  int tid = threadIdx.x;
+
+  if (bid >= hash_value_index_count_num) {
+    return;
+  }
+
+  uint32_t offset = hash_value_index_count_offset[bid];
+  float gi = accumulate_gradients(embedding_vec_size, sample_id, hash_value_index_count_offset,
+                                  wgrad, scaler, offset, bid, tid);
+
+  size_t row_index = hash_value_index_sort[offset];
+  size_t feature_index = row_index * embedding_vec_size + tid;
+  float mi = adam.beta1 * (m_scale[row_index] * static_cast<float>(m_quantized[feature_index])) +
+             (1.0f - adam.beta1) * gi;
+  float vi = adam.beta2 * (v_scale[row_index] * static_cast<float>(v_quantized[feature_index])) +
+             (1.0f - adam.beta2) * gi * gi;
+  float weight_diff = -alpha_t * mi / (sqrtf(vi) + adam.epsilon);
+  hash_table_value[feature_index] += weight_diff;
+
+  float new_m_scale = opt_state_row_absmax(mi, reduce_smem) / 127.0f;
+  float new_v_scale = opt_state_row_absmax(vi, reduce_smem) / 127.0f;
+  if (tid == 0) {
+    m_scale[row_index] = new_m_scale;
+    v_scale[row_index] = new_v_scale;
+  }
+  m_quantized[feature_index] = quantize_opt_state(mi, new_m_scale);
+  v_quantized[feature_index] = quantize_opt_state(vi, new_v_scale);
+}
+
+// Local update for AdaGrad with 8-bit accumulators, same scheme as the Adam variant above
+template <typename TypeKey, typename TypeEmbeddingComp>
+__global__ void opt_adagrad_kernel_quantized(
+    uint32_t hash_value_index_count_num, int embedding_vec_size, float lr,
+    const AdaGradParams adagrad, int8_t *accum_quantized, float *accum_scale,
+    const TypeKey *sample_id, const size_t *hash_value_index_sort,
+    const uint32_t *hash_value_index_count_offset, const TypeEmbeddingComp *wgrad,
+    float *hash_table_value, float scaler) {
+  extern __shared__ float reduce_smem[];
+  int bid = blockIdx.x;
+  int tid = threadIdx.x;
+
+  if (bid >= hash_value_index_count_num) {
+    return;
+  }
+
+  uint32_t offset = hash_value_index_count_offset[bid];
+  float gi = accumulate_gradients(embedding_vec_size, sample_id, hash_value_index_count_offset,
+                                  wgrad, scaler, offset, bid, tid);
+
+  size_t row_index = hash_value_index_sort[offset];
+  size_t feature_index = row_index * embedding_vec_size + tid;
+  float accum =
+      accum_scale[row_index] * static_cast<float>(accum_quantized[feature_index]) + gi * gi;
+  float weight_diff = -lr * gi / (sqrtf(accum) + adagrad.epsilon);
+  hash_table_value[feature_index] += weight_diff;
+
+  float new_accum_scale = opt_state_row_absmax(accum, reduce_smem) / 127.0f;
+  if (tid == 0) {
+    accum_scale[row_index] = new_accum_scale;
+  }
+  accum_quantized[feature_index] = quantize_opt_state(accum, new_accum_scale);
+}
+
 // Local update for Momentum SGD: compute the gradients and update the momentum and the weights
 template <typename TypeKey, typename TypeEmbeddingComp>
 __global__ void opt_momentum_sgd_kernel(uint32_t hash_value_index_count_num, int embedding_vec_size,
@@ -597,6 +915,19 @@ __global__ void opt_sgd_atomic_kernel(int nnz, int embedding_vec_size, float lr_
   }
 }
 
+// fold the accumulated wgrad deltas into the embedding table and clear them
+__global__ void delayed_delta_fold_kernel(size_t num_elements, float *wgrad_delta,
+                                          float *hash_table_value) {
+  const size_t gid = blockIdx.x * static_cast<size_t>(blockDim.x) + threadIdx.x;
+  if (gid < num_elements) {
+    float delta = wgrad_delta[gid];
+    if (delta != 0.0f) {
+      hash_table_value[gid] += delta;
+      wgrad_delta[gid] = 0.0f;
+    }
+  }
+}
+
 }  // namespace
 
 template <typename TypeHashKey, typename TypeEmbeddingComp>
@@ -630,8 +961,28 @@ void EmbeddingOptimizer<TypeHashKey, TypeEmbeddingComp>::update(
     sample_id_expand_kernel<<<grid_size, block_size, 0, stream>>>(
         batch_size, slot_num, row_offset.get_ptr(), sample_id.get_ptr());
 
-    if (opt_params.optimizer == Optimizer_t::SGD &&
-        opt_params.hyperparams.sgd.atomic_update) {  // for SGD, do atomic update
+    if (delayed_update_interval_ > 0) {
+      // delayed mode: accumulate this step's scaled gradients into the delta buffer (the
+      // learning rate is applied here, so the fold below is a pure add) and only touch the
+      // embedding table every delayed_update_interval_ steps
+      const size_t block_size = embedding_vec_size;
+      const size_t grid_size = min(max(1ul, nnz), sm_count * 32);
+
+      float lr_scale = opt_params.lr / opt_params.scaler;
+      opt_sgd_atomic_kernel<<<grid_size, block_size, 0, stream>>>(
+          nnz, embedding_vec_size, lr_scale, hash_value_index.get_ptr(), sample_id.get_ptr(),
+          wgrad.get_ptr(), wgrad_delta_tensors_.get_ptr());
+
+      if (++delayed_update_step_ >= delayed_update_interval_) {
+        delayed_update_step_ = 0;
+        const size_t num_elements = max_vocabulary_size_per_gpu * embedding_vec_size;
+        const size_t fold_block_size = 256;
+        const size_t fold_grid_size = (num_elements - 1) / fold_block_size + 1;
+        delayed_delta_fold_kernel<<<fold_grid_size, fold_block_size, 0, stream>>>(
+            num_elements, wgrad_delta_tensors_.get_ptr(), hash_table_value.get_ptr());
+      }
+    } else if (opt_params.optimizer == Optimizer_t::SGD &&
+               opt_params.hyperparams.sgd.atomic_update) {  // for SGD, do atomic update
       const size_t block_size = embedding_vec_size;
       const size_t grid_size = min(max(1ul, nnz), sm_count * 32);
 
@@ -640,34 +991,80 @@ void EmbeddingOptimizer<TypeHashKey, TypeEmbeddingComp>::update(
           nnz, embedding_vec_size, lr_scale, hash_value_index.get_ptr(), sample_id.get_ptr(),
           wgrad.get_ptr(), hash_table_value.get_ptr());
     } else {
-      // step3: sort by hash_value_index
-      int end_bit = static_cast<int>(log2(static_cast<float>(max_vocabulary_size_per_gpu))) + 1;
-      size_t temp_storage_sort_size = temp_storage_sort.get_size_in_bytes();
-      HCTR_LIB_THROW(cub::DeviceRadixSort::SortPairs(
-          temp_storage_sort.get_ptr(), temp_storage_sort_size, hash_value_index.get_ptr(),
-          hash_value_index_sort.get_ptr(), sample_id.get_ptr(), sample_id_sort.get_ptr(), nnz, 0,
-          end_bit, stream, false));
-
-      // step4: count the number for each unduplicated hash_value_index
-      HCTR_LIB_THROW(
-          cudaMemsetAsync(hash_value_index_count_counter.get_ptr(), 0, sizeof(uint32_t), stream));
-
       constexpr size_t max_grid_size = 384;
-      block_size = 256;
-      grid_size = min(max_grid_size, (nnz - 1) / block_size + 1);
-
-      value_count_kernel_1<<<grid_size, block_size, 0, stream>>>(
-          nnz, hash_value_index_sort.get_ptr(), new_hash_value_flag.get_ptr());
-
-      // prefix_sum
-      size_t temp_storage_scan_size = temp_storage_scan.get_size_in_bytes();
-      HCTR_LIB_THROW(cub::DeviceScan::InclusiveSum(
-          temp_storage_scan.get_ptr(), temp_storage_scan_size, new_hash_value_flag.get_ptr(),
-          hash_value_flag_sumed.get_ptr(), nnz, stream));
-
-      value_count_kernel_2<<<grid_size, block_size, 0, stream>>>(
-          nnz, new_hash_value_flag.get_ptr(), hash_value_flag_sumed.get_ptr(),
-          hash_value_index_count_offset.get_ptr(), hash_value_index_count_counter.get_ptr());
+      if (use_hash_aggregation_) {
+        // step3 (hash path): group the duplicate keys through a hash table of the touched
+        // keys, producing the same arrays as the sort path without radix-sorting all pairs
+        size_t capacity = hash_agg_capacity_;
+        while (capacity > 2 * nnz && capacity > 2) {
+          capacity /= 2;
+        }
+        HCTR_LIB_THROW(cudaMemsetAsync(hash_agg_key_tensors_.get_ptr(), 0xff,
+                                       capacity * sizeof(size_t), stream));
+        HCTR_LIB_THROW(cudaMemsetAsync(hash_agg_count_tensors_.get_ptr(), 0,
+                                       capacity * sizeof(uint32_t), stream));
+
+        block_size = 256;
+        grid_size = min(max_grid_size, (nnz - 1) / block_size + 1);
+
+        hash_agg_insert_kernel<<<grid_size, block_size, 0, stream>>>(
+            nnz, hash_value_index.get_ptr(), capacity, hash_agg_key_tensors_.get_ptr(),
+            hash_agg_count_tensors_.get_ptr(), hash_agg_entry_slot_tensors_.get_ptr());
+
+        size_t temp_storage_agg_scan_size = temp_storage_agg_scan_tensors_.get_size_in_bytes();
+        HCTR_LIB_THROW(cub::DeviceScan::InclusiveSum(
+            temp_storage_agg_scan_tensors_.get_ptr(), temp_storage_agg_scan_size,
+            hash_agg_count_tensors_.get_ptr(), hash_agg_offset_tensors_.get_ptr(), capacity,
+            stream));
+
+        cub::CountingInputIterator<uint32_t> counting(0);
+        HashAggNonEmptySlotOp select_op(hash_agg_count_tensors_.get_ptr());
+        size_t temp_storage_agg_select_size =
+            temp_storage_agg_select_tensors_.get_size_in_bytes();
+        HCTR_LIB_THROW(cub::DeviceSelect::If(
+            temp_storage_agg_select_tensors_.get_ptr(), temp_storage_agg_select_size, counting,
+            hash_agg_unique_slot_tensors_.get_ptr(), hash_value_index_count_counter.get_ptr(),
+            capacity, select_op, stream));
+
+        hash_agg_group_offset_kernel<<<grid_size, block_size, 0, stream>>>(
+            nnz, hash_value_index_count_counter.get_ptr(), hash_agg_unique_slot_tensors_.get_ptr(),
+            hash_agg_offset_tensors_.get_ptr(), hash_agg_count_tensors_.get_ptr(),
+            hash_value_index_count_offset.get_ptr());
+
+        hash_agg_scatter_kernel<<<grid_size, block_size, 0, stream>>>(
+            nnz, hash_value_index.get_ptr(), sample_id.get_ptr(),
+            hash_agg_entry_slot_tensors_.get_ptr(), hash_agg_offset_tensors_.get_ptr(),
+            hash_agg_count_tensors_.get_ptr(), hash_value_index_sort.get_ptr(),
+            sample_id_sort.get_ptr());
+      } else {
+        // step3: sort by hash_value_index
+        int end_bit = static_cast<int>(log2(static_cast<float>(max_vocabulary_size_per_gpu))) + 1;
+        size_t temp_storage_sort_size = temp_storage_sort.get_size_in_bytes();
+        HCTR_LIB_THROW(cub::DeviceRadixSort::SortPairs(
+            temp_storage_sort.get_ptr(), temp_storage_sort_size, hash_value_index.get_ptr(),
+            hash_value_index_sort.get_ptr(), sample_id.get_ptr(), sample_id_sort.get_ptr(), nnz, 0,
+            end_bit, stream, false));
+
+        // step4: count the number for each unduplicated hash_value_index
+        HCTR_LIB_THROW(
+            cudaMemsetAsync(hash_value_index_count_counter.get_ptr(), 0, sizeof(uint32_t), stream));
+
+        block_size = 256;
+        grid_size = min(max_grid_size, (nnz - 1) / block_size + 1);
+
+        value_count_kernel_1<<<grid_size, block_size, 0, stream>>>(
+            nnz, hash_value_index_sort.get_ptr(), new_hash_value_flag.get_ptr());
+
+        // prefix_sum
+        size_t temp_storage_scan_size = temp_storage_scan.get_size_in_bytes();
+        HCTR_LIB_THROW(cub::DeviceScan::InclusiveSum(
+            temp_storage_scan.get_ptr(), temp_storage_scan_size, new_hash_value_flag.get_ptr(),
+            hash_value_flag_sumed.get_ptr(), nnz, stream));
+
+        value_count_kernel_2<<<grid_size, block_size, 0, stream>>>(
+            nnz, new_hash_value_flag.get_ptr(), hash_value_flag_sumed.get_ptr(),
+            hash_value_index_count_offset.get_ptr(), hash_value_index_count_counter.get_ptr());
+      }
 
       uint32_t hash_hash_value_index_count_num = 0;
       // this async memcpy will not perform as a async operation because the host memory is not
@@ -755,6 +1152,19 @@ void EmbeddingOptimizer<TypeHashKey, TypeEmbeddingComp>::update(
                        pow(opt_params.hyperparams.adam.beta2, opt_params.hyperparams.adam.times)) /
                   (1 - pow(opt_params.hyperparams.adam.beta1, opt_params.hyperparams.adam.times));
 
+              if (use_quantized_opt_state_) {
+                opt_adam_kernel_quantized<<<grid_size, block_size,
+                                            embedding_vec_size * sizeof(float), stream>>>(
+                    hash_hash_value_index_count_num, embedding_vec_size,
+                    opt_params.hyperparams.adam,
+                    reinterpret_cast<int8_t *>(opt_m_quantized_tensors_.get_ptr()),
+                    opt_m_scale_tensors_.get_ptr(),
+                    reinterpret_cast<int8_t *>(opt_v_quantized_tensors_.get_ptr()),
+                    opt_v_scale_tensors_.get_ptr(), alpha_t, sample_id_sort.get_ptr(),
+                    hash_value_index_sort.get_ptr(), hash_value_index_count_offset.get_ptr(),
+                    wgrad.get_ptr(), hash_table_value.get_ptr(), opt_params.scaler);
+                break;
+              }
               opt_adam_kernel<<<grid_size, block_size, 0, stream>>>(
                   hash_hash_value_index_count_num, embedding_vec_size, opt_params.hyperparams.adam,
                   opt_tensor.opt_m_tensors_.get_ptr(), opt_tensor.opt_v_tensors_.get_ptr(), alpha_t,
@@ -764,6 +1174,17 @@ void EmbeddingOptimizer<TypeHashKey, TypeEmbeddingComp>::update(
               break;
             }
             case Optimizer_t::AdaGrad: {
+              if (use_quantized_opt_state_) {
+                opt_adagrad_kernel_quantized<<<grid_size, block_size,
+                                               embedding_vec_size * sizeof(float), stream>>>(
+                    hash_hash_value_index_count_num, embedding_vec_size, opt_params.lr,
+                    opt_params.hyperparams.adagrad,
+                    reinterpret_cast<int8_t *>(opt_accm_quantized_tensors_.get_ptr()),
+                    opt_accm_scale_tensors_.get_ptr(), sample_id_sort.get_ptr(),
+                    hash_value_index_sort.get_ptr(), hash_value_index_count_offset.get_ptr(),
+                    wgrad.get_ptr(), hash_table_value.get_ptr(), opt_params.scaler);
+                break;
+              }
               opt_adagrad_kernel<<<grid_size, block_size, 0, stream>>>(
                   hash_hash_value_index_count_num, embedding_vec_size, opt_params.lr,
                   opt_params.hyperparams.adagrad, opt_tensor.opt_accm_tensors_.get_ptr(),
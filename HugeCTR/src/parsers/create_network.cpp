@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <activation_arena_planner.hpp>
+#include <cstdlib>
 #include <layer.hpp>
 #include <layers/add_layer.hpp>
 #include <layers/batch_norm_layer.hpp>
@@ -136,6 +138,61 @@ static std::shared_ptr<Regularizer<T>> create_regularizer(
   return reg;
 }
 
+/**
+ * Rewrite the layer graph with fused implementations before any layer is constructed.
+ * Currently the only chain with a fused counterpart in the tree is InnerProduct -> ReLU
+ * (mixed precision), which becomes FusedInnerProduct when the intermediate tensor has no
+ * other consumer and the output width satisfies the fused kernel's alignment. Each rewrite
+ * is reported so the effective graph is visible in the log.
+ */
+static nlohmann::json fuse_layer_graph(const nlohmann::json& j_array, bool use_mixed_precision) {
+  nlohmann::json fused_array = nlohmann::json::array();
+  int num_fused = 0;
+
+  for (unsigned int i = 0; i < j_array.size(); i++) {
+    const nlohmann::json& j = j_array[i];
+    if (i > 0 && i + 1 < j_array.size() && use_mixed_precision &&
+        get_value_from_json<std::string>(j, "type") == "InnerProduct" &&
+        get_value_from_json<std::string>(j_array[i + 1], "type") == "ReLU") {
+      const nlohmann::json& j_relu = j_array[i + 1];
+      std::vector<std::string> ip_tops = get_layer_names(get_json(j, "top"));
+      std::vector<std::string> relu_bottoms = get_layer_names(get_json(j_relu, "bottom"));
+      auto j_fc_param = get_json(j, "fc_param");
+      auto output = get_value_from_json<size_t>(j_fc_param, "num_output");
+
+      if (ip_tops.size() == 1 && relu_bottoms.size() == 1 && ip_tops[0] == relu_bottoms[0] &&
+          output % 64 == 0) {
+        int num_consumers = 0;
+        for (unsigned int k = 1; k < j_array.size(); k++) {
+          if (k == i || !has_key_(j_array[k], "bottom")) continue;
+          for (const auto& name : get_layer_names(get_json(j_array[k], "bottom"))) {
+            if (name == ip_tops[0]) num_consumers++;
+          }
+        }
+        if (num_consumers == 1) {
+          nlohmann::json j_fused = j;
+          j_fused["type"] = "FusedInnerProduct";
+          j_fused["top"] = j_relu["top"];
+          fused_array.push_back(j_fused);
+          HCTR_LOG_S(INFO, ROOT) << "Fused " << get_value_from_json<std::string>(j, "name")
+                                 << " + " << get_value_from_json<std::string>(j_relu, "name")
+                                 << " into FusedInnerProduct" << std::endl;
+          num_fused++;
+          i++;  // the ReLU has been absorbed
+          continue;
+        }
+      }
+    }
+    fused_array.push_back(j);
+  }
+
+  if (num_fused > 0) {
+    HCTR_LOG_S(INFO, ROOT) << "Layer fusion pass replaced " << num_fused << " layer chain(s)"
+                           << std::endl;
+  }
+  return fused_array;
+}
+
 void create_layers(const nlohmann::json& j_array, std::vector<TensorEntry>& tensor_entries,
                    const std::shared_ptr<GeneralBuffer2<CudaAllocator>>& blobs_buff,
                    const std::shared_ptr<BufferBlock2<float>>& weight_buff,
@@ -149,7 +206,9 @@ void create_layers(const nlohmann::json& j_array, std::vector<TensorEntry>& tens
                    std::map<std::string, std::unique_ptr<ILoss>>& losses,
                    metrics::MultiLossMetricMap* raw_metrics,
                    std::vector<Layer*>* top_layers = nullptr,
-                   std::vector<Layer*>* bottom_layers = nullptr) {
+                   std::vector<Layer*>* bottom_layers = nullptr,
+                   ActivationArenaPlanner* arena_planner = nullptr,
+                   std::vector<size_t>* wgrad_watermarks = nullptr) {
   std::vector<TensorEntry> multi_task_output_tensor_entries;
 
   bool skip_dgrad = true;
@@ -1151,12 +1210,18 @@ void create_layers(const nlohmann::json& j_array, std::vector<TensorEntry>& tens
                                      ? (*leading_dim_it).get<int>()
                                      : in_tensor.get_num_elements() / in_dims[0];
             size_t time_step = (j_time_step != j.end()) ? (*j_time_step).get<int>() : 0;
+            std::vector<size_t> out_dims;
             if (time_step == 0) {  // 2D output
-              blobs_buff->reserve({in_tensor.get_num_elements() / leading_dim, leading_dim},
-                                  &out_tensor);
+              out_dims = {in_tensor.get_num_elements() / leading_dim, leading_dim};
             } else {  // 3D output
               size_t batch_size = in_tensor.get_num_elements() / leading_dim / time_step;
-              blobs_buff->reserve({batch_size, time_step, leading_dim}, &out_tensor);
+              out_dims = {batch_size, time_step, leading_dim};
+            }
+            if (std::getenv("HCTR_ZERO_COPY_RESHAPE")) {
+              // A pure reshape can alias the input buffer; the layer skips its copy for views.
+              out_tensor = in_tensor.reshape(out_dims);
+            } else {
+              blobs_buff->reserve(out_dims, &out_tensor);
             }
             emplaceback_layer(
                 new ReshapeLayer<__half>(in_tensor, out_tensor, blobs_buff, gpu_resource));
@@ -1170,12 +1235,17 @@ void create_layers(const nlohmann::json& j_array, std::vector<TensorEntry>& tens
                                      ? (*leading_dim_it).get<int>()
                                      : in_tensor.get_num_elements() / in_dims[0];
             size_t time_step = (j_time_step != j.end()) ? (*j_time_step).get<int>() : 0;
+            std::vector<size_t> out_dims;
             if (time_step == 0) {  // 2D output
-              blobs_buff->reserve({in_tensor.get_num_elements() / leading_dim, leading_dim},
-                                  &out_tensor);
+              out_dims = {in_tensor.get_num_elements() / leading_dim, leading_dim};
             } else {  // 3D output
               size_t batch_size = in_tensor.get_num_elements() / leading_dim / time_step;
-              blobs_buff->reserve({batch_size, time_step, leading_dim}, &out_tensor);
+              out_dims = {batch_size, time_step, leading_dim};
+            }
+            if (std::getenv("HCTR_ZERO_COPY_RESHAPE")) {
+              out_tensor = in_tensor.reshape(out_dims);
+            } else {
+              blobs_buff->reserve(out_dims, &out_tensor);
             }
             emplaceback_layer(
                 new ReshapeLayer<float>(in_tensor, out_tensor, blobs_buff, gpu_resource));
@@ -1380,6 +1450,23 @@ void create_layers(const nlohmann::json& j_array, std::vector<TensorEntry>& tens
       }
     }
 
+    if (arena_planner) {
+      std::vector<TensorBag2> output_bags;
+      for (const auto& output_tensor_entry : output_tensor_entries) {
+        output_bags.push_back(output_tensor_entry.bag);
+      }
+      arena_planner->add_layer(input_output_info.inputs, output_bags);
+    }
+
+    // One watermark per created layer: the wgrad block size once the layer has reserved its
+    // gradients. resize() fills only the entries of the layers appended in this iteration, so
+    // the vector stays aligned with `layers` even when an iteration creates none or several.
+    if (wgrad_watermarks) {
+      wgrad_watermarks->resize(layers.size(), use_mixed_precision
+                                                  ? wgrad_buff_half->get_num_elements()
+                                                  : wgrad_buff->get_num_elements());
+    }
+
     skip_dgrad = false;
   }  // for layers
 
@@ -1426,6 +1513,15 @@ Network* Network::create_network(const nlohmann::json& j_array, const nlohmann::
                                  bool grouped_all_reduce) {
   Network* network = new Network(cpu_resource, gpu_resource, use_mixed_precision);
 
+  // With HCTR_FUSE_LAYERS set, substitute fused layer implementations for the chains they
+  // cover instead of relying on the model author to hand-assemble them.
+  nlohmann::json fused_j_array;
+  const nlohmann::json* layer_array = &j_array;
+  if (std::getenv("HCTR_FUSE_LAYERS")) {
+    fused_j_array = fuse_layer_graph(j_array, use_mixed_precision);
+    layer_array = &fused_j_array;
+  }
+
   auto& train_layers = network->train_layers_;
   auto* bottom_layers = &network->bottom_layers_;
   auto* top_layers = &network->top_layers_;
@@ -1481,19 +1577,25 @@ Network* Network::create_network(const nlohmann::json& j_array, const nlohmann::
   // TODO: implement multiple loss support in create_layers
   if (!inference_flag) {
     // create train layers
-    create_layers(j_array, train_tensor_entries, blobs_buff, train_weight_buff,
+    create_layers(*layer_array, train_tensor_entries, blobs_buff, train_weight_buff,
                   train_weight_buff_half, wgrad_buff, wgrad_buff_half, train_loss_tensors,
                   gpu_resource, use_mixed_precision, enable_tf32_compute, num_networks_in_global,
                   scaler, inference_flag, train_layers, train_losses, nullptr, top_layers,
-                  bottom_layers);
+                  bottom_layers, nullptr, &network->train_layer_wgrad_watermarks_);
   }
 
+  // Inference runs forward only, so activations with disjoint lifetimes can share memory.
+  // The planner watches the layers as they are created and later assigns overlapping arena
+  // offsets to the activation buffers.
+  ActivationArenaPlanner arena_planner;
+  const bool use_activation_arena = inference_flag && std::getenv("HCTR_ACTIVATION_ARENA");
+
   // create evaluate layers
-  create_layers(j_array, evaluate_tensor_entries, blobs_buff, evaluate_weight_buff,
+  create_layers(*layer_array, evaluate_tensor_entries, blobs_buff, evaluate_weight_buff,
                 evaluate_weight_buff_half, wgrad_buff_placeholder, wgrad_buff_half_placeholder,
                 evaluate_loss_tensors, gpu_resource, use_mixed_precision, enable_tf32_compute,
                 num_networks_in_global, scaler, inference_flag, evaluate_layers, evaluate_losses,
-                &raw_metrics);
+                &raw_metrics, nullptr, nullptr, use_activation_arena ? &arena_planner : nullptr);
 
   // create optimizer
   if (!inference_flag) {
@@ -1533,6 +1635,21 @@ Network* Network::create_network(const nlohmann::json& j_array, const nlohmann::
   network->opt_tensor_ = opt_buff->as_tensor();
   network->opt_tensor_half_ = opt_buff_half->as_tensor();
 
+  if (use_activation_arena) {
+    // The prediction tensor is read after the network has finished, so it keeps its own
+    // allocation.
+    if (!evaluate_tensor_entries.empty()) {
+      arena_planner.pin(evaluate_tensor_entries.back().bag);
+    }
+    std::map<TensorBuffer2*, size_t> arena_offsets;
+    size_t arena_size = arena_planner.plan(&arena_offsets);
+    blobs_buff->set_overlapped_offsets(arena_offsets, arena_size);
+    HCTR_LOG_S(INFO, ROOT) << "HCTR_ACTIVATION_ARENA is set. Activations share a "
+                           << arena_size / (1024.0 * 1024.0) << " MB arena instead of "
+                           << arena_planner.get_total_size_in_bytes() / (1024.0 * 1024.0)
+                           << " MB of dedicated allocations." << std::endl;
+  }
+
   CudaDeviceContext context(gpu_resource->get_device_id());
   blobs_buff->allocate();
 
@@ -58,6 +58,11 @@ void InferenceParser::create_pipeline_inference(
   CudaDeviceContext context(
       resource_manager->get_local_gpu_from_device_id(inference_params.device_id)->get_device_id());
   input_buffer->allocate();
+  // Embedding-only sessions pass network == nullptr: the dense layers are never executed, so
+  // neither their parameters nor their forward buffers need to be materialized.
+  if (network == nullptr) {
+    return;
+  }
   // TODO: perhaps it is better to make a wrapper of this function for the inference
   // rather than passing unused parameters here.
   std::shared_ptr<ExchangeWgrad> exchange_wgrad_dummy;
@@ -68,6 +73,8 @@ void InferenceParser::create_pipeline_inference(
       inference_params.use_mixed_precision, false, inference_params.scaler, false, true, false);
 }
 
+// network may be nullptr, in which case only the embedding inputs and feature combiners are
+// created (embedding-only serving).
 void InferenceParser::create_pipeline(const InferenceParams& inference_params,
                                       TensorBag2& dense_input_bag,
                                       std::vector<std::shared_ptr<Tensor2<int>>>& rows,
@@ -15,6 +15,8 @@
  */
 #include "pipeline.hpp"
 
+#include "pipeline_profiler.hpp"
+
 namespace HugeCTR {
 
 Scheduleable::Scheduleable()
@@ -55,6 +57,126 @@ cudaEvent_t Scheduleable::record_done(bool external, unsigned int flags) {
   return completion_event_.value();
 }
 
+void Scheduleable::declare_access(const std::vector<const void *> &reads,
+                                  const std::vector<const void *> &writes) {
+  reads_ = reads;
+  writes_ = writes;
+}
+
+InferredSchedule infer_schedule(const std::vector<std::vector<const void *>> &reads,
+                                const std::vector<std::vector<const void *>> &writes,
+                                size_t max_streams) {
+  HCTR_CHECK_HINT(reads.size() == writes.size(), "inconsistent access set sizes.");
+  HCTR_CHECK_HINT(max_streams >= 1, "at least one stream is required.");
+  const size_t count = reads.size();
+
+  auto intersects = [](const std::vector<const void *> &a, const std::vector<const void *> &b) {
+    for (const void *pa : a) {
+      for (const void *pb : b) {
+        if (pa == pb) {
+          return true;
+        }
+      }
+    }
+    return false;
+  };
+
+  // Direct dependencies from the RAW, WAW and WAR hazards in program order, plus the
+  // reachability needed to drop the edges already enforced transitively.
+  std::vector<std::vector<bool>> depends(count, std::vector<bool>(count, false));
+  std::vector<std::vector<bool>> reaches(count, std::vector<bool>(count, false));
+  for (size_t j = 0; j < count; j++) {
+    for (size_t i = 0; i < j; i++) {
+      depends[j][i] = intersects(writes[i], reads[j]) || intersects(writes[i], writes[j]) ||
+                      intersects(reads[i], writes[j]);
+      if (depends[j][i]) {
+        reaches[j][i] = true;
+        for (size_t k = 0; k < i; k++) {
+          reaches[j][k] = reaches[j][k] || reaches[i][k];
+        }
+      }
+    }
+  }
+
+  InferredSchedule schedule;
+  schedule.stream_id.assign(count, 0);
+  schedule.wait_on.resize(count);
+
+  // A node stays on the stream of its latest producer when it is still that stream's tail, so
+  // dependency chains run back to back without events; independent work opens a new stream.
+  std::vector<int> tail(max_streams, -1);
+  for (size_t j = 0; j < count; j++) {
+    std::vector<size_t> minimal;
+    for (size_t i = 0; i < j; i++) {
+      if (!depends[j][i]) {
+        continue;
+      }
+      bool covered = false;
+      for (size_t k = i + 1; k < j && !covered; k++) {
+        covered = depends[j][k] && reaches[k][i];
+      }
+      if (!covered) {
+        minimal.push_back(i);
+      }
+    }
+
+    int stream = -1;
+    for (auto it = minimal.rbegin(); it != minimal.rend(); ++it) {
+      if (tail[schedule.stream_id[*it]] == static_cast<int>(*it)) {
+        stream = schedule.stream_id[*it];
+        break;
+      }
+    }
+    if (stream < 0) {
+      for (size_t s = 0; s < max_streams; s++) {
+        if (tail[s] < 0) {
+          stream = s;
+          break;
+        }
+      }
+    }
+    if (stream < 0) {
+      // All streams are busy: pick the one whose tail is oldest to limit false serialization.
+      stream = 0;
+      for (size_t s = 1; s < max_streams; s++) {
+        if (tail[s] < tail[stream]) {
+          stream = s;
+        }
+      }
+    }
+    schedule.stream_id[j] = stream;
+    tail[stream] = j;
+    schedule.wait_on[j] = std::move(minimal);
+  }
+  return schedule;
+}
+
+void auto_schedule(const std::vector<std::shared_ptr<Scheduleable>> &scheduleable_list,
+                   size_t max_streams) {
+  std::vector<std::vector<const void *>> reads, writes;
+  for (const auto &scheduleable : scheduleable_list) {
+    reads.push_back(scheduleable->get_reads());
+    writes.push_back(scheduleable->get_writes());
+  }
+  InferredSchedule schedule = infer_schedule(reads, writes, max_streams);
+
+  for (size_t j = 0; j < scheduleable_list.size(); j++) {
+    // Stream 0 keeps the calling stream name so a fully serial list schedules like before.
+    if (schedule.stream_id[j] != 0) {
+      scheduleable_list[j]->set_stream("auto" + std::to_string(schedule.stream_id[j]));
+    }
+    std::vector<cudaEvent_t> wait_events;
+    for (size_t producer : schedule.wait_on[j]) {
+      if (schedule.stream_id[producer] != schedule.stream_id[j]) {
+        wait_events.push_back(scheduleable_list[producer]->record_done());
+      }
+    }
+    if (!wait_events.empty()) {
+      scheduleable_list[j]->wait_event(wait_events);
+    }
+  }
+}
+
 StreamContextScheduleable::StreamContextScheduleable(std::function<void()> workload)
     : workload_(workload) {}
 
@@ -78,7 +200,12 @@ void StreamContextScheduleable::run(std::shared_ptr<GPUResource> gpu, bool use_g
             wait_external_ && use_graph ? cudaEventWaitExternal : cudaEventWaitDefault));
       }
     }
+    // Timing events must not end up inside a graph capture, so the graph path is not profiled.
+    void *profiler_handle =
+        use_graph ? NULL
+                  : PipelineProfiler::get().begin_stage(name_, gpu->get_device_id(), stream);
     workload_();
+    PipelineProfiler::get().end_stage(profiler_handle, stream);
     if (completion_event_.has_value()) {
       HCTR_LIB_THROW(cudaEventRecordWithFlags(
           completion_event_.value(), stream,
@@ -93,8 +220,11 @@ Pipeline::Pipeline(const std::string &stream_name, std::shared_ptr<GPUResource>
       gpu_resource_(gpu_resource),
       scheduleable_list_(scheduleable_list) {
   StreamContext stream_context(gpu_resource_, stream_name_);
-  for (auto &scheduleable : scheduleable_list_) {
-    scheduleable->run(gpu_resource_, false, true);
+  for (size_t i = 0; i < scheduleable_list_.size(); i++) {
+    if (scheduleable_list_[i]->get_name().empty()) {
+      scheduleable_list_[i]->set_name(stream_name_ + ":stage" + std::to_string(i));
+    }
+    scheduleable_list_[i]->run(gpu_resource_, false, true);
   }
 }
 
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2021, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <common.hpp>
+#include <cstdlib>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <pipeline_profiler.hpp>
+
+namespace HugeCTR {
+
+namespace {
+
+// Bounds the memory held per stage; once reached, the oldest samples are overwritten so the
+// report reflects the most recent iterations.
+constexpr size_t max_samples_per_stage = 65536;
+
+float percentile(const std::vector<float>& sorted_samples, float p) {
+  size_t idx = static_cast<size_t>(p / 100.f * (sorted_samples.size() - 1) + 0.5f);
+  return sorted_samples[idx];
+}
+
+}  // namespace
+
+PipelineProfiler& PipelineProfiler::get() {
+  static PipelineProfiler profiler;
+  return profiler;
+}
+
+PipelineProfiler::PipelineProfiler() {
+  if (std::getenv("HCTR_PROFILE_PIPELINE")) {
+    enabled_ = true;
+    HCTR_LOG_S(INFO, ROOT) << "Pipeline profiler enabled" << std::endl;
+  }
+}
+
+PipelineProfiler::~PipelineProfiler() {
+  for (auto& stage : stages_) {
+    for (auto& pair : stage.second.free_pairs_) {
+      cudaEventDestroy(pair.first);
+      cudaEventDestroy(pair.second);
+    }
+    for (auto& pair : stage.second.inflight_pairs_) {
+      cudaEventDestroy(pair.first);
+      cudaEventDestroy(pair.second);
+    }
+  }
+}
+
+void PipelineProfiler::harvest(StageStats& stats) {
+  auto it = stats.inflight_pairs_.begin();
+  while (it != stats.inflight_pairs_.end()) {
+    cudaError_t err = cudaEventQuery(it->second);
+    if (err == cudaErrorNotReady) {
+      break;  // the pairs complete in submission order, the rest is still pending
+    }
+    HCTR_LIB_THROW(err);
+    float elapsed_ms = 0.f;
+    HCTR_LIB_THROW(cudaEventElapsedTime(&elapsed_ms, it->first, it->second));
+    if (stats.samples_ms_.size() < max_samples_per_stage) {
+      stats.samples_ms_.push_back(elapsed_ms);
+    } else {
+      stats.samples_ms_[stats.next_sample_ % max_samples_per_stage] = elapsed_ms;
+    }
+    stats.next_sample_++;
+    stats.free_pairs_.push_back(*it);
+    it = stats.inflight_pairs_.erase(it);
+  }
+}
+
+void* PipelineProfiler::begin_stage(const std::string& name, int device_id, cudaStream_t stream) {
+  if (!enabled_) {
+    return NULL;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& stats = stages_[name + "@" + std::to_string(device_id)];
+  stats.device_id_ = device_id;
+  harvest(stats);
+
+  std::pair<cudaEvent_t, cudaEvent_t> events;
+  if (!stats.free_pairs_.empty()) {
+    events = stats.free_pairs_.back();
+    stats.free_pairs_.pop_back();
+  } else {
+    HCTR_LIB_THROW(cudaEventCreate(&events.first));
+    HCTR_LIB_THROW(cudaEventCreate(&events.second));
+  }
+  HCTR_LIB_THROW(cudaEventRecord(events.first, stream));
+  return new Handle{&stats, events};
+}
+
+void PipelineProfiler::end_stage(void* handle, cudaStream_t stream) {
+  if (!handle) {
+    return;
+  }
+  std::unique_ptr<Handle> stage_handle(static_cast<Handle*>(handle));
+  HCTR_LIB_THROW(cudaEventRecord(stage_handle->events.second, stream));
+  std::lock_guard<std::mutex> lock(mutex_);
+  stage_handle->stats->inflight_pairs_.push_back(stage_handle->events);
+}
+
+std::string PipelineProfiler::report_json() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  nlohmann::json report;
+  report["stages"] = nlohmann::json::array();
+  for (auto& stage : stages_) {
+    harvest(stage.second);
+    if (stage.second.samples_ms_.empty()) {
+      continue;
+    }
+    std::vector<float> sorted_samples = stage.second.samples_ms_;
+    std::sort(sorted_samples.begin(), sorted_samples.end());
+    float sum = 0.f;
+    for (float sample : sorted_samples) {
+      sum += sample;
+    }
+
+    nlohmann::json entry;
+    entry["name"] = stage.first.substr(0, stage.first.rfind('@'));
+    entry["device_id"] = stage.second.device_id_;
+    entry["count"] = stage.second.next_sample_;
+    entry["avg_ms"] = sum / sorted_samples.size();
+    entry["p50_ms"] = percentile(sorted_samples, 50.f);
+    entry["p99_ms"] = percentile(sorted_samples, 99.f);
+    entry["max_ms"] = sorted_samples.back();
+    report["stages"].push_back(entry);
+  }
+  return report.dump(2);
+}
+
+void PipelineProfiler::dump_json(const std::string& path) {
+  std::ofstream output_stream(path);
+  if (!output_stream.is_open()) {
+    HCTR_OWN_THROW(Error_t::WrongInput, "Cannot open output file " + path);
+  }
+  output_stream << report_json();
+}
+
+void PipelineProfiler::reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& stage : stages_) {
+    harvest(stage.second);
+    stage.second.samples_ms_.clear();
+    stage.second.next_sample_ = 0;
+  }
+}
+}  // namespace HugeCTR
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <cstdlib>
 #include <layer.hpp>
 #include <layers/add_layer.hpp>
 #include <layers/batch_norm_layer.hpp>
@@ -814,6 +815,20 @@ static InputOutputInfo get_input_tensor_and_output_name(
   return {bottom_bags, top_names};
 }
 
+/**
+ * Attaches the optional third bottom of a loss layer as per-sample weights; must be a
+ * [batch, 1] float tensor (it reaches here through the regular multi-label plumbing).
+ */
+static void set_sample_weight_tensor(ILoss& loss, const std::vector<TensorBag2>& inputs) {
+  Tensor2<float> weight_tensor = Tensor2<float>::stretch_from(inputs[2]);
+  const std::vector<size_t> expected_dims{inputs[0].get_dimensions()[0], 1};
+  if (weight_tensor.get_dimensions() != expected_dims) {
+    HCTR_OWN_THROW(Error_t::WrongInput,
+                   "the per-sample weight tensor of a loss must have shape [batch, 1]");
+  }
+  loss.set_sample_weight_tensor(weight_tensor);
+}
+
 template <typename T>
 static std::shared_ptr<Regularizer<T>> create_regularizer(
     bool use_regularizer, Regularizer_t regularizer_type, float lambda,
@@ -942,8 +957,10 @@ void Model::add_dense_layer_internal(
       break;
     }
     case Layer_t::BinaryCrossEntropyLoss: {
-      if (input_output_info.inputs.size() != 2) {
-        HCTR_OWN_THROW(Error_t::WrongInput, "bottom of BinaryCrossEntropyLoss must be two dim");
+      if (input_output_info.inputs.size() != 2 && input_output_info.inputs.size() != 3) {
+        HCTR_OWN_THROW(Error_t::WrongInput,
+                       "bottom of BinaryCrossEntropyLoss must be two dim (plus an optional "
+                       "[batch, 1] per-sample weight tensor)");
       }
       if (input_output_info.inputs[0].get_dimensions() !=
           input_output_info.inputs[1].get_dimensions()) {
@@ -981,6 +998,9 @@ void Model::add_dense_layer_internal(
             label_tensor, in_tensor, new_loss_tensor, regularizer, gpu_resource,
             num_networks_in_global, scaler, solver_.gen_loss_summary));
       }
+      if (input_output_info.inputs.size() == 3) {
+        set_sample_weight_tensor(*new_loss, input_output_info.inputs);
+      }
 
       loss_tensors.insert(std::pair(name, new_loss_tensor));
       losses.insert(std::pair(name, std::move(new_loss)));
@@ -1022,15 +1042,23 @@ void Model::add_dense_layer_internal(
       break;
     }
     case Layer_t::CrossEntropyLoss: {
-      if (input_output_info.inputs.size() != 2) {
-        HCTR_OWN_THROW(Error_t::WrongInput, "bottom of CrossEntropyLoss must be two dim");
-      }
-      if (input_output_info.inputs[0].get_dimensions() !=
-          input_output_info.inputs[1].get_dimensions()) {
+      if (input_output_info.inputs.size() != 2 && input_output_info.inputs.size() != 3) {
+        HCTR_OWN_THROW(Error_t::WrongInput,
+                       "bottom of CrossEntropyLoss must be two dim (plus an optional [batch, 1] "
+                       "per-sample weight tensor)");
+      }
+      // Heads wider than two classes take the target class index as the label, i.e. a
+      // [batch, 1] label tensor; the two-class case keeps the legacy same-shape contract.
+      const auto& pred_dims = input_output_info.inputs[0].get_dimensions();
+      const auto& label_dims = input_output_info.inputs[1].get_dimensions();
+      const bool multiclass_index_label = pred_dims.size() == 2 && pred_dims[1] > 2 &&
+                                          label_dims.size() == 2 && label_dims[0] == pred_dims[0] &&
+                                          label_dims[1] == 1;
+      if (pred_dims != label_dims && !multiclass_index_label) {
         std::string err_msg =
-            "predition tensor and label tensor should have the same shape, got: " +
-            v2s(input_output_info.inputs[0].get_dimensions()) + " and " +
-            v2s(input_output_info.inputs[1].get_dimensions());
+            "predition tensor and label tensor should have the same shape (or [batch, 1] "
+            "class-index labels for a multi-class head), got: " +
+            v2s(pred_dims) + " and " + v2s(label_dims);
         HCTR_OWN_THROW(Error_t::WrongInput, err_msg.c_str());
       }
       Tensor2<float> label_tensor = Tensor2<float>::stretch_from(input_output_info.inputs[1]);
@@ -1063,6 +1091,9 @@ void Model::add_dense_layer_internal(
                                cross_entropy_loss_in_tensor.get_dimensions()[0], gpu_resource),
             gpu_resource, num_networks_in_global, scaler));
       }
+      if (input_output_info.inputs.size() == 3) {
+        set_sample_weight_tensor(*new_loss, input_output_info.inputs);
+      }
       loss_tensors.insert(std::pair(name, new_loss_tensor));
       losses.insert(std::pair(name, std::move(new_loss)));
       break;
@@ -1279,8 +1310,10 @@ void Model::add_dense_layer_internal(
       break;
     }
     case Layer_t::MultiHeadAttention: {
-      if (input_output_info.inputs.size() != 2) {
-        HCTR_OWN_THROW(Error_t::WrongInput, "MultiHeadAttentionLayer needs two input tensors ");
+      if (input_output_info.inputs.size() != 2 && input_output_info.inputs.size() != 3) {
+        HCTR_OWN_THROW(Error_t::WrongInput,
+                       "MultiHeadAttentionLayer needs two (query, key) or three (query, key, "
+                       "value) input tensors ");
       }
       if (use_mixed_precision) {
         Tensors2<__half> in_tensors;
@@ -1391,8 +1424,10 @@ void Model::add_dense_layer_internal(
       break;
     }
     case Layer_t::MultiCrossEntropyLoss: {
-      if (input_output_info.inputs.size() != 2) {
-        HCTR_OWN_THROW(Error_t::WrongInput, "bottom of MultiCrossEntropyLoss must be two dim");
+      if (input_output_info.inputs.size() != 2 && input_output_info.inputs.size() != 3) {
+        HCTR_OWN_THROW(Error_t::WrongInput,
+                       "bottom of MultiCrossEntropyLoss must be two dim (plus an optional "
+                       "[batch, 1] per-sample weight tensor)");
       }
       if (input_output_info.inputs[0].get_dimensions() !=
           input_output_info.inputs[1].get_dimensions()) {
@@ -1432,23 +1467,46 @@ void Model::add_dense_layer_internal(
                 multi_cross_entropy_loss_in_tensor.get_dimensions()[0], gpu_resource),
             dense_layer.target_weight_vec, gpu_resource, num_networks_in_global, scaler));
       }
+      if (input_output_info.inputs.size() == 3) {
+        set_sample_weight_tensor(*new_loss, input_output_info.inputs);
+      }
       loss_tensors.insert(std::pair(name, new_loss_tensor));
       losses.insert(std::pair(name, std::move(new_loss)));
       break;
     }
     case Layer_t::ReLU: {
+      // With HCTR_RECOMPUTE_ACTIVATIONS set, ReLU runs in place on its input buffer and keeps
+      // only a packed 1-bit-per-element sign mask for backward instead of a full copy of the
+      // activation. Only valid when the pre-activation is not consumed by another layer.
+      bool recompute = std::getenv("HCTR_RECOMPUTE_ACTIVATIONS") != nullptr;
       if (use_mixed_precision) {
         Tensor2<__half> relu_in_tensor = Tensor2<__half>::stretch_from(input_output_info.inputs[0]);
         Tensor2<__half> relu_out_tensor;
-        blobs_buff->reserve(relu_in_tensor.get_dimensions(), &relu_out_tensor);
-        layers.emplace_back(new ReluLayer<__half>(relu_in_tensor, relu_out_tensor, gpu_resource));
+        if (recompute) {
+          relu_out_tensor = relu_in_tensor;
+          Tensor2<unsigned int> mask_tensor;
+          blobs_buff->reserve({(relu_in_tensor.get_num_elements() + 31) / 32}, &mask_tensor);
+          layers.emplace_back(
+              new ReluLayer<__half>(relu_in_tensor, relu_out_tensor, mask_tensor, gpu_resource));
+        } else {
+          blobs_buff->reserve(relu_in_tensor.get_dimensions(), &relu_out_tensor);
+          layers.emplace_back(new ReluLayer<__half>(relu_in_tensor, relu_out_tensor, gpu_resource));
+        }
         output_tensor_entries.push_back(
             {input_output_info.output_names[0], relu_out_tensor.shrink()});
       } else {
         Tensor2<float> relu_in_tensor = Tensor2<float>::stretch_from(input_output_info.inputs[0]);
         Tensor2<float> relu_out_tensor;
-        blobs_buff->reserve(relu_in_tensor.get_dimensions(), &relu_out_tensor);
-        layers.emplace_back(new ReluLayer<float>(relu_in_tensor, relu_out_tensor, gpu_resource));
+        if (recompute) {
+          relu_out_tensor = relu_in_tensor;
+          Tensor2<unsigned int> mask_tensor;
+          blobs_buff->reserve({(relu_in_tensor.get_num_elements() + 31) / 32}, &mask_tensor);
+          layers.emplace_back(
+              new ReluLayer<float>(relu_in_tensor, relu_out_tensor, mask_tensor, gpu_resource));
+        } else {
+          blobs_buff->reserve(relu_in_tensor.get_dimensions(), &relu_out_tensor);
+          layers.emplace_back(new ReluLayer<float>(relu_in_tensor, relu_out_tensor, gpu_resource));
+        }
         output_tensor_entries.push_back(
             {input_output_info.output_names[0], relu_out_tensor.shrink()});
       }
@@ -1476,12 +1534,18 @@ void Model::add_dense_layer_internal(
         if (use_mixed_precision) {
           Tensor2<__half> in_tensor = Tensor2<__half>::stretch_from(input_output_info.inputs[0]);
           Tensor2<__half> out_tensor;
+          std::vector<size_t> out_dims;
           if (time_step == 0) {  // 2D output
-            blobs_buff->reserve({in_tensor.get_num_elements() / leading_dim, leading_dim},
-                                &out_tensor);
+            out_dims = {in_tensor.get_num_elements() / leading_dim, leading_dim};
           } else {  // 3D output
             size_t batch_size = in_tensor.get_num_elements() / leading_dim / time_step;
-            blobs_buff->reserve({batch_size, time_step, leading_dim}, &out_tensor);
+            out_dims = {batch_size, time_step, leading_dim};
+          }
+          if (std::getenv("HCTR_ZERO_COPY_RESHAPE")) {
+            // A pure reshape can alias the input buffer; the layer skips its copy for views.
+            out_tensor = in_tensor.reshape(out_dims);
+          } else {
+            blobs_buff->reserve(out_dims, &out_tensor);
           }
           layers.emplace_back(
               new ReshapeLayer<__half>(in_tensor, out_tensor, blobs_buff, gpu_resource));
@@ -1489,12 +1553,17 @@ void Model::add_dense_layer_internal(
         } else {
           Tensor2<float> in_tensor = Tensor2<float>::stretch_from(input_output_info.inputs[0]);
           Tensor2<float> out_tensor;
+          std::vector<size_t> out_dims;
           if (time_step == 0) {  // 2D output
-            blobs_buff->reserve({in_tensor.get_num_elements() / leading_dim, leading_dim},
-                                &out_tensor);
+            out_dims = {in_tensor.get_num_elements() / leading_dim, leading_dim};
           } else {  // 3D output
             size_t batch_size = in_tensor.get_num_elements() / leading_dim / time_step;
-            blobs_buff->reserve({batch_size, time_step, leading_dim}, &out_tensor);
+            out_dims = {batch_size, time_step, leading_dim};
+          }
+          if (std::getenv("HCTR_ZERO_COPY_RESHAPE")) {
+            out_tensor = in_tensor.reshape(out_dims);
+          } else {
+            blobs_buff->reserve(out_dims, &out_tensor);
           }
           layers.emplace_back(
               new ReshapeLayer<float>(in_tensor, out_tensor, blobs_buff, gpu_resource));
@@ -1657,10 +1726,20 @@ void Model::add_dense_layer_internal(
       Tensor2<float> in_tensor = Tensor2<float>::stretch_from(input_output_info.inputs[0]);
       Tensor2<float> gru_out_tensor;
       blobs_buff->reserve({in_tensor.get_dimensions()[0], dense_layer.num_output}, &gru_out_tensor);
-      layers.emplace_back(new GRULayer<float>(weight_buff, wgrad_buff, in_tensor, gru_out_tensor,
-                                              dense_layer.num_output, dense_layer.batchsize,
-                                              dense_layer.SeqLength, dense_layer.vector_size,
-                                              gpu_resource, initializer_types));
+      if (input_output_info.inputs.size() == 2) {
+        // The optional second input carries the per-sample sequence lengths, so the padded
+        // time steps are skipped instead of computed.
+        Tensor2<float> seq_len_tensor = Tensor2<float>::stretch_from(input_output_info.inputs[1]);
+        layers.emplace_back(new GRULayer<float>(
+            weight_buff, wgrad_buff, in_tensor, seq_len_tensor, gru_out_tensor,
+            dense_layer.num_output, dense_layer.batchsize, dense_layer.SeqLength,
+            dense_layer.vector_size, gpu_resource, initializer_types));
+      } else {
+        layers.emplace_back(new GRULayer<float>(weight_buff, wgrad_buff, in_tensor, gru_out_tensor,
+                                                dense_layer.num_output, dense_layer.batchsize,
+                                                dense_layer.SeqLength, dense_layer.vector_size,
+                                                gpu_resource, initializer_types));
+      }
       output_tensor_entries.push_back({input_output_info.output_names[0], gru_out_tensor.shrink()});
 
       break;
@@ -1936,8 +2015,11 @@ void calculate_tensor_dimensions(std::map<std::string, std::vector<int>>& tensor
       auto& dim1 = tensor_shape_info_raw[dense_layer.bottom_names[0]];
       auto& dim2 = tensor_shape_info_raw[dense_layer.bottom_names[1]];
       if (dim1.size() == 4) {
+        // with a value input the fused layer emits [head, batch, seq, head_dim] instead of
+        // the score matrix
+        int out_last_dim = dense_layer.bottom_names.size() == 3 ? dim1[3] : dim2[2];
         tensor_shape_info_raw.insert(std::make_pair(
-            dense_layer.top_names[0], std::vector<int>{dim1[0], dim1[1], dim1[2], dim2[2]}));
+            dense_layer.top_names[0], std::vector<int>{dim1[0], dim1[1], dim1[2], out_last_dim}));
       } else {
         HCTR_OWN_THROW(Error_t::WrongInput, "MultiHeadAttentionLayer needs two 4D input tensors ");
       }
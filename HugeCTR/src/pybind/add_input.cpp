@@ -83,6 +83,12 @@ void add_input(Input& input, DataReaderParams& reader_params,
   long long num_samples = reader_params.num_samples;
   long long eval_num_samples = reader_params.eval_num_samples;
   bool float_label_dense = reader_params.float_label_dense;
+
+  // Worker threads and their pinned staging buffers are placed on the NUMA node closest to the
+  // target GPU through CudaCPUDeviceContext. Some topologies (or external pinning via numactl)
+  // want this off.
+  CudaCPUDeviceContext::set_numa_pinning_enabled(reader_params.numa_pinning);
+
   // TODO - changes structures to support multiple labels
   std::string top_strs_dense = input.dense_name;
   int dense_dim = input.dense_dim;
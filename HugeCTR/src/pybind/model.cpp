@@ -19,11 +19,14 @@
 #include <HugeCTR/include/base/debug/logger.hpp>
 #include <HugeCTR/include/resource_managers/resource_manager_ext.hpp>
 #include <algorithm>
+#include <cstdlib>
 #include <data_readers/async_reader/async_reader_adapter.hpp>
 #include <embeddings/hybrid_sparse_embedding.hpp>
+#include <gemm_algo_cache.hpp>
 #include <fstream>
 #include <iomanip>
 #include <iterator>
+#include <pipeline_profiler.hpp>
 #include <pybind/model.hpp>
 #include <sstream>
 
@@ -144,7 +147,7 @@ DataReaderParams::DataReaderParams(DataReaderType_t data_reader_type,
                                    bool float_label_dense, bool read_file_sequentially,
                                    int num_workers, std::vector<long long>& slot_size_array,
                                    const DataSourceParams& data_source_params,
-                                   const AsyncParam& async_param)
+                                   const AsyncParam& async_param, bool numa_pinning)
     : data_reader_type(data_reader_type),
       source(source),
       keyset(keyset),
@@ -158,7 +161,8 @@ DataReaderParams::DataReaderParams(DataReaderType_t data_reader_type,
       num_workers(num_workers),
       slot_size_array(slot_size_array),
       data_source_params(data_source_params),
-      async_param(async_param) {}
+      async_param(async_param),
+      numa_pinning(numa_pinning) {}
 
 DataReaderParams::DataReaderParams(DataReaderType_t data_reader_type, std::string source,
                                    std::string keyset, std::string eval_source, Check_t check_type,
@@ -167,7 +171,7 @@ DataReaderParams::DataReaderParams(DataReaderType_t data_reader_type, std::strin
                                    bool read_file_sequentially, int num_workers,
                                    std::vector<long long>& slot_size_array,
                                    const DataSourceParams& data_source_params,
-                                   const AsyncParam& async_param)
+                                   const AsyncParam& async_param, bool numa_pinning)
     : data_reader_type(data_reader_type),
       eval_source(eval_source),
       check_type(check_type),
@@ -179,7 +183,8 @@ DataReaderParams::DataReaderParams(DataReaderType_t data_reader_type, std::strin
       num_workers(num_workers),
       slot_size_array(slot_size_array),
       data_source_params(data_source_params),
-      async_param(async_param) {
+      async_param(async_param),
+      numa_pinning(numa_pinning) {
   this->source.push_back(source);
   this->keyset.push_back(keyset);
 }
@@ -442,7 +447,17 @@ Model::Model(const Solver& solver, const DataReaderParams& reader_params,
     HCTR_OWN_THROW(Error_t::WrongInput,
                    " The data source for training and evaluation should be specified");
   }
-  if (etc_params_->use_embedding_training_cache && solver_.kafka_brokers.length()) {
+  if (const char* kafka_sync_env = std::getenv("HCTR_KAFKA_SYNC_INTERVAL")) {
+    kafka_sync_interval_ = std::strtoull(kafka_sync_env, nullptr, 10);
+    if (kafka_sync_interval_ > 0 && !solver_.kafka_brokers.length()) {
+      HCTR_LOG_S(WARNING, ROOT) << "HCTR_KAFKA_SYNC_INTERVAL is set, but no Kafka brokers were "
+                                   "configured; incremental publication stays disabled."
+                                << std::endl;
+      kafka_sync_interval_ = 0;
+    }
+  }
+  if ((etc_params_->use_embedding_training_cache || kafka_sync_interval_ > 0) &&
+      solver_.kafka_brokers.length()) {
     message_sink_.reset(new KafkaMessageSink<long long>(solver_.kafka_brokers));
   }
   if (etc_params_->use_embedding_training_cache && solver_.repeat_dataset) {
@@ -465,6 +480,23 @@ Model::Model(const Solver& solver, const DataReaderParams& reader_params,
     overflow_check_ = false;
   }
 
+  // Gradient accumulation over N micro-batches per optimizer step. The scheduled RawAsync +
+  // hybrid embedding pipeline fuses update and backward in its graph, so it keeps one step per
+  // batch.
+  if (const char* env = std::getenv("HCTR_GRAD_ACCUM_STEPS")) {
+    const int num_steps = std::atoi(env);
+    if (num_steps > 1) {
+      if (reader_params_.data_reader_type == DataReaderType_t::RawAsync ||
+          solver_.use_embedding_collection) {
+        HCTR_LOG_S(WARNING, ROOT)
+            << "HCTR_GRAD_ACCUM_STEPS ignored: gradient accumulation is not supported with the "
+               "scheduled RawAsync train pipeline or the embedding collection" << std::endl;
+      } else {
+        grad_accum_steps_ = num_steps;
+      }
+    }
+  }
+
   // reserve networks to be created
   for (size_t i = 0; i < resource_manager_->get_local_gpu_count(); i++) {
     networks_.emplace_back(new Network(resource_manager_->get_local_cpu(),
@@ -704,6 +736,12 @@ void Model::add(SparseEmbedding& sparse_embedding) {
 
   embedding_opt_params_list_.push_back(sparse_embedding.embedding_opt_params);
   init_optimizer(embedding_opt_params, solver_, sparse_embedding.embedding_opt_params);
+  if (grad_accum_steps_ > 1) {
+    // The embedding update kernels divide the gradients by the scaler, so scaling it by the
+    // accumulation depth averages the micro-batch contributions. Rows are still touched every
+    // micro-batch, which matches the accumulated step exactly for SGD.
+    embedding_opt_params.scaler *= grad_accum_steps_;
+  }
   if (solver_.i64_input_key && !solver_.use_mixed_precision) {
     add_sparse_embedding<long long, float>(
         sparse_embedding, sparse_input_map_64_, train_tensor_entries_list_,
@@ -817,6 +855,19 @@ void Model::add(const EmbeddingCollectionPlaceholder& embedding_collection_place
   eval_embedding_planner.generate_embedding_plan_from_json_file(
       embedding_collection_placeholder.plan_file_);
 
+  // One communicator group per model-parallel sharding group, so that independent tables'
+  // all2alls are not serialized inside the shared per-GPU communicator. The created count is
+  // capped in create_embedding_comm_groups (HCTR_EMB_COMM_GROUPS).
+  size_t num_mp_groups = 0;
+  for (auto& sharding_param :
+       embedding_planner.get_gpu_major_global_embedding_sharding_param_list()[0]) {
+    if (sharding_param.table_placement_strategy ==
+        embedding::TablePlacementStrategy::ModelParallel) {
+      num_mp_groups++;
+    }
+  }
+  resource_manager_->create_embedding_comm_groups(num_mp_groups);
+
   std::vector<std::shared_ptr<core::CoreResourceManager>> core_list;
 
   for (int local_gpu_id = 0; local_gpu_id < num_local_gpus; ++local_gpu_id) {
@@ -1142,6 +1193,34 @@ void Model::compile() {
   HCTR_PRINT(INFO,
              "===================================================Model "
              "Compile===================================================\n");
+  // Fast validation phase: surface config mistakes that do not need any allocation, so a
+  // deferred compile still fails here rather than at the first fit().
+  if (!networks_.empty()) {
+    for (const auto& label_weight : label_weights_) {
+      if (networks_[0]->train_losses_.find(label_weight.first) ==
+              networks_[0]->train_losses_.end() ||
+          networks_[0]->evaluate_losses_.find(label_weight.first) ==
+              networks_[0]->evaluate_losses_.end()) {
+        HCTR_OWN_THROW(Error_t::WrongInput, "Label weight names and losses do not match.");
+      }
+    }
+  }
+  // Two-phase init: with HCTR_LAZY_COMPILE set, compile() stops after graph analysis and
+  // validation; the GPU buffers materialize at the first fit() or weight/optimizer-state
+  // load. This keeps config iteration sub-second on large models while fit() behaves as if
+  // compile() had run eagerly.
+  if (std::getenv("HCTR_LAZY_COMPILE")) {
+    compile_deferred_ = true;
+    HCTR_LOG(INFO, ROOT,
+             "HCTR_LAZY_COMPILE: model graph validated, GPU buffer allocation deferred to the "
+             "first fit() or load call\n");
+    return;
+  }
+  materialize_compile_();
+}
+
+void Model::materialize_compile_() {
+  compile_deferred_ = false;
   for (size_t i = 0; i < resource_manager_->get_local_gpu_count(); i++) {
     if (solver_.use_mixed_precision) {
       networks_[i]->optimizer_ = std::move(Optimizer::Create(
@@ -1188,6 +1267,32 @@ void Model::compile() {
   }
   exchange_wgrad_->allocate();
   buff_allocated_ = true;
+  // Bucketed overlap of the dense wgrad all-reduce with the backward pass. Only valid when
+  // Network::train runs the backward pass itself (no scheduled pipeline), the NCCL algorithm
+  // exchanges exactly the network wgrads (no grouped embedding buffer) and the MLP wgrads are
+  // produced in order on the compute stream (no async wgrad).
+  if (const char* env = std::getenv("HCTR_AR_NUM_BUCKETS")) {
+    const int num_buckets = std::atoi(env);
+    if (num_buckets > 1) {
+      if (resource_manager_->get_global_gpu_count() > 1 &&
+          solver_.all_reduce_algo == AllReduceAlgo::NCCL && !solver_.grouped_all_reduce &&
+          !solver_.async_mlp_wgrad && !(is_scheduled_datareader() && is_scheduled_embedding())) {
+        for (auto& network : networks_) {
+          network->enable_bucketed_wgrad_exchange(num_buckets);
+        }
+      } else {
+        HCTR_LOG_S(WARNING, ROOT)
+            << "HCTR_AR_NUM_BUCKETS ignored: bucketed wgrad exchange requires multiple GPUs, "
+               "the NCCL all-reduce algorithm without grouping, no async MLP wgrad and no "
+               "scheduled train pipeline" << std::endl;
+      }
+    }
+  }
+  if (grad_accum_steps_ > 1) {
+    for (auto& network : networks_) {
+      network->enable_grad_accumulation(grad_accum_steps_);
+    }
+  }
 #ifndef DATA_READING_TEST
 #pragma omp parallel num_threads(networks_.size())
   {
@@ -1198,6 +1303,9 @@ void Model::compile() {
     }
     HCTR_LIB_THROW(cudaStreamSynchronize(resource_manager_->get_local_gpu(id)->get_stream()));
   }
+  if (solver_.use_algorithm_search) {
+    GemmAlgoCache::get().flush();
+  }
 #endif
   init_params_for_dense_();
   if (solver_.perf_logging) {
@@ -1364,6 +1472,14 @@ void Model::compile(std::vector<std::string>& label_names, std::vector<float>& l
   compile();
 }
 
+void Model::set_gemm_algo_cache(const std::string& cache_file) {
+  if (buff_allocated_) {
+    HCTR_OWN_THROW(Error_t::IllegalCall,
+                   "The gemm algorithm cache must be set before calling Model.compile()");
+  }
+  GemmAlgoCache::get().set_file(cache_file);
+}
+
 void Model::update_label_weights(std::vector<std::string>& label_names,
                                  std::vector<float>& label_weights) {
   // Add implementation and support in next merge request
@@ -1381,6 +1497,9 @@ void Model::update_label_weights(std::vector<std::string>& label_names,
 }
 
 void Model::load_dense_optimizer_states(const std::string& dense_opt_states_file) {
+  if (compile_deferred_) {
+    materialize_compile_();
+  }
   if (!buff_allocated_) {
     HCTR_OWN_THROW(Error_t::IllegalCall,
                    "Cannot load the dense optimizer states before calling Model.compile()");
@@ -1389,6 +1508,9 @@ void Model::load_dense_optimizer_states(const std::string& dense_opt_states_file
 }
 
 void Model::load_sparse_optimizer_states(const std::vector<std::string>& sparse_opt_states_files) {
+  if (compile_deferred_) {
+    materialize_compile_();
+  }
   if (!buff_allocated_) {
     HCTR_OWN_THROW(Error_t::IllegalCall,
                    "Cannot load the sparse optimizer states before "
@@ -1409,6 +1531,9 @@ void Model::load_sparse_optimizer_states(const std::vector<std::string>& sparse_
 
 void Model::load_sparse_optimizer_states(
     const std::map<std::string, std::string>& sparse_opt_states_files_map) {
+  if (compile_deferred_) {
+    materialize_compile_();
+  }
   if (!buff_allocated_) {
     HCTR_OWN_THROW(Error_t::IllegalCall,
                    "Cannot load the sparse optimizer states before "
@@ -1436,6 +1561,9 @@ void Model::load_sparse_optimizer_states(
 }
 
 void Model::load_dense_weights(const std::string& dense_model_file) {
+  if (compile_deferred_) {
+    materialize_compile_();
+  }
   if (!buff_allocated_) {
     HCTR_OWN_THROW(Error_t::IllegalCall,
                    "Cannot load the dense weights before "
@@ -1445,6 +1573,9 @@ void Model::load_dense_weights(const std::string& dense_model_file) {
 }
 
 void Model::load_sparse_weights(const std::vector<std::string>& sparse_embedding_files) {
+  if (compile_deferred_) {
+    materialize_compile_();
+  }
   if (!buff_allocated_) {
     HCTR_OWN_THROW(Error_t::IllegalCall,
                    "Cannot load the sparse weights before "
@@ -1465,6 +1596,9 @@ void Model::load_sparse_weights(const std::vector<std::string>& sparse_embedding
 
 void Model::load_sparse_weights(
     const std::map<std::string, std::string>& sparse_embedding_files_map) {
+  if (compile_deferred_) {
+    materialize_compile_();
+  }
   if (!buff_allocated_) {
     HCTR_OWN_THROW(Error_t::IllegalCall,
                    "Cannot load the sparse weights before "
@@ -1607,6 +1741,9 @@ void print_class_aucs(std::vector<float> class_aucs) {
 
 void Model::fit(int num_epochs, int max_iter, int display, int eval_interval, int snapshot,
                 std::string snapshot_prefix) {
+  if (compile_deferred_) {
+    materialize_compile_();
+  }
   if (!buff_allocated_) {
     HCTR_OWN_THROW(Error_t::IllegalCall,
                    "Cannot start the training process "
@@ -1702,7 +1839,7 @@ void Model::fit(int num_epochs, int max_iter, int display, int eval_interval, in
         if (display > 0 && iter % display == 0 && iter != 0) {
           timer_train.stop();
           float loss = 0;
-          this->get_current_loss(&loss);
+          this->get_display_loss(&loss);
           if (isnan(loss)) {
             throw std::runtime_error(std::string("Train Runtime error: Loss "
                                                  "cannot converge") +
@@ -1767,6 +1904,9 @@ void Model::fit(int num_epochs, int max_iter, int display, int eval_interval, in
         if (snapshot > 0 && iter % snapshot == 0 && iter != 0) {
           this->download_params_to_files(snapshot_prefix, iter);
         }
+        if (kafka_sync_interval_ > 0 && (iter + 1) % kafka_sync_interval_ == 0) {
+          publish_incremental_updates_2kafka_();
+        }
         iter++;
       } while (data_reader_train_status_);
       timer.stop();
@@ -1804,7 +1944,7 @@ void Model::fit(int num_epochs, int max_iter, int display, int eval_interval, in
           if (display > 0 && iter % display == 0 && iter != 0) {
             timer_train.stop();
             float loss = 0;
-            this->get_current_loss(&loss);
+            this->get_display_loss(&loss);
             if (isnan(loss)) {
               throw std::runtime_error(std::string("Train Runtime error: Loss "
                                                    "cannot converge") +
@@ -1852,6 +1992,9 @@ void Model::fit(int num_epochs, int max_iter, int display, int eval_interval, in
             HCTR_LOG_S(INFO, ROOT) << "Eval Time for " << solver_.max_eval_batches
                                    << " iters: " << timer_eval.elapsedSeconds() << "s" << std::endl;
           }
+          if (kafka_sync_interval_ > 0 && (iter + 1) % kafka_sync_interval_ == 0) {
+            publish_incremental_updates_2kafka_();
+          }
           iter++;
         } while (data_reader_train_status_);
       }  // end for file list
@@ -1866,7 +2009,86 @@ void Model::fit(int num_epochs, int max_iter, int display, int eval_interval, in
 
     this->start_data_reading();
     this->init_data_reader_.reset();
+
+    // HCTR_CONCURRENT_EVAL: instead of draining all eval batches while training sits idle,
+    // take the weight snapshot at the eval point and fold one eval batch in front of each
+    // subsequent training iteration. The eval forward passes run on their own stream against
+    // the snapshot copies, so their GPU work overlaps the training iterations and only the
+    // snapshot itself stays on the critical path. The embedding tables are shared with
+    // training, so the overlapped eval batches can observe the embedding updates of the
+    // iterations they overlap with.
+    const bool concurrent_eval = std::getenv("HCTR_CONCURRENT_EVAL") != nullptr &&
+                                 !(is_scheduled_datareader() && is_scheduled_embedding()) &&
+                                 eval_interval > 0 && solver_.max_eval_batches > 0;
+    if (concurrent_eval) {
+      HCTR_LOG_S(INFO, ROOT) << "Concurrent eval enabled: eval batches are interleaved with "
+                                "training iterations"
+                             << std::endl;
+    }
+    int pending_eval_batches = 0;
+
+    auto run_one_eval_batch = [&] {
+      graph_.is_first_eval_batch_ = (pending_eval_batches == solver_.max_eval_batches);
+      this->eval(graph_.is_first_eval_batch_);
+      pending_eval_batches--;
+    };
+
+    // Reads out the metrics of a finished eval pass. Returns true when the target AUC is hit
+    // and fit should stop.
+    auto finalize_eval = [&](int iter) -> bool {
+      auto eval_metrics = this->get_eval_metrics();
+      size_t metric_id = 0;
+      for (auto& eval_metric : eval_metrics) {
+        metric_id++;
+        HCTR_LOG_S(INFO, ROOT) << "Evaluation, " << eval_metric.first << ": " << eval_metric.second
+                               << std::endl;
+        if (solver_.perf_logging) {
+          HCTR_LOG_ARGS(timer_log.elapsedMilliseconds(), "eval_accuracy", eval_metric.second,
+                        float(iter) / max_iter, iter);
+        }
+        if (!eval_metric.first.compare("AUC")) {
+          print_class_aucs(metrics_[metric_id - 1]->get_per_class_metric());
+          const auto auc_threshold = solver_.metrics_spec[HugeCTR::metrics::Type::AUC];
+          if (eval_metric.second > auc_threshold) {
+            timer.stop();
+            if (solver_.perf_logging) {
+              size_t train_samples =
+                  static_cast<size_t>(iter + 1) * static_cast<size_t>(solver_.batchsize);
+
+              HCTR_LOG_ARGS(timer_log.elapsedMilliseconds(), "eval_stop", float(iter) / max_iter);
+              HCTR_LOG_ARGS(timer_log.elapsedMilliseconds(), "epoch_stop", 0);
+              HCTR_LOG_ARGS(timer_log.elapsedMilliseconds(), "run_stop");
+              HCTR_LOG_ARGS(timer_log.elapsedMilliseconds(), "train_samples", train_samples);
+              timer_log.stop();
+            }
+            HCTR_LOG(INFO, ROOT,
+                     "Hit target accuracy AUC %.4f at "
+                     "%d / %d iterations with batchsize %d "
+                     "in %.2fs. Average speed %f "
+                     "records/s.\n",
+                     auc_threshold, iter, max_iter, solver_.batchsize, timer.elapsedSeconds(),
+                     float(iter) * solver_.batchsize / timer.elapsedSeconds());
+            return true;
+          }
+        }
+      }
+      timer_eval.stop();
+      HCTR_LOG_S(INFO, ROOT) << "Eval Time for " << solver_.max_eval_batches
+                             << " iters: " << timer_eval.elapsedSeconds() << "s" << std::endl;
+      if (solver_.perf_logging) {
+        HCTR_LOG_ARGS(timer_log.elapsedMilliseconds(), "eval_stop",
+                      float(iter) / max_iter);  // use iteration to calculate it's in which epoch
+      }
+      return false;
+    };
+
     for (int iter = 0; iter < max_iter; iter++) {
+      if (pending_eval_batches > 0) {
+        run_one_eval_batch();
+        if (pending_eval_batches == 0 && finalize_eval(iter)) {
+          return;
+        }
+      }
       float lr = 0;
       if (!this->use_gpu_learning_rate_scheduling()) {
         lr = lr_sch_->get_next();
@@ -1877,7 +2099,7 @@ void Model::fit(int num_epochs, int max_iter, int display, int eval_interval, in
         timer_train.stop();
         float loss = 0.0f;
         if (solver_.gen_loss_summary) {
-          this->get_current_loss(&loss);
+          this->get_display_loss(&loss);
           if (isnan(loss)) {
             throw std::runtime_error(std::string("Train Runtime error: Loss "
                                                  "cannot converge") +
@@ -1896,6 +2118,14 @@ void Model::fit(int num_epochs, int max_iter, int display, int eval_interval, in
         timer_train.start();
       }
       if (eval_interval > 0 && iter % eval_interval == 0 && iter != 0) {
+        // The previous eval can still be in flight when eval_interval < max_eval_batches:
+        // drain it before taking the next snapshot.
+        while (pending_eval_batches > 0) {
+          run_one_eval_batch();
+          if (pending_eval_batches == 0 && finalize_eval(iter)) {
+            return;
+          }
+        }
         if (solver_.all_reduce_algo == AllReduceAlgo::NCCL) {
 #pragma omp parallel num_threads(networks_.size())
           {
@@ -1910,58 +2140,34 @@ void Model::fit(int num_epochs, int max_iter, int display, int eval_interval, in
         if (solver_.perf_logging) {
           HCTR_LOG_ARGS(timer_log.elapsedMilliseconds(), "eval_start", float(iter) / max_iter);
         }
-        for (int batches = 0; batches < solver_.max_eval_batches; batches++) {
-          graph_.is_first_eval_batch_ = (batches == 0);
-          this->eval(graph_.is_first_eval_batch_);
-        }
-        auto eval_metrics = this->get_eval_metrics();
-        size_t metric_id = 0;
-        for (auto& eval_metric : eval_metrics) {
-          metric_id++;
-          HCTR_LOG_S(INFO, ROOT) << "Evaluation, " << eval_metric.first << ": "
-                                 << eval_metric.second << std::endl;
-          if (solver_.perf_logging) {
-            HCTR_LOG_ARGS(timer_log.elapsedMilliseconds(), "eval_accuracy", eval_metric.second,
-                          float(iter) / max_iter, iter);
+        if (concurrent_eval) {
+          pending_eval_batches = solver_.max_eval_batches;
+        } else {
+          for (int batches = 0; batches < solver_.max_eval_batches; batches++) {
+            graph_.is_first_eval_batch_ = (batches == 0);
+            this->eval(graph_.is_first_eval_batch_);
           }
-          if (!eval_metric.first.compare("AUC")) {
-            print_class_aucs(metrics_[metric_id - 1]->get_per_class_metric());
-            const auto auc_threshold = solver_.metrics_spec[HugeCTR::metrics::Type::AUC];
-            if (eval_metric.second > auc_threshold) {
-              timer.stop();
-              if (solver_.perf_logging) {
-                size_t train_samples =
-                    static_cast<size_t>(iter + 1) * static_cast<size_t>(solver_.batchsize);
-
-                HCTR_LOG_ARGS(timer_log.elapsedMilliseconds(), "eval_stop", float(iter) / max_iter);
-                HCTR_LOG_ARGS(timer_log.elapsedMilliseconds(), "epoch_stop", 0);
-                HCTR_LOG_ARGS(timer_log.elapsedMilliseconds(), "run_stop");
-                HCTR_LOG_ARGS(timer_log.elapsedMilliseconds(), "train_samples", train_samples);
-                timer_log.stop();
-              }
-              HCTR_LOG(INFO, ROOT,
-                       "Hit target accuracy AUC %.4f at "
-                       "%d / %d iterations with batchsize %d "
-                       "in %.2fs. Average speed %f "
-                       "records/s.\n",
-                       auc_threshold, iter, max_iter, solver_.batchsize, timer.elapsedSeconds(),
-                       float(iter) * solver_.batchsize / timer.elapsedSeconds());
-              return;
-            }
+          if (finalize_eval(iter)) {
+            return;
           }
         }
-        timer_eval.stop();
-        HCTR_LOG_S(INFO, ROOT) << "Eval Time for " << solver_.max_eval_batches
-                               << " iters: " << timer_eval.elapsedSeconds() << "s" << std::endl;
-        if (solver_.perf_logging) {
-          HCTR_LOG_ARGS(timer_log.elapsedMilliseconds(), "eval_stop",
-                        float(iter) / max_iter);  // use iteration to calculate it's in which epoch
-        }
       }
       if (snapshot > 0 && iter % snapshot == 0 && iter != 0) {
         this->download_params_to_files(snapshot_prefix, iter);
       }
+      if (kafka_sync_interval_ > 0 && (iter + 1) % kafka_sync_interval_ == 0) {
+        publish_incremental_updates_2kafka_();
+      }
     }  // end for iter
+
+    // Report the eval that is still in flight for the last snapshot.
+    while (pending_eval_batches > 0) {
+      run_one_eval_batch();
+      if (pending_eval_batches == 0 && finalize_eval(max_iter - 1)) {
+        return;
+      }
+    }
+
     if (solver_.perf_logging) {
       HCTR_LOG_ARGS(timer_log.elapsedMilliseconds(), "epoch_stop", 0);
       HCTR_LOG_ARGS(timer_log.elapsedMilliseconds(), "run_stop");
@@ -1982,6 +2188,11 @@ void Model::fit(int num_epochs, int max_iter, int display, int eval_interval, in
 void Model::exchange_wgrad(size_t device_id) {
   auto& gpu_resource = resource_manager_->get_local_gpu(device_id);
   CudaCPUDeviceContext context(gpu_resource->get_device_id());
+  if (networks_[device_id]->bucketed_wgrad_exchange_enabled()) {
+    // Network::train already exchanged the wgrads bucket by bucket during the backward pass
+    // and ordered the compute stream behind the last bucket.
+    return;
+  }
   if (solver_.async_mlp_wgrad && is_scheduled_datareader() && is_scheduled_embedding())
     gpu_resource->wait_on_wgrad_event(gpu_resource->get_stream());
   if (resource_manager_->get_global_gpu_count() > 1) {
@@ -2101,13 +2312,22 @@ bool Model::train(bool is_first_batch) {
         one_embedding->backward();
       }
 
-      // Exchange wgrad and update params
+      // Exchange wgrad and update params. With gradient accumulation only every N-th
+      // micro-batch exchanges the dense wgrads and applies the dense optimizer; the other
+      // micro-batches just fold their wgrads into the shadow buffer.
+      const bool apply_update =
+          grad_accum_steps_ <= 1 || (++grad_accum_iter_ % grad_accum_steps_ == 0);
 #pragma omp parallel num_threads(networks_.size())
       {
         size_t id = omp_get_thread_num();
         CudaCPUDeviceContext ctx(resource_manager_->get_local_gpu(id)->get_device_id());
-        exchange_wgrad(id);
-        networks_[id]->update_params();
+        if (grad_accum_steps_ > 1) {
+          networks_[id]->accumulate_wgrad(apply_update);
+        }
+        if (apply_update) {
+          exchange_wgrad(id);
+          networks_[id]->update_params();
+        }
         ebc_update(id);
       }
 
@@ -2159,6 +2379,20 @@ bool Model::eval(bool is_first_batch) {
     if (is_scheduled_datareader() && is_scheduled_embedding()) {
       evaluate_pipeline(current_batchsize);
     } else {
+      // When evaluation runs on its own stream (HCTR_CONCURRENT_EVAL), order it against the
+      // embedding forward that stays on the default stream: the embedding of this batch must
+      // not overwrite its outputs while the previous network eval still reads them.
+      const bool eval_on_side_stream = !graph_.evaluate_pipeline_.empty() &&
+                                       graph_.evaluate_pipeline_[0].get_stream_name() != "default";
+      if (eval_on_side_stream) {
+        for (size_t id = 0; id < networks_.size(); id++) {
+          auto gpu = resource_manager_->get_local_gpu(id);
+          CudaDeviceContext context(gpu->get_device_id());
+          HCTR_LIB_THROW(
+              cudaStreamWaitEvent(gpu->get_stream(), gpu->get_event("concurrent_eval_done")));
+        }
+      }
+
       for (size_t i = 0; i < embeddings_.size(); ++i) {
         auto& one_embedding = embeddings_.at(i);
 
@@ -2198,7 +2432,19 @@ bool Model::eval(bool is_first_batch) {
 
         // doesn't do anything if eval_overlap disabled
         eval_ebc_forward(id);
+        if (eval_on_side_stream) {
+          cudaStream_t eval_stream =
+              gpu->get_stream(graph_.evaluate_pipeline_[id].get_stream_name());
+          cudaEvent_t eval_start = gpu->get_event("concurrent_eval_start");
+          HCTR_LIB_THROW(cudaEventRecord(eval_start, gpu->get_stream()));
+          HCTR_LIB_THROW(cudaStreamWaitEvent(eval_stream, eval_start));
+        }
         graph_.evaluate_pipeline_[id].run();
+        if (eval_on_side_stream) {
+          cudaStream_t eval_stream =
+              gpu->get_stream(graph_.evaluate_pipeline_[id].get_stream_name());
+          HCTR_LIB_THROW(cudaEventRecord(gpu->get_event("concurrent_eval_done"), eval_stream));
+        }
       }
 #endif
 
@@ -2305,6 +2551,12 @@ Error_t Model::export_predictions(const std::string& output_prediction_file_name
   return Error_t::Success;
 }
 
+std::string Model::get_pipeline_profile() { return PipelineProfiler::get().report_json(); }
+
+void Model::dump_pipeline_profile(const std::string& profile_file) {
+  PipelineProfiler::get().dump_json(profile_file);
+}
+
 std::vector<std::pair<std::string, float>> Model::get_eval_metrics() {
   std::vector<std::pair<std::string, float>> metrics;
   for (auto& metric : metrics_) {
@@ -2313,6 +2565,37 @@ std::vector<std::pair<std::string, float>> Model::get_eval_metrics() {
   return metrics;
 }
 
+Error_t Model::get_display_loss(float* loss) {
+  if (std::getenv("HCTR_ASYNC_LOSS_READBACK") == nullptr) {
+    return get_current_loss(loss);
+  }
+  try {
+    if (!loss_readback_ring_) {
+      std::vector<LossReadbackRing::Source> sources;
+      for (size_t i = 0; i < networks_.size(); ++i) {
+        const auto& gpu = resource_manager_->get_local_gpu(i);
+        for (const float* ptr : networks_[i]->get_train_loss_ptrs()) {
+          sources.push_back({ptr, gpu->get_stream(), gpu->get_device_id()});
+        }
+      }
+      loss_readback_ring_.reset(new LossReadbackRing(sources));
+    }
+    loss_readback_ring_->push();
+    // Consume the newest completed slot; keeps the previous value (initially 0) when no slot
+    // has landed yet, so the caller never waits on the GPU.
+    float loss_sum = *loss * resource_manager_->get_global_gpu_count();
+    loss_readback_ring_->latest(&loss_sum);
+    *loss = loss_sum / resource_manager_->get_global_gpu_count();
+  } catch (const internal_runtime_error& rt_err) {
+    Logger::print_exception(rt_err, 0);
+    return rt_err.get_error();
+  } catch (const std::exception& err) {
+    Logger::print_exception(err, 0);
+    return Error_t::UnspecificError;
+  }
+  return Error_t::Success;
+}
+
 Error_t Model::get_current_loss(float* loss) {
   try {
     float loss_sum = 0.f;
@@ -2709,4 +2992,80 @@ void Model::dump_incremental_model_2kafka() {
   message_sink_->flush();
 }
 
+void Model::export_params_to_hps(const std::shared_ptr<HierParameterServerBase>& hps_ps) {
+  if (compile_deferred_) {
+    materialize_compile_();
+  }
+  if (!buff_allocated_) {
+    HCTR_OWN_THROW(Error_t::IllegalCall,
+                   "Cannot export the model to HPS before calling Model.compile()");
+  }
+  if (embeddings_.empty()) {
+    HCTR_OWN_THROW(Error_t::IllegalCall, "The model has no sparse embedding table to export");
+  }
+  if (solver_.i64_input_key) {
+    export_params_to_hps_<long long>(hps_ps);
+  } else {
+    export_params_to_hps_<unsigned int>(hps_ps);
+  }
+}
+
+template <typename TypeKey>
+void Model::export_params_to_hps_(const std::shared_ptr<HierParameterServerBase>& hps_ps) {
+  for (size_t i = 0; i < embeddings_.size(); i++) {
+    const size_t max_vocabulary_size = embeddings_[i]->get_max_vocabulary_size();
+    const size_t embedding_vec_size = sparse_embedding_params_[i].embedding_vec_size;
+    const std::string& table_name = sparse_embedding_params_[i].sparse_embedding_name;
+
+    // Stage the table in pinned host memory, then hand the raw arrays to the parameter server.
+    // The staging buffer only lives for the duration of one table, so back-to-back tables do
+    // not accumulate host memory.
+    BufferBag buf_bag;
+    auto host_blobs_buff = GeneralBuffer2<CudaHostAllocator>::create();
+    Tensor2<TypeKey> tensor_keys;
+    Tensor2<size_t> tensor_slot_id;
+    host_blobs_buff->reserve({max_vocabulary_size}, &tensor_keys);
+    host_blobs_buff->reserve({max_vocabulary_size}, &tensor_slot_id);
+    host_blobs_buff->reserve({max_vocabulary_size, embedding_vec_size}, &buf_bag.embedding);
+    host_blobs_buff->allocate();
+    buf_bag.keys = tensor_keys.shrink();
+    buf_bag.slot_id = tensor_slot_id.shrink();
+
+    size_t num_pairs = 0;
+    embeddings_[i]->dump_parameters(buf_bag, &num_pairs);
+
+    HCTR_LOG_S(INFO, ROOT) << "Exporting table " << table_name << " (" << num_pairs
+                           << " embeddings) of model " << solver_.model_name
+                           << " to the parameter server" << std::endl;
+    hps_ps->ingest_model_table(solver_.model_name, table_name, num_pairs, tensor_keys.get_ptr(),
+                               sizeof(TypeKey), buf_bag.embedding.get_ptr(), embedding_vec_size);
+  }
+}
+
+void Model::publish_incremental_updates_2kafka_() {
+  bool posted = false;
+  for (size_t i = 0; i < embeddings_.size(); i++) {
+    std::vector<long long> keys;
+    std::vector<float> vectors;
+    if (!embeddings_[i]->dump_incremental(keys, vectors)) {
+      continue;
+    }
+    if (keys.empty()) {
+      continue;
+    }
+    size_t embedding_size = sparse_embedding_params_[i].embedding_vec_size;
+    std::string table_name = sparse_embedding_params_[i].sparse_embedding_name;
+    std::string tag = HierParameterServerBase::make_tag_name(solver_.model_name, table_name);
+    HCTR_LOG_S(DEBUG, WORLD) << "Publish " << keys.size() << " incremental parameters of " << tag
+                             << " into kafka." << std::endl;
+    message_sink_->post(tag, keys.size(), keys.data(),
+                        reinterpret_cast<const char*>(vectors.data()),
+                        embedding_size * sizeof(float));
+    posted = true;
+  }
+  if (posted) {
+    message_sink_->flush();
+  }
+}
+
 }  // namespace HugeCTR
@@ -17,6 +17,7 @@
 #include <HugeCTR/include/base/debug/logger.hpp>
 #include <HugeCTR/include/resource_managers/resource_manager_ext.hpp>
 #include <algorithm>
+#include <cstdlib>
 #include <data_readers/async_reader/async_reader_adapter.hpp>
 #include <embeddings/hybrid_sparse_embedding.hpp>
 #include <fstream>
@@ -48,6 +49,9 @@ void Model::create_train_network_pipeline() {
       if (solver_.async_mlp_wgrad) gpu_resource->wait_on_wgrad_event(gpu_resource->get_stream());
     });
 
+    network_forward_and_backward->set_name("network_forward_and_backward");
+    async_mlp_syncback->set_name("async_mlp_syncback");
+
     graph_.train_pipeline_[local_id] =
         Pipeline{"default", gpu_resource, {network_forward_and_backward, async_mlp_syncback}};
   }
@@ -56,6 +60,12 @@ void Model::create_train_network_pipeline() {
 void Model::create_eval_network_pipeline() {
   graph_.evaluate_pipeline_.resize(resource_manager_->get_local_gpu_count());
 
+  // With HCTR_CONCURRENT_EVAL, evaluation gets its own stream so the eval forward passes can
+  // overlap with the training iterations instead of queuing behind them on the default stream.
+  // Model::eval orders the two streams explicitly around the embedding forward.
+  const std::string eval_stream_name =
+      std::getenv("HCTR_CONCURRENT_EVAL") ? "concurrent_eval" : "default";
+
   for (size_t local_id = 0; local_id < resource_manager_->get_local_gpu_count(); local_id++) {
     auto gpu_resource = resource_manager_->get_local_gpu(local_id);
     CudaCPUDeviceContext context(gpu_resource->get_device_id());
@@ -74,8 +84,11 @@ void Model::create_eval_network_pipeline() {
       }
     });
 
+    network_eval->set_name("network_eval");
+    cal_metrics->set_name("cal_metrics");
+
     graph_.evaluate_pipeline_[local_id] =
-        Pipeline{"default", gpu_resource, {network_eval, cal_metrics}};
+        Pipeline{eval_stream_name, gpu_resource, {network_eval, cal_metrics}};
   }
 }
 
@@ -236,6 +249,36 @@ void Model::create_train_pipeline() {
         iteration_end,
     };
 
+    const std::vector<std::string> stage_names = {"iteration_start",
+                                                  "EMB_input_ready_wait",
+                                                  "embedding_index_calculation",
+                                                  "BNET_input_ready_wait",
+                                                  "cross_iteration_sync",
+                                                  "embedding_infreq_model_forward",
+                                                  "embedding_infreq_network_forward",
+                                                  "embedding_freq_forward",
+                                                  "network_init",
+                                                  "bottom_network_fprop",
+                                                  "init_wgrad",
+                                                  "schedule_reader",
+                                                  "top_network_fprop",
+                                                  "lr_sched_update",
+                                                  "cal_loss",
+                                                  "top_network_bprop",
+                                                  "embedding_freq_backward",
+                                                  "bottom_network_bprop",
+                                                  "embedding_infreq_network_backward",
+                                                  "embedding_infreq_model_backward",
+                                                  "schedule_split_3way",
+                                                  "network_exchange_wgrad",
+                                                  "schedule_d2d",
+                                                  "embedding_freq_update_params",
+                                                  "update_params",
+                                                  "iteration_end"};
+    for (size_t i = 0; i < scheduleable_list.size(); i++) {
+      scheduleable_list[i]->set_name(stage_names[i]);
+    }
+
     if (solver_.train_intra_iteration_overlap) {
       std::string infreq_stream = "side_stream";
       std::string freq_stream = "freq_stream";
@@ -343,6 +386,9 @@ void Model::train_pipeline(size_t current_batch_size) {
   const bool use_graph = solver_.use_cuda_graph && !scheduled_reader->current_batch_incomplete();
 
   scheduled_embedding->assign_input_tensors(true, current_batch_size, inflight_id, cached);
+  // No-op unless HCTR_PRECOMPUTE_INDICES is set: launches this batch's index calculation on a
+  // side stream so that the pipeline's index_calculation only consumes the result
+  scheduled_embedding->precompute_indices(true);
 
 #pragma omp parallel num_threads(resource_manager_->get_local_gpu_count())
   {
@@ -450,6 +496,20 @@ void Model::create_evaluate_pipeline() {
         cal_metrics,
     };
 
+    const std::vector<std::string> stage_names = {"BNET_input_ready_wait",
+                                                  "EMB_input_ready_wait",
+                                                  "embedding_index_calculation",
+                                                  "embedding_infreq_model_forward",
+                                                  "embedding_infreq_network_forward",
+                                                  "embedding_freq_forward",
+                                                  "embedding_global_barrier",
+                                                  "network_init",
+                                                  "network_eval",
+                                                  "cal_metrics"};
+    for (size_t i = 0; i < scheduleable_list.size(); i++) {
+      scheduleable_list[i]->set_name(stage_names[i]);
+    }
+
     const bool overlap_infreq_freq =
         (sparse_embedding_params_[0].hybrid_embedding_param.communication_type !=
          CommunicationType::NVLink_SingleNode) &&
@@ -506,6 +566,7 @@ void Model::evaluate_pipeline(size_t current_batch_size) {
   const bool cached = scheduled_reader->is_batch_cached();
 
   scheduled_embedding->assign_input_tensors(false, current_batch_size, inflight_id, cached);
+  scheduled_embedding->precompute_indices(false);
 
 #pragma omp parallel num_threads(networks_.size())
   {
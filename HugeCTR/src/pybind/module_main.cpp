@@ -27,12 +27,14 @@
 #include <pybind/learning_rate_scheduler_wrapper.hpp>
 #include <pybind/model_wrapper.hpp>
 #include <pybind/optimizer_wrapper.hpp>
+#include <pybind/pinned_buffer_pool.hpp>
 #include <pybind/solver_wrapper.hpp>
 using namespace HugeCTR::python_lib;
 
 PYBIND11_MODULE(hugectr, m) {
   m.doc() = "hugectr python interface";
   CommonPybind(m);
+  PinnedBufferPoolPybind(m);
   DataGeneratorPybind(m);
   DataSourcePybind(m);
   SolverPybind(m);
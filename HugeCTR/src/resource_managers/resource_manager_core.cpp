@@ -17,8 +17,12 @@
 #include <omp.h>
 
 #include <base/debug/logger.hpp>
+#include <cstdlib>
+#include <map>
+#include <mutex>
 #include <random>
 #include <resource_managers/resource_manager_core.hpp>
+#include <sstream>
 #include <utils.hpp>
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-variable"
@@ -159,32 +163,136 @@ ResourceManagerCore::ResourceManagerCore(int num_process, int process_id, Device
 
   cpu_resource_.reset(new CPUResource(replica_uniform_seed, local_replica_variant_seeds));
 
+  // Settle (and log) the declarative core partition now, before any reader/comm/service threads
+  // that consult it are spawned.
+  CPUResource::core_reservation_enabled();
+
+  // NCCL bootstrap is expensive at scale, and elastic restarts or repeated fit sessions in one
+  // process pay it again for the very same topology. With HCTR_NCCL_COMM_CACHE set, the
+  // communicators are kept alive in a process-wide registry keyed by the device layout and handed
+  // back to the next resource manager instead of re-running the rendezvous.
+  static std::mutex comm_cache_guard;
+  static std::map<std::string, std::pair<std::vector<ncclComm_t>, std::vector<ncclComm_t>>>
+      comm_cache;
+  const bool cache_comms = (std::getenv("HCTR_NCCL_COMM_CACHE") != nullptr);
+  std::string comm_signature;
+  if (cache_comms) {
+    std::ostringstream os;
+    os << num_process_ << ':' << process_id_;
+    for (int device_id : local_gpu_device_id_list) {
+      os << ',' << device_id;
+    }
+    for (size_t i = 0; i < local_gpu_count; i++) {
+      os << ';' << device_map_.get_global_id(i);
+    }
+    comm_signature = os.str();
+  }
+
   CudaDeviceContext context;
   std::vector<ncclComm_t> comms(local_gpu_count);
-#ifdef ENABLE_MPI
-  ncclUniqueId nid;
-  if (process_id_ == 0) HCTR_LIB_THROW(ncclGetUniqueId(&nid));
-  HCTR_MPI_THROW(MPI_Bcast((void*)&nid, sizeof(nid), MPI_BYTE, 0, MPI_COMM_WORLD));
-
-  HCTR_LIB_THROW(ncclGroupStart());
-  for (size_t i = 0; i < local_gpu_count; i++) {
-    context.set_device(local_gpu_device_id_list[i]);
-    HCTR_LIB_THROW(
-        ncclCommInitRank(&comms[i], global_gpu_count, nid, device_map_.get_global_id(i)));
+  std::vector<ncclComm_t> island_comms(local_gpu_count, nullptr);
+  bool comms_from_cache = false;
+  if (cache_comms) {
+    std::lock_guard<std::mutex> lock(comm_cache_guard);
+    const auto it = comm_cache.find(comm_signature);
+    if (it != comm_cache.end()) {
+      comms = it->second.first;
+      island_comms = it->second.second;
+      comms_from_cache = true;
+      HCTR_LOG_S(INFO, ROOT) << "Reusing cached NCCL communicators, bootstrap skipped"
+                             << std::endl;
+    }
   }
-  HCTR_LIB_THROW(ncclGroupEnd());
+
+  if (!comms_from_cache) {
+#ifdef ENABLE_MPI
+    ncclUniqueId nid;
+    if (process_id_ == 0) HCTR_LIB_THROW(ncclGetUniqueId(&nid));
+    HCTR_MPI_THROW(MPI_Bcast((void*)&nid, sizeof(nid), MPI_BYTE, 0, MPI_COMM_WORLD));
+
+    // The grouped init bootstraps all local ranks through one rendezvous round.
+    HCTR_LIB_THROW(ncclGroupStart());
+    for (size_t i = 0; i < local_gpu_count; i++) {
+      context.set_device(local_gpu_device_id_list[i]);
+      HCTR_LIB_THROW(
+          ncclCommInitRank(&comms[i], global_gpu_count, nid, device_map_.get_global_id(i)));
+    }
+    HCTR_LIB_THROW(ncclGroupEnd());
 #else
-  HCTR_LIB_THROW(ncclCommInitAll(comms.data(), local_gpu_device_id_list.size(),
-                                 local_gpu_device_id_list.data()));
+    HCTR_LIB_THROW(ncclCommInitAll(comms.data(), local_gpu_device_id_list.size(),
+                                   local_gpu_device_id_list.data()));
 #endif
 
+    // Discover the NVLink islands (connected components of the peer-access matrix) and build a
+    // subcommunicator per island of two or more GPUs. These are bootstrapped locally, without any
+    // global rendezvous, and let collectives run their dense phase over NVLink and cross islands
+    // (or nodes) only once. When the single island spans all GPUs of a single-process job, the
+    // global communicator already is the island communicator and no extra one is created.
+    std::vector<int> island_of(local_gpu_count, -1);
+    int num_islands = 0;
+    for (size_t i = 0; i < local_gpu_count; i++) {
+      if (island_of[i] >= 0) {
+        continue;
+      }
+      std::vector<size_t> pending{i};
+      island_of[i] = num_islands;
+      while (!pending.empty()) {
+        const size_t cur = pending.back();
+        pending.pop_back();
+        for (size_t j = 0; j < local_gpu_count; j++) {
+          if (island_of[j] >= 0) {
+            continue;
+          }
+          int can_access_peer = 0;
+          HCTR_LIB_THROW(cudaDeviceCanAccessPeer(&can_access_peer, local_gpu_device_id_list[cur],
+                                                 local_gpu_device_id_list[j]));
+          if (can_access_peer == 1) {
+            island_of[j] = num_islands;
+            pending.push_back(j);
+          }
+        }
+      }
+      num_islands++;
+    }
+    if (num_islands > 1 || num_process_ > 1) {
+      for (int island = 0; island < num_islands; island++) {
+        std::vector<int> island_devices;
+        std::vector<size_t> island_members;
+        for (size_t i = 0; i < local_gpu_count; i++) {
+          if (island_of[i] == island) {
+            island_devices.push_back(local_gpu_device_id_list[i]);
+            island_members.push_back(i);
+          }
+        }
+        if (island_devices.size() < 2) {
+          continue;
+        }
+        std::vector<ncclComm_t> sub_comms(island_devices.size());
+        HCTR_LIB_THROW(
+            ncclCommInitAll(sub_comms.data(), island_devices.size(), island_devices.data()));
+        for (size_t m = 0; m < island_members.size(); m++) {
+          island_comms[island_members[m]] = sub_comms[m];
+        }
+        HCTR_LOG_S(INFO, ROOT) << "Created NVLink-island subcommunicator over "
+                               << island_devices.size() << " GPUs (island " << island << " of "
+                               << num_islands << ")" << std::endl;
+      }
+    }
+
+    if (cache_comms) {
+      std::lock_guard<std::mutex> lock(comm_cache_guard);
+      comm_cache.emplace(comm_signature, std::make_pair(comms, island_comms));
+    }
+  }
+
   gpu_resources_.resize(local_gpu_count);
 #pragma omp parallel num_threads(local_gpu_count)
   {
     size_t id = omp_get_thread_num();
     set_local_gpu(std::make_shared<GPUResource>(local_gpu_device_id_list[id], id,
                                                 device_map_.get_global_id(id), replica_uniform_seed,
-                                                local_replica_variant_seeds[id], comms[id]),
+                                                local_replica_variant_seeds[id], comms[id],
+                                                island_comms[id], !cache_comms),
                   id);
   }
 
@@ -14,7 +14,9 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <base/debug/logger.hpp>
+#include <cstdlib>
 #include <random>
 #include <resource_managers/resource_manager_ext.hpp>
 #include <utils.hpp>
@@ -62,6 +64,57 @@ void ResourceManagerExt::init_ib_comm() {
 }
 #endif
 
+void ResourceManagerExt::create_embedding_comm_groups(size_t num_groups) {
+  // Every communicator schedules its own SM channels, so the number of concurrent ones is capped
+  // to keep the collectives from crowding out the compute kernels.
+  size_t max_groups = 2;
+  if (const char* env = std::getenv("HCTR_EMB_COMM_GROUPS")) {
+    max_groups = std::max(1l, atol(env));
+  }
+  num_groups = std::min(num_groups, max_groups);
+  if (num_groups <= 1) {
+    return;  // a single group keeps using the shared communicator
+  }
+  if (get_local_gpu(0)->get_group_comm_count() > 0) {
+    return;  // already created, e.g. by a second embedding collection
+  }
+
+  const auto& device_list = get_local_gpu_device_id_list();
+  const size_t local_gpu_count = get_local_gpu_count();
+
+  std::vector<std::vector<ncclComm_t>> group_comms(local_gpu_count,
+                                                   std::vector<ncclComm_t>(num_groups));
+  CudaDeviceContext context;
+  for (size_t group = 0; group < num_groups; ++group) {
+    std::vector<ncclComm_t> comms(local_gpu_count);
+#ifdef ENABLE_MPI
+    ncclUniqueId nid;
+    if (get_process_id() == 0) HCTR_LIB_THROW(ncclGetUniqueId(&nid));
+    HCTR_MPI_THROW(MPI_Bcast((void*)&nid, sizeof(nid), MPI_BYTE, 0, MPI_COMM_WORLD));
+
+    HCTR_LIB_THROW(ncclGroupStart());
+    for (size_t i = 0; i < local_gpu_count; i++) {
+      context.set_device(device_list[i]);
+      HCTR_LIB_THROW(ncclCommInitRank(&comms[i], get_global_gpu_count(), nid,
+                                      get_gpu_global_id_from_local_id(i)));
+    }
+    HCTR_LIB_THROW(ncclGroupEnd());
+#else
+    HCTR_LIB_THROW(ncclCommInitAll(comms.data(), device_list.size(), device_list.data()));
+#endif
+    for (size_t i = 0; i < local_gpu_count; i++) {
+      group_comms[i][group] = comms[i];
+    }
+  }
+  for (size_t i = 0; i < local_gpu_count; i++) {
+    get_local_gpu(i)->set_group_comms(group_comms[i]);
+  }
+  HCTR_LOG_S(INFO, ROOT) << "Created " << num_groups
+                         << " embedding communicator groups so independent table groups' "
+                            "exchanges can overlap"
+                         << std::endl;
+}
+
 void ResourceManagerExt::set_ar_comm(AllReduceAlgo algo, bool use_mixed_precision) {
   int num_process = get_num_process();
 #ifdef ENABLE_MPI
@@ -14,10 +14,13 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <base/debug/logger.hpp>
+#include <cpu_resource.hpp>
 #include <cstdlib>
 #include <iostream>
 #include <thread_pool.hpp>
+#include <utils.hpp>
 
 namespace HugeCTR {
 
@@ -34,9 +37,18 @@ ThreadPool::ThreadPool(const std::string& name, size_t num_workers) : name_(name
     }
   }
 
-  // Create worker threads.
+  // Create the per-worker queues before the workers that poll them.
+  for (size_t i = 0; i < num_workers; i++) {
+    queues_.emplace_back(std::make_unique<WorkerQueue>());
+  }
+  // Keep the workers on the "service" pool when one is reserved (HCTR_CORE_RESERVATION), so
+  // background/serving work does not land on the cores driving the GPUs.
+  const std::set<int>& service_cores = CPUResource::reserved_cores("service");
   for (size_t i = 0; i < num_workers; i++) {
     workers_.emplace_back(&ThreadPool::run_, this, i);
+    if (!service_cores.empty()) {
+      set_affinity(workers_.back(), service_cores, false);
+    }
   }
 
   // Block until all workers entered the idle state.
@@ -60,7 +72,7 @@ ThreadPool::~ThreadPool() {
 bool ThreadPool::idle() const {
   // Momentarily request exclusive access, and read out the idle status.
   std::lock_guard<std::mutex> lock(barrier_);
-  return num_idle_workers_ == workers_.size() && packages_.empty();
+  return num_idle_workers_ == workers_.size() && num_pending_ == 0;
 }
 
 void ThreadPool::await_idle() const {
@@ -68,7 +80,7 @@ void ThreadPool::await_idle() const {
   std::unique_lock<std::mutex> lock(barrier_);
 
   // Are we idle already? If not wait for a worker to exit.
-  while (num_idle_workers_ != workers_.size() || !packages_.empty()) {
+  while (num_idle_workers_ != workers_.size() || num_pending_ != 0) {
     if (terminate_) {
       HCTR_OWN_THROW(Error_t::IllegalCall, "Attempted to await an already terminated ThreadPool!");
     }
@@ -77,21 +89,50 @@ void ThreadPool::await_idle() const {
 }
 
 std::future<void> ThreadPool::submit(std::function<void()> task) {
-  std::packaged_task<void()> package(std::move(task));
-  std::future<void> result = package.get_future();
+  return submit(std::move(task), {});
+}
 
-  // Momentarily request exclusive access, to submit the task.
+std::future<void> ThreadPool::submit(std::function<void()> task,
+                                     const std::vector<size_t>& affinity) {
+  for (size_t worker_index : affinity) {
+    if (worker_index >= workers_.size()) {
+      HCTR_OWN_THROW(Error_t::WrongInput, "ThreadPool affinity index out of range!");
+    }
+  }
+
+  Task package{std::packaged_task<void()>(std::move(task)), affinity};
+  std::future<void> result = package.work.get_future();
+
+  // Momentarily request exclusive access, to check the termination state.
   {
     std::lock_guard<std::mutex> lock(barrier_);
     if (terminate_) {
       HCTR_OWN_THROW(Error_t::IllegalCall,
                      "Attempted to submit work to an already terminated ThreadPool!");
     }
-    packages_.push_back(std::move(package));
   }
 
-  // Wake up a worker.
-  submit_sempahore_.notify_one();
+  // Spread the submissions round-robin over the allowed queues; only that queue's lock is
+  // taken, so concurrent submitters do not serialize on a shared mutex.
+  const size_t ticket = next_queue_++;
+  const size_t target = affinity.empty() ? ticket % queues_.size()
+                                         : affinity[ticket % affinity.size()];
+  num_pending_++;
+  {
+    std::lock_guard<std::mutex> lock(queues_[target]->mutex);
+    queues_[target]->tasks.push_back(std::move(package));
+  }
+
+  // Wake up a worker. A pinned task needs notify_all: the one woken worker is not
+  // necessarily allowed to run it.
+  {
+    std::lock_guard<std::mutex> lock(barrier_);
+    if (affinity.empty()) {
+      submit_sempahore_.notify_one();
+    } else {
+      submit_sempahore_.notify_all();
+    }
+  }
 
   return result;
 }
@@ -104,42 +145,79 @@ ThreadPool& ThreadPool::get() {
   return *default_pool.get();
 }
 
+bool ThreadPool::try_acquire_task_(const size_t thread_index, Task& task) {
+  // Own queue first, oldest task first.
+  {
+    WorkerQueue& own = *queues_[thread_index];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    for (auto it = own.tasks.begin(); it != own.tasks.end(); ++it) {
+      if (it->affinity.empty() ||
+          std::find(it->affinity.begin(), it->affinity.end(), thread_index) !=
+              it->affinity.end()) {
+        task = std::move(*it);
+        own.tasks.erase(it);
+        return true;
+      }
+    }
+  }
+
+  // Steal from the back of the other queues, skipping tasks pinned elsewhere.
+  for (size_t i = 1; i < queues_.size(); i++) {
+    WorkerQueue& victim = *queues_[(thread_index + i) % queues_.size()];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    for (auto it = victim.tasks.rbegin(); it != victim.tasks.rend(); ++it) {
+      if (it->affinity.empty() ||
+          std::find(it->affinity.begin(), it->affinity.end(), thread_index) !=
+              it->affinity.end()) {
+        task = std::move(*it);
+        victim.tasks.erase(std::next(it).base());
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 void ThreadPool::run_(const size_t thread_index) {
   hctr_set_thread_name(name_ + " #" + std::to_string(thread_index));
+  Task task;
   while (true) {
-    thread_local std::packaged_task<void()> package;
+    if (try_acquire_task_(thread_index, task)) {
+      // Execute work package.
+      task.work();
+      num_pending_--;
+      continue;
+    }
 
     // Acquire exclusive access.
-    {
-      std::unique_lock<std::mutex> lock(barrier_);
+    std::unique_lock<std::mutex> lock(barrier_);
 
-      // If termination request occured.
-      if (terminate_) {
-        return;
-      }
+    // If termination request occured.
+    if (terminate_) {
+      return;
+    }
+
+    // Re-check under the lock so a submission racing with the scan above is not missed.
+    if (try_acquire_task_(thread_index, task)) {
+      lock.unlock();
+      task.work();
+      num_pending_--;
+      continue;
+    }
 
-      // If no work package queued.
-      while (packages_.empty()) {
-        // Enter idle state (notify threads that wait for the threadpool to go idle).
-        num_idle_workers_ += 1;
-        idle_semaphore_.notify_all();
+    // Enter idle state (notify threads that wait for the threadpool to go idle).
+    num_idle_workers_ += 1;
+    idle_semaphore_.notify_all();
 
-        // Wait for a task.
-        submit_sempahore_.wait(lock);
-        num_idle_workers_ -= 1;
+    // Wait for a task.
+    submit_sempahore_.wait(lock);
+    num_idle_workers_ -= 1;
 
-        // If woken up by terminate request.
-        if (terminate_) {
-          return;
-        }
-      }
-      package = std::move(packages_.front());
-      packages_.pop_front();
+    // If woken up by terminate request.
+    if (terminate_) {
+      return;
     }
-
-    // Execute work package.
-    package();
   }
 }
 
-}  // namespace HugeCTR
\ No newline at end of file
+}  // namespace HugeCTR
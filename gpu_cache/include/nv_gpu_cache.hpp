@@ -20,6 +20,7 @@
 #include <cstdio>
 #include <hash_functions.cuh>
 #include <limits>
+#include <memory>
 #ifdef LIBCUDACXX_VERSION
 #include <cuda/std/atomic>
 #include <cuda/std/semaphore>
@@ -45,13 +46,84 @@ struct slab_set {
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Type-erased API of the GPU cache. The set associativity is baked into the gpu_cache template, so
+// callers that want to select it at runtime (i.e. per embedding table) hold the cache through this
+// interface and construct it with the create_gpu_cache factory below.
+template <typename key_type>
+class gpu_cache_api {
+ public:
+  virtual ~gpu_cache_api() {}
+
+  // Query API, i.e. A single read from the cache
+  virtual void Query(const key_type* d_keys, const size_t len, float* d_values,
+                     uint64_t* d_missing_index, key_type* d_missing_keys, size_t* d_missing_len,
+                     cudaStream_t stream,
+                     const size_t task_per_warp_tile = TASK_PER_WARP_TILE_MACRO) = 0;
+
+  // Variable-width Query, i.e. read embedding_vec_size floats per key from slots that are
+  // embedding_vec_size (as constructed) floats wide. Lets one cache instance serve tables of
+  // different embedding widths.
+  virtual void Query(const key_type* d_keys, const size_t len, float* d_values,
+                     const size_t embedding_vec_size, uint64_t* d_missing_index,
+                     key_type* d_missing_keys, size_t* d_missing_len, cudaStream_t stream,
+                     const size_t task_per_warp_tile = TASK_PER_WARP_TILE_MACRO) = 0;
+
+  // Replace API, i.e. Follow the Query API to update the content of the cache to Most Recent
+  virtual void Replace(const key_type* d_keys, const size_t len, const float* d_values,
+                       cudaStream_t stream,
+                       const size_t task_per_warp_tile = TASK_PER_WARP_TILE_MACRO) = 0;
+
+  // Variable-width Replace
+  virtual void Replace(const key_type* d_keys, const size_t len, const float* d_values,
+                       const size_t embedding_vec_size, cudaStream_t stream,
+                       const size_t task_per_warp_tile = TASK_PER_WARP_TILE_MACRO) = 0;
+
+  // Double-buffered Replace: stages the <k,v> pairs chunk-by-chunk in an internal side buffer and
+  // performs the actual replacement on an internal low-priority stream, so that concurrent Query
+  // streams are not stalled behind bulk replacements. The input buffers can be reused as soon as
+  // the caller's stream has passed this call, like any other async operation on that stream.
+  virtual void ReplaceAsync(const key_type* d_keys, const size_t len, const float* d_values,
+                            const size_t embedding_vec_size, cudaStream_t stream) = 0;
+
+  // Update API, i.e. update the embeddings which exist in the cache
+  virtual void Update(const key_type* d_keys, const size_t len, const float* d_values,
+                      cudaStream_t stream,
+                      const size_t task_per_warp_tile = TASK_PER_WARP_TILE_MACRO) = 0;
+
+  // Variable-width Update
+  virtual void Update(const key_type* d_keys, const size_t len, const float* d_values,
+                      const size_t embedding_vec_size, cudaStream_t stream,
+                      const size_t task_per_warp_tile = TASK_PER_WARP_TILE_MACRO) = 0;
+
+  // Dump API, i.e. dump some slabsets' keys from the cache
+  virtual void Dump(key_type* d_keys, size_t* d_dump_counter, const size_t start_set_index,
+                    const size_t end_set_index, cudaStream_t stream) = 0;
+
+  // Incremental Dump, i.e. dump only the keys whose value was inserted or updated at or after the
+  // given sequence number, compacted on-device. Pair with GetSequenceNumber to snapshot just the
+  // entries that changed since the last dump.
+  virtual void Dump(key_type* d_keys, size_t* d_dump_counter, const size_t start_set_index,
+                    const size_t end_set_index, const size_t dirty_threshold,
+                    cudaStream_t stream) = 0;
+
+  // Current modification sequence number of the cache. Values written from here on will carry a
+  // sequence >= the returned number.
+  virtual size_t GetSequenceNumber() = 0;
+
+  // Cumulative number of LRU evictions (valid entries overwritten to make room) since
+  // construction, copied into host memory asynchronously on the given stream. Pass a pinned
+  // destination so the copy does not synchronize the device.
+  virtual void ReadEvictionCount(size_t* h_evict_count, cudaStream_t stream) = 0;
+};
+
 // GPU Cache
 template <typename key_type, typename ref_counter_type, key_type empty_key, int set_associativity,
           int warp_size, typename set_hasher = MurmurHash3_32<key_type>,
           typename slab_hasher = Mod_Hash<key_type, size_t>>
-class gpu_cache {
+class gpu_cache : public gpu_cache_api<key_type> {
  public:
-  // Ctor
+  // Ctor. embedding_vec_size is the slot width of the value store; variable-width queries may use
+  // any width up to this value.
   gpu_cache(const size_t capacity_in_set, const size_t embedding_vec_size);
 
   // Dtor
@@ -60,19 +132,49 @@ class gpu_cache {
   // Query API, i.e. A single read from the cache
   void Query(const key_type* d_keys, const size_t len, float* d_values, uint64_t* d_missing_index,
              key_type* d_missing_keys, size_t* d_missing_len, cudaStream_t stream,
-             const size_t task_per_warp_tile = TASK_PER_WARP_TILE_MACRO);
+             const size_t task_per_warp_tile = TASK_PER_WARP_TILE_MACRO) override;
+
+  // Variable-width Query
+  void Query(const key_type* d_keys, const size_t len, float* d_values,
+             const size_t embedding_vec_size, uint64_t* d_missing_index, key_type* d_missing_keys,
+             size_t* d_missing_len, cudaStream_t stream,
+             const size_t task_per_warp_tile = TASK_PER_WARP_TILE_MACRO) override;
 
   // Replace API, i.e. Follow the Query API to update the content of the cache to Most Recent
   void Replace(const key_type* d_keys, const size_t len, const float* d_values, cudaStream_t stream,
-               const size_t task_per_warp_tile = TASK_PER_WARP_TILE_MACRO);
+               const size_t task_per_warp_tile = TASK_PER_WARP_TILE_MACRO) override;
+
+  // Variable-width Replace
+  void Replace(const key_type* d_keys, const size_t len, const float* d_values,
+               const size_t embedding_vec_size, cudaStream_t stream,
+               const size_t task_per_warp_tile = TASK_PER_WARP_TILE_MACRO) override;
+
+  // Double-buffered Replace on the internal low-priority stream
+  void ReplaceAsync(const key_type* d_keys, const size_t len, const float* d_values,
+                    const size_t embedding_vec_size, cudaStream_t stream) override;
 
   // Update API, i.e. update the embeddings which exist in the cache
   void Update(const key_type* d_keys, const size_t len, const float* d_values, cudaStream_t stream,
-              const size_t task_per_warp_tile = TASK_PER_WARP_TILE_MACRO);
+              const size_t task_per_warp_tile = TASK_PER_WARP_TILE_MACRO) override;
+
+  // Variable-width Update
+  void Update(const key_type* d_keys, const size_t len, const float* d_values,
+              const size_t embedding_vec_size, cudaStream_t stream,
+              const size_t task_per_warp_tile = TASK_PER_WARP_TILE_MACRO) override;
 
   // Dump API, i.e. dump some slabsets' keys from the cache
   void Dump(key_type* d_keys, size_t* d_dump_counter, const size_t start_set_index,
-            const size_t end_set_index, cudaStream_t stream);
+            const size_t end_set_index, cudaStream_t stream) override;
+
+  // Incremental Dump of the entries modified at or after the given sequence number
+  void Dump(key_type* d_keys, size_t* d_dump_counter, const size_t start_set_index,
+            const size_t end_set_index, const size_t dirty_threshold, cudaStream_t stream) override;
+
+  // Current modification sequence number
+  size_t GetSequenceNumber() override;
+
+  // Asynchronous readback of the cumulative LRU eviction count
+  void ReadEvictionCount(size_t* h_evict_count, cudaStream_t stream) override;
 
  public:
   using slabset = slab_set<set_associativity, key_type, warp_size>;
@@ -88,6 +190,11 @@ class gpu_cache {
   slabset* keys_;
   float* vals_;
   ref_counter_type* slot_counter_;
+  // Sequence number of the last value write (insert/replace/update) per slot; enables
+  // incremental (dirty-only) dumps
+  ref_counter_type* update_counter_;
+  // Number of LRU evictions since construction, see ReadEvictionCount
+  size_t* evict_counter_;
 
   // Global counter
 #ifdef LIBCUDACXX_VERSION
@@ -113,6 +220,23 @@ class gpu_cache {
   // 1 slab set 1 for unlock, 0 for lock
   int* set_mutex_;
 #endif
+
+  // Asynchronous replace pipeline; lazily created on the first ReplaceAsync call.
+  static const size_t REPLACE_BUFFER_LEN_ = 65536;
+  cudaStream_t replace_stream_ = nullptr;
+  key_type* replace_keys_buf_[2] = {nullptr, nullptr};
+  float* replace_vals_buf_[2] = {nullptr, nullptr};
+  cudaEvent_t replace_staged_[2];
+  cudaEvent_t replace_consumed_[2];
+  int replace_buf_idx_ = 0;
 };
 
+// Factory that selects one of the pre-instantiated set associativities (2/4/8/16-way) at runtime.
+// Low associativity keeps probe cost down for head-heavy key distributions, high associativity
+// improves the hit rate for long-tail distributions.
+template <typename key_type, typename ref_counter_type, key_type empty_key, int warp_size>
+std::unique_ptr<gpu_cache_api<key_type>> create_gpu_cache(const int set_associativity,
+                                                          const size_t capacity_in_set,
+                                                          const size_t embedding_vec_size);
+
 }  // namespace gpu_cache
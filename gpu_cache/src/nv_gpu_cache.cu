@@ -245,7 +245,8 @@ template <typename key_type, typename ref_counter_type, typename atomic_ref_coun
           typename slabset, typename set_hasher, typename slab_hasher, typename mutex,
           key_type empty_key, int set_associativity, int warp_size>
 __global__ void get_kernel(const key_type* d_keys, const size_t len, float* d_values,
-                           const size_t embedding_vec_size, uint64_t* d_missing_index,
+                           const size_t embedding_vec_size, const size_t value_stride,
+                           uint64_t* d_missing_index,
                            key_type* d_missing_keys, size_t* d_missing_len,
                            const atomic_ref_counter_type* global_counter,
                            ref_counter_type* slot_counter, const size_t capacity_in_set,
@@ -339,7 +340,7 @@ __global__ void get_kernel(const key_type* d_keys, const size_t len, float* d_va
 
         warp_tile_copy<warp_size>(lane_idx, embedding_vec_size,
                                   d_values + next_idx * embedding_vec_size,
-                                  vals + found_offset * embedding_vec_size);
+                                  vals + found_offset * value_stride);
 
         active_mask = warp_tile.ballot(active);
         break;
@@ -390,7 +391,8 @@ __global__ void get_kernel(const key_type* d_keys, const size_t len, float* d_va
 template <typename key_type, typename ref_counter_type, typename slabset, typename set_hasher,
           typename slab_hasher, key_type empty_key, int set_associativity, int warp_size>
 __global__ void get_kernel(const key_type* d_keys, const size_t len, float* d_values,
-                           const size_t embedding_vec_size, uint64_t* d_missing_index,
+                           const size_t embedding_vec_size, const size_t value_stride,
+                           uint64_t* d_missing_index,
                            key_type* d_missing_keys, size_t* d_missing_len,
                            ref_counter_type* global_counter,
                            volatile ref_counter_type* slot_counter, const size_t capacity_in_set,
@@ -484,7 +486,7 @@ __global__ void get_kernel(const key_type* d_keys, const size_t len, float* d_va
 
         warp_tile_copy<warp_size>(lane_idx, embedding_vec_size,
                                   (volatile float*)(d_values + next_idx * embedding_vec_size),
-                                  (volatile float*)(vals + found_offset * embedding_vec_size));
+                                  (volatile float*)(vals + found_offset * value_stride));
 
         active_mask = warp_tile.ballot(active);
         break;
@@ -539,12 +541,13 @@ template <typename key_type, typename slabset, typename ref_counter_type, typena
           ref_counter_type max_ref_counter_type = std::numeric_limits<ref_counter_type>::max(),
           size_t max_slab_distance = std::numeric_limits<size_t>::max()>
 __global__ void insert_replace_kernel(const key_type* d_keys, const float* d_values,
-                                      const size_t embedding_vec_size, const size_t len,
+                                      const size_t embedding_vec_size, const size_t value_stride,
+                                      const size_t len,
                                       slabset* keys, float* vals, ref_counter_type* slot_counter,
-                                      mutex* set_mutex,
+                                      ref_counter_type* update_counter, mutex* set_mutex,
                                       const atomic_ref_counter_type* global_counter,
                                       const size_t capacity_in_set,
-                                      const size_t task_per_warp_tile) {
+                                      const size_t task_per_warp_tile, size_t* evict_counter) {
   // Lane(thread) ID within a warp_tile
   cg::thread_block_tile<warp_size> warp_tile =
       cg::tiled_partition<warp_size>(cg::this_thread_block());
@@ -613,14 +616,16 @@ __global__ void insert_replace_kernel(const key_type* d_keys, const float* d_val
         size_t slot_index =
             (next_set * set_associativity + target_slab) * warp_size + slot_distance;
 
-        // Replace the LR slot
+        // Replace the LR slot; the victim always holds a valid key here, so this is an eviction
         if (lane_idx == (size_t)next_lane) {
           keys[next_set].set_[target_slab].slab_[slot_distance] = key;
           slot_counter[slot_index] = global_counter->load(cuda::std::memory_order_relaxed);
+          update_counter[slot_index] = slot_counter[slot_index];
+          atomicAdd(evict_counter, (size_t)1);
         }
 
         warp_tile_copy<warp_size>(lane_idx, embedding_vec_size,
-                                  vals + slot_index * embedding_vec_size,
+                                  vals + slot_index * value_stride,
                                   d_values + next_idx * embedding_vec_size);
 
         // Replace complete, mark this task completed
@@ -660,10 +665,11 @@ __global__ void insert_replace_kernel(const key_type* d_keys, const float* d_val
         if (lane_idx == (size_t)next_lane) {
           keys[next_set].set_[next_slab].slab_[found_lane] = key;
           slot_counter[found_offset] = global_counter->load(cuda::std::memory_order_relaxed);
+          update_counter[found_offset] = slot_counter[found_offset];
         }
 
         warp_tile_copy<warp_size>(lane_idx, embedding_vec_size,
-                                  vals + found_offset * embedding_vec_size,
+                                  vals + found_offset * value_stride,
                                   d_values + next_idx * embedding_vec_size);
 
         if (lane_idx == (size_t)next_lane) {
@@ -698,12 +704,14 @@ template <typename key_type, typename slabset, typename ref_counter_type, typena
           ref_counter_type max_ref_counter_type = std::numeric_limits<ref_counter_type>::max(),
           size_t max_slab_distance = std::numeric_limits<size_t>::max()>
 __global__ void insert_replace_kernel(const key_type* d_keys, const float* d_values,
-                                      const size_t embedding_vec_size, const size_t len,
+                                      const size_t embedding_vec_size, const size_t value_stride,
+                                      const size_t len,
                                       volatile slabset* keys, volatile float* vals,
                                       volatile ref_counter_type* slot_counter,
-                                      volatile int* set_mutex, ref_counter_type* global_counter,
+                                      ref_counter_type* update_counter, volatile int* set_mutex,
+                                      ref_counter_type* global_counter,
                                       const size_t capacity_in_set,
-                                      const size_t task_per_warp_tile) {
+                                      const size_t task_per_warp_tile, size_t* evict_counter) {
   // Lane(thread) ID within a warp_tile
   cg::thread_block_tile<warp_size> warp_tile =
       cg::tiled_partition<warp_size>(cg::this_thread_block());
@@ -772,14 +780,16 @@ __global__ void insert_replace_kernel(const key_type* d_keys, const float* d_val
         size_t slot_index =
             (next_set * set_associativity + target_slab) * warp_size + slot_distance;
 
-        // Replace the LR slot
+        // Replace the LR slot; the victim always holds a valid key here, so this is an eviction
         if (lane_idx == (size_t)next_lane) {
           ((volatile key_type*)(keys[next_set].set_[target_slab].slab_))[slot_distance] = key;
           slot_counter[slot_index] = atomicAdd(global_counter, 0);
+          update_counter[slot_index] = slot_counter[slot_index];
+          atomicAdd(evict_counter, (size_t)1);
         }
 
         warp_tile_copy<warp_size>(lane_idx, embedding_vec_size,
-                                  (volatile float*)(vals + slot_index * embedding_vec_size),
+                                  (volatile float*)(vals + slot_index * value_stride),
                                   (volatile float*)(d_values + next_idx * embedding_vec_size));
 
         // Replace complete, mark this task completed
@@ -819,10 +829,11 @@ __global__ void insert_replace_kernel(const key_type* d_keys, const float* d_val
         if (lane_idx == (size_t)next_lane) {
           ((volatile key_type*)(keys[next_set].set_[next_slab].slab_))[found_lane] = key;
           slot_counter[found_offset] = atomicAdd(global_counter, 0);
+          update_counter[found_offset] = slot_counter[found_offset];
         }
 
         warp_tile_copy<warp_size>(lane_idx, embedding_vec_size,
-                                  (volatile float*)(vals + found_offset * embedding_vec_size),
+                                  (volatile float*)(vals + found_offset * value_stride),
                                   (volatile float*)(d_values + next_idx * embedding_vec_size));
 
         if (lane_idx == (size_t)next_lane) {
@@ -855,11 +866,14 @@ __global__ void insert_replace_kernel(const key_type* d_keys, const float* d_val
 #ifdef LIBCUDACXX_VERSION
 // Kernel to update the existing keys in the cache
 // Will not change the locality information
-template <typename key_type, typename slabset, typename set_hasher, typename slab_hasher,
-          typename mutex, key_type empty_key, int set_associativity, int warp_size>
+template <typename key_type, typename ref_counter_type, typename atomic_ref_counter_type,
+          typename slabset, typename set_hasher, typename slab_hasher, typename mutex,
+          key_type empty_key, int set_associativity, int warp_size>
 __global__ void update_kernel(const key_type* d_keys, const size_t len, const float* d_values,
-                              const size_t embedding_vec_size, const size_t capacity_in_set,
-                              const slabset* keys, float* vals, mutex* set_mutex,
+                              const size_t embedding_vec_size, const size_t value_stride,
+                              const size_t capacity_in_set, const slabset* keys, float* vals,
+                              ref_counter_type* update_counter,
+                              const atomic_ref_counter_type* global_counter, mutex* set_mutex,
                               const size_t task_per_warp_tile) {
   // Lane(thread) ID within a warp_tile
   cg::thread_block_tile<warp_size> warp_tile =
@@ -932,10 +946,11 @@ __global__ void update_kernel(const key_type* d_keys, const size_t len, const fl
         size_t found_offset = (next_set * set_associativity + next_slab) * warp_size + found_lane;
         if (lane_idx == (size_t)next_lane) {
           active = false;
+          update_counter[found_offset] = global_counter->load(cuda::std::memory_order_relaxed);
         }
 
         warp_tile_copy<warp_size>(lane_idx, embedding_vec_size,
-                                  vals + found_offset * embedding_vec_size,
+                                  vals + found_offset * value_stride,
                                   d_values + next_idx * embedding_vec_size);
 
         active_mask = warp_tile.ballot(active);
@@ -965,11 +980,13 @@ __global__ void update_kernel(const key_type* d_keys, const size_t len, const fl
 #else
 // Kernel to update the existing keys in the cache
 // Will not change the locality information
-template <typename key_type, typename slabset, typename set_hasher, typename slab_hasher,
-          key_type empty_key, int set_associativity, int warp_size>
+template <typename key_type, typename ref_counter_type, typename slabset, typename set_hasher,
+          typename slab_hasher, key_type empty_key, int set_associativity, int warp_size>
 __global__ void update_kernel(const key_type* d_keys, const size_t len, const float* d_values,
-                              const size_t embedding_vec_size, const size_t capacity_in_set,
-                              volatile slabset* keys, volatile float* vals, volatile int* set_mutex,
+                              const size_t embedding_vec_size, const size_t value_stride,
+                              const size_t capacity_in_set, volatile slabset* keys,
+                              volatile float* vals, ref_counter_type* update_counter,
+                              ref_counter_type* global_counter, volatile int* set_mutex,
                               const size_t task_per_warp_tile) {
   // Lane(thread) ID within a warp_tile
   cg::thread_block_tile<warp_size> warp_tile =
@@ -1042,10 +1059,11 @@ __global__ void update_kernel(const key_type* d_keys, const size_t len, const fl
         size_t found_offset = (next_set * set_associativity + next_slab) * warp_size + found_lane;
         if (lane_idx == (size_t)next_lane) {
           active = false;
+          update_counter[found_offset] = atomicAdd(global_counter, 0);
         }
 
         warp_tile_copy<warp_size>(lane_idx, embedding_vec_size,
-                                  (volatile float*)(vals + found_offset * embedding_vec_size),
+                                  (volatile float*)(vals + found_offset * value_stride),
                                   (volatile float*)(d_values + next_idx * embedding_vec_size));
 
         active_mask = warp_tile.ballot(active);
@@ -1075,11 +1093,12 @@ __global__ void update_kernel(const key_type* d_keys, const size_t len, const fl
 #endif
 
 #ifdef LIBCUDACXX_VERSION
-template <typename key_type, typename slabset, typename mutex, key_type empty_key,
-          int set_associativity, int warp_size>
+template <typename key_type, typename ref_counter_type, typename slabset, typename mutex,
+          key_type empty_key, int set_associativity, int warp_size>
 __global__ void dump_kernel(key_type* d_keys, size_t* d_dump_counter, const slabset* keys,
-                            mutex* set_mutex, const size_t start_set_index,
-                            const size_t end_set_index) {
+                            const ref_counter_type* update_counter,
+                            const ref_counter_type dirty_threshold, mutex* set_mutex,
+                            const size_t start_set_index, const size_t end_set_index) {
   // Block-level counter used by all warp tiles within a block
   __shared__ uint32_t block_acc;
   // Initialize block-level counter
@@ -1096,6 +1115,8 @@ __global__ void dump_kernel(key_type* d_keys, size_t* d_dump_counter, const slab
       ((blockIdx.x * (blockDim.x / warp_size)) + warp_tile.meta_group_rank()) + start_set_index;
   // Keys dump from cache
   key_type read_key[set_associativity];
+  // Write sequence numbers of the dumped keys
+  ref_counter_type read_seq[set_associativity];
   // Lane(thread) offset for storing each key
   uint32_t thread_key_offset[set_associativity];
   // Warp offset for storing each key
@@ -1112,6 +1133,8 @@ __global__ void dump_kernel(key_type* d_keys, size_t* d_dump_counter, const slab
     for (unsigned slab_id = 0; slab_id < set_associativity; slab_id++) {
       // The warp tile read out a slab
       read_key[slab_id] = keys[set_idx].set_[slab_id].slab_[lane_idx];
+      read_seq[slab_id] =
+          update_counter[(set_idx * set_associativity + slab_id) * warp_size + lane_idx];
     }
 
     // Finish dumping the slabset, unlock the slabset
@@ -1120,7 +1143,8 @@ __global__ void dump_kernel(key_type* d_keys, size_t* d_dump_counter, const slab
     // Each lane(thread) within the warp tile calculate the offset to store its keys
     uint32_t warp_tile_total_keys = 0;
     for (unsigned slab_id = 0; slab_id < set_associativity; slab_id++) {
-      unsigned valid_mask = warp_tile.ballot(read_key[slab_id] != empty_key);
+      unsigned valid_mask =
+          warp_tile.ballot(read_key[slab_id] != empty_key && read_seq[slab_id] >= dirty_threshold);
       thread_key_offset[slab_id] =
           __popc(valid_mask & ((1U << lane_idx) - 1U)) + warp_tile_total_keys;
       warp_tile_total_keys = warp_tile_total_keys + __popc(valid_mask);
@@ -1143,18 +1167,19 @@ __global__ void dump_kernel(key_type* d_keys, size_t* d_dump_counter, const slab
   // Warp tile store the (non-empty)keys back to output buffer
   if (set_idx < end_set_index) {
     for (unsigned slab_id = 0; slab_id < set_associativity; slab_id++) {
-      if (read_key[slab_id] != empty_key) {
+      if (read_key[slab_id] != empty_key && read_seq[slab_id] >= dirty_threshold) {
         d_keys[block_key_offset + warp_key_offset + thread_key_offset[slab_id]] = read_key[slab_id];
       }
     }
   }
 }
 #else
-template <typename key_type, typename slabset, key_type empty_key, int set_associativity,
-          int warp_size>
+template <typename key_type, typename ref_counter_type, typename slabset, key_type empty_key,
+          int set_associativity, int warp_size>
 __global__ void dump_kernel(key_type* d_keys, size_t* d_dump_counter, volatile slabset* keys,
-                            volatile int* set_mutex, const size_t start_set_index,
-                            const size_t end_set_index) {
+                            const ref_counter_type* update_counter,
+                            const ref_counter_type dirty_threshold, volatile int* set_mutex,
+                            const size_t start_set_index, const size_t end_set_index) {
   // Block-level counter used by all warp tiles within a block
   __shared__ uint32_t block_acc;
   // Initialize block-level counter
@@ -1171,6 +1196,8 @@ __global__ void dump_kernel(key_type* d_keys, size_t* d_dump_counter, volatile s
       ((blockIdx.x * (blockDim.x / warp_size)) + warp_tile.meta_group_rank()) + start_set_index;
   // Keys dump from cache
   key_type read_key[set_associativity];
+  // Write sequence numbers of the dumped keys
+  ref_counter_type read_seq[set_associativity];
   // Lane(thread) offset for storing each key
   uint32_t thread_key_offset[set_associativity];
   // Warp offset for storing each key
@@ -1187,6 +1214,8 @@ __global__ void dump_kernel(key_type* d_keys, size_t* d_dump_counter, volatile s
     for (unsigned slab_id = 0; slab_id < set_associativity; slab_id++) {
       // The warp tile read out a slab
       read_key[slab_id] = ((volatile key_type*)(keys[set_idx].set_[slab_id].slab_))[lane_idx];
+      read_seq[slab_id] =
+          update_counter[(set_idx * set_associativity + slab_id) * warp_size + lane_idx];
     }
 
     // Finish dumping the slabset, unlock the slabset
@@ -1195,7 +1224,8 @@ __global__ void dump_kernel(key_type* d_keys, size_t* d_dump_counter, volatile s
     // Each lane(thread) within the warp tile calculate the offset to store its keys
     uint32_t warp_tile_total_keys = 0;
     for (unsigned slab_id = 0; slab_id < set_associativity; slab_id++) {
-      unsigned valid_mask = warp_tile.ballot(read_key[slab_id] != empty_key);
+      unsigned valid_mask =
+          warp_tile.ballot(read_key[slab_id] != empty_key && read_seq[slab_id] >= dirty_threshold);
       thread_key_offset[slab_id] =
           __popc(valid_mask & ((1U << lane_idx) - 1U)) + warp_tile_total_keys;
       warp_tile_total_keys = warp_tile_total_keys + __popc(valid_mask);
@@ -1218,7 +1248,7 @@ __global__ void dump_kernel(key_type* d_keys, size_t* d_dump_counter, volatile s
   // Warp tile store the (non-empty)keys back to output buffer
   if (set_idx < end_set_index) {
     for (unsigned slab_id = 0; slab_id < set_associativity; slab_id++) {
-      if (read_key[slab_id] != empty_key) {
+      if (read_key[slab_id] != empty_key && read_seq[slab_id] >= dirty_threshold) {
         d_keys[block_key_offset + warp_key_offset + thread_key_offset[slab_id]] = read_key[slab_id];
       }
     }
@@ -1262,6 +1292,10 @@ gpu_cache<key_type, ref_counter_type, empty_key, set_associativity, warp_size, s
   CUDA_CHECK(cudaMalloc((void**)&keys_, sizeof(slabset) * capacity_in_set_));
   CUDA_CHECK(cudaMalloc((void**)&vals_, sizeof(float) * embedding_vec_size_ * num_slot_));
   CUDA_CHECK(cudaMalloc((void**)&slot_counter_, sizeof(ref_counter_type) * num_slot_));
+  CUDA_CHECK(cudaMalloc((void**)&update_counter_, sizeof(ref_counter_type) * num_slot_));
+  CUDA_CHECK(cudaMemset(update_counter_, 0, sizeof(ref_counter_type) * num_slot_));
+  CUDA_CHECK(cudaMalloc((void**)&evict_counter_, sizeof(size_t)));
+  CUDA_CHECK(cudaMemset(evict_counter_, 0, sizeof(size_t)));
   CUDA_CHECK(cudaMalloc((void**)&global_counter_, sizeof(atomic_ref_counter_type)));
 
   // Allocate GPU memory for set mutex
@@ -1310,6 +1344,10 @@ gpu_cache<key_type, ref_counter_type, empty_key, set_associativity, warp_size, s
   CUDA_CHECK(cudaMalloc((void**)&keys_, sizeof(slabset) * capacity_in_set_));
   CUDA_CHECK(cudaMalloc((void**)&vals_, sizeof(float) * embedding_vec_size_ * num_slot_));
   CUDA_CHECK(cudaMalloc((void**)&slot_counter_, sizeof(ref_counter_type) * num_slot_));
+  CUDA_CHECK(cudaMalloc((void**)&update_counter_, sizeof(ref_counter_type) * num_slot_));
+  CUDA_CHECK(cudaMemset(update_counter_, 0, sizeof(ref_counter_type) * num_slot_));
+  CUDA_CHECK(cudaMalloc((void**)&evict_counter_, sizeof(size_t)));
+  CUDA_CHECK(cudaMemset(evict_counter_, 0, sizeof(size_t)));
   CUDA_CHECK(cudaMalloc((void**)&global_counter_, sizeof(ref_counter_type)));
 
   // Allocate GPU memory for set mutex
@@ -1336,6 +1374,18 @@ gpu_cache<key_type, ref_counter_type, empty_key, set_associativity, warp_size, s
   // Set device
   CUDA_CHECK(cudaSetDevice(dev_));
 
+  // Tear down the asynchronous replace pipeline.
+  if (replace_stream_ != nullptr) {
+    CUDA_CHECK(cudaStreamSynchronize(replace_stream_));
+    for (int i = 0; i < 2; i++) {
+      CUDA_CHECK(cudaEventDestroy(replace_staged_[i]));
+      CUDA_CHECK(cudaEventDestroy(replace_consumed_[i]));
+      CUDA_CHECK(cudaFree(replace_keys_buf_[i]));
+      CUDA_CHECK(cudaFree(replace_vals_buf_[i]));
+    }
+    CUDA_CHECK(cudaStreamDestroy(replace_stream_));
+  }
+
   // Destruct CUDA std object
   destruct_kernel<<<((capacity_in_set_ - 1) / BLOCK_SIZE_) + 1, BLOCK_SIZE_>>>(
       global_counter_, set_mutex_, capacity_in_set_);
@@ -1346,6 +1396,8 @@ gpu_cache<key_type, ref_counter_type, empty_key, set_associativity, warp_size, s
   CUDA_CHECK(cudaFree(keys_));
   CUDA_CHECK(cudaFree(vals_));
   CUDA_CHECK(cudaFree(slot_counter_));
+  CUDA_CHECK(cudaFree(update_counter_));
+  CUDA_CHECK(cudaFree(evict_counter_));
   CUDA_CHECK(cudaFree(global_counter_));
   // Free GPU memory for set mutex
   CUDA_CHECK(cudaFree(set_mutex_));
@@ -1361,10 +1413,24 @@ gpu_cache<key_type, ref_counter_type, empty_key, set_associativity, warp_size, s
   // Set device
   CUDA_CHECK(cudaSetDevice(dev_));
 
+  // Tear down the asynchronous replace pipeline.
+  if (replace_stream_ != nullptr) {
+    CUDA_CHECK(cudaStreamSynchronize(replace_stream_));
+    for (int i = 0; i < 2; i++) {
+      CUDA_CHECK(cudaEventDestroy(replace_staged_[i]));
+      CUDA_CHECK(cudaEventDestroy(replace_consumed_[i]));
+      CUDA_CHECK(cudaFree(replace_keys_buf_[i]));
+      CUDA_CHECK(cudaFree(replace_vals_buf_[i]));
+    }
+    CUDA_CHECK(cudaStreamDestroy(replace_stream_));
+  }
+
   // Free GPU memory for cache
   CUDA_CHECK(cudaFree(keys_));
   CUDA_CHECK(cudaFree(vals_));
   CUDA_CHECK(cudaFree(slot_counter_));
+  CUDA_CHECK(cudaFree(update_counter_));
+  CUDA_CHECK(cudaFree(evict_counter_));
   CUDA_CHECK(cudaFree(global_counter_));
   // Free GPU memory for set mutex
   CUDA_CHECK(cudaFree(set_mutex_));
@@ -1376,9 +1442,9 @@ template <typename key_type, typename ref_counter_type, key_type empty_key, int
           int warp_size, typename set_hasher, typename slab_hasher>
 void gpu_cache<key_type, ref_counter_type, empty_key, set_associativity, warp_size, set_hasher,
                slab_hasher>::Query(const key_type* d_keys, const size_t len, float* d_values,
-                                   uint64_t* d_missing_index, key_type* d_missing_keys,
-                                   size_t* d_missing_len, cudaStream_t stream,
-                                   const size_t task_per_warp_tile) {
+                                   const size_t embedding_vec_size, uint64_t* d_missing_index,
+                                   key_type* d_missing_keys, size_t* d_missing_len,
+                                   cudaStream_t stream, const size_t task_per_warp_tile) {
   // Device Restorer
   nv::CudaDeviceRestorer dev_restorer;
   // Set to the device of this cache
@@ -1390,6 +1456,11 @@ void gpu_cache<key_type, ref_counter_type, empty_key, set_associativity, warp_si
     CUDA_CHECK(cudaMemsetAsync(d_missing_len, 0, sizeof(size_t), stream));
     return;
   }
+  if (embedding_vec_size > embedding_vec_size_) {
+    printf("Error: Invalid value for embedding_vec_size. Nothing queried.\n");
+    CUDA_CHECK(cudaMemsetAsync(d_missing_len, 0, sizeof(size_t), stream));
+    return;
+  }
 
   // Update the global counter as user perform a new(most recent) read operation to the cache
   // Resolve distance overflow issue as well.
@@ -1402,9 +1473,9 @@ void gpu_cache<key_type, ref_counter_type, empty_key, set_associativity, warp_si
   const size_t grid_size = ((len - 1) / keys_per_block) + 1;
   get_kernel<key_type, ref_counter_type, atomic_ref_counter_type, slabset, set_hasher, slab_hasher,
              mutex, empty_key, set_associativity, warp_size><<<grid_size, BLOCK_SIZE_, 0, stream>>>(
-      d_keys, len, d_values, embedding_vec_size_, d_missing_index, d_missing_keys, d_missing_len,
-      global_counter_, slot_counter_, capacity_in_set_, keys_, vals_, set_mutex_,
-      task_per_warp_tile);
+      d_keys, len, d_values, embedding_vec_size, embedding_vec_size_, d_missing_index,
+      d_missing_keys, d_missing_len, global_counter_, slot_counter_, capacity_in_set_, keys_, vals_,
+      set_mutex_, task_per_warp_tile);
 
   // Check for GPU error before return
   CUDA_CHECK(cudaGetLastError());
@@ -1414,9 +1485,9 @@ template <typename key_type, typename ref_counter_type, key_type empty_key, int
           int warp_size, typename set_hasher, typename slab_hasher>
 void gpu_cache<key_type, ref_counter_type, empty_key, set_associativity, warp_size, set_hasher,
                slab_hasher>::Query(const key_type* d_keys, const size_t len, float* d_values,
-                                   uint64_t* d_missing_index, key_type* d_missing_keys,
-                                   size_t* d_missing_len, cudaStream_t stream,
-                                   const size_t task_per_warp_tile) {
+                                   const size_t embedding_vec_size, uint64_t* d_missing_index,
+                                   key_type* d_missing_keys, size_t* d_missing_len,
+                                   cudaStream_t stream, const size_t task_per_warp_tile) {
   // Device Restorer
   nv::CudaDeviceRestorer dev_restorer;
   // Set to the device of this cache
@@ -1428,6 +1499,11 @@ void gpu_cache<key_type, ref_counter_type, empty_key, set_associativity, warp_si
     CUDA_CHECK(cudaMemsetAsync(d_missing_len, 0, sizeof(size_t), stream));
     return;
   }
+  if (embedding_vec_size > embedding_vec_size_) {
+    printf("Error: Invalid value for embedding_vec_size. Nothing queried.\n");
+    CUDA_CHECK(cudaMemsetAsync(d_missing_len, 0, sizeof(size_t), stream));
+    return;
+  }
 
   // Update the global counter as user perform a new(most recent) read operation to the cache
   // Resolve distance overflow issue as well.
@@ -1440,9 +1516,9 @@ void gpu_cache<key_type, ref_counter_type, empty_key, set_associativity, warp_si
   const size_t grid_size = ((len - 1) / keys_per_block) + 1;
   get_kernel<key_type, ref_counter_type, slabset, set_hasher, slab_hasher, empty_key,
              set_associativity, warp_size><<<grid_size, BLOCK_SIZE_, 0, stream>>>(
-      d_keys, len, d_values, embedding_vec_size_, d_missing_index, d_missing_keys, d_missing_len,
-      global_counter_, slot_counter_, capacity_in_set_, keys_, vals_, set_mutex_,
-      task_per_warp_tile);
+      d_keys, len, d_values, embedding_vec_size, embedding_vec_size_, d_missing_index,
+      d_missing_keys, d_missing_len, global_counter_, slot_counter_, capacity_in_set_, keys_, vals_,
+      set_mutex_, task_per_warp_tile);
 
   // Check for GPU error before return
   CUDA_CHECK(cudaGetLastError());
@@ -1454,12 +1530,16 @@ template <typename key_type, typename ref_counter_type, key_type empty_key, int
           int warp_size, typename set_hasher, typename slab_hasher>
 void gpu_cache<key_type, ref_counter_type, empty_key, set_associativity, warp_size, set_hasher,
                slab_hasher>::Replace(const key_type* d_keys, const size_t len,
-                                     const float* d_values, cudaStream_t stream,
-                                     const size_t task_per_warp_tile) {
+                                     const float* d_values, const size_t embedding_vec_size,
+                                     cudaStream_t stream, const size_t task_per_warp_tile) {
   // Check if it is a valid replacement
   if (len == 0) {
     return;
   }
+  if (embedding_vec_size > embedding_vec_size_) {
+    printf("Error: Invalid value for embedding_vec_size. Nothing replaced.\n");
+    return;
+  }
 
   // Device Restorer
   nv::CudaDeviceRestorer dev_restorer;
@@ -1472,9 +1552,11 @@ void gpu_cache<key_type, ref_counter_type, empty_key, set_associativity, warp_si
   const size_t grid_size = ((len - 1) / keys_per_block) + 1;
   insert_replace_kernel<key_type, slabset, ref_counter_type, mutex, atomic_ref_counter_type,
                         set_hasher, slab_hasher, empty_key, set_associativity, warp_size>
-      <<<grid_size, BLOCK_SIZE_, 0, stream>>>(d_keys, d_values, embedding_vec_size_, len, keys_,
-                                              vals_, slot_counter_, set_mutex_, global_counter_,
-                                              capacity_in_set_, task_per_warp_tile);
+      <<<grid_size, BLOCK_SIZE_, 0, stream>>>(d_keys, d_values, embedding_vec_size,
+                                              embedding_vec_size_, len, keys_, vals_, slot_counter_,
+                                              update_counter_, set_mutex_, global_counter_,
+                                              capacity_in_set_, task_per_warp_tile,
+                                              evict_counter_);
 
   // Check for GPU error before return
   CUDA_CHECK(cudaGetLastError());
@@ -1484,12 +1566,16 @@ template <typename key_type, typename ref_counter_type, key_type empty_key, int
           int warp_size, typename set_hasher, typename slab_hasher>
 void gpu_cache<key_type, ref_counter_type, empty_key, set_associativity, warp_size, set_hasher,
                slab_hasher>::Replace(const key_type* d_keys, const size_t len,
-                                     const float* d_values, cudaStream_t stream,
-                                     const size_t task_per_warp_tile) {
+                                     const float* d_values, const size_t embedding_vec_size,
+                                     cudaStream_t stream, const size_t task_per_warp_tile) {
   // Check if it is a valid replacement
   if (len == 0) {
     return;
   }
+  if (embedding_vec_size > embedding_vec_size_) {
+    printf("Error: Invalid value for embedding_vec_size. Nothing replaced.\n");
+    return;
+  }
 
   // Device Restorer
   nv::CudaDeviceRestorer dev_restorer;
@@ -1502,24 +1588,93 @@ void gpu_cache<key_type, ref_counter_type, empty_key, set_associativity, warp_si
   const size_t grid_size = ((len - 1) / keys_per_block) + 1;
   insert_replace_kernel<key_type, slabset, ref_counter_type, set_hasher, slab_hasher, empty_key,
                         set_associativity, warp_size><<<grid_size, BLOCK_SIZE_, 0, stream>>>(
-      d_keys, d_values, embedding_vec_size_, len, keys_, vals_, slot_counter_, set_mutex_,
-      global_counter_, capacity_in_set_, task_per_warp_tile);
+      d_keys, d_values, embedding_vec_size, embedding_vec_size_, len, keys_, vals_, slot_counter_,
+      update_counter_, set_mutex_, global_counter_, capacity_in_set_, task_per_warp_tile,
+      evict_counter_);
 
   // Check for GPU error before return
   CUDA_CHECK(cudaGetLastError());
 }
 #endif
 
+template <typename key_type, typename ref_counter_type, key_type empty_key, int set_associativity,
+          int warp_size, typename set_hasher, typename slab_hasher>
+void gpu_cache<key_type, ref_counter_type, empty_key, set_associativity, warp_size, set_hasher,
+               slab_hasher>::ReplaceAsync(const key_type* d_keys, const size_t len,
+                                          const float* d_values, const size_t embedding_vec_size,
+                                          cudaStream_t stream) {
+  // Check if it is a valid replacement
+  if (len == 0) {
+    return;
+  }
+  if (embedding_vec_size > embedding_vec_size_) {
+    printf("Error: Invalid value for embedding_vec_size. Nothing replaced.\n");
+    return;
+  }
+
+  // Device Restorer
+  nv::CudaDeviceRestorer dev_restorer;
+  // Set to the device of this cache
+  CUDA_CHECK(cudaSetDevice(dev_));
+
+  // Lazily create the double-buffered replace pipeline. The replace stream runs at the lowest
+  // priority, so query kernels on other streams are scheduled preferentially.
+  if (replace_stream_ == nullptr) {
+    int least_priority;
+    int greatest_priority;
+    CUDA_CHECK(cudaDeviceGetStreamPriorityRange(&least_priority, &greatest_priority));
+    CUDA_CHECK(
+        cudaStreamCreateWithPriority(&replace_stream_, cudaStreamNonBlocking, least_priority));
+    for (int i = 0; i < 2; i++) {
+      CUDA_CHECK(cudaMalloc((void**)&replace_keys_buf_[i], REPLACE_BUFFER_LEN_ * sizeof(key_type)));
+      CUDA_CHECK(cudaMalloc((void**)&replace_vals_buf_[i],
+                            REPLACE_BUFFER_LEN_ * embedding_vec_size_ * sizeof(float)));
+      CUDA_CHECK(cudaEventCreateWithFlags(&replace_staged_[i], cudaEventDisableTiming));
+      CUDA_CHECK(cudaEventCreateWithFlags(&replace_consumed_[i], cudaEventDisableTiming));
+      CUDA_CHECK(cudaEventRecord(replace_consumed_[i], replace_stream_));
+    }
+  }
+
+  // Stage and consume the <k,v> pairs chunk-by-chunk, ping-ponging between the two side buffers:
+  // while the replace stream consumes one buffer, the caller's stream stages into the other.
+  for (size_t offset = 0; offset < len; offset += REPLACE_BUFFER_LEN_) {
+    const size_t chunk_len = (len - offset) < REPLACE_BUFFER_LEN_ ? (len - offset)
+                                                                  : REPLACE_BUFFER_LEN_;
+    const int buf = replace_buf_idx_;
+    replace_buf_idx_ = (replace_buf_idx_ + 1) % 2;
+
+    // Stage the chunk once the replace stream has finished consuming this buffer.
+    CUDA_CHECK(cudaStreamWaitEvent(stream, replace_consumed_[buf], 0));
+    CUDA_CHECK(cudaMemcpyAsync(replace_keys_buf_[buf], d_keys + offset,
+                               chunk_len * sizeof(key_type), cudaMemcpyDeviceToDevice, stream));
+    CUDA_CHECK(cudaMemcpyAsync(replace_vals_buf_[buf], d_values + offset * embedding_vec_size,
+                               chunk_len * embedding_vec_size * sizeof(float),
+                               cudaMemcpyDeviceToDevice, stream));
+    CUDA_CHECK(cudaEventRecord(replace_staged_[buf], stream));
+
+    // Consume the staged chunk on the replace stream.
+    CUDA_CHECK(cudaStreamWaitEvent(replace_stream_, replace_staged_[buf], 0));
+    Replace(replace_keys_buf_[buf], chunk_len, replace_vals_buf_[buf], embedding_vec_size,
+            replace_stream_, TASK_PER_WARP_TILE_MACRO);
+    CUDA_CHECK(cudaEventRecord(replace_consumed_[buf], replace_stream_));
+  }
+}
+
 #ifdef LIBCUDACXX_VERSION
 template <typename key_type, typename ref_counter_type, key_type empty_key, int set_associativity,
           int warp_size, typename set_hasher, typename slab_hasher>
 void gpu_cache<key_type, ref_counter_type, empty_key, set_associativity, warp_size, set_hasher,
                slab_hasher>::Update(const key_type* d_keys, const size_t len, const float* d_values,
-                                    cudaStream_t stream, const size_t task_per_warp_tile) {
+                                    const size_t embedding_vec_size, cudaStream_t stream,
+                                    const size_t task_per_warp_tile) {
   // Check if it is a valid update request
   if (len == 0) {
     return;
   }
+  if (embedding_vec_size > embedding_vec_size_) {
+    printf("Error: Invalid value for embedding_vec_size. Nothing updated.\n");
+    return;
+  }
 
   // Device Restorer
   nv::CudaDeviceRestorer dev_restorer;
@@ -1529,10 +1684,12 @@ void gpu_cache<key_type, ref_counter_type, empty_key, set_associativity, warp_si
   // Update the value of input keys that are existed in the cache
   const size_t keys_per_block = (BLOCK_SIZE_ / warp_size) * task_per_warp_tile;
   const size_t grid_size = ((len - 1) / keys_per_block) + 1;
-  update_kernel<key_type, slabset, set_hasher, slab_hasher, mutex, empty_key, set_associativity,
-                warp_size><<<grid_size, BLOCK_SIZE_, 0, stream>>>(
-      d_keys, len, d_values, embedding_vec_size_, capacity_in_set_, keys_, vals_, set_mutex_,
-      task_per_warp_tile);
+  update_kernel<key_type, ref_counter_type, atomic_ref_counter_type, slabset, set_hasher,
+                slab_hasher, mutex, empty_key, set_associativity, warp_size>
+      <<<grid_size, BLOCK_SIZE_, 0, stream>>>(d_keys, len, d_values, embedding_vec_size,
+                                              embedding_vec_size_, capacity_in_set_, keys_, vals_,
+                                              update_counter_, global_counter_, set_mutex_,
+                                              task_per_warp_tile);
 
   // Check for GPU error before return
   CUDA_CHECK(cudaGetLastError());
@@ -1542,11 +1699,16 @@ template <typename key_type, typename ref_counter_type, key_type empty_key, int
           int warp_size, typename set_hasher, typename slab_hasher>
 void gpu_cache<key_type, ref_counter_type, empty_key, set_associativity, warp_size, set_hasher,
                slab_hasher>::Update(const key_type* d_keys, const size_t len, const float* d_values,
-                                    cudaStream_t stream, const size_t task_per_warp_tile) {
+                                    const size_t embedding_vec_size, cudaStream_t stream,
+                                    const size_t task_per_warp_tile) {
   // Check if it is a valid update request
   if (len == 0) {
     return;
   }
+  if (embedding_vec_size > embedding_vec_size_) {
+    printf("Error: Invalid value for embedding_vec_size. Nothing updated.\n");
+    return;
+  }
 
   // Device Restorer
   nv::CudaDeviceRestorer dev_restorer;
@@ -1556,9 +1718,11 @@ void gpu_cache<key_type, ref_counter_type, empty_key, set_associativity, warp_si
   // Update the value of input keys that are existed in the cache
   const size_t keys_per_block = (BLOCK_SIZE_ / warp_size) * task_per_warp_tile;
   const size_t grid_size = ((len - 1) / keys_per_block) + 1;
-  update_kernel<key_type, slabset, set_hasher, slab_hasher, empty_key, set_associativity, warp_size>
-      <<<grid_size, BLOCK_SIZE_, 0, stream>>>(d_keys, len, d_values, embedding_vec_size_,
-                                              capacity_in_set_, keys_, vals_, set_mutex_,
+  update_kernel<key_type, ref_counter_type, slabset, set_hasher, slab_hasher, empty_key,
+                set_associativity, warp_size>
+      <<<grid_size, BLOCK_SIZE_, 0, stream>>>(d_keys, len, d_values, embedding_vec_size,
+                                              embedding_vec_size_, capacity_in_set_, keys_, vals_,
+                                              update_counter_, global_counter_, set_mutex_,
                                               task_per_warp_tile);
 
   // Check for GPU error before return
@@ -1572,7 +1736,7 @@ template <typename key_type, typename ref_counter_type, key_type empty_key, int
 void gpu_cache<key_type, ref_counter_type, empty_key, set_associativity, warp_size, set_hasher,
                slab_hasher>::Dump(key_type* d_keys, size_t* d_dump_counter,
                                   const size_t start_set_index, const size_t end_set_index,
-                                  cudaStream_t stream) {
+                                  const size_t dirty_threshold, cudaStream_t stream) {
   // Check if it is a valid dump request
   if (start_set_index >= capacity_in_set_) {
     printf("Error: Invalid value for start_set_index. Nothing dumped.\n");
@@ -1594,9 +1758,11 @@ void gpu_cache<key_type, ref_counter_type, empty_key, set_associativity, warp_si
   // Dump keys from the cache
   const size_t grid_size =
       (((end_set_index - start_set_index) - 1) / (BLOCK_SIZE_ / warp_size)) + 1;
-  dump_kernel<key_type, slabset, mutex, empty_key, set_associativity, warp_size>
-      <<<grid_size, BLOCK_SIZE_, 0, stream>>>(d_keys, d_dump_counter, keys_, set_mutex_,
-                                              start_set_index, end_set_index);
+  dump_kernel<key_type, ref_counter_type, slabset, mutex, empty_key, set_associativity, warp_size>
+      <<<grid_size, BLOCK_SIZE_, 0, stream>>>(
+          d_keys, d_dump_counter, keys_, update_counter_,
+          static_cast<ref_counter_type>(dirty_threshold), set_mutex_, start_set_index,
+          end_set_index);
 
   // Check for GPU error before return
   CUDA_CHECK(cudaGetLastError());
@@ -1607,7 +1773,7 @@ template <typename key_type, typename ref_counter_type, key_type empty_key, int
 void gpu_cache<key_type, ref_counter_type, empty_key, set_associativity, warp_size, set_hasher,
                slab_hasher>::Dump(key_type* d_keys, size_t* d_dump_counter,
                                   const size_t start_set_index, const size_t end_set_index,
-                                  cudaStream_t stream) {
+                                  const size_t dirty_threshold, cudaStream_t stream) {
   // Check if it is a valid dump request
   if (start_set_index >= capacity_in_set_) {
     printf("Error: Invalid value for start_set_index. Nothing dumped.\n");
@@ -1629,17 +1795,129 @@ void gpu_cache<key_type, ref_counter_type, empty_key, set_associativity, warp_si
   // Dump keys from the cache
   const size_t grid_size =
       (((end_set_index - start_set_index) - 1) / (BLOCK_SIZE_ / warp_size)) + 1;
-  dump_kernel<key_type, slabset, empty_key, set_associativity, warp_size>
-      <<<grid_size, BLOCK_SIZE_, 0, stream>>>(d_keys, d_dump_counter, keys_, set_mutex_,
-                                              start_set_index, end_set_index);
+  dump_kernel<key_type, ref_counter_type, slabset, empty_key, set_associativity, warp_size>
+      <<<grid_size, BLOCK_SIZE_, 0, stream>>>(
+          d_keys, d_dump_counter, keys_, update_counter_,
+          static_cast<ref_counter_type>(dirty_threshold), set_mutex_, start_set_index,
+          end_set_index);
 
   // Check for GPU error before return
   CUDA_CHECK(cudaGetLastError());
 }
 #endif
 
-template class gpu_cache<unsigned int, uint64_t, std::numeric_limits<unsigned int>::max(),
-                         SET_ASSOCIATIVITY, SLAB_SIZE>;
-template class gpu_cache<long long, uint64_t, std::numeric_limits<long long>::max(),
-                         SET_ASSOCIATIVITY, SLAB_SIZE>;
+// Full Dump: a threshold of 0 matches every resident entry, since the update counter is set on
+// every insertion.
+template <typename key_type, typename ref_counter_type, key_type empty_key, int set_associativity,
+          int warp_size, typename set_hasher, typename slab_hasher>
+void gpu_cache<key_type, ref_counter_type, empty_key, set_associativity, warp_size, set_hasher,
+               slab_hasher>::Dump(key_type* d_keys, size_t* d_dump_counter,
+                                  const size_t start_set_index, const size_t end_set_index,
+                                  cudaStream_t stream) {
+  Dump(d_keys, d_dump_counter, start_set_index, end_set_index, 0, stream);
+}
+
+template <typename key_type, typename ref_counter_type, key_type empty_key, int set_associativity,
+          int warp_size, typename set_hasher, typename slab_hasher>
+size_t gpu_cache<key_type, ref_counter_type, empty_key, set_associativity, warp_size, set_hasher,
+                 slab_hasher>::GetSequenceNumber() {
+  // Device Restorer
+  nv::CudaDeviceRestorer dev_restorer;
+  // Set to the device of this cache
+  CUDA_CHECK(cudaSetDevice(dev_));
+
+  // The global counter increases monotonically, so a plain copy of its storage is a valid lower
+  // bound for the sequence number of any later modification.
+  ref_counter_type sequence_number = 0;
+  CUDA_CHECK(cudaMemcpy(&sequence_number, global_counter_, sizeof(ref_counter_type),
+                        cudaMemcpyDeviceToHost));
+  return static_cast<size_t>(sequence_number);
+}
+
+template <typename key_type, typename ref_counter_type, key_type empty_key, int set_associativity,
+          int warp_size, typename set_hasher, typename slab_hasher>
+void gpu_cache<key_type, ref_counter_type, empty_key, set_associativity, warp_size, set_hasher,
+               slab_hasher>::ReadEvictionCount(size_t* h_evict_count, cudaStream_t stream) {
+  // Device Restorer
+  nv::CudaDeviceRestorer dev_restorer;
+  // Set to the device of this cache
+  CUDA_CHECK(cudaSetDevice(dev_));
+
+  CUDA_CHECK(cudaMemcpyAsync(h_evict_count, evict_counter_, sizeof(size_t),
+                             cudaMemcpyDeviceToHost, stream));
+}
+
+// Fixed-width forwarders: operate on the full slot width the cache was constructed with.
+template <typename key_type, typename ref_counter_type, key_type empty_key, int set_associativity,
+          int warp_size, typename set_hasher, typename slab_hasher>
+void gpu_cache<key_type, ref_counter_type, empty_key, set_associativity, warp_size, set_hasher,
+               slab_hasher>::Query(const key_type* d_keys, const size_t len, float* d_values,
+                                   uint64_t* d_missing_index, key_type* d_missing_keys,
+                                   size_t* d_missing_len, cudaStream_t stream,
+                                   const size_t task_per_warp_tile) {
+  Query(d_keys, len, d_values, embedding_vec_size_, d_missing_index, d_missing_keys, d_missing_len,
+        stream, task_per_warp_tile);
+}
+
+template <typename key_type, typename ref_counter_type, key_type empty_key, int set_associativity,
+          int warp_size, typename set_hasher, typename slab_hasher>
+void gpu_cache<key_type, ref_counter_type, empty_key, set_associativity, warp_size, set_hasher,
+               slab_hasher>::Replace(const key_type* d_keys, const size_t len,
+                                     const float* d_values, cudaStream_t stream,
+                                     const size_t task_per_warp_tile) {
+  Replace(d_keys, len, d_values, embedding_vec_size_, stream, task_per_warp_tile);
+}
+
+template <typename key_type, typename ref_counter_type, key_type empty_key, int set_associativity,
+          int warp_size, typename set_hasher, typename slab_hasher>
+void gpu_cache<key_type, ref_counter_type, empty_key, set_associativity, warp_size, set_hasher,
+               slab_hasher>::Update(const key_type* d_keys, const size_t len, const float* d_values,
+                                    cudaStream_t stream, const size_t task_per_warp_tile) {
+  Update(d_keys, len, d_values, embedding_vec_size_, stream, task_per_warp_tile);
+}
+
+template <typename key_type, typename ref_counter_type, key_type empty_key, int warp_size>
+std::unique_ptr<gpu_cache_api<key_type>> create_gpu_cache(const int set_associativity,
+                                                          const size_t capacity_in_set,
+                                                          const size_t embedding_vec_size) {
+  switch (set_associativity) {
+    case 2:
+      return std::make_unique<gpu_cache<key_type, ref_counter_type, empty_key, 2, warp_size>>(
+          capacity_in_set, embedding_vec_size);
+    case 4:
+      return std::make_unique<gpu_cache<key_type, ref_counter_type, empty_key, 4, warp_size>>(
+          capacity_in_set, embedding_vec_size);
+    case 8:
+      return std::make_unique<gpu_cache<key_type, ref_counter_type, empty_key, 8, warp_size>>(
+          capacity_in_set, embedding_vec_size);
+    case 16:
+      return std::make_unique<gpu_cache<key_type, ref_counter_type, empty_key, 16, warp_size>>(
+          capacity_in_set, embedding_vec_size);
+    default:
+      throw nv::CudaException("set_associativity must be one of {2, 4, 8, 16}. Got: " +
+                              std::to_string(set_associativity));
+  }
+}
+
+// Pre-instantiated set associativities selectable through create_gpu_cache. Keep in sync with the
+// factory above.
+template class gpu_cache<unsigned int, uint64_t, std::numeric_limits<unsigned int>::max(), 2,
+                         SLAB_SIZE>;
+template class gpu_cache<unsigned int, uint64_t, std::numeric_limits<unsigned int>::max(), 4,
+                         SLAB_SIZE>;
+template class gpu_cache<unsigned int, uint64_t, std::numeric_limits<unsigned int>::max(), 8,
+                         SLAB_SIZE>;
+template class gpu_cache<unsigned int, uint64_t, std::numeric_limits<unsigned int>::max(), 16,
+                         SLAB_SIZE>;
+template class gpu_cache<long long, uint64_t, std::numeric_limits<long long>::max(), 2, SLAB_SIZE>;
+template class gpu_cache<long long, uint64_t, std::numeric_limits<long long>::max(), 4, SLAB_SIZE>;
+template class gpu_cache<long long, uint64_t, std::numeric_limits<long long>::max(), 8, SLAB_SIZE>;
+template class gpu_cache<long long, uint64_t, std::numeric_limits<long long>::max(), 16, SLAB_SIZE>;
+
+template std::unique_ptr<gpu_cache_api<unsigned int>>
+create_gpu_cache<unsigned int, uint64_t, std::numeric_limits<unsigned int>::max(), SLAB_SIZE>(
+    const int set_associativity, const size_t capacity_in_set, const size_t embedding_vec_size);
+template std::unique_ptr<gpu_cache_api<long long>>
+create_gpu_cache<long long, uint64_t, std::numeric_limits<long long>::max(), SLAB_SIZE>(
+    const int set_associativity, const size_t capacity_in_set, const size_t embedding_vec_size);
 }  // namespace gpu_cache
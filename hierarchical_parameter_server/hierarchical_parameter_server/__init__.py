@@ -22,6 +22,7 @@ from hierarchical_parameter_server.core.initialize import Init
 from hierarchical_parameter_server.core.initialize import wait_one_child
 from hierarchical_parameter_server.core.initialize import SetStepProfileValue
 from hierarchical_parameter_server.core.lookup_layer import LookupLayer
+from hierarchical_parameter_server.core.fused_lookup_layer import FusedLookupLayer
 from hierarchical_parameter_server.core.sparse_lookup_layer import SparseLookupLayer
 
 def _get_next_enum_val(next_val):
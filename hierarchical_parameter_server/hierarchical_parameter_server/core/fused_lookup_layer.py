@@ -0,0 +1,91 @@
+"""
+ Copyright (c) 2021, NVIDIA CORPORATION.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+"""
+
+import tensorflow as tf
+from hierarchical_parameter_server.core import lookup_ops
+
+
+class FusedLookupLayer(tf.keras.layers.Layer):
+    """
+    Abbreviated as ``hps.FusedLookupLayer(*args, **kwargs)``.
+
+    Fused counterpart of ``hps.LookupLayer`` for models with many embedding tables:
+    one layer call performs the lookup for all tables of the model with a single op
+    execution and a single batched HPS lookup, instead of one op per table. The
+    table_ids list must mention each table of the model exactly once.
+
+    Parameters
+    ----------
+    model_name: str
+            the name of the model that has embedding table(s)
+    table_ids: list of int
+            the indices of all embedding tables of the model specified by model_name
+    emb_vec_sizes: list of int
+            the embedding vector sizes of the tables, aligned with table_ids
+    emb_vec_dtype:
+            the data type of embedding vectors which must be tf.float32
+
+    Examples
+    --------
+    .. code-block:: python
+
+        import hierarchical_parameter_server as hps
+
+        fused_lookup_layer = hps.FusedLookupLayer(model_name = args.model_name,
+                                                  table_ids = list(range(args.num_tables)),
+                                                  emb_vec_sizes = args.embed_vec_sizes,
+                                                  emb_vec_dtype = tf.float32)
+
+        @tf.function
+        def _infer_step(inputs_per_table):
+            embedding_vectors = fused_lookup_layer(inputs_per_table)
+            ...
+    """
+
+    def __init__(self, model_name, table_ids, emb_vec_sizes, emb_vec_dtype, **kwargs):
+        super(FusedLookupLayer, self).__init__(**kwargs)
+        self.model_name = model_name
+        self.table_ids = table_ids
+        self.emb_vec_sizes = emb_vec_sizes
+        self.emb_vec_dtype = emb_vec_dtype
+
+    def call(self, inputs):
+        """
+        The forward logic of this wrapper class.
+
+        Parameters
+        ----------
+        inputs:
+                list of key tensors, aligned with table_ids. The data type must be
+                tf.int64.
+
+        Returns
+        -------
+        emb_vectors: list of tf.Tensor
+                the embedding vectors for each input tensor. The shape of the i-th
+                entry is *inputs[i].get_shape() + emb_vec_sizes[i]*.
+        """
+        emb_vectors = lookup_ops.fused_lookup(
+            values_list=inputs,
+            model_name=self.model_name,
+            table_ids=self.table_ids,
+            emb_vec_sizes=self.emb_vec_sizes,
+            emb_vec_dtype=self.emb_vec_dtype,
+        )
+        for i, emb_vector in enumerate(emb_vectors):
+            output_shape = inputs[i].get_shape() + self.emb_vec_sizes[i]
+            emb_vector.set_shape(output_shape)
+        return emb_vectors
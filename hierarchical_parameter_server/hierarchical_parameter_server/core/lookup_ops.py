@@ -108,3 +108,21 @@ def lookup(
         # init_status=status,
     )
     return vector
+
+
+def fused_lookup(values_list, model_name, table_ids, emb_vec_sizes, emb_vec_dtype):
+    """
+    This function is a wrapper of HPS's fused lookup forward propagation. All tables of
+    the model are queried with a single op execution and a single batched lookup; the
+    table_ids list must mention each table of the model exactly once.
+    """
+    global_replica_id = get_global_replica_id(_get_comm_tool())
+    vectors = hps_lib.fused_lookup(
+        values=values_list,
+        global_replica_id=global_replica_id,
+        model_name=model_name,
+        table_ids=table_ids,
+        emb_vec_sizes=emb_vec_sizes,
+        dtype=emb_vec_dtype,
+    )
+    return vectors
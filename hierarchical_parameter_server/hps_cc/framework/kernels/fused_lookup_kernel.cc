@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2021, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "config.h"
+#include "facade.h"
+#include "tensorflow/core/framework/op_kernel.h"
+
+namespace tensorflow {
+
+using GPUDevice = Eigen::GpuDevice;
+using CPUDevice = Eigen::ThreadPoolDevice;
+
+template <typename Device>
+class FusedLookup : public OpKernel {
+ public:
+  explicit FusedLookup(OpKernelConstruction *ctx) : OpKernel(ctx) {
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("model_name", &model_name_));
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("table_ids", &table_ids_));
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("emb_vec_sizes", &emb_vec_sizes_));
+    OP_REQUIRES(ctx, table_ids_.size() == emb_vec_sizes_.size(),
+                errors::InvalidArgument("table_ids and emb_vec_sizes must have the same length."));
+  }
+
+  void Compute(OpKernelContext *ctx) override {
+    OpInputList values_list;
+    OP_REQUIRES_OK(ctx, ctx->input_list("values", &values_list));
+    OP_REQUIRES(ctx, values_list.size() == static_cast<int>(table_ids_.size()),
+                errors::InvalidArgument("one values tensor per table_id is required."));
+
+    Tensor const *global_replica_id_tensor = nullptr;
+    OP_REQUIRES_OK(ctx, ctx->input("global_replica_id", &global_replica_id_tensor));
+    const int32_t global_replica_id_value = global_replica_id_tensor->scalar<int32_t>()();
+
+    // allocate outputs
+    OpOutputList emb_vector_list;
+    OP_REQUIRES_OK(ctx, ctx->output_list("emb_vector", &emb_vector_list));
+    std::vector<const Tensor *> values_tensors(values_list.size());
+    std::vector<Tensor *> emb_vector_tensors(values_list.size());
+    for (int i = 0; i < values_list.size(); i++) {
+      values_tensors[i] = &values_list[i];
+      TensorShape emb_vector_tensor_shape = values_list[i].shape();
+      emb_vector_tensor_shape.AppendShape({emb_vec_sizes_[i]});
+      OP_REQUIRES_OK(
+          ctx, emb_vector_list.allocate(i, emb_vector_tensor_shape, &emb_vector_tensors[i]));
+    }
+
+    // do forward propagation for all tables with a single batched lookup
+    try {
+      HierarchicalParameterServer::Facade::instance()->forward_fused(
+          model_name_.c_str(), table_ids_, global_replica_id_value, values_tensors,
+          emb_vector_tensors);
+    } catch (std::exception const &error) {
+      ctx->SetStatus(errors::Aborted(error.what()));
+      return;
+    }
+  }
+
+ private:
+  std::string model_name_;
+  std::vector<int32> table_ids_;
+  std::vector<int32> emb_vec_sizes_;
+};
+
+REGISTER_KERNEL_BUILDER(Name("FusedLookup").Device(DEVICE_GPU).HostMemory("global_replica_id"),
+                        FusedLookup<GPUDevice>);
+
+}  // namespace tensorflow
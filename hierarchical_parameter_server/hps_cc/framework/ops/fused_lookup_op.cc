@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2021, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "config.h"
+#include "tensorflow/core/framework/common_shape_fns.h"
+#include "tensorflow/core/framework/op.h"
+#include "tensorflow/core/framework/shape_inference.h"
+
+using namespace tensorflow;
+using namespace tensorflow::shape_inference;
+
+// Variadic counterpart of Lookup: one op execution queries every table of a model through a
+// single batched LookupSession call, instead of one op (and one session call) per table.
+// table_ids must mention each table of the model exactly once; emb_vec_sizes is aligned with
+// table_ids and determines the trailing dimension of the corresponding output.
+REGISTER_OP("FusedLookup")
+    .Input("values: num_tables * value_dtype")
+    .Input("global_replica_id: int32")
+    .Output("emb_vector: num_tables * dtype")
+    .Attr("num_tables: int >= 1")
+    .Attr("value_dtype: {int64,int32,uint64,uint32}")
+    .Attr("model_name: string")
+    .Attr("table_ids: list(int)")
+    .Attr("emb_vec_sizes: list(int)")
+    .Attr("dtype: {float32}")
+    .SetShapeFn([](InferenceContext* ctx) {
+      int num_tables;
+      TF_RETURN_IF_ERROR(ctx->GetAttr("num_tables", &num_tables));
+      std::vector<int32> emb_vec_sizes;
+      TF_RETURN_IF_ERROR(ctx->GetAttr("emb_vec_sizes", &emb_vec_sizes));
+      if (static_cast<int>(emb_vec_sizes.size()) != num_tables) {
+        return errors::InvalidArgument("emb_vec_sizes must hold one entry per table.");
+      }
+
+      ShapeHandle replica_id_shape = ctx->input(num_tables);
+      DimensionHandle replica_id_num_elem = ctx->NumElements(replica_id_shape);
+      if (1 != ctx->Value(replica_id_num_elem)) {
+        return errors::InvalidArgument("global_replica_id must be a scalar.");
+      }
+
+      for (int i = 0; i < num_tables; i++) {
+        ShapeHandle output_shape;
+        TF_RETURN_IF_ERROR(
+            ctx->Concatenate(ctx->input(i), ctx->Vector(emb_vec_sizes[i]), &output_shape));
+        ctx->set_output(i, output_shape);
+      }
+      return Status::OK();
+    });
@@ -47,6 +47,15 @@ class Facade final {
             const int32_t num_replicas_in_sync);
   void forward(const char* model_name, const int32_t table_id, const int32_t global_replica_id,
                const tensorflow::Tensor* values_tensor, tensorflow::Tensor* emb_vector_tensor);
+  /**
+   * Fused variant of forward: queries every table of the model through one batched
+   * LookupSession call. table_ids must mention each table exactly once; the tensor vectors are
+   * aligned with table_ids.
+   */
+  void forward_fused(const char* model_name, const std::vector<tensorflow::int32>& table_ids,
+                     const int32_t global_replica_id,
+                     const std::vector<const tensorflow::Tensor*>& values_tensors,
+                     const std::vector<tensorflow::Tensor*>& emb_vector_tensors);
   void report_avg();
   std::shared_ptr<coll_cache_lib::common::Profiler> profiler_;
   std::vector<size_t> current_steps_for_each_replica_;
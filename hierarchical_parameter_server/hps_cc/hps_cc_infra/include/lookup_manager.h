@@ -35,6 +35,17 @@ class LookupManager final {
   void forward(const std::string& model_name, const int32_t table_id,
                const int32_t global_replica_id, const size_t num_keys, const size_t emb_vec_size,
                const void* values_ptr, void* emb_vector_ptr);
+  /**
+   * Queries all tables of the model with one batched LookupSession call (one lookup stream per
+   * table, a single synchronization). table_ids must mention each table exactly once and the
+   * remaining vectors are aligned with it.
+   */
+  void forward_fused(const std::string& model_name, const std::vector<int32_t>& table_ids,
+                     const int32_t global_replica_id,
+                     const std::vector<size_t>& num_keys_per_table,
+                     const std::vector<size_t>& emb_vec_size_per_table,
+                     const std::vector<const void*>& values_ptrs,
+                     const std::vector<float*>& emb_vector_ptrs);
 
  private:
   LookupManager();
@@ -68,6 +68,31 @@ void Facade::forward(const char* model_name, int32_t table_id, int32_t global_re
   this->set_step_profile_value(global_replica_id, coll_cache_lib::common::kLogL2CacheCopyTime, t.Passed());
 }
 
+void Facade::forward_fused(const char* model_name,
+                           const std::vector<tensorflow::int32>& table_ids,
+                           int32_t global_replica_id,
+                           const std::vector<const tensorflow::Tensor*>& values_tensors,
+                           const std::vector<tensorflow::Tensor*>& emb_vector_tensors) {
+  std::vector<int32_t> ids(table_ids.begin(), table_ids.end());
+  std::vector<size_t> num_keys_per_table(values_tensors.size());
+  std::vector<size_t> emb_vec_size_per_table(values_tensors.size());
+  std::vector<const void*> values_ptrs(values_tensors.size());
+  std::vector<float*> emb_vector_ptrs(values_tensors.size());
+  for (size_t i = 0; i < values_tensors.size(); i++) {
+    num_keys_per_table[i] = static_cast<size_t>(values_tensors[i]->NumElements());
+    emb_vec_size_per_table[i] =
+        static_cast<size_t>(emb_vector_tensors[i]->shape().dim_sizes().back());
+    values_ptrs[i] = values_tensors[i]->data();
+    emb_vector_ptrs[i] = reinterpret_cast<float*>(emb_vector_tensors[i]->data());
+  }
+  coll_cache_lib::common::Timer t;
+  lookup_manager_->forward_fused(std::string(model_name), ids, global_replica_id,
+                                 num_keys_per_table, emb_vec_size_per_table, values_ptrs,
+                                 emb_vector_ptrs);
+  this->set_step_profile_value(global_replica_id, coll_cache_lib::common::kLogL2CacheCopyTime,
+                               t.Passed());
+}
+
 void Facade::report_avg() {
   this->profiler_->ReportStepAverage(
       coll_cache_lib::common::RunConfig::num_epoch - 1,
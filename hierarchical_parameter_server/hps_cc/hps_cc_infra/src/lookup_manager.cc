@@ -125,4 +125,66 @@ void LookupManager::forward(const std::string& model_name, int32_t table_id,
                          reinterpret_cast<float*>(emb_vector_ptr), num_keys, table_id);
 }
 
+void LookupManager::forward_fused(const std::string& model_name,
+                                  const std::vector<int32_t>& table_ids,
+                                  int32_t global_replica_id,
+                                  const std::vector<size_t>& num_keys_per_table,
+                                  const std::vector<size_t>& emb_vec_size_per_table,
+                                  const std::vector<const void*>& values_ptrs,
+                                  const std::vector<float*>& emb_vector_ptrs) {
+  HCTR_CHECK_HINT(initialized_,
+                  "hierarchical_parameter_server.Init must be called before execution");
+  HCTR_CHECK_HINT(lookup_session_map_.find(model_name) != lookup_session_map_.end(),
+                  "Cannot find the model with the name %s in HPS", model_name.c_str());
+
+  auto lookup_session =
+      lookup_session_map_.find(model_name)->second.find(global_replica_id)->second;
+  auto inference_params = lookup_session->get_inference_params();
+  size_t num_tables = inference_params.sparse_model_files.size();
+
+  // The batched session lookup dispatches all tables at once (one stream each), so the fused
+  // path requires the inputs to cover every table of the model exactly once.
+  HCTR_CHECK_HINT(table_ids.size() == num_tables,
+                  "fused lookup for %s requires one values tensor per table (%lu), got: %lu",
+                  model_name.c_str(), num_tables, table_ids.size());
+
+  auto& h_values_per_table = h_values_map_.find(model_name)->second.find(global_replica_id)->second;
+  size_t per_key_size = inference_params.i64_input_key ? 8 : 4;
+  std::vector<const void*> h_keys_per_table(num_tables, nullptr);
+  std::vector<float*> d_vectors_per_table(num_tables, nullptr);
+  std::vector<size_t> reordered_num_keys(num_tables, 0);
+  for (size_t i = 0; i < table_ids.size(); i++) {
+    const int32_t table_id = table_ids[i];
+    HCTR_CHECK_HINT(table_id >= 0 && table_id < num_tables,
+                    "table_id for %s should be from 0 to %lu, got: %d", model_name.c_str(),
+                    num_tables - 1, table_id);
+    HCTR_CHECK_HINT(h_keys_per_table[table_id] == nullptr,
+                    "fused lookup for %s mentions table_id %d more than once", model_name.c_str(),
+                    table_id);
+    HCTR_CHECK_HINT(
+        num_keys_per_table[i] <=
+            inference_params.max_batchsize *
+                inference_params.maxnum_catfeature_query_per_table_per_sample[table_id],
+        "num_keys must be <= inference_params.max_batchsize * "
+        "inference_params.maxnum_catfeature_query_per_table_per_sample[table_id], but %lu > %lu * "
+        "%lu",
+        num_keys_per_table[i], inference_params.max_batchsize,
+        inference_params.maxnum_catfeature_query_per_table_per_sample[table_id]);
+    HCTR_CHECK_HINT(
+        emb_vec_size_per_table[i] == inference_params.embedding_vecsize_per_table[table_id],
+        "emb_vec_size must be equal to "
+        "inference_params.embedding_vecsize_per_table[table_id], but %lu != %lu",
+        emb_vec_size_per_table[i], inference_params.embedding_vecsize_per_table[table_id]);
+
+    void* h_values = h_values_per_table[table_id].get();
+    cudaMemcpy(h_values, values_ptrs[i], num_keys_per_table[i] * per_key_size,
+               cudaMemcpyDeviceToHost);
+    h_keys_per_table[table_id] = h_values;
+    d_vectors_per_table[table_id] = emb_vector_ptrs[i];
+    reordered_num_keys[table_id] = num_keys_per_table[i];
+  }
+
+  lookup_session->lookup(h_keys_per_table, d_vectors_per_table, reordered_num_keys);
+}
+
 }  // namespace HierarchicalParameterServer
\ No newline at end of file
@@ -27,6 +27,7 @@ def convert(
     sparse_models=None,
     ntp_file=None,
     graph_name="hugectr",
+    keep_fused_ops=False,
 ):
     """Convert a HugeCTR model to an ONNX model
     Args:
@@ -37,9 +38,12 @@ def convert(
         sparse_models: the files of the sparse embeddings for the HugeCTR model (optional)
         ntp_file: the file of the non-trainable parameters for the HugeCTR model (optional)
         graph_name: the graph name for the ONNX model (optional)
+        keep_fused_ops: export fused HugeCTR layers as com.nvidia.hugectr custom ops instead
+            of decomposed ONNX primitives; requires the HugeCTR TensorRT plugin library at
+            deployment time (optional)
     """
     loader = HugeCTRLoader(graph_config, dense_model, convert_embedding, sparse_models, ntp_file)
-    builder = GraphBuilder(convert_embedding)
+    builder = GraphBuilder(convert_embedding, keep_fused_ops)
     for _ in range(loader.layers):
         layer_params, weights_dict, dimensions = loader.load_layer()
         print(f"[HUGECTR2ONNX][INFO]: Converting {layer_params.layer_type} layer to ONNX")
@@ -67,6 +71,11 @@ if __name__ == "__main__":
     parser.add_argument(
         "--graph_name", type=str, default="hugectr", help="Graph name for the ONNX model (optional)"
     )
+    parser.add_argument(
+        "--keep_fused_ops",
+        action="store_true",
+        help="Export fused HugeCTR layers as custom ops for the TensorRT plugin library (optional)",
+    )
     args = parser.parse_args()
     print(args)
     convert(
@@ -77,4 +86,5 @@ if __name__ == "__main__":
         args.sparse_models,
         args.ntp_file,
         args.graph_name,
+        args.keep_fused_ops,
     )
@@ -20,12 +20,23 @@ import onnx
 
 
 class GraphBuilder(object):
-    def __init__(self, convert_embedding):
+    # Custom op domain for fused HugeCTR layers kept as single nodes (keep_fused_ops). The
+    # deployed runtime must provide kernels for this domain, e.g. the HugeCTR TensorRT
+    # plugin library.
+    CUSTOM_OP_DOMAIN = "com.nvidia.hugectr"
+
+    def __init__(self, convert_embedding, keep_fused_ops=False):
         """Create GraphBuilder
         Args:
             convert_embedding: boolean, whether converting sparse embedding models to ONNX
+            keep_fused_ops: boolean, export fused HugeCTR layers (FusedInnerProduct,
+                FusedReshapeConcat) as single custom ops in the com.nvidia.hugectr domain
+                instead of decomposing them into ONNX primitives. The resulting model needs
+                the matching TensorRT plugin library at deployment time.
         """
         self.__convert_embeddding = convert_embedding
+        self.__keep_fused_ops = keep_fused_ops
+        self.__uses_custom_ops = False
         self.__nodes = []
         self.__initializers = []
         self.__inputs = []
@@ -475,16 +486,46 @@ class GraphBuilder(object):
                     vals=bias.flatten(),
                 )
             )
+            if self.__keep_fused_ops:
+                # Single custom node mirroring fused_relu_bias_fully_connected_layer, so the
+                # deployed engine keeps the fused GEMM+bias+ReLU kernel instead of relying on
+                # the backend to re-fuse the decomposed Gemm/Relu pair.
+                self.__uses_custom_ops = True
+                self.__nodes.append(
+                    helper.make_node(
+                        op_type="FusedGemmRelu",
+                        inputs=[layer_params.bottom_names[0], weight_name, bias_name],
+                        outputs=layer_params.top_names,
+                        domain=self.CUSTOM_OP_DOMAIN,
+                    )
+                )
+            else:
+                self.__nodes.append(
+                    helper.make_node(
+                        op_type="Gemm",
+                        inputs=[layer_params.bottom_names[0], weight_name, bias_name],
+                        outputs=[gemm_name],
+                    )
+                )
+                self.__nodes.append(
+                    helper.make_node(
+                        op_type="Relu", inputs=[gemm_name], outputs=layer_params.top_names
+                    )
+                )
+        elif layer_type == "FusedReshapeConcat" and self.__keep_fused_ops:
+            # Single custom node mirroring fused_reshape_concat_layer: the plugin splits each
+            # input into item/ad parts and emits the two concatenated 2D outputs in one pass.
+            self.__uses_custom_ops = True
+            slot_num = dimensions[layer_params.bottom_names[0]][0]
             self.__nodes.append(
                 helper.make_node(
-                    op_type="Gemm",
-                    inputs=[layer_params.bottom_names[0], weight_name, bias_name],
-                    outputs=[gemm_name],
+                    op_type="FusedReshapeConcat",
+                    inputs=layer_params.bottom_names,
+                    outputs=layer_params.top_names,
+                    domain=self.CUSTOM_OP_DOMAIN,
+                    slot_num=slot_num,
                 )
             )
-            self.__nodes.append(
-                helper.make_node(op_type="Relu", inputs=[gemm_name], outputs=layer_params.top_names)
-            )
         elif layer_type == "FusedReshapeConcat":
             slot_num = dimensions[layer_params.bottom_names[0]][0]
             output_fea_num = 0
@@ -1275,6 +1316,14 @@ class GraphBuilder(object):
         model_def = helper.make_model(self.__graph_def)
         model_def.opset_import[0].version = op_version
         model_def.ir_version = ir_version
+        if self.__uses_custom_ops:
+            custom_opset = model_def.opset_import.add()
+            custom_opset.domain = self.CUSTOM_OP_DOMAIN
+            custom_opset.version = 1
+            print(
+                "[HUGECTR2ONNX][INFO]: The model contains {} custom ops; deploy it with the "
+                "HugeCTR TensorRT plugin library".format(self.CUSTOM_OP_DOMAIN)
+            )
         onnx.checker.check_model(model_def)
         print("[HUGECTR2ONNX][INFO]: The model is checked!")
         onnx.save(model_def, model_path)
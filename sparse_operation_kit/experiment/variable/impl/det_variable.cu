@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <random>
 
 #include "common/check.h"
@@ -125,24 +126,43 @@ int64_t DETVariable<KeyType, ValueType>::cols() {
 template <typename KeyType, typename ValueType>
 void DETVariable<KeyType, ValueType>::eXport(KeyType* keys, ValueType* values,
                                              cudaStream_t stream) {
-  size_t num_keys = rows();
   size_t dim = cols();
 
-  // `keys` and `values` are pointers of host memory
+  // `keys` and `values` are pointers of host memory. Stage through device memory one submap at
+  // a time so the transient allocation is bounded by the largest submap (one extent when the
+  // table grows in fixed-size extents) instead of duplicating the whole table.
+  size_t num_submaps = map_->get_num_submaps();
+  size_t max_submap_size = 0;
+  for (size_t i = 0; i < num_submaps; ++i) {
+    max_submap_size = std::max(max_submap_size, map_->get_submap_size(i));
+  }
+  if (max_submap_size == 0) {
+    return;
+  }
+
   KeyType* d_keys;
-  CUDACHECK(cudaMalloc(&d_keys, sizeof(KeyType) * num_keys));
+  CUDACHECK(cudaMalloc(&d_keys, sizeof(KeyType) * max_submap_size));
   ValueType* d_values;
-  CUDACHECK(cudaMalloc(&d_values, sizeof(ValueType) * num_keys * dim));
+  CUDACHECK(cudaMalloc(&d_values, sizeof(ValueType) * max_submap_size * dim));
 
-  map_->eXport(d_keys, d_values, num_keys, stream);
-
-  // clang-format off
-  CUDACHECK(cudaMemcpyAsync(keys, d_keys, sizeof(KeyType) * num_keys,
-                            cudaMemcpyDeviceToHost, stream));
-  CUDACHECK(cudaMemcpyAsync(values, d_values, sizeof(ValueType) * num_keys * dim,
-                            cudaMemcpyDeviceToHost, stream));
-  // clang-format on
-  CUDACHECK(cudaStreamSynchronize(stream));
+  size_t offset = 0;
+  for (size_t i = 0; i < num_submaps; ++i) {
+    size_t n = map_->get_submap_size(i);
+    if (n == 0) {
+      continue;
+    }
+    map_->eXport_submap(i, d_keys, d_values, n, stream);
+
+    // clang-format off
+    CUDACHECK(cudaMemcpyAsync(keys + offset, d_keys, sizeof(KeyType) * n,
+                              cudaMemcpyDeviceToHost, stream));
+    CUDACHECK(cudaMemcpyAsync(values + offset * dim, d_values, sizeof(ValueType) * n * dim,
+                              cudaMemcpyDeviceToHost, stream));
+    // clang-format on
+    // The staging buffers are reused for the next submap.
+    CUDACHECK(cudaStreamSynchronize(stream));
+    offset += n;
+  }
   CUDACHECK(cudaFree(d_keys));
   CUDACHECK(cudaFree(d_values));
 }
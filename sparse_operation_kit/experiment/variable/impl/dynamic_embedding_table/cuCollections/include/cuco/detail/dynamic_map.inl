@@ -24,7 +24,11 @@ dynamic_map<Key, Element, Initializer>::dynamic_map(uint32_t dimension, size_t i
       dimension_(dimension),
       initial_capacity_(initial_capacity),
       capacity_(initial_capacity),
-      initializer_(initializer) {}
+      initializer_(initializer) {
+  if (const char *env = std::getenv("SOK_DET_EXTENT_SIZE")) {
+    extent_size_ = std::strtoull(env, nullptr, 10);
+  }
+}
 
 template <typename Key, typename Element, typename Initializer>
 void dynamic_map<Key, Element, Initializer>::initialize(cudaStream_t stream) {
@@ -71,7 +75,10 @@ void dynamic_map<Key, Element, Initializer>::reserve(size_t n, cudaStream_t stre
     }
     // if the submap does not exist yet, create it
     else {
-      submap_capacity = capacity_;
+      // With a fixed extent size, every submap after the first is one extent so that a growth
+      // step allocates O(extent) memory; otherwise each new submap doubles the total capacity.
+      submap_capacity =
+          (extent_size_ > 0 && !submaps_.empty()) ? extent_size_ : capacity_;
       auto submap = std::make_unique<static_map<key_type, element_type, Initializer>>(
           dimension_, submap_capacity, occupied_size_per_submap_ + submap_idx,
           reclaimed_size_per_submap_ + submap_idx, h_occupied_size_per_submap_ + submap_idx,
@@ -81,7 +88,7 @@ void dynamic_map<Key, Element, Initializer>::reserve(size_t n, cudaStream_t stre
       submap_mutable_views_.push_back(submap->get_device_mutable_view());
       submaps_.push_back(std::move(submap));
 
-      capacity_ *= 2;
+      capacity_ += submap_capacity;
     }
 
     num_elements_remaining -= max_load_factor_ * submap_capacity - min_insert_size_;
@@ -246,4 +253,20 @@ void dynamic_map<Key, Element, Initializer>::eXport(key_type *keys, element_type
   // CUCO_CUDA_TRY(cudaStreamSynchronize(stream));
 }
 
+template <typename Key, typename Element, typename Initializer>
+void dynamic_map<Key, Element, Initializer>::eXport_submap(size_t submap_idx, key_type *keys,
+                                                           element_type *values, size_t num_keys,
+                                                           cudaStream_t stream) {
+  auto const block_size = 128;
+  auto const stride = 1;
+  auto const tile_size = 4;
+  auto const grid_size = (tile_size * num_keys + stride * block_size - 1) / (stride * block_size);
+
+  h_num_successes_[0] = 0;
+  CUCO_ASSERT_CUDA_SUCCESS(cudaMemcpyAsync(
+      num_successes_, h_num_successes_, sizeof(atomic_ctr_type), cudaMemcpyHostToDevice, stream));
+  detail::eXport<tile_size><<<grid_size, block_size, 0, stream>>>(
+      keys, values, num_keys, num_successes_, submap_views_.data().get() + submap_idx, 1);
+}
+
 }  // namespace cuco
@@ -18,6 +18,7 @@
 
 #include <thrust/device_vector.h>
 
+#include <cstdlib>
 #include <cuco/detail/dynamic_map_kernels.cuh>
 #include <cuco/detail/error.hpp>
 #include <cuco/static_map.cuh>
@@ -128,6 +129,13 @@ class dynamic_map {
 
   void eXport(key_type *keys, element_type *values, size_t num_keys, cudaStream_t stream = 0);
 
+  /**
+   * @brief Exports the entries of a single submap, so that callers can bound
+   * their staging memory by the largest submap instead of the whole table.
+   */
+  void eXport_submap(size_t submap_idx, key_type *keys, element_type *values, size_t num_keys,
+                     cudaStream_t stream = 0);
+
   /**
    * @brief Gets the current number of elements in the map
    *
@@ -156,6 +164,12 @@ class dynamic_map {
    */
   size_t get_capacity() const noexcept { return capacity_ - initial_capacity_; }
 
+  size_t get_num_submaps() const noexcept { return submaps_.size(); }
+
+  size_t get_submap_size(size_t submap_idx) const noexcept {
+    return submaps_[submap_idx]->get_size();
+  }
+
  private:
   static constexpr size_t max_num_submaps = 128;
   const float max_load_factor_{};   ///< Max load factor before capacity growth
@@ -165,6 +179,12 @@ class dynamic_map {
 
   size_t capacity_{};  ///< Maximum number of keys that can be inserted
 
+  ///< Fixed capacity of submaps created after the first one. When 0 (the default) each new
+  ///< submap doubles the total capacity; a non-zero value (SOK_DET_EXTENT_SIZE) makes every
+  ///< growth step allocate exactly one extent of this many entries, trading a longer submap
+  ///< probe chain for O(extent) instead of O(table) allocation spikes during online training.
+  size_t extent_size_{};
+
   std::vector<std::unique_ptr<static_map<key_type, element_type, Initializer>>>
       submaps_;                                    ///< vector of pointers to each submap
   thrust::device_vector<view_type> submap_views_;  ///< vector of device views for each submap
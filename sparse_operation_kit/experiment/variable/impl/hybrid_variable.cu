@@ -0,0 +1,342 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+
+#include "common/check.h"
+#include "variable/impl/hybrid_variable.h"
+
+namespace sok {
+
+namespace {
+
+constexpr int kSetAssociativity = 8;
+
+// Scatters the fetched miss rows into the query output at the positions reported by Query.
+template <typename ValueType>
+__global__ void scatter_missing_kernel(const ValueType* staging_values,
+                                       const uint64_t* missing_index, size_t missing_len,
+                                       size_t dimension, ValueType* values) {
+  const size_t len = missing_len * dimension;
+  for (size_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < len;
+       idx += blockDim.x * gridDim.x) {
+    const size_t i = idx / dimension;
+    const size_t j = idx % dimension;
+    values[missing_index[i] * dimension + j] = staging_values[idx];
+  }
+}
+
+void parse_initializer(const std::string& initializer, bool& is_const, float& val) {
+  if (initializer == "random" || initializer == "") {
+    is_const = false;
+    return;
+  }
+
+  is_const = true;
+  if (initializer == "ones") {
+    val = 1.0;
+  } else if (initializer == "zeros") {
+    val = 0.0;
+  } else {
+    try {
+      val = std::stof(initializer);
+    } catch (std::invalid_argument& err) {
+      throw std::runtime_error("Unrecognized initializer {" + initializer + "}");
+    }
+  }
+}
+
+}  // namespace
+
+template <typename KeyType, typename ValueType>
+HybridVariable<KeyType, ValueType>::HybridVariable(int64_t rows, size_t dimension,
+                                                   const std::string& initializer,
+                                                   cudaStream_t stream)
+    : dimension_(dimension), initializer_(initializer), generator_(std::random_device{}()) {
+  if (dimension_ <= 0) {
+    throw std::invalid_argument("dimension must > 0 but got " + std::to_string(dimension));
+  }
+
+  parse_initializer(initializer_, use_const_initializer_, initial_val_);
+
+  size_t cache_rows = (rows > 0) ? static_cast<size_t>(rows) / 10 + 1 : (1 << 22);
+  if (const char* env = std::getenv("SOK_HYBRID_CACHE_ROWS")) {
+    cache_rows = std::stoull(env);
+  }
+  const size_t slot_rows = kSetAssociativity * SLAB_SIZE;
+  const size_t capacity_in_set = (cache_rows + slot_rows - 1) / slot_rows;
+  cache_ = gpu_cache::create_gpu_cache<CacheKeyType, uint64_t,
+                                       std::numeric_limits<CacheKeyType>::max(), SLAB_SIZE>(
+      kSetAssociativity, capacity_in_set, dimension_);
+  if (!cache_) {
+    throw std::runtime_error("Create gpu_cache for hybrid variable failed");
+  }
+}
+
+template <typename KeyType, typename ValueType>
+HybridVariable<KeyType, ValueType>::~HybridVariable() {
+  for (ValueType* block : blocks_) {
+    cudaFreeHost(block);
+  }
+  if (staging_capacity_ > 0) {
+    cudaFree(d_missing_keys_);
+    cudaFree(d_missing_index_);
+    cudaFree(d_staging_values_);
+    cudaFreeHost(h_missing_keys_);
+    cudaFreeHost(h_missing_index_);
+    cudaFreeHost(h_staging_values_);
+  }
+  if (d_missing_len_) {
+    cudaFree(d_missing_len_);
+    cudaFreeHost(h_missing_len_);
+  }
+}
+
+template <typename KeyType, typename ValueType>
+int64_t HybridVariable<KeyType, ValueType>::rows() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return static_cast<int64_t>(index_.size());
+}
+
+template <typename KeyType, typename ValueType>
+int64_t HybridVariable<KeyType, ValueType>::cols() {
+  return static_cast<int64_t>(dimension_);
+}
+
+template <typename KeyType, typename ValueType>
+size_t HybridVariable<KeyType, ValueType>::get_or_create_row_(KeyType key) {
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    return it->second;
+  }
+
+  const size_t row_index = index_.size();
+  if (row_index / block_rows_ == blocks_.size()) {
+    ValueType* block;
+    CUDACHECK(cudaMallocHost(&block, sizeof(ValueType) * block_rows_ * dimension_));
+    blocks_.push_back(block);
+  }
+  index_.emplace(key, row_index);
+
+  ValueType* row = host_row_(row_index);
+  if (use_const_initializer_) {
+    for (size_t j = 0; j < dimension_; j++) {
+      row[j] = initial_val_;
+    }
+  } else {
+    std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+    for (size_t j = 0; j < dimension_; j++) {
+      row[j] = uniform(generator_);
+    }
+  }
+  return row_index;
+}
+
+template <typename KeyType, typename ValueType>
+ValueType* HybridVariable<KeyType, ValueType>::host_row_(size_t row_index) {
+  return blocks_[row_index / block_rows_] + (row_index % block_rows_) * dimension_;
+}
+
+template <typename KeyType, typename ValueType>
+void HybridVariable<KeyType, ValueType>::reserve_staging_(size_t num_keys) {
+  if (!d_missing_len_) {
+    CUDACHECK(cudaMalloc(&d_missing_len_, sizeof(size_t)));
+    CUDACHECK(cudaMallocHost(&h_missing_len_, sizeof(size_t)));
+  }
+  if (num_keys <= staging_capacity_) {
+    return;
+  }
+  if (staging_capacity_ > 0) {
+    CUDACHECK(cudaFree(d_missing_keys_));
+    CUDACHECK(cudaFree(d_missing_index_));
+    CUDACHECK(cudaFree(d_staging_values_));
+    CUDACHECK(cudaFreeHost(h_missing_keys_));
+    CUDACHECK(cudaFreeHost(h_missing_index_));
+    CUDACHECK(cudaFreeHost(h_staging_values_));
+  }
+  CUDACHECK(cudaMalloc(&d_missing_keys_, sizeof(CacheKeyType) * num_keys));
+  CUDACHECK(cudaMalloc(&d_missing_index_, sizeof(uint64_t) * num_keys));
+  CUDACHECK(cudaMalloc(&d_staging_values_, sizeof(ValueType) * num_keys * dimension_));
+  CUDACHECK(cudaMallocHost(&h_missing_keys_, sizeof(CacheKeyType) * num_keys));
+  CUDACHECK(cudaMallocHost(&h_missing_index_, sizeof(uint64_t) * num_keys));
+  CUDACHECK(cudaMallocHost(&h_staging_values_, sizeof(ValueType) * num_keys * dimension_));
+  staging_capacity_ = num_keys;
+}
+
+template <typename KeyType, typename ValueType>
+void HybridVariable<KeyType, ValueType>::update_cache_(const KeyType* keys,
+                                                       const CacheKeyType* d_keys, size_t num_keys,
+                                                       cudaStream_t stream) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < num_keys; i++) {
+      const size_t row_index = get_or_create_row_(keys[i]);
+      memcpy(h_staging_values_ + i * dimension_, host_row_(row_index),
+             sizeof(ValueType) * dimension_);
+    }
+  }
+  CUDACHECK(cudaMemcpyAsync(d_staging_values_, h_staging_values_,
+                            sizeof(ValueType) * num_keys * dimension_, cudaMemcpyHostToDevice,
+                            stream));
+  cache_->Update(d_keys, num_keys, d_staging_values_, stream);
+  CUDACHECK(cudaStreamSynchronize(stream));
+}
+
+template <typename KeyType, typename ValueType>
+void HybridVariable<KeyType, ValueType>::eXport(KeyType* keys, ValueType* values,
+                                                cudaStream_t stream) {
+  // The host store is authoritative (write-through cache), so no device traffic is needed.
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t i = 0;
+  for (const auto& pair : index_) {
+    keys[i] = pair.first;
+    memcpy(values + i * dimension_, host_row_(pair.second), sizeof(ValueType) * dimension_);
+    i++;
+  }
+}
+
+template <typename KeyType, typename ValueType>
+void HybridVariable<KeyType, ValueType>::assign(const KeyType* keys, const ValueType* values,
+                                                size_t num_keys, cudaStream_t stream) {
+  // `keys` and `values` are pointers of host memory
+  reserve_staging_(num_keys);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < num_keys; i++) {
+      const size_t row_index = get_or_create_row_(keys[i]);
+      memcpy(host_row_(row_index), values + i * dimension_, sizeof(ValueType) * dimension_);
+    }
+  }
+  for (size_t i = 0; i < num_keys; i++) {
+    h_missing_keys_[i] = static_cast<CacheKeyType>(keys[i]);
+  }
+  CUDACHECK(cudaMemcpyAsync(d_missing_keys_, h_missing_keys_, sizeof(CacheKeyType) * num_keys,
+                            cudaMemcpyHostToDevice, stream));
+  update_cache_(keys, d_missing_keys_, num_keys, stream);
+}
+
+template <typename KeyType, typename ValueType>
+void HybridVariable<KeyType, ValueType>::lookup(const KeyType* keys, ValueType* values,
+                                                size_t num_keys, cudaStream_t stream) {
+  if (num_keys == 0) {
+    return;
+  }
+  reserve_staging_(num_keys);
+
+  cache_->Query(reinterpret_cast<const CacheKeyType*>(keys), num_keys, values, d_missing_index_,
+                d_missing_keys_, d_missing_len_, stream);
+  CUDACHECK(cudaMemcpyAsync(h_missing_len_, d_missing_len_, sizeof(size_t),
+                            cudaMemcpyDeviceToHost, stream));
+  CUDACHECK(cudaStreamSynchronize(stream));
+
+  const size_t missing_len = *h_missing_len_;
+  if (missing_len == 0) {
+    return;
+  }
+
+  // Fetch the missing rows from the host store and patch them into the output.
+  CUDACHECK(cudaMemcpyAsync(h_missing_keys_, d_missing_keys_, sizeof(CacheKeyType) * missing_len,
+                            cudaMemcpyDeviceToHost, stream));
+  CUDACHECK(cudaStreamSynchronize(stream));
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < missing_len; i++) {
+      const size_t row_index = get_or_create_row_(static_cast<KeyType>(h_missing_keys_[i]));
+      memcpy(h_staging_values_ + i * dimension_, host_row_(row_index),
+             sizeof(ValueType) * dimension_);
+    }
+  }
+  CUDACHECK(cudaMemcpyAsync(d_staging_values_, h_staging_values_,
+                            sizeof(ValueType) * missing_len * dimension_, cudaMemcpyHostToDevice,
+                            stream));
+  constexpr int block_dim = 256;
+  const int grid_dim =
+      static_cast<int>((missing_len * dimension_ + block_dim - 1) / block_dim);
+  scatter_missing_kernel<<<grid_dim, block_dim, 0, stream>>>(d_staging_values_, d_missing_index_,
+                                                             missing_len, dimension_, values);
+
+  // Make the fetched rows resident for the next iterations.
+  cache_->Replace(d_missing_keys_, missing_len, d_staging_values_, stream);
+  CUDACHECK(cudaStreamSynchronize(stream));
+}
+
+template <typename KeyType, typename ValueType>
+void HybridVariable<KeyType, ValueType>::lookup(const KeyType* keys, ValueType** values,
+                                                size_t num_keys, cudaStream_t stream) {
+  // The rows live in host memory, so handing out device-dereferenceable row pointers is not
+  // possible; every consumer in the lookup path uses the dense overload.
+  throw std::runtime_error("Pointer lookup is not supported by hybrid variables");
+}
+
+template <typename KeyType, typename ValueType>
+void HybridVariable<KeyType, ValueType>::scatter_add(const KeyType* keys, const ValueType* values,
+                                                     size_t num_keys, cudaStream_t stream) {
+  if (num_keys == 0) {
+    return;
+  }
+  // `keys` and `values` are pointers of device memory
+  reserve_staging_(num_keys);
+  CUDACHECK(cudaMemcpyAsync(h_missing_keys_, keys, sizeof(KeyType) * num_keys,
+                            cudaMemcpyDeviceToHost, stream));
+  CUDACHECK(cudaMemcpyAsync(h_staging_values_, values, sizeof(ValueType) * num_keys * dimension_,
+                            cudaMemcpyDeviceToHost, stream));
+  CUDACHECK(cudaStreamSynchronize(stream));
+
+  const KeyType* h_keys = reinterpret_cast<const KeyType*>(h_missing_keys_);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < num_keys; i++) {
+      ValueType* row = host_row_(get_or_create_row_(h_keys[i]));
+      for (size_t j = 0; j < dimension_; j++) {
+        row[j] += h_staging_values_[i * dimension_ + j];
+      }
+    }
+  }
+  update_cache_(h_keys, reinterpret_cast<const CacheKeyType*>(keys), num_keys, stream);
+}
+
+template <typename KeyType, typename ValueType>
+void HybridVariable<KeyType, ValueType>::scatter_update(const KeyType* keys,
+                                                        const ValueType* values, size_t num_keys,
+                                                        cudaStream_t stream) {
+  if (num_keys == 0) {
+    return;
+  }
+  // `keys` and `values` are pointers of device memory
+  reserve_staging_(num_keys);
+  CUDACHECK(cudaMemcpyAsync(h_missing_keys_, keys, sizeof(KeyType) * num_keys,
+                            cudaMemcpyDeviceToHost, stream));
+  CUDACHECK(cudaMemcpyAsync(h_staging_values_, values, sizeof(ValueType) * num_keys * dimension_,
+                            cudaMemcpyDeviceToHost, stream));
+  CUDACHECK(cudaStreamSynchronize(stream));
+
+  const KeyType* h_keys = reinterpret_cast<const KeyType*>(h_missing_keys_);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < num_keys; i++) {
+      memcpy(host_row_(get_or_create_row_(h_keys[i])), h_staging_values_ + i * dimension_,
+             sizeof(ValueType) * dimension_);
+    }
+  }
+  update_cache_(h_keys, reinterpret_cast<const CacheKeyType*>(keys), num_keys, stream);
+}
+
+template class HybridVariable<int32_t, float>;
+template class HybridVariable<int64_t, float>;
+
+}  // namespace sok
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HYBRID_VARIABLE_H
+#define HYBRID_VARIABLE_H
+
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "gpu_cache/include/nv_gpu_cache.hpp"
+#include "variable/impl/variable_base.h"
+
+namespace sok {
+
+/**
+ * Variable whose full table lives in pinned host memory, fronted by an nv_gpu_cache instance
+ * on the device. Selected with type="hybrid" and intended for tables that do not fit in GPU
+ * memory: lookups are served from the cache and only the missing rows cross PCIe. The host
+ * store is always authoritative; every mutation is applied to the host rows first and then
+ * pushed to the cache with Update (which only touches keys that are resident), so cached rows
+ * never go stale.
+ *
+ * The cache capacity in rows defaults to 1/10 of the `rows` hint handed to the factory and can
+ * be overridden with the SOK_HYBRID_CACHE_ROWS environment variable. Keys equal to
+ * std::numeric_limits<key>::max() are reserved as the cache's empty sentinel.
+ */
+template <typename KeyType, typename ValueType>
+class HybridVariable : public VariableBase<KeyType, ValueType> {
+ public:
+  HybridVariable(int64_t rows, size_t dimension, const std::string &initializer,
+                 cudaStream_t stream = 0);
+  ~HybridVariable() override;
+
+  int64_t rows() override;
+  int64_t cols() override;
+
+  void eXport(KeyType *keys, ValueType *values, cudaStream_t stream = 0) override;
+  void assign(const KeyType *keys, const ValueType *values, size_t num_keys,
+              cudaStream_t stream = 0) override;
+
+  void lookup(const KeyType *keys, ValueType *values, size_t num_keys,
+              cudaStream_t stream = 0) override;
+  void lookup(const KeyType *keys, ValueType **values, size_t num_keys,
+              cudaStream_t stream = 0) override;
+  void scatter_add(const KeyType *keys, const ValueType *values, size_t num_keys,
+                   cudaStream_t stream = 0) override;
+  void scatter_update(const KeyType *keys, const ValueType *values, size_t num_keys,
+                      cudaStream_t stream = 0) override;
+
+ private:
+  // nv_gpu_cache is instantiated for unsigned int / long long keys only; both SOK key types
+  // are bit-compatible with one of them.
+  using CacheKeyType =
+      typename std::conditional<sizeof(KeyType) == 8, long long, unsigned int>::type;
+  static constexpr size_t block_rows_ = 65536;
+
+  // Host store helpers; callers must hold mutex_.
+  size_t get_or_create_row_(KeyType key);
+  ValueType *host_row_(size_t row_index);
+
+  // Grows the device/host staging buffers to hold at least num_keys entries.
+  void reserve_staging_(size_t num_keys);
+
+  // Pushes the current host values of the given device-resident keys into the cache (Update,
+  // i.e. misses are ignored). `keys` lives on the host, `d_keys` is its device copy.
+  void update_cache_(const KeyType *keys, const CacheKeyType *d_keys, size_t num_keys,
+                     cudaStream_t stream);
+
+  size_t dimension_;
+  std::string initializer_;
+  bool use_const_initializer_{false};
+  float initial_val_{0.0f};
+  std::mt19937 generator_;
+
+  std::unordered_map<KeyType, size_t> index_;
+  std::vector<ValueType *> blocks_;  // pinned host memory, block_rows_ rows per block
+  std::mutex mutex_;
+
+  std::unique_ptr<gpu_cache::gpu_cache_api<CacheKeyType>> cache_;
+
+  // Staging buffers for miss handling and host/device round trips, grown on demand.
+  size_t staging_capacity_{0};
+  CacheKeyType *d_missing_keys_{nullptr};
+  uint64_t *d_missing_index_{nullptr};
+  size_t *d_missing_len_{nullptr};
+  ValueType *d_staging_values_{nullptr};
+  CacheKeyType *h_missing_keys_{nullptr};
+  uint64_t *h_missing_index_{nullptr};
+  size_t *h_missing_len_{nullptr};
+  ValueType *h_staging_values_{nullptr};
+};
+
+}  // namespace sok
+
+#endif  // HYBRID_VARIABLE_H
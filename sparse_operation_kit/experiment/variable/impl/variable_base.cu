@@ -15,6 +15,7 @@
  */
 
 #include "variable/impl/det_variable.h"
+#include "variable/impl/hybrid_variable.h"
 #include "variable/impl/variable_base.h"
 
 namespace sok {
@@ -23,9 +24,10 @@ template <typename KeyType, typename ValueType>
 std::shared_ptr<VariableBase<KeyType, ValueType>> VariableFactory::create(
     int64_t rows, int64_t cols, const std::string &type, const std::string &initializer,
     cudaStream_t stream) {
-  // if (type == "xxx") {
-  //   return nullptr;
-  // }
+  // host-memory table fronted by a GPU cache, for tables that do not fit in device memory
+  if (type == "hybrid") {
+    return std::make_shared<HybridVariable<KeyType, ValueType>>(rows, cols, initializer, stream);
+  }
 
   // default type
   return std::make_shared<DETVariable<KeyType, ValueType>>(cols, 2E4, initializer, stream);
@@ -25,7 +25,7 @@
 namespace SparseOperationKit {
 
 /*type used to specify the event is recorded on which stream*/
-enum class EventRecordType { RDLFramework, RMyself };
+enum class EventRecordType { RDLFramework, RMyself, RMyselfDeferrable };
 
 /*class used to handle cudaEvent*/
 class Event {
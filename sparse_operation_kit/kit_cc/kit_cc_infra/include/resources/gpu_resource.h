@@ -48,6 +48,7 @@ class GpuResource {
 
   std::unique_ptr<EventManager> event_mgr_;
   const bool event_sync_;
+  const bool defer_backward_join_;
 
   GpuResource(const size_t local_device_id, const size_t global_device_id,
               const uint64_t replica_uniform_seed, const uint64_t replica_variant_seed,
@@ -461,7 +461,12 @@ void Facade::backward(const tensorflow::Tensor* emb_handle, const size_t global_
   embedding_mgr_->backward(embedding, top_gradient, global_replica_id, gradient, value_index);
 
 #ifdef SOK_ASYNC
-  resources_mgr_->event_record(global_replica_id, EventRecordType::RMyself,
+  // Deferrable: with SOK_DEFER_BACKWARD_JOIN=1 this is a no-op, so the embedding gradient
+  // exchange runs concurrently with the framework's dense backprop and only the optimizer
+  // apply joins the two streams. That mode requires the gradients produced here to flow
+  // exclusively into the sok optimizer apply; any other framework-stream consumer would
+  // race with the still-running exchange.
+  resources_mgr_->event_record(global_replica_id, EventRecordType::RMyselfDeferrable,
                                /*event_name=*/embedding->get_var_name() + "_backward_end");
 #endif
 
@@ -35,6 +35,15 @@ bool GetEventSync() {
   }
 }
 
+bool GetDeferBackwardJoin() {
+  const auto sok_defer_backward_join = std::getenv("SOK_DEFER_BACKWARD_JOIN");
+  if (nullptr != sok_defer_backward_join && 1 == std::atoi(sok_defer_backward_join)) {
+    return true;
+  } else {
+    return false;
+  }
+}
+
 GpuResource::GpuResource(const size_t local_device_id, const size_t global_device_id,
                          const uint64_t replica_uniform_seed, const uint64_t replica_variant_seed,
                          const ncclComm_t& nccl_comm, const cudaStream_t& cuda_stream)
@@ -50,7 +59,8 @@ GpuResource::GpuResource(const size_t local_device_id, const size_t global_devic
       warp_size_(0),
       nccl_sync_data_(nullptr),
       event_mgr_(nullptr),
-      event_sync_(GetEventSync()) {
+      event_sync_(GetEventSync()),
+      defer_backward_join_(GetDeferBackwardJoin()) {
 #ifdef SOK_ASYNC
   CK_CUDA(cudaStreamCreateWithFlags(&computation_stream_, cudaStreamNonBlocking));
   event_mgr_.reset(EventManager::create().release());
@@ -164,6 +174,18 @@ void GpuResource::event_record(EventRecordType event_record_type, const std::str
                                    /*event_name=*/std::move(event_name));
       break;
     }
+    case EventRecordType::RMyselfDeferrable: {
+      // With SOK_DEFER_BACKWARD_JOIN=1 the framework stream is left free here, so the
+      // framework's dense backprop overlaps our gradient exchange; the optimizer apply,
+      // which is ordered behind us on the computation stream, becomes the only join point.
+      if (defer_backward_join_) {
+        break;
+      }
+      event_mgr_->sync_two_streams(/*root_stream=*/get_stream(),
+                                   /*sub_stream=*/get_framework_stream(),
+                                   /*event_name=*/std::move(event_name));
+      break;
+    }
     default: {
       throw std::runtime_error(ErrorBase + "Not supported EventRecordType.");
       break;
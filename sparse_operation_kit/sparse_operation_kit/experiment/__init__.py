@@ -59,6 +59,7 @@ from sparse_operation_kit.experiment.optimizer import SGD
 
 from sparse_operation_kit.experiment.lookup import lookup_sparse
 from sparse_operation_kit.experiment.lookup import all2all_dense_embedding
+from sparse_operation_kit.experiment.lookup import group_all2all_dense_embedding
 
 
 def init(comm_tool="horovod"):
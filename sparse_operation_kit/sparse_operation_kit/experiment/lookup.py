@@ -97,6 +97,90 @@ def all2all_dense_embedding(param, indices):
     return ex_embeddings
 
 
+def group_all2all_dense_embedding(params, indices):
+    """
+    Horizontally fused version of all2all_dense_embedding: a single lookup over all
+    tables that batches the index selection, the local gather (one GroupLookup op)
+    and the all-to-all communication across tables, instead of issuing one op chain
+    and two NCCL calls per table.
+    """
+    params = to_list(params)
+    indices = to_list(indices)
+    num_tables = len(params)
+
+    # The fused path assumes the distributed (key % num_gpus) sharding that the dense
+    # all2all lookup uses; everything else keeps the per-table path.
+    fusable = num_tables > 1 and all(
+        isinstance(param, DistributedVariable) and param.target_gpu == -1 for param in params
+    )
+    if not fusable:
+        return [all2all_dense_embedding(param, index) for param, index in zip(params, indices)]
+
+    num_gpus = params[0].num_gpus
+    dimensions = [int(param.shape[1]) for param in params]
+
+    # Filter keys per table; the chunks are laid out destination-gpu-major so that one
+    # all-to-all moves all tables' keys at once.
+    selected_chunks, orders, splits_per_table = [], [], []
+    for param, index in zip(params, indices):
+        selected_indices, order, splits = raw_ops.dist_select(index, num_splits=num_gpus)
+        selected_chunks.append(tf.split(selected_indices, splits))
+        orders.append(order)
+        splits_per_table.append(splits)
+
+    key_send_buffer = tf.concat(
+        [selected_chunks[t][g] for g in range(num_gpus) for t in range(num_tables)], 0
+    )
+    # [num_gpus, num_tables] key counts, flattened destination-major for the exchanges.
+    send_counts = tf.reshape(tf.stack(splits_per_table, axis=1), [num_gpus * num_tables])
+    recv_counts, _ = alltoall(send_counts, tf.fill([num_gpus], num_tables))
+    recv_counts = tf.reshape(recv_counts, [num_gpus * num_tables])
+
+    # All-to-all of all tables' keys
+    key_recv_buffer, _ = alltoall(key_send_buffer, tf.add_n(splits_per_table))
+    recv_chunks = tf.split(key_recv_buffer, recv_counts)
+    ex_indices = []
+    for t in range(num_tables):
+        ex_index = tf.concat([recv_chunks[g * num_tables + t] for g in range(num_gpus)], 0)
+        ex_indices.append(params[t].key_map(ex_index))
+
+    # Local lookup of all tables with a single fused gather
+    embeddings = group_lookup(params, ex_indices)
+
+    # All-to-all of all tables' embedding vectors, flattened because the tables may
+    # have different embedding dimensions.
+    recv_count_matrix = tf.reshape(recv_counts, [num_gpus, num_tables])
+    emb_chunks = [
+        tf.split(embeddings[t], recv_count_matrix[:, t]) for t in range(num_tables)
+    ]
+    vec_send_buffer = tf.concat(
+        [
+            tf.reshape(emb_chunks[t][g], [-1])
+            for g in range(num_gpus)
+            for t in range(num_tables)
+        ],
+        0,
+    )
+    table_dimensions = tf.constant(dimensions, dtype=send_counts.dtype)
+    vec_send_splits = tf.reduce_sum(recv_count_matrix * table_dimensions, axis=1)
+    vec_recv_buffer, _ = alltoall(vec_send_buffer, vec_send_splits)
+
+    # The received buffer mirrors what was sent out per destination: split it back into
+    # per-(gpu, table) pieces and restore each table's original key order.
+    vec_recv_sizes = tf.reshape(
+        tf.stack(splits_per_table, axis=1) * table_dimensions, [num_gpus * num_tables]
+    )
+    vec_chunks = tf.split(vec_recv_buffer, vec_recv_sizes)
+    outputs = []
+    for t in range(num_tables):
+        ex_embeddings = tf.concat(
+            [vec_chunks[g * num_tables + t] for g in range(num_gpus)], 0
+        )
+        ex_embeddings = tf.reshape(ex_embeddings, [-1, dimensions[t]])
+        outputs.append(raw_ops.reorder(ex_embeddings, orders[t]))
+    return outputs
+
+
 def _preprocessing_forward(*args, **kwargs):
     """
     This function should not be used by user directly.
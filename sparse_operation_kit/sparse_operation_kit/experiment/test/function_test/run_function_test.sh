@@ -22,4 +22,5 @@ do
     horovodrun -np ${i} python lookup_sparse_localized_dynamic_test.py
     horovodrun -np ${i} python all2all_dense_embedding_test.py
     horovodrun -np ${i} python all2all_dense_embedding_dynamic_test.py
+    horovodrun -np ${i} python group_all2all_dense_embedding_test.py
 done
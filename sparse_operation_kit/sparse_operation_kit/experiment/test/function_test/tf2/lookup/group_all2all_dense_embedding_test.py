@@ -0,0 +1,130 @@
+"""
+ Copyright (c) 2022, NVIDIA CORPORATION.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+"""
+
+import time
+import numpy as np
+import tensorflow as tf
+import horovod.tensorflow as hvd
+
+from sparse_operation_kit import experiment as sok
+
+
+if __name__ == "__main__":
+
+    # initialize
+    hvd.init()
+    gpus = tf.config.experimental.list_physical_devices("GPU")
+    for gpu in gpus:
+        tf.config.experimental.set_memory_growth(gpu, True)
+    if gpus:
+        tf.config.experimental.set_visible_devices(gpus[hvd.local_rank()], "GPU")
+    sok.init()
+
+    rows = [65536, 8192, 4096]
+    cols = [128, 16, 32]
+    batch_size = 8192
+    iters = 100
+
+    # initial value of embedding tables, same on each rank
+    weights = []
+    for row, col in zip(rows, cols):
+        weight = np.random.rand(row, col).astype(np.float32)
+        weight = tf.convert_to_tensor(weight, dtype=tf.float32)
+        weight = hvd.allreduce(weight)
+        weights.append(weight)
+
+    # sok variables
+    sok_vars = [sok.Variable(weight) for weight in weights]
+
+    # indices, same on each rank
+    total_indices = []
+    for row in rows:
+        indices = np.random.randint(0, row, [iters, batch_size])
+        indices = tf.convert_to_tensor(indices, dtype=tf.int64)
+        indices = hvd.broadcast(indices, root_rank=0)
+        total_indices.append(indices)
+    left = batch_size // hvd.size() * hvd.rank()
+    right = batch_size // hvd.size() * (hvd.rank() + 1)
+
+    # initialize optimizer
+    optimizer = tf.keras.optimizers.SGD(learning_rate=1.0)
+
+    # graph with sok.group_all2all_dense_embedding
+    @tf.function
+    def step(params, indices, optimizer):
+        with tf.GradientTape() as tape:
+            embeddings = sok.group_all2all_dense_embedding(params, indices)
+            loss = 0
+            for embedding in embeddings:
+                loss = loss + tf.reduce_sum(embedding)
+        grads = tape.gradient(loss, params)
+        optimizer.apply_gradients(zip(grads, params))
+        loss = hvd.allreduce(loss, op=hvd.Sum)
+        return loss
+
+    loss1 = []
+    ts = []
+    t = time.time()
+    for i in range(iters):
+        ts.append(time.time() - t)
+        t = time.time()
+        indices = [index[i, left:right] for index in total_indices]
+        loss = step(sok_vars, indices, optimizer)
+        loss1.append(loss)
+        print("-" * 30 + "iteration %d" % i + "-" * 30)
+        print("loss:", loss)
+
+    # graph with the per-table sok.all2all_dense_embedding as reference
+    sok_vars2 = [sok.Variable(weight) for weight in weights]
+    optimizer2 = tf.keras.optimizers.SGD(learning_rate=1.0)
+
+    @tf.function
+    def step2(params, indices, optimizer):
+        with tf.GradientTape() as tape:
+            loss = 0
+            for param, index in zip(params, indices):
+                embedding = sok.all2all_dense_embedding(param, index)
+                loss = loss + tf.reduce_sum(embedding)
+        grads = tape.gradient(loss, params)
+        optimizer.apply_gradients(zip(grads, params))
+        loss = hvd.allreduce(loss, op=hvd.Sum)
+        return loss
+
+    loss2 = []
+    for i in range(iters):
+        indices = [index[i, left:right] for index in total_indices]
+        loss = step2(sok_vars2, indices, optimizer2)
+        loss2.append(loss)
+        print("-" * 30 + "iteration %d" % i + "-" * 30)
+        print("ref loss:", loss)
+
+    # Check results
+    for var1, var2 in zip(sok_vars, sok_vars2):
+        length = var1**2 + var2**2 + 1e-8
+        diff = tf.reduce_sum((var1 - var2) ** 2 / length)
+        print("[SOK INFO] diff:", diff)
+        assert diff < 1e-6
+
+    diff = 0
+    for i in range(iters):
+        length = loss1[i] ** 2 + loss2[i] ** 2 + 1e-8
+        diff = diff + (loss1[i] - loss2[i]) ** 2 / length
+    print("[SOK INFO] loss diff:", diff)
+    assert diff < 1e-6
+
+    print("[SOK INFO] group_all2all_dense_embedding test passed")
+    ts = ts[5:]
+    print("[SOK INFO] Average time: %f ms/iteration" % (sum(ts) / len(ts) * 1000))
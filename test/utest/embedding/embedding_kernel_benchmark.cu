@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2021, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cuda_runtime_api.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <embeddings/sparse_embedding_functors.hpp>
+#include <functional>
+#include <general_buffer2.hpp>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace HugeCTR;
+
+namespace {
+
+// Microbenchmark for the hot embedding kernels (forward_per_gpu_functor.cu and
+// update_params_functor.cu). Sweeps (batch, hotness, vec size, table rows), times each kernel
+// with CUDA events and reports the achieved bandwidth relative to the device's theoretical
+// peak, so a kernel regression shows up as a drop in the roofline fraction rather than only in
+// end-to-end canaries. The table lookup indices are drawn from a Zipf distribution by default
+// to mimic production key skew (matters for the atomic SGD update).
+struct BenchmarkConfig {
+  std::vector<size_t> batch_sizes = {1024, 8192};
+  std::vector<size_t> hotnesses = {1, 8, 32};
+  std::vector<size_t> vec_sizes = {16, 64, 128};
+  std::vector<size_t> table_rows = {1000000};
+  size_t slot_num = 26;
+  size_t iterations = 100;
+  size_t warmup_iterations = 10;
+  double zipf_alpha = 1.05;
+  unsigned seed = 42;
+  int device = 0;
+};
+
+void print_usage(const char* prog) {
+  std::printf(
+      "Usage: %s [options]\n"
+      "  --batch-sizes <n,n,...>   samples per iteration (default 1024,8192)\n"
+      "  --hotnesses <n,n,...>     keys per sample per slot (default 1,8,32)\n"
+      "  --vec-sizes <n,n,...>     floats per embedding vector (default 16,64,128)\n"
+      "  --table-rows <n,n,...>    rows per embedding table (default 1000000)\n"
+      "  --slot-num <n>            slots per sample (default 26)\n"
+      "  --iterations <n>          timed launches per configuration (default 100)\n"
+      "  --warmup <n>              untimed launches per configuration (default 10)\n"
+      "  --zipf-alpha <a>          row-index skew, 0 = uniform (default 1.05)\n"
+      "  --seed <n>                RNG seed (default 42)\n"
+      "  --device <n>              CUDA device ordinal (default 0)\n",
+      prog);
+}
+
+std::vector<size_t> parse_size_list(const std::string& arg) {
+  std::vector<size_t> values;
+  std::stringstream ss(arg);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    values.push_back(std::stoull(item));
+  }
+  return values;
+}
+
+bool parse_args(int argc, char** argv, BenchmarkConfig& config) {
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    const auto next = [&]() -> std::string {
+      if (++i >= argc) {
+        throw std::runtime_error("missing value for " + arg);
+      }
+      return argv[i];
+    };
+    if (arg == "--batch-sizes") {
+      config.batch_sizes = parse_size_list(next());
+    } else if (arg == "--hotnesses") {
+      config.hotnesses = parse_size_list(next());
+    } else if (arg == "--vec-sizes") {
+      config.vec_sizes = parse_size_list(next());
+    } else if (arg == "--table-rows") {
+      config.table_rows = parse_size_list(next());
+    } else if (arg == "--slot-num") {
+      config.slot_num = std::stoull(next());
+    } else if (arg == "--iterations") {
+      config.iterations = std::stoull(next());
+    } else if (arg == "--warmup") {
+      config.warmup_iterations = std::stoull(next());
+    } else if (arg == "--zipf-alpha") {
+      config.zipf_alpha = std::stod(next());
+    } else if (arg == "--seed") {
+      config.seed = static_cast<unsigned>(std::stoul(next()));
+    } else if (arg == "--device") {
+      config.device = std::stoi(next());
+    } else {
+      print_usage(argv[0]);
+      return false;
+    }
+  }
+  return true;
+}
+
+// Inverse-CDF Zipf sampler over [0, num_rows); alpha == 0 degenerates to uniform.
+class ZipfSampler {
+ public:
+  ZipfSampler(size_t num_rows, double alpha, unsigned seed)
+      : generator_(seed), uniform_(0.0, 1.0), num_rows_(num_rows), alpha_(alpha) {
+    if (alpha_ > 0.0) {
+      cdf_.resize(num_rows);
+      double sum = 0.0;
+      for (size_t rank = 0; rank < num_rows; rank++) {
+        sum += 1.0 / std::pow(static_cast<double>(rank + 1), alpha_);
+        cdf_[rank] = sum;
+      }
+      for (auto& v : cdf_) {
+        v /= sum;
+      }
+    }
+  }
+
+  size_t operator()() {
+    if (alpha_ <= 0.0) {
+      return static_cast<size_t>(uniform_(generator_) * num_rows_) % num_rows_;
+    }
+    const auto it = std::upper_bound(cdf_.begin(), cdf_.end(), uniform_(generator_));
+    return static_cast<size_t>(it - cdf_.begin());
+  }
+
+ private:
+  std::mt19937_64 generator_;
+  std::uniform_real_distribution<double> uniform_;
+  std::vector<double> cdf_;
+  size_t num_rows_;
+  double alpha_;
+};
+
+__global__ void fill_table_kernel(float* table, size_t len) {
+  for (size_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < len;
+       idx += blockDim.x * gridDim.x) {
+    table[idx] = static_cast<float>(idx % 1997) * 1e-4f;
+  }
+}
+
+// Average milliseconds per launch of `body` over `iterations` timed runs.
+float time_kernel_ms(const std::function<void()>& body, size_t warmup_iterations,
+                     size_t iterations, cudaStream_t stream) {
+  for (size_t i = 0; i < warmup_iterations; i++) {
+    body();
+  }
+  cudaEvent_t start, stop;
+  HCTR_LIB_THROW(cudaEventCreate(&start));
+  HCTR_LIB_THROW(cudaEventCreate(&stop));
+  HCTR_LIB_THROW(cudaEventRecord(start, stream));
+  for (size_t i = 0; i < iterations; i++) {
+    body();
+  }
+  HCTR_LIB_THROW(cudaEventRecord(stop, stream));
+  HCTR_LIB_THROW(cudaEventSynchronize(stop));
+  float elapsed_ms = 0.f;
+  HCTR_LIB_THROW(cudaEventElapsedTime(&elapsed_ms, start, stop));
+  HCTR_LIB_THROW(cudaEventDestroy(start));
+  HCTR_LIB_THROW(cudaEventDestroy(stop));
+  return elapsed_ms / iterations;
+}
+
+void report(const char* kernel, const char* comp, size_t batch, size_t hotness, size_t vec_size,
+            size_t rows, float ms, double bytes, double peak_bytes_per_sec) {
+  const double gbps = bytes / (ms * 1e-3) / 1e9;
+  const double roofline = 100.0 * bytes / (ms * 1e-3) / peak_bytes_per_sec;
+  std::printf("%-22s %-6s %8zu %8zu %6zu %10zu %10.4f %10.1f %8.1f%%\n", kernel, comp, batch,
+              hotness, vec_size, rows, ms, gbps, roofline);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  BenchmarkConfig config;
+  try {
+    if (!parse_args(argc, argv, config)) {
+      return 1;
+    }
+  } catch (const std::exception& e) {
+    std::fprintf(stderr, "%s\n", e.what());
+    print_usage(argv[0]);
+    return 1;
+  }
+
+  HCTR_LIB_THROW(cudaSetDevice(config.device));
+  cudaDeviceProp prop;
+  HCTR_LIB_THROW(cudaGetDeviceProperties(&prop, config.device));
+  // Theoretical peak: memory clock (kHz) * bus width (bits) * 2 (DDR) / 8 -> bytes/s.
+  const double peak_bytes_per_sec =
+      static_cast<double>(prop.memoryClockRate) * 1e3 * prop.memoryBusWidth * 2.0 / 8.0;
+  std::printf("device %d (%s), theoretical peak %.1f GB/s, zipf %.2f, %zu iterations\n",
+              config.device, prop.name, peak_bytes_per_sec / 1e9, config.zipf_alpha,
+              config.iterations);
+  std::printf("%-22s %-6s %8s %8s %6s %10s %10s %10s %9s\n", "kernel", "comp", "batch", "hotness",
+              "vec", "rows", "ms/iter", "GB/s", "roofline");
+
+  SparseEmbeddingFunctors functors;
+  cudaStream_t stream = 0;
+
+  for (size_t rows : config.table_rows) {
+    for (size_t vec_size : config.vec_sizes) {
+      for (size_t batch : config.batch_sizes) {
+        for (size_t hotness : config.hotnesses) {
+          const size_t slot_num = config.slot_num;
+          const size_t nnz = batch * slot_num * hotness;
+
+          auto buf = GeneralBuffer2<CudaAllocator>::create();
+          Tensor2<float> table;
+          Tensor2<unsigned int> row_offset;
+          Tensor2<unsigned int> hash_key;
+          Tensor2<size_t> value_index;
+          Tensor2<float> feature_fp32;
+          Tensor2<__half> feature_fp16;
+          Tensor2<float> wgrad;
+          Tensor2<size_t> top_categories;
+          buf->reserve({rows, vec_size}, &table);
+          buf->reserve({batch * slot_num + 1}, &row_offset);
+          buf->reserve({nnz}, &hash_key);
+          buf->reserve({nnz}, &value_index);
+          buf->reserve({batch * slot_num, vec_size}, &feature_fp32);
+          buf->reserve({batch * slot_num, vec_size}, &feature_fp16);
+          buf->reserve({nnz, vec_size}, &wgrad);
+          buf->reserve({nnz}, &top_categories);
+          buf->allocate();
+
+          fill_table_kernel<<<1024, 256, 0, stream>>>(table.get_ptr(),
+                                                      table.get_num_elements());
+          fill_table_kernel<<<1024, 256, 0, stream>>>(wgrad.get_ptr(),
+                                                      wgrad.get_num_elements());
+
+          // Uniform hotness CSR and skewed row indices, generated on the host once per config.
+          std::vector<unsigned int> h_row_offset(batch * slot_num + 1);
+          for (size_t i = 0; i < h_row_offset.size(); i++) {
+            h_row_offset[i] = static_cast<unsigned int>(i * hotness);
+          }
+          ZipfSampler sampler(rows, config.zipf_alpha, config.seed);
+          std::vector<size_t> h_value_index(nnz);
+          for (auto& idx : h_value_index) {
+            idx = sampler();
+          }
+          HCTR_LIB_THROW(cudaMemcpy(row_offset.get_ptr(), h_row_offset.data(),
+                                    row_offset.get_size_in_bytes(), cudaMemcpyHostToDevice));
+          HCTR_LIB_THROW(cudaMemcpy(value_index.get_ptr(), h_value_index.data(),
+                                    value_index.get_size_in_bytes(), cudaMemcpyHostToDevice));
+
+          // Forward gather: table rows + indices + CSR in, one combined vector per slot out.
+          const double fwd_bytes_in = static_cast<double>(nnz) * vec_size * sizeof(float) +
+                                      static_cast<double>(nnz) * sizeof(size_t) +
+                                      static_cast<double>(h_row_offset.size()) *
+                                          sizeof(unsigned int);
+          const double fwd_out_rows = static_cast<double>(batch) * slot_num * vec_size;
+
+          for (int combiner : {0, 1}) {
+            const char* name = (combiner == 0) ? "forward_sum" : "forward_mean";
+            const float ms_fp32 = time_kernel_ms(
+                [&] {
+                  functors.forward_sum_per_gpu(batch, slot_num, vec_size, combiner, true,
+                                               row_offset, hash_key, nnz, table, value_index,
+                                               feature_fp32, stream);
+                },
+                config.warmup_iterations, config.iterations, stream);
+            report(name, "fp32", batch, hotness, vec_size, rows, ms_fp32,
+                   fwd_bytes_in + fwd_out_rows * sizeof(float), peak_bytes_per_sec);
+
+            const float ms_fp16 = time_kernel_ms(
+                [&] {
+                  functors.forward_sum_per_gpu(batch, slot_num, vec_size, combiner, true,
+                                               row_offset, hash_key, nnz, table, value_index,
+                                               feature_fp16, stream);
+                },
+                config.warmup_iterations, config.iterations, stream);
+            report(name, "fp16", batch, hotness, vec_size, rows, ms_fp16,
+                   fwd_bytes_in + fwd_out_rows * sizeof(__half), peak_bytes_per_sec);
+          }
+
+          // Atomic SGD update: wgrad + indices in, read-modify-write on the touched table rows.
+          // The byte model charges every touched row twice (no dedup), so heavily skewed inputs
+          // can report above 100% of peak -- that is cache reuse, not a measurement error.
+          size_t size_top_categories = 0;
+          const double upd_bytes = static_cast<double>(nnz) * vec_size * sizeof(float) +
+                                   static_cast<double>(nnz) * sizeof(size_t) +
+                                   2.0 * static_cast<double>(nnz) * vec_size * sizeof(float);
+          const float ms_upd = time_kernel_ms(
+              [&] {
+                SparseEmbeddingFunctors::opt_sgd_atomic_cached<float>(
+                    nnz, vec_size, value_index.get_ptr(), 0.01f, 1.0f, wgrad.get_ptr(),
+                    table.get_ptr(), top_categories.get_ptr(), size_top_categories, stream);
+              },
+              config.warmup_iterations, config.iterations, stream);
+          report("opt_sgd_atomic_cached", "fp32", batch, hotness, vec_size, rows, ms_upd,
+                 upd_bytes, peak_bytes_per_sec);
+        }
+      }
+    }
+  }
+
+  return 0;
+}
@@ -228,6 +228,72 @@ void statistics_test(const size_t batch_size, const size_t num_tables) {
   EXPECT_EQ(count_ne, 0);
 }
 
+template <typename dtype>
+void sketch_statistics_test(const size_t batch_size, const size_t num_tables) {
+  cudaStream_t stream = 0;
+
+  std::vector<size_t> categories;
+  std::vector<size_t> counts;
+
+  HugeCTR::hybrid_embedding::HybridEmbeddingInputGenerator<dtype> input_generator(848484);
+  std::vector<dtype> raw_data = input_generator.generate_categorical_input(batch_size, num_tables);
+  std::vector<size_t> table_sizes = input_generator.get_table_sizes();
+
+  std::vector<dtype> samples_ref;
+  HugeCTR::hybrid_embedding::generate_reference_stats<dtype>(raw_data, samples_ref, categories,
+                                                             counts, table_sizes, batch_size);
+  std::map<dtype, size_t> ref_count;
+  for (size_t c = 0; c < categories.size(); ++c) {
+    ref_count[(dtype)categories[c]] = counts[c];
+  }
+
+  Tensor2<dtype> d_raw_data;
+  std::shared_ptr<GeneralBuffer2<CudaAllocator>> buf = GeneralBuffer2<CudaAllocator>::create();
+  buf->reserve({raw_data.size(), 1}, &d_raw_data);
+  buf->allocate();
+  upload_tensor(raw_data, d_raw_data, stream);
+
+  Data<dtype> data(table_sizes, batch_size, 1);
+  data.data_to_unique_categories(d_raw_data, stream);
+  size_t num_instances = 8;  // not important here
+
+  // the sketch path is selected at construction time
+  setenv("HCTR_HYBRID_SKETCH_STATISTICS", "1", 1);
+  HugeCTR::hybrid_embedding::Statistics<dtype> statistics(data, num_instances);
+  unsetenv("HCTR_HYBRID_SKETCH_STATISTICS");
+
+  statistics.sort_categories_by_count(data.samples, stream);
+  HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+
+  std::vector<dtype> h_categories_sorted;
+  std::vector<uint32_t> h_counts_sorted;
+  download_tensor(h_categories_sorted, statistics.categories_sorted, stream);
+  download_tensor(h_counts_sorted, statistics.counts_sorted, stream);
+
+  const size_t num_selected = statistics.num_unique_categories;
+  EXPECT_LE(num_selected, categories.size());
+
+  // every truly repeated category must be selected (the sketch never under-counts)
+  std::unordered_set<dtype> selected(h_categories_sorted.begin(),
+                                     h_categories_sorted.begin() + num_selected);
+  for (const auto &category_count : ref_count) {
+    if (category_count.second >= 2) {
+      EXPECT_TRUE(selected.count(category_count.first) > 0);
+    }
+  }
+
+  // estimates bound the exact counts from above, stay within 1% of the window, and are sorted
+  const size_t max_overestimate = std::max((size_t)1, raw_data.size() / 100);
+  for (size_t c = 0; c < num_selected; ++c) {
+    const size_t exact = ref_count[h_categories_sorted[c]];
+    EXPECT_GE((size_t)h_counts_sorted[c], exact);
+    EXPECT_LE((size_t)h_counts_sorted[c], exact + max_overestimate);
+    if (c > 0) {
+      EXPECT_LE(h_counts_sorted[c], h_counts_sorted[c - 1]);
+    }
+  }
+}
+
 TEST(calculate_statistics_test, dtype_uint32) {
   const size_t N = 5;
   for (size_t batch_size = 128; batch_size < 15 * 64 * 1024; batch_size = 4 * batch_size) {
@@ -249,3 +315,19 @@ TEST(calculate_statistics_test, dtype_long_long) {
     }
   }
 }
+
+TEST(calculate_statistics_test, sketch_dtype_uint32) {
+  for (size_t batch_size = 128; batch_size < 15 * 64 * 1024; batch_size = 8 * batch_size) {
+    for (size_t num_tables = 1; num_tables <= 32; num_tables = 4 * num_tables) {
+      sketch_statistics_test<uint32_t>(batch_size, num_tables);
+    }
+  }
+}
+
+TEST(calculate_statistics_test, sketch_dtype_long_long) {
+  for (size_t batch_size = 128; batch_size < 15 * 64 * 1024; batch_size = 8 * batch_size) {
+    for (size_t num_tables = 1; num_tables <= 32; num_tables = 4 * num_tables) {
+      sketch_statistics_test<long long>(batch_size, num_tables);
+    }
+  }
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "HugeCTR/embedding/embedding_planner.hpp"
+#include "HugeCTR/embedding_storage/common.hpp"
+using namespace embedding;
+
+namespace {
+
+EmbeddingCollectionParam make_ebc_param(const std::vector<int> &hotness_list,
+                                        const std::vector<Combiner> &combiner_list, int ev_size,
+                                        int batch_size) {
+  EmbeddingCollectionParam ebc_param;
+  ebc_param.num_embedding = static_cast<int>(hotness_list.size());
+  for (int embedding_id = 0; embedding_id < ebc_param.num_embedding; ++embedding_id) {
+    EmbeddingParam emb_param;
+    emb_param.embedding_id = embedding_id;
+    emb_param.id_space = embedding_id;
+    emb_param.combiner = combiner_list[embedding_id];
+    emb_param.hotness = hotness_list[embedding_id];
+    emb_param.ev_size = ev_size;
+    ebc_param.embedding_params.push_back(std::move(emb_param));
+  }
+  ebc_param.universal_batch_size = batch_size;
+  ebc_param.emb_type = core::TensorScalarType::Float32;
+  return ebc_param;
+}
+
+EmbeddingTableParam make_table_param(int table_id, int max_vocabulary_size, int ev_size) {
+  EmbeddingTableParam table_param;
+  table_param.table_id = table_id;
+  table_param.max_vocabulary_size = max_vocabulary_size;
+  table_param.ev_size = ev_size;
+  table_param.min_key = 0;
+  table_param.max_key = max_vocabulary_size;
+  return table_param;
+}
+
+}  // namespace
+
+TEST(test_embedding_planner, auto_plan_places_small_hot_table_dp) {
+  // table 0 is tiny and hot (the dp candidate), table 1 is far too large to replicate
+  auto ebc_param = make_ebc_param({30, 1}, {Combiner::Sum, Combiner::Sum}, 16, 8192);
+  std::vector<EmbeddingTableParam> table_param_list{make_table_param(0, 100, 16),
+                                                    make_table_param(1, 100000000, 16)};
+
+  AutoPlannerCostModel cost_model;
+  cost_model.num_global_gpus = 8;
+  cost_model.num_gpus_per_node = 8;
+
+  EmbeddingPlanner planner{ebc_param};
+  planner.generate_embedding_plan_auto(table_param_list, cost_model);
+
+  const auto &plan = planner.get_gpu_major_global_embedding_sharding_param_list();
+  ASSERT_EQ(plan.size(), 8ul);
+  for (int gpu_id = 0; gpu_id < 8; ++gpu_id) {
+    ASSERT_EQ(plan[gpu_id].size(), 2ul);
+
+    const auto &dp_param = plan[gpu_id][0];
+    EXPECT_EQ(dp_param.table_placement_strategy, TablePlacementStrategy::DataParallel);
+    EXPECT_EQ(dp_param.local_embedding_list, std::vector<int>{0});
+    EXPECT_EQ(dp_param.shard_id, 0);
+    EXPECT_EQ(dp_param.shards_count, 1);
+
+    const auto &mp_param = plan[gpu_id][1];
+    EXPECT_EQ(mp_param.table_placement_strategy, TablePlacementStrategy::ModelParallel);
+    EXPECT_EQ(mp_param.local_embedding_list, std::vector<int>{1});
+    EXPECT_EQ(mp_param.shard_id, gpu_id);
+    EXPECT_EQ(mp_param.shards_count, 8);
+    EXPECT_EQ(mp_param.global_embedding_list.size(), 8ul);
+  }
+}
+
+TEST(test_embedding_planner, auto_plan_respects_dp_memory_budget) {
+  // the table would win on predicted time but does not fit the replication budget
+  auto ebc_param = make_ebc_param({30}, {Combiner::Sum}, 16, 8192);
+  std::vector<EmbeddingTableParam> table_param_list{make_table_param(0, 100, 16)};
+
+  AutoPlannerCostModel cost_model;
+  cost_model.num_global_gpus = 4;
+  cost_model.num_gpus_per_node = 4;
+  cost_model.dp_memory_budget = 0;
+
+  EmbeddingPlanner planner{ebc_param};
+  planner.generate_embedding_plan_auto(table_param_list, cost_model);
+
+  const auto &plan = planner.get_gpu_major_global_embedding_sharding_param_list();
+  ASSERT_EQ(plan.size(), 4ul);
+  for (int gpu_id = 0; gpu_id < 4; ++gpu_id) {
+    ASSERT_EQ(plan[gpu_id].size(), 1ul);
+    EXPECT_EQ(plan[gpu_id][0].table_placement_strategy, TablePlacementStrategy::ModelParallel);
+    EXPECT_EQ(plan[gpu_id][0].shard_id, gpu_id);
+  }
+}
+
+TEST(test_embedding_planner, auto_plan_keeps_concat_embedding_mp_cost_hotness_scaled) {
+  // a concat embedding moves all its vectors through the all2all, so a small table with
+  // high hotness should still be placed dp when it fits
+  auto ebc_param = make_ebc_param({30}, {Combiner::Concat}, 16, 8192);
+  std::vector<EmbeddingTableParam> table_param_list{make_table_param(0, 100, 16)};
+
+  AutoPlannerCostModel cost_model;
+  cost_model.num_global_gpus = 4;
+  cost_model.num_gpus_per_node = 4;
+
+  EmbeddingPlanner planner{ebc_param};
+  planner.generate_embedding_plan_auto(table_param_list, cost_model);
+
+  const auto &plan = planner.get_gpu_major_global_embedding_sharding_param_list();
+  ASSERT_EQ(plan.size(), 4ul);
+  for (int gpu_id = 0; gpu_id < 4; ++gpu_id) {
+    ASSERT_EQ(plan[gpu_id].size(), 1ul);
+    EXPECT_EQ(plan[gpu_id][0].table_placement_strategy, TablePlacementStrategy::DataParallel);
+  }
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <numeric>
+
+#include "HugeCTR/core/hctr_impl/hctr_backend.hpp"
+#include "HugeCTR/embedding/operators/network_forward.hpp"
+#include "HugeCTR/include/resource_managers/resource_manager_ext.hpp"
+#include "HugeCTR/include/utils.hpp"
+using namespace embedding;
+
+// The fused-combiner NetworkForward overload must divide average-combiner lookups by their
+// bucket size inside the gather; compare it against the unfused gather plus an explicit
+// host-side division.
+TEST(test_network_forward, fused_average_combiner) {
+  Device device{DeviceType::GPU, 0};
+  auto resource_manager = HugeCTR::ResourceManagerExt::create({{0}}, 0);
+  auto core = std::make_shared<hctr_internal::HCTRCoreResourceManager>(resource_manager, 0);
+  HugeCTR::CudaDeviceContext context(device.index());
+
+  const int batch_size = 4;
+  const int num_lookup = 2;
+  const std::vector<int> ev_size_list{4, 8};
+  const int max_ev_size = 8;
+  const int num_elements = (ev_size_list[0] + ev_size_list[1]) * batch_size;
+  const std::vector<char> combiner_list{static_cast<char>(Combiner::Average),
+                                        static_cast<char>(Combiner::Sum)};
+
+  auto buffer_ptr = core::GetBuffer(core);
+  auto network_ids = buffer_ptr->reserve({num_lookup}, device, TensorScalarType::Int32);
+  auto network_gpu_ids = buffer_ptr->reserve({num_lookup}, device, TensorScalarType::Int32);
+  auto network_offsets = buffer_ptr->reserve({num_lookup + 1}, device, TensorScalarType::Int32);
+  auto network_dst_lookup_ids = buffer_ptr->reserve({num_lookup}, device, TensorScalarType::Int32);
+  auto local_ev_sizes = buffer_ptr->reserve({num_lookup}, device, TensorScalarType::Int32);
+  auto local_ev_offsets = buffer_ptr->reserve({num_lookup}, device, TensorScalarType::Int32);
+  auto bucket_range =
+      buffer_ptr->reserve({num_lookup * batch_size + 1}, device, TensorScalarType::UInt32);
+  auto d_combiner_list = buffer_ptr->reserve({num_lookup}, device, TensorScalarType::Char);
+  auto d_ev_size_offset = buffer_ptr->reserve({num_lookup + 1}, device, TensorScalarType::Int32);
+  auto comm_buffer = buffer_ptr->reserve({num_elements}, device, TensorScalarType::Float32);
+  auto output_fused = buffer_ptr->reserve({num_elements}, device, TensorScalarType::Float32);
+  auto output_ref = buffer_ptr->reserve({num_elements}, device, TensorScalarType::Float32);
+  buffer_ptr->allocate();
+
+  // one gpu, one source per dst lookup
+  network_ids.copy_from(std::vector<int>{0, 1});
+  network_gpu_ids.copy_from(std::vector<int>{0, 0});
+  network_offsets.copy_from(std::vector<int>{0, 1, 2});
+  network_dst_lookup_ids.copy_from(std::vector<int>{0, 1});
+  local_ev_sizes.copy_from(ev_size_list);
+  local_ev_offsets.copy_from(std::vector<int>{0, ev_size_list[0]});
+  d_combiner_list.copy_from(combiner_list);
+  d_ev_size_offset.copy_from(
+      std::vector<int>{0, ev_size_list[0], ev_size_list[0] + ev_size_list[1]});
+
+  std::vector<uint32_t> cpu_bucket_range{0};
+  for (int i = 0; i < num_lookup * batch_size; ++i) {
+    cpu_bucket_range.push_back(1 + rand() % 5);
+  }
+  std::partial_sum(cpu_bucket_range.begin(), cpu_bucket_range.end(), cpu_bucket_range.begin());
+  bucket_range.copy_from(cpu_bucket_range);
+
+  std::vector<float> cpu_comm_buffer(num_elements);
+  for (int i = 0; i < num_elements; ++i) {
+    cpu_comm_buffer[i] = 0.25f * static_cast<float>(i % 17) - 1.f;
+  }
+  comm_buffer.copy_from(cpu_comm_buffer);
+
+  TensorList comm_buffer_list{core.get(), std::vector<Tensor>{comm_buffer}, device,
+                              TensorScalarType::Float32};
+  TensorList ev_sizes_list{core.get(), std::vector<Tensor>{local_ev_sizes}, device,
+                           TensorScalarType::Int32};
+  TensorList ev_offsets_list{core.get(), std::vector<Tensor>{local_ev_offsets}, device,
+                             TensorScalarType::Int32};
+
+  NetworkForward network_forward{core, 1};
+  network_forward.compute(comm_buffer_list, network_ids, network_gpu_ids, network_offsets,
+                          network_dst_lookup_ids, ev_sizes_list, ev_offsets_list, bucket_range,
+                          d_combiner_list, output_fused, d_ev_size_offset, batch_size, max_ev_size);
+  network_forward.compute(comm_buffer_list, network_ids, network_gpu_ids, network_offsets,
+                          network_dst_lookup_ids, ev_sizes_list, ev_offsets_list, output_ref,
+                          d_ev_size_offset, batch_size, max_ev_size);
+  HCTR_LIB_THROW(cudaStreamSynchronize(core->get_local_gpu()->get_stream()));
+
+  std::vector<float> fused;
+  output_fused.to(&fused);
+  std::vector<float> ref;
+  output_ref.to(&ref);
+
+  for (int bid = 0; bid < batch_size; ++bid) {
+    // lookup 0 uses the average combiner and must come out divided by its bucket size
+    int nnz = static_cast<int>(cpu_bucket_range[bid + 1] - cpu_bucket_range[bid]);
+    ASSERT_GE(nnz, 1);
+    for (int e = 0; e < ev_size_list[0]; ++e) {
+      int idx = bid * ev_size_list[0] + e;
+      ASSERT_FLOAT_EQ(fused[idx], ref[idx] / nnz);
+    }
+    // lookup 1 uses the sum combiner and must match the unfused gather exactly
+    for (int e = 0; e < ev_size_list[1]; ++e) {
+      int idx = ev_size_list[0] * batch_size + bid * ev_size_list[1] + e;
+      ASSERT_FLOAT_EQ(fused[idx], ref[idx]);
+    }
+  }
+}
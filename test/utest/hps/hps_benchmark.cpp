@@ -0,0 +1,332 @@
+/*
+ * Copyright (c) 2021, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cuda_runtime_api.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <common.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <hps/embedding_cache_base.hpp>
+#include <hps/hier_parameter_server_base.hpp>
+#include <hps/inference_utils.hpp>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace HugeCTR;
+namespace {
+
+// Reproducible lookup/update load generator for the HPS stack. Generates synthetic sparse model
+// files, stands up a HierParameterServer on them and drives concurrent lookups with a Zipf key
+// distribution, optionally with a background cache-refresh thread emulating applied updates.
+struct BenchmarkConfig {
+  size_t num_tables = 2;
+  size_t num_keys_per_table = 100000;
+  size_t embedding_vec_size = 16;
+  size_t batch_size = 64;
+  size_t feature_num = 10;  // keys per sample per table
+  double zipf_alpha = 1.05;
+  size_t iterations = 1000;
+  size_t num_threads = 4;
+  size_t refresh_interval_ms = 0;  // 0 disables the update thread
+  float cache_size_percentage = 0.5f;
+  float hit_rate_threshold = 1.0f;
+  bool use_gpu_cache_lookup = false;  // drive EmbeddingCacheBase::lookup instead of the host path
+  unsigned seed = 42;
+};
+
+void print_usage(const char* prog) {
+  std::printf(
+      "Usage: %s [options]\n"
+      "  --num-tables <n>           embedding tables per model (default 2)\n"
+      "  --num-keys <n>             rows per table (default 100000)\n"
+      "  --vec-size <n>             floats per embedding vector (default 16)\n"
+      "  --batch-size <n>           samples per lookup batch (default 64)\n"
+      "  --feature-num <n>          keys per sample per table (default 10)\n"
+      "  --zipf-alpha <a>           key skew, 0 = uniform (default 1.05)\n"
+      "  --iterations <n>           batches per lookup thread (default 1000)\n"
+      "  --threads <n>              concurrent lookup threads (default 4)\n"
+      "  --refresh-interval-ms <n>  update thread period, 0 = off (default 0)\n"
+      "  --cache-percentage <p>     GPU cache size fraction (default 0.5)\n"
+      "  --hit-rate-threshold <p>   sync/async insert boundary (default 1.0)\n"
+      "  --gpu-cache                drive the GPU embedding cache instead of the host path\n"
+      "  --seed <n>                 RNG seed (default 42)\n",
+      prog);
+}
+
+bool parse_args(int argc, char** argv, BenchmarkConfig& config) {
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    auto next = [&]() -> const char* {
+      if (i + 1 >= argc) {
+        print_usage(argv[0]);
+        std::exit(1);
+      }
+      return argv[++i];
+    };
+    if (arg == "--num-tables") {
+      config.num_tables = std::stoul(next());
+    } else if (arg == "--num-keys") {
+      config.num_keys_per_table = std::stoul(next());
+    } else if (arg == "--vec-size") {
+      config.embedding_vec_size = std::stoul(next());
+    } else if (arg == "--batch-size") {
+      config.batch_size = std::stoul(next());
+    } else if (arg == "--feature-num") {
+      config.feature_num = std::stoul(next());
+    } else if (arg == "--zipf-alpha") {
+      config.zipf_alpha = std::stod(next());
+    } else if (arg == "--iterations") {
+      config.iterations = std::stoul(next());
+    } else if (arg == "--threads") {
+      config.num_threads = std::stoul(next());
+    } else if (arg == "--refresh-interval-ms") {
+      config.refresh_interval_ms = std::stoul(next());
+    } else if (arg == "--cache-percentage") {
+      config.cache_size_percentage = std::stof(next());
+    } else if (arg == "--hit-rate-threshold") {
+      config.hit_rate_threshold = std::stof(next());
+    } else if (arg == "--gpu-cache") {
+      config.use_gpu_cache_lookup = true;
+    } else if (arg == "--seed") {
+      config.seed = static_cast<unsigned>(std::stoul(next()));
+    } else {
+      print_usage(argv[0]);
+      return false;
+    }
+  }
+  return true;
+}
+
+// Inverse-CDF Zipf sampler over [0, num_keys); alpha == 0 degenerates to uniform.
+class ZipfSampler {
+ public:
+  ZipfSampler(size_t num_keys, double alpha, unsigned seed)
+      : generator_(seed), uniform_(0.0, 1.0), num_keys_(num_keys), alpha_(alpha) {
+    if (alpha_ > 0.0) {
+      cdf_.resize(num_keys);
+      double sum = 0.0;
+      for (size_t rank = 0; rank < num_keys; rank++) {
+        sum += 1.0 / std::pow(static_cast<double>(rank + 1), alpha_);
+        cdf_[rank] = sum;
+      }
+      for (auto& v : cdf_) {
+        v /= sum;
+      }
+    }
+  }
+
+  long long operator()() {
+    if (alpha_ <= 0.0) {
+      return static_cast<long long>(uniform_(generator_) * num_keys_) % num_keys_;
+    }
+    const auto it = std::upper_bound(cdf_.begin(), cdf_.end(), uniform_(generator_));
+    return static_cast<long long>(it - cdf_.begin());
+  }
+
+ private:
+  std::mt19937_64 generator_;
+  std::uniform_real_distribution<double> uniform_;
+  std::vector<double> cdf_;
+  size_t num_keys_;
+  double alpha_;
+};
+
+// Write a synthetic sparse model (key + emb_vector files) that the model loader can read.
+void generate_sparse_model(const std::string& model_dir, size_t num_keys, size_t vec_size,
+                           unsigned seed) {
+  std::filesystem::create_directories(model_dir);
+  std::ofstream key_stream(model_dir + "/key", std::ofstream::binary);
+  std::ofstream vec_stream(model_dir + "/emb_vector", std::ofstream::binary);
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<float> value(-1.f, 1.f);
+  std::vector<float> vec(vec_size);
+  for (size_t i = 0; i < num_keys; i++) {
+    const long long key = static_cast<long long>(i);
+    key_stream.write(reinterpret_cast<const char*>(&key), sizeof(long long));
+    for (auto& v : vec) {
+      v = value(generator);
+    }
+    vec_stream.write(reinterpret_cast<const char*>(vec.data()), vec_size * sizeof(float));
+  }
+}
+
+void report_latencies(const char* name, std::vector<double>& latencies_us, size_t keys_per_batch,
+                      double elapsed_s) {
+  if (latencies_us.empty()) {
+    return;
+  }
+  std::sort(latencies_us.begin(), latencies_us.end());
+  auto percentile = [&](double p) {
+    return latencies_us[std::min(latencies_us.size() - 1,
+                                 static_cast<size_t>(p * latencies_us.size()))];
+  };
+  const double throughput = latencies_us.size() * keys_per_batch / elapsed_s;
+  std::printf("%s: %zu batches, %.0f keys/s\n", name, latencies_us.size(), throughput);
+  std::printf("  latency p50 %.1f us, p90 %.1f us, p99 %.1f us, max %.1f us\n", percentile(0.5),
+              percentile(0.9), percentile(0.99), latencies_us.back());
+}
+
+int run_benchmark(const BenchmarkConfig& config) {
+  const std::string model_name = "hps_benchmark";
+  const std::string base_dir = std::filesystem::temp_directory_path() /
+                               ("hps_benchmark_" + std::to_string(::getpid()));
+
+  std::vector<std::string> sparse_model_files;
+  std::vector<std::string> table_names;
+  for (size_t i = 0; i < config.num_tables; i++) {
+    const std::string model_dir = base_dir + "/sparse" + std::to_string(i);
+    generate_sparse_model(model_dir, config.num_keys_per_table, config.embedding_vec_size,
+                          config.seed + i);
+    sparse_model_files.push_back(model_dir);
+    table_names.push_back("table" + std::to_string(i));
+  }
+
+  VolatileDatabaseParams volatile_db;
+  volatile_db.type = DatabaseType_t::ParallelHashMap;
+  PersistentDatabaseParams persistent_db;
+  UpdateSourceParams update_source;
+
+  InferenceParams inference_params(
+      model_name, config.batch_size, config.hit_rate_threshold, "", sparse_model_files, 0, true,
+      config.cache_size_percentage, true, false, 1.0, true, true, 1, 1, 16, 0.1f, {0},
+      std::vector<float>(config.num_tables, 0.0f), volatile_db, persistent_db, update_source);
+  inference_params.maxnum_catfeature_query_per_table_per_sample.assign(config.num_tables,
+                                                                       config.feature_num);
+  inference_params.embedding_vecsize_per_table.assign(config.num_tables,
+                                                      config.embedding_vec_size);
+  inference_params.embedding_table_names = table_names;
+
+  std::map<std::string, std::vector<std::string>> emb_table_name{{model_name, table_names}};
+  std::map<std::string, std::vector<size_t>> embedding_vec_size{
+      {model_name, std::vector<size_t>(config.num_tables, config.embedding_vec_size)}};
+  std::map<std::string, std::vector<size_t>> max_feature_num{
+      {model_name, std::vector<size_t>(config.num_tables, config.feature_num)}};
+  std::vector<InferenceParams> inference_params_array{inference_params};
+  parameter_server_config ps_config{emb_table_name,          embedding_vec_size, max_feature_num,
+                                    inference_params_array,  volatile_db,        persistent_db,
+                                    update_source};
+  std::shared_ptr<HierParameterServerBase> parameter_server =
+      HierParameterServerBase::create(ps_config, inference_params_array);
+  auto embedding_cache = parameter_server->get_embedding_cache(model_name, 0);
+  // Drain the initial lookup statistics so that the report only covers the benchmark itself.
+  embedding_cache->get_and_reset_lookup_stats();
+
+  const size_t keys_per_batch_per_table = config.batch_size * config.feature_num;
+  std::atomic<bool> stop_updates{false};
+  std::thread update_thread;
+  if (config.refresh_interval_ms > 0) {
+    // Emulates the effect of a steady real-time update stream: each refresh round replays a slice
+    // of the model through the cache-refresh path that applied updates also take.
+    update_thread = std::thread([&]() {
+      const std::chrono::milliseconds interval(config.refresh_interval_ms);
+      while (!stop_updates) {
+        std::this_thread::sleep_for(interval);
+        if (stop_updates) {
+          break;
+        }
+        parameter_server->refresh_embedding_cache(model_name, 0);
+      }
+    });
+  }
+
+  std::vector<std::vector<double>> latencies_per_thread(config.num_threads);
+  const auto bench_start = std::chrono::steady_clock::now();
+  std::vector<std::thread> lookup_threads;
+  for (size_t t = 0; t < config.num_threads; t++) {
+    lookup_threads.emplace_back([&, t]() {
+      ZipfSampler sampler(config.num_keys_per_table, config.zipf_alpha,
+                          config.seed + static_cast<unsigned>(t) * 7919);
+      std::vector<long long> h_keys(keys_per_batch_per_table);
+      std::vector<float> h_vectors(keys_per_batch_per_table * config.embedding_vec_size);
+      float* d_vectors = nullptr;
+      cudaStream_t stream = nullptr;
+      if (config.use_gpu_cache_lookup) {
+        HCTR_LIB_THROW(cudaMalloc(&d_vectors, h_vectors.size() * sizeof(float)));
+        HCTR_LIB_THROW(cudaStreamCreate(&stream));
+      }
+      auto& latencies = latencies_per_thread[t];
+      latencies.reserve(config.iterations);
+      for (size_t iter = 0; iter < config.iterations; iter++) {
+        for (auto& key : h_keys) {
+          key = sampler();
+        }
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t table_id = 0; table_id < config.num_tables; table_id++) {
+          if (config.use_gpu_cache_lookup) {
+            embedding_cache->lookup(table_id, d_vectors, h_keys.data(), h_keys.size(),
+                                    config.hit_rate_threshold, stream);
+            HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+          } else {
+            parameter_server->lookup(h_keys.data(), h_keys.size(), h_vectors.data(), model_name,
+                                     table_id);
+          }
+        }
+        const auto end = std::chrono::steady_clock::now();
+        latencies.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+      }
+      if (config.use_gpu_cache_lookup) {
+        HCTR_LIB_THROW(cudaStreamDestroy(stream));
+        HCTR_LIB_THROW(cudaFree(d_vectors));
+      }
+    });
+  }
+  for (auto& thread : lookup_threads) {
+    thread.join();
+  }
+  const double elapsed_s =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - bench_start).count();
+  stop_updates = true;
+  if (update_thread.joinable()) {
+    update_thread.join();
+  }
+
+  std::vector<double> latencies_us;
+  for (auto& thread_latencies : latencies_per_thread) {
+    latencies_us.insert(latencies_us.end(), thread_latencies.begin(), thread_latencies.end());
+  }
+  std::printf("tables %zu, keys/table %zu, vec size %zu, batch %zu x %zu keys, zipf %.2f\n",
+              config.num_tables, config.num_keys_per_table, config.embedding_vec_size,
+              config.batch_size, config.feature_num, config.zipf_alpha);
+  report_latencies(config.use_gpu_cache_lookup ? "gpu cache lookup" : "parameter server lookup",
+                   latencies_us, keys_per_batch_per_table * config.num_tables, elapsed_s);
+  const auto [unique_queries, misses] = embedding_cache->get_and_reset_lookup_stats();
+  if (unique_queries > 0) {
+    std::printf("gpu cache tier: %zu unique queries, %zu misses, hit rate %.3f\n", unique_queries,
+                misses, 1.0 - static_cast<double>(misses) / unique_queries);
+  }
+
+  std::filesystem::remove_all(base_dir);
+  return 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  BenchmarkConfig config;
+  if (!parse_args(argc, argv, config)) {
+    return 1;
+  }
+  return run_benchmark(config);
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2021, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <hps/key_compactor.hpp>
+#include <unordered_set>
+
+using namespace HugeCTR;
+namespace {
+
+TEST(key_compactor, small_keys_keep_their_value) {
+  for (uint64_t key : {0ULL, 1ULL, 42ULL, (1ULL << 32) - 1}) {
+    EXPECT_EQ(compact_key_32(key), static_cast<uint32_t>(key));
+  }
+}
+
+TEST(key_compactor, mapping_is_deterministic) {
+  const uint64_t key = (123ULL << 40) + 456;
+  EXPECT_EQ(compact_key_32(key), compact_key_32(key));
+}
+
+TEST(key_compactor, long_tail_spreads_without_collisions) {
+  // A strided tail above 2^32, as produced by hash-partitioned feature ids; the finalizer should
+  // keep a table-sized sample collision-free.
+  KeyCompactor32 compactor;
+  std::unordered_set<uint32_t> ids;
+  for (uint64_t i = 0; i < 100000; i++) {
+    ids.insert(compactor.add((1ULL << 32) + i * 2654435761ULL));
+  }
+  EXPECT_FALSE(compactor.has_collision());
+  EXPECT_EQ(ids.size(), 100000ul);
+}
+
+TEST(key_compactor, reports_the_colliding_pair) {
+  KeyCompactor32 compactor;
+  const uint64_t key = (7ULL << 33) + 11;
+  const uint32_t id = compactor.add(key);
+  compactor.add(id);  // the identity-mapped small key aliases the hashed one
+  ASSERT_TRUE(compactor.has_collision());
+  const auto [key_a, key_b] = compactor.collision_keys();
+  EXPECT_EQ(key_a, key);
+  EXPECT_EQ(key_b, static_cast<uint64_t>(id));
+}
+
+}  // namespace
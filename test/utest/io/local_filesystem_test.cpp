@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2021, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "HugeCTR/include/io/local_filesystem.hpp"
+
+#include <filesystem>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace HugeCTR;
+
+namespace {
+
+const std::string test_dir = "/tmp/local_fs_test";
+
+TEST(local_filesystem_test, write_read_roundtrip) {
+  const DataSourceParams data_source_params(DataSourceType_t::Local, "localhost", 9000);
+  auto fs = data_source_params.create_unique();
+
+  fs->create_dir(test_dir);
+  const std::string file = test_dir + "/roundtrip.bin";
+
+  std::vector<char> payload(1 << 20);
+  for (size_t i = 0; i < payload.size(); i++) {
+    payload[i] = static_cast<char>(i * 31);
+  }
+  EXPECT_EQ(fs->write(file, payload.data(), payload.size(), true),
+            static_cast<int>(payload.size()));
+  EXPECT_EQ(fs->get_file_size(file), payload.size());
+
+  std::vector<char> readback(payload.size());
+  EXPECT_EQ(fs->read(file, readback.data(), readback.size(), 0),
+            static_cast<int>(readback.size()));
+  EXPECT_EQ(readback, payload);
+
+  fs->delete_file(test_dir);
+}
+
+TEST(local_filesystem_test, async_block_reads) {
+  const DataSourceParams data_source_params(DataSourceType_t::Local, "localhost", 9000);
+  auto fs = data_source_params.create_unique();
+
+  fs->create_dir(test_dir);
+  const std::string file = test_dir + "/async.bin";
+
+  std::vector<char> payload(4 << 20);
+  for (size_t i = 0; i < payload.size(); i++) {
+    payload[i] = static_cast<char>(i * 131);
+  }
+  ASSERT_EQ(fs->write(file, payload.data(), payload.size(), true),
+            static_cast<int>(payload.size()));
+
+  // More blocks than the ring depth, so submission has to reap completions along the way.
+  const size_t block_size = 64 << 10;
+  std::vector<char> readback(payload.size());
+  size_t num_callbacks = 0;
+  for (size_t offset = 0; offset < payload.size(); offset += block_size) {
+    fs->read_async(file, readback.data() + offset, block_size, offset,
+                   [&num_callbacks, block_size](int bytes_read) {
+                     EXPECT_EQ(bytes_read, static_cast<int>(block_size));
+                     num_callbacks++;
+                   });
+  }
+  fs->wait_all();
+  EXPECT_EQ(num_callbacks, payload.size() / block_size);
+  EXPECT_EQ(readback, payload);
+
+  fs->delete_file(test_dir);
+}
+
+}  // namespace
@@ -303,6 +303,162 @@ void multi_head_attention_layer_test(size_t head_num, size_t batch_size, size_t
   }
 }
 
+template <typename T>
+void fused_attention_fprop_cpu(const T *q, const T *k, const T *v, T *out, float *prob, size_t h,
+                               size_t b, size_t m, size_t n, size_t d) {
+  float scale = 1.f / sqrtf(static_cast<float>(d));
+  for (size_t bh = 0; bh < h * b; bh++) {
+    for (size_t i = 0; i < m; i++) {
+      float *p_row = prob + bh * m * n + i * n;
+      const T *q_row = q + (bh * m + i) * d;
+      float max_score = -1e20f;
+      for (size_t j = 0; j < n; j++) {
+        float score = 0.f;
+        for (size_t t = 0; t < d; t++) {
+          score += static_cast<float>(q_row[t]) * static_cast<float>(k[(bh * n + j) * d + t]);
+        }
+        p_row[j] = score * scale;
+        max_score = std::max(max_score, p_row[j]);
+      }
+      float sum = 0.f;
+      for (size_t j = 0; j < n; j++) {
+        p_row[j] = expf(p_row[j] - max_score);
+        sum += p_row[j];
+      }
+      for (size_t j = 0; j < n; j++) {
+        p_row[j] /= sum;
+      }
+      for (size_t t = 0; t < d; t++) {
+        float acc = 0.f;
+        for (size_t j = 0; j < n; j++) {
+          acc += p_row[j] * static_cast<float>(v[(bh * n + j) * d + t]);
+        }
+        out[(bh * m + i) * d + t] = TypeConvert<T, float>::convert(acc);
+      }
+    }
+  }
+}
+
+template <typename T>
+void fused_attention_dgrad_cpu(const T *dout, const T *q, const T *k, const T *v,
+                               const float *prob, T *dq, T *dk, T *dv, size_t h, size_t b,
+                               size_t m, size_t n, size_t d) {
+  float scale = 1.f / sqrtf(static_cast<float>(d));
+  std::vector<float> dk_acc(h * b * n * d, 0.f);
+  std::vector<float> dv_acc(h * b * n * d, 0.f);
+  for (size_t bh = 0; bh < h * b; bh++) {
+    for (size_t i = 0; i < m; i++) {
+      const float *p_row = prob + bh * m * n + i * n;
+      const T *do_row = dout + (bh * m + i) * d;
+      std::vector<float> dp(n, 0.f);
+      float row_dot = 0.f;
+      for (size_t j = 0; j < n; j++) {
+        for (size_t t = 0; t < d; t++) {
+          dp[j] += static_cast<float>(do_row[t]) * static_cast<float>(v[(bh * n + j) * d + t]);
+        }
+        row_dot += p_row[j] * dp[j];
+      }
+      for (size_t t = 0; t < d; t++) {
+        float acc = 0.f;
+        for (size_t j = 0; j < n; j++) {
+          float ds = p_row[j] * (dp[j] - row_dot) * scale;
+          acc += ds * static_cast<float>(k[(bh * n + j) * d + t]);
+          dk_acc[(bh * n + j) * d + t] += ds * static_cast<float>(q[(bh * m + i) * d + t]);
+          dv_acc[(bh * n + j) * d + t] += p_row[j] * static_cast<float>(do_row[t]);
+        }
+        dq[(bh * m + i) * d + t] = TypeConvert<T, float>::convert(acc);
+      }
+    }
+  }
+  for (size_t idx = 0; idx < h * b * n * d; idx++) {
+    dk[idx] = TypeConvert<T, float>::convert(dk_acc[idx]);
+    dv[idx] = TypeConvert<T, float>::convert(dv_acc[idx]);
+  }
+}
+
+template <typename T>
+void fused_multi_head_attention_layer_test(size_t head_num, size_t batch_size, size_t from_seq_len,
+                                           size_t to_seq_len, size_t size_per_head,
+                                           bool use_mixed_precision = false) {
+  std::shared_ptr<GeneralBuffer2<CudaAllocator>> buff = GeneralBuffer2<CudaAllocator>::create();
+
+  size_t q_size = head_num * batch_size * from_seq_len * size_per_head;
+  size_t kv_size = head_num * batch_size * to_seq_len * size_per_head;
+  size_t out_size = q_size;
+
+  Tensors2<T> in_tensors;
+  Tensor2<T> in_tensor;
+  buff->reserve({head_num, batch_size, from_seq_len, size_per_head}, &in_tensor);
+  in_tensors.push_back(in_tensor);
+  buff->reserve({head_num, batch_size, to_seq_len, size_per_head}, &in_tensor);
+  in_tensors.push_back(in_tensor);
+  buff->reserve({head_num, batch_size, to_seq_len, size_per_head}, &in_tensor);
+  in_tensors.push_back(in_tensor);
+  Tensor2<T> out_tensor;
+
+  MultiHeadAttentionLayer<T> multi_head_attention_layer(
+      in_tensors, out_tensor, buff, test::get_default_gpu(), use_mixed_precision, false);
+  buff->allocate();
+
+  ASSERT_EQ(out_tensor.get_dimensions()[3], size_per_head);
+
+  std::vector<size_t> in_sizes = {q_size, kv_size, kv_size};
+  std::unique_ptr<T[]> h_q(new T[q_size]);
+  std::unique_ptr<T[]> h_k(new T[kv_size]);
+  std::unique_ptr<T[]> h_v(new T[kv_size]);
+  std::unique_ptr<T[]> h_out(new T[out_size]);
+  std::unique_ptr<T[]> h_cpu_out(new T[out_size]);
+  std::unique_ptr<float[]> h_prob(new float[head_num * batch_size * from_seq_len * to_seq_len]);
+
+  test::GaussianDataSimulator simulator(0.0f, 1.0f);
+  simulator.fill(h_q.get(), test::align_to_even(q_size));
+  simulator.fill(h_k.get(), test::align_to_even(kv_size));
+  simulator.fill(h_v.get(), test::align_to_even(kv_size));
+  HCTR_LIB_THROW(
+      cudaMemcpy(in_tensors[0].get_ptr(), h_q.get(), q_size * sizeof(T), cudaMemcpyHostToDevice));
+  HCTR_LIB_THROW(
+      cudaMemcpy(in_tensors[1].get_ptr(), h_k.get(), kv_size * sizeof(T), cudaMemcpyHostToDevice));
+  HCTR_LIB_THROW(
+      cudaMemcpy(in_tensors[2].get_ptr(), h_v.get(), kv_size * sizeof(T), cudaMemcpyHostToDevice));
+
+  HCTR_LIB_THROW(cudaDeviceSynchronize());
+  multi_head_attention_layer.fprop(true);
+  HCTR_LIB_THROW(cudaDeviceSynchronize());
+
+  HCTR_LIB_THROW(cudaMemcpy(h_out.get(), out_tensor.get_ptr(), out_tensor.get_size_in_bytes(),
+                            cudaMemcpyDeviceToHost));
+  fused_attention_fprop_cpu(h_q.get(), h_k.get(), h_v.get(), h_cpu_out.get(), h_prob.get(),
+                            head_num, batch_size, from_seq_len, to_seq_len, size_per_head);
+  ASSERT_TRUE(
+      test::compare_array_approx<T>(h_out.get(), h_cpu_out.get(), out_size, get_eps<T>(false)));
+
+  // device bprop
+  std::unique_ptr<T[]> h_dout(new T[out_size]);
+  simulator.fill(h_dout.get(), test::align_to_even(out_size));
+  HCTR_LIB_THROW(cudaMemcpy(out_tensor.get_ptr(), h_dout.get(), out_size * sizeof(T),
+                            cudaMemcpyHostToDevice));
+
+  HCTR_LIB_THROW(cudaDeviceSynchronize());
+  multi_head_attention_layer.bprop();
+  HCTR_LIB_THROW(cudaDeviceSynchronize());
+
+  std::unique_ptr<T[]> h_cpu_dq(new T[q_size]);
+  std::unique_ptr<T[]> h_cpu_dk(new T[kv_size]);
+  std::unique_ptr<T[]> h_cpu_dv(new T[kv_size]);
+  fused_attention_dgrad_cpu(h_dout.get(), h_q.get(), h_k.get(), h_v.get(), h_prob.get(),
+                            h_cpu_dq.get(), h_cpu_dk.get(), h_cpu_dv.get(), head_num, batch_size,
+                            from_seq_len, to_seq_len, size_per_head);
+
+  T *h_cpu_grads[3] = {h_cpu_dq.get(), h_cpu_dk.get(), h_cpu_dv.get()};
+  for (size_t i = 0; i < 3; i++) {
+    std::unique_ptr<T[]> h_grad(new T[in_sizes[i]]);
+    HCTR_LIB_THROW(cudaMemcpy(h_grad.get(), in_tensors[i].get_ptr(), in_sizes[i] * sizeof(T),
+                              cudaMemcpyDeviceToHost));
+    ASSERT_TRUE(test::compare_array_approx<T>(h_grad.get(), h_cpu_grads[i], in_sizes[i],
+                                              get_eps<T>(false)));
+  }
+}
+
 }  // namespace
 
 TEST(mha_layer, fp32_512x512) { multi_head_attention_layer_test<float>(4, 512, 400, 600, 128); }
@@ -319,3 +475,14 @@ TEST(mha_layer, fp16_512x479) {
   }
   multi_head_attention_layer_test<__half>(4, 512, 100, 200, 256, true, false);
 }
+
+TEST(mha_layer, fused_fp32_2x8) { fused_multi_head_attention_layer_test<float>(2, 8, 30, 20, 64); }
+
+TEST(mha_layer, fused_fp16_2x8) {
+  int major = 0;
+  cudaDeviceGetAttribute(&major, cudaDevAttrComputeCapabilityMajor, 0);
+  if (major < 7) {
+    GTEST_SKIP();
+  }
+  fused_multi_head_attention_layer_test<__half>(2, 8, 30, 20, 64, true);
+}
@@ -117,6 +117,63 @@ void relu_test(size_t dim0, size_t dim1) {
                                             Eps<T>::value()));
 }
 
+template <typename T>
+void relu_inplace_test(size_t dim0, size_t dim1) {
+  std::shared_ptr<GeneralBuffer2<CudaAllocator>> buf = GeneralBuffer2<CudaAllocator>::create();
+  std::vector<size_t> dims = {dim0, dim1};
+
+  Tensor2<T> bottom_tensor;
+  buf->reserve(dims, &bottom_tensor);
+  Tensor2<T> top_tensor = bottom_tensor;
+  Tensor2<unsigned int> mask_tensor;
+  buf->reserve({(dim0 * dim1 + 31) / 32}, &mask_tensor);
+
+  ReluLayer<T> relu_layer(bottom_tensor, top_tensor, mask_tensor, test::get_default_gpu());
+
+  buf->allocate();
+  relu_layer.initialize();
+
+  const size_t len = dim0 * dim1;
+
+  std::unique_ptr<T[]> h_bottom(new T[len]);
+  std::unique_ptr<T[]> h_top(new T[len]);
+  std::unique_ptr<T[]> d2h_top(new T[len]);
+  std::unique_ptr<T[]> h_bottom_grad(new T[len]);
+  std::unique_ptr<T[]> d2h_bottom_grad(new T[len]);
+
+  test::GaussianDataSimulator simulator(0.0f, 1.0f);
+  simulator.fill(h_bottom.get(), len);
+
+  // fprop
+
+  HCTR_LIB_THROW(
+      cudaMemcpy(bottom_tensor.get_ptr(), h_bottom.get(), len * sizeof(T), cudaMemcpyHostToDevice));
+  HCTR_LIB_THROW(cudaDeviceSynchronize());
+  relu_layer.fprop(true);
+  HCTR_LIB_THROW(cudaDeviceSynchronize());
+  HCTR_LIB_THROW(
+      cudaMemcpy(d2h_top.get(), top_tensor.get_ptr(), len * sizeof(T), cudaMemcpyDeviceToHost));
+
+  relu_cpu<T>(h_top.get(), h_bottom.get(), len);
+  ASSERT_TRUE(test::compare_array_approx<T>(d2h_top.get(), h_top.get(), len, Eps<T>::value()));
+
+  // bprop: the downstream layer overwrites the shared buffer with the top gradient before
+  // bprop runs, so the mask is the only record of the forward signs.
+  simulator.fill(h_top.get(), len);
+
+  HCTR_LIB_THROW(
+      cudaMemcpy(top_tensor.get_ptr(), h_top.get(), len * sizeof(T), cudaMemcpyHostToDevice));
+  HCTR_LIB_THROW(cudaDeviceSynchronize());
+  relu_layer.bprop();
+  HCTR_LIB_THROW(cudaDeviceSynchronize());
+  HCTR_LIB_THROW(cudaMemcpy(d2h_bottom_grad.get(), bottom_tensor.get_ptr(), len * sizeof(T),
+                            cudaMemcpyDeviceToHost));
+
+  relu_bprop_cpu<T>(h_bottom_grad.get(), h_top.get(), h_bottom.get(), len);
+  ASSERT_TRUE(test::compare_array_approx<T>(d2h_bottom_grad.get(), h_bottom_grad.get(), len,
+                                            Eps<T>::value()));
+}
+
 }  // namespace
 
 TEST(relu_layer, fp32_10x20) { relu_test<float>(10, 20); }
@@ -125,3 +182,7 @@ TEST(relu_layer, fp32_512x2048) { relu_test<float>(512, 1024 * 2); }
 TEST(relu_layer, fp16_10x20) { relu_test<__half>(10, 20); }
 TEST(relu_layer, fp16_10x500) { relu_test<__half>(10, 500); }
 TEST(relu_layer, fp16_512x2048) { relu_test<__half>(512, 1024 * 2); }
+TEST(relu_layer, fp32_inplace_10x20) { relu_inplace_test<float>(10, 20); }
+TEST(relu_layer, fp32_inplace_512x2048) { relu_inplace_test<float>(512, 1024 * 2); }
+TEST(relu_layer, fp16_inplace_10x20) { relu_inplace_test<__half>(10, 20); }
+TEST(relu_layer, fp16_inplace_512x2048) { relu_inplace_test<__half>(512, 1024 * 2); }
@@ -80,6 +80,26 @@ void reshape_2d_to_3d_test(size_t dim0, size_t leading_dim, size_t time_step) {
   }
 }
 
+template <typename T>
+void reshape_view_test(size_t dim0, size_t dim1, size_t leading_dim) {
+  std::shared_ptr<GeneralBuffer2<CudaAllocator>> buff = GeneralBuffer2<CudaAllocator>::create();
+  Tensor2<T> in_tensor;
+  buff->reserve({dim0, dim1}, &in_tensor);
+
+  Tensor2<T> out_tensor = in_tensor.reshape({dim0 * dim1 / leading_dim, leading_dim});
+  ReshapeLayer<T> reshape_layer(in_tensor, out_tensor, buff, test::get_default_gpu());
+
+  buff->allocate();
+  reshape_layer.initialize();
+
+  ASSERT_TRUE(out_tensor.allocated());
+  // The view shares the input buffer, so fprop and bprop are metadata-only.
+  ASSERT_EQ(in_tensor.get_ptr(), out_tensor.get_ptr());
+  reshape_layer.fprop(true);
+  reshape_layer.bprop();
+  HCTR_LIB_THROW(cudaDeviceSynchronize());
+}
+
 }  // namespace
 
 TEST(reshape_layer, fp32_32x320to8x1280) { reshape_2d_test<float>(8 * 4, 320, 4 * 320); }
@@ -107,4 +127,8 @@ TEST(reshape_layer, fp16_8x4x320to8x1280) { reshape_3d_test<__half>(8, 4, 320, 4
 
 TEST(reshape_layer, fp16_8x4x320to4x2560) { reshape_3d_test<__half>(8, 4, 320, 8 * 320); }
 
-TEST(reshape_layer, fp16_8x4x320to32x2560) { reshape_3d_test<__half>(8, 4, 320, 320); }
\ No newline at end of file
+TEST(reshape_layer, fp16_8x4x320to32x2560) { reshape_3d_test<__half>(8, 4, 320, 320); }
+
+TEST(reshape_layer, fp32_view_32x320to8x1280) { reshape_view_test<float>(8 * 4, 320, 4 * 320); }
+
+TEST(reshape_layer, fp16_view_32x320to8x1280) { reshape_view_test<__half>(8 * 4, 320, 4 * 320); }
\ No newline at end of file
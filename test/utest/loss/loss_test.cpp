@@ -185,3 +185,82 @@ void binary_cross_entropy_loss(size_t batch_size) {
 
 TEST(loss_test, BinaryCrossEntropyLoss_2048) { binary_cross_entropy_loss(2048); }
 TEST(loss_test, BinaryCrossEntropyLoss_64) { binary_cross_entropy_loss(64); }
+
+void fused_binary_cross_entropy_loss(size_t batch_size, int num_heads) {
+  std::shared_ptr<GeneralBuffer2<CudaAllocator>> buff = GeneralBuffer2<CudaAllocator>::create();
+
+  std::vector<Tensor2<float>> input_tensors(num_heads);
+  std::vector<Tensor2<float>> label_tensors(num_heads);
+  std::vector<Tensor2<float>> loss_tensors(num_heads);
+  std::vector<std::unique_ptr<BinaryCrossEntropyLoss<float>>> losses;
+
+  std::shared_ptr<BufferBlock2<float>> weight_buff = buff->create_block<float>();
+  std::shared_ptr<BufferBlock2<float>> wgrad_buff = buff->create_block<float>();
+  std::shared_ptr<NoRegularizer<float>> no_regularizer(new NoRegularizer<float>(
+      weight_buff->as_tensor(), wgrad_buff->as_tensor(), batch_size, test::get_default_gpu()));
+
+  for (int h = 0; h < num_heads; ++h) {
+    buff->reserve({batch_size, 1}, &input_tensors[h]);
+    buff->reserve({batch_size, 1}, &label_tensors[h]);
+    buff->reserve({1, 1}, &loss_tensors[h]);
+    losses.emplace_back(new BinaryCrossEntropyLoss<float>(label_tensors[h], input_tensors[h],
+                                                          loss_tensors[h], no_regularizer,
+                                                          test::get_default_gpu(), 1));
+    losses.back()->set_label_weight(1.0);
+  }
+
+  buff->allocate();
+
+  srand(time(NULL));
+  std::vector<std::unique_ptr<float[]>> h_inputs;
+  std::vector<std::unique_ptr<float[]>> h_labels;
+  for (int h = 0; h < num_heads; ++h) {
+    h_inputs.emplace_back(new float[batch_size]);
+    h_labels.emplace_back(new float[batch_size]);
+    for (size_t i = 0; i < batch_size; ++i) h_inputs[h][i] = rand() % 100 * 0.01f;
+    for (size_t i = 0; i < batch_size; ++i) h_labels[h][i] = rand() % 2;
+    HCTR_LIB_THROW(cudaMemcpy(input_tensors[h].get_ptr(), h_inputs[h].get(),
+                              sizeof(float) * batch_size, cudaMemcpyHostToDevice));
+    HCTR_LIB_THROW(cudaMemcpy(label_tensors[h].get_ptr(), h_labels[h].get(),
+                              sizeof(float) * batch_size, cudaMemcpyHostToDevice));
+  }
+
+  std::vector<FusedBCEHead<float>> heads;
+  for (auto &loss : losses) {
+    heads.push_back(loss->get_fused_head(true));
+  }
+  fused_bce_compute(heads, batch_size, 1.f, 1, 0.f, true,
+                    test::get_default_gpu()->get_stream());
+  HCTR_LIB_THROW(cudaDeviceSynchronize());
+
+  int scaler = 1;
+#ifdef SCALE_128
+  scaler = 128;
+#elif SCALE_256
+  scaler = 256;
+#elif SCALE_512
+  scaler = 512;
+#elif SCALE_1024
+  scaler = 1024;
+#endif
+  // Every head must match the reference, exactly as the per-head launches would.
+  for (int h = 0; h < num_heads; ++h) {
+    float cpu_loss = 0.0f;
+    for (size_t i = 0; i < batch_size; ++i) {
+      float x = h_inputs[h][i];
+      float val = 1 / (1 + exp(-x));
+      float y = h_labels[h][i];
+      h_inputs[h][i] = -1 * val * (y - val) * exp(-x) / (1 - val) / batch_size * scaler;
+      cpu_loss += y * log(val) + (1 - y) * log(1 - val);
+    }
+    cpu_loss = -cpu_loss / batch_size;
+
+    ASSERT_EQ(true, cpu_gpu_cmp(&cpu_loss, loss_tensors[h].get_ptr(), 1))
+        << " Fused BCE loss calculation failed at head " << h << std::endl;
+    ASSERT_EQ(true, cpu_gpu_cmp(h_inputs[h].get(), input_tensors[h].get_ptr(), batch_size))
+        << " Fused BCE gradient calculation failed at head " << h << std::endl;
+  }
+}
+
+TEST(loss_test, FusedBinaryCrossEntropyLoss_2048x3) { fused_binary_cross_entropy_loss(2048, 3); }
+TEST(loss_test, FusedBinaryCrossEntropyLoss_64x8) { fused_binary_cross_entropy_loss(64, 8); }
@@ -15,6 +15,7 @@
  */
 
 #include <cstdio>
+#include <cstdlib>
 #include <fstream>
 #include <functional>
 #include <sstream>
@@ -188,7 +189,8 @@ static int execution_number = 0;
 
 template <typename T, typename Generator>
 void metric_test(std::vector<int> device_list, size_t batch_size, size_t num_total_samples,
-                 Generator gen, bool auc, size_t num_evals = 1, size_t num_classes = 1) {
+                 Generator gen, bool auc, size_t num_evals = 1, size_t num_classes = 1,
+                 float error_margin_override = 0.0f) {
   int num_procs = 1, rank = 0;
 #ifdef ENABLE_MPI
   HCTR_MPI_THROW(MPI_Comm_rank(MPI_COMM_WORLD, &rank));
@@ -287,7 +289,9 @@ void metric_test(std::vector<int> device_list, size_t batch_size, size_t num_tot
   float ref_result = sklearn_ref(num_total_samples, num_classes, h_labels, h_scores, auc);
   // HCTR_LOG(INFO, WORLD, "GPU %f, ref %f \n", gpu_result, ref_result);
 
-  float error_margin = auc ? eps : 10 * eps;  // Use a larger margin of error for NDCG
+  // Use a larger margin of error for NDCG
+  float error_margin =
+      error_margin_override > 0.0f ? error_margin_override : (auc ? eps : 10 * eps);
   ASSERT_NEAR(gpu_result, ref_result, error_margin);
 }
 
@@ -329,6 +333,19 @@ TEST(auc_test, fp32_8gpu_wrong) {
 // TEST(auc_test, fp32_8gpu_large)      { metric_test<float>({0,1,2,3,4,5,6,7}, 131072, 89137319,
 // gen_random<float>, 1, 2); }
 
+TEST(auc_test, fp32_1gpu_sketch) {
+  // The histogram sketch approximates the AUC within the bin width
+  setenv("HCTR_AUC_SKETCH_BINS", "10000", 1);
+  metric_test<float>({0}, 10, 2000, gen_random<float>, 1, 1, 1, 1.0e-3);
+  unsetenv("HCTR_AUC_SKETCH_BINS");
+}
+
+TEST(auc_test, fp32_2gpu_sketch) {
+  setenv("HCTR_AUC_SKETCH_BINS", "10000", 1);
+  metric_test<float>({0, 1}, 10, 2440, gen_random<float>, 1, 1, 1, 1.0e-3);
+  unsetenv("HCTR_AUC_SKETCH_BINS");
+}
+
 TEST(auc_test, fp16_1gpu) { metric_test<__half>({0}, 15, 200, gen_random<__half>, 1); }
 TEST(auc_test, fp16_1gpu_odd) { metric_test<__half>({0}, 11, 182, gen_random<__half>, 1); }
 TEST(auc_test, fp16_2gpu) { metric_test<__half>({0, 1}, 10, 540, gen_random<__half>, 1); }
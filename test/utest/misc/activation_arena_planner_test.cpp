@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "HugeCTR/include/activation_arena_planner.hpp"
+#include "HugeCTR/include/general_buffer2.hpp"
+
+using namespace HugeCTR;
+
+namespace {
+
+// 4 x 8 floats = 128 bytes, already a multiple of the 32 byte arena alignment
+constexpr size_t kTensorBytes = 4 * 8 * sizeof(float);
+
+std::vector<TensorBag2> make_chain(const std::shared_ptr<GeneralBuffer2<HostAllocator>>& buff,
+                                   size_t count) {
+  std::vector<TensorBag2> bags;
+  for (size_t i = 0; i < count; i++) {
+    Tensor2<float> tensor;
+    buff->reserve({4, 8}, &tensor);
+    bags.push_back(tensor.shrink());
+  }
+  return bags;
+}
+
+}  // namespace
+
+TEST(activation_arena_planner, chain_reuses_dead_activations) {
+  auto buff = GeneralBuffer2<HostAllocator>::create();
+  // a -> layer0 -> b -> layer1 -> c -> layer2 -> d
+  auto bags = make_chain(buff, 4);
+
+  ActivationArenaPlanner planner;
+  planner.add_layer({bags[0]}, {bags[1]});
+  planner.add_layer({bags[1]}, {bags[2]});
+  planner.add_layer({bags[2]}, {bags[3]});
+
+  std::map<TensorBuffer2*, size_t> offsets;
+  size_t arena_size = planner.plan(&offsets);
+
+  ASSERT_EQ(offsets.size(), 4ul);
+  // a dies after layer 0 and c is born at layer 1, so they can share; b overlaps both
+  EXPECT_EQ(offsets.at(bags[0].get_buffer().get()), offsets.at(bags[2].get_buffer().get()));
+  EXPECT_NE(offsets.at(bags[0].get_buffer().get()), offsets.at(bags[1].get_buffer().get()));
+  EXPECT_NE(offsets.at(bags[1].get_buffer().get()), offsets.at(bags[2].get_buffer().get()));
+  EXPECT_EQ(arena_size, 2 * kTensorBytes);
+  EXPECT_EQ(planner.get_total_size_in_bytes(), 4 * kTensorBytes);
+}
+
+TEST(activation_arena_planner, pinned_tensor_keeps_dedicated_allocation) {
+  auto buff = GeneralBuffer2<HostAllocator>::create();
+  auto bags = make_chain(buff, 3);
+
+  ActivationArenaPlanner planner;
+  planner.add_layer({bags[0]}, {bags[1]});
+  planner.add_layer({bags[1]}, {bags[2]});
+  planner.pin(bags[2]);
+
+  std::map<TensorBuffer2*, size_t> offsets;
+  planner.plan(&offsets);
+
+  EXPECT_EQ(offsets.size(), 2ul);
+  EXPECT_EQ(offsets.count(bags[2].get_buffer().get()), 0ul);
+}
+
+TEST(activation_arena_planner, general_buffer_honors_arena_offsets) {
+  auto buff = GeneralBuffer2<HostAllocator>::create();
+  auto bags = make_chain(buff, 4);
+
+  ActivationArenaPlanner planner;
+  planner.add_layer({bags[0]}, {bags[1]});
+  planner.add_layer({bags[1]}, {bags[2]});
+  planner.add_layer({bags[2]}, {bags[3]});
+  planner.pin(bags[3]);
+
+  std::map<TensorBuffer2*, size_t> offsets;
+  size_t arena_size = planner.plan(&offsets);
+  buff->set_overlapped_offsets(offsets, arena_size);
+  buff->allocate();
+
+  // the pinned tensor is packed sequentially, the rest live in the arena behind it
+  EXPECT_EQ(buff->get_size_in_bytes(), kTensorBytes + arena_size);
+  EXPECT_EQ(bags[0].get_ptr(), bags[2].get_ptr());
+  EXPECT_NE(bags[0].get_ptr(), bags[1].get_ptr());
+  EXPECT_NE(bags[1].get_ptr(), bags[3].get_ptr());
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2021, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <pipeline.hpp>
+
+using namespace HugeCTR;
+
+namespace {
+
+// Stable keys standing in for tensor buffer addresses.
+char buf_w, buf_x, buf_y, buf_z;
+const void* w = &buf_w;
+const void* x = &buf_x;
+const void* y = &buf_y;
+const void* z = &buf_z;
+
+}  // namespace
+
+TEST(pipeline_schedule_test, diamond_transitive_reduction) {
+  // A writes x; B and C both read x; D consumes both results. The direct A->D edge
+  // (D reads what A wrote via y and z only, but add w to force it) must be dropped
+  // because it is implied by A->B->D and A->C->D.
+  std::vector<std::vector<const void*>> reads = {{}, {x}, {x}, {y, z, x}};
+  std::vector<std::vector<const void*>> writes = {{x}, {y}, {z}, {w}};
+
+  InferredSchedule schedule = infer_schedule(reads, writes);
+
+  ASSERT_EQ(schedule.stream_id.size(), 4ul);
+  // B continues A's chain on the same stream; C branches off to another stream.
+  EXPECT_EQ(schedule.stream_id[1], schedule.stream_id[0]);
+  EXPECT_NE(schedule.stream_id[2], schedule.stream_id[0]);
+
+  EXPECT_EQ(schedule.wait_on[1], std::vector<size_t>({0}));
+  EXPECT_EQ(schedule.wait_on[2], std::vector<size_t>({0}));
+  // The A->D edge is transitively implied, so D only waits on B and C.
+  EXPECT_EQ(schedule.wait_on[3], std::vector<size_t>({1, 2}));
+}
+
+TEST(pipeline_schedule_test, war_hazard_serializes) {
+  // A only reads x; B overwrites x. B must still be ordered after A.
+  std::vector<std::vector<const void*>> reads = {{x}, {}};
+  std::vector<std::vector<const void*>> writes = {{y}, {x}};
+
+  InferredSchedule schedule = infer_schedule(reads, writes);
+
+  EXPECT_EQ(schedule.wait_on[1], std::vector<size_t>({0}));
+  EXPECT_EQ(schedule.stream_id[1], schedule.stream_id[0]);
+}
+
+TEST(pipeline_schedule_test, independent_chains_spread_over_streams) {
+  std::vector<std::vector<const void*>> reads = {{}, {x}, {}, {y}};
+  std::vector<std::vector<const void*>> writes = {{x}, {z}, {y}, {w}};
+
+  InferredSchedule schedule = infer_schedule(reads, writes);
+
+  EXPECT_EQ(schedule.stream_id[1], schedule.stream_id[0]);
+  EXPECT_EQ(schedule.stream_id[3], schedule.stream_id[2]);
+  EXPECT_NE(schedule.stream_id[2], schedule.stream_id[0]);
+  EXPECT_TRUE(schedule.wait_on[1].size() == 1 && schedule.wait_on[3].size() == 1);
+}
+
+TEST(pipeline_schedule_test, single_stream_keeps_program_order) {
+  std::vector<std::vector<const void*>> reads = {{}, {}, {x}};
+  std::vector<std::vector<const void*>> writes = {{x}, {y}, {z}};
+
+  InferredSchedule schedule = infer_schedule(reads, writes, 1);
+
+  for (int id : schedule.stream_id) {
+    EXPECT_EQ(id, 0);
+  }
+}
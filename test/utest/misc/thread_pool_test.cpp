@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2021, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <set>
+#include <thread>
+#include <thread_pool.hpp>
+#include <vector>
+
+using namespace HugeCTR;
+
+TEST(thread_pool_test, submit_and_await) {
+  ThreadPool pool("test", 4);
+  std::atomic<int> counter{0};
+
+  std::vector<std::future<void>> results;
+  for (int i = 0; i < 256; i++) {
+    results.push_back(pool.submit([&counter] { counter++; }));
+  }
+  ThreadPool::await(results.begin(), results.end());
+  EXPECT_EQ(counter.load(), 256);
+
+  pool.await_idle();
+  EXPECT_TRUE(pool.idle());
+}
+
+TEST(thread_pool_test, affinity_restricts_workers) {
+  ThreadPool pool("test", 4);
+
+  // Pin the pool workers' identities down once: every task records the executing thread and
+  // the tasks pinned to workers {0, 1} must only ever run on two distinct threads.
+  std::mutex mutex;
+  std::set<std::thread::id> affine_threads;
+  std::vector<std::future<void>> results;
+  for (int i = 0; i < 64; i++) {
+    results.push_back(pool.submit(
+        [&] {
+          std::lock_guard<std::mutex> lock(mutex);
+          affine_threads.insert(std::this_thread::get_id());
+        },
+        {0, 1}));
+  }
+  ThreadPool::await(results.begin(), results.end());
+  EXPECT_LE(affine_threads.size(), 2u);
+}
+
+TEST(thread_pool_test, affinity_out_of_range_throws) {
+  ThreadPool pool("test", 2);
+  EXPECT_THROW(pool.submit([] {}, {7}), std::exception);
+}
+
+TEST(thread_pool_test, concurrent_submitters) {
+  ThreadPool pool("test", 4);
+  std::atomic<int> counter{0};
+
+  std::vector<std::thread> submitters;
+  for (int t = 0; t < 4; t++) {
+    submitters.emplace_back([&] {
+      std::vector<std::future<void>> results;
+      for (int i = 0; i < 128; i++) {
+        results.push_back(pool.submit([&counter] { counter++; }));
+      }
+      ThreadPool::await(results.begin(), results.end());
+    });
+  }
+  for (auto& submitter : submitters) {
+    submitter.join();
+  }
+  EXPECT_EQ(counter.load(), 4 * 128);
+}
@@ -0,0 +1,285 @@
+"""
+Self-contained training benchmark over synthetic data.
+
+Generates a synthetic dataset with hugectr.tools.DataGenerator, trains one of the
+reference workloads (DLRM / DCN / WDL) for a fixed number of iterations and emits a
+regression-comparable JSON record. With HCTR_PROFILE_PIPELINE set, the per-stage
+step-time breakdown reported by Model.get_pipeline_profile() is embedded in the record.
+
+Presets:
+  1gpu       single GPU
+  8gpu       one node, eight GPUs
+  multinode  two nodes x eight GPUs; launch under mpirun -np 2
+
+Examples:
+  python run_benchmark.py --workload dlrm --preset 1gpu --output dlrm_1gpu.json
+  python run_benchmark.py --workload dcn --preset 8gpu --baseline old/dcn_8gpu.json
+  mpirun -np 2 python run_benchmark.py --workload dlrm --preset multinode
+"""
+
+import argparse
+import json
+import os
+import socket
+import sys
+import time
+
+import hugectr
+from hugectr.tools import DataGenerator, DataGeneratorParams
+from mpi4py import MPI
+
+PRESETS = {
+    "1gpu": {"vvgpu": [[0]], "batchsize": 2048},
+    "8gpu": {"vvgpu": [[0, 1, 2, 3, 4, 5, 6, 7]], "batchsize": 16384},
+    "multinode": {
+        "vvgpu": [[0, 1, 2, 3, 4, 5, 6, 7], [0, 1, 2, 3, 4, 5, 6, 7]],
+        "batchsize": 32768,
+    },
+}
+
+CRITEO_SLOT_SIZES = [
+    39884, 39043, 17289, 7420, 20263, 3, 7120, 1543, 63, 38532,
+    2953546, 403346, 10, 2208, 11938, 155, 4, 976, 14, 39979,
+    25641295, 39664984, 585935, 12972, 108, 36,
+]
+
+
+def generator_params(workload, workdir):
+    if workload == "dlrm":
+        return DataGeneratorParams(
+            format=hugectr.DataReaderType_t.Raw,
+            label_dim=1,
+            dense_dim=13,
+            num_slot=26,
+            i64_input_key=False,
+            source=os.path.join(workdir, "dlrm_raw/train_data.bin"),
+            eval_source=os.path.join(workdir, "dlrm_raw/test_data.bin"),
+            slot_size_array=[min(s, 40000) for s in CRITEO_SLOT_SIZES],
+            nnz_array=[1] * 26,
+        )
+    # WDL has one extra slot holding the crossed wide features.
+    slot_sizes = [min(s, 40000) for s in CRITEO_SLOT_SIZES]
+    if workload == "wdl":
+        slot_sizes.append(40000)
+    return DataGeneratorParams(
+        format=hugectr.DataReaderType_t.Norm,
+        label_dim=1,
+        dense_dim=13,
+        num_slot=len(slot_sizes),
+        i64_input_key=False,
+        source=os.path.join(workdir, "%s_norm/file_list.txt" % workload),
+        eval_source=os.path.join(workdir, "%s_norm/file_list_test.txt" % workload),
+        slot_size_array=slot_sizes,
+        check_type=hugectr.Check_t.Sum,
+        dist_type=hugectr.Distribution_t.PowerLaw,
+        power_law_type=hugectr.PowerLaw_t.Short,
+    )
+
+
+def make_solver(preset, args):
+    return hugectr.CreateSolver(
+        max_eval_batches=64,
+        batchsize_eval=preset["batchsize"],
+        batchsize=args.batchsize or preset["batchsize"],
+        lr=0.001,
+        vvgpu=preset["vvgpu"],
+        repeat_dataset=True,
+        use_mixed_precision=args.mixed_precision,
+        scaler=1024 if args.mixed_precision else 1,
+    )
+
+
+def make_reader(gen_params):
+    kwargs = dict(
+        data_reader_type=gen_params.format,
+        source=[gen_params.source],
+        eval_source=gen_params.eval_source,
+        check_type=gen_params.check_type,
+    )
+    if gen_params.format == hugectr.DataReaderType_t.Raw:
+        kwargs["num_samples"] = gen_params.num_samples
+        kwargs["eval_num_samples"] = gen_params.eval_num_samples
+    return hugectr.DataReaderParams(**kwargs)
+
+
+def add_mlp(model, bottom, prefix, widths):
+    for i, width in enumerate(widths):
+        fc = "%s_fc%d" % (prefix, i + 1)
+        relu = "%s_relu%d" % (prefix, i + 1)
+        model.add(hugectr.DenseLayer(layer_type=hugectr.Layer_t.InnerProduct,
+                                     bottom_names=[bottom], top_names=[fc], num_output=width))
+        model.add(hugectr.DenseLayer(layer_type=hugectr.Layer_t.ReLU,
+                                     bottom_names=[fc], top_names=[relu]))
+        bottom = relu
+    return bottom
+
+
+def build_dlrm(model, gen_params, optimizer):
+    model.add(hugectr.Input(
+        label_dim=1, label_name="label", dense_dim=13, dense_name="dense",
+        data_reader_sparse_param_array=[
+            hugectr.DataReaderSparseParam("data1", 1, True, gen_params.num_slot)]))
+    model.add(hugectr.SparseEmbedding(
+        embedding_type=hugectr.Embedding_t.DistributedSlotSparseEmbeddingHash,
+        workspace_size_per_gpu_in_mb=2048, embedding_vec_size=128, combiner="sum",
+        sparse_embedding_name="sparse_embedding1", bottom_name="data1", optimizer=optimizer))
+    bottom = add_mlp(model, "dense", "bot", [512, 256, 128])
+    model.add(hugectr.DenseLayer(layer_type=hugectr.Layer_t.Interaction,
+                                 bottom_names=[bottom, "sparse_embedding1"],
+                                 top_names=["interaction1"]))
+    top = add_mlp(model, "interaction1", "top", [1024, 1024, 512, 256])
+    model.add(hugectr.DenseLayer(layer_type=hugectr.Layer_t.InnerProduct,
+                                 bottom_names=[top], top_names=["out"], num_output=1))
+    model.add(hugectr.DenseLayer(layer_type=hugectr.Layer_t.BinaryCrossEntropyLoss,
+                                 bottom_names=["out", "label"], top_names=["loss"]))
+
+
+def build_dcn(model, gen_params, optimizer):
+    model.add(hugectr.Input(
+        label_dim=1, label_name="label", dense_dim=13, dense_name="dense",
+        data_reader_sparse_param_array=[
+            hugectr.DataReaderSparseParam("data1", 1, True, gen_params.num_slot)]))
+    model.add(hugectr.SparseEmbedding(
+        embedding_type=hugectr.Embedding_t.DistributedSlotSparseEmbeddingHash,
+        workspace_size_per_gpu_in_mb=256, embedding_vec_size=16, combiner="sum",
+        sparse_embedding_name="sparse_embedding1", bottom_name="data1", optimizer=optimizer))
+    model.add(hugectr.DenseLayer(layer_type=hugectr.Layer_t.Reshape,
+                                 bottom_names=["sparse_embedding1"], top_names=["reshape1"],
+                                 leading_dim=416))
+    model.add(hugectr.DenseLayer(layer_type=hugectr.Layer_t.Concat,
+                                 bottom_names=["reshape1", "dense"], top_names=["concat1"]))
+    model.add(hugectr.DenseLayer(layer_type=hugectr.Layer_t.Slice,
+                                 bottom_names=["concat1"], top_names=["slice11", "slice12"],
+                                 ranges=[(0, 429), (0, 429)]))
+    model.add(hugectr.DenseLayer(layer_type=hugectr.Layer_t.MultiCross,
+                                 bottom_names=["slice11"], top_names=["multicross1"],
+                                 num_layers=6))
+    deep = add_mlp(model, "slice12", "deep", [1024, 1024])
+    model.add(hugectr.DenseLayer(layer_type=hugectr.Layer_t.Concat,
+                                 bottom_names=[deep, "multicross1"], top_names=["concat2"]))
+    model.add(hugectr.DenseLayer(layer_type=hugectr.Layer_t.InnerProduct,
+                                 bottom_names=["concat2"], top_names=["out"], num_output=1))
+    model.add(hugectr.DenseLayer(layer_type=hugectr.Layer_t.BinaryCrossEntropyLoss,
+                                 bottom_names=["out", "label"], top_names=["loss"]))
+
+
+def build_wdl(model, gen_params, optimizer):
+    model.add(hugectr.Input(
+        label_dim=1, label_name="label", dense_dim=13, dense_name="dense",
+        data_reader_sparse_param_array=[
+            hugectr.DataReaderSparseParam("wide_data", 1, True, 1),
+            hugectr.DataReaderSparseParam("deep_data", 1, True, 26)]))
+    model.add(hugectr.SparseEmbedding(
+        embedding_type=hugectr.Embedding_t.DistributedSlotSparseEmbeddingHash,
+        workspace_size_per_gpu_in_mb=16, embedding_vec_size=1, combiner="sum",
+        sparse_embedding_name="sparse_embedding2", bottom_name="wide_data",
+        optimizer=optimizer))
+    model.add(hugectr.SparseEmbedding(
+        embedding_type=hugectr.Embedding_t.DistributedSlotSparseEmbeddingHash,
+        workspace_size_per_gpu_in_mb=256, embedding_vec_size=16, combiner="sum",
+        sparse_embedding_name="sparse_embedding1", bottom_name="deep_data",
+        optimizer=optimizer))
+    model.add(hugectr.DenseLayer(layer_type=hugectr.Layer_t.Reshape,
+                                 bottom_names=["sparse_embedding1"], top_names=["reshape1"],
+                                 leading_dim=416))
+    model.add(hugectr.DenseLayer(layer_type=hugectr.Layer_t.Reshape,
+                                 bottom_names=["sparse_embedding2"], top_names=["reshape2"],
+                                 leading_dim=1))
+    model.add(hugectr.DenseLayer(layer_type=hugectr.Layer_t.Concat,
+                                 bottom_names=["reshape1", "dense"], top_names=["concat1"]))
+    deep = add_mlp(model, "concat1", "deep", [1024, 1024])
+    model.add(hugectr.DenseLayer(layer_type=hugectr.Layer_t.InnerProduct,
+                                 bottom_names=[deep], top_names=["fc_out"], num_output=1))
+    model.add(hugectr.DenseLayer(layer_type=hugectr.Layer_t.Add,
+                                 bottom_names=["fc_out", "reshape2"], top_names=["out"]))
+    model.add(hugectr.DenseLayer(layer_type=hugectr.Layer_t.BinaryCrossEntropyLoss,
+                                 bottom_names=["out", "label"], top_names=["loss"]))
+
+
+BUILDERS = {"dlrm": build_dlrm, "dcn": build_dcn, "wdl": build_wdl}
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--workload", choices=sorted(BUILDERS), default="dlrm")
+    parser.add_argument("--preset", choices=sorted(PRESETS), default="1gpu")
+    parser.add_argument("--batchsize", type=int, default=0,
+                        help="override the preset batch size")
+    parser.add_argument("--iters", type=int, default=2000)
+    parser.add_argument("--mixed_precision", action="store_true")
+    parser.add_argument("--workdir", default="./benchmark_data",
+                        help="where synthetic datasets are generated and reused")
+    parser.add_argument("--regen", action="store_true",
+                        help="regenerate the dataset even if it already exists")
+    parser.add_argument("--output", default="",
+                        help="result JSON path; defaults to <workload>_<preset>.json")
+    parser.add_argument("--baseline", default="",
+                        help="previous result JSON to compare against")
+    parser.add_argument("--regression_threshold", type=float, default=0.05,
+                        help="fail when avg step time regresses more than this fraction")
+    args = parser.parse_args()
+
+    preset = PRESETS[args.preset]
+    gen_params = generator_params(args.workload, args.workdir)
+
+    rank = MPI.COMM_WORLD.Get_rank()
+    if rank == 0 and (args.regen or not os.path.exists(gen_params.source)):
+        DataGenerator(gen_params).generate()
+    MPI.COMM_WORLD.Barrier()
+
+    solver = make_solver(preset, args)
+    reader = make_reader(gen_params)
+    optimizer = hugectr.CreateOptimizer(
+        optimizer_type=hugectr.Optimizer_t.SGD,
+        update_type=hugectr.Update_t.Local,
+        atomic_update=True,
+    )
+    model = hugectr.Model(solver, reader, optimizer)
+    BUILDERS[args.workload](model, gen_params, optimizer)
+    model.compile()
+    model.summary()
+
+    start = time.time()
+    model.fit(max_iter=args.iters, display=max(args.iters // 10, 1),
+              eval_interval=args.iters + 1, snapshot=args.iters + 1)
+    elapsed = time.time() - start
+
+    batchsize = args.batchsize or preset["batchsize"]
+    result = {
+        "workload": args.workload,
+        "preset": args.preset,
+        "vvgpu": preset["vvgpu"],
+        "batchsize": batchsize,
+        "mixed_precision": args.mixed_precision,
+        "iters": args.iters,
+        "elapsed_sec": round(elapsed, 3),
+        "avg_step_ms": round(elapsed * 1000.0 / args.iters, 4),
+        "samples_per_sec": round(batchsize * args.iters / elapsed, 1),
+        "hostname": socket.gethostname(),
+        "timestamp": int(time.time()),
+    }
+    if os.getenv("HCTR_PROFILE_PIPELINE"):
+        result["pipeline_profile"] = json.loads(model.get_pipeline_profile())
+
+    if rank != 0:
+        return
+
+    output = args.output or "%s_%s.json" % (args.workload, args.preset)
+    with open(output, "w") as f:
+        json.dump(result, f, indent=2)
+    print("benchmark result written to %s" % output)
+
+    if args.baseline:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+        delta = (result["avg_step_ms"] - baseline["avg_step_ms"]) / baseline["avg_step_ms"]
+        print("avg_step_ms: %.4f vs baseline %.4f (%+.2f%%)"
+              % (result["avg_step_ms"], baseline["avg_step_ms"], delta * 100.0))
+        if delta > args.regression_threshold:
+            print("REGRESSION above %.0f%% threshold" % (args.regression_threshold * 100.0))
+            sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
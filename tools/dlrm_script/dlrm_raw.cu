@@ -20,11 +20,38 @@
 
 using namespace DLRM_RAW;
 
+// Out-of-core mode (--out-of-core): back the RMM pool with managed memory so the
+// category-mapping hash tables and CSV chunks may oversubscribe a single GPU and spill to host
+// memory, and spread the per-column index builds round-robin across all visible GPUs. Managed
+// allocations are accessible from every device, so the workers need no peer setup.
+static bool out_of_core_mode = false;
+static int num_build_gpus = 1;
+
 template <typename T>
 auto dtype() {
   return cudf::data_type{cudf::type_to_id<T>()};
 }
 
+static rmm::mr::device_memory_resource *make_base_mr() {
+  if (out_of_core_mode) {
+    return new rmm::mr::managed_memory_resource();
+  }
+  return new rmm::mr::cuda_memory_resource();
+}
+
+// In out-of-core mode the build kernels of one chunk run on several devices; they must all
+// finish before the chunk's cudf table is freed, because only device 0's default stream is
+// ordered with the pool's deallocations.
+static void sync_build_gpus() {
+  if (out_of_core_mode && num_build_gpus > 1) {
+    for (int g = 0; g < num_build_gpus; g++) {
+      HCTR_LIB_THROW(cudaSetDevice(g));
+      HCTR_LIB_THROW(cudaDeviceSynchronize());
+    }
+    HCTR_LIB_THROW(cudaSetDevice(0));
+  }
+}
+
 void process_kaggle_dataset(const std::string &input_dir_path, const std::string &output_dir_path,
                             const int num_numericals, const int num_categoricals) {
   int max_chunk_per_file = 10000;  // loop count, in a signle binary data, store how many chunks
@@ -57,7 +84,7 @@ void process_kaggle_dataset(const std::string &input_dir_path, const std::string
 
   size_t pool_alloc_size = (size_t)4 * 1024 * 1024 * 1024;  // 4 GB
   // std::vector<int> dev = {0};
-  rmm::mr::device_memory_resource *base_mr = new rmm::mr::cuda_memory_resource();
+  rmm::mr::device_memory_resource *base_mr = make_base_mr();
   auto *p_mr =
       new rmm::mr::pool_memory_resource<rmm::mr::device_memory_resource>(base_mr, pool_alloc_size);
   rmm::mr::set_current_device_resource(p_mr);
@@ -103,8 +130,14 @@ void process_kaggle_dataset(const std::string &input_dir_path, const std::string
 
   size_t read_chunks = 128 * 1024 * 1024;  // read 128MB at one time
 
-  uint32_t *accum_location = nullptr;                // slot-size
-  HCTR_LIB_THROW(cudaMalloc(&accum_location, 128));  // 128 Bytes = 32 * uint32_t
+  uint32_t *accum_location = nullptr;  // slot-size, 128 Bytes = 32 * uint32_t
+  if (out_of_core_mode) {
+    // The per-column build kernels may run on any device; managed memory keeps the slot-size
+    // accumulators reachable from all of them.
+    HCTR_LIB_THROW(cudaMallocManaged(&accum_location, 128));
+  } else {
+    HCTR_LIB_THROW(cudaMalloc(&accum_location, 128));
+  }
   HCTR_LIB_THROW(cudaMemset(accum_location, 0, 128));
 
   // uint32_t *culled_index_count = nullptr;
@@ -145,6 +178,9 @@ void process_kaggle_dataset(const std::string &input_dir_path, const std::string
 
     // categorical-features
     for (unsigned int k = 0; k < cat_column_names.size(); ++k) {
+      if (out_of_core_mode && num_build_gpus > 1) {
+        HCTR_LIB_THROW(cudaSetDevice(k % num_build_gpus));
+      }
       auto col = std::move(tbl_w_metadata.tbl->get_column(k));
       if (col.type().id() == cudf::type_id::STRING) {
         auto str_col = cudf::strings_column_view(col.view());
@@ -171,6 +207,7 @@ void process_kaggle_dataset(const std::string &input_dir_path, const std::string
                                  << std::endl;
       }
     }
+    sync_build_gpus();
 
     size_t new_byte_range_offset = in_args.get_byte_range_offset() + read_chunks;
     in_args.set_byte_range_offset(new_byte_range_offset);
@@ -401,7 +438,7 @@ void process_terabyte_dataset(const std::string &input_dir_path, const std::stri
       hash_bucket, hash_bucket, hash_bucket, hash_bucket, hash_bucket};  // mod-idx
 
   size_t pool_alloc_size = (size_t)10 * 1024 * 1024 * 1024;  // 10 GB
-  rmm::mr::device_memory_resource *base_mr = new rmm::mr::cuda_memory_resource();
+  rmm::mr::device_memory_resource *base_mr = make_base_mr();
   auto *p_mr =
       new rmm::mr::pool_memory_resource<rmm::mr::device_memory_resource>(base_mr, pool_alloc_size);
   rmm::mr::set_current_device_resource(p_mr);
@@ -447,8 +484,14 @@ void process_terabyte_dataset(const std::string &input_dir_path, const std::stri
 
   size_t read_chunks = 128 * 1024 * 1024;  // read 128MB at one time
 
-  uint32_t *accum_location = nullptr;                // slot-size
-  HCTR_LIB_THROW(cudaMalloc(&accum_location, 128));  // 128 Bytes = 32 * uint32_t
+  uint32_t *accum_location = nullptr;  // slot-size, 128 Bytes = 32 * uint32_t
+  if (out_of_core_mode) {
+    // The per-column build kernels may run on any device; managed memory keeps the slot-size
+    // accumulators reachable from all of them.
+    HCTR_LIB_THROW(cudaMallocManaged(&accum_location, 128));
+  } else {
+    HCTR_LIB_THROW(cudaMalloc(&accum_location, 128));
+  }
   HCTR_LIB_THROW(cudaMemset(accum_location, 0, 128));
 
   // uint32_t *culled_index_count = nullptr;
@@ -497,6 +540,9 @@ void process_terabyte_dataset(const std::string &input_dir_path, const std::stri
 
       // categorical-features
       for (unsigned int k = 0; k < cat_column_names.size(); ++k) {
+        if (out_of_core_mode && num_build_gpus > 1) {
+          HCTR_LIB_THROW(cudaSetDevice(k % num_build_gpus));
+        }
         auto col = std::move(tbl_w_metadata.tbl->get_column(k));
         if (col.type().id() == cudf::type_id::STRING) {
           auto str_col = cudf::strings_column_view(col.view());
@@ -525,6 +571,7 @@ void process_terabyte_dataset(const std::string &input_dir_path, const std::stri
               << "col.type().id() != [STRING, INT32] " << HCTR_LOCATION() << std::endl;
         }
       }
+      sync_build_gpus();
 
       size_t new_byte_range_offset = in_args.get_byte_range_offset() + read_chunks;
       in_args.set_byte_range_offset(new_byte_range_offset);
@@ -754,23 +801,43 @@ void process_terabyte_dataset(const std::string &input_dir_path, const std::stri
 }
 
 int main(const int argc, const char *argv[]) {
-  if (argc < 3) {
+  // --out-of-core may appear anywhere; strip it before the positional arguments are parsed.
+  std::vector<const char *> args;
+  for (int i = 0; i < argc; i++) {
+    if (std::strcmp(argv[i], "--out-of-core") == 0) {
+      out_of_core_mode = true;
+    } else {
+      args.push_back(argv[i]);
+    }
+  }
+  const int num_args = static_cast<int>(args.size());
+
+  if (num_args < 3) {
     HCTR_LOG(INFO, ROOT, "Need min 2 args: input_dir output_dir\n");
     HCTR_LOG(INFO, ROOT, "Usage for Kaggle Datasets: ./dlrm_raw input_dir output_dir\n");
     HCTR_LOG(
         INFO, ROOT,
         "Usage for TeraBytes Datasets: ./dlrm_raw input_dir output_dir --train [days for training] "
         "--test [days for testing], those days are seperated with comma, no whitespace.\n");
+    HCTR_LOG(INFO, ROOT,
+             "Add --out-of-core to keep the category hash tables in managed memory (they may "
+             "exceed one GPU's memory) and build them on all visible GPUs.\n");
     return -1;
   }
 
+  if (out_of_core_mode) {
+    HCTR_LIB_THROW(cudaGetDeviceCount(&num_build_gpus));
+    HCTR_LOG_S(INFO, ROOT) << "Out-of-core mode: hash tables in managed memory, index build on "
+                           << num_build_gpus << " GPU(s)." << std::endl;
+  }
+
   const int num_numericals = 14;    // label + 13 int-dense-feature
   const int num_categoricals = 26;  // 26 int-categorical-feature
 
-  std::string input_dir_path(argv[1]);
-  std::string output_dir_path(argv[2]);
+  std::string input_dir_path(args[1]);
+  std::string output_dir_path(args[2]);
 
-  switch (argc) {
+  switch (num_args) {
     case 3: {
       HCTR_LOG_S(INFO, ROOT) << "Processing Kaggle datasets" << std::endl;
       HCTR_LOG_S(INFO, ROOT) << "input_dir: " << input_dir_path << std::endl;
@@ -781,8 +848,8 @@ int main(const int argc, const char *argv[]) {
     }
 
     case 7: {
-      if (argc == 7 &&
-          (std::strcmp(argv[3], "--train") != 0 || std::strcmp(argv[5], "--test") != 0)) {
+      if (num_args == 7 &&
+          (std::strcmp(args[3], "--train") != 0 || std::strcmp(args[5], "--test") != 0)) {
         HCTR_LOG(INFO, ROOT,
                  "Usage for TeraBytes Datasets: ./dlrm_raw input_dir output_dir --train [days for "
                  "training] "
@@ -792,14 +859,14 @@ int main(const int argc, const char *argv[]) {
         return -1;
       }
 
-      const std::vector<std::string> train_days = split_string(std::string(argv[4]), ",");
-      const std::vector<std::string> test_days = split_string(std::string(argv[6]), ",");
+      const std::vector<std::string> train_days = split_string(std::string(args[4]), ",");
+      const std::vector<std::string> test_days = split_string(std::string(args[6]), ",");
 
       HCTR_LOG_S(INFO, ROOT) << "Processing TeraBytes datasets." << std::endl;
       HCTR_LOG_S(INFO, ROOT) << "input_dir: " << input_dir_path << std::endl;
       HCTR_LOG_S(INFO, ROOT) << "output_dir: " << output_dir_path << std::endl;
-      HCTR_LOG_S(INFO, ROOT) << "days for training: " << argv[4] << std::endl;
-      HCTR_LOG_S(INFO, ROOT) << "days for testing: " << argv[6] << std::endl;
+      HCTR_LOG_S(INFO, ROOT) << "days for training: " << args[4] << std::endl;
+      HCTR_LOG_S(INFO, ROOT) << "days for testing: " << args[6] << std::endl;
 
       process_terabyte_dataset(input_dir_path, output_dir_path, num_numericals, num_categoricals,
                                train_days, test_days);
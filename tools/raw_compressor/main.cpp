@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2021, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <data_readers/async_reader/compressed_raw.hpp>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using HugeCTR::CompressedRawHeader;
+
+namespace {
+
+// Greedy LZ4 block compressor (single hash table, 64KB window). Produces standard LZ4 block
+// streams that the GPU decompressor in decompress_frames.cu consumes. dst must provide the LZ4
+// worst case of src_size + src_size / 255 + 16 bytes.
+size_t lz4_compress_block(const uint8_t* src, size_t src_size, uint8_t* dst) {
+  constexpr int HASH_LOG = 16;
+  std::vector<uint32_t> table(1 << HASH_LOG, 0);  // stores position + 1, 0 means empty
+
+  auto hash = [](uint32_t v) { return (v * 2654435761u) >> (32 - HASH_LOG); };
+  auto read32 = [](const uint8_t* p) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+  };
+  auto write_length = [](uint8_t* op, size_t len) {
+    for (; len >= 255; len -= 255) {
+      *op++ = 255;
+    }
+    *op++ = static_cast<uint8_t>(len);
+    return op;
+  };
+
+  const uint8_t* ip = src;
+  const uint8_t* anchor = src;
+  const uint8_t* const iend = src + src_size;
+  // The spec requires the last 5 bytes to be literals and no match to start within the last
+  // 12 bytes of the block.
+  const uint8_t* const mflimit = (src_size >= 12) ? iend - 12 : src;
+  const uint8_t* const matchlimit = (src_size >= 5) ? iend - 5 : src;
+  uint8_t* op = dst;
+
+  while (ip < mflimit) {
+    const uint32_t h = hash(read32(ip));
+    const uint32_t candidate = table[h];
+    table[h] = static_cast<uint32_t>(ip - src) + 1;
+    const uint8_t* match = src + candidate - 1;
+
+    if (candidate == 0 || static_cast<size_t>(ip - match) > 65535 ||
+        read32(match) != read32(ip)) {
+      ip++;
+      continue;
+    }
+
+    const uint8_t* cp = ip + 4;
+    const uint8_t* mp = match + 4;
+    while (cp < matchlimit && *cp == *mp) {
+      cp++;
+      mp++;
+    }
+    const size_t match_len = cp - ip;
+    const size_t lit_len = ip - anchor;
+
+    uint8_t* token = op++;
+    if (lit_len >= 15) {
+      *token = 15 << 4;
+      op = write_length(op, lit_len - 15);
+    } else {
+      *token = static_cast<uint8_t>(lit_len << 4);
+    }
+    std::memcpy(op, anchor, lit_len);
+    op += lit_len;
+
+    const size_t offset = ip - match;
+    *op++ = static_cast<uint8_t>(offset);
+    *op++ = static_cast<uint8_t>(offset >> 8);
+
+    if (match_len - 4 >= 15) {
+      *token |= 15;
+      op = write_length(op, match_len - 4 - 15);
+    } else {
+      *token |= static_cast<uint8_t>(match_len - 4);
+    }
+
+    ip = cp;
+    anchor = ip;
+  }
+
+  // trailing literals
+  const size_t lit_len = iend - anchor;
+  uint8_t* token = op++;
+  if (lit_len >= 15) {
+    *token = 15 << 4;
+    op = write_length(op, lit_len - 15);
+  } else {
+    *token = static_cast<uint8_t>(lit_len << 4);
+  }
+  std::memcpy(op, anchor, lit_len);
+  op += lit_len;
+
+  return op - dst;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc != 4 && argc != 5) {
+    std::cout << "Convert a raw dataset into the block-compressed raw format for the AsyncReader."
+              << std::endl;
+    std::cout << "usage: " << argv[0] << " <input> <output> <batch_size_bytes> [chunk_size_kb=64]"
+              << std::endl;
+    return -1;
+  }
+
+  const std::string in_name = argv[1];
+  const std::string out_name = argv[2];
+  const size_t batch_size_bytes = std::stoull(argv[3]);
+  const size_t chunk_size = (argc == 5 ? std::stoull(argv[4]) : 64) * 1024;
+
+  std::ifstream in_file(in_name, std::ios::binary | std::ios::ate);
+  if (!in_file) {
+    std::cerr << "Cannot open " << in_name << std::endl;
+    return -1;
+  }
+  const size_t total_size = in_file.tellg();
+  in_file.seekg(0);
+
+  CompressedRawHeader header;
+  header.magic = CompressedRawHeader::MAGIC;
+  header.version = CompressedRawHeader::VERSION;
+  header.batch_size_bytes = batch_size_bytes;
+  header.chunk_size_bytes = chunk_size;
+  header.uncompressed_size = total_size;
+  header.num_frames = (total_size + batch_size_bytes - 1) / batch_size_bytes;
+
+  std::ofstream out_file(out_name, std::ios::binary);
+  if (!out_file) {
+    std::cerr << "Cannot open " << out_name << std::endl;
+    return -1;
+  }
+
+  std::vector<uint64_t> frame_offsets(header.num_frames + 1, 0);
+  out_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  // Placeholder index, rewritten once the frame sizes are known.
+  const size_t index_pos = out_file.tellp();
+  out_file.write(reinterpret_cast<const char*>(frame_offsets.data()),
+                 frame_offsets.size() * sizeof(uint64_t));
+
+  std::vector<uint8_t> frame(batch_size_bytes);
+  std::vector<uint8_t> comp_chunk(chunk_size + chunk_size / 255 + 16);
+  frame_offsets[0] = out_file.tellp();
+
+  for (size_t frame_id = 0; frame_id < header.num_frames; frame_id++) {
+    const size_t frame_size =
+        std::min(batch_size_bytes, total_size - frame_id * batch_size_bytes);
+    in_file.read(reinterpret_cast<char*>(frame.data()), frame_size);
+
+    const uint32_t num_chunks = (frame_size + chunk_size - 1) / chunk_size;
+    std::vector<uint32_t> chunk_offsets(num_chunks + 1, 0);
+    std::vector<uint8_t> payload;
+    payload.reserve(frame_size);
+
+    for (uint32_t chunk = 0; chunk < num_chunks; chunk++) {
+      const size_t chunk_beg = chunk * chunk_size;
+      const size_t chunk_len = std::min(chunk_size, frame_size - chunk_beg);
+      const size_t comp_len =
+          lz4_compress_block(frame.data() + chunk_beg, chunk_len, comp_chunk.data());
+      payload.insert(payload.end(), comp_chunk.data(), comp_chunk.data() + comp_len);
+      chunk_offsets[chunk + 1] = chunk_offsets[chunk] + comp_len;
+    }
+
+    out_file.write(reinterpret_cast<const char*>(&num_chunks), sizeof(num_chunks));
+    out_file.write(reinterpret_cast<const char*>(chunk_offsets.data()),
+                   chunk_offsets.size() * sizeof(uint32_t));
+    out_file.write(reinterpret_cast<const char*>(payload.data()), payload.size());
+    frame_offsets[frame_id + 1] = out_file.tellp();
+  }
+
+  const size_t compressed_size = out_file.tellp();
+  out_file.seekp(index_pos);
+  out_file.write(reinterpret_cast<const char*>(frame_offsets.data()),
+                 frame_offsets.size() * sizeof(uint64_t));
+
+  std::cout << "Wrote " << header.num_frames << " frames, " << total_size << " -> "
+            << compressed_size << " bytes (ratio "
+            << static_cast<double>(total_size) / compressed_size << ")" << std::endl;
+  return 0;
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2021, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <data_readers/async_reader/raw_v2.hpp>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using HugeCTR::RAW_V2_ALIGNMENT;
+using HugeCTR::RawV2Header;
+
+namespace {
+
+size_t align_up(size_t value, size_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc != 5) {
+    std::cout << "Convert a raw dataset into the aligned raw v2 format for the AsyncReader."
+              << std::endl;
+    std::cout << "usage: " << argv[0]
+              << " <input> <output> <sample_size_bytes> <samples_per_group>" << std::endl;
+    std::cout << "samples_per_group must equal the training batch size: one record group is read "
+              << "as one batch." << std::endl;
+    return -1;
+  }
+
+  const std::string in_name = argv[1];
+  const std::string out_name = argv[2];
+  const size_t sample_size = std::stoull(argv[3]);
+  const size_t samples_per_group = std::stoull(argv[4]);
+
+  std::ifstream in_file(in_name, std::ios::binary | std::ios::ate);
+  if (!in_file) {
+    std::cerr << "Cannot open " << in_name << std::endl;
+    return -1;
+  }
+  const size_t total_size = in_file.tellg();
+  in_file.seekg(0);
+
+  if (sample_size == 0 || samples_per_group == 0 || total_size % sample_size != 0) {
+    std::cerr << "Input size " << total_size << " is not a multiple of the sample size "
+              << sample_size << std::endl;
+    return -1;
+  }
+  const size_t num_samples = total_size / sample_size;
+  const size_t num_groups = (num_samples + samples_per_group - 1) / samples_per_group;
+  const size_t group_payload = samples_per_group * sample_size;
+
+  RawV2Header header;
+  header.magic = RawV2Header::MAGIC;
+  header.version = RawV2Header::VERSION;
+  header.sample_size_bytes = sample_size;
+  header.samples_per_group = samples_per_group;
+  header.group_stride_bytes = align_up(group_payload, RAW_V2_ALIGNMENT);
+  header.data_offset_bytes =
+      align_up(sizeof(header) + num_groups * sizeof(uint32_t), RAW_V2_ALIGNMENT);
+  header.num_samples = num_samples;
+  header.num_groups = num_groups;
+
+  std::ofstream out_file(out_name, std::ios::binary);
+  if (!out_file) {
+    std::cerr << "Cannot open " << out_name << std::endl;
+    return -1;
+  }
+
+  std::vector<uint32_t> checksums(num_groups, 0);
+  out_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  // Placeholder checksum segment, rewritten once the groups are hashed.
+  const size_t checksum_pos = out_file.tellp();
+  out_file.write(reinterpret_cast<const char*>(checksums.data()),
+                 checksums.size() * sizeof(uint32_t));
+  const std::vector<char> pad(header.data_offset_bytes - checksum_pos -
+                              checksums.size() * sizeof(uint32_t));
+  out_file.write(pad.data(), pad.size());
+
+  // The group padding is zeroed so converted files are byte-reproducible.
+  std::vector<char> group(header.group_stride_bytes, 0);
+  for (size_t group_id = 0; group_id < num_groups; group_id++) {
+    const size_t payload =
+        std::min(group_payload, (num_samples - group_id * samples_per_group) * sample_size);
+    std::fill(group.begin(), group.end(), 0);
+    in_file.read(group.data(), payload);
+    checksums[group_id] = HugeCTR::raw_v2_crc32(group.data(), payload);
+    out_file.write(group.data(), group.size());
+  }
+
+  const size_t converted_size = out_file.tellp();
+  out_file.seekp(checksum_pos);
+  out_file.write(reinterpret_cast<const char*>(checksums.data()),
+                 checksums.size() * sizeof(uint32_t));
+
+  std::cout << "Wrote " << num_groups << " record groups of " << samples_per_group << " samples, "
+            << total_size << " -> " << converted_size << " bytes" << std::endl;
+  return 0;
+}